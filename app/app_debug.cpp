@@ -115,6 +115,21 @@ void debug_info_populate_profiler(DebugInfo *info)
     info->sim_particles_ms = profile_get_avg_ms(PROFILE_SIM_PARTICLES);
     info->sim_collision_ms = profile_get_avg_ms(PROFILE_SIM_COLLISION);
 
+    info->lod_bodies[0] = profile_get_counter(PROFILE_COUNTER_LOD_BODY_FULL);
+    info->lod_bodies[1] = profile_get_counter(PROFILE_COUNTER_LOD_BODY_HALF);
+    info->lod_bodies[2] = profile_get_counter(PROFILE_COUNTER_LOD_BODY_QUARTER);
+    info->lod_bodies_deferred = profile_get_counter(PROFILE_COUNTER_LOD_BODY_DEFERRED);
+    info->lod_bodies_promoted = profile_get_counter(PROFILE_COUNTER_LOD_BODY_PROMOTED);
+    info->lod_particles[0] = profile_get_counter(PROFILE_COUNTER_LOD_PARTICLE_FULL);
+    info->lod_particles[1] = profile_get_counter(PROFILE_COUNTER_LOD_PARTICLE_HALF);
+    info->lod_particles[2] = profile_get_counter(PROFILE_COUNTER_LOD_PARTICLE_QUARTER);
+    info->lod_particles_deferred = profile_get_counter(PROFILE_COUNTER_LOD_PARTICLE_DEFERRED);
+    info->debris_demoted = profile_get_counter(PROFILE_COUNTER_DEBRIS_DEMOTED);
+    info->debris_particles = profile_get_counter(PROFILE_COUNTER_DEBRIS_PARTICLES);
+    info->debris_threshold = profile_get_counter(PROFILE_COUNTER_DEBRIS_THRESHOLD);
+    info->freeze_frozen = profile_get_counter(PROFILE_COUNTER_FREEZE_FROZEN);
+    info->freeze_deferred = profile_get_counter(PROFILE_COUNTER_FREEZE_DEFERRED);
+
     info->render_total_ms = profile_get_avg_ms(PROFILE_RENDER_TOTAL);
     info->render_shadow_ms = profile_get_avg_ms(PROFILE_RENDER_SHADOW);
     info->render_main_ms = profile_get_avg_ms(PROFILE_RENDER_MAIN);
@@ -171,8 +186,18 @@ bool export_debug_report(const char *filename, const DebugInfo *info)
             info->cpu_fence_ms, info->cpu_acquire_ms, info->cpu_present_ms);
 
     fprintf(f, "--- Sim Timing ---\n");
-    fprintf(f, "Tick: %.2fms (physics %.2fms, particles %.2fms, collision %.2fms)\n\n",
+    fprintf(f, "Tick: %.2fms (physics %.2fms, particles %.2fms, collision %.2fms)\n",
             info->sim_tick_ms, info->sim_physics_ms, info->sim_particles_ms, info->sim_collision_ms);
+    fprintf(f, "LOD bodies: %d full, %d 1/2, %d 1/4, %d deferred, %d promoted\n",
+            info->lod_bodies[0], info->lod_bodies[1], info->lod_bodies[2],
+            info->lod_bodies_deferred, info->lod_bodies_promoted);
+    fprintf(f, "LOD particles: %d full, %d 1/2, %d 1/4, %d deferred\n",
+            info->lod_particles[0], info->lod_particles[1], info->lod_particles[2],
+            info->lod_particles_deferred);
+    fprintf(f, "Debris: %d fragments as %d particles, threshold %d voxels\n",
+            info->debris_demoted, info->debris_particles, info->debris_threshold);
+    fprintf(f, "Frozen into terrain: %d bodies, %d deferred\n\n",
+            info->freeze_frozen, info->freeze_deferred);
 
     fprintf(f, "--- Render Timing ---\n");
     fprintf(f, "Total: %.2fms\n", info->render_total_ms);
@@ -250,7 +275,8 @@ bool export_debug_report(const char *filename, const DebugInfo *info)
         "volume_init", "prop_spawn",
         "render_gbuffer", "render_objects", "render_lighting", "render_ao", "render_denoise",
         "render_volume_begin", "render_chunk_upload", "render_shadow_volume",
-        "shadow_terrain_pack", "shadow_object_stamp", "shadow_mip_regen", "shadow_upload"};
+        "shadow_terrain_pack", "shadow_object_stamp", "shadow_mip_regen", "shadow_upload",
+        "sim_narrowphase_pair"};
 
     const int name_count = (int)(sizeof(names) / sizeof(names[0]));
     const int count = (PROFILE_COUNT < name_count) ? PROFILE_COUNT : name_count;
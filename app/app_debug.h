@@ -81,6 +81,22 @@ struct DebugInfo
     float sim_particles_ms;
     float sim_collision_ms;
 
+    /* Sim LOD work last tick: full, 1/2, 1/4 rate updates; skipped; promoted by contact */
+    int32_t lod_bodies[3];
+    int32_t lod_bodies_deferred;
+    int32_t lod_bodies_promoted;
+    int32_t lod_particles[3];
+    int32_t lod_particles_deferred;
+
+    /* Debris LOD: fragments demoted to particles and particles spawned (totals), voxel threshold */
+    int32_t debris_demoted;
+    int32_t debris_particles;
+    int32_t debris_threshold;
+
+    /* Body freezing: bodies frozen into the terrain (total), ready ones deferred last tick */
+    int32_t freeze_frozen;
+    int32_t freeze_deferred;
+
     /* Render timing */
     float render_total_ms;
     float render_shadow_ms;
@@ -619,7 +619,7 @@ int patch_main(int argc, char *argv[])
                                     if (!obj->active) continue;
                                     int32_t body_idx = physics_world_find_body_for_object(bp_data->physics, obj_idx);
                                     if (body_idx < 0) continue;
-                                    Vec3 dir = vec3_sub(obj->position, hit_pos);
+                                    Vec3 dir = vec3_sub(voxel_object_position(bp_data->objects, obj_idx), hit_pos);
                                     float dist = vec3_length(dir);
                                     if (dist > 0.001f) dir = vec3_scale(dir, 1.0f / dist);
                                     else dir = vec3_create(0.0f, 1.0f, 0.0f);
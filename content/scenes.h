@@ -12,6 +12,9 @@ extern "C"
 /* Maximum scenes in registration table */
 #define SCENE_MAX_COUNT 16
 
+/* Scene chunk counts are authored in 32-voxel chunks, independent of CHUNK_SIZE */
+#define SCENE_CHUNK_VOXELS 32
+
     typedef enum
     {
         SCENE_TYPE_BALL_PIT,
@@ -27,7 +30,7 @@ extern "C"
         const char *name;      /* Display name */
         SceneType type;        /* Scene type for factory */
         Bounds3D bounds;       /* World-space bounds */
-        int32_t chunks_x;      /* Chunk coverage X */
+        int32_t chunks_x;      /* Chunk coverage X (SCENE_CHUNK_VOXELS units) */
         int32_t chunks_y;      /* Chunk coverage Y */
         int32_t chunks_z;      /* Chunk coverage Z */
         float voxel_size;      /* Size of each voxel in world units */
@@ -51,7 +54,7 @@ extern "C"
     /* Compute bounds from chunks (single source of truth for terrain dimensions) */
     static inline Bounds3D scene_compute_terrain_bounds(const SceneDescriptor *desc)
     {
-        float chunk_world_size = 32.0f * desc->voxel_size; /* CHUNK_SIZE = 32 */
+        float chunk_world_size = (float)SCENE_CHUNK_VOXELS * desc->voxel_size;
         float half_x = desc->chunks_x * chunk_world_size * 0.5f;
         float half_z = desc->chunks_z * chunk_world_size * 0.5f;
         float height = desc->chunks_y * chunk_world_size;
@@ -68,6 +68,9 @@ extern "C"
         PROFILE_SHADOW_MIP_REGEN,
         PROFILE_SHADOW_UPLOAD,
 
+        /* Physics narrowphase: one sample per hull pair test */
+        PROFILE_SIM_NARROWPHASE,
+
         PROFILE_COUNT
     } ProfileCategory;
 
@@ -101,7 +104,48 @@ extern "C"
         "      Terrain Pack",
         "      Object Stamp",
         "      Mip Regen",
-        "      Upload"};
+        "      Upload",
+        "  Narrowphase Pair"};
+
+    /* Work counters: last value set per tick, not timed */
+    typedef enum
+    {
+        /* Sim LOD: updates by rate, skipped ticks, far bodies promoted by contact */
+        PROFILE_COUNTER_LOD_BODY_FULL,
+        PROFILE_COUNTER_LOD_BODY_HALF,
+        PROFILE_COUNTER_LOD_BODY_QUARTER,
+        PROFILE_COUNTER_LOD_BODY_DEFERRED,
+        PROFILE_COUNTER_LOD_BODY_PROMOTED,
+        PROFILE_COUNTER_LOD_PARTICLE_FULL,
+        PROFILE_COUNTER_LOD_PARTICLE_HALF,
+        PROFILE_COUNTER_LOD_PARTICLE_QUARTER,
+        PROFILE_COUNTER_LOD_PARTICLE_DEFERRED,
+        /* Debris LOD: fragments turned into particles and their particles (totals), voxel threshold */
+        PROFILE_COUNTER_DEBRIS_DEMOTED,
+        PROFILE_COUNTER_DEBRIS_PARTICLES,
+        PROFILE_COUNTER_DEBRIS_THRESHOLD,
+        /* Body freezing: bodies frozen into the terrain (total), ready ones left for later */
+        PROFILE_COUNTER_FREEZE_FROZEN,
+        PROFILE_COUNTER_FREEZE_DEFERRED,
+
+        PROFILE_COUNTER_COUNT
+    } ProfileCounter;
+
+    static const char *const g_profile_counter_names[PROFILE_COUNTER_COUNT] = {
+        "LOD Bodies Full",
+        "LOD Bodies 1/2",
+        "LOD Bodies 1/4",
+        "LOD Bodies Deferred",
+        "LOD Bodies Promoted",
+        "LOD Particles Full",
+        "LOD Particles 1/2",
+        "LOD Particles 1/4",
+        "LOD Particles Deferred",
+        "Debris Demoted",
+        "Debris Particles",
+        "Debris Threshold",
+        "Freeze Frozen",
+        "Freeze Deferred"};
 
     /* Per-category profiling state with rolling history */
     typedef struct
@@ -130,6 +174,7 @@ extern "C"
 
     extern ProfileSlot g_profile_slots[PROFILE_COUNT];
     extern ProfileBudget g_profile_budget;
+    extern int32_t g_profile_counters[PROFILE_COUNTER_COUNT];
 
     static inline void profile_begin(ProfileCategory cat)
     {
@@ -157,6 +202,16 @@ extern "C"
             slot->history_count++;
     }
 
+    static inline void profile_counter_set(ProfileCounter counter, int32_t value)
+    {
+        g_profile_counters[counter] = value;
+    }
+
+    static inline int32_t profile_get_counter(ProfileCounter counter)
+    {
+        return g_profile_counters[counter];
+    }
+
     /* Mark end of frame and update budget tracking */
     static inline void profile_frame_end(void)
     {
@@ -294,6 +349,8 @@ extern "C"
     {
         for (int i = 0; i < PROFILE_COUNT; i++)
             profile_reset((ProfileCategory)i);
+        for (int i = 0; i < PROFILE_COUNTER_COUNT; i++)
+            g_profile_counters[i] = 0;
 
         g_profile_budget.frame_ms = 0.0f;
         g_profile_budget.budget_used_pct = 0.0f;
@@ -344,6 +401,7 @@ extern "C"
 #define PROFILE_BEGIN(cat) profile_begin(cat)
 #define PROFILE_END(cat) profile_end(cat)
 #define PROFILE_FRAME_END() profile_frame_end()
+#define PROFILE_COUNTER_SET(counter, value) profile_counter_set(counter, value)
 
 /* Backward compatibility aliases */
 #define PROFILE_RAYCAST PROFILE_VOXEL_RAYCAST
@@ -387,9 +445,29 @@ typedef enum
     PROFILE_RENDER_CHUNK_UPLOAD,
     PROFILE_RENDER_SHADOW_VOLUME,
     PROFILE_CHUNK_UPLOAD,
+    PROFILE_SIM_NARROWPHASE,
     PROFILE_COUNT
 } ProfileCategory;
 
+typedef enum
+{
+    PROFILE_COUNTER_LOD_BODY_FULL = 0,
+    PROFILE_COUNTER_LOD_BODY_HALF,
+    PROFILE_COUNTER_LOD_BODY_QUARTER,
+    PROFILE_COUNTER_LOD_BODY_DEFERRED,
+    PROFILE_COUNTER_LOD_BODY_PROMOTED,
+    PROFILE_COUNTER_LOD_PARTICLE_FULL,
+    PROFILE_COUNTER_LOD_PARTICLE_HALF,
+    PROFILE_COUNTER_LOD_PARTICLE_QUARTER,
+    PROFILE_COUNTER_LOD_PARTICLE_DEFERRED,
+    PROFILE_COUNTER_DEBRIS_DEMOTED,
+    PROFILE_COUNTER_DEBRIS_PARTICLES,
+    PROFILE_COUNTER_DEBRIS_THRESHOLD,
+    PROFILE_COUNTER_FREEZE_FROZEN,
+    PROFILE_COUNTER_FREEZE_DEFERRED,
+    PROFILE_COUNTER_COUNT
+} ProfileCounter;
+
 typedef struct
 {
     int64_t start_tick;
@@ -417,6 +495,7 @@ extern ProfileBudget g_profile_budget;
 #define PROFILE_BEGIN(cat) ((void)0)
 #define PROFILE_END(cat) ((void)0)
 #define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_COUNTER_SET(counter, value) ((void)0)
 
 static inline float profile_get_avg_ms(int cat)
 {
@@ -463,6 +542,11 @@ static inline int32_t profile_get_sample_count(int cat)
     (void)cat;
     return 0;
 }
+static inline int32_t profile_get_counter(int counter)
+{
+    (void)counter;
+    return 0;
+}
 static inline void profile_reset(int cat) { (void)cat; }
 static inline void profile_reset_all(void) {}
 static inline float profile_budget_used_pct(void) { return 0.0f; }
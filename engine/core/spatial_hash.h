@@ -11,7 +11,7 @@ extern "C" {
 
 /*
  * Spatial Hash Grid for O(n) neighbor queries.
- * Currently used by particle system only for particle-particle collision.
+ * Used by the voxel object world for raycast candidates.
  *
  * Usage:
  *   1. spatial_hash_clear() at start of each frame
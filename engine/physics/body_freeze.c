@@ -0,0 +1,80 @@
+#include "body_freeze.h"
+#include "engine/core/profile.h"
+#include <string.h>
+
+void physics_freeze_init(PhysicsFreeze *freeze)
+{
+    memset(freeze, 0, sizeof(*freeze));
+    freeze->rest_ticks = PHYS_FREEZE_REST_TICKS;
+    freeze->max_per_tick = PHYS_FREEZE_MAX_PER_TICK;
+}
+
+int32_t physics_freeze_resting(PhysicsFreeze *freeze, PhysicsWorld *world)
+{
+    if (!freeze || !world || !world->objects || !world->terrain)
+        return 0;
+
+    PROFILE_BEGIN(PROFILE_SIM_VOXEL_UPDATE);
+
+    VoxelVolume *terrain = world->terrain;
+    VoxelObjectWorld *objects = world->objects;
+    freeze->deferred = 0;
+
+    bool batch_open = false;
+    int32_t frozen = 0;
+    int32_t limit = world->max_body_index + 1;
+    for (int32_t i = 0; i < limit; i++)
+    {
+        RigidBody *body = &world->bodies[i];
+        if (!(world->flags[i] & PHYS_FLAG_ACTIVE) || (int32_t)body->rest_ticks < freeze->rest_ticks)
+            continue;
+
+        int32_t obj_index = body->vobj_index;
+        if (obj_index < 0 || obj_index >= objects->object_count || !objects->objects[obj_index].active)
+            continue;
+        VoxelObject *obj = &objects->objects[obj_index];
+
+        if (frozen >= freeze->max_per_tick)
+        {
+            freeze->deferred++;
+            continue;
+        }
+
+        if (!batch_open)
+        {
+            volume_edit_begin(terrain);
+            batch_open = true;
+        }
+
+        /* Whole or not at all: a partial stamp would lose voxels when the object goes */
+        int32_t chunks = 0;
+        VoxelObjectPose pose = voxel_object_pose(objects, obj_index);
+        int32_t needed = voxel_object_stamp_volume(obj, pose, terrain, false, &chunks);
+        if (terrain->edit_count + needed > VOLUME_MAX_EDITS_PER_TICK ||
+            terrain->edit_touched_count + chunks > VOLUME_EDIT_BATCH_MAX_CHUNKS)
+        {
+            freeze->deferred++;
+            continue;
+        }
+
+        freeze->voxels_written += voxel_object_stamp_volume(obj, pose, terrain, true, NULL);
+        physics_world_remove_body(world, i);
+
+        /* A dirty object is recycled by process_recalcs, which walks the dirty list */
+        if (obj->shape_dirty)
+            obj->active = false;
+        else
+            voxel_object_world_free_slot(objects, obj_index);
+        frozen++;
+    }
+
+    if (batch_open)
+        volume_edit_end(terrain);
+
+    freeze->bodies_frozen += frozen;
+    PROFILE_COUNTER_SET(PROFILE_COUNTER_FREEZE_FROZEN, freeze->bodies_frozen);
+    PROFILE_COUNTER_SET(PROFILE_COUNTER_FREEZE_DEFERRED, freeze->deferred);
+
+    PROFILE_END(PROFILE_SIM_VOXEL_UPDATE);
+    return frozen;
+}
@@ -0,0 +1,56 @@
+#ifndef PATCH_PHYSICS_BODY_FREEZE_H
+#define PATCH_PHYSICS_BODY_FREEZE_H
+
+#include "engine/core/types.h"
+#include "engine/voxel/volume.h"
+#include "engine/voxel/voxel_object.h"
+#include "rigidbody.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Body Freezing
+ *
+ * A voxel object that has slept on the terrain for rest_ticks steps goes
+ * back into the terrain: it is stamped at its current pose
+ * (voxel_object_stamp_volume, keeping its materials) in one edit batch,
+ * then its body and object slot are freed. That returns the BVH,
+ * broadphase, shadow stamp and GPU object slots it held; destroying the
+ * voxels later detaches them again like any other terrain.
+ *
+ * A body freezes whole or not at all: one whose stamp would overrun the
+ * tick's edit budget or touched-chunk list waits for a later call.
+ */
+
+#define PHYS_FREEZE_REST_TICKS 180 /* Steps asleep on the terrain before freezing (3 s at 60 Hz) */
+#define PHYS_FREEZE_MAX_PER_TICK 4
+
+    typedef struct PhysicsFreeze
+    {
+        int32_t rest_ticks;   /* RigidBody.rest_ticks needed */
+        int32_t max_per_tick; /* Bodies frozen per call at most */
+
+        /* Totals since init (also published as profiler counters) */
+        int32_t bodies_frozen;
+        int32_t voxels_written;
+        int32_t deferred; /* Ready bodies the last call left for later */
+    } PhysicsFreeze;
+
+    void physics_freeze_init(PhysicsFreeze *freeze);
+
+    /*
+     * Freezes ready bodies into world->terrain. Call between steps, outside
+     * any terrain edit batch. Returns the bodies frozen.
+     */
+    int32_t physics_freeze_resting(PhysicsFreeze *freeze, PhysicsWorld *world);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,131 +1,386 @@
 #include "broadphase.h"
+#include <float.h>
+#include <stdlib.h>
 #include <string.h>
 
-void sap_init(SAPBroadphase *sap)
+/* Parks removed bodies past every real endpoint */
+#define SAP_SENTINEL FLT_MAX
+
+SAPBroadphase *sap_create(int32_t max_bodies)
 {
+    if (max_bodies <= 0)
+        return NULL;
+
+    SAPBroadphase *sap = (SAPBroadphase *)calloc(1, sizeof(SAPBroadphase));
     if (!sap)
-        return;
+        return NULL;
+
+    sap->max_bodies = max_bodies;
+    bool ok = true;
+    for (int32_t axis = 0; axis < 3; axis++)
+    {
+        sap->endpoints[axis] = (SAPEndpoint *)calloc((size_t)max_bodies * 2, sizeof(SAPEndpoint));
+        sap->endpoint_pos[axis] = (int32_t *)calloc((size_t)max_bodies * 2, sizeof(int32_t));
+        ok = ok && sap->endpoints[axis] && sap->endpoint_pos[axis];
+    }
+    sap->aabb_min = (float (*)[3])calloc((size_t)max_bodies, sizeof(float[3]));
+    sap->aabb_max = (float (*)[3])calloc((size_t)max_bodies, sizeof(float[3]));
+    sap->body_active = (bool *)calloc((size_t)max_bodies, sizeof(bool));
 
-    memset(sap, 0, sizeof(SAPBroadphase));
-    sap->endpoint_count = 0;
+    sap->table_size = SAP_INITIAL_PAIRS * 2;
+    sap->pair_table = (int32_t *)malloc(sizeof(int32_t) * (size_t)sap->table_size);
+    sap->pairs.items = (SAPPair *)malloc(sizeof(SAPPair) * SAP_INITIAL_PAIRS);
+    sap->pairs.capacity = SAP_INITIAL_PAIRS;
+
+    if (!ok || !sap->aabb_min || !sap->aabb_max || !sap->body_active ||
+        !sap->pair_table || !sap->pairs.items)
+    {
+        sap_destroy(sap);
+        return NULL;
+    }
+
+    memset(sap->pair_table, 0xFF, sizeof(int32_t) * (size_t)sap->table_size);
+    return sap;
 }
 
-void sap_update_body(SAPBroadphase *sap, int32_t body_index,
-                     Vec3 aabb_min, Vec3 aabb_max, bool active)
+void sap_destroy(SAPBroadphase *sap)
 {
-    if (!sap || body_index < 0 || body_index >= SAP_MAX_BODIES)
+    if (!sap)
         return;
 
-    sap->aabb_min[body_index][0] = aabb_min.x;
-    sap->aabb_min[body_index][1] = aabb_min.y;
-    sap->aabb_min[body_index][2] = aabb_min.z;
-    sap->aabb_max[body_index][0] = aabb_max.x;
-    sap->aabb_max[body_index][1] = aabb_max.y;
-    sap->aabb_max[body_index][2] = aabb_max.z;
-    sap->body_active[body_index] = active;
+    for (int32_t axis = 0; axis < 3; axis++)
+    {
+        free(sap->endpoints[axis]);
+        free(sap->endpoint_pos[axis]);
+    }
+    free(sap->aabb_min);
+    free(sap->aabb_max);
+    free(sap->body_active);
+    free(sap->pair_table);
+    free(sap->pairs.items);
+    free(sap->began.items);
+    free(sap->ended.items);
+    free(sap);
 }
 
-void sap_remove_body(SAPBroadphase *sap, int32_t body_index)
+/*
+ * Pair set
+ */
+
+static uint32_t pair_hash(int32_t a, int32_t b)
 {
-    if (!sap || body_index < 0 || body_index >= SAP_MAX_BODIES)
-        return;
+    uint32_t h = (uint32_t)a * 73856093u ^ (uint32_t)b * 19349663u;
+    return h ^ (h >> 15);
+}
 
-    sap->body_active[body_index] = false;
+static bool pair_list_push(SAPPairList *list, int32_t a, int32_t b)
+{
+    if (list->count == list->capacity)
+    {
+        int32_t capacity = list->capacity > 0 ? list->capacity * 2 : SAP_INITIAL_PAIRS;
+        SAPPair *items = (SAPPair *)realloc(list->items, sizeof(SAPPair) * (size_t)capacity);
+        if (!items)
+            return false;
+        list->items = items;
+        list->capacity = capacity;
+    }
+    list->items[list->count].body_a = a;
+    list->items[list->count].body_b = b;
+    list->count++;
+    return true;
 }
 
-static void insertion_sort_endpoints(SAPEndpoint *endpoints, int32_t count)
+/* Slot holding the pair, or the empty slot where it would go */
+static int32_t pair_slot(const SAPBroadphase *sap, int32_t a, int32_t b)
 {
-    for (int32_t i = 1; i < count; i++)
+    uint32_t mask = (uint32_t)sap->table_size - 1;
+    uint32_t slot = pair_hash(a, b) & mask;
+    for (;;)
     {
-        SAPEndpoint key = endpoints[i];
-        int32_t j = i - 1;
-        while (j >= 0 && endpoints[j].value > key.value)
-        {
-            endpoints[j + 1] = endpoints[j];
-            j--;
-        }
-        endpoints[j + 1] = key;
+        int32_t index = sap->pair_table[slot];
+        if (index < 0)
+            return (int32_t)slot;
+        const SAPPair *pair = &sap->pairs.items[index];
+        if (pair->body_a == a && pair->body_b == b)
+            return (int32_t)slot;
+        slot = (slot + 1) & mask;
     }
 }
 
-static bool aabb_overlap_1d(float min_a, float max_a, float min_b, float max_b)
+static bool pair_table_grow(SAPBroadphase *sap)
 {
-    return min_a <= max_b && min_b <= max_a;
+    int32_t size = sap->table_size * 2;
+    int32_t *table = (int32_t *)malloc(sizeof(int32_t) * (size_t)size);
+    if (!table)
+        return false;
+
+    memset(table, 0xFF, sizeof(int32_t) * (size_t)size);
+    free(sap->pair_table);
+    sap->pair_table = table;
+    sap->table_size = size;
+
+    for (int32_t i = 0; i < sap->pairs.count; i++)
+    {
+        const SAPPair *pair = &sap->pairs.items[i];
+        sap->pair_table[pair_slot(sap, pair->body_a, pair->body_b)] = i;
+    }
+    return true;
 }
 
-int32_t sap_query_pairs(SAPBroadphase *sap, SAPPair *out_pairs, int32_t max_pairs)
+static void pair_add(SAPBroadphase *sap, int32_t a, int32_t b)
 {
-    if (!sap || !out_pairs || max_pairs <= 0)
-        return 0;
+    if (a > b)
+    {
+        int32_t t = a;
+        a = b;
+        b = t;
+    }
+
+    if ((sap->pairs.count + 1) * 2 > sap->table_size && !pair_table_grow(sap))
+        return;
+
+    int32_t slot = pair_slot(sap, a, b);
+    if (sap->pair_table[slot] >= 0)
+        return;
+    if (!pair_list_push(&sap->pairs, a, b))
+        return;
+
+    sap->pair_table[slot] = sap->pairs.count - 1;
+    pair_list_push(&sap->began, a, b);
+}
+
+static void pair_remove(SAPBroadphase *sap, int32_t a, int32_t b)
+{
+    if (a > b)
+    {
+        int32_t t = a;
+        a = b;
+        b = t;
+    }
+
+    int32_t slot = pair_slot(sap, a, b);
+    int32_t index = sap->pair_table[slot];
+    if (index < 0)
+        return;
 
-    int32_t active_count = 0;
-    int16_t active_bodies[SAP_MAX_BODIES];
+    /* Backward-shift deletion keeps probe chains intact without tombstones */
+    uint32_t mask = (uint32_t)sap->table_size - 1;
+    uint32_t hole = (uint32_t)slot;
+    uint32_t next = (hole + 1) & mask;
+    while (sap->pair_table[next] >= 0)
+    {
+        const SAPPair *moved = &sap->pairs.items[sap->pair_table[next]];
+        uint32_t home = pair_hash(moved->body_a, moved->body_b) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            sap->pair_table[hole] = sap->pair_table[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    sap->pair_table[hole] = -1;
 
-    for (int32_t i = 0; i < SAP_MAX_BODIES; i++)
+    /* Swap the last pair into the gap */
+    int32_t last = sap->pairs.count - 1;
+    if (index != last)
     {
-        if (sap->body_active[i])
-            active_bodies[active_count++] = (int16_t)i;
+        SAPPair moved = sap->pairs.items[last];
+        sap->pairs.items[index] = moved;
+        sap->pair_table[pair_slot(sap, moved.body_a, moved.body_b)] = index;
     }
+    sap->pairs.count--;
 
-    if (active_count < 2)
-        return 0;
+    pair_list_push(&sap->ended, a, b);
+}
 
-    int32_t ep_count = active_count * 2;
-    SAPEndpoint *eps_x = sap->endpoints_x;
+/*
+ * Endpoint sorting
+ */
 
-    for (int32_t i = 0; i < active_count; i++)
+/* Inclusive, so a tie the sort did not swap is never missed (at worst a touching pair stays) */
+static bool aabb_overlap(const SAPBroadphase *sap, int32_t a, int32_t b)
+{
+    for (int32_t axis = 0; axis < 3; axis++)
     {
-        int16_t idx = active_bodies[i];
-        eps_x[i * 2].value = sap->aabb_min[idx][0];
-        eps_x[i * 2].body_index = idx;
-        eps_x[i * 2].is_max = 0;
-        eps_x[i * 2 + 1].value = sap->aabb_max[idx][0];
-        eps_x[i * 2 + 1].body_index = idx;
-        eps_x[i * 2 + 1].is_max = 1;
+        if (sap->aabb_min[a][axis] > sap->aabb_max[b][axis] ||
+            sap->aabb_min[b][axis] > sap->aabb_max[a][axis])
+            return false;
     }
+    return true;
+}
 
-    insertion_sort_endpoints(eps_x, ep_count);
+static void endpoint_place(SAPBroadphase *sap, int32_t axis, int32_t pos, SAPEndpoint ep)
+{
+    sap->endpoints[axis][pos] = ep;
+    sap->endpoint_pos[axis][ep.body_index * 2 + ep.is_max] = pos;
+}
 
-    int32_t pair_count = 0;
-    bool active_set[SAP_MAX_BODIES];
-    memset(active_set, 0, sizeof(active_set));
+/* Bounds are checked against every body's current values, so axes can be sorted one at a time */
+static void sort_down(SAPBroadphase *sap, int32_t axis, int32_t pos)
+{
+    SAPEndpoint *eps = sap->endpoints[axis];
+    SAPEndpoint key = eps[pos];
 
-    for (int32_t i = 0; i < ep_count && pair_count < max_pairs; i++)
+    while (pos > 0 && eps[pos - 1].value > key.value)
     {
-        SAPEndpoint *ep = &eps_x[i];
-        int16_t body_idx = ep->body_index;
+        SAPEndpoint prev = eps[pos - 1];
+        if (!key.is_max && prev.is_max)
+        {
+            if (aabb_overlap(sap, key.body_index, prev.body_index))
+                pair_add(sap, key.body_index, prev.body_index);
+        }
+        else if (key.is_max && !prev.is_max)
+        {
+            pair_remove(sap, key.body_index, prev.body_index);
+        }
+        endpoint_place(sap, axis, pos, prev);
+        pos--;
+    }
+    endpoint_place(sap, axis, pos, key);
+}
+
+static void sort_up(SAPBroadphase *sap, int32_t axis, int32_t pos)
+{
+    SAPEndpoint *eps = sap->endpoints[axis];
+    SAPEndpoint key = eps[pos];
 
-        if (ep->is_max == 0)
+    while (pos + 1 < sap->endpoint_count && eps[pos + 1].value < key.value)
+    {
+        SAPEndpoint next = eps[pos + 1];
+        if (key.is_max && !next.is_max)
+        {
+            if (aabb_overlap(sap, key.body_index, next.body_index))
+                pair_add(sap, key.body_index, next.body_index);
+        }
+        else if (!key.is_max && next.is_max)
         {
-            for (int32_t j = 0; j < SAP_MAX_BODIES && pair_count < max_pairs; j++)
-            {
-                if (!active_set[j] || j == body_idx)
-                    continue;
+            pair_remove(sap, key.body_index, next.body_index);
+        }
+        endpoint_place(sap, axis, pos, next);
+        pos++;
+    }
+    endpoint_place(sap, axis, pos, key);
+}
 
-                if (!aabb_overlap_1d(sap->aabb_min[body_idx][1], sap->aabb_max[body_idx][1],
-                                     sap->aabb_min[j][1], sap->aabb_max[j][1]))
-                    continue;
+/* Moves a body's endpoints to new bounds: growing moves first, so adds precede removes */
+static void move_body(SAPBroadphase *sap, int32_t body, const float new_min[3], const float new_max[3])
+{
+    float old_min[3], old_max[3];
+    memcpy(old_min, sap->aabb_min[body], sizeof(old_min));
+    memcpy(old_max, sap->aabb_max[body], sizeof(old_max));
+    memcpy(sap->aabb_min[body], new_min, sizeof(old_min));
+    memcpy(sap->aabb_max[body], new_max, sizeof(old_max));
 
-                if (!aabb_overlap_1d(sap->aabb_min[body_idx][2], sap->aabb_max[body_idx][2],
-                                     sap->aabb_min[j][2], sap->aabb_max[j][2]))
-                    continue;
+    for (int32_t axis = 0; axis < 3; axis++)
+    {
+        int32_t min_pos = sap->endpoint_pos[axis][body * 2];
+        int32_t max_pos = sap->endpoint_pos[axis][body * 2 + 1];
+        sap->endpoints[axis][min_pos].value = new_min[axis];
+        sap->endpoints[axis][max_pos].value = new_max[axis];
 
-                int16_t a = body_idx < j ? body_idx : (int16_t)j;
-                int16_t b = body_idx < j ? (int16_t)j : body_idx;
+        if (new_min[axis] < old_min[axis])
+            sort_down(sap, axis, min_pos);
+        if (new_max[axis] > old_max[axis])
+            sort_up(sap, axis, sap->endpoint_pos[axis][body * 2 + 1]);
+        if (new_min[axis] > old_min[axis])
+            sort_up(sap, axis, sap->endpoint_pos[axis][body * 2]);
+        if (new_max[axis] < old_max[axis])
+            sort_down(sap, axis, sap->endpoint_pos[axis][body * 2 + 1]);
+    }
+}
 
-                out_pairs[pair_count].body_a = a;
-                out_pairs[pair_count].body_b = b;
-                pair_count++;
-            }
+void sap_update_body(SAPBroadphase *sap, int32_t body_index,
+                     Vec3 aabb_min, Vec3 aabb_max, bool active)
+{
+    if (!sap || body_index < 0 || body_index >= sap->max_bodies)
+        return;
 
-            active_set[body_idx] = true;
-        }
-        else
+    if (!active)
+    {
+        sap_remove_body(sap, body_index);
+        return;
+    }
+
+    float new_min[3] = {aabb_min.x, aabb_min.y, aabb_min.z};
+    float new_max[3] = {aabb_max.x, aabb_max.y, aabb_max.z};
+
+    if (!sap->body_active[body_index])
+    {
+        /* Enter parked past every endpoint, then sort into place like a move */
+        for (int32_t axis = 0; axis < 3; axis++)
         {
-            active_set[body_idx] = false;
+            SAPEndpoint ep_min = {SAP_SENTINEL, body_index, 0};
+            SAPEndpoint ep_max = {SAP_SENTINEL, body_index, 1};
+            endpoint_place(sap, axis, sap->endpoint_count, ep_min);
+            endpoint_place(sap, axis, sap->endpoint_count + 1, ep_max);
+            sap->aabb_min[body_index][axis] = SAP_SENTINEL;
+            sap->aabb_max[body_index][axis] = SAP_SENTINEL;
         }
+        sap->endpoint_count += 2;
+        sap->body_active[body_index] = true;
+        sap->body_count++;
+    }
+    else if (memcmp(new_min, sap->aabb_min[body_index], sizeof(new_min)) == 0 &&
+             memcmp(new_max, sap->aabb_max[body_index], sizeof(new_max)) == 0)
+    {
+        return;
     }
 
-    sap->endpoint_count = ep_count;
-    return pair_count;
+    move_body(sap, body_index, new_min, new_max);
+}
+
+void sap_remove_body(SAPBroadphase *sap, int32_t body_index)
+{
+    if (!sap || body_index < 0 || body_index >= sap->max_bodies || !sap->body_active[body_index])
+        return;
+
+    /* Parking at the sentinel ends every overlap and leaves the endpoints last */
+    float parked[3] = {SAP_SENTINEL, SAP_SENTINEL, SAP_SENTINEL};
+    move_body(sap, body_index, parked, parked);
+
+    sap->endpoint_count -= 2;
+    sap->body_active[body_index] = false;
+    sap->body_count--;
+}
+
+const SAPPair *sap_get_pairs(const SAPBroadphase *sap, int32_t *out_count)
+{
+    if (out_count)
+        *out_count = sap ? sap->pairs.count : 0;
+    return sap ? sap->pairs.items : NULL;
+}
+
+bool sap_has_pair(const SAPBroadphase *sap, int32_t body_a, int32_t body_b)
+{
+    if (!sap)
+        return false;
+    if (body_a > body_b)
+    {
+        int32_t t = body_a;
+        body_a = body_b;
+        body_b = t;
+    }
+    return sap->pair_table[pair_slot(sap, body_a, body_b)] >= 0;
+}
+
+const SAPPair *sap_get_began(const SAPBroadphase *sap, int32_t *out_count)
+{
+    if (out_count)
+        *out_count = sap ? sap->began.count : 0;
+    return sap ? sap->began.items : NULL;
+}
+
+const SAPPair *sap_get_ended(const SAPBroadphase *sap, int32_t *out_count)
+{
+    if (out_count)
+        *out_count = sap ? sap->ended.count : 0;
+    return sap ? sap->ended.items : NULL;
+}
+
+void sap_clear_events(SAPBroadphase *sap)
+{
+    if (!sap)
+        return;
+    sap->began.count = 0;
+    sap->ended.count = 0;
 }
@@ -11,38 +11,77 @@ extern "C"
 {
 #endif
 
-#define SAP_MAX_BODIES 512
-#define SAP_MAX_ENDPOINTS (SAP_MAX_BODIES * 2)
-#define SAP_MAX_PAIRS 256
+/*
+ * Incremental Sweep and Prune
+ *
+ * AABB endpoints stay sorted on all three axes between updates. Moving a
+ * body bubbles its endpoints to their new place, and every time a min
+ * endpoint crosses a max endpoint two boxes start or stop overlapping on
+ * that axis, so the overlapping pair set is maintained from those swaps
+ * instead of being re-derived:
+ * - an update costs O(swaps), near zero for coherent motion
+ * - bodies that are not updated (sleeping) cost nothing
+ * - pairs live in a hashed set that grows as needed; there is no pair cap
+ *
+ * Pairs that start or stop overlapping are also recorded as events until
+ * sap_clear_events(). A pair can begin and end between two clears.
+ */
+
+#define SAP_INITIAL_PAIRS 256
 
 typedef struct {
     float value;
-    int16_t body_index;
+    int32_t body_index;
     uint8_t is_max;
-    uint8_t _pad;
 } SAPEndpoint;
 
 typedef struct {
-    int16_t body_a;
-    int16_t body_b;
+    int32_t body_a; /* body_a < body_b */
+    int32_t body_b;
 } SAPPair;
 
 typedef struct {
-    SAPEndpoint endpoints_x[SAP_MAX_ENDPOINTS];
-    SAPEndpoint endpoints_y[SAP_MAX_ENDPOINTS];
-    SAPEndpoint endpoints_z[SAP_MAX_ENDPOINTS];
+    SAPPair *items;
+    int32_t count;
+    int32_t capacity;
+} SAPPairList;
+
+typedef struct {
+    int32_t max_bodies;
+
+    SAPEndpoint *endpoints[3]; /* Sorted by value; two per body in the set */
+    int32_t *endpoint_pos[3];  /* [body * 2 + is_max] -> index into endpoints */
     int32_t endpoint_count;
 
-    float aabb_min[SAP_MAX_BODIES][3];
-    float aabb_max[SAP_MAX_BODIES][3];
-    bool body_active[SAP_MAX_BODIES];
+    float (*aabb_min)[3];
+    float (*aabb_max)[3];
+    bool *body_active;
+    int32_t body_count;
+
+    /* Overlapping pairs: dense list indexed by an open-addressed table */
+    SAPPairList pairs;
+    int32_t *pair_table; /* -1 = empty */
+    int32_t table_size;  /* Power of two, > 2x pairs */
+
+    SAPPairList began;
+    SAPPairList ended;
 } SAPBroadphase;
 
-void sap_init(SAPBroadphase *sap);
+SAPBroadphase *sap_create(int32_t max_bodies);
+void sap_destroy(SAPBroadphase *sap);
+
+/* Inserts or moves a body; active = false removes it */
 void sap_update_body(SAPBroadphase *sap, int32_t body_index,
                      Vec3 aabb_min, Vec3 aabb_max, bool active);
 void sap_remove_body(SAPBroadphase *sap, int32_t body_index);
-int32_t sap_query_pairs(SAPBroadphase *sap, SAPPair *out_pairs, int32_t max_pairs);
+
+/* Every currently overlapping pair; valid until the next update */
+const SAPPair *sap_get_pairs(const SAPBroadphase *sap, int32_t *out_count);
+bool sap_has_pair(const SAPBroadphase *sap, int32_t body_a, int32_t body_b);
+
+const SAPPair *sap_get_began(const SAPBroadphase *sap, int32_t *out_count);
+const SAPPair *sap_get_ended(const SAPBroadphase *sap, int32_t *out_count);
+void sap_clear_events(SAPBroadphase *sap);
 
 #ifdef __cplusplus
 }
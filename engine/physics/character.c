@@ -1,8 +1,13 @@
 #include "character.h"
 #include "rigidbody.h"
+#include "island.h"
 #include "engine/voxel/bvh.h"
 #include <math.h>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 void character_init(Character *character, Vec3 start_position)
 {
     if (!character)
@@ -18,172 +23,698 @@ void character_init(Character *character, Vec3 start_position)
     character->ground_normal = vec3_create(0.0f, 1.0f, 0.0f);
 }
 
-static void get_capsule_sample_points(Character *character, Vec3 points[CHAR_SAMPLE_POINTS])
+/* Solid boxes near one move: terrain runs and object colliders, in world space */
+typedef struct
+{
+    Vec3 min[CHAR_MAX_BOXES];
+    Vec3 max[CHAR_MAX_BOXES];
+    int32_t count;
+    bool full; /* A box did not fit */
+} CharBoxes;
+
+/* Upright capsule: a segment from base (feet + radius) up by length, rounded by radius */
+typedef struct
+{
+    float radius;
+    float length;
+} CharCapsule;
+
+typedef struct
+{
+    bool hit;
+    float t; /* Fraction of the move before contact */
+    Vec3 normal;
+} CharSweepHit;
+
+static inline CharCapsule char_capsule(const Character *character)
+{
+    CharCapsule cap;
+    cap.radius = character->radius;
+    cap.length = fmaxf(character->height - 2.0f * character->radius, 0.0f);
+    return cap;
+}
+
+static inline Vec3 char_base(const Character *character)
 {
-    Vec3 pos = character->position;
-    float r = character->radius;
-    float h = character->height;
-    float bottom_y = pos.y;
-    float top_y = pos.y + h;
-    float middle_y = pos.y + h * 0.5f;
+    return vec3_create(character->position.x, character->position.y + character->radius, character->position.z);
+}
 
-    float angle_step = K_PI * 0.5f;
-    for (int32_t i = 0; i < 4; i++)
+static inline bool char_push_box(CharBoxes *boxes, Vec3 min, Vec3 max)
+{
+    if (boxes->count >= CHAR_MAX_BOXES)
     {
-        float angle = (float)i * angle_step;
-        float dx = cosf(angle) * r;
-        float dz = sinf(angle) * r;
+        boxes->full = true;
+        return false;
+    }
+    boxes->min[boxes->count] = min;
+    boxes->max[boxes->count] = max;
+    boxes->count++;
+    return true;
+}
 
-        points[i] = vec3_create(pos.x + dx, bottom_y, pos.z + dz);
-        points[i + 4] = vec3_create(pos.x + dx, top_y, pos.z + dz);
-        points[i + 8] = vec3_create(pos.x + dx, middle_y, pos.z + dz);
+/* Last chunk looked up; consecutive rows mostly stay in one chunk */
+typedef struct
+{
+    int32_t cx, cy, cz;
+    const Chunk *chunk;
+} CharChunkCache;
+
+static inline const Chunk *char_chunk(CharChunkCache *cache, VoxelVolume *terrain, int32_t cx, int32_t cy, int32_t cz)
+{
+    if (cx != cache->cx || cy != cache->cy || cz != cache->cz)
+    {
+        cache->cx = cx;
+        cache->cy = cy;
+        cache->cz = cz;
+        cache->chunk = volume_get_chunk(terrain, cx, cy, cz);
     }
+    return cache->chunk;
 }
 
-static bool check_terrain_collision(VoxelVolume *terrain, Vec3 point, Vec3 *out_normal)
+/* Solid voxels x0..x1 (at most 64) of terrain row (y, z); bit i is voxel x0 + i */
+static uint64_t char_terrain_row(CharChunkCache *cache, VoxelVolume *terrain, int32_t x0, int32_t x1, int32_t y,
+                                 int32_t z)
 {
-    if (!terrain)
-        return false;
+    int32_t ly = y & CHUNK_SIZE_MASK;
+    int32_t lz = z & CHUNK_SIZE_MASK;
+    int32_t region_yz = (ly >> CHUNK_REGION_BITS) * CHUNK_MIP0_SIZE +
+                        (lz >> CHUNK_REGION_BITS) * CHUNK_MIP0_SIZE * CHUNK_MIP0_SIZE;
+    uint64_t mask = 0;
+
+    int32_t x = x0;
+    while (x <= x1)
+    {
+        int32_t chunk_end = ((x >> CHUNK_SIZE_BITS) + 1) << CHUNK_SIZE_BITS;
+        if (chunk_end > x1 + 1)
+            chunk_end = x1 + 1;
 
-    uint8_t mat = volume_get_at(terrain, point);
-    if (mat == 0)
-        return false;
+        const Chunk *chunk = char_chunk(cache, terrain, x >> CHUNK_SIZE_BITS, y >> CHUNK_SIZE_BITS,
+                                        z >> CHUNK_SIZE_BITS);
+        if (!chunk || !chunk->occupancy.has_any)
+        {
+            x = chunk_end;
+            continue;
+        }
+
+        while (x < chunk_end)
+        {
+            int32_t region_end = ((x >> CHUNK_REGION_BITS) + 1) << CHUNK_REGION_BITS;
+            if (region_end > chunk_end)
+                region_end = chunk_end;
+
+            int32_t region = ((x & CHUNK_SIZE_MASK) >> CHUNK_REGION_BITS) + region_yz;
+            if (chunk->occupancy.level0 & (1ULL << region))
+            {
+                for (; x < region_end; x++)
+                {
+                    if (chunk->voxels[chunk_voxel_index(x & CHUNK_SIZE_MASK, ly, lz)].material != MATERIAL_EMPTY)
+                        mask |= 1ULL << (x - x0);
+                }
+            }
+            x = region_end;
+        }
+    }
+    return mask;
+}
+
+#define CHAR_MAX_ROW_RUNS 64
+#define CHAR_MAX_COARSE_SHIFT 3 /* Coarsest cells gathered: 8 voxels on a side */
 
-    float probe_dist = terrain->voxel_size * 0.5f;
-    float dx = (volume_get_at(terrain, vec3_create(point.x + probe_dist, point.y, point.z)) != 0 ? 1.0f : 0.0f) -
-               (volume_get_at(terrain, vec3_create(point.x - probe_dist, point.y, point.z)) != 0 ? 1.0f : 0.0f);
-    float dy = (volume_get_at(terrain, vec3_create(point.x, point.y + probe_dist, point.z)) != 0 ? 1.0f : 0.0f) -
-               (volume_get_at(terrain, vec3_create(point.x, point.y - probe_dist, point.z)) != 0 ? 1.0f : 0.0f);
-    float dz = (volume_get_at(terrain, vec3_create(point.x, point.y, point.z + probe_dist)) != 0 ? 1.0f : 0.0f) -
-               (volume_get_at(terrain, vec3_create(point.x, point.y, point.z - probe_dist)) != 0 ? 1.0f : 0.0f);
-
-    Vec3 gradient = vec3_create(-dx, -dy, -dz);
-    float len = vec3_length(gradient);
-    if (len > K_EPSILON)
-        *out_normal = vec3_scale(gradient, 1.0f / len);
-    else
-        *out_normal = vec3_create(0.0f, 1.0f, 0.0f);
+/* Index of the lowest set bit; bits must be non-zero */
+static inline int32_t char_lowest_bit(uint64_t bits)
+{
+#ifdef _MSC_VER
+    unsigned long bit_index;
+    _BitScanForward64(&bit_index, bits);
+    return (int32_t)bit_index;
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
 
+/* Terrain voxels inside [lo, hi], clamped to the volume; false when none are */
+static bool char_voxel_range(const VoxelVolume *terrain, Vec3 lo, Vec3 hi, int32_t g0[3], int32_t g1[3])
+{
+    float inv_vs = 1.0f / terrain->voxel_size;
+    const float vol_min[3] = {terrain->bounds.min_x, terrain->bounds.min_y, terrain->bounds.min_z};
+    const float lo3[3] = {lo.x, lo.y, lo.z};
+    const float hi3[3] = {hi.x, hi.y, hi.z};
+    const int32_t size[3] = {terrain->chunks_x * CHUNK_SIZE, terrain->chunks_y * CHUNK_SIZE,
+                             terrain->chunks_z * CHUNK_SIZE};
+    for (int32_t a = 0; a < 3; a++)
+    {
+        float f0 = floorf((lo3[a] - vol_min[a]) * inv_vs);
+        float f1 = floorf((hi3[a] - vol_min[a]) * inv_vs);
+        if (f1 < 0.0f || f0 >= (float)size[a])
+            return false;
+        g0[a] = f0 < 0.0f ? 0 : (int32_t)f0;
+        g1[a] = f1 >= (float)size[a] ? size[a] - 1 : (int32_t)f1;
+    }
     return true;
 }
 
-static bool check_object_collision(VoxelObjectWorld *objects, Vec3 point, Vec3 *out_normal)
+/*
+ * Cells x0..x1 (at most 64) of row (y, z) on the grid of cells 2^shift
+ * voxels on a side; bit i is cell x0 + i, set when any voxel in it is solid
+ */
+static uint64_t char_coarse_row(CharChunkCache *cache, VoxelVolume *terrain, int32_t x0, int32_t x1, int32_t y,
+                                int32_t z, int32_t shift)
 {
-    if (!objects || !objects->bvh || objects->bvh->node_count <= 0)
+    int32_t fx0 = x0 << shift;
+    int32_t fx1 = ((x1 + 1) << shift) - 1;
+    int32_t fy1 = ((y + 1) << shift) - 1;
+    int32_t fz1 = ((z + 1) << shift) - 1;
+    if (fx1 >= terrain->chunks_x * CHUNK_SIZE)
+        fx1 = terrain->chunks_x * CHUNK_SIZE - 1;
+    if (fy1 >= terrain->chunks_y * CHUNK_SIZE)
+        fy1 = terrain->chunks_y * CHUNK_SIZE - 1;
+    if (fz1 >= terrain->chunks_z * CHUNK_SIZE)
+        fz1 = terrain->chunks_z * CHUNK_SIZE - 1;
+
+    uint64_t mask = 0;
+    for (int32_t fz = z << shift; fz <= fz1; fz++)
+    {
+        for (int32_t fy = y << shift; fy <= fy1; fy++)
+        {
+            for (int32_t xs = fx0; xs <= fx1; xs += 64)
+            {
+                uint64_t bits = char_terrain_row(cache, terrain, xs, xs + 63 < fx1 ? xs + 63 : fx1, fy, fz);
+                while (bits)
+                {
+                    mask |= 1ULL << ((xs + char_lowest_bit(bits) - fx0) >> shift);
+                    bits &= bits - 1;
+                }
+            }
+        }
+    }
+    return mask;
+}
+
+/*
+ * Terrain rows over the region all moves of one batch task can reach, read
+ * from the chunks once, 64 voxels per read. Moves close together (a crowd,
+ * a squad) then take their rows from here instead of each reading its own
+ * narrow rows. Rows come out exactly as char_terrain_row returns them, so
+ * the boxes built from them are the same too.
+ */
+#define CHAR_ROW_CACHE_WORDS 4096
+
+typedef struct
+{
+    int32_t g0[3]; /* Voxel of bit 0 of the first row */
+    int32_t g1[3];
+    int32_t words; /* Words per row */
+    uint64_t solid[CHAR_ROW_CACHE_WORDS];
+} CharRowCache;
+
+static inline uint64_t char_row_bits(const uint64_t *row, int32_t words, int32_t bit)
+{
+    int32_t w = bit >> 6, s = bit & 63;
+    uint64_t bits = row[w] >> s;
+    if (s && w + 1 < words)
+        bits |= row[w + 1] << (64 - s);
+    return bits;
+}
+
+/* Reads the rows of [g0, g1]; false when they do not fit */
+static bool char_row_cache_fill(CharRowCache *rows, VoxelVolume *terrain, const int32_t g0[3], const int32_t g1[3])
+{
+    int32_t words = ((g1[0] - g0[0]) >> 6) + 1;
+    int64_t total = (int64_t)words * (g1[1] - g0[1] + 1) * (g1[2] - g0[2] + 1);
+    if (total > CHAR_ROW_CACHE_WORDS)
         return false;
 
-    BVHQueryResult candidates = bvh_query_sphere(objects->bvh, point, CHAR_CAPSULE_RADIUS);
+    for (int32_t a = 0; a < 3; a++)
+    {
+        rows->g0[a] = g0[a];
+        rows->g1[a] = g1[a];
+    }
+    rows->words = words;
 
-    for (int32_t c = 0; c < candidates.count; c++)
+    CharChunkCache cache = {-1, -1, -1, NULL};
+    uint64_t *row = rows->solid;
+    for (int32_t z = g0[2]; z <= g1[2]; z++)
     {
-        int32_t i = candidates.indices[c];
-        if (i < 0 || i >= objects->object_count)
-            continue;
+        for (int32_t y = g0[1]; y <= g1[1]; y++)
+        {
+            for (int32_t xs = g0[0]; xs <= g1[0]; xs += 64)
+                *row++ = char_terrain_row(&cache, terrain, xs, xs + 63 < g1[0] ? xs + 63 : g1[0], y, z);
+        }
+    }
+    return true;
+}
 
-        VoxelObject *obj = &objects->objects[i];
-        if (!obj->active)
-            continue;
+/* Solid voxels x0..x1 (at most 64) of a cached row; bit i is voxel x0 + i */
+static inline uint64_t char_cached_row(const CharRowCache *rows, int32_t x0, int32_t x1, int32_t y, int32_t z)
+{
+    int32_t len = x1 - x0 + 1;
+    uint64_t mask = len >= 64 ? ~0ULL : (1ULL << len) - 1;
+    size_t row = ((size_t)(z - rows->g0[2]) * (size_t)(rows->g1[1] - rows->g0[1] + 1) + (size_t)(y - rows->g0[1])) *
+                 (size_t)rows->words;
+    return char_row_bits(&rows->solid[row], rows->words, x0 - rows->g0[0]) & mask;
+}
 
-        Vec3 delta = vec3_sub(point, obj->position);
-        float dist = vec3_length(delta);
-        if (dist > obj->radius)
-            continue;
+/*
+ * Terrain voxels overlapping [lo, hi] as boxes: one per run of a row, grown
+ * upwards while the run repeats. With shift > 0 the rows are those of cells
+ * 2^shift voxels on a side, and rows stays unused.
+ */
+static void char_gather_terrain(CharBoxes *boxes, VoxelVolume *terrain, const CharRowCache *rows, Vec3 lo,
+                                Vec3 hi, int32_t shift)
+{
+    if (!terrain)
+        return;
+
+    float vs = terrain->voxel_size * (float)(1 << shift);
+    const float vol_min[3] = {terrain->bounds.min_x, terrain->bounds.min_y, terrain->bounds.min_z};
+    int32_t g0[3], g1[3];
+    if (!char_voxel_range(terrain, lo, hi, g0, g1))
+        return;
+    for (int32_t a = 0; a < 3; a++)
+    {
+        g0[a] >>= shift;
+        g1[a] >>= shift;
+    }
 
-        Vec3 local = quat_rotate_vec3(quat_conjugate(obj->orientation), delta);
-        Vec3 he = obj->shape_half_extents;
+    /* Boxes ending on the previous row of this z slice, by run, in x order */
+    int32_t prev[CHAR_MAX_ROW_RUNS], cur[CHAR_MAX_ROW_RUNS];
+    int32_t prev_count, cur_count;
+    /* Boxes ending on the previous z slice */
+    int32_t slab[CHAR_MAX_ROW_RUNS];
+    int32_t slab_count = 0;
+    CharChunkCache cache = {-1, -1, -1, NULL};
 
-        if (fabsf(local.x) <= he.x &&
-            fabsf(local.y) <= he.y &&
-            fabsf(local.z) <= he.z)
+    for (int32_t z = g0[2]; z <= g1[2]; z++)
+    {
+        float min_z = vol_min[2] + (float)z * vs;
+        float max_z = min_z + vs;
+        int32_t slice_begin = boxes->count;
+        prev_count = 0;
+        for (int32_t y = g0[1]; y <= g1[1]; y++)
         {
-            float dx = he.x - fabsf(local.x);
-            float dy = he.y - fabsf(local.y);
-            float dz = he.z - fabsf(local.z);
-
-            float mat3[9];
-            quat_to_mat3(obj->orientation, mat3);
+            float min_y = vol_min[1] + (float)y * vs;
+            float max_y = min_y + vs;
+            int32_t p = 0;
+            cur_count = 0;
 
-            if (dx <= dy && dx <= dz)
+            for (int32_t xs = g0[0]; xs <= g1[0]; xs += 64)
             {
-                float sign = local.x >= 0.0f ? 1.0f : -1.0f;
-                *out_normal = vec3_create(mat3[0] * sign, mat3[3] * sign, mat3[6] * sign);
+                int32_t xe = xs + 63 < g1[0] ? xs + 63 : g1[0];
+                uint64_t row = shift  ? char_coarse_row(&cache, terrain, xs, xe, y, z, shift)
+                               : rows ? char_cached_row(rows, xs, xe, y, z)
+                                      : char_terrain_row(&cache, terrain, xs, xe, y, z);
+                while (row)
+                {
+                    int32_t start = char_lowest_bit(row);
+                    uint64_t rest = ~(row >> start);
+                    int32_t len = rest ? char_lowest_bit(rest) : 64 - start;
+                    row &= (len + start >= 64) ? ((1ULL << start) - 1) : ~(((1ULL << len) - 1) << start);
+
+                    float min_x = vol_min[0] + (float)(xs + start) * vs;
+                    float max_x = vol_min[0] + (float)(xs + start + len) * vs;
+
+                    /* Same run on the row below: grow that box */
+                    while (p < prev_count && boxes->min[prev[p]].x < min_x)
+                        p++;
+                    int32_t id = -1;
+                    if (p < prev_count && boxes->min[prev[p]].x == min_x && boxes->max[prev[p]].x == max_x)
+                    {
+                        id = prev[p++];
+                        boxes->max[id].y = max_y;
+                    }
+                    else if (char_push_box(boxes, vec3_create(min_x, min_y, min_z), vec3_create(max_x, max_y, max_z)))
+                    {
+                        id = boxes->count - 1;
+                    }
+                    if (id >= 0 && cur_count < CHAR_MAX_ROW_RUNS)
+                        cur[cur_count++] = id;
+                }
             }
-            else if (dy <= dx && dy <= dz)
+
+            for (int32_t i = 0; i < cur_count; i++)
+                prev[i] = cur[i];
+            prev_count = cur_count;
+        }
+
+        /* Boxes of this slice matching one on the previous slice grow it instead */
+        int32_t kept = slice_begin;
+        int32_t next_slab_count = 0;
+        int32_t next_slab[CHAR_MAX_ROW_RUNS];
+        for (int32_t i = slice_begin; i < boxes->count; i++)
+        {
+            int32_t id = -1;
+            for (int32_t k = 0; k < slab_count; k++)
             {
-                float sign = local.y >= 0.0f ? 1.0f : -1.0f;
-                *out_normal = vec3_create(mat3[1] * sign, mat3[4] * sign, mat3[7] * sign);
+                int32_t j = slab[k];
+                if (boxes->min[j].x == boxes->min[i].x && boxes->max[j].x == boxes->max[i].x &&
+                    boxes->min[j].y == boxes->min[i].y && boxes->max[j].y == boxes->max[i].y)
+                {
+                    id = j;
+                    boxes->max[j].z = max_z;
+                    break;
+                }
             }
-            else
+            if (id < 0)
             {
-                float sign = local.z >= 0.0f ? 1.0f : -1.0f;
-                *out_normal = vec3_create(mat3[2] * sign, mat3[5] * sign, mat3[8] * sign);
+                id = kept;
+                boxes->min[kept] = boxes->min[i];
+                boxes->max[kept] = boxes->max[i];
+                kept++;
             }
-            return true;
+            if (next_slab_count < CHAR_MAX_ROW_RUNS)
+                next_slab[next_slab_count++] = id;
         }
+        boxes->count = kept;
+        for (int32_t i = 0; i < next_slab_count; i++)
+            slab[i] = next_slab[i];
+        slab_count = next_slab_count;
+        if (boxes->full)
+            return;
     }
+}
+
+/* Voxel objects overlapping [lo, hi]: world boxes around their collider boxes, or their shape boxes */
+static void char_gather_objects(CharBoxes *boxes, VoxelObjectWorld *objects, Vec3 lo, Vec3 hi, bool colliders)
+{
+    if (!objects || !objects->bvh || objects->bvh->node_count <= 0)
+        return;
+
+    BVHQueryResult candidates = bvh_query_aabb(objects->bvh, lo, hi);
+    for (int32_t c = 0; c < candidates.count; c++)
+    {
+        int32_t i = candidates.indices[c];
+        if (i < 0 || i >= objects->object_count)
+            continue;
+
+        const VoxelObject *obj = &objects->objects[i];
+        if (!obj->active)
+            continue;
+
+        VoxelObjectPose pose = voxel_object_pose(objects, i);
+        float m[9];
+        quat_to_mat3(pose.orientation, m);
 
-    return false;
+        /* A full collider box list may be missing voxels; the shape box covers them all */
+        bool use_colliders = colliders && obj->collider_box_count > 0 &&
+                             obj->collider_box_count < VOBJ_MAX_COLLIDER_BOXES;
+        int32_t count = use_colliders ? obj->collider_box_count : 1;
+        for (int32_t k = 0; k < count; k++)
+        {
+            Vec3 local_min = use_colliders ? obj->collider_boxes[k].local_min : vec3_neg(obj->shape_half_extents);
+            Vec3 local_max = use_colliders ? obj->collider_boxes[k].local_max : obj->shape_half_extents;
+            Vec3 c_local = vec3_scale(vec3_add(local_min, local_max), 0.5f);
+            Vec3 e = vec3_scale(vec3_sub(local_max, local_min), 0.5f);
+
+            Vec3 center = vec3_add(pose.position, mat3_transform_vec3(m, c_local));
+            Vec3 half = vec3_create(fabsf(m[0]) * e.x + fabsf(m[1]) * e.y + fabsf(m[2]) * e.z,
+                                    fabsf(m[3]) * e.x + fabsf(m[4]) * e.y + fabsf(m[5]) * e.z,
+                                    fabsf(m[6]) * e.x + fabsf(m[7]) * e.y + fabsf(m[8]) * e.z);
+            Vec3 bmin = vec3_sub(center, half);
+            Vec3 bmax = vec3_add(center, half);
+            if (bmax.x < lo.x || bmin.x > hi.x || bmax.y < lo.y || bmin.y > hi.y || bmax.z < lo.z || bmin.z > hi.z)
+                continue;
+            char_push_box(boxes, bmin, bmax);
+        }
+    }
 }
 
-static bool check_collision(VoxelVolume *terrain, VoxelObjectWorld *objects, Vec3 point, Vec3 *out_normal)
+/* Everything the move can reach: the capsule grown by the move, a step up and the ground probe below */
+static void char_reach(const Character *character, Vec3 move_delta, Vec3 *out_lo, Vec3 *out_hi)
 {
-    Vec3 terrain_normal = vec3_zero();
-    Vec3 object_normal = vec3_zero();
+    float reach = vec3_length(move_delta) + 4.0f * CHAR_SKIN_WIDTH;
+    Vec3 p = character->position;
+    *out_lo = vec3_create(p.x - character->radius - reach,
+                          p.y - reach - CHAR_GROUND_CHECK_DIST,
+                          p.z - character->radius - reach);
+    *out_hi = vec3_create(p.x + character->radius + reach,
+                          p.y + character->height + reach + character->step_height,
+                          p.z + character->radius + reach);
+}
 
-    bool hit_terrain = check_terrain_collision(terrain, point, &terrain_normal);
-    bool hit_object = check_object_collision(objects, point, &object_normal);
+/*
+ * Boxes for one move. Nothing in reach is ever left out: objects whose
+ * collider boxes do not all fit fall back to one shape box each, and
+ * terrain runs that do not fit are gathered again over cells 2, 4 then 8
+ * voxels on a side, each solid when any voxel in it is. False when even
+ * those do not fit.
+ */
+static bool char_gather(CharBoxes *boxes, const Character *character, VoxelVolume *terrain,
+                        const CharRowCache *rows, VoxelObjectWorld *objects, Vec3 move_delta)
+{
+    Vec3 lo, hi;
+    char_reach(character, move_delta, &lo, &hi);
+    boxes->count = 0;
+    boxes->full = false;
+    char_gather_objects(boxes, objects, lo, hi, true);
+    if (boxes->full)
+    {
+        boxes->count = 0;
+        boxes->full = false;
+        char_gather_objects(boxes, objects, lo, hi, false);
+    }
 
-    if (hit_terrain && hit_object)
+    int32_t object_count = boxes->count;
+    for (int32_t shift = 0; !boxes->full; shift++)
     {
-        *out_normal = vec3_normalize(vec3_add(terrain_normal, object_normal));
-        return true;
+        char_gather_terrain(boxes, terrain, rows, lo, hi, shift);
+        if (!boxes->full || shift == CHAR_MAX_COARSE_SHIFT)
+            break;
+        boxes->count = object_count;
+        boxes->full = false;
     }
-    else if (hit_terrain)
+    return !boxes->full;
+}
+
+/* Distance from p to a box with the outward normal; inside, minus the depth to the nearest face */
+static float box_signed_distance(Vec3 p, Vec3 bmin, Vec3 bmax, Vec3 *out_normal)
+{
+    Vec3 closest = vec3_create(fminf(fmaxf(p.x, bmin.x), bmax.x),
+                               fminf(fmaxf(p.y, bmin.y), bmax.y),
+                               fminf(fmaxf(p.z, bmin.z), bmax.z));
+    Vec3 d = vec3_sub(p, closest);
+    float dist_sq = vec3_length_sq(d);
+    if (dist_sq > 1e-12f)
     {
-        *out_normal = terrain_normal;
-        return true;
+        float dist = sqrtf(dist_sq);
+        *out_normal = vec3_scale(d, 1.0f / dist);
+        return dist;
     }
-    else if (hit_object)
+
+    /* Leave through the nearest face, upwards on ties */
+    float depth = bmax.y - p.y;
+    Vec3 n = vec3_create(0.0f, 1.0f, 0.0f);
+    const float faces[5] = {p.y - bmin.y, bmax.x - p.x, p.x - bmin.x, bmax.z - p.z, p.z - bmin.z};
+    const Vec3 normals[5] = {{0.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f},
+                             {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}};
+    for (int32_t i = 0; i < 5; i++)
     {
-        *out_normal = object_normal;
-        return true;
+        if (faces[i] < depth)
+        {
+            depth = faces[i];
+            n = normals[i];
+        }
     }
+    *out_normal = n;
+    return -depth;
+}
 
-    return false;
+/* Parameters where o + d t enters and leaves a box; false when the line misses it */
+static bool ray_box(Vec3 o, Vec3 d, Vec3 bmin, Vec3 bmax, float *t_enter, float *t_exit)
+{
+    const float o3[3] = {o.x, o.y, o.z};
+    const float d3[3] = {d.x, d.y, d.z};
+    const float lo3[3] = {bmin.x, bmin.y, bmin.z};
+    const float hi3[3] = {bmax.x, bmax.y, bmax.z};
+    float tn = -1e30f, tf = 1e30f;
+    for (int32_t a = 0; a < 3; a++)
+    {
+        if (fabsf(d3[a]) < 1e-12f)
+        {
+            if (o3[a] < lo3[a] || o3[a] > hi3[a])
+                return false;
+            continue;
+        }
+        float inv = 1.0f / d3[a];
+        float t0 = (lo3[a] - o3[a]) * inv;
+        float t1 = (hi3[a] - o3[a]) * inv;
+        if (t0 > t1)
+        {
+            float tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+        }
+        tn = fmaxf(tn, t0);
+        tf = fminf(tf, t1);
+        if (tn > tf)
+            return false;
+    }
+    *t_enter = tn;
+    *t_exit = tf;
+    return true;
 }
 
-static bool check_capsule_collision(Character *character,
-                                     VoxelVolume *terrain,
-                                     VoxelObjectWorld *objects,
-                                     Vec3 *out_normal,
-                                     Vec3 *out_contact)
+/* First parameter where o + d t enters the capsule around segment pa-pb, -1 = none */
+static float ray_capsule(Vec3 o, Vec3 d, Vec3 pa, Vec3 pb, float r)
 {
-    Vec3 sample_points[CHAR_SAMPLE_POINTS];
-    get_capsule_sample_points(character, sample_points);
+    Vec3 ba = vec3_sub(pb, pa);
+    Vec3 oa = vec3_sub(o, pa);
+    float baba = vec3_dot(ba, ba);
+    float bard = vec3_dot(ba, d);
+    float baoa = vec3_dot(ba, oa);
+    float rdoa = vec3_dot(d, oa);
+    float oaoa = vec3_dot(oa, oa);
+    float rdrd = vec3_dot(d, d);
+
+    /* Side of the cylinder */
+    float a = baba * rdrd - bard * bard;
+    float b = baba * rdoa - baoa * bard;
+    float c = baba * oaoa - baoa * baoa - r * r * baba;
+    float y = baoa;
+    if (a > 1e-12f)
+    {
+        float h = b * b - a * c;
+        if (h < 0.0f)
+            return -1.0f;
+        float t = (-b - sqrtf(h)) / a;
+        y = baoa + t * bard;
+        if (y > 0.0f && y < baba)
+            return t;
+    }
+    else if (c > 0.0f)
+    {
+        return -1.0f;
+    }
 
-    Vec3 total_normal = vec3_zero();
-    int32_t collision_count = 0;
-    Vec3 avg_contact = vec3_zero();
+    /* End cap nearest the crossing */
+    Vec3 oc = (y <= 0.0f) ? oa : vec3_sub(o, pb);
+    b = vec3_dot(d, oc);
+    c = vec3_dot(oc, oc) - r * r;
+    float h = b * b - rdrd * c;
+    if (h < 0.0f || rdrd < 1e-12f)
+        return -1.0f;
+    return (-b - sqrtf(h)) / rdrd;
+}
 
-    for (int32_t i = 0; i < CHAR_SAMPLE_POINTS; i++)
+/*
+ * First parameter in [0, 1] where o + d t comes within r of the box, -1 =
+ * none; o must start farther than r. The rounded box is the box grown by r
+ * along each axis alone plus a capsule on each edge.
+ */
+static float ray_rounded_box(Vec3 o, Vec3 d, Vec3 bmin, Vec3 bmax, float r)
+{
+    Vec3 rr = vec3_create(r, r, r);
+    float tn, tf;
+    if (!ray_box(o, d, vec3_sub(bmin, rr), vec3_add(bmax, rr), &tn, &tf) || tf < 0.0f || tn > 1.0f)
+        return -1.0f;
+    if (tn < 0.0f)
+        tn = 0.0f;
+
+    /* Entering beside a face: that is the rounded box's surface too */
+    Vec3 q = vec3_add(o, vec3_scale(d, tn));
+    int32_t outside = (q.x < bmin.x || q.x > bmax.x) + (q.y < bmin.y || q.y > bmax.y) + (q.z < bmin.z || q.z > bmax.z);
+    if (outside <= 1)
+        return tn;
+
+    /* Entering beside an edge or corner: test the pieces */
+    float best = -1.0f;
+    const Vec3 grow[3] = {{r, 0.0f, 0.0f}, {0.0f, r, 0.0f}, {0.0f, 0.0f, r}};
+    for (int32_t a = 0; a < 3; a++)
     {
-        Vec3 normal;
-        if (check_collision(terrain, objects, sample_points[i], &normal))
+        float t0, t1;
+        if (ray_box(o, d, vec3_sub(bmin, grow[a]), vec3_add(bmax, grow[a]), &t0, &t1) &&
+            t0 >= 0.0f && t0 <= 1.0f && (best < 0.0f || t0 < best))
+            best = t0;
+    }
+
+    const float lo3[3] = {bmin.x, bmin.y, bmin.z};
+    const float hi3[3] = {bmax.x, bmax.y, bmax.z};
+    for (int32_t a = 0; a < 3; a++)
+    {
+        int32_t b = (a + 1) % 3;
+        int32_t c = (a + 2) % 3;
+        for (int32_t corner = 0; corner < 4; corner++)
         {
-            total_normal = vec3_add(total_normal, normal);
-            avg_contact = vec3_add(avg_contact, sample_points[i]);
-            collision_count++;
+            float e0[3], e1[3];
+            e0[a] = lo3[a];
+            e1[a] = hi3[a];
+            e0[b] = e1[b] = (corner & 1) ? hi3[b] : lo3[b];
+            e0[c] = e1[c] = (corner & 2) ? hi3[c] : lo3[c];
+            float t = ray_capsule(o, d, vec3_create(e0[0], e0[1], e0[2]), vec3_create(e1[0], e1[1], e1[2]), r);
+            if (t >= 0.0f && t <= 1.0f && (best < 0.0f || t < best))
+                best = t;
         }
     }
+    return best;
+}
 
-    if (collision_count > 0)
+/* Segment base moved by delta against every box: the first contact the move runs into */
+static CharSweepHit char_sweep(const CharBoxes *boxes, const CharCapsule *cap, Vec3 base, Vec3 delta)
+{
+    CharSweepHit result = {false, 1.0f, vec3_zero()};
+    float r = cap->radius;
+    Vec3 end = vec3_add(base, delta);
+    Vec3 lo = vec3_create(fminf(base.x, end.x) - r, fminf(base.y, end.y) - r, fminf(base.z, end.z) - r);
+    Vec3 hi = vec3_create(fmaxf(base.x, end.x) + r, fmaxf(base.y, end.y) + r, fmaxf(base.z, end.z) + r);
+
+    for (int32_t i = 0; i < boxes->count; i++)
     {
-        *out_normal = vec3_normalize(total_normal);
-        *out_contact = vec3_scale(avg_contact, 1.0f / (float)collision_count);
-        return true;
+        /* The segment against a box is its base against the box stretched down by the segment */
+        Vec3 bmin = vec3_create(boxes->min[i].x, boxes->min[i].y - cap->length, boxes->min[i].z);
+        Vec3 bmax = boxes->max[i];
+        if (hi.x < bmin.x || lo.x > bmax.x || hi.y < bmin.y || lo.y > bmax.y || hi.z < bmin.z || lo.z > bmax.z)
+            continue;
+
+        Vec3 n;
+        float t;
+        if (box_signed_distance(base, bmin, bmax, &n) < r)
+        {
+            t = 0.0f;
+        }
+        else
+        {
+            t = ray_rounded_box(base, delta, bmin, bmax, r);
+            if (t < 0.0f)
+                continue;
+            box_signed_distance(vec3_add(base, vec3_scale(delta, t)), bmin, bmax, &n);
+        }
+
+        /* Only contacts the move pushes into; the most head-on among ties */
+        float into = vec3_dot(delta, n);
+        if (into >= 0.0f)
+            continue;
+        if (!result.hit || t < result.t || (t == result.t && into < vec3_dot(delta, result.normal)))
+        {
+            result.hit = true;
+            result.t = t;
+            result.normal = n;
+        }
     }
+    return result;
+}
 
-    return false;
+/* Pushes the capsule out of boxes it overlaps by more than the skin */
+static void char_depenetrate(Character *character, const CharBoxes *boxes, const CharCapsule *cap)
+{
+    for (int32_t pass = 0; pass < CHAR_SLIDE_ITERATIONS; pass++)
+    {
+        Vec3 base = char_base(character);
+        float deepest = CHAR_SKIN_WIDTH;
+        Vec3 push = vec3_zero();
+        for (int32_t i = 0; i < boxes->count; i++)
+        {
+            Vec3 bmin = vec3_create(boxes->min[i].x, boxes->min[i].y - cap->length, boxes->min[i].z);
+            Vec3 n;
+            float depth = cap->radius - box_signed_distance(base, bmin, boxes->max[i], &n);
+            if (depth > deepest)
+            {
+                deepest = depth;
+                push = n;
+            }
+        }
+        if (deepest <= CHAR_SKIN_WIDTH)
+            return;
+        character->position = vec3_add(character->position, vec3_scale(push, deepest + CHAR_SKIN_WIDTH));
+    }
 }
 
 static Vec3 project_velocity_onto_plane(Vec3 velocity, Vec3 normal)
@@ -192,55 +723,93 @@ static Vec3 project_velocity_onto_plane(Vec3 velocity, Vec3 normal)
     return vec3_sub(velocity, vec3_scale(normal, v_dot_n));
 }
 
-static bool try_step_up(Character *character,
-                        VoxelVolume *terrain,
-                        VoxelObjectWorld *objects,
-                        Vec3 move_dir)
+/* Up by step_height, along the move, then down onto walkable ground; false leaves the character where it was */
+static bool try_step_up(Character *character, const CharBoxes *boxes, const CharCapsule *cap, Vec3 move_dir)
 {
-    Vec3 original_pos = character->position;
+    float move_dist = vec3_length(move_dir);
+    if (move_dist < K_EPSILON)
+        return false;
 
-    character->position.y += character->step_height;
+    Vec3 base = char_base(character);
+    CharSweepHit up = char_sweep(boxes, cap, base, vec3_create(0.0f, character->step_height, 0.0f));
+    float lift = up.t * character->step_height - (up.hit ? CHAR_SKIN_WIDTH : 0.0f);
+    if (lift <= CHAR_SKIN_WIDTH)
+        return false;
+    base.y += lift;
 
-    Vec3 collision_normal, contact_point;
-    if (check_capsule_collision(character, terrain, objects, &collision_normal, &contact_point))
-    {
-        character->position = original_pos;
+    CharSweepHit forward = char_sweep(boxes, cap, base, move_dir);
+    float travel = forward.t * move_dist - (forward.hit ? CHAR_SKIN_WIDTH : 0.0f);
+    if (travel <= K_EPSILON)
         return false;
-    }
+    base = vec3_add(base, vec3_scale(move_dir, travel / move_dist));
 
-    float move_dist = vec3_length(move_dir);
-    if (move_dist > K_EPSILON)
-    {
-        Vec3 step_pos = vec3_add(character->position, move_dir);
-        character->position = step_pos;
+    float drop = lift + CHAR_SKIN_WIDTH;
+    CharSweepHit down = char_sweep(boxes, cap, base, vec3_create(0.0f, -drop, 0.0f));
+    if (!down.hit || down.normal.y <= CHAR_WALKABLE_NORMAL_Y)
+        return false;
+    base.y -= fmaxf(down.t * drop - CHAR_SKIN_WIDTH, 0.0f);
 
-        if (check_capsule_collision(character, terrain, objects, &collision_normal, &contact_point))
-        {
-            character->position = original_pos;
-            return false;
-        }
-    }
+    character->position = vec3_create(base.x, base.y - character->radius, base.z);
+    character->is_grounded = true;
+    character->ground_normal = down.normal;
+    return true;
+}
 
-    Vec3 down_pos = character->position;
-    down_pos.y -= character->step_height;
+static void character_integrate(Character *character, Vec3 move_input, float dt)
+{
+    character->velocity = vec3_add(character->velocity, vec3_scale(vec3_create(0.0f, PHYS_GRAVITY_Y, 0.0f), dt));
+    character->velocity.x = move_input.x;
+    character->velocity.z = move_input.z;
+}
+
+/* Sweeps and slides the character by velocity * dt, then probes for ground; rows may be NULL */
+static void character_collide_and_slide(Character *character, VoxelVolume *terrain, const CharRowCache *rows,
+                                        VoxelObjectWorld *objects, CharBoxes *boxes, float dt)
+{
+    CharCapsule cap = char_capsule(character);
+    Vec3 move_delta = vec3_scale(character->velocity, dt);
+    bool was_grounded = character->is_grounded;
 
-    Vec3 test_pos = character->position;
-    float step_down = character->step_height / 4.0f;
+    if (!char_gather(boxes, character, terrain, rows, objects, move_delta))
+    {
+        /* Sweeping past geometry that was left out could pass through it */
+        character->velocity = vec3_zero();
+        return;
+    }
+    char_depenetrate(character, boxes, &cap);
 
-    for (int32_t i = 0; i < 4; i++)
+    for (int32_t iter = 0; iter < CHAR_SLIDE_ITERATIONS; iter++)
     {
-        test_pos.y -= step_down;
-        character->position = test_pos;
+        float move_len = vec3_length(move_delta);
+        if (move_len < K_EPSILON)
+            break;
 
-        if (check_capsule_collision(character, terrain, objects, &collision_normal, &contact_point))
+        CharSweepHit hit = char_sweep(boxes, &cap, char_base(character), move_delta);
+        float travel = hit.hit ? fmaxf(hit.t * move_len - CHAR_SKIN_WIDTH, 0.0f) : move_len;
+        character->position = vec3_add(character->position, vec3_scale(move_delta, travel / move_len));
+        if (!hit.hit)
+            break;
+
+        Vec3 remaining = vec3_scale(move_delta, 1.0f - travel / move_len);
+        Vec3 horizontal_move = vec3_create(remaining.x, 0.0f, remaining.z);
+        if (was_grounded && hit.normal.y < CHAR_WALKABLE_NORMAL_Y &&
+            vec3_length_sq(horizontal_move) > K_EPSILON * K_EPSILON &&
+            try_step_up(character, boxes, &cap, horizontal_move))
         {
-            character->position.y += step_down;
-            return true;
+            move_delta = vec3_zero();
+            continue;
         }
+
+        move_delta = project_velocity_onto_plane(remaining, hit.normal);
+        character->velocity = project_velocity_onto_plane(character->velocity, hit.normal);
     }
 
-    character->position = original_pos;
-    return false;
+    CharSweepHit ground = char_sweep(boxes, &cap, char_base(character),
+                                     vec3_create(0.0f, -CHAR_GROUND_CHECK_DIST, 0.0f));
+    character->is_grounded = ground.hit && ground.normal.y > CHAR_WALKABLE_NORMAL_Y;
+    character->is_sliding = ground.hit && !character->is_grounded;
+    if (ground.hit)
+        character->ground_normal = ground.normal;
 }
 
 void character_move(Character *character,
@@ -252,72 +821,158 @@ void character_move(Character *character,
     if (!character)
         return;
 
-    character->velocity = vec3_add(character->velocity, vec3_scale(vec3_create(0.0f, PHYS_GRAVITY_Y, 0.0f), dt));
-    character->velocity.x = move_input.x;
-    character->velocity.z = move_input.z;
-
-    Vec3 move_delta = vec3_scale(character->velocity, dt);
-
-    for (int32_t iter = 0; iter < CHAR_SLIDE_ITERATIONS; iter++)
-    {
-        float move_len = vec3_length(move_delta);
-        if (move_len < K_EPSILON)
-            break;
+    static thread_local CharBoxes boxes;
+    character_integrate(character, move_input, dt);
+    character_collide_and_slide(character, terrain, NULL, objects, &boxes, dt);
+    character->velocity = vec3_clamp_length(character->velocity, PHYS_MAX_LINEAR_VELOCITY);
+}
 
-        character->position = vec3_add(character->position, move_delta);
+void character_batch_init(CharacterBatch *batch)
+{
+    if (batch)
+        batch->count = 0;
+}
 
-        Vec3 collision_normal, contact_point;
-        if (check_capsule_collision(character, terrain, objects, &collision_normal, &contact_point))
-        {
-            character->position = vec3_sub(character->position, move_delta);
+int32_t character_batch_add(CharacterBatch *batch, Vec3 start_position)
+{
+    if (!batch || batch->count >= CHAR_BATCH_MAX)
+        return -1;
+
+    Character character;
+    character_init(&character, start_position);
+    int32_t index = batch->count++;
+    character_batch_set(batch, index, &character);
+    batch->move_input.x[index] = 0.0f;
+    batch->move_input.y[index] = 0.0f;
+    batch->move_input.z[index] = 0.0f;
+    return index;
+}
 
-            if (collision_normal.y < 0.7f && vec3_length_sq(vec3_create(move_delta.x, 0.0f, move_delta.z)) > K_EPSILON * K_EPSILON)
-            {
-                Vec3 horizontal_move = vec3_create(move_delta.x, 0.0f, move_delta.z);
-                if (try_step_up(character, terrain, objects, horizontal_move))
-                {
-                    move_delta = vec3_zero();
-                    continue;
-                }
-            }
+void character_batch_get(const CharacterBatch *batch, int32_t index, Character *out)
+{
+    out->position = vec3_create(batch->position.x[index], batch->position.y[index], batch->position.z[index]);
+    out->velocity = vec3_create(batch->velocity.x[index], batch->velocity.y[index], batch->velocity.z[index]);
+    out->ground_normal = vec3_create(batch->ground_normal.x[index], batch->ground_normal.y[index],
+                                     batch->ground_normal.z[index]);
+    out->radius = batch->radius[index];
+    out->height = batch->height[index];
+    out->step_height = batch->step_height[index];
+    out->is_grounded = (batch->flags[index] & CHAR_FLAG_GROUNDED) != 0;
+    out->is_sliding = (batch->flags[index] & CHAR_FLAG_SLIDING) != 0;
+}
 
-            move_delta = project_velocity_onto_plane(move_delta, collision_normal);
-            character->velocity = project_velocity_onto_plane(character->velocity, collision_normal);
+void character_batch_set(CharacterBatch *batch, int32_t index, const Character *character)
+{
+    batch->position.x[index] = character->position.x;
+    batch->position.y[index] = character->position.y;
+    batch->position.z[index] = character->position.z;
+    batch->velocity.x[index] = character->velocity.x;
+    batch->velocity.y[index] = character->velocity.y;
+    batch->velocity.z[index] = character->velocity.z;
+    batch->ground_normal.x[index] = character->ground_normal.x;
+    batch->ground_normal.y[index] = character->ground_normal.y;
+    batch->ground_normal.z[index] = character->ground_normal.z;
+    batch->radius[index] = character->radius;
+    batch->height[index] = character->height;
+    batch->step_height[index] = character->step_height;
+    batch->flags[index] = (uint8_t)((character->is_grounded ? CHAR_FLAG_GROUNDED : 0) |
+                                    (character->is_sliding ? CHAR_FLAG_SLIDING : 0));
+}
 
-            if (collision_normal.y > 0.7f)
-            {
-                character->is_grounded = true;
-                character->ground_normal = collision_normal;
-            }
-        }
-        else
+typedef struct
+{
+    CharacterBatch *batch;
+    VoxelVolume *terrain;
+    VoxelObjectWorld *objects;
+    float dt;
+} CharacterMoveJob;
+
+/*
+ * Terrain voxels all of the task's moves can reach. False when none can
+ * reach any, or when they are spread so far apart that reading the whole
+ * region would read more voxels than the moves read on their own.
+ */
+static bool character_task_range(const CharacterMoveJob *job, int32_t begin, int32_t end, int32_t g0[3],
+                                 int32_t g1[3])
+{
+    bool any = false;
+    int64_t own = 0;
+    for (int32_t i = begin; i < end; i++)
+    {
+        Character character;
+        character_batch_get(job->batch, i, &character);
+        Vec3 lo, hi;
+        char_reach(&character, vec3_scale(character.velocity, job->dt), &lo, &hi);
+        int32_t c0[3], c1[3];
+        if (!char_voxel_range(job->terrain, lo, hi, c0, c1))
+            continue;
+        own += (int64_t)(c1[0] - c0[0] + 1) * (c1[1] - c0[1] + 1) * (c1[2] - c0[2] + 1);
+        for (int32_t a = 0; a < 3; a++)
         {
-            break;
+            g0[a] = any && g0[a] < c0[a] ? g0[a] : c0[a];
+            g1[a] = any && g1[a] > c1[a] ? g1[a] : c1[a];
         }
+        any = true;
     }
+    return any && (int64_t)(g1[0] - g0[0] + 1) * (g1[1] - g0[1] + 1) * (g1[2] - g0[2] + 1) <= own;
+}
 
-    Vec3 ground_check_pos = character->position;
-    ground_check_pos.y -= CHAR_GROUND_CHECK_DIST;
+static void character_move_task(int32_t task, void *ctx)
+{
+    static thread_local CharRowCache rows;
+    static thread_local CharBoxes boxes;
+    CharacterMoveJob *job = (CharacterMoveJob *)ctx;
+    int32_t begin = task * CHAR_BATCH_TASK_SIZE;
+    int32_t end = begin + CHAR_BATCH_TASK_SIZE < job->batch->count ? begin + CHAR_BATCH_TASK_SIZE : job->batch->count;
+
+    int32_t g0[3], g1[3];
+    bool cached = job->terrain && end - begin > 1 && character_task_range(job, begin, end, g0, g1) &&
+                  char_row_cache_fill(&rows, job->terrain, g0, g1);
+    for (int32_t i = begin; i < end; i++)
+    {
+        Character character;
+        character_batch_get(job->batch, i, &character);
+        character_collide_and_slide(&character, job->terrain, cached ? &rows : NULL, job->objects, &boxes, job->dt);
+        character_batch_set(job->batch, i, &character);
+    }
+}
 
-    Vec3 check_normal;
-    Character temp_char = *character;
-    temp_char.position = ground_check_pos;
+void character_move_many(CharacterBatch *batch,
+                         VoxelVolume *terrain,
+                         VoxelObjectWorld *objects,
+                         struct PhysicsWorkers *workers,
+                         float dt)
+{
+    if (!batch || batch->count <= 0)
+        return;
 
-    Vec3 contact;
-    if (check_capsule_collision(&temp_char, terrain, objects, &check_normal, &contact))
+    /* Same operations as character_integrate, over the arrays */
+    int32_t n = batch->count;
+    float gravity_dv = PHYS_GRAVITY_Y * dt;
+    for (int32_t i = 0; i < n; i++)
     {
-        if (check_normal.y > 0.7f)
-        {
-            character->is_grounded = true;
-            character->ground_normal = check_normal;
-        }
+        batch->velocity.x[i] = batch->move_input.x[i];
+        batch->velocity.y[i] = batch->velocity.y[i] + gravity_dv;
+        batch->velocity.z[i] = batch->move_input.z[i];
     }
-    else
+
+    CharacterMoveJob job = {batch, terrain, objects, dt};
+    physics_workers_run(workers, (n + CHAR_BATCH_TASK_SIZE - 1) / CHAR_BATCH_TASK_SIZE, character_move_task, &job);
+
+    /* Same as vec3_clamp_length */
+    float max_sq = PHYS_MAX_LINEAR_VELOCITY * PHYS_MAX_LINEAR_VELOCITY;
+    for (int32_t i = 0; i < n; i++)
     {
-        character->is_grounded = false;
+        float vx = batch->velocity.x[i], vy = batch->velocity.y[i], vz = batch->velocity.z[i];
+        float len_sq = vx * vx + vy * vy + vz * vz;
+        if (len_sq > max_sq && len_sq > K_EPSILON * K_EPSILON)
+        {
+            float scale = PHYS_MAX_LINEAR_VELOCITY * (1.0f / sqrtf(len_sq));
+            batch->velocity.x[i] = vx * scale;
+            batch->velocity.y[i] = vy * scale;
+            batch->velocity.z[i] = vz * scale;
+        }
     }
-
-    character->velocity = vec3_clamp_length(character->velocity, PHYS_MAX_LINEAR_VELOCITY);
 }
 
 void character_jump(Character *character, float jump_velocity)
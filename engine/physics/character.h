@@ -5,18 +5,58 @@
 #include "engine/core/math.h"
 #include "engine/voxel/volume.h"
 #include "engine/voxel/voxel_object.h"
+#include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+/*
+ * Character Controller
+ *
+ * The character is an upright capsule standing on its feet position. Each
+ * move sweeps it along the tick's motion and stops it at the first contact
+ * (time of impact), then slides the rest along the contact plane, up to
+ * CHAR_SLIDE_ITERATIONS times. Walls lower than step_height are stepped
+ * onto while grounded.
+ *
+ * Collision geometry is gathered once per move from the region the move
+ * can reach:
+ * - terrain rows inside that region are read as bitmasks (chunks and
+ *   occupancy regions without solid voxels are skipped whole), and each
+ *   run of solid voxels becomes one box, grown instead when the row below
+ *   or the slice behind has the same run
+ * - voxel objects come from one BVH query, as world boxes around their
+ *   collider boxes
+ * When the boxes do not fit in CHAR_MAX_BOXES, objects fall back to their
+ * shape boxes and terrain to runs of coarser cells that cover every solid
+ * voxel, so the sweep never misses geometry; a move that still does not
+ * fit is not taken.
+ * The sweep against a box is exact: an upright capsule against a box is a
+ * point against the box stretched down by the capsule's segment and
+ * rounded by its radius.
+ *
+ * character_move_many moves a structure-of-arrays batch: integration and
+ * velocity clamping run over the arrays, and the sweeps run in tasks on
+ * an optional worker pool. When a task's characters stand close together,
+ * the terrain rows around all of them are read once, 64 voxels at a time,
+ * and each move builds its boxes from those. Characters do not collide
+ * with each other, so results match character_move on each one, whatever
+ * the worker count.
+ */
+
 #define CHAR_CAPSULE_RADIUS 0.3f
 #define CHAR_CAPSULE_HEIGHT 1.8f
 #define CHAR_STEP_HEIGHT 0.3f
 #define CHAR_GROUND_CHECK_DIST 0.1f
 #define CHAR_SLIDE_ITERATIONS 3
-#define CHAR_SAMPLE_POINTS 12
+#define CHAR_SKIN_WIDTH 0.002f      /* Gap kept to surfaces after a contact */
+#define CHAR_WALKABLE_NORMAL_Y 0.7f /* Steeper contacts are walls */
+#define CHAR_MAX_BOXES 1024         /* Collision boxes gathered per move */
+#define CHAR_BATCH_MAX 512
+#define CHAR_BATCH_TASK_SIZE 16     /* Characters per worker task */
 
     typedef struct
     {
@@ -40,6 +80,51 @@ extern "C"
 
     void character_jump(Character *character, float jump_velocity);
 
+#define CHAR_FLAG_GROUNDED 0x01
+#define CHAR_FLAG_SLIDING 0x02
+
+    /* One Vec3 per character, stored as three component arrays */
+    typedef struct
+    {
+        float x[CHAR_BATCH_MAX];
+        float y[CHAR_BATCH_MAX];
+        float z[CHAR_BATCH_MAX];
+    } CharacterVec3Array;
+
+    typedef struct CharacterBatch
+    {
+        CharacterVec3Array position; /* Feet */
+        CharacterVec3Array velocity;
+        CharacterVec3Array ground_normal;
+        CharacterVec3Array move_input; /* Horizontal velocity wanted next move (y unused) */
+        float radius[CHAR_BATCH_MAX];
+        float height[CHAR_BATCH_MAX];
+        float step_height[CHAR_BATCH_MAX];
+        uint8_t flags[CHAR_BATCH_MAX]; /* CHAR_FLAG_* */
+        int32_t count;
+    } CharacterBatch;
+
+    struct PhysicsWorkers;
+
+    void character_batch_init(CharacterBatch *batch);
+
+    /* Adds a character with character_init defaults; returns its index, -1 when full */
+    int32_t character_batch_add(CharacterBatch *batch, Vec3 start_position);
+
+    void character_batch_get(const CharacterBatch *batch, int32_t index, Character *out);
+    void character_batch_set(CharacterBatch *batch, int32_t index, const Character *character);
+
+    /*
+     * Moves every character in the batch by its move_input, as
+     * character_move would. The sweeps run on workers when given (NULL =
+     * calling thread only); terrain and objects must not change meanwhile.
+     */
+    void character_move_many(CharacterBatch *batch,
+                             VoxelVolume *terrain,
+                             VoxelObjectWorld *objects,
+                             struct PhysicsWorkers *workers,
+                             float dt);
+
     bool character_is_grounded(Character *character);
 
     Vec3 character_get_feet_position(Character *character);
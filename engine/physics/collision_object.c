@@ -2,7 +2,9 @@
 #include "convex_hull.h"
 #include "gjk.h"
 #include "broadphase.h"
+#include "manifold.h"
 #include "engine/core/spatial_hash.h"
+#include "engine/core/profile.h"
 #include <string.h>
 
 #define COLLISION_SAMPLE_POINTS 24
@@ -17,31 +19,48 @@ typedef struct
 
 static CachedHull g_hull_cache[VOBJ_MAX_OBJECTS];
 
-static void ensure_hull_valid(VoxelObject *obj, int32_t obj_index)
+static void ensure_hull_valid(VoxelObject *obj, int32_t obj_index, PhysicsPairCache *stats)
 {
     CachedHull *cache = &g_hull_cache[obj_index];
     if (cache->valid && cache->obj_ptr == obj && cache->revision == obj->voxel_revision)
         return;
 
-    convex_hull_build(obj->surface_voxels, obj->surface_voxel_count, &cache->hull);
-    cache->hull.margin = 0.04f;
+    HullUpdate update = HULL_UPDATE_REBUILT;
+    if (cache->valid && cache->obj_ptr == obj)
+    {
+        update = convex_hull_update(&cache->hull, obj->surface_voxels, obj->surface_voxel_count);
+    }
+    else
+    {
+        convex_hull_build(obj->surface_voxels, obj->surface_voxel_count, &cache->hull);
+        cache->hull.margin = 0.04f;
+    }
+
+    if (stats)
+    {
+        if (update == HULL_UPDATE_REUSED)
+            stats->hull_reuses++;
+        else
+            stats->hull_rebuilds++;
+    }
     cache->obj_ptr = obj;
     cache->revision = obj->voxel_revision;
     cache->valid = true;
 }
 
-static bool test_sphere_sphere_coarse(VoxelObject *a, VoxelObject *b)
+static bool test_sphere_sphere_coarse(VoxelObject *a, const VoxelObjectPose *pa,
+                                      VoxelObject *b, const VoxelObjectPose *pb)
 {
-    Vec3 delta = vec3_sub(b->position, a->position);
+    Vec3 delta = vec3_sub(pb->position, pa->position);
     float dist_sq = vec3_length_sq(delta);
     float combined_radius = a->radius + b->radius;
     return dist_sq <= combined_radius * combined_radius;
 }
 
-static void get_obb_axes(VoxelObject *obj, Vec3 axes[3])
+static void get_obb_axes(Quat orientation, Vec3 axes[3])
 {
     float mat3[9];
-    quat_to_mat3(obj->orientation, mat3);
+    quat_to_mat3(orientation, mat3);
     axes[0] = vec3_create(mat3[0], mat3[3], mat3[6]);
     axes[1] = vec3_create(mat3[1], mat3[4], mat3[7]);
     axes[2] = vec3_create(mat3[2], mat3[5], mat3[8]);
@@ -56,7 +75,7 @@ static float project_obb_onto_axis(VoxelObject *obj, Vec3 axes[3], Vec3 axis)
 }
 
 static bool test_sat_axis(VoxelObject *a, VoxelObject *b,
-                          Vec3 axes_a[3], Vec3 axes_b[3],
+                          Vec3 axes_a[3], Vec3 axes_b[3], Vec3 center_diff,
                           Vec3 axis, float *min_overlap, Vec3 *min_axis)
 {
     float axis_len = vec3_length(axis);
@@ -68,7 +87,6 @@ static bool test_sat_axis(VoxelObject *a, VoxelObject *b,
     float proj_a = project_obb_onto_axis(a, axes_a, axis);
     float proj_b = project_obb_onto_axis(b, axes_b, axis);
 
-    Vec3 center_diff = vec3_sub(b->position, a->position);
     float center_dist = fabsf(vec3_dot(center_diff, axis));
 
     float overlap = proj_a + proj_b - center_dist;
@@ -88,25 +106,27 @@ static bool test_sat_axis(VoxelObject *a, VoxelObject *b,
     return true;
 }
 
-static bool test_obb_overlap(VoxelObject *obj_a, VoxelObject *obj_b,
+static bool test_obb_overlap(VoxelObject *obj_a, const VoxelObjectPose *pa,
+                             VoxelObject *obj_b, const VoxelObjectPose *pb,
                              float *out_overlap, Vec3 *out_axis)
 {
     Vec3 axes_a[3], axes_b[3];
-    get_obb_axes(obj_a, axes_a);
-    get_obb_axes(obj_b, axes_b);
+    get_obb_axes(pa->orientation, axes_a);
+    get_obb_axes(pb->orientation, axes_b);
+    Vec3 center_diff = vec3_sub(pb->position, pa->position);
 
     float min_overlap = 1e10f;
     Vec3 min_axis = vec3_zero();
 
     for (int i = 0; i < 3; i++)
     {
-        if (!test_sat_axis(obj_a, obj_b, axes_a, axes_b, axes_a[i], &min_overlap, &min_axis))
+        if (!test_sat_axis(obj_a, obj_b, axes_a, axes_b, center_diff, axes_a[i], &min_overlap, &min_axis))
             return false;
     }
 
     for (int i = 0; i < 3; i++)
     {
-        if (!test_sat_axis(obj_a, obj_b, axes_a, axes_b, axes_b[i], &min_overlap, &min_axis))
+        if (!test_sat_axis(obj_a, obj_b, axes_a, axes_b, center_diff, axes_b[i], &min_overlap, &min_axis))
             return false;
     }
 
@@ -115,7 +135,7 @@ static bool test_obb_overlap(VoxelObject *obj_a, VoxelObject *obj_b,
         for (int j = 0; j < 3; j++)
         {
             Vec3 cross_axis = vec3_cross(axes_a[i], axes_b[j]);
-            if (!test_sat_axis(obj_a, obj_b, axes_a, axes_b, cross_axis, &min_overlap, &min_axis))
+            if (!test_sat_axis(obj_a, obj_b, axes_a, axes_b, center_diff, cross_axis, &min_overlap, &min_axis))
                 return false;
         }
     }
@@ -125,11 +145,11 @@ static bool test_obb_overlap(VoxelObject *obj_a, VoxelObject *obj_b,
     return min_overlap > K_EPSILON;
 }
 
-static bool world_to_voxel(VoxelObject *obj, Vec3 world_point,
+static bool world_to_voxel(VoxelObject *obj, const VoxelObjectPose *pose, Vec3 world_point,
                            int32_t *out_vx, int32_t *out_vy, int32_t *out_vz)
 {
-    Vec3 relative = vec3_sub(world_point, obj->position);
-    Quat inv_orient = quat_conjugate(obj->orientation);
+    Vec3 relative = vec3_sub(world_point, pose->position);
+    Quat inv_orient = quat_conjugate(pose->orientation);
     Vec3 local = quat_rotate_vec3(inv_orient, relative);
 
     float half_grid = (float)VOBJ_GRID_SIZE * 0.5f;
@@ -180,7 +200,8 @@ static Vec3 estimate_surface_normal(VoxelObject *obj, int32_t vx, int32_t vy, in
     return vec3_create(0.0f, 1.0f, 0.0f);
 }
 
-static bool refine_collision_with_voxels(VoxelObject *obj_a, VoxelObject *obj_b,
+static bool refine_collision_with_voxels(VoxelObject *obj_a, const VoxelObjectPose *pa,
+                                         VoxelObject *obj_b, const VoxelObjectPose *pb,
                                          Vec3 sat_axis, float sat_overlap,
                                          Vec3 *out_contact, Vec3 *out_normal, float *out_penetration)
 {
@@ -188,8 +209,8 @@ static bool refine_collision_with_voxels(VoxelObject *obj_a, VoxelObject *obj_b,
     Vec3 normal_sum = vec3_zero();
     int32_t contact_count = 0;
 
-    Vec3 center_a = obj_a->position;
-    Vec3 center_b = obj_b->position;
+    Vec3 center_a = pa->position;
+    Vec3 center_b = pb->position;
     Vec3 midpoint = vec3_scale(vec3_add(center_a, center_b), 0.5f);
 
     float sample_radius = sat_overlap + obj_a->voxel_size * 2.0f;
@@ -229,21 +250,21 @@ static bool refine_collision_with_voxels(VoxelObject *obj_a, VoxelObject *obj_b,
                                                    offsets[i][2] * step));
 
         int32_t ax, ay, az;
-        if (!world_to_voxel(obj_a, sample_world, &ax, &ay, &az))
+        if (!world_to_voxel(obj_a, pa, sample_world, &ax, &ay, &az))
             continue;
         if (!is_voxel_occupied(obj_a, ax, ay, az))
             continue;
 
         int32_t bx, by, bz;
-        if (!world_to_voxel(obj_b, sample_world, &bx, &by, &bz))
+        if (!world_to_voxel(obj_b, pb, sample_world, &bx, &by, &bz))
             continue;
         if (!is_voxel_occupied(obj_b, bx, by, bz))
             continue;
 
         Vec3 local_normal_a = estimate_surface_normal(obj_a, ax, ay, az);
-        Vec3 world_normal_a = quat_rotate_vec3(obj_a->orientation, local_normal_a);
+        Vec3 world_normal_a = quat_rotate_vec3(pa->orientation, local_normal_a);
         Vec3 local_normal_b = estimate_surface_normal(obj_b, bx, by, bz);
-        Vec3 world_normal_b = quat_rotate_vec3(obj_b->orientation, local_normal_b);
+        Vec3 world_normal_b = quat_rotate_vec3(pb->orientation, local_normal_b);
 
         Vec3 combined = vec3_sub(world_normal_a, world_normal_b);
         float combined_len = vec3_length(combined);
@@ -281,64 +302,256 @@ static bool refine_collision_with_voxels(VoxelObject *obj_a, VoxelObject *obj_b,
     return true;
 }
 
-static bool detect_obb_collision(VoxelObject *obj_a, VoxelObject *obj_b,
+static bool detect_obb_collision(VoxelObject *obj_a, const VoxelObjectPose *pa,
+                                 VoxelObject *obj_b, const VoxelObjectPose *pb,
                                  Vec3 *out_contact, Vec3 *out_normal, float *out_penetration)
 {
     float sat_overlap;
     Vec3 sat_axis;
 
-    if (!test_obb_overlap(obj_a, obj_b, &sat_overlap, &sat_axis))
+    if (!test_obb_overlap(obj_a, pa, obj_b, pb, &sat_overlap, &sat_axis))
         return false;
 
-    if (refine_collision_with_voxels(obj_a, obj_b, sat_axis, sat_overlap,
+    if (refine_collision_with_voxels(obj_a, pa, obj_b, pb, sat_axis, sat_overlap,
                                      out_contact, out_normal, out_penetration))
     {
         return true;
     }
 
-    *out_contact = vec3_scale(vec3_add(obj_a->position, obj_b->position), 0.5f);
+    *out_contact = vec3_scale(vec3_add(pa->position, pb->position), 0.5f);
     *out_normal = sat_axis;
     *out_penetration = sat_overlap;
     return true;
 }
 
-static bool detect_hull_collision(VoxelObject *obj_a, int32_t idx_a,
-                                  VoxelObject *obj_b, int32_t idx_b,
+static uint32_t pair_cache_hash(int32_t body_a, int32_t body_b)
+{
+    uint32_t key = (uint32_t)body_a * PHYS_MAX_BODIES + (uint32_t)body_b;
+    return (key * 2654435761u) & (PHYS_PAIR_CACHE_TABLE_SIZE - 1);
+}
+
+void physics_pair_cache_init(PhysicsPairCache *cache)
+{
+    memset(cache, 0, sizeof(*cache));
+    memset(cache->table, 0xFF, sizeof(cache->table));
+
+    /* Hulls are cached per object slot and matched by address and revision;
+       a new world can land on a freed world's memory with equal revisions */
+    for (int32_t i = 0; i < VOBJ_MAX_OBJECTS; i++)
+        g_hull_cache[i].valid = false;
+}
+
+/* Starts a step: keeps pairs tested last step, drops the rest */
+static void pair_cache_begin(PhysicsPairCache *cache)
+{
+    uint32_t last = cache->stamp;
+    cache->stamp++;
+    cache->hull_tests = 0;
+    cache->axis_rejects = 0;
+    cache->contact_reuses = 0;
+    cache->gjk_runs = 0;
+    cache->gjk_iterations = 0;
+    cache->epa_runs = 0;
+    cache->hull_reuses = 0;
+    cache->hull_rebuilds = 0;
+
+    int32_t kept = 0;
+    for (int32_t i = 0; i < cache->count; i++)
+    {
+        if (cache->entries[i].stamp != last)
+            continue;
+        if (kept != i)
+            cache->entries[kept] = cache->entries[i];
+        kept++;
+    }
+    cache->count = kept;
+
+    memset(cache->table, 0xFF, sizeof(cache->table));
+    for (int32_t i = 0; i < cache->count; i++)
+    {
+        uint32_t slot = pair_cache_hash(cache->entries[i].body_a, cache->entries[i].body_b);
+        while (cache->table[slot] >= 0)
+            slot = (slot + 1) & (PHYS_PAIR_CACHE_TABLE_SIZE - 1);
+        cache->table[slot] = (int16_t)i;
+    }
+}
+
+/* Entry for a pair, created on first use; NULL when the cache is full */
+static PairCacheEntry *pair_cache_get(PhysicsPairCache *cache, int32_t body_a, int32_t body_b)
+{
+    uint32_t slot = pair_cache_hash(body_a, body_b);
+    while (cache->table[slot] >= 0)
+    {
+        PairCacheEntry *e = &cache->entries[cache->table[slot]];
+        if (e->body_a == body_a && e->body_b == body_b)
+        {
+            e->stamp = cache->stamp;
+            return e;
+        }
+        slot = (slot + 1) & (PHYS_PAIR_CACHE_TABLE_SIZE - 1);
+    }
+
+    if (cache->count >= PHYS_PAIR_CACHE_MAX)
+        return NULL;
+
+    int32_t index = cache->count++;
+    PairCacheEntry *e = &cache->entries[index];
+    memset(e, 0, sizeof(*e));
+    e->body_a = body_a;
+    e->body_b = body_b;
+    e->stamp = cache->stamp;
+    cache->table[slot] = (int16_t)index;
+    return e;
+}
+
+/*
+ * Re-measures last step's contact along its normal, rotated with A. Returns
+ * 1 with the contact when it still holds, 2 when the hulls still only touch
+ * within their margins, -1 when the normal now separates the hulls, 0 when
+ * EPA has to run again.
+ */
+static int32_t reuse_hull_contact(PairCacheEntry *entry, const ConvexHull *hull_a, const ConvexHull *hull_b,
+                                  VoxelObject *obj_a, const VoxelObjectPose *pa,
+                                  VoxelObject *obj_b, const VoxelObjectPose *pb,
+                                  Vec3 *out_contact, Vec3 *out_normal, float *out_penetration)
+{
+    if (!entry->has_contact || entry->age >= PHYS_PAIR_CACHE_MAX_AGE ||
+        entry->revision_a != obj_a->voxel_revision || entry->revision_b != obj_b->voxel_revision)
+        return 0;
+
+    Vec3 normal = quat_rotate_vec3(pa->orientation, entry->normal_local);
+    GJKVertex support = gjk_support_cached(hull_a, pa->position, pa->orientation,
+                                           hull_b, pb->position, pb->orientation,
+                                           normal, &entry->gjk);
+    float depth = vec3_dot(support.minkowski, normal);
+    if (depth < 0.0f)
+    {
+        entry->gjk.axis = normal;
+        return -1;
+    }
+
+    float voxel_size = minf(obj_a->voxel_size, obj_b->voxel_size);
+    if (depth > entry->depth + PHYS_PAIR_CACHE_DEEPEN_RATIO * voxel_size)
+        return 0;
+
+    /* Contact anchors slid apart: the old feature no longer describes the touch */
+    Vec3 anchor_a = vec3_add(pa->position, quat_rotate_vec3(pa->orientation, entry->contact_a_local));
+    Vec3 anchor_b = vec3_add(pb->position, quat_rotate_vec3(pb->orientation, entry->contact_b_local));
+    Vec3 d = vec3_sub(anchor_a, anchor_b);
+    Vec3 drift = vec3_sub(d, vec3_scale(normal, vec3_dot(d, normal)));
+    float break_dist = PHYS_MANIFOLD_BREAK_RATIO * voxel_size;
+    if (vec3_length_sq(drift) > break_dist * break_dist)
+        return 0;
+
+    entry->age++;
+    float adjusted_depth = depth - (hull_a->margin + hull_b->margin);
+    if (adjusted_depth < K_EPSILON)
+        return 2;
+
+    *out_contact = vec3_scale(vec3_add(anchor_a, anchor_b), 0.5f);
+    *out_normal = normal;
+    *out_penetration = adjusted_depth;
+    return 1;
+}
+
+static void store_hull_contact(PairCacheEntry *entry, const EPAResult *epa,
+                               VoxelObject *obj_a, const VoxelObjectPose *pa,
+                               VoxelObject *obj_b, const VoxelObjectPose *pb)
+{
+    Quat inv_a = quat_conjugate(pa->orientation);
+    Quat inv_b = quat_conjugate(pb->orientation);
+    entry->has_contact = true;
+    entry->normal_local = quat_rotate_vec3(inv_a, epa->normal);
+    entry->contact_a_local = quat_rotate_vec3(inv_a, vec3_sub(epa->contact_a, pa->position));
+    entry->contact_b_local = quat_rotate_vec3(inv_b, vec3_sub(epa->contact_b, pb->position));
+    entry->depth = epa->depth;
+    entry->age = 0;
+    entry->revision_a = obj_a->voxel_revision;
+    entry->revision_b = obj_b->voxel_revision;
+}
+
+static bool detect_hull_collision(PhysicsPairCache *pair_cache, PairCacheEntry *entry,
+                                  VoxelObject *obj_a, const VoxelObjectPose *pa, int32_t idx_a,
+                                  VoxelObject *obj_b, const VoxelObjectPose *pb, int32_t idx_b,
                                   Vec3 *out_contact, Vec3 *out_normal,
                                   float *out_penetration)
 {
     if (obj_a->surface_voxel_count < 4 || obj_b->surface_voxel_count < 4)
-        return detect_obb_collision(obj_a, obj_b, out_contact, out_normal, out_penetration);
+        return detect_obb_collision(obj_a, pa, obj_b, pb, out_contact, out_normal, out_penetration);
 
-    ensure_hull_valid(obj_a, idx_a);
-    ensure_hull_valid(obj_b, idx_b);
+    ensure_hull_valid(obj_a, idx_a, pair_cache);
+    ensure_hull_valid(obj_b, idx_b, pair_cache);
 
     CachedHull *cache_a = &g_hull_cache[idx_a];
     CachedHull *cache_b = &g_hull_cache[idx_b];
 
     if (cache_a->hull.vertex_count < 4 || cache_b->hull.vertex_count < 4)
-        return detect_obb_collision(obj_a, obj_b, out_contact, out_normal, out_penetration);
+        return detect_obb_collision(obj_a, pa, obj_b, pb, out_contact, out_normal, out_penetration);
+
+    if (pair_cache)
+        pair_cache->hull_tests++;
+
+    if (entry)
+    {
+        int32_t reused = reuse_hull_contact(entry, &cache_a->hull, &cache_b->hull, obj_a, pa, obj_b, pb,
+                                            out_contact, out_normal, out_penetration);
+        if (reused == 2)
+        {
+            pair_cache->contact_reuses++;
+            return detect_obb_collision(obj_a, pa, obj_b, pb, out_contact, out_normal, out_penetration);
+        }
+        if (reused != 0)
+        {
+            if (reused > 0)
+                pair_cache->contact_reuses++;
+            else
+                pair_cache->axis_rejects++;
+            entry->has_contact = reused > 0;
+            return reused > 0;
+        }
+        entry->has_contact = false;
+    }
 
     GJKSimplex simplex;
-    if (!gjk_intersect(&cache_a->hull, obj_a->position, obj_a->orientation,
-                       &cache_b->hull, obj_b->position, obj_b->orientation,
-                       &simplex))
+    bool intersecting = gjk_intersect_cached(&cache_a->hull, pa->position, pa->orientation,
+                                             &cache_b->hull, pb->position, pb->orientation,
+                                             entry ? &entry->gjk : NULL, &simplex);
+    if (entry)
+    {
+        if (entry->gjk.iterations == 0)
+        {
+            pair_cache->axis_rejects++;
+        }
+        else
+        {
+            pair_cache->gjk_runs++;
+            pair_cache->gjk_iterations += entry->gjk.iterations;
+        }
+    }
+    if (!intersecting)
         return false;
 
+    if (pair_cache)
+        pair_cache->epa_runs++;
+
     EPAResult epa;
-    if (!epa_penetration(&cache_a->hull, obj_a->position, obj_a->orientation,
-                         &cache_b->hull, obj_b->position, obj_b->orientation,
+    if (!epa_penetration(&cache_a->hull, pa->position, pa->orientation,
+                         &cache_b->hull, pb->position, pb->orientation,
                          &simplex, &epa))
     {
-        return detect_obb_collision(obj_a, obj_b, out_contact, out_normal, out_penetration);
+        return detect_obb_collision(obj_a, pa, obj_b, pb, out_contact, out_normal, out_penetration);
     }
 
+    /* Touching contacts are cached too, so a resting pair skips EPA until it deepens */
+    if (entry)
+        store_hull_contact(entry, &epa, obj_a, pa, obj_b, pb);
+
     float combined_margin = cache_a->hull.margin + cache_b->hull.margin;
     float adjusted_depth = epa.depth - combined_margin;
 
     if (adjusted_depth < K_EPSILON)
     {
-        return detect_obb_collision(obj_a, obj_b, out_contact, out_normal, out_penetration);
+        return detect_obb_collision(obj_a, pa, obj_b, pb, out_contact, out_normal, out_penetration);
     }
 
     *out_contact = vec3_scale(vec3_add(epa.contact_a, epa.contact_b), 0.5f);
@@ -347,6 +560,49 @@ static bool detect_hull_collision(VoxelObject *obj_a, int32_t idx_a,
     return true;
 }
 
+/* Half-width of an object's shape box along a world direction */
+static float shape_extent_along(const VoxelObject *obj, Quat orientation, Vec3 dir)
+{
+    Vec3 local = quat_rotate_vec3(quat_conjugate(orientation), dir);
+    return fabsf(local.x) * obj->shape_half_extents.x +
+           fabsf(local.y) * obj->shape_half_extents.y +
+           fabsf(local.z) * obj->shape_half_extents.z;
+}
+
+/*
+ * Separated pair with a fast body: contact on the line of centers with the
+ * shape-box gap as negative penetration, so the solver lets them close the
+ * gap this step but not pass through each other.
+ */
+static bool speculative_contact(const PhysicsWorld *world,
+                                int32_t body_a, const VoxelObject *obj_a, const VoxelObjectPose *pa,
+                                int32_t body_b, const VoxelObject *obj_b, const VoxelObjectPose *pb,
+                                Vec3 *out_contact, Vec3 *out_normal, float *out_penetration)
+{
+    Vec3 delta = vec3_sub(pb->position, pa->position);
+    float dist = vec3_length(delta);
+    if (dist < K_EPSILON)
+        return false;
+
+    Vec3 normal = vec3_scale(delta, 1.0f / dist);
+    Vec3 rel_vel = vec3_sub(physics_body_velocity(world, body_b), physics_body_velocity(world, body_a));
+    if (vec3_dot(rel_vel, normal) >= 0.0f)
+        return false;
+
+    float extent_a = shape_extent_along(obj_a, pa->orientation, normal);
+    float extent_b = shape_extent_along(obj_b, pb->orientation, normal);
+    float gap = dist - extent_a - extent_b;
+    if (gap <= 0.0f)
+        return false; /* Boxes overlap but voxels do not: leave it to narrowphase */
+
+    Vec3 surface_a = vec3_add(pa->position, vec3_scale(normal, extent_a));
+    Vec3 surface_b = vec3_sub(pb->position, vec3_scale(normal, extent_b));
+    *out_contact = vec3_scale(vec3_add(surface_a, surface_b), 0.5f);
+    *out_normal = normal;
+    *out_penetration = -gap;
+    return true;
+}
+
 static bool try_add_collision_pair(PhysicsWorld *world, VoxelObjectWorld *obj_world,
                                    ObjectCollisionPair *pairs, int32_t *pair_count,
                                    int32_t max_pairs, int32_t i, int32_t j)
@@ -358,15 +614,31 @@ static bool try_add_collision_pair(PhysicsWorld *world, VoxelObjectWorld *obj_wo
     RigidBody *body_b = &world->bodies[j];
     VoxelObject *obj_a = &obj_world->objects[body_a->vobj_index];
     VoxelObject *obj_b = &obj_world->objects[body_b->vobj_index];
+    VoxelObjectPose pose_a = voxel_object_pose(obj_world, body_a->vobj_index);
+    VoxelObjectPose pose_b = voxel_object_pose(obj_world, body_b->vobj_index);
 
-    if (!test_sphere_sphere_coarse(obj_a, obj_b))
-        return true;
-
+    bool fast = ((world->flags[i] | world->flags[j]) & PHYS_FLAG_FAST) != 0;
     Vec3 contact, normal;
     float penetration;
 
-    if (detect_hull_collision(obj_a, body_a->vobj_index, obj_b, body_b->vobj_index,
-                              &contact, &normal, &penetration))
+    bool touching = false;
+    if (test_sphere_sphere_coarse(obj_a, &pose_a, obj_b, &pose_b))
+    {
+        PhysicsPairCache *pair_cache = world->pair_cache;
+        PairCacheEntry *entry = pair_cache ? pair_cache_get(pair_cache, i, j) : NULL; /* SAP orders i < j */
+
+        /* One sample per hull pair: the average is the per-pair narrowphase cost */
+        PROFILE_BEGIN(PROFILE_SIM_NARROWPHASE);
+        touching = detect_hull_collision(pair_cache, entry,
+                                         obj_a, &pose_a, body_a->vobj_index,
+                                         obj_b, &pose_b, body_b->vobj_index,
+                                         &contact, &normal, &penetration);
+        PROFILE_END(PROFILE_SIM_NARROWPHASE);
+    }
+    if (!touching && fast)
+        touching = speculative_contact(world, i, obj_a, &pose_a, j, obj_b, &pose_b, &contact, &normal, &penetration);
+
+    if (touching)
     {
         pairs[*pair_count].body_a = i;
         pairs[*pair_count].body_b = j;
@@ -388,9 +660,11 @@ int32_t physics_detect_object_pairs(PhysicsWorld *world,
 
     int32_t pair_count = 0;
     VoxelObjectWorld *obj_world = world->objects;
+    if (world->pair_cache)
+        pair_cache_begin(world->pair_cache);
 
-    SAPPair sap_pairs[SAP_MAX_PAIRS];
-    int32_t sap_count = sap_query_pairs(world->broadphase, sap_pairs, SAP_MAX_PAIRS);
+    int32_t sap_count = 0;
+    const SAPPair *sap_pairs = sap_get_pairs(world->broadphase, &sap_count);
 
     for (int32_t p = 0; p < sap_count && pair_count < max_pairs; p++)
     {
@@ -399,12 +673,15 @@ int32_t physics_detect_object_pairs(PhysicsWorld *world,
 
         RigidBody *body_a = &world->bodies[i];
         RigidBody *body_b = &world->bodies[j];
+        uint8_t flags_a = world->flags[i];
+        uint8_t flags_b = world->flags[j];
 
-        if (!(body_a->flags & PHYS_FLAG_ACTIVE) || !(body_b->flags & PHYS_FLAG_ACTIVE))
+        if (!(flags_a & PHYS_FLAG_ACTIVE) || !(flags_b & PHYS_FLAG_ACTIVE))
             continue;
 
-        bool a_sleeping = (body_a->flags & PHYS_FLAG_SLEEPING) != 0;
-        bool b_sleeping = (body_b->flags & PHYS_FLAG_SLEEPING) != 0;
+        /* Static bodies count as resting: a sleeper on one stays untouched */
+        bool a_sleeping = (flags_a & (PHYS_FLAG_SLEEPING | PHYS_FLAG_STATIC)) != 0;
+        bool b_sleeping = (flags_b & (PHYS_FLAG_SLEEPING | PHYS_FLAG_STATIC)) != 0;
         if (a_sleeping && b_sleeping)
             continue;
 
@@ -421,15 +698,17 @@ int32_t physics_detect_object_pairs(PhysicsWorld *world,
     return pair_count;
 }
 
-static float compute_effective_mass_pair(RigidBody *body, VoxelObject *obj, Vec3 r, Vec3 n)
+static float compute_effective_mass_pair(const PhysicsWorld *world, int32_t body_index, Quat orientation,
+                                         Vec3 r, Vec3 n)
 {
-    if (body->inv_mass == 0.0f)
+    float inv_mass = world->inv_mass[body_index];
+    if (inv_mass == 0.0f)
         return 0.0f;
 
     Vec3 r_cross_n = vec3_cross(r, n);
 
     float mat3[9];
-    quat_to_mat3(obj->orientation, mat3);
+    quat_to_mat3(orientation, mat3);
     Vec3 rot_mat[3];
     rot_mat[0] = vec3_create(mat3[0], mat3[1], mat3[2]);
     rot_mat[1] = vec3_create(mat3[3], mat3[4], mat3[5]);
@@ -440,7 +719,7 @@ static float compute_effective_mass_pair(RigidBody *body, VoxelObject *obj, Vec3
         vec3_dot(rot_mat[1], r_cross_n),
         vec3_dot(rot_mat[2], r_cross_n));
 
-    Vec3 scaled = vec3_mul(local_r_cross_n, body->inv_inertia_local);
+    Vec3 scaled = vec3_mul(local_r_cross_n, physics_body_inv_inertia(world, body_index));
 
     Vec3 world_scaled = vec3_create(
         rot_mat[0].x * scaled.x + rot_mat[1].x * scaled.y + rot_mat[2].x * scaled.z,
@@ -448,19 +727,21 @@ static float compute_effective_mass_pair(RigidBody *body, VoxelObject *obj, Vec3
         rot_mat[0].z * scaled.x + rot_mat[1].z * scaled.y + rot_mat[2].z * scaled.z);
 
     Vec3 term = vec3_cross(world_scaled, r);
-    return body->inv_mass + vec3_dot(term, n);
+    return inv_mass + vec3_dot(term, n);
 }
 
-static Vec3 obj_world_com(VoxelObject *obj)
+static Vec3 obj_world_com(VoxelObject *obj, const VoxelObjectPose *pose)
 {
-    Vec3 rotated_com = quat_rotate_vec3(obj->orientation, obj->local_com);
-    return vec3_add(obj->position, rotated_com);
+    Vec3 rotated_com = quat_rotate_vec3(pose->orientation, obj->local_com);
+    return vec3_add(pose->position, rotated_com);
 }
 
-static Vec3 get_point_vel(RigidBody *body, VoxelObject *obj, Vec3 world_point)
+static Vec3 get_point_vel(const PhysicsWorld *world, int32_t body_index, VoxelObject *obj,
+                          const VoxelObjectPose *pose, Vec3 world_point)
 {
-    Vec3 r = vec3_sub(world_point, obj_world_com(obj));
-    return vec3_add(body->velocity, vec3_cross(body->angular_velocity, r));
+    Vec3 r = vec3_sub(world_point, obj_world_com(obj, pose));
+    return vec3_add(physics_body_velocity(world, body_index),
+                    vec3_cross(physics_body_angular_velocity(world, body_index), r));
 }
 
 void physics_resolve_object_collision(PhysicsWorld *world,
@@ -471,32 +752,38 @@ void physics_resolve_object_collision(PhysicsWorld *world,
 
     if (!world || !pair || !pair->valid)
         return;
+    if (pair->penetration < 0.0f)
+        return; /* Speculative: only the manifold solver can hold a gap */
 
     RigidBody *body_a = &world->bodies[pair->body_a];
     RigidBody *body_b = &world->bodies[pair->body_b];
 
-    if (!(body_a->flags & PHYS_FLAG_ACTIVE) || !(body_b->flags & PHYS_FLAG_ACTIVE))
+    uint8_t flags_a = world->flags[pair->body_a];
+    uint8_t flags_b = world->flags[pair->body_b];
+    if (!(flags_a & PHYS_FLAG_ACTIVE) || !(flags_b & PHYS_FLAG_ACTIVE))
         return;
 
     VoxelObject *obj_a = &world->objects->objects[body_a->vobj_index];
     VoxelObject *obj_b = &world->objects->objects[body_b->vobj_index];
+    VoxelObjectPose pose_a = voxel_object_pose(world->objects, body_a->vobj_index);
+    VoxelObjectPose pose_b = voxel_object_pose(world->objects, body_b->vobj_index);
 
-    Vec3 r_a = vec3_sub(pair->contact_point, obj_world_com(obj_a));
-    Vec3 r_b = vec3_sub(pair->contact_point, obj_world_com(obj_b));
+    Vec3 r_a = vec3_sub(pair->contact_point, obj_world_com(obj_a, &pose_a));
+    Vec3 r_b = vec3_sub(pair->contact_point, obj_world_com(obj_b, &pose_b));
 
     Vec3 n = vec3_neg(pair->contact_normal);
 
-    Vec3 vel_a = get_point_vel(body_a, obj_a, pair->contact_point);
-    Vec3 vel_b = get_point_vel(body_b, obj_b, pair->contact_point);
+    Vec3 vel_a = get_point_vel(world, pair->body_a, obj_a, &pose_a, pair->contact_point);
+    Vec3 vel_b = get_point_vel(world, pair->body_b, obj_b, &pose_b, pair->contact_point);
     Vec3 rel_vel = vec3_sub(vel_a, vel_b);
 
     float v_n = vec3_dot(rel_vel, n);
 
-    float inv_mass_a = (body_a->flags & PHYS_FLAG_STATIC) ? 0.0f : body_a->inv_mass;
-    float inv_mass_b = (body_b->flags & PHYS_FLAG_STATIC) ? 0.0f : body_b->inv_mass;
+    float inv_mass_a = (flags_a & PHYS_FLAG_STATIC) ? 0.0f : world->inv_mass[pair->body_a];
+    float inv_mass_b = (flags_b & PHYS_FLAG_STATIC) ? 0.0f : world->inv_mass[pair->body_b];
 
-    float eff_mass_a = (inv_mass_a > 0.0f) ? compute_effective_mass_pair(body_a, obj_a, r_a, n) : 0.0f;
-    float eff_mass_b = (inv_mass_b > 0.0f) ? compute_effective_mass_pair(body_b, obj_b, r_b, n) : 0.0f;
+    float eff_mass_a = (inv_mass_a > 0.0f) ? compute_effective_mass_pair(world, pair->body_a, pose_a.orientation, r_a, n) : 0.0f;
+    float eff_mass_b = (inv_mass_b > 0.0f) ? compute_effective_mass_pair(world, pair->body_b, pose_b.orientation, r_b, n) : 0.0f;
     float total_eff_mass = eff_mass_a + eff_mass_b;
 
     if (total_eff_mass < K_EPSILON)
@@ -516,12 +803,14 @@ void physics_resolve_object_collision(PhysicsWorld *world,
         if (inv_mass_a > 0.0f)
         {
             float ratio_a = inv_mass_a / total_inv_mass;
-            obj_a->position = vec3_add(obj_a->position, vec3_scale(n, correction * ratio_a));
+            voxel_object_set_position(world->objects, body_a->vobj_index,
+                                      vec3_add(pose_a.position, vec3_scale(n, correction * ratio_a)));
         }
         if (inv_mass_b > 0.0f)
         {
             float ratio_b = inv_mass_b / total_inv_mass;
-            obj_b->position = vec3_sub(obj_b->position, vec3_scale(n, correction * ratio_b));
+            voxel_object_set_position(world->objects, body_b->vobj_index,
+                                      vec3_sub(pose_b.position, vec3_scale(n, correction * ratio_b)));
         }
     }
 
@@ -566,9 +855,9 @@ void physics_resolve_object_collision(PhysicsWorld *world,
     physics_body_wake(world, pair->body_b);
 
     if (pair->contact_normal.y > 0.5f)
-        body_a->flags |= PHYS_FLAG_OBJ_CONTACT;
+        world->flags[pair->body_a] |= PHYS_FLAG_OBJ_CONTACT;
     if (pair->contact_normal.y < -0.5f)
-        body_b->flags |= PHYS_FLAG_OBJ_CONTACT;
+        world->flags[pair->body_b] |= PHYS_FLAG_OBJ_CONTACT;
 }
 
 void physics_process_object_collisions(PhysicsWorld *world, float dt)
@@ -2,6 +2,7 @@
 #define PATCH_PHYSICS_COLLISION_OBJECT_H
 
 #include "rigidbody.h"
+#include "gjk.h"
 #include "engine/core/types.h"
 #include "engine/voxel/voxel_object.h"
 
@@ -13,16 +14,72 @@ extern "C"
 #define PHYS_OBJ_COLLISION_BUDGET 128
 #define PHYS_OBJ_SAMPLE_POINTS 8
 
+/*
+ * Narrowphase coherence: hull pairs keep their GJK state and last EPA
+ * result between steps.
+ * - a pair separated last step is first tested on its old separating
+ *   axis; one support query settles it while the pair stays apart
+ * - support queries climb from last step's vertices
+ * - a touching pair is re-measured along its old normal, including pairs
+ *   that only touch within their hull margins; EPA only runs for new
+ *   contacts, contacts deepening past PHYS_PAIR_CACHE_DEEPEN_RATIO,
+ *   drifted contacts, and every PHYS_PAIR_CACHE_MAX_AGE steps
+ * Entries live while their pair is tested every step.
+ */
+#define PHYS_PAIR_CACHE_MAX 1024
+#define PHYS_PAIR_CACHE_TABLE_SIZE 2048    /* Power of two, >= 2x PHYS_PAIR_CACHE_MAX */
+#define PHYS_PAIR_CACHE_DEEPEN_RATIO 0.1f  /* Depth gain that re-runs EPA, in voxels */
+#define PHYS_PAIR_CACHE_MAX_AGE 8          /* Steps a reused EPA result lasts */
+
     typedef struct
     {
         int32_t body_a;
         int32_t body_b;
         Vec3 contact_point;
         Vec3 contact_normal;
-        float penetration;
+        float penetration; /* Negative = speculative gap ahead of a fast body */
         bool valid;
     } ObjectCollisionPair;
 
+    typedef struct
+    {
+        int32_t body_a; /* body_a < body_b */
+        int32_t body_b;
+        uint32_t stamp; /* Step the pair was last tested */
+        GJKCache gjk;
+
+        /* Last EPA contact, in the bodies' local frames (relative to position) */
+        bool has_contact;
+        Vec3 normal_local; /* A's frame */
+        Vec3 contact_a_local;
+        Vec3 contact_b_local;
+        float depth; /* EPA depth, margins included */
+        int32_t age; /* Steps reused since EPA ran */
+        uint32_t revision_a;
+        uint32_t revision_b;
+    } PairCacheEntry;
+
+    typedef struct PhysicsPairCache
+    {
+        PairCacheEntry entries[PHYS_PAIR_CACHE_MAX];
+        int32_t count;
+        int16_t table[PHYS_PAIR_CACHE_TABLE_SIZE]; /* -1 = empty */
+        uint32_t stamp;
+
+        /* Last step */
+        int32_t hull_tests;     /* Pairs that reached the hull test */
+        int32_t axis_rejects;   /* Settled apart by the cached axis alone */
+        int32_t contact_reuses; /* Contacts re-measured without EPA */
+        int32_t gjk_runs;
+        int32_t gjk_iterations;
+        int32_t epa_runs;
+        int32_t hull_reuses;   /* Voxels changed, hull kept as is */
+        int32_t hull_rebuilds; /* Hulls built from scratch */
+    } PhysicsPairCache;
+
+    void physics_pair_cache_init(PhysicsPairCache *cache);
+
+    /* Overlapping pairs, plus speculative pairs for fast bodies about to hit something */
     int32_t physics_detect_object_pairs(PhysicsWorld *world,
                                         ObjectCollisionPair *pairs,
                                         int32_t max_pairs);
@@ -2,17 +2,42 @@
 #include <string.h>
 #include <stdlib.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define QH_SSE2 1
+#endif
+
 #define QH_MAX_FACES 512
 #define QH_EPSILON 1e-6f
+#define QH_TOLERANCE 1e-5f /* Plane tolerance, relative to the point set's extent */
+#define QH_CULL_DIRECTIONS 26
 
 typedef struct
 {
-    int32_t v[3];
+    int32_t v[3]; /* Indices into QHull.verts */
     Vec3 normal;
     float dist;
     bool active;
 } QHFace;
 
+typedef struct
+{
+    Vec3 verts[HULL_MAX_VERTICES];
+    int32_t vert_count;
+    QHFace faces[QH_MAX_FACES];
+    int32_t face_count;
+    Vec3 center; /* Inside every face; orients new faces */
+    float tolerance;
+
+    /* Conflict lists: a point outside the hull belongs to the face it is farthest outside of */
+    const Vec3 *points;
+    int32_t point_count;
+    int32_t *owner; /* Face index, -1 = inside the hull or already a vertex */
+    float *owner_dist;
+    int32_t *live; /* Points that had an owner when last scanned */
+    int32_t live_count;
+} QHull;
+
 static Vec3 qh_compute_normal(Vec3 a, Vec3 b, Vec3 c)
 {
     Vec3 ab = vec3_sub(b, a);
@@ -24,39 +49,177 @@ static Vec3 qh_compute_normal(Vec3 a, Vec3 b, Vec3 c)
     return vec3_create(0.0f, 1.0f, 0.0f);
 }
 
-static float qh_signed_distance(Vec3 p, Vec3 face_point, Vec3 normal)
+static float qh_tolerance(const Vec3 *points, int32_t count)
+{
+    Vec3 lo = points[0];
+    Vec3 hi = points[0];
+    for (int32_t i = 1; i < count; i++)
+    {
+        lo = vec3_create(minf(lo.x, points[i].x), minf(lo.y, points[i].y), minf(lo.z, points[i].z));
+        hi = vec3_create(maxf(hi.x, points[i].x), maxf(hi.y, points[i].y), maxf(hi.z, points[i].z));
+    }
+    float scale = vec3_max_component(vec3_sub(hi, lo));
+    return maxf(scale * QH_TOLERANCE, QH_EPSILON);
+}
+
+/*
+ * For each listed point, the plane it lies farthest outside of by more than
+ * tolerance, or -1. Eight points per step against one broadcast plane, as
+ * two independent lanes of four.
+ */
+static void qh_classify(const Vec3 *points, const int32_t *point_list, int32_t count,
+                        const HullFace *planes, int32_t plane_count, float tolerance,
+                        int32_t *out_plane, float *out_dist)
+{
+    int32_t i = 0;
+#ifdef QH_SSE2
+    for (; i + 8 <= count; i += 8)
+    {
+        float xs[8], ys[8], zs[8];
+        for (int32_t k = 0; k < 8; k++)
+        {
+            Vec3 p = points[point_list ? point_list[i + k] : i + k];
+            xs[k] = p.x;
+            ys[k] = p.y;
+            zs[k] = p.z;
+        }
+
+        __m128 px0 = _mm_loadu_ps(xs), px1 = _mm_loadu_ps(xs + 4);
+        __m128 py0 = _mm_loadu_ps(ys), py1 = _mm_loadu_ps(ys + 4);
+        __m128 pz0 = _mm_loadu_ps(zs), pz1 = _mm_loadu_ps(zs + 4);
+        __m128 best0 = _mm_set1_ps(tolerance), best1 = best0;
+        __m128i plane0 = _mm_set1_epi32(-1), plane1 = plane0;
+
+        for (int32_t f = 0; f < plane_count; f++)
+        {
+            const HullFace *pl = &planes[f];
+            __m128 nx = _mm_set1_ps(pl->normal.x);
+            __m128 ny = _mm_set1_ps(pl->normal.y);
+            __m128 nz = _mm_set1_ps(pl->normal.z);
+            __m128 nd = _mm_set1_ps(pl->dist);
+            __m128i fi = _mm_set1_epi32(f);
+
+            __m128 d0 = _mm_add_ps(_mm_mul_ps(px0, nx), _mm_mul_ps(py0, ny));
+            __m128 d1 = _mm_add_ps(_mm_mul_ps(px1, nx), _mm_mul_ps(py1, ny));
+            d0 = _mm_sub_ps(_mm_add_ps(d0, _mm_mul_ps(pz0, nz)), nd);
+            d1 = _mm_sub_ps(_mm_add_ps(d1, _mm_mul_ps(pz1, nz)), nd);
+
+            __m128i gt0 = _mm_castps_si128(_mm_cmpgt_ps(d0, best0));
+            __m128i gt1 = _mm_castps_si128(_mm_cmpgt_ps(d1, best1));
+            best0 = _mm_max_ps(best0, d0);
+            best1 = _mm_max_ps(best1, d1);
+            plane0 = _mm_or_si128(_mm_and_si128(gt0, fi), _mm_andnot_si128(gt0, plane0));
+            plane1 = _mm_or_si128(_mm_and_si128(gt1, fi), _mm_andnot_si128(gt1, plane1));
+        }
+
+        _mm_storeu_ps(out_dist + i, best0);
+        _mm_storeu_ps(out_dist + i + 4, best1);
+        _mm_storeu_si128((__m128i *)(out_plane + i), plane0);
+        _mm_storeu_si128((__m128i *)(out_plane + i + 4), plane1);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        Vec3 p = points[point_list ? point_list[i] : i];
+        float best = tolerance;
+        int32_t best_plane = -1;
+        for (int32_t f = 0; f < plane_count; f++)
+        {
+            float d = vec3_dot(planes[f].normal, p) - planes[f].dist;
+            if (d > best)
+            {
+                best = d;
+                best_plane = f;
+            }
+        }
+        out_dist[i] = best;
+        out_plane[i] = best_plane;
+    }
+}
+
+static bool qh_begin(QHull *qh, const Vec3 *points, int32_t count, float tolerance)
+{
+    qh->vert_count = 0;
+    qh->face_count = 0;
+    qh->tolerance = tolerance;
+    qh->points = points;
+    qh->point_count = count;
+    qh->live_count = 0;
+
+    void *block = calloc((size_t)count, sizeof(int32_t) * 2 + sizeof(float));
+    if (!block)
+        return false;
+    qh->owner = (int32_t *)block;
+    qh->live = qh->owner + count;
+    qh->owner_dist = (float *)(qh->live + count);
+    for (int32_t i = 0; i < count; i++)
+        qh->owner[i] = -1;
+    return true;
+}
+
+static void qh_end(QHull *qh)
+{
+    free(qh->owner);
+    qh->owner = NULL;
+}
+
+static bool qh_add_face(QHull *qh, int32_t a, int32_t b, int32_t c)
 {
-    return vec3_dot(vec3_sub(p, face_point), normal);
+    if (qh->face_count >= QH_MAX_FACES)
+        return false;
+
+    QHFace *f = &qh->faces[qh->face_count++];
+    f->normal = qh_compute_normal(qh->verts[a], qh->verts[b], qh->verts[c]);
+    if (vec3_dot(f->normal, vec3_sub(qh->center, qh->verts[a])) > 0.0f)
+    {
+        f->normal = vec3_neg(f->normal);
+        int32_t tmp = b;
+        b = c;
+        c = tmp;
+    }
+    f->v[0] = a;
+    f->v[1] = b;
+    f->v[2] = c;
+    f->dist = vec3_dot(f->normal, qh->verts[a]);
+    f->active = true;
+    return true;
 }
 
-static int32_t qh_find_extreme_point(const Vec3 *points, int32_t count, Vec3 dir)
+static int32_t qh_find_extreme_point(const Vec3 *points, const int32_t *list, int32_t count, Vec3 dir)
 {
-    int32_t best = 0;
-    float best_dot = vec3_dot(points[0], dir);
+    int32_t best = list[0];
+    float best_dot = vec3_dot(points[best], dir);
     for (int32_t i = 1; i < count; i++)
     {
-        float d = vec3_dot(points[i], dir);
+        float d = vec3_dot(points[list[i]], dir);
         if (d > best_dot)
         {
             best_dot = d;
-            best = i;
+            best = list[i];
         }
     }
     return best;
 }
 
-static bool qh_build_initial_tetrahedron(const Vec3 *points, int32_t count,
-                                          int32_t *out_indices, Vec3 *out_verts)
+/* Starts the hull as a tetrahedron of listed points; false when they are flat */
+static bool qh_init_simplex(QHull *qh, const int32_t *list, int32_t count)
 {
     if (count < 4)
         return false;
 
-    int32_t idx0 = qh_find_extreme_point(points, count, vec3_create(1, 0, 0));
-    int32_t idx1 = qh_find_extreme_point(points, count, vec3_create(-1, 0, 0));
+    const Vec3 *points = qh->points;
+    int32_t idx0 = qh_find_extreme_point(points, list, count, vec3_create(1, 0, 0));
+    int32_t idx1 = qh_find_extreme_point(points, list, count, vec3_create(-1, 0, 0));
 
-    if (idx0 == idx1)
+    if (vec3_length_sq(vec3_sub(points[idx0], points[idx1])) < QH_EPSILON)
+    {
+        idx0 = qh_find_extreme_point(points, list, count, vec3_create(0, 1, 0));
+        idx1 = qh_find_extreme_point(points, list, count, vec3_create(0, -1, 0));
+    }
+    if (vec3_length_sq(vec3_sub(points[idx0], points[idx1])) < QH_EPSILON)
     {
-        idx1 = qh_find_extreme_point(points, count, vec3_create(0, 1, 0));
+        idx0 = qh_find_extreme_point(points, list, count, vec3_create(0, 0, 1));
+        idx1 = qh_find_extreme_point(points, list, count, vec3_create(0, 0, -1));
     }
 
     Vec3 line_dir = vec3_normalize(vec3_sub(points[idx1], points[idx0]));
@@ -65,20 +228,17 @@ static bool qh_build_initial_tetrahedron(const Vec3 *points, int32_t count,
 
     for (int32_t i = 0; i < count; i++)
     {
-        if (i == idx0 || i == idx1)
-            continue;
-        Vec3 to_p = vec3_sub(points[i], points[idx0]);
-        Vec3 proj = vec3_scale(line_dir, vec3_dot(to_p, line_dir));
-        Vec3 perp = vec3_sub(to_p, proj);
+        Vec3 to_p = vec3_sub(points[list[i]], points[idx0]);
+        Vec3 perp = vec3_sub(to_p, vec3_scale(line_dir, vec3_dot(to_p, line_dir)));
         float dist = vec3_length(perp);
         if (dist > max_dist)
         {
             max_dist = dist;
-            idx2 = i;
+            idx2 = list[i];
         }
     }
 
-    if (idx2 < 0 || max_dist < QH_EPSILON)
+    if (idx2 < 0 || max_dist < qh->tolerance)
         return false;
 
     Vec3 plane_normal = qh_compute_normal(points[idx0], points[idx1], points[idx2]);
@@ -87,290 +247,456 @@ static bool qh_build_initial_tetrahedron(const Vec3 *points, int32_t count,
 
     for (int32_t i = 0; i < count; i++)
     {
-        if (i == idx0 || i == idx1 || i == idx2)
-            continue;
-        float dist = fabsf(qh_signed_distance(points[i], points[idx0], plane_normal));
+        float dist = fabsf(vec3_dot(vec3_sub(points[list[i]], points[idx0]), plane_normal));
         if (dist > max_dist)
         {
             max_dist = dist;
-            idx3 = i;
+            idx3 = list[i];
         }
     }
 
-    if (idx3 < 0 || max_dist < QH_EPSILON)
+    if (idx3 < 0 || max_dist < qh->tolerance)
         return false;
 
-    out_indices[0] = idx0;
-    out_indices[1] = idx1;
-    out_indices[2] = idx2;
-    out_indices[3] = idx3;
-    out_verts[0] = points[idx0];
-    out_verts[1] = points[idx1];
-    out_verts[2] = points[idx2];
-    out_verts[3] = points[idx3];
-
+    qh->verts[0] = points[idx0];
+    qh->verts[1] = points[idx1];
+    qh->verts[2] = points[idx2];
+    qh->verts[3] = points[idx3];
+    qh->vert_count = 4;
+    qh->center = vec3_scale(vec3_add(vec3_add(qh->verts[0], qh->verts[1]),
+                                     vec3_add(qh->verts[2], qh->verts[3])),
+                            0.25f);
+
+    qh_add_face(qh, 0, 1, 2);
+    qh_add_face(qh, 0, 3, 1);
+    qh_add_face(qh, 1, 3, 2);
+    qh_add_face(qh, 2, 3, 0);
     return true;
 }
 
-void convex_hull_build(const Vec3 *points, int32_t count, ConvexHull *out)
+/* Assigns listed points to the listed faces they are outside of; NULL face list = every active face */
+static void qh_assign(QHull *qh, const int32_t *point_list, int32_t point_count,
+                      const int32_t *face_list, int32_t face_count)
 {
-    memset(out, 0, sizeof(ConvexHull));
-
-    if (count < 4)
+    HullFace planes[QH_MAX_FACES];
+    int32_t plane_face[QH_MAX_FACES];
+    int32_t plane_count = 0;
+    int32_t n = face_list ? face_count : qh->face_count;
+    for (int32_t i = 0; i < n; i++)
     {
-        for (int32_t i = 0; i < count && i < HULL_MAX_VERTICES; i++)
-        {
-            out->vertices[i] = points[i];
-        }
-        out->vertex_count = count < HULL_MAX_VERTICES ? count : HULL_MAX_VERTICES;
+        int32_t fi = face_list ? face_list[i] : i;
+        if (!qh->faces[fi].active)
+            continue;
+        planes[plane_count].normal = qh->faces[fi].normal;
+        planes[plane_count].dist = qh->faces[fi].dist;
+        plane_face[plane_count++] = fi;
+    }
+
+    int32_t *plane = (int32_t *)malloc((size_t)point_count * (sizeof(int32_t) + sizeof(float)));
+    if (!plane)
         return;
+    float *dist = (float *)(plane + point_count);
+    qh_classify(qh->points, point_list, point_count, planes, plane_count, qh->tolerance, plane, dist);
+
+    for (int32_t i = 0; i < point_count; i++)
+    {
+        if (plane[i] < 0)
+            continue;
+        int32_t pi = point_list ? point_list[i] : i;
+        qh->owner[pi] = plane_face[plane[i]];
+        qh->owner_dist[pi] = dist[i];
+        qh->live[qh->live_count++] = pi;
     }
+    free(plane);
+}
 
-    int32_t initial_idx[4];
-    Vec3 initial_verts[4];
-    if (!qh_build_initial_tetrahedron(points, count, initial_idx, initial_verts))
+static void qh_compact_faces(QHull *qh)
+{
+    int32_t remap[QH_MAX_FACES];
+    int32_t n = 0;
+    for (int32_t fi = 0; fi < qh->face_count; fi++)
     {
-        for (int32_t i = 0; i < count && i < HULL_MAX_VERTICES; i++)
+        if (qh->faces[fi].active)
         {
-            out->vertices[i] = points[i];
+            remap[fi] = n;
+            qh->faces[n++] = qh->faces[fi];
+        }
+        else
+        {
+            remap[fi] = -1;
         }
-        out->vertex_count = count < HULL_MAX_VERTICES ? count : HULL_MAX_VERTICES;
-        return;
     }
+    qh->face_count = n;
 
-    for (int32_t i = 0; i < 4; i++)
+    for (int32_t i = 0; i < qh->live_count; i++)
     {
-        out->vertices[i] = initial_verts[i];
+        int32_t pi = qh->live[i];
+        if (qh->owner[pi] >= 0)
+            qh->owner[pi] = remap[qh->owner[pi]];
     }
-    out->vertex_count = 4;
+}
 
-    QHFace faces[QH_MAX_FACES];
-    int32_t face_count = 0;
-
-    Vec3 center = vec3_scale(vec3_add(vec3_add(initial_verts[0], initial_verts[1]),
-                                       vec3_add(initial_verts[2], initial_verts[3])),
-                             0.25f);
-
-    int32_t tet_faces[4][3] = {
-        {0, 1, 2},
-        {0, 3, 1},
-        {1, 3, 2},
-        {2, 3, 0}};
-
-    for (int32_t i = 0; i < 4; i++)
-    {
-        QHFace *f = &faces[face_count];
-        f->v[0] = tet_faces[i][0];
-        f->v[1] = tet_faces[i][1];
-        f->v[2] = tet_faces[i][2];
-        f->normal = qh_compute_normal(out->vertices[f->v[0]],
-                                       out->vertices[f->v[1]],
-                                       out->vertices[f->v[2]]);
-        f->dist = vec3_dot(f->normal, out->vertices[f->v[0]]);
-        f->active = true;
-
-        Vec3 face_center = vec3_scale(vec3_add(vec3_add(out->vertices[f->v[0]],
-                                                         out->vertices[f->v[1]]),
-                                                out->vertices[f->v[2]]),
-                                       1.0f / 3.0f);
-        Vec3 to_center = vec3_sub(center, face_center);
-        if (vec3_dot(f->normal, to_center) > 0.0f)
-        {
-            f->normal = vec3_neg(f->normal);
-            f->dist = -f->dist;
-            int32_t tmp = f->v[1];
-            f->v[1] = f->v[2];
-            f->v[2] = tmp;
-        }
+static bool qh_face_has_edge(const QHFace *f, int32_t a, int32_t b)
+{
+    for (int32_t e = 0; e < 3; e++)
+    {
+        if (f->v[e] == a && f->v[(e + 1) % 3] == b)
+            return true;
+    }
+    return false;
+}
+
+/* Adds a conflict point as a vertex: removes the faces it sees, fans new faces from the horizon */
+static bool qh_add_vertex(QHull *qh, int32_t pi)
+{
+    if (qh->face_count > QH_MAX_FACES / 2)
+        qh_compact_faces(qh);
 
-        face_count++;
+    Vec3 p = qh->points[pi];
+    int32_t nv = qh->vert_count++;
+    qh->verts[nv] = p;
+    qh->owner[pi] = -1;
+
+    int32_t visible[QH_MAX_FACES];
+    int32_t visible_count = 0;
+    for (int32_t fi = 0; fi < qh->face_count; fi++)
+    {
+        const QHFace *f = &qh->faces[fi];
+        if (f->active && vec3_dot(f->normal, p) - f->dist > qh->tolerance)
+            visible[visible_count++] = fi;
     }
 
-    bool *used = (bool *)calloc(count, sizeof(bool));
-    for (int32_t i = 0; i < 4; i++)
+    /* Horizon: edges of visible faces whose twin belongs to a face that stays */
+    int32_t horizon[QH_MAX_FACES][2];
+    int32_t horizon_count = 0;
+    for (int32_t i = 0; i < visible_count; i++)
     {
-        used[initial_idx[i]] = true;
+        const QHFace *f = &qh->faces[visible[i]];
+        for (int32_t e = 0; e < 3; e++)
+        {
+            int32_t a = f->v[e];
+            int32_t b = f->v[(e + 1) % 3];
+            bool inner = false;
+            for (int32_t j = 0; j < visible_count && !inner; j++)
+                inner = j != i && qh_face_has_edge(&qh->faces[visible[j]], b, a);
+            if (!inner && horizon_count < QH_MAX_FACES)
+            {
+                horizon[horizon_count][0] = a;
+                horizon[horizon_count][1] = b;
+                horizon_count++;
+            }
+        }
     }
 
-    for (int32_t iter = 0; iter < count && out->vertex_count < HULL_MAX_VERTICES; iter++)
+    if (qh->face_count + horizon_count > QH_MAX_FACES)
+        return false;
+
+    for (int32_t i = 0; i < visible_count; i++)
+        qh->faces[visible[i]].active = false;
+
+    int32_t first_new = qh->face_count;
+    for (int32_t i = 0; i < horizon_count; i++)
+        qh_add_face(qh, horizon[i][0], horizon[i][1], nv);
+
+    /* Points of removed faces are only re-tested against the new ones */
+    int32_t new_faces[QH_MAX_FACES];
+    int32_t new_count = 0;
+    for (int32_t fi = first_new; fi < qh->face_count; fi++)
+        new_faces[new_count++] = fi;
+
+    int32_t orphans[HULL_MAX_VERTICES];
+    int32_t orphan_count = 0;
+    int32_t kept = 0;
+    for (int32_t i = 0; i < qh->live_count; i++)
     {
-        int32_t best_point = -1;
-        float best_dist = QH_EPSILON;
+        int32_t lp = qh->live[i];
+        int32_t owner = qh->owner[lp];
+        if (owner < 0)
+            continue;
+        if (!qh->faces[owner].active)
+        {
+            qh->owner[lp] = -1;
+            if (orphan_count == HULL_MAX_VERTICES)
+            {
+                qh_assign(qh, orphans, orphan_count, new_faces, new_count);
+                orphan_count = 0;
+            }
+            orphans[orphan_count++] = lp;
+            continue;
+        }
+        qh->live[kept++] = lp;
+    }
+    qh->live_count = kept;
+    if (orphan_count > 0)
+        qh_assign(qh, orphans, orphan_count, new_faces, new_count);
+    return true;
+}
 
-        for (int32_t fi = 0; fi < face_count; fi++)
+static void qh_expand(QHull *qh)
+{
+    while (qh->vert_count < HULL_MAX_VERTICES)
+    {
+        int32_t best = -1;
+        float best_dist = 0.0f;
+        int32_t kept = 0;
+        for (int32_t i = 0; i < qh->live_count; i++)
         {
-            if (!faces[fi].active)
+            int32_t pi = qh->live[i];
+            if (qh->owner[pi] < 0)
                 continue;
-
-            QHFace *f = &faces[fi];
-            for (int32_t pi = 0; pi < count; pi++)
+            qh->live[kept++] = pi;
+            if (qh->owner_dist[pi] > best_dist)
             {
-                if (used[pi])
-                    continue;
-
-                float d = qh_signed_distance(points[pi], out->vertices[f->v[0]], f->normal);
-                if (d > best_dist)
-                {
-                    best_dist = d;
-                    best_point = pi;
-                }
+                best_dist = qh->owner_dist[pi];
+                best = pi;
             }
         }
+        qh->live_count = kept;
 
-        if (best_point < 0)
+        if (best < 0 || !qh_add_vertex(qh, best))
             break;
+    }
+}
+
+static void qh_link(ConvexHull *out, int32_t v0, int32_t v1)
+{
+    for (int32_t a = 0; a < out->adj_count[v0]; a++)
+    {
+        if (out->adjacency[v0][a] == v1)
+            return;
+    }
+    if (out->adj_count[v0] < HULL_MAX_ADJACENCY)
+        out->adjacency[v0][out->adj_count[v0]++] = v1;
+}
+
+/* Writes the vertices referenced by live faces, face planes, and edge adjacency */
+static void qh_output(const QHull *qh, ConvexHull *out)
+{
+    memset(out, 0, sizeof(ConvexHull));
 
-        used[best_point] = true;
+    int32_t remap[HULL_MAX_VERTICES];
+    for (int32_t i = 0; i < qh->vert_count; i++)
+        remap[i] = -1;
 
-        int32_t new_vert = out->vertex_count++;
-        out->vertices[new_vert] = points[best_point];
+    for (int32_t fi = 0; fi < qh->face_count; fi++)
+    {
+        const QHFace *f = &qh->faces[fi];
+        if (!f->active)
+            continue;
 
-        bool visible[QH_MAX_FACES] = {false};
-        for (int32_t fi = 0; fi < face_count; fi++)
+        int32_t v[3];
+        for (int32_t e = 0; e < 3; e++)
         {
-            if (!faces[fi].active)
-                continue;
-            QHFace *f = &faces[fi];
-            float d = qh_signed_distance(points[best_point], out->vertices[f->v[0]], f->normal);
-            if (d > QH_EPSILON)
+            if (remap[f->v[e]] < 0)
             {
-                visible[fi] = true;
+                remap[f->v[e]] = out->vertex_count;
+                out->vertices[out->vertex_count++] = qh->verts[f->v[e]];
             }
+            v[e] = remap[f->v[e]];
         }
 
-        typedef struct
+        if (out->face_count < HULL_MAX_FACES)
         {
-            int32_t v0, v1;
-            int32_t face;
-        } HorizonEdge;
-        HorizonEdge horizon[256];
-        int32_t horizon_count = 0;
+            out->faces[out->face_count].normal = f->normal;
+            out->faces[out->face_count].dist = f->dist;
+            out->face_count++;
+        }
 
-        for (int32_t fi = 0; fi < face_count && horizon_count < 256; fi++)
+        for (int32_t e = 0; e < 3; e++)
         {
-            if (!faces[fi].active || !visible[fi])
-                continue;
+            qh_link(out, v[e], v[(e + 1) % 3]);
+            qh_link(out, v[(e + 1) % 3], v[e]);
+        }
+    }
+}
 
-            QHFace *f = &faces[fi];
-            int32_t edges[3][2] = {{f->v[0], f->v[1]}, {f->v[1], f->v[2]}, {f->v[2], f->v[0]}};
+static void hull_copy_points(const Vec3 *points, int32_t count, ConvexHull *out)
+{
+    memset(out, 0, sizeof(ConvexHull));
+    for (int32_t i = 0; i < count && i < HULL_MAX_VERTICES; i++)
+    {
+        out->vertices[i] = points[i];
+    }
+    out->vertex_count = count < HULL_MAX_VERTICES ? count : HULL_MAX_VERTICES;
+}
 
-            for (int32_t e = 0; e < 3; e++)
+/* Points extreme along the axes, face diagonals and corner diagonals, without duplicates */
+static int32_t qh_find_cull_extremes(const Vec3 *points, int32_t count, int32_t *out)
+{
+    Vec3 axes[QH_CULL_DIRECTIONS / 2];
+    float lo[QH_CULL_DIRECTIONS / 2], hi[QH_CULL_DIRECTIONS / 2];
+    int32_t lo_idx[QH_CULL_DIRECTIONS / 2], hi_idx[QH_CULL_DIRECTIONS / 2];
+    int32_t axis_count = 0;
+    for (int32_t z = -1; z <= 1; z++)
+        for (int32_t y = -1; y <= 1; y++)
+            for (int32_t x = -1; x <= 1; x++)
             {
-                int32_t ev0 = edges[e][0];
-                int32_t ev1 = edges[e][1];
-
-                bool edge_shared_with_invisible = false;
-                for (int32_t fi2 = 0; fi2 < face_count; fi2++)
-                {
-                    if (fi2 == fi || !faces[fi2].active || visible[fi2])
-                        continue;
-
-                    QHFace *f2 = &faces[fi2];
-                    for (int32_t e2 = 0; e2 < 3; e2++)
-                    {
-                        int32_t e2v0 = f2->v[e2];
-                        int32_t e2v1 = f2->v[(e2 + 1) % 3];
-                        if ((e2v0 == ev0 && e2v1 == ev1) || (e2v0 == ev1 && e2v1 == ev0))
-                        {
-                            edge_shared_with_invisible = true;
-                            break;
-                        }
-                    }
-                    if (edge_shared_with_invisible)
-                        break;
-                }
-
-                if (edge_shared_with_invisible && horizon_count < 256)
-                {
-                    horizon[horizon_count].v0 = ev0;
-                    horizon[horizon_count].v1 = ev1;
-                    horizon[horizon_count].face = fi;
-                    horizon_count++;
-                }
+                /* One of each opposite pair: the first nonzero component is positive */
+                int32_t lead = x != 0 ? x : (y != 0 ? y : z);
+                if (lead <= 0)
+                    continue;
+                axes[axis_count] = vec3_create((float)x, (float)y, (float)z);
+                lo[axis_count] = hi[axis_count] = vec3_dot(points[0], axes[axis_count]);
+                lo_idx[axis_count] = hi_idx[axis_count] = 0;
+                axis_count++;
             }
-        }
-
-        for (int32_t fi = 0; fi < face_count; fi++)
-        {
-            if (visible[fi])
-                faces[fi].active = false;
-        }
 
-        for (int32_t hi = 0; hi < horizon_count && face_count < QH_MAX_FACES; hi++)
+    for (int32_t i = 1; i < count; i++)
+    {
+        for (int32_t a = 0; a < axis_count; a++)
         {
-            int32_t new_fi = face_count++;
-            QHFace *nf = &faces[new_fi];
-            nf->v[0] = horizon[hi].v1;
-            nf->v[1] = horizon[hi].v0;
-            nf->v[2] = new_vert;
-            nf->normal = qh_compute_normal(out->vertices[nf->v[0]],
-                                            out->vertices[nf->v[1]],
-                                            out->vertices[nf->v[2]]);
-            nf->dist = vec3_dot(nf->normal, out->vertices[nf->v[0]]);
-            nf->active = true;
-
-            Vec3 face_center = vec3_scale(vec3_add(vec3_add(out->vertices[nf->v[0]],
-                                                             out->vertices[nf->v[1]]),
-                                                    out->vertices[nf->v[2]]),
-                                           1.0f / 3.0f);
-            Vec3 to_center = vec3_sub(center, face_center);
-            if (vec3_dot(nf->normal, to_center) > 0.0f)
+            float v = vec3_dot(points[i], axes[a]);
+            if (v > hi[a])
             {
-                nf->normal = vec3_neg(nf->normal);
-                nf->dist = -nf->dist;
-                int32_t tmp = nf->v[1];
-                nf->v[1] = nf->v[2];
-                nf->v[2] = tmp;
+                hi[a] = v;
+                hi_idx[a] = i;
+            }
+            if (v < lo[a])
+            {
+                lo[a] = v;
+                lo_idx[a] = i;
             }
         }
     }
 
-    free(used);
+    int32_t n = 0;
+    for (int32_t k = 0; k < axis_count * 2; k++)
+    {
+        int32_t idx = (k & 1) ? lo_idx[k >> 1] : hi_idx[k >> 1];
+        bool seen = false;
+        for (int32_t j = 0; j < n && !seen; j++)
+            seen = out[j] == idx;
+        if (!seen)
+            out[n++] = idx;
+    }
+    return n;
+}
 
-    for (int32_t i = 0; i < out->vertex_count; i++)
+void convex_hull_build(const Vec3 *points, int32_t count, ConvexHull *out)
+{
+    if (count < 4)
     {
-        out->adj_count[i] = 0;
+        hull_copy_points(points, count, out);
+        return;
     }
 
-    for (int32_t fi = 0; fi < face_count; fi++)
+    QHull qh;
+    if (!qh_begin(&qh, points, count, qh_tolerance(points, count)))
     {
-        if (!faces[fi].active)
-            continue;
-        QHFace *f = &faces[fi];
-        for (int32_t e = 0; e < 3; e++)
+        hull_copy_points(points, count, out);
+        return;
+    }
+
+    /* Seed hull from the directional extremes, then cull everything inside it at once */
+    int32_t extremes[QH_CULL_DIRECTIONS];
+    int32_t extreme_count = qh_find_cull_extremes(points, count, extremes);
+    bool seeded = qh_init_simplex(&qh, extremes, extreme_count);
+    if (seeded)
+    {
+        qh_assign(&qh, extremes, extreme_count, NULL, 0);
+        qh_expand(&qh);
+        qh_compact_faces(&qh);
+        for (int32_t i = 0; i < qh.live_count; i++)
+            qh.owner[qh.live[i]] = -1;
+        qh.live_count = 0;
+    }
+    else
+    {
+        int32_t *all = (int32_t *)malloc((size_t)count * sizeof(int32_t));
+        if (all)
         {
-            int32_t v0 = f->v[e];
-            int32_t v1 = f->v[(e + 1) % 3];
+            for (int32_t i = 0; i < count; i++)
+                all[i] = i;
+            seeded = qh_init_simplex(&qh, all, count);
+            free(all);
+        }
+    }
 
-            bool found = false;
-            for (int32_t a = 0; a < out->adj_count[v0]; a++)
-            {
-                if (out->adjacency[v0][a] == v1)
-                {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found && out->adj_count[v0] < HULL_MAX_ADJACENCY)
-            {
-                out->adjacency[v0][out->adj_count[v0]++] = v1;
-            }
+    if (!seeded)
+    {
+        qh_end(&qh);
+        hull_copy_points(points, count, out);
+        return;
+    }
 
-            found = false;
-            for (int32_t a = 0; a < out->adj_count[v1]; a++)
-            {
-                if (out->adjacency[v1][a] == v0)
-                {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found && out->adj_count[v1] < HULL_MAX_ADJACENCY)
-            {
-                out->adjacency[v1][out->adj_count[v1]++] = v0;
-            }
+    qh_assign(&qh, NULL, count, NULL, 0);
+    qh_expand(&qh);
+    qh_output(&qh, out);
+    qh_end(&qh);
+}
+
+static uint32_t hull_point_hash(Vec3 p)
+{
+    uint32_t bits[3];
+    memcpy(bits, &p, sizeof(bits));
+    uint32_t h = bits[0] * 0x9E3779B1u;
+    h ^= bits[1] * 0x85EBCA77u;
+    h ^= bits[2] * 0xC2B2AE3Du;
+    return h ^ (h >> 15);
+}
+
+/* Whether every hull vertex is still in the point set, by exact position */
+static bool hull_vertices_survive(const ConvexHull *hull, const Vec3 *points, int32_t count, int32_t *table,
+                                  int32_t table_size)
+{
+    memset(table, 0xFF, (size_t)table_size * sizeof(int32_t));
+    uint32_t mask = (uint32_t)table_size - 1;
+    for (int32_t i = 0; i < count; i++)
+    {
+        uint32_t slot = hull_point_hash(points[i]) & mask;
+        while (table[slot] >= 0)
+            slot = (slot + 1) & mask;
+        table[slot] = i;
+    }
+
+    for (int32_t v = 0; v < hull->vertex_count; v++)
+    {
+        Vec3 p = hull->vertices[v];
+        uint32_t slot = hull_point_hash(p) & mask;
+        bool found = false;
+        while (table[slot] >= 0 && !found)
+        {
+            Vec3 q = points[table[slot]];
+            found = q.x == p.x && q.y == p.y && q.z == p.z;
+            slot = (slot + 1) & mask;
         }
+        if (!found)
+            return false;
     }
+    return true;
+}
+
+HullUpdate convex_hull_update(ConvexHull *hull, const Vec3 *points, int32_t count)
+{
+    float margin = hull->margin;
+    bool reuse = hull->face_count > 0 && count >= 4;
+
+    int32_t table_size = 16;
+    while (table_size < count * 2)
+        table_size <<= 1;
+    int32_t *scratch = reuse ? (int32_t *)malloc((size_t)table_size * sizeof(int32_t)) : NULL;
+
+    /* Removed vertices are found by hash before paying for the plane test */
+    reuse = scratch && hull_vertices_survive(hull, points, count, scratch, table_size);
+
+    /* Anything outside the old hull means voxels were added or the grid moved */
+    if (reuse)
+    {
+        float tolerance = qh_tolerance(hull->vertices, hull->vertex_count);
+        int32_t *outside = scratch; /* The table has 2 * count slots, enough for both outputs */
+        float *outside_dist = (float *)(scratch + count);
+        qh_classify(points, NULL, count, hull->faces, hull->face_count, tolerance, outside, outside_dist);
+        for (int32_t i = 0; i < count && reuse; i++)
+            reuse = outside[i] < 0;
+    }
+    free(scratch);
+
+    if (reuse)
+        return HULL_UPDATE_REUSED;
+
+    convex_hull_build(points, count, hull);
+    hull->margin = margin;
+    return HULL_UPDATE_REBUILT;
 }
 
 int32_t convex_hull_support(const ConvexHull *hull, Vec3 dir, int32_t hint)
@@ -406,13 +732,21 @@ int32_t convex_hull_support(const ConvexHull *hull, Vec3 dir, int32_t hint)
 }
 
 Vec3 convex_hull_support_point(const ConvexHull *hull, Vec3 dir, Vec3 position, Quat orientation)
+{
+    int32_t hint = 0;
+    return convex_hull_support_point_hint(hull, dir, position, orientation, &hint);
+}
+
+Vec3 convex_hull_support_point_hint(const ConvexHull *hull, Vec3 dir, Vec3 position, Quat orientation,
+                                    int32_t *hint)
 {
     Quat inv_orient = quat_conjugate(orientation);
     Vec3 local_dir = quat_rotate_vec3(inv_orient, dir);
 
-    int32_t idx = convex_hull_support(hull, local_dir, 0);
+    int32_t idx = convex_hull_support(hull, local_dir, *hint);
     if (idx < 0)
         return position;
+    *hint = idx;
 
     Vec3 local_point = hull->vertices[idx];
 
@@ -11,25 +11,62 @@ extern "C"
 {
 #endif
 
+/*
+ * Convex Hulls
+ *
+ * Built by quickhull over conflict lists: each outside point belongs to one
+ * face and is only re-tested against the faces that replace it. Before
+ * that, the extreme points along 26 directions form a seed hull and every
+ * point inside it is culled with a vectorized plane test, so a box's
+ * surface voxels reduce to its corners without entering the main loop.
+ *
+ * Destruction mostly removes interior voxels, which cannot change the hull.
+ * convex_hull_update reuses the hull when every vertex is still present and
+ * no point lies outside its planes; otherwise it rebuilds. Re-hulling the
+ * survivors and patching the removed corners cost more than a fresh build,
+ * since the culled build only runs quickhull on a handful of extremes.
+ */
+
 #define HULL_MAX_VERTICES 128
 #define HULL_MAX_FACES 256
 #define HULL_MAX_ADJACENCY 12
 
+    typedef struct
+    {
+        Vec3 normal; /* Outward, unit length */
+        float dist;  /* dot(normal, p) <= dist for points inside */
+    } HullFace;
+
     typedef struct
     {
         Vec3 vertices[HULL_MAX_VERTICES];
         int32_t vertex_count;
         int32_t adjacency[HULL_MAX_VERTICES][HULL_MAX_ADJACENCY];
         int32_t adj_count[HULL_MAX_VERTICES];
+        HullFace faces[HULL_MAX_FACES];
+        int32_t face_count;
         float margin;
     } ConvexHull;
 
+    typedef enum
+    {
+        HULL_UPDATE_REUSED, /* Removed points were interior; hull untouched */
+        HULL_UPDATE_REBUILT
+    } HullUpdate;
+
     void convex_hull_build(const Vec3 *points, int32_t count, ConvexHull *out);
 
+    /* Refits a hull built from an earlier version of the point set; keeps margin */
+    HullUpdate convex_hull_update(ConvexHull *hull, const Vec3 *points, int32_t count);
+
     int32_t convex_hull_support(const ConvexHull *hull, Vec3 dir, int32_t hint);
 
     Vec3 convex_hull_support_point(const ConvexHull *hull, Vec3 dir, Vec3 position, Quat orientation);
 
+    /* Hill-climbs from *hint and stores the support vertex back: coherent queries take a step or two */
+    Vec3 convex_hull_support_point_hint(const ConvexHull *hull, Vec3 dir, Vec3 position, Quat orientation,
+                                        int32_t *hint);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,214 @@
+#include "debris_lod.h"
+#include "content/materials.h"
+#include "engine/core/profile.h"
+#include <string.h>
+
+void debris_lod_init(DebrisLod *lod, ParticleSystem *particles, RngState *rng)
+{
+    memset(lod, 0, sizeof(*lod));
+    lod->max_voxels = DEBRIS_LOD_MAX_VOXELS;
+    lod->max_mass = 0.0f;
+    lod->pressure_voxels = DEBRIS_LOD_PRESSURE_VOXELS;
+    lod->pressure_start = DEBRIS_LOD_PRESSURE_START;
+    lod->max_bodies = VOBJ_MAX_OBJECTS - 8;
+    lod->particle_radius = 0.4f;
+    lod->particles = particles;
+    lod->rng = rng;
+    lod->threshold = lod->max_voxels;
+}
+
+/* How far the thresholds have risen towards the pressure ones, 0 to 1 */
+static float debris_pressure(const DebrisLod *lod, int32_t active_bodies)
+{
+    if (lod->max_bodies <= 0)
+        return 1.0f;
+
+    float load = (float)active_bodies / (float)lod->max_bodies;
+    if (load <= lod->pressure_start)
+        return 0.0f;
+    if (load >= 1.0f || lod->pressure_start >= 1.0f)
+        return 1.0f;
+    return (load - lod->pressure_start) / (1.0f - lod->pressure_start);
+}
+
+int32_t debris_lod_voxel_threshold(const DebrisLod *lod, int32_t active_bodies)
+{
+    int32_t base = lod->max_voxels;
+    int32_t top = lod->pressure_voxels > base ? lod->pressure_voxels : base;
+    return base + (int32_t)((float)(top - base) * debris_pressure(lod, active_bodies));
+}
+
+bool debris_lod_should_demote(const DebrisLod *lod, int32_t voxel_count, float mass, int32_t active_bodies)
+{
+    if (voxel_count <= 0 || voxel_count > DEBRIS_LOD_MAX_FRAGMENT_VOXELS)
+        return false;
+
+    int32_t threshold = debris_lod_voxel_threshold(lod, active_bodies);
+    if (voxel_count <= threshold)
+        return true;
+
+    /* The mass threshold rises in the same proportion as the voxel one */
+    if (lod->max_mass > 0.0f && lod->max_voxels > 0)
+        return mass <= lod->max_mass * (float)threshold / (float)lod->max_voxels;
+    return false;
+}
+
+static float voxel_density(uint8_t material)
+{
+    const MaterialDescriptor *desc = material_get(material);
+    return (desc && desc->density > 0.0f) ? desc->density : 1.0f;
+}
+
+static void debris_publish(const DebrisLod *lod)
+{
+    (void)lod;
+    PROFILE_COUNTER_SET(PROFILE_COUNTER_DEBRIS_DEMOTED, lod->fragments_demoted);
+    PROFILE_COUNTER_SET(PROFILE_COUNTER_DEBRIS_PARTICLES, lod->particles_spawned);
+    PROFILE_COUNTER_SET(PROFILE_COUNTER_DEBRIS_THRESHOLD, lod->threshold);
+}
+
+/* One particle per voxel, at its centre, tagged with its material */
+static void debris_emit(DebrisLod *lod, Vec3 position, Vec3 velocity, uint8_t material, float voxel_size)
+{
+    int32_t slot = particle_system_add(lod->particles, lod->rng, position, velocity,
+                                       material_get_color(material), voxel_size * lod->particle_radius);
+    lod->particles->material[slot] = material;
+    lod->particles_spawned++;
+}
+
+bool debris_lod_take_island(void *user, const DetachFragment *fragment)
+{
+    DebrisLod *lod = (DebrisLod *)user;
+    if (!lod || !lod->particles || !fragment)
+        return false;
+
+    lod->threshold = debris_lod_voxel_threshold(lod, fragment->active_bodies);
+    if (fragment->voxel_count > DEBRIS_LOD_MAX_FRAGMENT_VOXELS)
+        return false;
+
+    int32_t cells = fragment->size_x * fragment->size_y * fragment->size_z;
+    float mass = 0.0f;
+    if (fragment->voxel_count > lod->threshold && lod->max_mass > 0.0f)
+    {
+        for (int32_t i = 0; i < cells; i++)
+        {
+            if (fragment->voxels[i] != 0)
+                mass += voxel_density(fragment->voxels[i]);
+        }
+    }
+    if (!debris_lod_should_demote(lod, fragment->voxel_count, mass, fragment->active_bodies))
+        return false;
+
+    float vs = fragment->voxel_size;
+    int32_t i = 0;
+    for (int32_t z = 0; z < fragment->size_z; z++)
+    {
+        for (int32_t y = 0; y < fragment->size_y; y++)
+        {
+            for (int32_t x = 0; x < fragment->size_x; x++, i++)
+            {
+                uint8_t mat = fragment->voxels[i];
+                if (mat == 0)
+                    continue;
+
+                Vec3 position = vec3_create(fragment->origin.x + ((float)x + 0.5f) * vs,
+                                            fragment->origin.y + ((float)y + 0.5f) * vs,
+                                            fragment->origin.z + ((float)z + 0.5f) * vs);
+                debris_emit(lod, position, vec3_zero(), mat, vs);
+            }
+        }
+    }
+
+    lod->fragments_demoted++;
+    lod->voxels_demoted += fragment->voxel_count;
+    debris_publish(lod);
+    return true;
+}
+
+/* Replaces an object with its voxels as particles moving with the given body motion */
+static void debris_demote_object(DebrisLod *lod, VoxelObjectWorld *objects, PhysicsWorld *physics,
+                                 int32_t obj_index, Vec3 velocity, Vec3 angular_velocity)
+{
+    VoxelObject *obj = &objects->objects[obj_index];
+    float half_size = obj->voxel_size * (float)VOBJ_GRID_SIZE * 0.5f;
+    VoxelObjectPose pose = voxel_object_pose(objects, obj_index);
+    float rot_mat[9];
+    quat_to_mat3(pose.orientation, rot_mat);
+    Vec3 com = vec3_add(pose.position, mat3_transform_vec3(rot_mat, obj->local_com));
+
+    for (int32_t idx = 0; idx < VOBJ_TOTAL_VOXELS; idx++)
+    {
+        uint8_t mat = obj->voxels[idx].material;
+        if (mat == 0)
+            continue;
+
+        int32_t x, y, z;
+        vobj_coords(idx, &x, &y, &z);
+        Vec3 local_pos = vec3_create(((float)x + 0.5f) * obj->voxel_size - half_size,
+                                     ((float)y + 0.5f) * obj->voxel_size - half_size,
+                                     ((float)z + 0.5f) * obj->voxel_size - half_size);
+        Vec3 position = vec3_add(pose.position, mat3_transform_vec3(rot_mat, local_pos));
+        Vec3 spin = vec3_cross(angular_velocity, vec3_sub(position, com));
+        debris_emit(lod, position, vec3_add(velocity, spin), mat, obj->voxel_size);
+    }
+
+    lod->fragments_demoted++;
+    lod->voxels_demoted += obj->voxel_count;
+
+    int32_t body = physics_world_find_body_for_object(physics, obj_index);
+    if (body >= 0)
+        physics_world_remove_body(physics, body);
+    /* A dirty object is recycled by process_recalcs, which walks the dirty list */
+    if (obj->shape_dirty)
+        obj->active = false;
+    else
+        voxel_object_world_free_slot(objects, obj_index);
+}
+
+int32_t debris_lod_process_splits(DebrisLod *lod, VoxelObjectWorld *objects, PhysicsWorld *physics)
+{
+    if (!lod || !lod->particles || !objects || objects->split_touched_count == 0)
+        return 0;
+
+    int32_t active_bodies = 0;
+    for (int32_t i = 0; i < objects->object_count; i++)
+    {
+        if (objects->objects[i].active)
+            active_bodies++;
+    }
+    lod->threshold = debris_lod_voxel_threshold(lod, active_bodies);
+
+    /* Read every source body first: demoting a parent removes the body its fragments move with */
+    enum { TOUCHED_MAX = VOBJ_SPLIT_QUEUE_SIZE + VOBJ_MAX_SPLITS_PER_TICK };
+    Vec3 velocity[TOUCHED_MAX];
+    Vec3 angular_velocity[TOUCHED_MAX];
+    int32_t count = objects->split_touched_count;
+    for (int32_t i = 0; i < count; i++)
+    {
+        int32_t body = physics_world_find_body_for_object(physics, objects->split_source[i]);
+        velocity[i] = body >= 0 ? physics_body_velocity(physics, body) : vec3_zero();
+        angular_velocity[i] = body >= 0 ? physics_body_angular_velocity(physics, body) : vec3_zero();
+    }
+
+    int32_t demoted = 0;
+    for (int32_t i = 0; i < count; i++)
+    {
+        int32_t obj_index = objects->split_touched[i];
+        if (obj_index < 0 || obj_index >= objects->object_count)
+            continue;
+
+        VoxelObject *obj = &objects->objects[obj_index];
+        if (!obj->active || obj->voxel_count <= 0)
+            continue;
+        if (!debris_lod_should_demote(lod, obj->voxel_count, obj->total_mass, active_bodies))
+            continue;
+
+        debris_demote_object(lod, objects, physics, obj_index, velocity[i], angular_velocity[i]);
+        active_bodies--;
+        demoted++;
+    }
+
+    objects->split_touched_count = 0;
+    debris_publish(lod);
+    return demoted;
+}
@@ -0,0 +1,86 @@
+#ifndef PATCH_PHYSICS_DEBRIS_LOD_H
+#define PATCH_PHYSICS_DEBRIS_LOD_H
+
+#include "engine/core/types.h"
+#include "engine/core/math.h"
+#include "engine/core/rng.h"
+#include "engine/voxel/voxel_object.h"
+#include "engine/sim/detach.h"
+#include "particles.h"
+#include "rigidbody.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Debris Level of Detail
+ *
+ * Fragments too small to be worth a voxel object (grid, rigid body, hull,
+ * BVH leaf) become particles instead: one per voxel, coloured by its
+ * material and tagged with it, moving with the velocity the voxel had on
+ * the fragment's body (linear plus angular about the centre of mass).
+ *
+ * A fragment is demoted at or below a voxel threshold, or a mass
+ * threshold when one is set. Below pressure_start of max_bodies live
+ * objects the thresholds are the base ones; above it they rise linearly,
+ * reaching pressure_voxels at max_bodies, so a crowded world sheds more of
+ * its small objects.
+ *
+ * Terrain islands are offered through detach_terrain_process (pass
+ * debris_lod_take_island as the config's debris_fn), before any object is
+ * spawned. Object splits are checked after voxel_object_world_process_splits
+ * by debris_lod_process_splits. The caller owns the policy, the particle
+ * system and the rng; all three must outlive it.
+ */
+
+#define DEBRIS_LOD_MAX_VOXELS 8         /* Base threshold: fragments of up to 8 voxels */
+#define DEBRIS_LOD_PRESSURE_VOXELS 64   /* Threshold with max_bodies objects alive */
+#define DEBRIS_LOD_PRESSURE_START 0.5f  /* Share of max_bodies where the threshold starts rising */
+#define DEBRIS_LOD_MAX_FRAGMENT_VOXELS 256 /* Never demoted above this, whatever the mass */
+
+    typedef struct DebrisLod
+    {
+        int32_t max_voxels;    /* Base voxel threshold */
+        float max_mass;        /* Base mass threshold, 0 = by voxels only */
+        int32_t pressure_voxels;
+        float pressure_start;
+        int32_t max_bodies;    /* Object count the thresholds adapt to */
+        float particle_radius; /* Particle radius per unit voxel size */
+
+        ParticleSystem *particles;
+        RngState *rng;
+
+        /* Totals since init (also published as profiler counters) */
+        int32_t fragments_demoted;
+        int32_t voxels_demoted;
+        int32_t particles_spawned;
+        int32_t threshold; /* Voxel threshold at the last check */
+    } DebrisLod;
+
+    void debris_lod_init(DebrisLod *lod, ParticleSystem *particles, RngState *rng);
+
+    /* Voxel threshold with active_bodies objects alive */
+    int32_t debris_lod_voxel_threshold(const DebrisLod *lod, int32_t active_bodies);
+
+    bool debris_lod_should_demote(const DebrisLod *lod, int32_t voxel_count, float mass, int32_t active_bodies);
+
+    /* DetachDebrisFn for a DebrisLod: demotes a small terrain island, which starts at rest */
+    bool debris_lod_take_island(void *lod, const DetachFragment *fragment);
+
+    /*
+     * Demotes small objects among those the last process_splits call touched.
+     * Particles take their velocity from the body of the object each split
+     * from; a NULL physics world means they start at rest. Returns the
+     * objects demoted.
+     */
+    int32_t debris_lod_process_splits(DebrisLod *lod, VoxelObjectWorld *objects, PhysicsWorld *physics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -13,6 +13,21 @@ static GJKVertex gjk_support(
     return v;
 }
 
+GJKVertex gjk_support_cached(
+    const ConvexHull *hull_a, Vec3 pos_a, Quat rot_a,
+    const ConvexHull *hull_b, Vec3 pos_b, Quat rot_b,
+    Vec3 dir, GJKCache *cache)
+{
+    if (!cache)
+        return gjk_support(hull_a, pos_a, rot_a, hull_b, pos_b, rot_b, dir);
+
+    GJKVertex v;
+    v.point_a = convex_hull_support_point_hint(hull_a, dir, pos_a, rot_a, &cache->hint_a);
+    v.point_b = convex_hull_support_point_hint(hull_b, vec3_neg(dir), pos_b, rot_b, &cache->hint_b);
+    v.minkowski = vec3_sub(v.point_a, v.point_b);
+    return v;
+}
+
 static Vec3 triple_product(Vec3 a, Vec3 b, Vec3 c)
 {
     return vec3_sub(vec3_scale(b, vec3_dot(a, c)), vec3_scale(a, vec3_dot(b, c)));
@@ -156,38 +171,69 @@ bool gjk_intersect(
     const ConvexHull *hull_a, Vec3 pos_a, Quat rot_a,
     const ConvexHull *hull_b, Vec3 pos_b, Quat rot_b,
     GJKSimplex *out_simplex)
+{
+    return gjk_intersect_cached(hull_a, pos_a, rot_a, hull_b, pos_b, rot_b, NULL, out_simplex);
+}
+
+bool gjk_intersect_cached(
+    const ConvexHull *hull_a, Vec3 pos_a, Quat rot_a,
+    const ConvexHull *hull_b, Vec3 pos_b, Quat rot_b,
+    GJKCache *cache, GJKSimplex *out_simplex)
 {
     if (hull_a->vertex_count == 0 || hull_b->vertex_count == 0)
         return false;
 
-    Vec3 dir = vec3_sub(pos_b, pos_a);
-    dir = vec3_add(dir, vec3_create(0.00091f, 0.00037f, 0.00071f));
-    if (vec3_length_sq(dir) < GJK_EPSILON * GJK_EPSILON)
-        dir = vec3_create(1.0f, 0.0f, 0.0f);
+    Vec3 dir;
+    bool warm = cache && vec3_length_sq(cache->axis) > GJK_EPSILON * GJK_EPSILON;
+    if (warm)
+    {
+        dir = cache->axis;
+    }
+    else
+    {
+        dir = vec3_sub(pos_b, pos_a);
+        dir = vec3_add(dir, vec3_create(0.00091f, 0.00037f, 0.00071f));
+        if (vec3_length_sq(dir) < GJK_EPSILON * GJK_EPSILON)
+            dir = vec3_create(1.0f, 0.0f, 0.0f);
+    }
+    if (cache)
+        cache->iterations = 0;
 
     GJKSimplex simplex;
     simplex.count = 0;
 
-    GJKVertex support = gjk_support(hull_a, pos_a, rot_a, hull_b, pos_b, rot_b, dir);
+    GJKVertex support = gjk_support_cached(hull_a, pos_a, rot_a, hull_b, pos_b, rot_b, dir, cache);
+
+    /* Nothing of A - B reaches past the origin along the old axis: still apart */
+    if (warm && vec3_dot(support.minkowski, dir) < 0.0f)
+        return false;
+
     simplex.vertices[simplex.count++] = support;
 
     dir = vec3_neg(support.minkowski);
 
     for (int32_t iter = 0; iter < GJK_MAX_ITERATIONS; iter++)
     {
+        if (cache)
+            cache->iterations = iter + 1;
+
         float dir_len = vec3_length(dir);
         if (dir_len < GJK_EPSILON)
         {
+            if (cache)
+                cache->axis = vec3_zero();
             if (out_simplex)
                 *out_simplex = simplex;
             return true;
         }
         dir = vec3_scale(dir, 1.0f / dir_len);
 
-        support = gjk_support(hull_a, pos_a, rot_a, hull_b, pos_b, rot_b, dir);
+        support = gjk_support_cached(hull_a, pos_a, rot_a, hull_b, pos_b, rot_b, dir, cache);
 
         if (vec3_dot(support.minkowski, dir) < GJK_EPSILON)
         {
+            if (cache)
+                cache->axis = dir;
             return false;
         }
 
@@ -195,6 +241,8 @@ bool gjk_intersect(
 
         if (gjk_do_simplex(&simplex, &dir))
         {
+            if (cache)
+                cache->axis = vec3_zero();
             if (out_simplex)
                 *out_simplex = simplex;
             return true;
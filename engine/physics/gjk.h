@@ -39,11 +39,36 @@ extern "C"
         Vec3 contact_b;
     } EPAResult;
 
+    /* Warm-start state for one hull pair, carried between calls */
+    typedef struct
+    {
+        Vec3 axis;      /* Last separating direction in A - B space; zero = none */
+        int32_t hint_a; /* Support vertex hints */
+        int32_t hint_b;
+        int32_t iterations; /* Last call; 0 = rejected by the cached axis */
+    } GJKCache;
+
     bool gjk_intersect(
         const ConvexHull *hull_a, Vec3 pos_a, Quat rot_a,
         const ConvexHull *hull_b, Vec3 pos_b, Quat rot_b,
         GJKSimplex *out_simplex);
 
+    /*
+     * gjk_intersect with temporal coherence: the cached axis is tried first
+     * and ends the test when it still separates, supports climb from the
+     * cached vertices, and a separating result leaves its axis in the cache.
+     */
+    bool gjk_intersect_cached(
+        const ConvexHull *hull_a, Vec3 pos_a, Quat rot_a,
+        const ConvexHull *hull_b, Vec3 pos_b, Quat rot_b,
+        GJKCache *cache, GJKSimplex *out_simplex);
+
+    /* Support of A - B along dir, climbing from the cache's hints */
+    GJKVertex gjk_support_cached(
+        const ConvexHull *hull_a, Vec3 pos_a, Quat rot_a,
+        const ConvexHull *hull_b, Vec3 pos_b, Quat rot_b,
+        Vec3 dir, GJKCache *cache);
+
     bool epa_penetration(
         const ConvexHull *hull_a, Vec3 pos_a, Quat rot_a,
         const ConvexHull *hull_b, Vec3 pos_b, Quat rot_b,
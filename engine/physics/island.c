@@ -0,0 +1,312 @@
+#include "island.h"
+#include <threads.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int32_t island_find(int32_t *parent, int32_t i)
+{
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/* Lower index wins so each root is its island's lowest body */
+static void island_union(int32_t *parent, int32_t a, int32_t b)
+{
+    int32_t ra = island_find(parent, a);
+    int32_t rb = island_find(parent, b);
+    if (ra == rb)
+        return;
+    if (ra < rb)
+        parent[rb] = ra;
+    else
+        parent[ra] = rb;
+}
+
+/* Island of a pair's awake side; -1 = invalid or both asleep */
+static int32_t pair_island(const PhysicsIslands *islands, const ObjectCollisionPair *pair)
+{
+    if (!pair->valid)
+        return -1;
+    int32_t k = islands->body_island[pair->body_a];
+    return k >= 0 ? k : islands->body_island[pair->body_b];
+}
+
+void physics_islands_build(PhysicsIslands *islands, const PhysicsWorld *world,
+                           const ObjectCollisionPair *pairs, int32_t pair_count)
+{
+    int32_t limit = world->max_body_index + 1;
+
+    islands->count = 0;
+    islands->largest = 0;
+
+    for (int32_t i = 0; i < limit; i++)
+    {
+        uint8_t flags = world->flags[i];
+        bool awake = (flags & PHYS_FLAG_ACTIVE) && !(flags & PHYS_FLAG_SLEEPING);
+        islands->parent[i] = awake ? i : -1;
+    }
+
+    /* Sleeping partners stay out: the solve holds them as static, so islands may share them */
+    for (int32_t p = 0; p < pair_count; p++)
+    {
+        if (!pairs[p].valid)
+            continue;
+        int32_t a = pairs[p].body_a;
+        int32_t b = pairs[p].body_b;
+        if (islands->parent[a] >= 0 && islands->parent[b] >= 0)
+            island_union(islands->parent, a, b);
+    }
+
+    /* Roots are lowest members, so one ascending pass numbers islands by first body */
+    int32_t body_counts[PHYS_MAX_BODIES];
+    for (int32_t i = 0; i < limit; i++)
+    {
+        islands->body_island[i] = -1;
+        if (islands->parent[i] < 0)
+            continue;
+
+        int32_t root = island_find(islands->parent, i);
+        if (root == i)
+        {
+            body_counts[islands->count] = 0;
+            islands->body_island[i] = islands->count++;
+        }
+        else
+        {
+            islands->body_island[i] = islands->body_island[root];
+        }
+        body_counts[islands->body_island[i]]++;
+    }
+
+    islands->body_start[0] = 0;
+    for (int32_t k = 0; k < islands->count; k++)
+    {
+        islands->body_start[k + 1] = islands->body_start[k] + body_counts[k];
+        if (body_counts[k] > islands->largest)
+            islands->largest = body_counts[k];
+    }
+
+    /* Counting sort keeps ascending body order within each island */
+    int32_t cursor[PHYS_MAX_BODIES];
+    memcpy(cursor, islands->body_start, sizeof(int32_t) * (size_t)islands->count);
+    for (int32_t i = 0; i < limit; i++)
+    {
+        int32_t k = islands->body_island[i];
+        if (k >= 0)
+            islands->bodies[cursor[k]++] = i;
+    }
+
+    /* Pairs keep detection order within each island */
+    int32_t pair_counts[PHYS_MAX_BODIES];
+    memset(pair_counts, 0, sizeof(int32_t) * (size_t)islands->count);
+    for (int32_t p = 0; p < pair_count; p++)
+    {
+        int32_t k = pair_island(islands, &pairs[p]);
+        if (k >= 0)
+            pair_counts[k]++;
+    }
+
+    islands->pair_start[0] = 0;
+    for (int32_t k = 0; k < islands->count; k++)
+        islands->pair_start[k + 1] = islands->pair_start[k] + pair_counts[k];
+
+    memcpy(cursor, islands->pair_start, sizeof(int32_t) * (size_t)islands->count);
+    for (int32_t p = 0; p < pair_count; p++)
+    {
+        int32_t k = pair_island(islands, &pairs[p]);
+        if (k >= 0)
+            islands->pairs[cursor[k]++] = p;
+    }
+}
+
+struct PhysicsWorkers
+{
+    thrd_t threads[PHYS_MAX_WORKERS];
+    int32_t thread_count;
+
+    /* Guards everything below */
+    mtx_t lock;
+    cnd_t work_cv;
+    cnd_t done_cv;
+    uint32_t generation;
+    bool shutdown;
+
+    PhysicsTaskFn fn; /* NULL = no job */
+    void *ctx;
+    int32_t task_count;
+    int32_t next_task;
+    int32_t batch; /* Tasks per claim: a few claims per thread balances load */
+    int32_t finished;
+};
+
+/* Claims and runs batches of tasks of the current job until none are left */
+static void workers_drain(PhysicsWorkers *workers)
+{
+    for (;;)
+    {
+        mtx_lock(&workers->lock);
+        PhysicsTaskFn fn = workers->fn;
+        int32_t begin = workers->next_task;
+        int32_t task_count = workers->task_count;
+        if (!fn || begin >= task_count)
+        {
+            mtx_unlock(&workers->lock);
+            return;
+        }
+        int32_t end = begin + workers->batch;
+        if (end > task_count)
+            end = task_count;
+        workers->next_task = end;
+        void *ctx = workers->ctx;
+        mtx_unlock(&workers->lock);
+
+        for (int32_t task = begin; task < end; task++)
+            fn(task, ctx);
+
+        mtx_lock(&workers->lock);
+        workers->finished += end - begin;
+        if (workers->finished == task_count)
+            cnd_signal(&workers->done_cv);
+        mtx_unlock(&workers->lock);
+    }
+}
+static int worker_main(void *arg)
+{
+    PhysicsWorkers *workers = (PhysicsWorkers *)arg;
+    uint32_t seen = 0;
+
+    for (;;)
+    {
+        mtx_lock(&workers->lock);
+        while (!workers->shutdown && workers->generation == seen)
+            cnd_wait(&workers->work_cv, &workers->lock);
+        if (workers->shutdown)
+        {
+            mtx_unlock(&workers->lock);
+            return 0;
+        }
+        seen = workers->generation;
+        mtx_unlock(&workers->lock);
+
+        workers_drain(workers);
+    }
+}
+
+PhysicsWorkers *physics_workers_create(int32_t worker_count)
+{
+    if (worker_count < 0)
+        worker_count = 0;
+    if (worker_count > PHYS_MAX_WORKERS)
+        worker_count = PHYS_MAX_WORKERS;
+
+    PhysicsWorkers *workers = (PhysicsWorkers *)calloc(1, sizeof(PhysicsWorkers));
+    if (!workers)
+        return NULL;
+
+    if (mtx_init(&workers->lock, mtx_plain) != thrd_success)
+    {
+        free(workers);
+        return NULL;
+    }
+    if (cnd_init(&workers->work_cv) != thrd_success)
+    {
+        mtx_destroy(&workers->lock);
+        free(workers);
+        return NULL;
+    }
+    if (cnd_init(&workers->done_cv) != thrd_success)
+    {
+        cnd_destroy(&workers->work_cv);
+        mtx_destroy(&workers->lock);
+        free(workers);
+        return NULL;
+    }
+
+    /* Fewer threads than asked is fine: the caller always helps */
+    for (int32_t i = 0; i < worker_count; i++)
+    {
+        if (thrd_create(&workers->threads[i], worker_main, workers) != thrd_success)
+            break;
+        workers->thread_count++;
+    }
+    return workers;
+}
+
+void physics_workers_destroy(PhysicsWorkers *workers)
+{
+    if (!workers)
+        return;
+
+    mtx_lock(&workers->lock);
+    workers->shutdown = true;
+    cnd_broadcast(&workers->work_cv);
+    mtx_unlock(&workers->lock);
+
+    for (int32_t i = 0; i < workers->thread_count; i++)
+        thrd_join(workers->threads[i], NULL);
+
+    cnd_destroy(&workers->done_cv);
+    cnd_destroy(&workers->work_cv);
+    mtx_destroy(&workers->lock);
+    free(workers);
+}
+
+int32_t physics_workers_count(const PhysicsWorkers *workers)
+{
+    return workers ? workers->thread_count : 0;
+}
+
+void physics_workers_run(PhysicsWorkers *workers, int32_t task_count, PhysicsTaskFn fn, void *ctx)
+{
+    if (!workers || workers->thread_count == 0 || task_count < 2)
+    {
+        for (int32_t task = 0; task < task_count; task++)
+            fn(task, ctx);
+        return;
+    }
+
+    mtx_lock(&workers->lock);
+    workers->fn = fn;
+    workers->ctx = ctx;
+    workers->task_count = task_count;
+    workers->next_task = 0;
+    workers->batch = task_count / ((workers->thread_count + 1) * 4);
+    if (workers->batch < 1)
+        workers->batch = 1;
+    workers->finished = 0;
+    workers->generation++;
+    cnd_broadcast(&workers->work_cv);
+    mtx_unlock(&workers->lock);
+
+    workers_drain(workers);
+
+    mtx_lock(&workers->lock);
+    while (workers->finished < task_count)
+        cnd_wait(&workers->done_cv, &workers->lock);
+    workers->fn = NULL;
+    mtx_unlock(&workers->lock);
+}
+
+typedef struct
+{
+    PhysicsWorld *world;
+    PhysicsIslandFn fn;
+    void *ctx;
+} IslandJob;
+
+static void run_island(int32_t island, void *ctx)
+{
+    IslandJob *job = (IslandJob *)ctx;
+    job->fn(job->world, island, job->ctx);
+}
+
+void physics_islands_run(PhysicsWorkers *workers, PhysicsWorld *world, const PhysicsIslands *islands,
+                         PhysicsIslandFn fn, void *ctx)
+{
+    IslandJob job = {world, fn, ctx};
+    physics_workers_run(workers, islands->count, run_island, &job);
+}
@@ -0,0 +1,83 @@
+#ifndef PATCH_PHYSICS_ISLAND_H
+#define PATCH_PHYSICS_ISLAND_H
+
+#include "rigidbody.h"
+#include "collision_object.h"
+#include "manifold.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Contact Islands
+ *
+ * Each step, awake bodies and the object pairs between them are grouped
+ * with union-find: bodies that touch (directly or through a chain) share an
+ * island, everything else is its own island. Terrain is static and never
+ * links islands. Islands share no bodies, so they can be solved on worker
+ * threads in any order with results identical to a serial solve:
+ * - pairs of an island are resolved in detection order
+ * - terrain contacts follow, in ascending body index
+ * Static and kinematic bodies are unioned like any other so no body is
+ * written by two islands. Sleeping bodies are not: the solve holds them as
+ * static and only flags contacts whose impulse should wake them, so a pile
+ * stays asleep under a light touch and several islands can rest on it.
+ * Sleep is decided per island after the step.
+ */
+
+#define PHYS_MAX_WORKERS 8
+#define PHYS_DEFAULT_WORKERS 2
+#define PHYS_PARALLEL_MIN_BODIES 16 /* Smaller steps are solved inline */
+#define PHYS_ISLAND_MAX_PAIRS (PHYS_OBJ_COLLISION_BUDGET + PHYS_MAX_MANIFOLDS) /* Detected + live manifolds */
+
+    typedef struct PhysicsIslands
+    {
+        int32_t parent[PHYS_MAX_BODIES];
+        int32_t body_island[PHYS_MAX_BODIES]; /* -1 = not simulated this step */
+
+        int32_t count;
+        int32_t body_start[PHYS_MAX_BODIES + 1]; /* bodies[body_start[i] .. body_start[i + 1]) */
+        int32_t bodies[PHYS_MAX_BODIES];
+        int32_t pair_start[PHYS_MAX_BODIES + 1]; /* pairs[pair_start[i] .. pair_start[i + 1]) */
+        int32_t pairs[PHYS_ISLAND_MAX_PAIRS];
+        int32_t largest;
+    } PhysicsIslands;
+
+    typedef void (*PhysicsIslandFn)(PhysicsWorld *world, int32_t island, void *ctx);
+    typedef void (*PhysicsTaskFn)(int32_t task, void *ctx);
+
+    typedef struct PhysicsWorkers PhysicsWorkers;
+
+    /*
+     * Builds islands over awake bodies; a pair with a sleeping side goes to
+     * its awake side's island. Island ids follow each island's lowest body
+     * index, so the layout is independent of pair order across islands.
+     */
+    void physics_islands_build(PhysicsIslands *islands, const PhysicsWorld *world,
+                               const ObjectCollisionPair *pairs, int32_t pair_count);
+
+    /* 0 workers = every island on the calling thread */
+    PhysicsWorkers *physics_workers_create(int32_t worker_count);
+    void physics_workers_destroy(PhysicsWorkers *workers);
+    int32_t physics_workers_count(const PhysicsWorkers *workers);
+
+    /*
+     * Runs fn for tasks [0, task_count) (calling thread participates);
+     * returns when all are done. Tasks run in any order and on any thread,
+     * so they must write disjoint data.
+     */
+    void physics_workers_run(PhysicsWorkers *workers, int32_t task_count, PhysicsTaskFn fn, void *ctx);
+
+    /* Runs fn for every island (calling thread participates); returns when all are done */
+    void physics_islands_run(PhysicsWorkers *workers, PhysicsWorld *world, const PhysicsIslands *islands,
+                             PhysicsIslandFn fn, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
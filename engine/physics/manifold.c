@@ -0,0 +1,495 @@
+#include "manifold.h"
+#include <string.h>
+
+static uint32_t manifold_hash(int32_t body_a, int32_t body_b)
+{
+    uint32_t key = (uint32_t)body_a * PHYS_MAX_BODIES + (uint32_t)body_b;
+    return (key * 2654435761u) & (PHYS_MANIFOLD_TABLE_SIZE - 1);
+}
+
+static void manifold_table_insert(PhysicsManifolds *cache, int32_t index)
+{
+    const ContactManifold *m = &cache->manifolds[index];
+    uint32_t slot = manifold_hash(m->body_a, m->body_b);
+    while (cache->table[slot] >= 0)
+        slot = (slot + 1) & (PHYS_MANIFOLD_TABLE_SIZE - 1);
+    cache->table[slot] = (int16_t)index;
+}
+
+static int32_t manifold_table_find(const PhysicsManifolds *cache, int32_t body_a, int32_t body_b)
+{
+    uint32_t slot = manifold_hash(body_a, body_b);
+    while (cache->table[slot] >= 0)
+    {
+        const ContactManifold *m = &cache->manifolds[cache->table[slot]];
+        if (m->body_a == body_a && m->body_b == body_b)
+            return cache->table[slot];
+        slot = (slot + 1) & (PHYS_MANIFOLD_TABLE_SIZE - 1);
+    }
+    return -1;
+}
+
+void physics_manifolds_init(PhysicsManifolds *cache)
+{
+    cache->count = 0;
+    cache->stamp = 0;
+    cache->active_count = 0;
+    cache->warm_started = 0;
+    memset(cache->table, 0xFF, sizeof(cache->table));
+}
+
+ContactManifold *physics_manifolds_find(PhysicsManifolds *cache, int32_t body_a, int32_t body_b)
+{
+    if (!cache)
+        return NULL;
+    if (body_a > body_b)
+    {
+        int32_t t = body_a;
+        body_a = body_b;
+        body_b = t;
+    }
+    int32_t index = manifold_table_find(cache, body_a, body_b);
+    return index >= 0 ? &cache->manifolds[index] : NULL;
+}
+
+static void manifold_tangents(ContactManifold *m)
+{
+    Vec3 n = m->normal;
+    Vec3 axis = fabsf(n.x) < 0.57735f ? vec3_create(1.0f, 0.0f, 0.0f) : vec3_create(0.0f, 1.0f, 0.0f);
+    m->tangent[0] = vec3_normalize(vec3_cross(n, axis));
+    m->tangent[1] = vec3_cross(n, m->tangent[0]);
+}
+
+static uint32_t voxel_feature(Vec3 local, float voxel_size)
+{
+    float inv = 1.0f / voxel_size;
+    uint32_t x = (uint32_t)(int32_t)floorf(local.x * inv) & 0x3FFu;
+    uint32_t y = (uint32_t)(int32_t)floorf(local.y * inv) & 0x3FFu;
+    uint32_t z = (uint32_t)(int32_t)floorf(local.z * inv) & 0x3FFu;
+    return x | (y << 10) | (z << 20);
+}
+
+/* Largest quad spanned by four contacts, by their diagonals */
+static float quad_area(Vec3 p0, Vec3 p1, Vec3 p2, Vec3 p3)
+{
+    float a = vec3_length_sq(vec3_cross(vec3_sub(p0, p1), vec3_sub(p2, p3)));
+    float b = vec3_length_sq(vec3_cross(vec3_sub(p0, p2), vec3_sub(p1, p3)));
+    float c = vec3_length_sq(vec3_cross(vec3_sub(p0, p3), vec3_sub(p1, p2)));
+    return maxf(a, maxf(b, c));
+}
+
+/* Which full-manifold point the new contact replaces: never the deepest, else the one keeping most area */
+static int32_t manifold_replace_index(const ContactManifold *m, const ManifoldPoint *incoming)
+{
+    int32_t deepest = -1;
+    float max_depth = incoming->penetration;
+    for (int32_t i = 0; i < PHYS_MANIFOLD_POINTS; i++)
+    {
+        if (m->points[i].penetration > max_depth)
+        {
+            max_depth = m->points[i].penetration;
+            deepest = i;
+        }
+    }
+
+    int32_t best = 0;
+    float best_area = -1.0f;
+    for (int32_t i = 0; i < PHYS_MANIFOLD_POINTS; i++)
+    {
+        if (i == deepest)
+            continue;
+
+        Vec3 p[PHYS_MANIFOLD_POINTS];
+        for (int32_t k = 0; k < PHYS_MANIFOLD_POINTS; k++)
+            p[k] = (k == i) ? incoming->local_a : m->points[k].local_a;
+
+        float area = quad_area(p[0], p[1], p[2], p[3]);
+        if (area > best_area)
+        {
+            best_area = area;
+            best = i;
+        }
+    }
+    return best;
+}
+
+static float manifold_break_distance(const VoxelObject *obj_a, const VoxelObject *obj_b)
+{
+    return PHYS_MANIFOLD_BREAK_RATIO * minf(obj_a->voxel_size, obj_b->voxel_size);
+}
+
+/* Re-derives world points and depths from the stored local anchors; drops broken ones */
+static void manifold_refresh(ContactManifold *m, const VoxelObject *obj_a, VoxelObjectPose pose_a,
+                             const VoxelObject *obj_b, VoxelObjectPose pose_b)
+{
+    float break_dist = manifold_break_distance(obj_a, obj_b);
+    float break_sq = break_dist * break_dist;
+    int32_t kept = 0;
+    for (int32_t i = 0; i < m->point_count; i++)
+    {
+        ManifoldPoint *p = &m->points[i];
+        Vec3 pa = vec3_add(pose_a.position, quat_rotate_vec3(pose_a.orientation, p->local_a));
+        Vec3 pb = vec3_add(pose_b.position, quat_rotate_vec3(pose_b.orientation, p->local_b));
+        Vec3 d = vec3_sub(pa, pb);
+        float depth = vec3_dot(d, m->normal);
+        Vec3 drift = vec3_sub(d, vec3_scale(m->normal, depth));
+        if (depth < -break_dist || vec3_length_sq(drift) > break_sq)
+            continue;
+
+        p->point = vec3_scale(vec3_add(pa, pb), 0.5f);
+        p->penetration = depth;
+        if (kept != i)
+            m->points[kept] = *p;
+        kept++;
+    }
+    m->point_count = kept;
+}
+
+void physics_manifolds_begin(PhysicsManifolds *cache, const PhysicsWorld *world)
+{
+    cache->stamp++;
+    cache->active_count = 0;
+    cache->warm_started = 0;
+
+    /* Compaction keeps order so solve order stays independent of history */
+    int32_t kept = 0;
+    for (int32_t i = 0; i < cache->count; i++)
+    {
+        ContactManifold *m = &cache->manifolds[i];
+        const RigidBody *body_a = &world->bodies[m->body_a];
+        const RigidBody *body_b = &world->bodies[m->body_b];
+        uint8_t flags_a = world->flags[m->body_a];
+        uint8_t flags_b = world->flags[m->body_b];
+        if (!(flags_a & PHYS_FLAG_ACTIVE) || !(flags_b & PHYS_FLAG_ACTIVE))
+            continue;
+
+        /* Resting pairs have not moved; keep their impulses for the wake */
+        if (!((flags_a & (PHYS_FLAG_SLEEPING | PHYS_FLAG_STATIC)) &&
+              (flags_b & (PHYS_FLAG_SLEEPING | PHYS_FLAG_STATIC))))
+        {
+            manifold_refresh(m, &world->objects->objects[body_a->vobj_index],
+                             voxel_object_pose(world->objects, body_a->vobj_index),
+                             &world->objects->objects[body_b->vobj_index],
+                             voxel_object_pose(world->objects, body_b->vobj_index));
+        }
+        if (m->point_count == 0)
+            continue;
+
+        if (kept != i)
+            cache->manifolds[kept] = *m;
+        kept++;
+    }
+    cache->count = kept;
+
+    memset(cache->table, 0xFF, sizeof(cache->table));
+    for (int32_t i = 0; i < cache->count; i++)
+        manifold_table_insert(cache, i);
+}
+
+int32_t physics_manifolds_add(PhysicsManifolds *cache, PhysicsWorld *world, const ObjectCollisionPair *pair)
+{
+    if (!cache || !world || !pair || !pair->valid)
+        return -1;
+
+    int32_t body_a = pair->body_a;
+    int32_t body_b = pair->body_b;
+    Vec3 normal = pair->contact_normal;
+    if (body_a > body_b)
+    {
+        body_a = pair->body_b;
+        body_b = pair->body_a;
+        normal = vec3_neg(normal);
+    }
+
+    int32_t index = manifold_table_find(cache, body_a, body_b);
+    if (index < 0)
+    {
+        if (cache->count >= PHYS_MAX_MANIFOLDS)
+            return -1;
+        index = cache->count++;
+        ContactManifold *m = &cache->manifolds[index];
+        m->body_a = body_a;
+        m->body_b = body_b;
+        m->normal = normal;
+        m->point_count = 0;
+        m->stamp = cache->stamp - 1;
+        m->wake = false;
+        manifold_table_insert(cache, index);
+    }
+
+    ContactManifold *m = &cache->manifolds[index];
+    int32_t vobj_a = world->bodies[body_a].vobj_index;
+    int32_t vobj_b = world->bodies[body_b].vobj_index;
+    const VoxelObject *obj_a = &world->objects->objects[vobj_a];
+    const VoxelObject *obj_b = &world->objects->objects[vobj_b];
+    VoxelObjectPose pose_a = voxel_object_pose(world->objects, vobj_a);
+    VoxelObjectPose pose_b = voxel_object_pose(world->objects, vobj_b);
+    float break_dist = manifold_break_distance(obj_a, obj_b);
+
+    if (m->stamp != cache->stamp)
+    {
+        /* First report this step: the normal follows narrowphase */
+        if (vec3_dot(m->normal, normal) < PHYS_MANIFOLD_NORMAL_COS)
+            m->point_count = 0;
+        m->normal = normal;
+        manifold_tangents(m);
+        m->stamp = cache->stamp;
+        cache->active_count++;
+    }
+
+    ManifoldPoint incoming;
+    memset(&incoming, 0, sizeof(incoming));
+    Vec3 half = vec3_scale(normal, pair->penetration * 0.5f);
+    Vec3 pa = vec3_add(pair->contact_point, half);
+    Vec3 pb = vec3_sub(pair->contact_point, half);
+    incoming.local_a = quat_rotate_vec3(quat_conjugate(pose_a.orientation), vec3_sub(pa, pose_a.position));
+    incoming.local_b = quat_rotate_vec3(quat_conjugate(pose_b.orientation), vec3_sub(pb, pose_b.position));
+    incoming.point = pair->contact_point;
+    incoming.penetration = pair->penetration;
+    incoming.feature = voxel_feature(incoming.local_a, obj_a->voxel_size) ^
+                       (voxel_feature(incoming.local_b, obj_b->voxel_size) * 2654435761u);
+
+    float break_sq = break_dist * break_dist;
+    for (int32_t i = 0; i < m->point_count; i++)
+    {
+        ManifoldPoint *p = &m->points[i];
+        if (p->feature == incoming.feature || vec3_length_sq(vec3_sub(p->local_a, incoming.local_a)) < break_sq)
+        {
+            incoming.normal_impulse = p->normal_impulse;
+            incoming.tangent_impulse[0] = p->tangent_impulse[0];
+            incoming.tangent_impulse[1] = p->tangent_impulse[1];
+            *p = incoming;
+            cache->warm_started++;
+            return index;
+        }
+    }
+
+    if (m->point_count < PHYS_MANIFOLD_POINTS)
+        m->points[m->point_count++] = incoming;
+    else
+        m->points[manifold_replace_index(m, &incoming)] = incoming;
+    return index;
+}
+
+static void solver_body_init(ManifoldSolverBody *sb, PhysicsWorld *world, int32_t body_index)
+{
+    const RigidBody *body = &world->bodies[body_index];
+    const VoxelObject *obj = &world->objects->objects[body->vobj_index];
+    VoxelObjectPose pose = voxel_object_pose(world->objects, body->vobj_index);
+    uint8_t flags = world->flags[body_index];
+    sb->world = world;
+    sb->index = body_index;
+    sb->body = body;
+    sb->held = (flags & PHYS_FLAG_SLEEPING) != 0;
+    sb->inv_mass = ((flags & PHYS_FLAG_STATIC) || sb->held) ? 0.0f : world->inv_mass[body_index];
+    sb->inv_inertia = physics_body_inv_inertia(world, body_index);
+    quat_to_mat3(pose.orientation, sb->rot);
+    sb->com = vec3_add(pose.position, quat_rotate_vec3(pose.orientation, obj->local_com));
+}
+
+/* World-space inverse inertia times v, same frame convention as physics_body_apply_impulse */
+static Vec3 solver_inv_inertia(const ManifoldSolverBody *sb, Vec3 v)
+{
+    const float *m = sb->rot;
+    Vec3 local = vec3_create(m[0] * v.x + m[1] * v.y + m[2] * v.z,
+                             m[3] * v.x + m[4] * v.y + m[5] * v.z,
+                             m[6] * v.x + m[7] * v.y + m[8] * v.z);
+    Vec3 s = vec3_mul(local, sb->inv_inertia);
+    return vec3_create(m[0] * s.x + m[3] * s.y + m[6] * s.z,
+                       m[1] * s.x + m[4] * s.y + m[7] * s.z,
+                       m[2] * s.x + m[5] * s.y + m[8] * s.z);
+}
+
+static float solver_effective_mass(const ManifoldSolverBody *sb, Vec3 r, Vec3 dir)
+{
+    if (sb->inv_mass == 0.0f)
+        return 0.0f;
+    Vec3 term = vec3_cross(solver_inv_inertia(sb, vec3_cross(r, dir)), r);
+    return sb->inv_mass + vec3_dot(term, dir);
+}
+
+static void solver_apply(const ManifoldSolverBody *sb, Vec3 r, Vec3 impulse)
+{
+    if (sb->inv_mass == 0.0f)
+        return;
+    PhysicsWorld *world = sb->world;
+    int32_t i = sb->index;
+    physics_body_store_velocity(world, i, vec3_add(physics_body_velocity(world, i), vec3_scale(impulse, sb->inv_mass)));
+    physics_body_store_angular_velocity(world, i, vec3_add(physics_body_angular_velocity(world, i),
+                                                           solver_inv_inertia(sb, vec3_cross(r, impulse))));
+}
+
+static Vec3 solver_point_velocity(const ManifoldSolverBody *sb, Vec3 r)
+{
+    return vec3_add(physics_body_velocity(sb->world, sb->index),
+                    vec3_cross(physics_body_angular_velocity(sb->world, sb->index), r));
+}
+
+static Vec3 solver_relative_velocity(const ManifoldSolverBody *a, const ManifoldSolverBody *b, const ManifoldPoint *p)
+{
+    Vec3 va = solver_point_velocity(a, p->r_a);
+    Vec3 vb = solver_point_velocity(b, p->r_b);
+    return vec3_sub(va, vb);
+}
+
+ObjectCollisionPair physics_manifold_as_pair(const ContactManifold *manifold)
+{
+    ObjectCollisionPair pair;
+    pair.body_a = manifold->body_a;
+    pair.body_b = manifold->body_b;
+    pair.contact_point = manifold->points[0].point;
+    pair.contact_normal = manifold->normal;
+    pair.penetration = manifold->points[0].penetration;
+    pair.valid = manifold->point_count > 0;
+    return pair;
+}
+
+void physics_manifolds_solve(PhysicsWorld *world, PhysicsManifolds *cache,
+                             const int32_t *indices, int32_t count, float dt)
+{
+    if (!world || !cache || count <= 0 || dt <= 0.0f)
+        return;
+
+    if (count > PHYS_MAX_MANIFOLDS)
+        count = PHYS_MAX_MANIFOLDS;
+
+    /* Prepare: anchors, effective masses, restitution targets, then warm start */
+    for (int32_t c = 0; c < count; c++)
+    {
+        ContactManifold *m = &cache->manifolds[indices[c]];
+        ManifoldSolverBody *a = &m->solver_a;
+        ManifoldSolverBody *b = &m->solver_b;
+        solver_body_init(a, world, m->body_a);
+        solver_body_init(b, world, m->body_b);
+        m->friction = (a->body->friction + b->body->friction) * 0.5f;
+        float restitution = minf(a->body->restitution, b->body->restitution);
+
+        Vec3 n = vec3_neg(m->normal);
+        for (int32_t i = 0; i < m->point_count; i++)
+        {
+            ManifoldPoint *p = &m->points[i];
+            p->r_a = vec3_sub(p->point, a->com);
+            p->r_b = vec3_sub(p->point, b->com);
+
+            float k_n = solver_effective_mass(a, p->r_a, n) + solver_effective_mass(b, p->r_b, n);
+            p->normal_mass = k_n > K_EPSILON ? 1.0f / k_n : 0.0f;
+            for (int32_t t = 0; t < 2; t++)
+            {
+                float k_t = solver_effective_mass(a, p->r_a, m->tangent[t]) +
+                            solver_effective_mass(b, p->r_b, m->tangent[t]);
+                p->tangent_mass[t] = k_t > K_EPSILON ? 1.0f / k_t : 0.0f;
+            }
+
+            /* Separated: may close the gap this step but not cross it */
+            float v_n = vec3_dot(solver_relative_velocity(a, b, p), n);
+            if (p->penetration < 0.0f)
+            {
+                p->velocity_bias = p->penetration / dt;
+            }
+            else
+            {
+                /* Gravity alone closes resting contacts every step; only real impacts bounce */
+                p->velocity_bias = v_n < -PHYS_RESTITUTION_THRESHOLD ? -restitution * v_n : 0.0f;
+            }
+
+            Vec3 impulse = vec3_add(vec3_scale(n, p->normal_impulse),
+                                    vec3_add(vec3_scale(m->tangent[0], p->tangent_impulse[0]),
+                                             vec3_scale(m->tangent[1], p->tangent_impulse[1])));
+            solver_apply(a, p->r_a, impulse);
+            solver_apply(b, p->r_b, vec3_neg(impulse));
+        }
+    }
+
+    for (int32_t iter = 0; iter < PHYS_SOLVER_ITERATIONS; iter++)
+    {
+        for (int32_t c = 0; c < count; c++)
+        {
+            ContactManifold *m = &cache->manifolds[indices[c]];
+            const ManifoldSolverBody *a = &m->solver_a;
+            const ManifoldSolverBody *b = &m->solver_b;
+            Vec3 n = vec3_neg(m->normal);
+
+            for (int32_t i = 0; i < m->point_count; i++)
+            {
+                ManifoldPoint *p = &m->points[i];
+
+                /* Friction bounded by the current accumulated normal impulse */
+                float max_friction = m->friction * p->normal_impulse;
+                for (int32_t t = 0; t < 2; t++)
+                {
+                    float v_t = vec3_dot(solver_relative_velocity(a, b, p), m->tangent[t]);
+                    float old_impulse = p->tangent_impulse[t];
+                    p->tangent_impulse[t] = clampf(old_impulse - p->tangent_mass[t] * v_t,
+                                                   -max_friction, max_friction);
+                    Vec3 impulse = vec3_scale(m->tangent[t], p->tangent_impulse[t] - old_impulse);
+                    solver_apply(a, p->r_a, impulse);
+                    solver_apply(b, p->r_b, vec3_neg(impulse));
+                }
+
+                float v_n = vec3_dot(solver_relative_velocity(a, b, p), n);
+                float old_impulse = p->normal_impulse;
+                p->normal_impulse = maxf(old_impulse + p->normal_mass * (p->velocity_bias - v_n), 0.0f);
+                Vec3 impulse = vec3_scale(n, p->normal_impulse - old_impulse);
+                solver_apply(a, p->r_a, impulse);
+                solver_apply(b, p->r_b, vec3_neg(impulse));
+            }
+        }
+    }
+
+    /* Position correction and contact flags, once per manifold as the single-point resolve did */
+    for (int32_t c = 0; c < count; c++)
+    {
+        ContactManifold *m = &cache->manifolds[indices[c]];
+        const ManifoldSolverBody *a = &m->solver_a;
+        const ManifoldSolverBody *b = &m->solver_b;
+
+        float penetration = 0.0f;
+        for (int32_t i = 0; i < m->point_count; i++)
+            penetration = maxf(penetration, m->points[i].penetration);
+
+        float total_inv_mass = a->inv_mass + b->inv_mass;
+        if (penetration > PHYS_SLOP && total_inv_mass > K_EPSILON)
+        {
+            Vec3 n = vec3_neg(m->normal);
+            float correction = (penetration - PHYS_SLOP) * 0.8f;
+            int32_t vobj_a = a->body->vobj_index;
+            int32_t vobj_b = b->body->vobj_index;
+            if (a->inv_mass > 0.0f)
+                voxel_object_set_position(world->objects, vobj_a,
+                                          vec3_add(voxel_object_position(world->objects, vobj_a),
+                                                   vec3_scale(n, correction * a->inv_mass / total_inv_mass)));
+            if (b->inv_mass > 0.0f)
+                voxel_object_set_position(world->objects, vobj_b,
+                                          vec3_sub(voxel_object_position(world->objects, vobj_b),
+                                                   vec3_scale(n, correction * b->inv_mass / total_inv_mass)));
+
+            /* Anchors moved with their bodies; depth is consumed until the next detection */
+            for (int32_t i = 0; i < m->point_count; i++)
+                m->points[i].penetration -= correction;
+        }
+
+        /* Normal points from A to B: the body on top is the supported one */
+        if (m->normal.y > 0.5f && !b->held)
+            world->flags[b->index] |= PHYS_FLAG_OBJ_CONTACT;
+        if (m->normal.y < -0.5f && !a->held)
+            world->flags[a->index] |= PHYS_FLAG_OBJ_CONTACT;
+
+        m->wake = false;
+        if (a->held != b->held)
+        {
+            const ManifoldSolverBody *sleeper = a->held ? a : b;
+            const ManifoldSolverBody *mover = a->held ? b : a;
+            Vec3 total = vec3_zero();
+            for (int32_t i = 0; i < m->point_count; i++)
+            {
+                const ManifoldPoint *p = &m->points[i];
+                total = vec3_add(total, vec3_add(vec3_scale(m->normal, p->normal_impulse),
+                                                 vec3_add(vec3_scale(m->tangent[0], p->tangent_impulse[0]),
+                                                          vec3_scale(m->tangent[1], p->tangent_impulse[1]))));
+            }
+            float load = mover->body->mass * vec3_length(world->gravity) * dt;
+            float excess = vec3_length(total) - load;
+            m->wake = excess * world->inv_mass[sleeper->index] > PHYS_WAKE_IMPULSE_THRESHOLD;
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef PATCH_PHYSICS_MANIFOLD_H
+#define PATCH_PHYSICS_MANIFOLD_H
+
+#include "rigidbody.h"
+#include "collision_object.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Persistent Contact Manifolds
+ *
+ * Narrowphase reports one contact per object pair per step. Manifolds
+ * keep up to PHYS_MANIFOLD_POINTS of them per body pair across steps:
+ * - points are stored in both bodies' local frames and refreshed every
+ *   step; separated or drifted points are dropped, and a manifold lives
+ *   as long as it has points
+ * - a new contact matches an old point by feature (the voxel cells it lies
+ *   in on each body) or proximity, inheriting its accumulated impulses
+ * - beyond the limit, the deepest point is kept and the rest chosen to
+ *   maximize contact area
+ *
+ * Live manifolds are solved even on steps where narrowphase misses the
+ * pair (resting contacts sit at zero depth). Separated points act as
+ * speculative contacts: approach is allowed up to the gap, no further.
+ *
+ * The solver warm-starts from last step's accumulated normal and friction
+ * impulses, then runs PHYS_SOLVER_ITERATIONS of sequential impulses with
+ * clamping on the accumulated totals. Resting stacks converge to zero
+ * relative velocity instead of bouncing, so islands reach sleep.
+ *
+ * A sleeping body is held as static. After the solve, the impulse it would
+ * have taken, less what carrying the other body's weight needs, is compared
+ * with PHYS_WAKE_IMPULSE_THRESHOLD per unit of its mass; above it the
+ * manifold is flagged and the step wakes the sleeper.
+ */
+
+#define PHYS_MANIFOLD_POINTS 4
+#define PHYS_MAX_MANIFOLDS 512
+#define PHYS_MANIFOLD_TABLE_SIZE 1024  /* Power of two, >= 2x PHYS_MAX_MANIFOLDS */
+#define PHYS_MANIFOLD_BREAK_RATIO 0.5f /* Drift allowed before a point is dropped, in voxels */
+#define PHYS_MANIFOLD_NORMAL_COS 0.9f  /* Normal turning further than this restarts the manifold */
+#define PHYS_SOLVER_ITERATIONS 8
+#define PHYS_RESTITUTION_THRESHOLD 1.0f /* Approach speed below which contacts do not bounce */
+#define PHYS_WAKE_IMPULSE_THRESHOLD 1.0f /* Excess impulse per unit sleeper mass (m/s) that wakes it */
+
+    typedef struct
+    {
+        Vec3 local_a; /* Contact on A's surface, A's local frame (relative to position) */
+        Vec3 local_b;
+        Vec3 point;   /* World midpoint, refreshed every step */
+        float penetration; /* Negative = separated (speculative) */
+        uint32_t feature;
+
+        /* Accumulated over iterations and carried across steps */
+        float normal_impulse;
+        float tangent_impulse[2];
+
+        /* Per-solve scratch */
+        Vec3 r_a, r_b;
+        float normal_mass;
+        float tangent_mass[2];
+        float velocity_bias;
+    } ManifoldPoint;
+
+    /* Per-solve body view; lives in the manifold so island workers need no stack scratch */
+    typedef struct
+    {
+        PhysicsWorld *world; /* Velocities are read and written in the world's body arrays */
+        int32_t index;
+        const RigidBody *body;
+        float inv_mass;
+        Vec3 inv_inertia;
+        float rot[9];
+        Vec3 com;
+        bool held; /* Sleeping: static for this solve, never written */
+    } ManifoldSolverBody;
+
+    typedef struct
+    {
+        int32_t body_a; /* body_a < body_b */
+        int32_t body_b;
+        Vec3 normal;    /* From A toward B, as ObjectCollisionPair::contact_normal */
+        Vec3 tangent[2];
+        ManifoldPoint points[PHYS_MANIFOLD_POINTS];
+        int32_t point_count;
+        uint32_t stamp; /* Substep narrowphase last reported the pair */
+        bool wake;      /* Last solve: the impact exceeded the sleeping side's wake threshold */
+
+        /* Per-solve scratch */
+        ManifoldSolverBody solver_a;
+        ManifoldSolverBody solver_b;
+        float friction;
+    } ContactManifold;
+
+    typedef struct PhysicsManifolds
+    {
+        ContactManifold manifolds[PHYS_MAX_MANIFOLDS];
+        int32_t count;
+        int16_t table[PHYS_MANIFOLD_TABLE_SIZE]; /* -1 = empty */
+        uint32_t stamp;
+
+        /* Last step */
+        int32_t active_count; /* Manifolds detected */
+        int32_t warm_started; /* Detected contacts that matched a point and kept its impulses */
+    } PhysicsManifolds;
+
+    void physics_manifolds_init(PhysicsManifolds *cache);
+
+    /* Starts a step: refreshes points against current transforms, drops empty manifolds */
+    void physics_manifolds_begin(PhysicsManifolds *cache, const PhysicsWorld *world);
+
+    /* Merges a detected pair into its manifold; returns the manifold index, or -1 when full */
+    int32_t physics_manifolds_add(PhysicsManifolds *cache, PhysicsWorld *world, const ObjectCollisionPair *pair);
+
+    /*
+     * Solves the listed manifolds together: warm start, sequential impulse
+     * iterations, then position correction. Touches only their bodies.
+     */
+    void physics_manifolds_solve(PhysicsWorld *world, PhysicsManifolds *cache,
+                                 const int32_t *indices, int32_t count, float dt);
+
+    /* Manifold as a pair record, for live manifolds narrowphase did not report this step */
+    ObjectCollisionPair physics_manifold_as_pair(const ContactManifold *manifold);
+
+    ContactManifold *physics_manifolds_find(PhysicsManifolds *cache, int32_t body_a, int32_t body_b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
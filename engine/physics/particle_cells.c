@@ -0,0 +1,249 @@
+#include "particle_cells.h"
+#include <string.h>
+#include <math.h>
+
+static inline int32_t cell_coord(float p, float origin, float inv_cell_size, int32_t dim)
+{
+    int32_t c = (int32_t)floorf((p - origin) * inv_cell_size);
+    /* Only rounding lands outside; clamping is monotonic, so neighbours stay within one cell */
+    if (c < 0)
+        c = 0;
+    if (c >= dim)
+        c = dim - 1;
+    return c;
+}
+
+/* (x % 3) + 3 * (y % 3) + 9 * (z % 3) */
+static inline int32_t cell_color(const ParticleCellGrid *grid, int32_t cell)
+{
+    int32_t cx = cell % grid->dim_x;
+    int32_t cy = (cell / grid->dim_x) % grid->dim_y;
+    int32_t cz = cell / (grid->dim_x * grid->dim_y);
+    return cx % 3 + 3 * (cy % 3) + 9 * (cz % 3);
+}
+
+void particle_cells_init(ParticleCellGrid *grid, float min_cell_size)
+{
+    memset(grid, 0, sizeof(*grid));
+    grid->min_cell_size = min_cell_size;
+    grid->cell_size = min_cell_size;
+    grid->inv_cell_size = 1.0f / min_cell_size;
+    grid->dim_x = grid->dim_y = grid->dim_z = 1;
+}
+
+void particle_cells_build(ParticleCellGrid *grid, const int32_t *slots, int32_t count,
+                          const float *x, const float *y, const float *z, const float *radius)
+{
+    if (count > PARTICLE_CELLS_MAX)
+        count = PARTICLE_CELLS_MAX;
+    if (count < 0)
+        count = 0;
+    grid->count = count;
+
+    float max_radius = 0.0f;
+    float lo_x = 0.0f, lo_y = 0.0f, lo_z = 0.0f;
+    float hi_x = 0.0f, hi_y = 0.0f, hi_z = 0.0f;
+    if (count > 0)
+    {
+        lo_x = hi_x = x[slots[0]];
+        lo_y = hi_y = y[slots[0]];
+        lo_z = hi_z = z[slots[0]];
+    }
+    for (int32_t k = 0; k < count; k++)
+    {
+        int32_t i = slots[k];
+        lo_x = x[i] < lo_x ? x[i] : lo_x;
+        lo_y = y[i] < lo_y ? y[i] : lo_y;
+        lo_z = z[i] < lo_z ? z[i] : lo_z;
+        hi_x = x[i] > hi_x ? x[i] : hi_x;
+        hi_y = y[i] > hi_y ? y[i] : hi_y;
+        hi_z = z[i] > hi_z ? z[i] : hi_z;
+        max_radius = radius[i] > max_radius ? radius[i] : max_radius;
+    }
+
+    /* Cells span the largest contact distance, so contacts are always in adjacent cells */
+    float cell_size = max_radius * 2.0f > grid->min_cell_size ? max_radius * 2.0f : grid->min_cell_size;
+
+    /* A grid over the bounds with a few cells per particle; widely spread particles get wider cells */
+    int64_t budget = (int64_t)count * 8;
+    if (budget < 4096)
+        budget = 4096;
+    if (budget > PARTICLE_CELLS_TABLE_MAX)
+        budget = PARTICLE_CELLS_TABLE_MAX;
+    int32_t dim_x = 1, dim_y = 1, dim_z = 1;
+    for (int32_t attempt = 0; attempt < 64; attempt++)
+    {
+        dim_x = (int32_t)fminf((hi_x - lo_x) / cell_size, (float)PARTICLE_CELLS_TABLE_MAX) + 1;
+        dim_y = (int32_t)fminf((hi_y - lo_y) / cell_size, (float)PARTICLE_CELLS_TABLE_MAX) + 1;
+        dim_z = (int32_t)fminf((hi_z - lo_z) / cell_size, (float)PARTICLE_CELLS_TABLE_MAX) + 1;
+        if ((int64_t)dim_x * dim_y * dim_z <= budget)
+            break;
+        cell_size *= 1.25f;
+        dim_x = dim_y = dim_z = 1; /* Non-finite bounds end as one cell */
+    }
+    int32_t cells = dim_x * dim_y * dim_z;
+    grid->cell_size = cell_size;
+    grid->inv_cell_size = 1.0f / cell_size;
+    grid->origin_x = lo_x;
+    grid->origin_y = lo_y;
+    grid->origin_z = lo_z;
+    grid->dim_x = dim_x;
+    grid->dim_y = dim_y;
+    grid->dim_z = dim_z;
+
+    /* Counting sort: cell_start[c + 1] counts cell c, and prefix sums make it the end of cell c */
+    memset(grid->cell_start, 0, sizeof(int32_t) * (size_t)(cells + 2));
+    for (int32_t k = 0; k < count; k++)
+    {
+        int32_t i = slots[k];
+        int32_t cx = cell_coord(x[i], lo_x, grid->inv_cell_size, dim_x);
+        int32_t cy = cell_coord(y[i], lo_y, grid->inv_cell_size, dim_y);
+        int32_t cz = cell_coord(z[i], lo_z, grid->inv_cell_size, dim_z);
+        int32_t cell = cx + dim_x * (cy + dim_y * cz);
+        grid->input_cell[k] = cell;
+        grid->cell_start[cell + 1]++;
+    }
+    for (int32_t c = 2; c <= cells; c++)
+        grid->cell_start[c] += grid->cell_start[c - 1];
+
+    /* Filling each cell backwards from its end keeps input order and leaves cell_start[c + 1] at its start */
+    for (int32_t k = count - 1; k >= 0; k--)
+    {
+        int32_t i = slots[k];
+        int32_t cell = grid->input_cell[k];
+        int32_t p = --grid->cell_start[cell + 1];
+        grid->slot[p] = i;
+        grid->cell[p] = cell;
+        grid->x[p] = x[i];
+        grid->y[p] = y[i];
+        grid->z[p] = z[i];
+        grid->radius[p] = radius[i];
+    }
+    grid->cell_start[cells + 1] = count;
+
+    /* Occupied cells in index order (reusing the input scratch), then counting-sorted by colour */
+    int32_t occupied = 0;
+    memset(grid->color_start, 0, sizeof(grid->color_start));
+    for (int32_t p = 0; p < count; p++)
+    {
+        if (occupied > 0 && grid->input_cell[occupied - 1] == grid->cell[p])
+            continue;
+        int32_t cell = grid->cell[p];
+        grid->input_cell[occupied++] = cell;
+        grid->color_start[cell_color(grid, cell) + 1]++;
+    }
+    for (int32_t k = 1; k <= PARTICLE_CELLS_COLORS; k++)
+        grid->color_start[k] += grid->color_start[k - 1];
+    int32_t cursor[PARTICLE_CELLS_COLORS];
+    memcpy(cursor, grid->color_start, sizeof(cursor));
+    for (int32_t c = 0; c < occupied; c++)
+    {
+        int32_t cell = grid->input_cell[c];
+        grid->color_cells[cursor[cell_color(grid, cell)]++] = cell;
+    }
+}
+
+/* Sorted ranges holding the entries that may touch cell's entries from first on; returns the range count */
+static int32_t near_rows(const ParticleCellGrid *grid, int32_t cell, int32_t first, int32_t near_start[9],
+                         int32_t near_end[9])
+{
+    int32_t cx = cell % grid->dim_x;
+    int32_t cy = (cell / grid->dim_x) % grid->dim_y;
+    int32_t cz = cell / (grid->dim_x * grid->dim_y);
+    int32_t x0 = cx > 0 ? cx - 1 : 0;
+    int32_t x1 = cx < grid->dim_x - 1 ? cx + 1 : cx;
+    int32_t near_count = 0;
+    for (int32_t nz = cz > 0 ? cz - 1 : 0; nz <= cz + 1 && nz < grid->dim_z; nz++)
+    {
+        for (int32_t ny = cy > 0 ? cy - 1 : 0; ny <= cy + 1 && ny < grid->dim_y; ny++)
+        {
+            int32_t row = grid->dim_x * (ny + grid->dim_y * nz);
+            int32_t row_start = grid->cell_start[row + x0 + 1];
+            int32_t row_end = grid->cell_start[row + x1 + 2];
+            /* Rows sorted wholly before first hold no partners */
+            if (row_end <= first + 1)
+                continue;
+            near_start[near_count] = row_start;
+            near_end[near_count] = row_end;
+            near_count++;
+        }
+    }
+    return near_count;
+}
+
+/* Pairs of one sorted entry with the partners after it in the given ranges */
+static int32_t sweep_entry(const ParticleCellGrid *grid, int32_t p, const int32_t *near_start,
+                           const int32_t *near_end, int32_t near_count, ParticleCellPairFn fn, void *user_data)
+{
+    float px = grid->x[p];
+    float py = grid->y[p];
+    float pz = grid->z[p];
+    float pr = grid->radius[p];
+    int32_t pairs = 0;
+    for (int32_t n = 0; n < near_count; n++)
+    {
+        /* Only partners sorted after p: the pair belongs to p */
+        int32_t q = near_start[n] > p + 1 ? near_start[n] : p + 1;
+        for (; q < near_end[n]; q++)
+        {
+            float dx = grid->x[q] - px;
+            float dy = grid->y[q] - py;
+            float dz = grid->z[q] - pz;
+            float min_dist = pr + grid->radius[q];
+            if (dx * dx + dy * dy + dz * dz < min_dist * min_dist)
+            {
+                fn(grid->slot[p], grid->slot[q], user_data);
+                pairs++;
+            }
+        }
+    }
+    return pairs;
+}
+
+int32_t particle_cells_sweep(const ParticleCellGrid *grid, int32_t begin, int32_t end,
+                             ParticleCellPairFn fn, void *user_data)
+{
+    if (begin < 0)
+        begin = 0;
+    if (end > grid->count)
+        end = grid->count;
+
+    int32_t near_start[9];
+    int32_t near_end[9];
+    int32_t near_count = 0;
+    int32_t current = -1;
+    int32_t pairs = 0;
+
+    for (int32_t p = begin; p < end; p++)
+    {
+        /* A cell's entries are contiguous, so its rows are found once */
+        if (grid->cell[p] != current)
+        {
+            current = grid->cell[p];
+            near_count = near_rows(grid, current, p, near_start, near_end);
+        }
+        pairs += sweep_entry(grid, p, near_start, near_end, near_count, fn, user_data);
+    }
+
+    return pairs;
+}
+
+int32_t particle_cells_sweep_cells(const ParticleCellGrid *grid, int32_t first, int32_t last,
+                                   ParticleCellPairFn fn, void *user_data)
+{
+    int32_t near_start[9];
+    int32_t near_end[9];
+    int32_t pairs = 0;
+
+    for (int32_t c = first; c < last; c++)
+    {
+        int32_t cell = grid->color_cells[c];
+        int32_t begin = grid->cell_start[cell + 1];
+        int32_t end = grid->cell_start[cell + 2];
+        int32_t near_count = near_rows(grid, cell, begin, near_start, near_end);
+        for (int32_t p = begin; p < end; p++)
+            pairs += sweep_entry(grid, p, near_start, near_end, near_count, fn, user_data);
+    }
+
+    return pairs;
+}
@@ -0,0 +1,99 @@
+#ifndef PATCH_PHYSICS_PARTICLE_CELLS_H
+#define PATCH_PHYSICS_PARTICLE_CELLS_H
+
+#include "engine/core/types.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Cell-Sorted Particle Pairs
+ *
+ * Broad phase for particle-particle contacts, rebuilt every tick:
+ * - a uniform grid is laid over the particles' bounds; cells are at least as
+ *   wide as the largest contact distance (twice the largest radius) and grow
+ *   when the particles are spread too widely for the cell budget
+ * - each particle goes into the cell holding its centre, and the particles
+ *   are counting-sorted by cell index (prefix sums over cell counts), so
+ *   every cell's particles sit in one contiguous run
+ * - x is the fastest grid axis, so three neighbouring cells along x are one
+ *   sorted range; the sweep visits, for each sorted particle p, the 9 ranges
+ *   around its cell and reports overlapping partners q > p only, so every
+ *   pair is reported exactly once with no pair cap
+ * Because a pair belongs to its lower sorted index, any split of [0, count)
+ * into ranges reports each pair in exactly one range.
+ *
+ * Resolving pairs moves both particles, so ranges cannot be resolved
+ * concurrently. For that the occupied cells are also listed by colour,
+ * (x % 3) + 3 * (y % 3) + 9 * (z % 3): two cells of one colour are three
+ * or more cells apart on some axis, so the particles they touch (their own
+ * and their neighbours') never overlap. The cells of one colour can be
+ * swept on any number of threads, and sweeping the colours in order gives
+ * the same result for every thread count.
+ */
+
+#define PARTICLE_CELLS_MAX 65536
+#define PARTICLE_CELLS_SIZE (PARTICLE_CELLS_MAX + 16)     /* Same padding as the particle arrays */
+#define PARTICLE_CELLS_TABLE_MAX (PARTICLE_CELLS_MAX * 2) /* Most grid cells per build */
+#define PARTICLE_CELLS_COLORS 27
+
+    typedef struct
+    {
+        /* Sorted by cell: cell c is [cell_start[c + 1], cell_start[c + 2]) */
+        int32_t slot[PARTICLE_CELLS_SIZE]; /* Caller's index of each sorted entry */
+        int32_t cell[PARTICLE_CELLS_SIZE];
+        float x[PARTICLE_CELLS_SIZE];
+        float y[PARTICLE_CELLS_SIZE];
+        float z[PARTICLE_CELLS_SIZE];
+        float radius[PARTICLE_CELLS_SIZE];
+        int32_t count;
+
+        int32_t cell_start[PARTICLE_CELLS_TABLE_MAX + 2];
+        int32_t input_cell[PARTICLE_CELLS_SIZE]; /* Build scratch, in input order */
+
+        /* Occupied cells by colour: colour k is color_cells[color_start[k] .. color_start[k + 1]) */
+        int32_t color_cells[PARTICLE_CELLS_SIZE];
+        int32_t color_start[PARTICLE_CELLS_COLORS + 1];
+
+        /* Grid of the last build; cell index = x + dim_x * (y + dim_y * z) */
+        float origin_x, origin_y, origin_z;
+        int32_t dim_x, dim_y, dim_z;
+        float min_cell_size;
+        float cell_size;
+        float inv_cell_size;
+    } ParticleCellGrid;
+
+    /* Reports one overlapping pair by the caller's indices */
+    typedef void (*ParticleCellPairFn)(int32_t slot_a, int32_t slot_b, void *user_data);
+
+    void particle_cells_init(ParticleCellGrid *grid, float min_cell_size);
+
+    /*
+     * Sorts slots[0..count) into cells, reading each one's centre and radius
+     * from the caller's structure-of-arrays (x[slot], ...). Count is clamped
+     * to PARTICLE_CELLS_MAX.
+     */
+    void particle_cells_build(ParticleCellGrid *grid, const int32_t *slots, int32_t count,
+                              const float *x, const float *y, const float *z, const float *radius);
+
+    /* Reports the overlapping pairs owned by sorted entries [begin, end); returns the pair count */
+    int32_t particle_cells_sweep(const ParticleCellGrid *grid, int32_t begin, int32_t end,
+                                 ParticleCellPairFn fn, void *user_data);
+
+    /*
+     * Reports the overlapping pairs owned by the entries of cells
+     * color_cells[first .. last); returns the pair count. Runs within one
+     * colour may be swept concurrently.
+     */
+    int32_t particle_cells_sweep_cells(const ParticleCellGrid *grid, int32_t first, int32_t last,
+                                       ParticleCellPairFn fn, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
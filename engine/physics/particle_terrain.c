@@ -0,0 +1,458 @@
+#include "particle_terrain.h"
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TERRAIN_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TERRAIN_LANES 4
+#else
+#define TERRAIN_LANES 1
+#endif
+
+/* Logical chunk key: chunk coordinates packed by the volume's maximum extents */
+#define TERRAIN_KEY_BITS_X (9 - CHUNK_SIZE_BITS)
+#define TERRAIN_KEY_BITS_Y (8 - CHUNK_SIZE_BITS)
+static_assert(VOLUME_MAX_CHUNKS_X == 1 << TERRAIN_KEY_BITS_X, "chunk key x bits must match VOLUME_MAX_CHUNKS_X");
+static_assert(VOLUME_MAX_CHUNKS_Y == 1 << TERRAIN_KEY_BITS_Y, "chunk key y bits must match VOLUME_MAX_CHUNKS_Y");
+static_assert(VOLUME_MAX_CHUNKS <= 32767, "bin and mask indices are int16_t");
+static_assert((PARTICLE_TERRAIN_CACHE_CHUNKS & (PARTICLE_TERRAIN_CACHE_CHUNKS - 1)) == 0,
+              "PARTICLE_TERRAIN_CACHE_CHUNKS must be a power of two");
+
+void particle_terrain_init(ParticleTerrain *pt)
+{
+    memset(pt, 0, sizeof(*pt));
+    memset(pt->key_bin, 0xff, sizeof(pt->key_bin));
+    memset(pt->slot_mask, 0xff, sizeof(pt->slot_mask));
+    for (int32_t i = 0; i < PARTICLE_TERRAIN_CACHE_CHUNKS; i++)
+        pt->masks[i].slot = -1;
+}
+
+/* Drops every cached mask when the queried volume changes */
+static void terrain_sync(ParticleTerrain *pt, const VoxelVolume *terrain)
+{
+    if (pt->terrain == terrain)
+        return;
+    for (int32_t i = 0; i < PARTICLE_TERRAIN_CACHE_CHUNKS; i++)
+    {
+        if (pt->masks[i].slot >= 0)
+            pt->slot_mask[pt->masks[i].slot] = -1;
+        pt->masks[i].slot = -1;
+    }
+    pt->terrain = terrain;
+}
+
+static void build_mask(ParticleChunkMask *mask, const Chunk *chunk)
+{
+    memset(mask->rows, 0, sizeof(mask->rows));
+
+    /* Only regions with solid voxels are read */
+    for (int32_t bit = 0; bit < 64; bit++)
+    {
+        if (!(chunk->occupancy.level0 & (1ULL << bit)))
+            continue;
+
+        int32_t x0 = (bit & 3) << CHUNK_REGION_BITS;
+        int32_t y0 = ((bit >> 2) & 3) << CHUNK_REGION_BITS;
+        int32_t z0 = (bit >> 4) << CHUNK_REGION_BITS;
+        for (int32_t z = z0; z < z0 + CHUNK_REGION_SIZE; z++)
+        {
+            for (int32_t y = y0; y < y0 + CHUNK_REGION_SIZE; y++)
+            {
+                uint64_t row = 0;
+                for (int32_t x = x0; x < x0 + CHUNK_REGION_SIZE; x++)
+                {
+                    if (chunk->voxels[chunk_voxel_index(x, y, z)].material != MATERIAL_EMPTY)
+                        row |= 1ULL << x;
+                }
+                mask->rows[y + z * CHUNK_SIZE] |= row;
+            }
+        }
+    }
+}
+
+/*
+ * Cached mask of a chunk, (re)built when missing or stale. Inside a batch,
+ * masks the batch already uses stay put; -1 when every mask is in use.
+ */
+static int32_t terrain_mask(ParticleTerrain *pt, const VoxelVolume *terrain, int32_t slot, bool in_batch)
+{
+    int32_t index = pt->slot_mask[slot];
+    bool stale = index < 0;
+    if (index < 0)
+    {
+        for (int32_t tries = 0; tries < PARTICLE_TERRAIN_CACHE_CHUNKS && index < 0; tries++)
+        {
+            int32_t candidate = pt->evict_cursor;
+            pt->evict_cursor = (pt->evict_cursor + 1) & (PARTICLE_TERRAIN_CACHE_CHUNKS - 1);
+            if (!in_batch || pt->masks[candidate].batch != pt->batch)
+                index = candidate;
+        }
+        if (index < 0)
+            return -1;
+
+        ParticleChunkMask *evicted = &pt->masks[index];
+        if (evicted->slot >= 0)
+            pt->slot_mask[evicted->slot] = -1;
+        evicted->slot = slot;
+        pt->slot_mask[slot] = (int16_t)index;
+    }
+
+    ParticleChunkMask *mask = &pt->masks[index];
+    uint32_t version = terrain->chunk_versions[slot];
+    if (stale || mask->version != version)
+    {
+        build_mask(mask, &terrain->chunks[slot]);
+        mask->version = version;
+        pt->masks_built++;
+    }
+    mask->batch = pt->batch;
+    return index;
+}
+
+static inline bool mask_test(const ParticleChunkMask *mask, int32_t gx, int32_t gy, int32_t gz)
+{
+    int32_t lx = gx & CHUNK_SIZE_MASK;
+    int32_t ly = gy & CHUNK_SIZE_MASK;
+    int32_t lz = gz & CHUNK_SIZE_MASK;
+    return (mask->rows[ly + lz * CHUNK_SIZE] >> lx) & 1u;
+}
+
+/* Solid test in a chunk known to be in range, through its mask when one is free */
+static bool chunk_voxel_solid(ParticleTerrain *pt, const VoxelVolume *terrain, int32_t slot, int32_t mask,
+                              int32_t gx, int32_t gy, int32_t gz)
+{
+    if (mask >= 0)
+        return mask_test(&pt->masks[mask], gx, gy, gz);
+    return chunk_get(&terrain->chunks[slot], gx & CHUNK_SIZE_MASK, gy & CHUNK_SIZE_MASK, gz & CHUNK_SIZE_MASK) !=
+           MATERIAL_EMPTY;
+}
+
+/*
+ * Global voxel and chunk key of each query, by the same float steps as
+ * volume_world_to_local (truncate, then step down where the truncation
+ * rounded up). chunk[q] gets the key where the chunk is inside the volume
+ * and the local voxel inside [0, CHUNK_SIZE), -1 elsewhere - the cases where
+ * volume_get_at answers empty.
+ */
+#if TERRAIN_LANES > 1
+
+#if TERRAIN_LANES == 8
+typedef __m256 TerrainF;
+typedef __m256i TerrainI;
+static inline TerrainF tf_load(const float *p) { return _mm256_loadu_ps(p); }
+static inline TerrainF tf_set1(float f) { return _mm256_set1_ps(f); }
+static inline TerrainF tf_sub(TerrainF a, TerrainF b) { return _mm256_sub_ps(a, b); }
+static inline TerrainF tf_mul(TerrainF a, TerrainF b) { return _mm256_mul_ps(a, b); }
+static inline TerrainF tf_div(TerrainF a, TerrainF b) { return _mm256_div_ps(a, b); }
+static inline TerrainI ti_set1(int32_t i) { return _mm256_set1_epi32(i); }
+static inline TerrainI ti_add(TerrainI a, TerrainI b) { return _mm256_add_epi32(a, b); }
+static inline TerrainI ti_and(TerrainI a, TerrainI b) { return _mm256_and_si256(a, b); }
+static inline TerrainI ti_xor(TerrainI a, TerrainI b) { return _mm256_xor_si256(a, b); }
+static inline TerrainI ti_gt(TerrainI a, TerrainI b) { return _mm256_cmpgt_epi32(a, b); }
+static inline TerrainI ti_eq(TerrainI a, TerrainI b) { return _mm256_cmpeq_epi32(a, b); }
+static inline TerrainI ti_or(TerrainI a, TerrainI b) { return _mm256_or_si256(a, b); }
+#define ti_shl(a, bits) _mm256_slli_epi32((a), (bits))
+static inline void ti_store(int32_t *p, TerrainI v) { _mm256_storeu_si256((__m256i *)p, v); }
+
+/* floor as volume_world_to_local computes it: subtracting the all-ones compare steps down */
+static inline TerrainI tf_floor(TerrainF f)
+{
+    TerrainI i = _mm256_cvttps_epi32(f);
+    TerrainF back = _mm256_cvtepi32_ps(i);
+    return _mm256_add_epi32(i, _mm256_castps_si256(_mm256_cmp_ps(back, f, _CMP_GT_OQ)));
+}
+static inline TerrainF ti_to_float(TerrainI i) { return _mm256_cvtepi32_ps(i); }
+#else
+typedef __m128 TerrainF;
+typedef __m128i TerrainI;
+static inline TerrainF tf_load(const float *p) { return _mm_loadu_ps(p); }
+static inline TerrainF tf_set1(float f) { return _mm_set1_ps(f); }
+static inline TerrainF tf_sub(TerrainF a, TerrainF b) { return _mm_sub_ps(a, b); }
+static inline TerrainF tf_mul(TerrainF a, TerrainF b) { return _mm_mul_ps(a, b); }
+static inline TerrainF tf_div(TerrainF a, TerrainF b) { return _mm_div_ps(a, b); }
+static inline TerrainI ti_set1(int32_t i) { return _mm_set1_epi32(i); }
+static inline TerrainI ti_add(TerrainI a, TerrainI b) { return _mm_add_epi32(a, b); }
+static inline TerrainI ti_and(TerrainI a, TerrainI b) { return _mm_and_si128(a, b); }
+static inline TerrainI ti_xor(TerrainI a, TerrainI b) { return _mm_xor_si128(a, b); }
+static inline TerrainI ti_gt(TerrainI a, TerrainI b) { return _mm_cmpgt_epi32(a, b); }
+static inline TerrainI ti_eq(TerrainI a, TerrainI b) { return _mm_cmpeq_epi32(a, b); }
+static inline TerrainI ti_or(TerrainI a, TerrainI b) { return _mm_or_si128(a, b); }
+#define ti_shl(a, bits) _mm_slli_epi32((a), (bits))
+static inline void ti_store(int32_t *p, TerrainI v) { _mm_storeu_si128((__m128i *)p, v); }
+
+static inline TerrainI tf_floor(TerrainF f)
+{
+    TerrainI i = _mm_cvttps_epi32(f);
+    TerrainF back = _mm_cvtepi32_ps(i);
+    return _mm_add_epi32(i, _mm_castps_si128(_mm_cmpgt_ps(back, f)));
+}
+static inline TerrainF ti_to_float(TerrainI i) { return _mm_cvtepi32_ps(i); }
+#endif
+
+/* One axis: global voxel, its chunk, and lanes where both chunk and local voxel are in range */
+static inline TerrainI lanes_axis(TerrainF p, TerrainF min, TerrainF chunk_world_size, TerrainF voxel_size,
+                                  TerrainI chunk_count, TerrainI *chunk, TerrainI *valid)
+{
+    TerrainF local = tf_sub(p, min);
+    TerrainI c = tf_floor(tf_div(local, chunk_world_size));
+    TerrainF base = tf_mul(ti_to_float(c), chunk_world_size);
+    TerrainI l = tf_floor(tf_div(tf_sub(local, base), voxel_size));
+
+    TerrainI in_chunk = ti_and(ti_gt(c, ti_set1(-1)), ti_gt(chunk_count, c));
+    TerrainI in_local = ti_eq(ti_and(l, ti_set1(~CHUNK_SIZE_MASK)), ti_set1(0));
+    *valid = ti_and(*valid, ti_and(in_chunk, in_local));
+    *chunk = c;
+    return ti_add(ti_shl(c, CHUNK_SIZE_BITS), l);
+}
+
+static void terrain_voxels(ParticleTerrain *pt, const VoxelVolume *terrain)
+{
+    const TerrainF min_x = tf_set1(terrain->bounds.min_x);
+    const TerrainF min_y = tf_set1(terrain->bounds.min_y);
+    const TerrainF min_z = tf_set1(terrain->bounds.min_z);
+    const TerrainF chunk_world_size = tf_set1(terrain->voxel_size * CHUNK_SIZE);
+    const TerrainF voxel_size = tf_set1(terrain->voxel_size);
+    const TerrainI chunks_x = ti_set1(terrain->chunks_x);
+    const TerrainI chunks_y = ti_set1(terrain->chunks_y);
+    const TerrainI chunks_z = ti_set1(terrain->chunks_z);
+
+    /* Lanes past count read stale entries; their answers are never used */
+    for (int32_t q = 0; q < pt->count; q += TERRAIN_LANES)
+    {
+        TerrainI valid = ti_set1(-1);
+        TerrainI cx, cy, cz;
+        ti_store(&pt->gx[q],
+                 lanes_axis(tf_load(&pt->x[q]), min_x, chunk_world_size, voxel_size, chunks_x, &cx, &valid));
+        ti_store(&pt->gy[q],
+                 lanes_axis(tf_load(&pt->y[q]), min_y, chunk_world_size, voxel_size, chunks_y, &cy, &valid));
+        ti_store(&pt->gz[q],
+                 lanes_axis(tf_load(&pt->z[q]), min_z, chunk_world_size, voxel_size, chunks_z, &cz, &valid));
+
+        TerrainI key = ti_or(cx, ti_or(ti_shl(cy, TERRAIN_KEY_BITS_X),
+                                       ti_shl(cz, TERRAIN_KEY_BITS_X + TERRAIN_KEY_BITS_Y)));
+        /* Key where valid (all ones), -1 elsewhere */
+        ti_store(&pt->chunk[q], ti_or(ti_and(key, valid), ti_xor(valid, ti_set1(-1))));
+    }
+}
+
+#else
+
+static inline int32_t scalar_floor(float f)
+{
+    int32_t i = (int32_t)f;
+    if ((float)i > f)
+        i--;
+    return i;
+}
+
+static inline int32_t scalar_axis(float p, float min, float chunk_world_size, float voxel_size,
+                                  int32_t chunk_count, int32_t *chunk, bool *valid)
+{
+    float local = p - min;
+    int32_t c = scalar_floor(local / chunk_world_size);
+    float base = c * chunk_world_size;
+    int32_t l = scalar_floor((local - base) / voxel_size);
+    if (c < 0 || c >= chunk_count || l < 0 || l >= CHUNK_SIZE)
+    {
+        *valid = false;
+        return 0;
+    }
+    *chunk = c;
+    return c * CHUNK_SIZE + l;
+}
+
+static void terrain_voxels(ParticleTerrain *pt, const VoxelVolume *terrain)
+{
+    float chunk_world_size = terrain->voxel_size * CHUNK_SIZE;
+    for (int32_t q = 0; q < pt->count; q++)
+    {
+        bool valid = true;
+        int32_t cx = 0, cy = 0, cz = 0;
+        pt->gx[q] = scalar_axis(pt->x[q], terrain->bounds.min_x, chunk_world_size, terrain->voxel_size,
+                                terrain->chunks_x, &cx, &valid);
+        pt->gy[q] = scalar_axis(pt->y[q], terrain->bounds.min_y, chunk_world_size, terrain->voxel_size,
+                                terrain->chunks_y, &cy, &valid);
+        pt->gz[q] = scalar_axis(pt->z[q], terrain->bounds.min_z, chunk_world_size, terrain->voxel_size,
+                                terrain->chunks_z, &cz, &valid);
+        pt->chunk[q] = valid ? cx | (cy << TERRAIN_KEY_BITS_X) | (cz << (TERRAIN_KEY_BITS_X + TERRAIN_KEY_BITS_Y))
+                             : -1;
+    }
+}
+
+#endif
+
+/* Opens this batch's bin for a chunk key: storage slot and mask, resolved once */
+static int32_t terrain_bin(ParticleTerrain *pt, const VoxelVolume *terrain, int32_t key)
+{
+    int32_t cx = key & (VOLUME_MAX_CHUNKS_X - 1);
+    int32_t cy = (key >> TERRAIN_KEY_BITS_X) & (VOLUME_MAX_CHUNKS_Y - 1);
+    int32_t cz = key >> (TERRAIN_KEY_BITS_X + TERRAIN_KEY_BITS_Y);
+    int32_t slot = volume_chunk_slot(terrain, cx, cy, cz);
+
+    int32_t b = pt->bin_count++;
+    pt->key_bin[key] = (int16_t)b;
+    pt->bin_key[b] = key;
+    if (terrain->chunks[slot].occupancy.has_any)
+    {
+        pt->bin_slot[b] = slot;
+        pt->bin_mask[b] = (int16_t)terrain_mask(pt, terrain, slot, true);
+    }
+    else
+    {
+        pt->bin_slot[b] = -1;
+        pt->bin_mask[b] = -1;
+    }
+    return b;
+}
+
+void particle_terrain_solve(ParticleTerrain *pt, const VoxelVolume *terrain)
+{
+    int32_t count = pt->count;
+    if (count <= 0)
+        return;
+
+    if (!terrain)
+    {
+        memset(pt->solid, 0, (size_t)count);
+        for (int32_t q = 0; q < count; q++)
+            pt->chunk[q] = -1;
+        return;
+    }
+
+    terrain_sync(pt, terrain);
+    pt->batch++;
+    terrain_voxels(pt, terrain);
+
+    /* Neighbouring queries usually share a chunk, so the last bin is kept at hand */
+    int32_t last_key = -1;
+    int32_t b = -1;
+    for (int32_t q = 0; q < count; q++)
+    {
+        int32_t key = pt->chunk[q];
+        if (key < 0)
+        {
+            pt->solid[q] = 0;
+            continue;
+        }
+        if (key != last_key)
+        {
+            b = pt->key_bin[key];
+            if (b < 0)
+                b = terrain_bin(pt, terrain, key);
+            last_key = key;
+        }
+
+        int32_t slot = pt->bin_slot[b];
+        pt->chunk[q] = slot;
+        pt->solid[q] = slot >= 0 &&
+                       chunk_voxel_solid(pt, terrain, slot, pt->bin_mask[b], pt->gx[q], pt->gy[q], pt->gz[q]);
+    }
+
+    for (int32_t k = 0; k < pt->bin_count; k++)
+        pt->key_bin[pt->bin_key[k]] = -1;
+    pt->bin_count = 0;
+}
+
+bool particle_terrain_voxel_solid(ParticleTerrain *pt, const VoxelVolume *terrain,
+                                  int32_t gx, int32_t gy, int32_t gz)
+{
+    if (!terrain || gx < 0 || gy < 0 || gz < 0)
+        return false;
+
+    int32_t cx = gx >> CHUNK_SIZE_BITS;
+    int32_t cy = gy >> CHUNK_SIZE_BITS;
+    int32_t cz = gz >> CHUNK_SIZE_BITS;
+    if (cx >= terrain->chunks_x || cy >= terrain->chunks_y || cz >= terrain->chunks_z)
+        return false;
+
+    int32_t slot = volume_chunk_slot(terrain, cx, cy, cz);
+    if (!terrain->chunks[slot].occupancy.has_any)
+        return false;
+
+    terrain_sync(pt, terrain);
+    return chunk_voxel_solid(pt, terrain, slot, terrain_mask(pt, terrain, slot, false), gx, gy, gz);
+}
+
+/*
+ * Global voxel from chunk and local coordinates. Points far outside are pulled
+ * in to two chunks out, which keeps them and their neighbours outside while
+ * avoiding overflow.
+ */
+static inline int32_t global_voxel(int32_t c, int32_t l, int32_t chunk_count)
+{
+    if (c < -2)
+        c = -2;
+    if (c > chunk_count + 1)
+        c = chunk_count + 1;
+    if (l < -1)
+        l = -1;
+    if (l > CHUNK_SIZE)
+        l = CHUNK_SIZE;
+    return c * CHUNK_SIZE + l;
+}
+
+bool particle_terrain_voxel_peek(const ParticleTerrain *pt, const VoxelVolume *terrain,
+                                 int32_t gx, int32_t gy, int32_t gz)
+{
+    if (!terrain || gx < 0 || gy < 0 || gz < 0)
+        return false;
+
+    int32_t cx = gx >> CHUNK_SIZE_BITS;
+    int32_t cy = gy >> CHUNK_SIZE_BITS;
+    int32_t cz = gz >> CHUNK_SIZE_BITS;
+    if (cx >= terrain->chunks_x || cy >= terrain->chunks_y || cz >= terrain->chunks_z)
+        return false;
+
+    int32_t slot = volume_chunk_slot(terrain, cx, cy, cz);
+    if (!terrain->chunks[slot].occupancy.has_any)
+        return false;
+
+    int32_t mask = pt->terrain == terrain ? pt->slot_mask[slot] : -1;
+    if (mask >= 0 && pt->masks[mask].version == terrain->chunk_versions[slot])
+        return mask_test(&pt->masks[mask], gx, gy, gz);
+    return chunk_get(&terrain->chunks[slot], gx & CHUNK_SIZE_MASK, gy & CHUNK_SIZE_MASK, gz & CHUNK_SIZE_MASK) !=
+           MATERIAL_EMPTY;
+}
+
+/* Global voxel of a point (see particle_terrain_point_solid); false when it is outside the volume */
+static bool point_voxel(const VoxelVolume *terrain, Vec3 point, int32_t voxel[3])
+{
+    int32_t cx, cy, cz, lx, ly, lz;
+    volume_world_to_local(terrain, point, &cx, &cy, &cz, &lx, &ly, &lz);
+    voxel[0] = global_voxel(cx, lx, terrain->chunks_x);
+    voxel[1] = global_voxel(cy, ly, terrain->chunks_y);
+    voxel[2] = global_voxel(cz, lz, terrain->chunks_z);
+
+    return cx >= 0 && cx < terrain->chunks_x &&
+           cy >= 0 && cy < terrain->chunks_y &&
+           cz >= 0 && cz < terrain->chunks_z &&
+           chunk_in_bounds(lx, ly, lz);
+}
+
+bool particle_terrain_point_solid(ParticleTerrain *pt, const VoxelVolume *terrain, Vec3 point,
+                                  int32_t out_voxel[3])
+{
+    if (!terrain)
+        return false;
+
+    int32_t voxel[3];
+    bool inside = point_voxel(terrain, point, voxel);
+    if (out_voxel)
+        memcpy(out_voxel, voxel, sizeof(voxel));
+    return inside && particle_terrain_voxel_solid(pt, terrain, voxel[0], voxel[1], voxel[2]);
+}
+
+bool particle_terrain_point_peek(const ParticleTerrain *pt, const VoxelVolume *terrain, Vec3 point,
+                                 int32_t out_voxel[3])
+{
+    if (!terrain)
+        return false;
+
+    int32_t voxel[3];
+    bool inside = point_voxel(terrain, point, voxel);
+    if (out_voxel)
+        memcpy(out_voxel, voxel, sizeof(voxel));
+    return inside && particle_terrain_voxel_peek(pt, terrain, voxel[0], voxel[1], voxel[2]);
+}
@@ -0,0 +1,125 @@
+#ifndef PATCH_PHYSICS_PARTICLE_TERRAIN_H
+#define PATCH_PHYSICS_PARTICLE_TERRAIN_H
+
+#include "engine/core/types.h"
+#include "engine/core/math.h"
+#include "engine/voxel/volume.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Batched Particle Terrain Queries
+ *
+ * Particles ask terrain the same question many times per tick: is the voxel
+ * under this point solid? Instead of one volume_is_solid_at per point, the
+ * points are queued and answered together:
+ * - positions become chunk and local voxel coordinates several at a time
+ *   (8 lanes with AVX2, 4 with SSE2, scalar otherwise) using the same float
+ *   steps as volume_world_to_local, so answers match volume_is_solid_at
+ * - points outside the volume or in chunks without has_any answer empty;
+ *   the rest are binned by chunk, and each chunk is resolved once per batch
+ * - each point is tested against its chunk's solid bitmask (one bit per
+ *   voxel, a 64-bit word per x row) with integer shifts only
+ * Masks are built from the voxels on first use and cached by storage slot.
+ * Each one remembers the chunk version (VoxelVolume::chunk_versions) it was
+ * built from, so an edit rebuilds only the chunks it touched. Neighbourhood
+ * lookups (contact normals, escape probes) read the same masks by global
+ * voxel coordinates.
+ */
+
+#define PARTICLE_TERRAIN_MAX_QUERIES 65536
+#define PARTICLE_TERRAIN_QUERY_SIZE (PARTICLE_TERRAIN_MAX_QUERIES + 16) /* Room for a whole last lane block */
+#define PARTICLE_TERRAIN_CACHE_CHUNKS 64 /* Cached masks; a batch touching more chunks reads the rest directly */
+
+    typedef struct
+    {
+        uint64_t rows[CHUNK_SIZE * CHUNK_SIZE]; /* Bit x of word y + z * CHUNK_SIZE */
+        int32_t slot;                           /* Chunk storage slot, -1 = unused */
+        uint32_t version;
+        uint32_t batch; /* Last batch that used it; those are not evicted mid-batch */
+    } ParticleChunkMask;
+
+    typedef struct
+    {
+        /* Queued points, answered in place by particle_terrain_solve */
+        float x[PARTICLE_TERRAIN_QUERY_SIZE];
+        float y[PARTICLE_TERRAIN_QUERY_SIZE];
+        float z[PARTICLE_TERRAIN_QUERY_SIZE];
+        uint8_t solid[PARTICLE_TERRAIN_QUERY_SIZE];
+        int32_t count;
+
+        /* Per query: global voxel coordinates, valid where chunk >= 0 */
+        int32_t gx[PARTICLE_TERRAIN_QUERY_SIZE];
+        int32_t gy[PARTICLE_TERRAIN_QUERY_SIZE];
+        int32_t gz[PARTICLE_TERRAIN_QUERY_SIZE];
+        int32_t chunk[PARTICLE_TERRAIN_QUERY_SIZE]; /* Storage slot, -1 = outside or empty chunk */
+
+        /* Chunk bins of the current batch, by logical chunk key */
+        int16_t key_bin[VOLUME_MAX_CHUNKS]; /* -1 = not seen this batch */
+        int32_t bin_key[VOLUME_MAX_CHUNKS];
+        int32_t bin_slot[VOLUME_MAX_CHUNKS];  /* -1 = chunk has no solid voxels */
+        int16_t bin_mask[VOLUME_MAX_CHUNKS];  /* Index into masks, -1 = read voxels directly */
+        int32_t bin_count;
+
+        /* Mask cache */
+        const VoxelVolume *terrain; /* Volume the cached masks were built from */
+        ParticleChunkMask masks[PARTICLE_TERRAIN_CACHE_CHUNKS];
+        int16_t slot_mask[VOLUME_MAX_CHUNKS]; /* Storage slot -> index into masks, -1 = none */
+        int32_t evict_cursor;
+        uint32_t batch;
+        int32_t masks_built; /* Mask (re)builds since init (stats) */
+    } ParticleTerrain;
+
+    void particle_terrain_init(ParticleTerrain *pt);
+
+    /* Empties the query queue */
+    static inline void particle_terrain_begin(ParticleTerrain *pt)
+    {
+        pt->count = 0;
+    }
+
+    /* Queues a point; returns its query index */
+    static inline int32_t particle_terrain_push(ParticleTerrain *pt, float x, float y, float z)
+    {
+        int32_t q = pt->count++;
+        pt->x[q] = x;
+        pt->y[q] = y;
+        pt->z[q] = z;
+        return q;
+    }
+
+    /* Answers every queued point: solid[], and gx/gy/gz/chunk */
+    void particle_terrain_solve(ParticleTerrain *pt, const VoxelVolume *terrain);
+
+    /* Solid test for one global voxel; false outside the volume */
+    bool particle_terrain_voxel_solid(ParticleTerrain *pt, const VoxelVolume *terrain,
+                                      int32_t gx, int32_t gy, int32_t gz);
+
+    /*
+     * Solid test for one point, same answer as volume_is_solid_at. out_voxel
+     * (optional) gets the point's global voxel, which may lie outside the
+     * volume; its neighbours can be tested with particle_terrain_voxel_solid.
+     */
+    bool particle_terrain_point_solid(ParticleTerrain *pt, const VoxelVolume *terrain, Vec3 point,
+                                      int32_t out_voxel[3]);
+
+    /*
+     * Read-only forms of the two tests above, safe on worker threads while
+     * nothing else uses pt: current cached masks answer, other chunks are
+     * read directly, and no mask is built or evicted.
+     */
+    bool particle_terrain_voxel_peek(const ParticleTerrain *pt, const VoxelVolume *terrain,
+                                     int32_t gx, int32_t gy, int32_t gz);
+    bool particle_terrain_point_peek(const ParticleTerrain *pt, const VoxelVolume *terrain, Vec3 point,
+                                     int32_t out_voxel[3]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,10 +1,36 @@
 #include "particles.h"
+#include "island.h"
 #include "engine/voxel/volume.h"
 #include "engine/voxel/voxel_object.h"
+#include "engine/core/profile.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PARTICLE_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_LANES 4
+#else
+#define PARTICLE_LANES 1
+#endif
+
+static_assert(PARTICLE_MAX_COUNT <= PARTICLE_TERRAIN_MAX_QUERIES, "one terrain probe per particle must fit a batch");
+static_assert(PARTICLE_MAX_COUNT <= PARTICLE_CELLS_MAX, "every moving particle must fit the collision cells");
+static_assert(PARTICLE_TASK_SIZE % PARTICLE_LANES == 0, "integration tasks must cover whole lane blocks");
+
+static inline Vec3 vec3_array_get(const ParticleVec3Array *a, int32_t i) {
+    return vec3_create(a->x[i], a->y[i], a->z[i]);
+}
+
+static inline void vec3_array_set(ParticleVec3Array *a, int32_t i, Vec3 v) {
+    a->x[i] = v.x;
+    a->y[i] = v.y;
+    a->z[i] = v.z;
+}
+
 ParticleSystem* particle_system_create(Bounds3D bounds) {
     ParticleSystem* sys = (ParticleSystem*)calloc(1, sizeof(ParticleSystem));
     if (!sys) return NULL;
@@ -17,10 +43,11 @@ ParticleSystem* particle_system_create(Bounds3D bounds) {
     sys->restitution = 0.45f;
     sys->floor_friction = 0.88f;
     sys->enable_particle_collision = true;
+    memset(sys->state, PARTICLE_INACTIVE, sizeof(sys->state));
+    particle_terrain_init(&sys->terrain_queries);
 
-    /* Cell size = 4x typical particle radius to reduce multi-cell spans */
-    float cell_size = 0.25f;
-    spatial_hash_init(&sys->collision_grid, cell_size, bounds);
+    /* Cells of at least twice a typical particle radius; they grow for larger particles */
+    particle_cells_init(&sys->collision_cells, 0.1f);
 
     return sys;
 }
@@ -30,129 +57,224 @@ void particle_system_destroy(ParticleSystem* sys) {
 }
 
 void particle_system_clear(ParticleSystem* sys) {
+    for (int32_t l = 0; l < PARTICLE_LIST_COUNT; l++) {
+        ParticleIndexList* list = &sys->lists[l];
+        for (int32_t k = 0; k < list->count; k++) {
+            sys->state[list->slots[k]] = PARTICLE_INACTIVE;
+        }
+        list->count = 0;
+    }
     sys->count = 0;
     sys->next_slot = 0;
     sys->active_count = 0;
+    sys->update_cursor = 0;
+}
+
+void particle_system_set_lod(ParticleSystem* sys, PhysicsSimLod *lod) {
+    sys->lod = lod;
+}
+
+void particle_system_set_workers(ParticleSystem* sys, struct PhysicsWorkers* workers) {
+    sys->workers = workers;
+}
+
+static inline int32_t task_count(int32_t count, int32_t per_task) {
+    return (count + per_task - 1) / per_task;
 }
 
-Particle* particle_system_add_slot(ParticleSystem* sys) {
-    uint32_t slot = sys->next_slot;
+int32_t particle_system_add_slot(ParticleSystem* sys) {
+    int32_t slot = sys->next_slot;
     sys->next_slot = (sys->next_slot + 1) % PARTICLE_MAX_COUNT;
     if (sys->count < PARTICLE_MAX_COUNT) {
         sys->count++;
     }
-    return &sys->particles[slot];
+    return slot;
 }
 
-int32_t particle_system_add(ParticleSystem* sys, RngState *rng, Vec3 position, Vec3 velocity, Vec3 color, float radius) {
-    Particle* p = particle_system_add_slot(sys);
-    /* active_count tracking:
-     * - If slot was inactive, we're adding a new particle: increment
-     * - If slot was active (at capacity, overwriting oldest): no change */
-    if (!p->active) sys->active_count++;
-    p->position = position;
-    p->prev_position = position;
-    p->velocity = velocity;
-    p->rotation = vec3_zero();
-    p->prev_rotation = vec3_zero();
-    p->angular_velocity = vec3_create(
+static Vec3 random_spin(RngState *rng) {
+    return vec3_create(
         rng_signed_half(rng) * 20.0f,
         rng_signed_half(rng) * 20.0f,
         rng_signed_half(rng) * 20.0f
     );
-    p->color = color;
-    p->radius = radius;
-    p->lifetime = 0.0f;
-    p->active = true;
-    p->settled = false;
-    return (int32_t)(p - sys->particles);
 }
 
-static Vec3 estimate_terrain_normal(const VoxelVolume *vol, Vec3 pos, float vs) {
+/* Moves a slot between state lists: swap-remove from the old, append to the new */
+static void particle_set_state(ParticleSystem* sys, int32_t i, ParticleState state) {
+    ParticleState old = (ParticleState)sys->state[i];
+    if (old == state) return;
+
+    if (old != PARTICLE_INACTIVE) {
+        ParticleIndexList* list = &sys->lists[old];
+        int32_t last = list->slots[--list->count];
+        list->slots[sys->list_index[i]] = last;
+        sys->list_index[last] = sys->list_index[i];
+        sys->active_count--;
+    }
+    if (state != PARTICLE_INACTIVE) {
+        ParticleIndexList* list = &sys->lists[state];
+        sys->list_index[i] = list->count;
+        list->slots[list->count++] = i;
+        sys->active_count++;
+    }
+    sys->state[i] = (uint8_t)state;
+}
+
+static inline float particle_age(const ParticleSystem* sys, int32_t i) {
+    return (float)(sys->time - sys->spawn_time[i]);
+}
+
+/* Writes a fresh particle into a claimed slot */
+static void particle_store(ParticleSystem* sys, int32_t slot, Vec3 position, Vec3 velocity,
+                           Vec3 angular_velocity, Vec3 color, float radius) {
+    /* At capacity this overwrites the oldest particle, whatever its state */
+    particle_set_state(sys, slot, PARTICLE_YOUNG);
+    vec3_array_set(&sys->position, slot, position);
+    vec3_array_set(&sys->prev_position, slot, position);
+    vec3_array_set(&sys->velocity, slot, velocity);
+    vec3_array_set(&sys->rotation, slot, vec3_zero());
+    vec3_array_set(&sys->angular_velocity, slot, angular_velocity);
+    sys->color[slot] = color;
+    sys->radius[slot] = radius;
+    sys->spawn_time[slot] = sys->time;
+    if (sys->time < sys->young_spawn_min) sys->young_spawn_min = sys->time;
+    sys->lod_pending[slot] = 0;
+    sys->material[slot] = 0;
+}
+
+int32_t particle_system_add(ParticleSystem* sys, RngState *rng, Vec3 position, Vec3 velocity, Vec3 color, float radius) {
+    int32_t slot = particle_system_add_slot(sys);
+    particle_store(sys, slot, position, velocity, random_spin(rng), color, radius);
+    return slot;
+}
+
+Particle particle_system_get(const ParticleSystem* sys, int32_t index) {
+    Particle p;
+    p.position = vec3_array_get(&sys->position, index);
+    p.prev_position = vec3_array_get(&sys->prev_position, index);
+    p.velocity = vec3_array_get(&sys->velocity, index);
+    p.rotation = vec3_array_get(&sys->rotation, index);
+    p.angular_velocity = vec3_array_get(&sys->angular_velocity, index);
+    p.color = sys->color[index];
+    p.radius = sys->radius[index];
+    p.lifetime = particle_age(sys, index);
+    p.active = sys->state[index] != PARTICLE_INACTIVE;
+    p.settled = sys->state[index] == PARTICLE_SETTLED;
+    return p;
+}
+
+/* Normal from which of a voxel's six neighbours are open */
+static Vec3 estimate_terrain_normal(const ParticleTerrain *pt, const VoxelVolume *vol, const int32_t v[3]) {
     Vec3 n = vec3_zero();
-    if (!volume_is_solid_at(vol, vec3_add(pos, vec3_create(vs, 0.0f, 0.0f))))  n.x += 1.0f;
-    if (!volume_is_solid_at(vol, vec3_add(pos, vec3_create(-vs, 0.0f, 0.0f)))) n.x -= 1.0f;
-    if (!volume_is_solid_at(vol, vec3_add(pos, vec3_create(0.0f, vs, 0.0f))))  n.y += 1.0f;
-    if (!volume_is_solid_at(vol, vec3_add(pos, vec3_create(0.0f, -vs, 0.0f)))) n.y -= 1.0f;
-    if (!volume_is_solid_at(vol, vec3_add(pos, vec3_create(0.0f, 0.0f, vs))))  n.z += 1.0f;
-    if (!volume_is_solid_at(vol, vec3_add(pos, vec3_create(0.0f, 0.0f, -vs)))) n.z -= 1.0f;
+    if (!particle_terrain_voxel_peek(pt, vol, v[0] + 1, v[1], v[2])) n.x += 1.0f;
+    if (!particle_terrain_voxel_peek(pt, vol, v[0] - 1, v[1], v[2])) n.x -= 1.0f;
+    if (!particle_terrain_voxel_peek(pt, vol, v[0], v[1] + 1, v[2])) n.y += 1.0f;
+    if (!particle_terrain_voxel_peek(pt, vol, v[0], v[1] - 1, v[2])) n.y -= 1.0f;
+    if (!particle_terrain_voxel_peek(pt, vol, v[0], v[1], v[2] + 1)) n.z += 1.0f;
+    if (!particle_terrain_voxel_peek(pt, vol, v[0], v[1], v[2] - 1)) n.z -= 1.0f;
     float len = vec3_length(n);
     return len > 0.001f ? vec3_scale(n, 1.0f / len) : vec3_create(0.0f, 1.0f, 0.0f);
 }
 
-static void resolve_particle_terrain(Particle *p,
-                                     const VoxelVolume *vol,
-                                     const VoxelObjectWorld *objects,
-                                     float restitution, float friction) {
-    bool hit_terrain = vol && volume_is_solid_at(vol, p->position);
-    bool hit_object = false;
-    Vec3 normal = vec3_create(0.0f, 1.0f, 0.0f);
+/* Moves a particle back to prev_position and reflects its velocity off the contact */
+static void bounce_particle(ParticleSystem* sys, int32_t i, Vec3 normal, float restitution, float friction) {
+    vec3_array_set(&sys->position, i, vec3_array_get(&sys->prev_position, i));
 
-    if (!hit_terrain && objects)
+    Vec3 velocity = vec3_array_get(&sys->velocity, i);
+    float vn = vec3_dot(velocity, normal);
+    if (vn < 0.0f)
     {
-        VoxelObjectPointTest test = voxel_object_world_test_point(objects, p->position);
-        if (test.hit)
-        {
-            hit_object = true;
-            normal = test.surface_normal;
-        }
+        velocity = vec3_sub(velocity,
+                            vec3_scale(normal, (1.0f + restitution) * vn));
     }
 
-    if (!hit_terrain && !hit_object)
-        return;
+    /* Surface friction on tangential component */
+    float vn_after = vec3_dot(velocity, normal);
+    Vec3 normal_component = vec3_scale(normal, vn_after);
+    Vec3 tangent_vel = vec3_sub(velocity, normal_component);
+    vec3_array_set(&sys->velocity, i, vec3_add(normal_component, vec3_scale(tangent_vel, friction)));
+}
+
+/*
+ * Terrain contact for a particle whose new position probed solid. Only
+ * reads the terrain queries, so it runs on worker threads. Returns true
+ * when the particle is stuck in solid and should be removed.
+ */
+static bool resolve_particle_terrain(ParticleSystem* sys, int32_t i, const VoxelVolume *vol,
+                                     float restitution, float friction) {
+    const ParticleTerrain *pt = &sys->terrain_queries;
+    int32_t voxel[3];
+    Vec3 prev_position = vec3_array_get(&sys->prev_position, i);
 
     /* If prev_position is also solid, push upward to escape embedded geometry */
-    if (hit_terrain && vol && volume_is_solid_at(vol, p->prev_position))
+    if (particle_terrain_point_peek(pt, vol, prev_position, voxel))
     {
         float vs = vol->voxel_size;
-        Vec3 escape = p->prev_position;
-        for (int32_t push = 0; push < 5; push++)
+        Vec3 escape = prev_position;
+        for (int32_t push = 1; push <= 5; push++)
         {
             escape.y += vs;
-            if (!volume_is_solid_at(vol, escape))
+            if (!particle_terrain_voxel_peek(pt, vol, voxel[0], voxel[1] + push, voxel[2]))
             {
-                p->position = escape;
-                p->velocity.y = fabsf(p->velocity.y) * 0.3f;
-                return;
+                vec3_array_set(&sys->position, i, escape);
+                sys->velocity.y[i] = fabsf(sys->velocity.y[i]) * 0.3f;
+                return false;
             }
         }
-        p->active = false;
-        return;
+        return true;
     }
 
-    p->position = p->prev_position;
+    bounce_particle(sys, i, estimate_terrain_normal(pt, vol, voxel), restitution, friction);
+    return false;
+}
 
-    if (hit_terrain && vol)
-        normal = estimate_terrain_normal(vol, p->position, vol->voxel_size);
+/* Contact with a voxel object for a particle clear of terrain */
+static void resolve_particle_object(ParticleSystem* sys, int32_t i, const VoxelObjectWorld *objects,
+                                    float restitution, float friction) {
+    VoxelObjectPointTest test = voxel_object_world_test_point(objects, vec3_array_get(&sys->position, i));
+    if (test.hit)
+        bounce_particle(sys, i, test.surface_normal, restitution, friction);
+}
 
-    float vn = vec3_dot(p->velocity, normal);
-    if (vn < 0.0f)
-    {
-        p->velocity = vec3_sub(p->velocity,
-                               vec3_scale(normal, (1.0f + restitution) * vn));
+/*
+ * Queues one probe per listed particle, just below it, and answers them
+ * together: terrain_queries.solid[k] is the answer for slots[k].
+ */
+static void probe_below(ParticleSystem* sys, const int32_t* slots, int32_t count, const VoxelVolume *terrain,
+                        float gap) {
+    ParticleTerrain *pt = &sys->terrain_queries;
+    if (!terrain) {
+        memset(pt->solid, 0, (size_t)count);
+        return;
     }
 
-    /* Surface friction on tangential component */
-    float vn_after = vec3_dot(p->velocity, normal);
-    Vec3 normal_component = vec3_scale(normal, vn_after);
-    Vec3 tangent_vel = vec3_sub(p->velocity, normal_component);
-    p->velocity = vec3_add(normal_component, vec3_scale(tangent_vel, friction));
+    particle_terrain_begin(pt);
+    for (int32_t k = 0; k < count; k++) {
+        int32_t i = slots[k];
+        particle_terrain_push(pt, sys->position.x[i], sys->position.y[i] + (-sys->radius[i] - gap),
+                              sys->position.z[i]);
+    }
+    particle_terrain_solve(pt, terrain);
 }
 
-static void resolve_particle_collision(Particle* a, Particle* b, float restitution) {
-    Vec3 delta = vec3_sub(b->position, a->position);
+static void resolve_particle_collision(ParticleSystem* sys, int32_t a, int32_t b, float restitution) {
+    Vec3 pos_a = vec3_array_get(&sys->position, a);
+    Vec3 pos_b = vec3_array_get(&sys->position, b);
+    Vec3 delta = vec3_sub(pos_b, pos_a);
     float dist = vec3_length(delta);
-    float min_dist = a->radius + b->radius;
+    float min_dist = sys->radius[a] + sys->radius[b];
 
     if (dist >= min_dist || dist < 0.0001f) return;
 
     Vec3 normal = vec3_scale(delta, 1.0f / dist);
     float overlap = min_dist - dist;
 
-    a->position = vec3_sub(a->position, vec3_scale(normal, overlap * 0.5f));
-    b->position = vec3_add(b->position, vec3_scale(normal, overlap * 0.5f));
+    vec3_array_set(&sys->position, a, vec3_sub(pos_a, vec3_scale(normal, overlap * 0.5f)));
+    vec3_array_set(&sys->position, b, vec3_add(pos_b, vec3_scale(normal, overlap * 0.5f)));
 
-    Vec3 rel_vel = vec3_sub(a->velocity, b->velocity);
+    Vec3 vel_a = vec3_array_get(&sys->velocity, a);
+    Vec3 vel_b = vec3_array_get(&sys->velocity, b);
+    Vec3 rel_vel = vec3_sub(vel_a, vel_b);
     float vel_along_normal = vec3_dot(rel_vel, normal);
 
     if (vel_along_normal > 0.0f) return;
@@ -160,167 +282,576 @@ static void resolve_particle_collision(Particle* a, Particle* b, float restituti
     float j = -(1.0f + restitution) * vel_along_normal * 0.5f;
     Vec3 impulse = vec3_scale(normal, j);
 
-    a->velocity = vec3_add(a->velocity, impulse);
-    b->velocity = vec3_sub(b->velocity, impulse);
+    vec3_array_set(&sys->velocity, a, vec3_add(vel_a, impulse));
+    vec3_array_set(&sys->velocity, b, vec3_sub(vel_b, impulse));
 }
 
-void particle_system_update(ParticleSystem* sys, float dt,
-                            const VoxelVolume *terrain,
-                            const VoxelObjectWorld *objects) {
-    /* No compaction needed - circular buffer overwrites oldest particles when at capacity */
+static void collide_pair(int32_t a, int32_t b, void *user_data) {
+    ParticleSystem* sys = (ParticleSystem*)user_data;
+    resolve_particle_collision(sys, a, b, sys->restitution);
+}
 
-    /* Safe max velocity to prevent tunneling (based on typical particle radius) */
-    float max_velocity = 0.03f / dt;
-    if (max_velocity < 10.0f) max_velocity = 10.0f;
-    if (max_velocity > 30.0f) max_velocity = 30.0f;
+/*
+ * Integration split into tasks of PARTICLE_TASK_SIZE slots. Each task also
+ * picks which of its slots update this tick, so scheduling costs no pass of
+ * its own: the slots it integrates go to updated[] and the young ones that
+ * aged out to aged[], both from the task's first slot on, and are packed
+ * in task order afterwards.
+ */
+#define PARTICLE_INTEGRATE_TASKS (PARTICLE_ARRAY_SIZE / PARTICLE_TASK_SIZE + 1)
+
+typedef struct {
+    int32_t first;   /* Task's first slot: its entries in updated[] and aged[] start here */
+    int32_t updated;
+    int32_t aged;
+    double young_spawn_min; /* Earliest spawn among the young particles that did not age out */
+    int32_t lod_updates[PHYS_LOD_LEVELS];
+    int32_t lod_deferred;
+} IntegrateTask;
+
+typedef struct {
+    ParticleSystem* sys;
+    const VoxelVolume* terrain;
+    float dt;
+    float max_velocity;
+    int32_t count;        /* Slots covered */
+    int32_t awake_start;  /* Awake list entries [awake_start, awake_start + awake_budget) update, wrapping */
+    int32_t awake_budget;
+    int32_t awake_count;
+    bool check_age;       /* False when young_spawn_min shows no young particle can have aged out */
+    IntegrateTask tasks[PARTICLE_INTEGRATE_TASKS];
+} IntegrateJob;
+
+/*
+ * Which of slots i..i + lanes - 1 are up for an update this tick, bit l for
+ * slot i + l, given which are young and which awake: young particles every
+ * tick, awake ones when their awake list entry is inside the budget window.
+ * Young particles past the young age still update as young this tick and
+ * are moved to the awake list after it.
+ */
+static inline int32_t lanes_due(const IntegrateJob* job, IntegrateTask* task, int32_t i, int32_t lanes,
+                                int32_t young, int32_t awake) {
+    ParticleSystem* sys = job->sys;
+    if (young && job->check_age) {
+        for (int32_t l = 0; l < lanes; l++) {
+            if (!(young & (1 << l))) continue;
+            if (particle_age(sys, i + l) > PARTICLE_YOUNG_AGE_THRESHOLD)
+                sys->aged[task->first + task->aged++] = i + l;
+            else if (sys->spawn_time[i + l] < task->young_spawn_min)
+                task->young_spawn_min = sys->spawn_time[i + l];
+        }
+    }
 
-    /* Save previous positions for interpolation before updating physics */
-    for (int32_t i = 0; i < sys->count; i++) {
-        Particle* p = &sys->particles[i];
-        if (!p->active) continue;
-        p->prev_position = p->position;
-        p->prev_rotation = p->rotation;
+    if (awake && job->awake_budget < job->awake_count) {
+        for (int32_t l = 0; l < lanes; l++) {
+            int32_t entry = sys->list_index[i + l] - job->awake_start;
+            if (entry < 0) entry += job->awake_count;
+            if (entry >= job->awake_budget) awake &= ~(1 << l);
+        }
     }
+    return young | awake;
+}
 
-    /* Update lifetime for age tracking (used for young particle priority).
-     * No auto-expiration - particles are removed via circular buffer when at capacity. */
-    for (int32_t i = 0; i < sys->count; i++) {
-        Particle* p = &sys->particles[i];
-        if (!p->active) continue;
-        p->lifetime += dt;
+/* Step of a due slot under LOD, 0 when its level skips the tick; otherwise it covers the skipped ticks too */
+static float slot_lod_step(const IntegrateJob* job, IntegrateTask* task, int32_t i) {
+    ParticleSystem* sys = job->sys;
+    Vec3 position = vec3_array_get(&sys->position, i);
+    uint8_t level = physics_lod_level(sys->lod, position, sys->radius[i]);
+    if (!physics_lod_due(sys->lod_tick, i, level, sys->lod_pending[i])) {
+        sys->lod_pending[i]++;
+        task->lod_deferred++;
+        return 0.0f;
     }
+    float step_dt = job->dt * (float)(sys->lod_pending[i] + 1);
+    sys->lod_pending[i] = 0;
+    task->lod_updates[level]++;
+    return step_dt;
+}
 
-    /* Age-prioritized budgeted physics update:
-     * Pass 1: Always update young particles (fast-moving, need frequent updates)
-     * Pass 2: Use remaining budget for older particles (round-robin) */
-    int32_t budget = PARTICLE_MAX_UPDATES_PER_TICK;
-    int32_t processed = 0;
+/* Floor friction when the particle is just above a surface, -1 elsewhere */
+static float slot_friction(const IntegrateJob* job, int32_t i) {
+    const ParticleSystem* sys = job->sys;
+    Vec3 below = vec3_create(sys->position.x[i], sys->position.y[i] + (-sys->radius[i] - 0.05f), sys->position.z[i]);
+    return particle_terrain_point_peek(&sys->terrain_queries, job->terrain, below, NULL) ? sys->floor_friction : -1.0f;
+}
 
-    /* Pass 1: Young particles always get priority (unbounded - they're time-limited) */
-    for (int32_t i = 0; i < sys->count; i++) {
-        Particle* p = &sys->particles[i];
-        if (!p->active || p->settled) continue;
-        if (p->lifetime > PARTICLE_YOUNG_AGE_THRESHOLD) continue;
+/*
+ * Steps and friction of the due slots among i..i + lanes - 1 (bit l of due
+ * for slot i + l); a step of 0 means no update. Updated slots are listed.
+ */
+static inline void schedule_lanes(const IntegrateJob* job, IntegrateTask* task, int32_t i, int32_t lanes,
+                                  int32_t due, float* step_dt, float* friction) {
+    ParticleSystem* sys = job->sys;
+    int32_t* updated = &sys->updated[task->first];
+    int32_t count = task->updated;
+    for (int32_t l = 0; l < lanes; l++) {
+        float h = (due & (1 << l)) ? job->dt : 0.0f;
+        if (h > 0.0f && sys->lod) h = slot_lod_step(job, task, i + l);
+        step_dt[l] = h;
+        friction[l] = h > 0.0f && job->terrain ? slot_friction(job, i + l) : -1.0f;
+        updated[count] = i + l;
+        count += h > 0.0f;
+    }
+    task->updated = count;
+}
+
+static void integrate_range(const IntegrateJob* job, IntegrateTask* task, int32_t begin, int32_t end);
+
+static void integrate_task(int32_t t, void* ctx) {
+    IntegrateJob* job = (IntegrateJob*)ctx;
+    int32_t begin = t * PARTICLE_TASK_SIZE;
+    int32_t end = begin + PARTICLE_TASK_SIZE < job->count ? begin + PARTICLE_TASK_SIZE : job->count;
+    IntegrateTask* task = &job->tasks[t];
+    memset(task, 0, sizeof(*task));
+    task->first = begin;
+    task->young_spawn_min = job->sys->time;
+    integrate_range(job, task, begin, end);
+}
 
-        p->velocity = vec3_add(p->velocity, vec3_scale(sys->gravity, dt));
+#if PARTICLE_LANES > 1
+
+#if PARTICLE_LANES == 8
+typedef __m256 ParticleLanes;
+static inline ParticleLanes lanes_load(const float *p) { return _mm256_loadu_ps(p); }
+static inline void lanes_store(float *p, ParticleLanes v) { _mm256_storeu_ps(p, v); }
+static inline ParticleLanes lanes_set1(float f) { return _mm256_set1_ps(f); }
+static inline ParticleLanes lanes_add(ParticleLanes a, ParticleLanes b) { return _mm256_add_ps(a, b); }
+static inline ParticleLanes lanes_mul(ParticleLanes a, ParticleLanes b) { return _mm256_mul_ps(a, b); }
+static inline ParticleLanes lanes_div(ParticleLanes a, ParticleLanes b) { return _mm256_div_ps(a, b); }
+static inline ParticleLanes lanes_sqrt(ParticleLanes a) { return _mm256_sqrt_ps(a); }
+static inline ParticleLanes lanes_gt(ParticleLanes a, ParticleLanes b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+static inline ParticleLanes lanes_ge(ParticleLanes a, ParticleLanes b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+static inline ParticleLanes lanes_select(ParticleLanes mask, ParticleLanes a, ParticleLanes b) { return _mm256_blendv_ps(b, a, mask); }
+static inline int lanes_any(ParticleLanes mask) { return _mm256_movemask_ps(mask); }
+/* All bits set in lane l when bit l of bits is */
+static inline ParticleLanes lanes_from_bits(int32_t bits) {
+    const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i set = _mm256_and_si256(_mm256_set1_epi32(bits), lane_bits);
+    return _mm256_castsi256_ps(_mm256_cmpeq_epi32(set, lane_bits));
+}
+/* Bit l set when bytes[l] == value */
+static inline int32_t lanes_bytes_equal(const uint8_t *bytes, uint8_t value) {
+    __m128i v = _mm_loadl_epi64((const __m128i *)bytes);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8((char)value))) & 0xFF;
+}
+#else
+typedef __m128 ParticleLanes;
+static inline ParticleLanes lanes_load(const float *p) { return _mm_loadu_ps(p); }
+static inline void lanes_store(float *p, ParticleLanes v) { _mm_storeu_ps(p, v); }
+static inline ParticleLanes lanes_set1(float f) { return _mm_set1_ps(f); }
+static inline ParticleLanes lanes_add(ParticleLanes a, ParticleLanes b) { return _mm_add_ps(a, b); }
+static inline ParticleLanes lanes_mul(ParticleLanes a, ParticleLanes b) { return _mm_mul_ps(a, b); }
+static inline ParticleLanes lanes_div(ParticleLanes a, ParticleLanes b) { return _mm_div_ps(a, b); }
+static inline ParticleLanes lanes_sqrt(ParticleLanes a) { return _mm_sqrt_ps(a); }
+static inline ParticleLanes lanes_gt(ParticleLanes a, ParticleLanes b) { return _mm_cmpgt_ps(a, b); }
+static inline ParticleLanes lanes_ge(ParticleLanes a, ParticleLanes b) { return _mm_cmpge_ps(a, b); }
+static inline ParticleLanes lanes_select(ParticleLanes mask, ParticleLanes a, ParticleLanes b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+static inline int lanes_any(ParticleLanes mask) { return _mm_movemask_ps(mask); }
+static inline ParticleLanes lanes_from_bits(int32_t bits) {
+    const __m128i lane_bits = _mm_setr_epi32(1, 2, 4, 8);
+    __m128i set = _mm_and_si128(_mm_set1_epi32(bits), lane_bits);
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(set, lane_bits));
+}
+static inline int32_t lanes_bytes_equal(const uint8_t *bytes, uint8_t value) {
+    int32_t word;
+    memcpy(&word, bytes, sizeof(word));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_cvtsi32_si128(word), _mm_set1_epi8((char)value))) & 0xF;
+}
+#endif
+
+/*
+ * One fused pass over whole lane blocks of slots [begin, end): saves the
+ * previous position and schedules each lane, then lanes with a step run
+ * gravity, speed clamp, damping, surface friction, integration and spin.
+ * Same operations in the same order as the scalar path, so results match
+ * it bit for bit.
+ */
+static void integrate_range(const IntegrateJob* job, IntegrateTask* task, int32_t begin, int32_t end) {
+    ParticleSystem* sys = job->sys;
+    float max_velocity = job->max_velocity;
+    const ParticleLanes zero = lanes_set1(0.0f);
+    const ParticleLanes one = lanes_set1(1.0f);
+    const ParticleLanes gx = lanes_set1(sys->gravity.x);
+    const ParticleLanes gy = lanes_set1(sys->gravity.y);
+    const ParticleLanes gz = lanes_set1(sys->gravity.z);
+    const ParticleLanes max_speed = lanes_set1(max_velocity);
+    const ParticleLanes max_speed_sq = lanes_set1(max_velocity * max_velocity);
+    const ParticleLanes damping = lanes_set1(sys->damping);
+    const ParticleLanes surface_spin = lanes_set1(0.9f);
+    const ParticleLanes spin_damping = lanes_set1(0.995f);
+    const ParticleLanes dt = lanes_set1(job->dt);
+    const ParticleLanes no_friction = lanes_set1(-1.0f);
+
+    for (int32_t i = begin; i < end; i += PARTICLE_LANES) {
+        ParticleLanes px = lanes_load(&sys->position.x[i]);
+        ParticleLanes py = lanes_load(&sys->position.y[i]);
+        ParticleLanes pz = lanes_load(&sys->position.z[i]);
+        lanes_store(&sys->prev_position.x[i], px);
+        lanes_store(&sys->prev_position.y[i], py);
+        lanes_store(&sys->prev_position.z[i], pz);
+
+        int32_t young = lanes_bytes_equal(&sys->state[i], PARTICLE_YOUNG);
+        int32_t awake = lanes_bytes_equal(&sys->state[i], PARTICLE_AWAKE);
+        int32_t due = young | awake ? lanes_due(job, task, i, PARTICLE_LANES, young, awake) : 0;
+        if (!due) continue;
+
+        ParticleLanes h, friction;
+        if (sys->lod || job->terrain) {
+            float step_dt[PARTICLE_LANES], step_friction[PARTICLE_LANES];
+            schedule_lanes(job, task, i, PARTICLE_LANES, due, step_dt, step_friction);
+            h = lanes_load(step_dt);
+            friction = lanes_load(step_friction);
+        } else {
+            /* Every due lane steps dt, with no surface to slow it */
+            int32_t* updated = &sys->updated[task->first];
+            int32_t count = task->updated;
+            for (int32_t l = 0; l < PARTICLE_LANES; l++) {
+                updated[count] = i + l;
+                count += (due >> l) & 1;
+            }
+            task->updated = count;
+            h = lanes_select(lanes_from_bits(due), dt, zero);
+            friction = no_friction;
+        }
+        ParticleLanes moving = lanes_gt(h, zero);
+        if (!lanes_any(moving)) continue;
+
+        ParticleLanes vx = lanes_add(lanes_load(&sys->velocity.x[i]), lanes_mul(gx, h));
+        ParticleLanes vy = lanes_add(lanes_load(&sys->velocity.y[i]), lanes_mul(gy, h));
+        ParticleLanes vz = lanes_add(lanes_load(&sys->velocity.z[i]), lanes_mul(gz, h));
+
+        ParticleLanes speed_sq = lanes_add(lanes_add(lanes_mul(vx, vx), lanes_mul(vy, vy)), lanes_mul(vz, vz));
+        ParticleLanes over = lanes_gt(speed_sq, max_speed_sq);
+        if (lanes_any(over)) {
+            ParticleLanes scale = lanes_select(over, lanes_div(max_speed, lanes_sqrt(speed_sq)), one);
+            vx = lanes_mul(vx, scale);
+            vy = lanes_mul(vy, scale);
+            vz = lanes_mul(vz, scale);
+        }
 
-        float speed_sq = vec3_length_sq(p->velocity);
-        if (speed_sq > max_velocity * max_velocity) {
-            float speed = sqrtf(speed_sq);
-            p->velocity = vec3_scale(p->velocity, max_velocity / speed);
+        vx = lanes_mul(vx, damping);
+        vy = lanes_mul(vy, damping);
+        vz = lanes_mul(vz, damping);
+
+        ParticleLanes wx = lanes_load(&sys->angular_velocity.x[i]);
+        ParticleLanes wy = lanes_load(&sys->angular_velocity.y[i]);
+        ParticleLanes wz = lanes_load(&sys->angular_velocity.z[i]);
+
+        ParticleLanes near_surface = lanes_ge(friction, zero);
+        if (lanes_any(near_surface)) {
+            vx = lanes_select(near_surface, lanes_mul(vx, friction), vx);
+            vz = lanes_select(near_surface, lanes_mul(vz, friction), vz);
+            ParticleLanes spin = lanes_select(near_surface, surface_spin, one);
+            wx = lanes_mul(wx, spin);
+            wy = lanes_mul(wy, spin);
+            wz = lanes_mul(wz, spin);
         }
 
-        p->velocity = vec3_scale(p->velocity, sys->damping);
+        lanes_store(&sys->position.x[i], lanes_select(moving, lanes_add(px, lanes_mul(vx, h)), px));
+        lanes_store(&sys->position.y[i], lanes_select(moving, lanes_add(py, lanes_mul(vy, h)), py));
+        lanes_store(&sys->position.z[i], lanes_select(moving, lanes_add(pz, lanes_mul(vz, h)), pz));
+
+        ParticleLanes rx = lanes_load(&sys->rotation.x[i]);
+        ParticleLanes ry = lanes_load(&sys->rotation.y[i]);
+        ParticleLanes rz = lanes_load(&sys->rotation.z[i]);
+        lanes_store(&sys->rotation.x[i], lanes_select(moving, lanes_add(rx, lanes_mul(wx, h)), rx));
+        lanes_store(&sys->rotation.y[i], lanes_select(moving, lanes_add(ry, lanes_mul(wy, h)), ry));
+        lanes_store(&sys->rotation.z[i], lanes_select(moving, lanes_add(rz, lanes_mul(wz, h)), rz));
+
+        lanes_store(&sys->velocity.x[i], lanes_select(moving, vx, lanes_load(&sys->velocity.x[i])));
+        lanes_store(&sys->velocity.y[i], lanes_select(moving, vy, lanes_load(&sys->velocity.y[i])));
+        lanes_store(&sys->velocity.z[i], lanes_select(moving, vz, lanes_load(&sys->velocity.z[i])));
+        lanes_store(&sys->angular_velocity.x[i],
+                    lanes_select(moving, lanes_mul(wx, spin_damping), lanes_load(&sys->angular_velocity.x[i])));
+        lanes_store(&sys->angular_velocity.y[i],
+                    lanes_select(moving, lanes_mul(wy, spin_damping), lanes_load(&sys->angular_velocity.y[i])));
+        lanes_store(&sys->angular_velocity.z[i],
+                    lanes_select(moving, lanes_mul(wz, spin_damping), lanes_load(&sys->angular_velocity.z[i])));
+    }
+}
 
-        /* Surface proximity friction: check if solid below particle */
-        bool near_surface = terrain &&
-            volume_is_solid_at(terrain, vec3_add(p->position, vec3_create(0.0f, -p->radius - 0.05f, 0.0f)));
-        if (near_surface) {
-            p->velocity.x *= sys->floor_friction;
-            p->velocity.z *= sys->floor_friction;
-            p->angular_velocity = vec3_scale(p->angular_velocity, 0.9f);
-        }
+#else
 
-        p->position = vec3_add(p->position, vec3_scale(p->velocity, dt));
-        p->rotation = vec3_add(p->rotation, vec3_scale(p->angular_velocity, dt));
-        p->angular_velocity = vec3_scale(p->angular_velocity, 0.995f);
+static void integrate_particle(ParticleSystem* sys, int32_t i, float h, float friction, float max_velocity) {
+    Vec3 velocity = vec3_add(vec3_array_get(&sys->velocity, i), vec3_scale(sys->gravity, h));
 
-        resolve_particle_terrain(p, terrain, objects, sys->restitution, sys->floor_friction);
+    float speed_sq = vec3_length_sq(velocity);
+    if (speed_sq > max_velocity * max_velocity) {
+        float speed = sqrtf(speed_sq);
+        velocity = vec3_scale(velocity, max_velocity / speed);
     }
 
-    /* Pass 2: Older particles with remaining budget (round-robin) */
-    int32_t cursor = sys->update_cursor;
-    int32_t checked = 0;
-    while (processed < budget && checked < sys->count) {
-        if (cursor >= sys->count) cursor = 0;
+    velocity = vec3_scale(velocity, sys->damping);
 
-        Particle* p = &sys->particles[cursor];
-        cursor++;
-        checked++;
+    Vec3 angular_velocity = vec3_array_get(&sys->angular_velocity, i);
+    if (friction >= 0.0f) {
+        velocity.x *= friction;
+        velocity.z *= friction;
+        angular_velocity = vec3_scale(angular_velocity, 0.9f);
+    }
 
-        /* Skip inactive, settled, or young (already processed) */
-        if (!p->active || p->settled || p->lifetime <= PARTICLE_YOUNG_AGE_THRESHOLD) continue;
+    vec3_array_set(&sys->position, i, vec3_add(vec3_array_get(&sys->position, i), vec3_scale(velocity, h)));
+    vec3_array_set(&sys->rotation, i, vec3_add(vec3_array_get(&sys->rotation, i), vec3_scale(angular_velocity, h)));
+    vec3_array_set(&sys->velocity, i, velocity);
+    vec3_array_set(&sys->angular_velocity, i, vec3_scale(angular_velocity, 0.995f));
+}
 
-        p->velocity = vec3_add(p->velocity, vec3_scale(sys->gravity, dt));
+/* Slots [begin, end): previous position saved for interpolation, then scheduled and integrated */
+static void integrate_range(const IntegrateJob* job, IntegrateTask* task, int32_t begin, int32_t end) {
+    ParticleSystem* sys = job->sys;
+    for (int32_t i = begin; i < end; i++) {
+        vec3_array_set(&sys->prev_position, i, vec3_array_get(&sys->position, i));
+        int32_t young = sys->state[i] == PARTICLE_YOUNG;
+        int32_t awake = sys->state[i] == PARTICLE_AWAKE;
+        if (!lanes_due(job, task, i, 1, young, awake)) continue;
+        float h, friction;
+        schedule_lanes(job, task, i, 1, 1, &h, &friction);
+        if (h > 0.0f) integrate_particle(sys, i, h, friction, job->max_velocity);
+    }
+}
 
-        float speed_sq = vec3_length_sq(p->velocity);
-        if (speed_sq > max_velocity * max_velocity) {
-            float speed = sqrtf(speed_sq);
-            p->velocity = vec3_scale(p->velocity, max_velocity / speed);
+#endif
+
+/*
+ * Schedules and integrates every slot in one pass, then packs the tasks'
+ * updated entries in slot order and moves aged young particles to the
+ * awake list. The awake budget takes the next PARTICLE_MAX_UPDATES_PER_TICK
+ * awake list entries round-robin; entries whose LOD level skips the tick
+ * still count against it.
+ */
+static void integrate_particles(ParticleSystem* sys, float dt, float max_velocity, const VoxelVolume* terrain) {
+    IntegrateJob job;
+    const ParticleIndexList* awake = &sys->lists[PARTICLE_AWAKE];
+    job.sys = sys;
+    job.terrain = terrain;
+    job.dt = dt;
+    job.max_velocity = max_velocity;
+    job.count = (sys->count + PARTICLE_LANES - 1) / PARTICLE_LANES * PARTICLE_LANES;
+    job.awake_count = awake->count;
+    job.check_age = (float)(sys->time - sys->young_spawn_min) > PARTICLE_YOUNG_AGE_THRESHOLD;
+    job.awake_budget = awake->count < PARTICLE_MAX_UPDATES_PER_TICK ? awake->count : PARTICLE_MAX_UPDATES_PER_TICK;
+    job.awake_start = sys->update_cursor < awake->count ? sys->update_cursor : 0;
+    sys->update_cursor = awake->count > 0 ? (job.awake_start + job.awake_budget) % awake->count : 0;
+
+    int32_t tasks = task_count(job.count, PARTICLE_TASK_SIZE);
+    physics_workers_run(sys->workers, tasks, integrate_task, &job);
+
+    int32_t updated = 0;
+    if (job.check_age) sys->young_spawn_min = sys->time;
+    for (int32_t t = 0; t < tasks; t++) {
+        const IntegrateTask* task = &job.tasks[t];
+        if (job.check_age && task->young_spawn_min < sys->young_spawn_min) sys->young_spawn_min = task->young_spawn_min;
+        memmove(&sys->updated[updated], &sys->updated[task->first], sizeof(int32_t) * (size_t)task->updated);
+        updated += task->updated;
+        for (int32_t k = 0; k < task->aged; k++) {
+            particle_set_state(sys, sys->aged[task->first + k], PARTICLE_AWAKE);
         }
-
-        p->velocity = vec3_scale(p->velocity, sys->damping);
-
-        bool near_surface = terrain &&
-            volume_is_solid_at(terrain, vec3_add(p->position, vec3_create(0.0f, -p->radius - 0.05f, 0.0f)));
-        if (near_surface) {
-            p->velocity.x *= sys->floor_friction;
-            p->velocity.z *= sys->floor_friction;
-            p->angular_velocity = vec3_scale(p->angular_velocity, 0.9f);
+        if (sys->lod) {
+            for (int32_t level = 0; level < PHYS_LOD_LEVELS; level++) {
+                sys->lod->particle_updates[level] += task->lod_updates[level];
+            }
+            sys->lod->particle_deferred += task->lod_deferred;
         }
+    }
+    sys->updated_count = updated;
+}
+
+/* Contacts of the updated list; probe k answered in terrain_queries.solid[k] */
+typedef struct {
+    ParticleSystem* sys;
+    const VoxelVolume* terrain;
+    const VoxelObjectWorld* objects;
+} ContactJob;
+
+static void contact_task(int32_t task, void* ctx) {
+    const ContactJob* job = (const ContactJob*)ctx;
+    ParticleSystem* sys = job->sys;
+    int32_t begin = task * PARTICLE_TASK_SIZE;
+    int32_t end = begin + PARTICLE_TASK_SIZE < sys->updated_count ? begin + PARTICLE_TASK_SIZE : sys->updated_count;
+    for (int32_t k = begin; k < end; k++) {
+        int32_t i = sys->updated[k];
+        sys->outcome[k] = 0;
+        if (job->terrain && sys->terrain_queries.solid[k])
+            sys->outcome[k] = resolve_particle_terrain(sys, i, job->terrain, sys->restitution, sys->floor_friction);
+        else if (job->objects)
+            resolve_particle_object(sys, i, job->objects, sys->restitution, sys->floor_friction);
+    }
+}
 
-        p->position = vec3_add(p->position, vec3_scale(p->velocity, dt));
-        p->rotation = vec3_add(p->rotation, vec3_scale(p->angular_velocity, dt));
-        p->angular_velocity = vec3_scale(p->angular_velocity, 0.995f);
+/* Particle contacts of one colour's cells, PARTICLE_TASK_CELLS per task */
+typedef struct {
+    ParticleSystem* sys;
+    int32_t first;
+    int32_t last;
+    int32_t pairs[PARTICLE_CELLS_MAX / PARTICLE_TASK_CELLS + 1];
+} CollisionJob;
+
+static void collision_task(int32_t task, void* ctx) {
+    CollisionJob* job = (CollisionJob*)ctx;
+    int32_t first = job->first + task * PARTICLE_TASK_CELLS;
+    int32_t last = first + PARTICLE_TASK_CELLS < job->last ? first + PARTICLE_TASK_CELLS : job->last;
+    job->pairs[task] = particle_cells_sweep_cells(&job->sys->collision_cells, first, last, collide_pair, job->sys);
+}
 
-        resolve_particle_terrain(p, terrain, objects, sys->restitution, sys->floor_friction);
-        processed++;
+/* Settle decisions for a state list; probe k answered in terrain_queries.solid[k] */
+typedef struct {
+    ParticleSystem* sys;
+    const ParticleIndexList* list;
+} SettleJob;
+
+static void settle_task(int32_t task, void* ctx) {
+    const SettleJob* job = (const SettleJob*)ctx;
+    ParticleSystem* sys = job->sys;
+    int32_t begin = task * PARTICLE_TASK_SIZE;
+    int32_t end = begin + PARTICLE_TASK_SIZE < job->list->count ? begin + PARTICLE_TASK_SIZE : job->list->count;
+    for (int32_t k = begin; k < end; k++) {
+        int32_t i = job->list->slots[k];
+        sys->outcome[k] = sys->terrain_queries.solid[k] &&
+                          vec3_length(vec3_array_get(&sys->velocity, i)) < PARTICLE_SETTLE_VELOCITY;
     }
-    sys->update_cursor = cursor;
+}
 
-    /* Spatial hash collision: O(n) average, bounded by pair budget */
-    if (sys->enable_particle_collision) {
-        spatial_hash_clear(&sys->collision_grid);
+void particle_system_update(ParticleSystem* sys, float dt,
+                            const VoxelVolume *terrain,
+                            const VoxelObjectWorld *objects) {
+    /* No compaction needed - circular buffer overwrites oldest particles when at capacity */
 
-        /* Insert active non-settled particles into grid */
-        for (int32_t i = 0; i < sys->count; i++) {
-            if (!sys->particles[i].active || sys->particles[i].settled) continue;
-            spatial_hash_insert(&sys->collision_grid, i,
-                               sys->particles[i].position, sys->particles[i].radius);
-        }
+    /* Safe max velocity to prevent tunneling (based on typical particle radius) */
+    float max_velocity = 0.03f / dt;
+    if (max_velocity < 10.0f) max_velocity = 10.0f;
+    if (max_velocity > 30.0f) max_velocity = 30.0f;
+
+    if (sys->lod) {
+        sys->lod_tick++;
+        memset(sys->lod->particle_updates, 0, sizeof(sys->lod->particle_updates));
+        sys->lod->particle_deferred = 0;
+    }
 
-        /* Check collisions using spatial hash (capped to prevent frame spikes) */
-        int32_t pair_budget = PARTICLE_MAX_COLLISION_PAIRS;
-        for (int32_t i = 0; i < sys->count && pair_budget > 0; i++) {
-            if (!sys->particles[i].active || sys->particles[i].settled) continue;
+    /* No auto-expiration - particles are removed via circular buffer when at capacity */
+    sys->time += dt;
+    sys->tick++;
 
-            int32_t nearby[SPATIAL_HASH_MAX_PER_CELL];
-            int32_t nearby_count = spatial_hash_query(&sys->collision_grid,
-                sys->particles[i].position, sys->particles[i].radius * 2.0f,
-                nearby, SPATIAL_HASH_MAX_PER_CELL);
+    integrate_particles(sys, dt, max_velocity, terrain);
 
-            for (int32_t n = 0; n < nearby_count && pair_budget > 0; n++) {
-                int32_t j = nearby[n];
-                if (j <= i) continue;
-                if (!sys->particles[j].active || sys->particles[j].settled) continue;
+    /* Terrain first, as one batch at the new positions; objects only where terrain is clear */
+    if (terrain || objects) {
+        ParticleTerrain *pt = &sys->terrain_queries;
+        particle_terrain_begin(pt);
+        for (int32_t k = 0; terrain && k < sys->updated_count; k++) {
+            int32_t i = sys->updated[k];
+            particle_terrain_push(pt, sys->position.x[i], sys->position.y[i], sys->position.z[i]);
+        }
+        particle_terrain_solve(pt, terrain);
 
-                resolve_particle_collision(&sys->particles[i], &sys->particles[j], sys->restitution);
-                pair_budget--;
-            }
+        ContactJob job = {sys, terrain, objects};
+        physics_workers_run(sys->workers, task_count(sys->updated_count, PARTICLE_TASK_SIZE), contact_task, &job);
+        for (int32_t k = 0; k < sys->updated_count; k++) {
+            if (sys->outcome[k]) particle_set_state(sys, sys->updated[k], PARTICLE_INACTIVE);
         }
     }
 
-    for (int32_t i = 0; i < sys->count; i++) {
-        Particle* p = &sys->particles[i];
-        if (!p->active) continue;
+    if (sys->lod) {
+        PROFILE_COUNTER_SET(PROFILE_COUNTER_LOD_PARTICLE_FULL, sys->lod->particle_updates[0]);
+        PROFILE_COUNTER_SET(PROFILE_COUNTER_LOD_PARTICLE_HALF, sys->lod->particle_updates[1]);
+        PROFILE_COUNTER_SET(PROFILE_COUNTER_LOD_PARTICLE_QUARTER, sys->lod->particle_updates[2]);
+        PROFILE_COUNTER_SET(PROFILE_COUNTER_LOD_PARTICLE_DEFERRED, sys->lod->particle_deferred);
+    }
 
-        bool near_surface = terrain &&
-            volume_is_solid_at(terrain, vec3_add(p->position, vec3_create(0.0f, -p->radius - 0.02f, 0.0f)));
+    /* Particle-particle contacts: moving particles sorted into cells, every overlapping pair resolved */
+    if (sys->enable_particle_collision) {
+        int32_t moving = 0;
+        for (int32_t l = PARTICLE_YOUNG; l <= PARTICLE_AWAKE; l++) {
+            const ParticleIndexList* list = &sys->lists[l];
+            memcpy(&sys->collision_slots[moving], list->slots, sizeof(int32_t) * (size_t)list->count);
+            moving += list->count;
+        }
 
-        if (p->settled) {
-            if (!near_surface) {
-                p->settled = false;
-                p->velocity = vec3_scale(sys->gravity, 0.01f);
-            }
-            continue;
+        particle_cells_build(&sys->collision_cells, sys->collision_slots, moving,
+                             sys->position.x, sys->position.y, sys->position.z, sys->radius);
+
+        /* Colour by colour: cells of one colour share no particles, so their tasks may run concurrently */
+        CollisionJob job;
+        job.sys = sys;
+        sys->collision_pairs = 0;
+        for (int32_t color = 0; color < PARTICLE_CELLS_COLORS; color++) {
+            job.first = sys->collision_cells.color_start[color];
+            job.last = sys->collision_cells.color_start[color + 1];
+            int32_t tasks = task_count(job.last - job.first, PARTICLE_TASK_CELLS);
+            physics_workers_run(sys->workers, tasks, collision_task, &job);
+            for (int32_t t = 0; t < tasks; t++) sys->collision_pairs += job.pairs[t];
         }
+    }
 
-        float speed = vec3_length(p->velocity);
-        if (speed < PARTICLE_SETTLE_VELOCITY && near_surface) {
-            p->settled = true;
-            p->velocity = vec3_zero();
+    /* Settle slow particles resting on a surface. Lists are walked backwards
+     * so a particle changing state is swap-removed behind the walk, leaving
+     * slots[k] (and so its outcome) in place for every k still ahead. */
+    for (int32_t l = PARTICLE_YOUNG; l <= PARTICLE_AWAKE; l++) {
+        const ParticleIndexList* list = &sys->lists[l];
+        probe_below(sys, list->slots, list->count, terrain, 0.02f);
+        SettleJob job = {sys, list};
+        physics_workers_run(sys->workers, task_count(list->count, PARTICLE_TASK_SIZE), settle_task, &job);
+        for (int32_t k = list->count - 1; k >= 0; k--) {
+            int32_t i = list->slots[k];
+            if (sys->outcome[k]) {
+                particle_set_state(sys, i, PARTICLE_SETTLED);
+                vec3_array_set(&sys->velocity, i, vec3_zero());
+                sys->settled_tick[i] = sys->tick;
+            }
         }
     }
+
+    /* Wake settled particles whose support is gone. Particles settle only
+     * where the check would pass, so it is needed only after terrain edits. */
+    if (terrain && terrain == sys->support_terrain && terrain->version_counter == sys->support_version) return;
+    sys->support_terrain = terrain;
+    sys->support_version = terrain ? terrain->version_counter : 0;
+
+    const ParticleIndexList* settled = &sys->lists[PARTICLE_SETTLED];
+    probe_below(sys, settled->slots, settled->count, terrain, 0.02f);
+    for (int32_t k = settled->count - 1; k >= 0; k--) {
+        int32_t i = settled->slots[k];
+        if (sys->terrain_queries.solid[k]) continue;
+
+        bool young = particle_age(sys, i) <= PARTICLE_YOUNG_AGE_THRESHOLD;
+        particle_set_state(sys, i, young ? PARTICLE_YOUNG : PARTICLE_AWAKE);
+        if (young && sys->spawn_time[i] < sys->young_spawn_min) sys->young_spawn_min = sys->spawn_time[i];
+        vec3_array_set(&sys->velocity, i, vec3_scale(sys->gravity, 0.01f));
+    }
+}
+
+/* One explosion particle drawn from rng; the radius is drawn last */
+static void explosion_particle(RngState *rng, Vec3 center, float radius, Vec3 color, float force,
+                               Vec3* out_position, Vec3* out_velocity, Vec3* out_spin, Vec3* out_color,
+                               float* out_radius) {
+    float theta = rng_float(rng) * 2.0f * K_PI;
+    float phi = rng_float(rng) * K_PI;
+    float r = rng_float(rng) * radius * 0.8f;
+
+    float sin_phi = sinf(phi);
+    Vec3 offset = vec3_create(
+        r * sin_phi * cosf(theta),
+        r * cosf(phi),
+        r * sin_phi * sinf(theta)
+    );
+
+    Vec3 dir = vec3_length(offset) > 0.001f ? vec3_normalize(offset) : vec3_create(0.0f, 1.0f, 0.0f);
+
+    float speed_variation = 0.5f + rng_float(rng) * 1.0f;
+    Vec3 vel = vec3_scale(dir, force * speed_variation);
+
+    vel.y += force * 0.3f * rng_float(rng);
+
+    float color_variation = 0.9f + rng_float(rng) * 0.2f;
+    Vec3 particle_color = vec3_scale(color, color_variation);
+    particle_color.x = clampf(particle_color.x, 0.0f, 1.0f);
+    particle_color.y = clampf(particle_color.y, 0.0f, 1.0f);
+    particle_color.z = clampf(particle_color.z, 0.0f, 1.0f);
+
+    *out_position = vec3_add(center, offset);
+    *out_velocity = vel;
+    *out_spin = random_spin(rng);
+    *out_color = particle_color;
+    *out_radius = 0.04f + rng_float(rng) * 0.03f;
 }
 
 int32_t particle_system_spawn_explosion(ParticleSystem* sys, RngState *rng, Vec3 center, float radius,
@@ -328,55 +859,63 @@ int32_t particle_system_spawn_explosion(ParticleSystem* sys, RngState *rng, Vec3
     int32_t spawned = 0;
 
     for (int32_t i = 0; i < count; i++) {
-        float theta = rng_float(rng) * 2.0f * K_PI;
-        float phi = rng_float(rng) * K_PI;
-        float r = rng_float(rng) * radius * 0.8f;
+        Vec3 position, vel, spin, particle_color;
+        float particle_radius;
+        explosion_particle(rng, center, radius, color, force, &position, &vel, &spin, &particle_color,
+                           &particle_radius);
 
-        float sin_phi = sinf(phi);
-        Vec3 offset = vec3_create(
-            r * sin_phi * cosf(theta),
-            r * cosf(phi),
-            r * sin_phi * sinf(theta)
-        );
-
-        Vec3 dir = vec3_length(offset) > 0.001f ? vec3_normalize(offset) : vec3_create(0.0f, 1.0f, 0.0f);
+        /* Use circular buffer - overwrites oldest when at capacity */
+        int32_t slot = particle_system_add_slot(sys);
+        particle_store(sys, slot, position, vel, spin, particle_color, particle_radius);
 
-        float speed_variation = 0.5f + rng_float(rng) * 1.0f;
-        Vec3 vel = vec3_scale(dir, force * speed_variation);
+        spawned++;
+    }
 
-        vel.y += force * 0.3f * rng_float(rng);
+    return spawned;
+}
 
-        float color_variation = 0.9f + rng_float(rng) * 0.2f;
-        Vec3 particle_color = vec3_scale(color, color_variation);
-        particle_color.x = clampf(particle_color.x, 0.0f, 1.0f);
-        particle_color.y = clampf(particle_color.y, 0.0f, 1.0f);
-        particle_color.z = clampf(particle_color.z, 0.0f, 1.0f);
+void particle_spawn_buffer_clear(ParticleSpawnBuffer* buffer) {
+    buffer->count = 0;
+    buffer->dropped = 0;
+}
 
-        /* Use circular buffer - overwrites oldest when at capacity */
-        Particle* p = particle_system_add_slot(sys);
-        if (!p->active) sys->active_count++;
-        p->position = vec3_add(center, offset);
-        p->prev_position = p->position;
-        p->velocity = vel;
-        p->rotation = vec3_zero();
-        p->prev_rotation = vec3_zero();
-        p->angular_velocity = vec3_create(
-            rng_signed_half(rng) * 20.0f,
-            rng_signed_half(rng) * 20.0f,
-            rng_signed_half(rng) * 20.0f
-        );
-        p->color = particle_color;
-        p->radius = 0.04f + rng_float(rng) * 0.03f;
-        p->lifetime = 0.0f;
-        p->active = true;
-        p->settled = false;
+int32_t particle_spawn_buffer_explosion(ParticleSpawnBuffer* buffer, RngState *rng, Vec3 center, float radius,
+                                        Vec3 color, int32_t count, float force) {
+    int32_t spawned = 0;
 
+    for (int32_t i = 0; i < count; i++) {
+        if (buffer->count >= PARTICLE_SPAWN_BUFFER_MAX) {
+            buffer->dropped += count - i;
+            break;
+        }
+        int32_t n = buffer->count++;
+        explosion_particle(rng, center, radius, color, force, &buffer->position[n], &buffer->velocity[n],
+                           &buffer->angular_velocity[n], &buffer->color[n], &buffer->radius[n]);
         spawned++;
     }
 
     return spawned;
 }
 
+int32_t particle_system_merge_spawns(ParticleSystem* sys, ParticleSpawnBuffer* const* buffers,
+                                     int32_t buffer_count) {
+    int32_t added = 0;
+
+    for (int32_t b = 0; b < buffer_count; b++) {
+        ParticleSpawnBuffer* buffer = buffers[b];
+        if (!buffer) continue;
+        for (int32_t n = 0; n < buffer->count; n++) {
+            int32_t slot = particle_system_add_slot(sys);
+            particle_store(sys, slot, buffer->position[n], buffer->velocity[n], buffer->angular_velocity[n],
+                           buffer->color[n], buffer->radius[n]);
+        }
+        added += buffer->count;
+        buffer->count = 0;
+    }
+
+    return added;
+}
+
 int32_t particle_system_spawn_at_impact(ParticleSystem* sys, RngState *rng, Vec3 impact_point, Vec3 ball_center,
                                          float ball_radius, Vec3 color, int32_t count, float force) {
     int32_t spawned = 0;
@@ -417,91 +956,143 @@ int32_t particle_system_spawn_at_impact(ParticleSystem* sys, RngState *rng, Vec3
         particle_color.z = clampf(particle_color.z, 0.0f, 1.0f);
 
         /* Use circular buffer - overwrites oldest when at capacity */
-        Particle* p = particle_system_add_slot(sys);
-        if (!p->active) sys->active_count++;
-        p->position = vec3_add(impact_point, offset);
-        p->prev_position = p->position;
-        p->velocity = vel;
-        p->rotation = vec3_zero();
-        p->prev_rotation = vec3_zero();
-        p->angular_velocity = vec3_create(
-            rng_signed_half(rng) * 20.0f,
-            rng_signed_half(rng) * 20.0f,
-            rng_signed_half(rng) * 20.0f
-        );
-        p->color = particle_color;
-        p->radius = 0.03f + rng_float(rng) * 0.04f;
-        p->lifetime = 0.0f;
-        p->active = true;
-        p->settled = false;
+        int32_t slot = particle_system_add_slot(sys);
+        Vec3 spin = random_spin(rng);
+        particle_store(sys, slot, vec3_add(impact_point, offset), vel, spin, particle_color,
+                       0.03f + rng_float(rng) * 0.04f);
         spawned++;
     }
 
     return spawned;
 }
 
+
 int32_t particle_system_get_settled(ParticleSystem* sys, Particle* out_settled, int32_t max_count) {
+    const ParticleIndexList* settled = &sys->lists[PARTICLE_SETTLED];
     int32_t found = 0;
-    for (int32_t i = 0; i < sys->count && found < max_count; i++) {
-        if (sys->particles[i].active && sys->particles[i].settled) {
-            out_settled[found++] = sys->particles[i];
-        }
+    for (int32_t k = 0; k < settled->count && found < max_count; k++) {
+        out_settled[found++] = particle_system_get(sys, settled->slots[k]);
     }
     return found;
 }
 
+static void vec3_array_move(ParticleVec3Array *a, int32_t to, int32_t from) {
+    a->x[to] = a->x[from];
+    a->y[to] = a->y[from];
+    a->z[to] = a->z[from];
+}
+
 void particle_system_remove_settled(ParticleSystem* sys) {
+    ParticleIndexList* settled = &sys->lists[PARTICLE_SETTLED];
+    for (int32_t k = 0; k < settled->count; k++) {
+        sys->state[settled->slots[k]] = PARTICLE_INACTIVE;
+    }
+    settled->count = 0;
+
+    /* Compact the survivors to the front, then relist them in slot order */
     int32_t write = 0;
     for (int32_t read = 0; read < sys->count; read++) {
-        if (sys->particles[read].active && !sys->particles[read].settled) {
-            if (write != read) {
-                sys->particles[write] = sys->particles[read];
-            }
-            write++;
+        if (sys->state[read] == PARTICLE_INACTIVE) continue;
+        if (write != read) {
+            vec3_array_move(&sys->position, write, read);
+            vec3_array_move(&sys->prev_position, write, read);
+            vec3_array_move(&sys->velocity, write, read);
+            vec3_array_move(&sys->rotation, write, read);
+            vec3_array_move(&sys->angular_velocity, write, read);
+            sys->color[write] = sys->color[read];
+            sys->radius[write] = sys->radius[read];
+            sys->spawn_time[write] = sys->spawn_time[read];
+            sys->state[write] = sys->state[read];
+            sys->lod_pending[write] = sys->lod_pending[read];
+            sys->material[write] = sys->material[read];
+            sys->settled_tick[write] = sys->settled_tick[read];
+            sys->state[read] = PARTICLE_INACTIVE;
         }
+        write++;
+    }
+
+    sys->lists[PARTICLE_YOUNG].count = 0;
+    sys->lists[PARTICLE_AWAKE].count = 0;
+    for (int32_t i = 0; i < write; i++) {
+        ParticleIndexList* list = &sys->lists[sys->state[i]];
+        sys->list_index[i] = list->count;
+        list->slots[list->count++] = i;
     }
     sys->count = write;
     sys->active_count = write;  /* All remaining are active non-settled */
+    sys->update_cursor = 0;
 }
 
-bool particle_system_pickup_nearest(ParticleSystem* sys, Vec3 position, float max_dist, Vec3* out_color) {
-    int32_t nearest_idx = -1;
-    float nearest_dist = max_dist;
-    
-    for (int32_t i = 0; i < sys->count; i++) {
-        if (!sys->particles[i].active || !sys->particles[i].settled) continue;
-        
-        Vec3 to_particle = vec3_sub(sys->particles[i].position, position);
+int32_t particle_system_deposit_settled(ParticleSystem* sys, VoxelVolume* terrain, uint32_t settled_ticks,
+                                        uint8_t default_material) {
+    if (!terrain) return 0;
+
+    /* Deposits only add solid voxels, so a support check that was current stays current */
+    bool support_current = terrain == sys->support_terrain && terrain->version_counter == sys->support_version;
+
+    ParticleIndexList* settled = &sys->lists[PARTICLE_SETTLED];
+    int32_t freed = 0;
+    volume_edit_begin(terrain);
+
+    /* Walked backwards so a freed particle is swap-removed behind the walk */
+    for (int32_t k = settled->count - 1; k >= 0 && freed < PARTICLE_MAX_DEPOSITS_PER_TICK; k--) {
+        int32_t i = settled->slots[k];
+        if (sys->tick - sys->settled_tick[i] < settled_ticks) continue;
+
+        uint8_t material = sys->material[i] ? sys->material[i] : default_material;
+        if (material == MATERIAL_EMPTY) continue;
+
+        Vec3 position = particle_system_position(sys, i);
+        int32_t cx, cy, cz, lx, ly, lz;
+        volume_world_to_local(terrain, position, &cx, &cy, &cz, &lx, &ly, &lz);
+        if (!volume_get_chunk(terrain, cx, cy, cz) || !chunk_in_bounds(lx, ly, lz)) continue;
+
+        /* The batch tracks a bounded number of chunks; one more may be touched per particle */
+        if (terrain->edit_touched_count >= VOLUME_EDIT_BATCH_MAX_CHUNKS) break;
+
+        /* A voxel already filled (by an earlier deposit) just absorbs the particle */
+        if (volume_get_at(terrain, position) == MATERIAL_EMPTY)
+            volume_edit_set(terrain, position, material);
+        particle_set_state(sys, i, PARTICLE_INACTIVE);
+        freed++;
+    }
+
+    volume_edit_end(terrain);
+    if (support_current) sys->support_version = terrain->version_counter;
+    return freed;
+}
+
+/* Listed particle nearest horizontally, if closer than *nearest_dist; otherwise nearest_idx */
+static int32_t nearest_in_list(const ParticleSystem* sys, const ParticleIndexList* list, Vec3 position,
+                               float* nearest_dist, int32_t nearest_idx) {
+    for (int32_t k = 0; k < list->count; k++) {
+        int32_t i = list->slots[k];
+        Vec3 to_particle = vec3_sub(particle_system_position(sys, i), position);
         to_particle.y = 0.0f;
         float dist = vec3_length(to_particle);
-        
-        if (dist < nearest_dist) {
-            nearest_dist = dist;
+
+        if (dist < *nearest_dist) {
+            *nearest_dist = dist;
             nearest_idx = i;
         }
     }
+    return nearest_idx;
+}
+
+bool particle_system_pickup_nearest(ParticleSystem* sys, Vec3 position, float max_dist, Vec3* out_color) {
+    /* Settled particles first, then any live one */
+    float nearest_dist = max_dist;
+    int32_t nearest_idx = nearest_in_list(sys, &sys->lists[PARTICLE_SETTLED], position, &nearest_dist, -1);
 
     if (nearest_idx < 0) {
-        nearest_dist = max_dist;
-        for (int32_t i = 0; i < sys->count; i++) {
-            if (!sys->particles[i].active) continue;
-            
-            Vec3 to_particle = vec3_sub(sys->particles[i].position, position);
-            to_particle.y = 0.0f;
-            float dist = vec3_length(to_particle);
-            
-            if (dist < nearest_dist) {
-                nearest_dist = dist;
-                nearest_idx = i;
-            }
-        }
+        nearest_idx = nearest_in_list(sys, &sys->lists[PARTICLE_YOUNG], position, &nearest_dist, -1);
+        nearest_idx = nearest_in_list(sys, &sys->lists[PARTICLE_AWAKE], position, &nearest_dist, nearest_idx);
     }
-    
+
     if (nearest_idx < 0) return false;
 
-    *out_color = sys->particles[nearest_idx].color;
-    sys->particles[nearest_idx].active = false;
-    sys->active_count--;
+    *out_color = sys->color[nearest_idx];
+    particle_set_state(sys, nearest_idx, PARTICLE_INACTIVE);
 
     return true;
 }
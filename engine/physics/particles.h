@@ -2,17 +2,52 @@
 #define PATCH_CORE_PARTICLES_H
 
 /*
- * Visual-only particle system for debris and effects.
- * Lightweight: simple gravity, floor bounce, particle-particle collision.
- * NOT integrated with rigid body physics - purely cosmetic.
+ * Particle system for small debris and effects.
+ * Particles fall, bounce and slide on the terrain's solid voxels, collide
+ * with each other, and bounce off voxel objects without pushing them (no
+ * impulse reaches the rigid bodies). Debris LOD (debris_lod.h) turns
+ * fragments too small to be worth a rigid body into particles, and settled
+ * particles can be deposited back into the terrain.
+ *
+ * Storage is structure-of-arrays: particle i is slot i of every array.
+ * Scheduling (young age, awake budget, LOD rate), the surface friction
+ * probe, gravity, velocity clamping, damping, friction, integration and
+ * spin run as one fused pass over the slots, 8 lanes at a time with AVX2,
+ * 4 with SSE2, one at a time otherwise; all three give identical results.
+ *
+ * Live particles are also listed by state in dense index lists (young,
+ * awake, settled), so passes walk only the particles they work on instead
+ * of testing every slot. Moving a particle between lists is O(1).
+ *
+ * Terrain probes (collision, settling, support) are queued per pass and
+ * answered together from per-chunk solid bitmasks (particle_terrain.h)
+ * rather than one volume lookup per probe; the friction probe inside the
+ * fused pass reads the same masks one point at a time.
+ *
+ * Particle-particle contacts come from a cell-sorted sweep over the moving
+ * particles (particle_cells.h) that resolves every overlapping pair once.
+ *
+ * With a worker pool (island.h), integration, terrain and object contacts,
+ * particle contacts and settling run as chunked tasks. Tasks write only
+ * their own particles; state changes are recorded per entry and applied in
+ * list order afterwards, and particle contacts run colour by colour so no
+ * two concurrent cells share a particle. Results match the serial update
+ * for every thread count. Spawns produced on other threads go into spawn
+ * buffers and are merged in buffer order.
+ *
+ * Optionally, particles settled long enough are deposited: written into the
+ * terrain as voxels of their material in one batched volume edit, then
+ * freed, so long sessions do not pile up settled particles.
  */
 
 #include "engine/core/types.h"
 #include "engine/core/math.h"
 #include "engine/core/rng.h"
-#include "engine/core/spatial_hash.h"
 #include "engine/voxel/volume.h"
 #include "engine/voxel/voxel_object.h"
+#include "sim_lod.h"
+#include "particle_terrain.h"
+#include "particle_cells.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -21,18 +56,24 @@ extern "C"
 
 #define PARTICLE_MAX_COUNT 65536
 #define PARTICLE_MAX_UPDATES_PER_TICK 16384
-#define PARTICLE_MAX_COLLISION_PAIRS 8192
 #define PARTICLE_YOUNG_AGE_THRESHOLD 1.0f
 #define PARTICLE_SETTLE_VELOCITY 0.15f
+/* Per-slot array length: one spare cache line per array, so slot i of
+ * different arrays does not map to the same cache set */
+#define PARTICLE_ARRAY_SIZE (PARTICLE_MAX_COUNT + 16)
+#define PARTICLE_TASK_SIZE 2048      /* Slots or list entries per worker task, a whole number of lane blocks */
+#define PARTICLE_TASK_CELLS 256      /* Collision cells per worker task */
+#define PARTICLE_SPAWN_BUFFER_MAX 4096
+#define PARTICLE_MAX_DEPOSITS_PER_TICK 1024 /* Well within VOLUME_MAX_EDITS_PER_TICK */
 /* No PARTICLE_LIFETIME_MAX - particles are removed via circular buffer when spawning at capacity */
 
+    /* One particle, copied out of the arrays */
     typedef struct
     {
         Vec3 position;
         Vec3 prev_position;
         Vec3 velocity;
         Vec3 rotation;
-        Vec3 prev_rotation;
         Vec3 angular_velocity;
         Vec3 color;
         float radius;
@@ -41,9 +82,67 @@ extern "C"
         bool settled;
     } Particle;
 
+    typedef enum
+    {
+        PARTICLE_YOUNG,   /* Spawned under PARTICLE_YOUNG_AGE_THRESHOLD ago: updated every tick */
+        PARTICLE_AWAKE,   /* Older and moving: updated round-robin within the tick budget */
+        PARTICLE_SETTLED, /* Resting on a surface: not integrated */
+        PARTICLE_LIST_COUNT,
+        PARTICLE_INACTIVE = PARTICLE_LIST_COUNT
+    } ParticleState;
+
+    /* Slots in one state, in no particular order */
+    typedef struct
+    {
+        int32_t slots[PARTICLE_ARRAY_SIZE];
+        int32_t count;
+    } ParticleIndexList;
+
+    /* One Vec3 per slot, stored as three component arrays */
+    typedef struct
+    {
+        float x[PARTICLE_ARRAY_SIZE];
+        float y[PARTICLE_ARRAY_SIZE];
+        float z[PARTICLE_ARRAY_SIZE];
+    } ParticleVec3Array;
+
+    /* Particles generated away from the system, added by particle_system_merge_spawns */
     typedef struct
     {
-        Particle particles[PARTICLE_MAX_COUNT];
+        Vec3 position[PARTICLE_SPAWN_BUFFER_MAX];
+        Vec3 velocity[PARTICLE_SPAWN_BUFFER_MAX];
+        Vec3 angular_velocity[PARTICLE_SPAWN_BUFFER_MAX];
+        Vec3 color[PARTICLE_SPAWN_BUFFER_MAX];
+        float radius[PARTICLE_SPAWN_BUFFER_MAX];
+        int32_t count;
+        int32_t dropped; /* Spawns past capacity (stats) */
+    } ParticleSpawnBuffer;
+
+    struct PhysicsWorkers;
+
+    typedef struct
+    {
+        ParticleVec3Array position;
+        ParticleVec3Array prev_position; /* Position before the last update, for render interpolation */
+        ParticleVec3Array velocity;
+        ParticleVec3Array rotation;
+        ParticleVec3Array angular_velocity;
+        Vec3 color[PARTICLE_ARRAY_SIZE];
+        float radius[PARTICLE_ARRAY_SIZE];
+        double spawn_time[PARTICLE_ARRAY_SIZE]; /* Value of time when spawned */
+        uint8_t state[PARTICLE_ARRAY_SIZE];      /* ParticleState */
+        int32_t list_index[PARTICLE_ARRAY_SIZE]; /* Position in lists[state] */
+        uint8_t lod_pending[PARTICLE_ARRAY_SIZE]; /* Ticks skipped since the last update (sim_lod.h) */
+        uint8_t material[PARTICLE_ARRAY_SIZE];    /* Voxel material when deposited, 0 = the caller's default */
+        uint32_t settled_tick[PARTICLE_ARRAY_SIZE]; /* Value of tick when the particle settled */
+
+        ParticleIndexList lists[PARTICLE_LIST_COUNT];
+
+        int32_t updated[PARTICLE_ARRAY_SIZE]; /* Slots integrated this tick, in slot order */
+        int32_t updated_count;
+        int32_t aged[PARTICLE_ARRAY_SIZE];    /* Young slots past the young age, found by the integration pass */
+        uint8_t outcome[PARTICLE_ARRAY_SIZE]; /* Per-entry result of a chunked pass, applied in order after it */
+
         int32_t count;
         int32_t next_slot;
 
@@ -55,10 +154,26 @@ extern "C"
         float floor_friction;
 
         bool enable_particle_collision;
-        SpatialHashGrid collision_grid;
+        ParticleCellGrid collision_cells; /* Moving particles by cell (particle_cells.h) */
+        int32_t collision_slots[PARTICLE_ARRAY_SIZE]; /* Young then awake slots, the grid's input */
+        int32_t collision_pairs;                      /* Pairs resolved by the last update (stats) */
+
+        int32_t update_cursor;  /* Round-robin cursor into the awake list */
+        int32_t active_count;   /* Sum of the list counts */
+        double time;            /* Simulated seconds, for particle ages */
+        double young_spawn_min; /* No young particle spawned earlier; ages are read only once it ages out */
+        uint32_t tick;          /* Updates so far */
+
+        /* Terrain the settled list was last checked against; unchanged terrain skips the check */
+        const VoxelVolume *support_terrain;
+        uint32_t support_version;
 
-        int32_t update_cursor;  /* Round-robin cursor for budgeted updates */
-        int32_t active_count;   /* Tracked count to avoid O(n) scans */
+        PhysicsSimLod *lod;     /* Caller-owned rate scheduler, NULL = full rate */
+        uint32_t lod_tick;
+
+        struct PhysicsWorkers *workers; /* Caller-owned pool for the chunked passes, NULL = serial */
+
+        ParticleTerrain terrain_queries; /* Batched terrain probes, one pass at a time */
     } ParticleSystem;
 
     ParticleSystem *particle_system_create(Bounds3D bounds);
@@ -68,19 +183,70 @@ extern "C"
                                 const VoxelObjectWorld *objects);
     void particle_system_clear(ParticleSystem *sys);
 
+    /* Updates far particles at reduced rates; the scheduler must outlive the system (NULL = off) */
+    void particle_system_set_lod(ParticleSystem *sys, PhysicsSimLod *lod);
+
+    /* Runs the chunked passes on a worker pool that must outlive the system (NULL = serial) */
+    void particle_system_set_workers(ParticleSystem *sys, struct PhysicsWorkers *workers);
+
     int32_t particle_system_spawn_explosion(ParticleSystem *sys, RngState *rng, Vec3 center, float radius,
                                             Vec3 color, int32_t count, float force);
 
+    /*
+     * Spawn buffers: one per thread, filled without touching the system.
+     * spawn_explosion draws the same particles from rng as
+     * particle_system_spawn_explosion; merge_spawns adds the buffers in array
+     * order (so the result does not depend on which thread finished first)
+     * and empties them. Returns the particles added.
+     */
+    void particle_spawn_buffer_clear(ParticleSpawnBuffer *buffer);
+    int32_t particle_spawn_buffer_explosion(ParticleSpawnBuffer *buffer, RngState *rng, Vec3 center, float radius,
+                                            Vec3 color, int32_t count, float force);
+    int32_t particle_system_merge_spawns(ParticleSystem *sys, ParticleSpawnBuffer *const *buffers,
+                                         int32_t buffer_count);
+
     int32_t particle_system_spawn_at_impact(ParticleSystem *sys, RngState *rng, Vec3 impact_point, Vec3 ball_center,
                                             float ball_radius, Vec3 color, int32_t count, float force);
 
     int32_t particle_system_get_settled(ParticleSystem *sys, Particle *out_settled, int32_t max_count);
     void particle_system_remove_settled(ParticleSystem *sys);
 
+    /*
+     * Deposits particles settled for at least settled_ticks updates: each
+     * fills the empty voxel at its centre with its material (default_material
+     * when it has none) in one volume edit batch and is freed. At most
+     * PARTICLE_MAX_DEPOSITS_PER_TICK per call; the rest wait for the next.
+     * Returns the particles freed.
+     */
+    int32_t particle_system_deposit_settled(ParticleSystem *sys, VoxelVolume *terrain, uint32_t settled_ticks,
+                                            uint8_t default_material);
+
     bool particle_system_pickup_nearest(ParticleSystem *sys, Vec3 position, float max_dist, Vec3 *out_color);
 
     int32_t particle_system_add(ParticleSystem *sys, RngState *rng, Vec3 position, Vec3 velocity, Vec3 color, float radius);
-    Particle *particle_system_add_slot(ParticleSystem *sys);
+
+    /* Claims the next slot (overwriting the oldest at capacity) and clears its state */
+    int32_t particle_system_add_slot(ParticleSystem *sys);
+
+    Particle particle_system_get(const ParticleSystem *sys, int32_t index);
+
+    static inline bool particle_system_is_active(const ParticleSystem *sys, int32_t index)
+    {
+        return sys->state[index] != PARTICLE_INACTIVE;
+    }
+
+    static inline Vec3 particle_system_position(const ParticleSystem *sys, int32_t index)
+    {
+        return vec3_create(sys->position.x[index], sys->position.y[index], sys->position.z[index]);
+    }
+
+    /* Position between the last two updates, alpha in [0, 1] */
+    static inline Vec3 particle_system_interpolated_position(const ParticleSystem *sys, int32_t index, float alpha)
+    {
+        return vec3_create(sys->prev_position.x[index] + alpha * (sys->position.x[index] - sys->prev_position.x[index]),
+                           sys->prev_position.y[index] + alpha * (sys->position.y[index] - sys->prev_position.y[index]),
+                           sys->prev_position.z[index] + alpha * (sys->position.z[index] - sys->prev_position.z[index]));
+    }
 
 #ifdef __cplusplus
 }
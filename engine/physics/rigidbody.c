@@ -1,11 +1,28 @@
 #include "rigidbody.h"
 #include "collision_object.h"
+#include "island.h"
+#include "manifold.h"
+#include "terrain_contact.h"
+#include "sim_lod.h"
 #include "content/materials.h"
 #include "engine/core/profile.h"
+#include <assert.h>
 #include <stdlib.h>
 #include <string.h>
 
-static Vec3 vobj_world_com(VoxelObject *obj);
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PHYS_BODY_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PHYS_BODY_LANES 4
+#else
+#define PHYS_BODY_LANES 1
+#endif
+
+static_assert(PHYS_MAX_BODIES % PHYS_BODY_LANES == 0, "lane blocks must not run past the body arrays");
+
+static Vec3 vobj_world_com(const PhysicsWorld *world, int32_t body_index);
 
 PhysicsWorld *physics_world_create(VoxelObjectWorld *objects, VoxelVolume *terrain)
 {
@@ -25,13 +42,27 @@ PhysicsWorld *physics_world_create(VoxelObjectWorld *objects, VoxelVolume *terra
 
     for (int32_t i = 0; i < PHYS_MAX_BODIES; i++)
     {
-        world->bodies[i].flags = 0;
+        world->flags[i] = 0;
         world->bodies[i].next_free = -1;
+        world->active_index[i] = -1;
     }
 
-    world->broadphase = (SAPBroadphase *)calloc(1, sizeof(SAPBroadphase));
-    if (world->broadphase)
-        sap_init(world->broadphase);
+    world->broadphase = sap_create(PHYS_MAX_BODIES);
+
+    world->islands = (PhysicsIslands *)calloc(1, sizeof(PhysicsIslands));
+    world->manifolds = (PhysicsManifolds *)calloc(1, sizeof(PhysicsManifolds));
+    world->pair_cache = (PhysicsPairCache *)calloc(1, sizeof(PhysicsPairCache));
+    if (!world->islands || !world->manifolds || !world->pair_cache)
+    {
+        free(world->pair_cache);
+        free(world->manifolds);
+        free(world->islands);
+        sap_destroy(world->broadphase);
+        free(world);
+        return NULL;
+    }
+    physics_manifolds_init(world->manifolds);
+    physics_pair_cache_init(world->pair_cache);
 
     return world;
 }
@@ -40,12 +71,35 @@ void physics_world_destroy(PhysicsWorld *world)
 {
     if (world)
     {
-        if (world->broadphase)
-            free(world->broadphase);
+        physics_workers_destroy(world->workers);
+        sap_destroy(world->broadphase);
+        free(world->pair_cache);
+        free(world->manifolds);
+        free(world->islands);
         free(world);
     }
 }
 
+bool physics_world_set_worker_count(PhysicsWorld *world, int32_t worker_count)
+{
+    if (!world)
+        return false;
+
+    physics_workers_destroy(world->workers);
+    world->workers = NULL;
+    if (worker_count <= 0)
+        return true;
+
+    world->workers = physics_workers_create(worker_count);
+    return world->workers != NULL;
+}
+
+void physics_world_set_lod(PhysicsWorld *world, PhysicsSimLod *lod)
+{
+    if (world)
+        world->lod = lod;
+}
+
 static int32_t find_free_slot(PhysicsWorld *world)
 {
     if (world->first_free >= 0)
@@ -57,14 +111,15 @@ static int32_t find_free_slot(PhysicsWorld *world)
 
     for (int32_t i = 0; i < PHYS_MAX_BODIES; i++)
     {
-        if (!(world->bodies[i].flags & PHYS_FLAG_ACTIVE))
+        if (!(world->flags[i] & PHYS_FLAG_ACTIVE))
             return i;
     }
     return -1;
 }
 
-void physics_body_compute_inertia(RigidBody *body, Vec3 half_extents)
+void physics_body_compute_inertia(PhysicsWorld *world, int32_t body_index, Vec3 half_extents)
 {
+    RigidBody *body = &world->bodies[body_index];
     float w = half_extents.x * 2.0f;
     float h = half_extents.y * 2.0f;
     float d = half_extents.z * 2.0f;
@@ -76,68 +131,81 @@ void physics_body_compute_inertia(RigidBody *body, Vec3 half_extents)
     body->inertia_local.z = factor * (w * w + h * h);
 
     if (body->inertia_local.x > K_EPSILON)
-        body->inv_inertia_local.x = 1.0f / body->inertia_local.x;
+        world->inv_inertia_local.x[body_index] = 1.0f / body->inertia_local.x;
     if (body->inertia_local.y > K_EPSILON)
-        body->inv_inertia_local.y = 1.0f / body->inertia_local.y;
+        world->inv_inertia_local.y[body_index] = 1.0f / body->inertia_local.y;
     if (body->inertia_local.z > K_EPSILON)
-        body->inv_inertia_local.z = 1.0f / body->inertia_local.z;
+        world->inv_inertia_local.z[body_index] = 1.0f / body->inertia_local.z;
 }
 
-int32_t physics_world_add_body(PhysicsWorld *world, int32_t vobj_index)
+/* Mass and inertia from the object's voxels, box inertia when it has none */
+static void body_set_mass_from_object(PhysicsWorld *world, int32_t body_index, const VoxelObject *obj)
 {
-    if (!world || !world->objects)
-        return -1;
-
-    if (vobj_index < 0 || vobj_index >= VOBJ_MAX_OBJECTS)
-        return -1;
-
-    VoxelObject *obj = &world->objects->objects[vobj_index];
-    if (!obj->active)
-        return -1;
-
-    int32_t slot = find_free_slot(world);
-    if (slot < 0)
-        return -1;
-
-    RigidBody *body = &world->bodies[slot];
-    memset(body, 0, sizeof(RigidBody));
-
-    body->vobj_index = vobj_index;
-    body->velocity = vec3_zero();
-    body->angular_velocity = vec3_zero();
-
+    RigidBody *body = &world->bodies[body_index];
     body->mass = obj->total_mass > K_EPSILON ? obj->total_mass
                                              : (float)obj->voxel_count * PHYS_VOXEL_DENSITY;
     if (body->mass < K_EPSILON)
         body->mass = K_EPSILON;
-    body->inv_mass = 1.0f / body->mass;
+    world->inv_mass[body_index] = 1.0f / body->mass;
 
     if (obj->inertia_diag.x > K_EPSILON && obj->inertia_diag.y > K_EPSILON &&
         obj->inertia_diag.z > K_EPSILON)
     {
         body->inertia_local = obj->inertia_diag;
-        body->inv_inertia_local = vec3_create(
-            1.0f / obj->inertia_diag.x,
-            1.0f / obj->inertia_diag.y,
-            1.0f / obj->inertia_diag.z);
+        world->inv_inertia_local.x[body_index] = 1.0f / obj->inertia_diag.x;
+        world->inv_inertia_local.y[body_index] = 1.0f / obj->inertia_diag.y;
+        world->inv_inertia_local.z[body_index] = 1.0f / obj->inertia_diag.z;
     }
     else
     {
-        physics_body_compute_inertia(body, obj->shape_half_extents);
+        physics_body_compute_inertia(world, body_index, obj->shape_half_extents);
     }
+}
 
+/* Clears a claimed slot and enters it in the active list */
+static RigidBody *body_claim(PhysicsWorld *world, int32_t slot, int32_t vobj_index)
+{
+    RigidBody *body = &world->bodies[slot];
+    memset(body, 0, sizeof(RigidBody));
+    body->vobj_index = vobj_index;
     body->restitution = PHYS_DEFAULT_RESTITUTION;
     body->friction = PHYS_DEFAULT_FRICTION;
-    body->sleep_frames = 0;
-    body->ground_frames = 0;
-    body->flags = PHYS_FLAG_ACTIVE;
     body->next_free = -1;
-    body->synced_revision = obj->voxel_revision;
 
-    world->body_count++;
+    physics_body_store_velocity(world, slot, vec3_zero());
+    physics_body_store_angular_velocity(world, slot, vec3_zero());
+    world->inv_inertia_local.x[slot] = 0.0f;
+    world->inv_inertia_local.y[slot] = 0.0f;
+    world->inv_inertia_local.z[slot] = 0.0f;
+    world->flags[slot] = PHYS_FLAG_ACTIVE;
+
+    world->active_index[slot] = (int16_t)world->body_count;
+    world->active_bodies[world->body_count++] = (int16_t)slot;
     if (slot > world->max_body_index)
         world->max_body_index = slot;
     world->vobj_to_body[vobj_index] = (int16_t)slot;
+    return body;
+}
+
+int32_t physics_world_add_body(PhysicsWorld *world, int32_t vobj_index)
+{
+    if (!world || !world->objects)
+        return -1;
+
+    if (vobj_index < 0 || vobj_index >= VOBJ_MAX_OBJECTS)
+        return -1;
+
+    VoxelObject *obj = &world->objects->objects[vobj_index];
+    if (!obj->active)
+        return -1;
+
+    int32_t slot = find_free_slot(world);
+    if (slot < 0)
+        return -1;
+
+    RigidBody *body = body_claim(world, slot, vobj_index);
+    body_set_mass_from_object(world, slot, obj);
+    body->synced_revision = obj->voxel_revision;
     return slot;
 }
 
@@ -158,31 +226,13 @@ int32_t physics_world_add_body_with_mass(PhysicsWorld *world, int32_t vobj_index
     if (slot < 0)
         return -1;
 
-    RigidBody *body = &world->bodies[slot];
-    memset(body, 0, sizeof(RigidBody));
-
-    body->vobj_index = vobj_index;
-    body->velocity = vec3_zero();
-    body->angular_velocity = vec3_zero();
-
+    RigidBody *body = body_claim(world, slot, vobj_index);
     body->mass = mass;
     if (body->mass < K_EPSILON)
         body->mass = K_EPSILON;
-    body->inv_mass = 1.0f / body->mass;
-
-    physics_body_compute_inertia(body, half_extents);
-
-    body->restitution = PHYS_DEFAULT_RESTITUTION;
-    body->friction = PHYS_DEFAULT_FRICTION;
-    body->sleep_frames = 0;
-    body->ground_frames = 0;
-    body->flags = PHYS_FLAG_ACTIVE;
-    body->next_free = -1;
+    world->inv_mass[slot] = 1.0f / body->mass;
 
-    world->body_count++;
-    if (slot > world->max_body_index)
-        world->max_body_index = slot;
-    world->vobj_to_body[vobj_index] = (int16_t)slot;
+    physics_body_compute_inertia(world, slot, half_extents);
     return slot;
 }
 
@@ -192,16 +242,25 @@ void physics_world_remove_body(PhysicsWorld *world, int32_t body_index)
         return;
 
     RigidBody *body = &world->bodies[body_index];
-    if (!(body->flags & PHYS_FLAG_ACTIVE))
+    if (!(world->flags[body_index] & PHYS_FLAG_ACTIVE))
         return;
 
     if (body->vobj_index >= 0 && body->vobj_index < VOBJ_MAX_OBJECTS)
         world->vobj_to_body[body->vobj_index] = -1;
 
-    body->flags = 0;
+    /* The slot may be reused before the next step; its pairs must not carry over */
+    sap_remove_body(world->broadphase, body_index);
+
+    /* The last listed body takes the removed one's place */
+    int32_t k = world->active_index[body_index];
+    int16_t last = world->active_bodies[--world->body_count];
+    world->active_bodies[k] = last;
+    world->active_index[last] = (int16_t)k;
+    world->active_index[body_index] = -1;
+
+    world->flags[body_index] = 0;
     body->next_free = world->first_free;
     world->first_free = body_index;
-    world->body_count--;
 }
 
 int32_t physics_world_find_body_for_object(PhysicsWorld *world, int32_t vobj_index)
@@ -212,7 +271,7 @@ int32_t physics_world_find_body_for_object(PhysicsWorld *world, int32_t vobj_ind
         return -1;
 
     int16_t body_idx = world->vobj_to_body[vobj_index];
-    if (body_idx >= 0 && (world->bodies[body_idx].flags & PHYS_FLAG_ACTIVE))
+    if (body_idx >= 0 && (world->flags[body_idx] & PHYS_FLAG_ACTIVE))
         return body_idx;
 
     return -1;
@@ -222,7 +281,7 @@ RigidBody *physics_world_get_body(PhysicsWorld *world, int32_t body_index)
 {
     if (!world || body_index < 0 || body_index >= PHYS_MAX_BODIES)
         return NULL;
-    if (!(world->bodies[body_index].flags & PHYS_FLAG_ACTIVE))
+    if (!(world->flags[body_index] & PHYS_FLAG_ACTIVE))
         return NULL;
     return &world->bodies[body_index];
 }
@@ -235,7 +294,7 @@ int32_t physics_world_get_body_count(PhysicsWorld *world)
 bool physics_body_is_sleeping(PhysicsWorld *world, int32_t body_index)
 {
     RigidBody *body = physics_world_get_body(world, body_index);
-    return body ? (body->flags & PHYS_FLAG_SLEEPING) != 0 : true;
+    return body ? (world->flags[body_index] & PHYS_FLAG_SLEEPING) != 0 : true;
 }
 
 void physics_body_wake(PhysicsWorld *world, int32_t body_index)
@@ -243,7 +302,7 @@ void physics_body_wake(PhysicsWorld *world, int32_t body_index)
     RigidBody *body = physics_world_get_body(world, body_index);
     if (body)
     {
-        body->flags &= ~PHYS_FLAG_SLEEPING;
+        world->flags[body_index] &= ~PHYS_FLAG_SLEEPING;
         body->sleep_frames = 0;
     }
 }
@@ -253,7 +312,7 @@ void physics_body_set_velocity(PhysicsWorld *world, int32_t body_index, Vec3 vel
     RigidBody *body = physics_world_get_body(world, body_index);
     if (body)
     {
-        body->velocity = velocity;
+        physics_body_store_velocity(world, body_index, velocity);
         physics_body_wake(world, body_index);
     }
 }
@@ -263,7 +322,7 @@ void physics_body_set_angular_velocity(PhysicsWorld *world, int32_t body_index,
     RigidBody *body = physics_world_get_body(world, body_index);
     if (body)
     {
-        body->angular_velocity = angular_velocity;
+        physics_body_store_angular_velocity(world, body_index, angular_velocity);
         physics_body_wake(world, body_index);
     }
 }
@@ -271,22 +330,23 @@ void physics_body_set_angular_velocity(PhysicsWorld *world, int32_t body_index,
 void physics_body_apply_impulse(PhysicsWorld *world, int32_t body_index, Vec3 impulse, Vec3 world_point)
 {
     RigidBody *body = physics_world_get_body(world, body_index);
-    if (!body || body->inv_mass == 0.0f)
+    float inv_mass = body ? world->inv_mass[body_index] : 0.0f;
+    if (inv_mass == 0.0f)
         return;
 
     float impulse_mag = vec3_length(impulse);
     if (impulse_mag < 0.001f)
         return;
 
-    VoxelObject *obj = &world->objects->objects[body->vobj_index];
-    Vec3 r = vec3_sub(world_point, vobj_world_com(obj));
+    Vec3 r = vec3_sub(world_point, vobj_world_com(world, body_index));
 
-    body->velocity = vec3_add(body->velocity, vec3_scale(impulse, body->inv_mass));
+    physics_body_store_velocity(world, body_index,
+                                vec3_add(physics_body_velocity(world, body_index), vec3_scale(impulse, inv_mass)));
 
     Vec3 angular_impulse = vec3_cross(r, impulse);
     Vec3 rot_mat[3];
     float mat3[9];
-    quat_to_mat3(obj->orientation, mat3);
+    quat_to_mat3(voxel_object_orientation(world->objects, body->vobj_index), mat3);
     rot_mat[0] = vec3_create(mat3[0], mat3[1], mat3[2]);
     rot_mat[1] = vec3_create(mat3[3], mat3[4], mat3[5]);
     rot_mat[2] = vec3_create(mat3[6], mat3[7], mat3[8]);
@@ -296,14 +356,15 @@ void physics_body_apply_impulse(PhysicsWorld *world, int32_t body_index, Vec3 im
         vec3_dot(rot_mat[1], angular_impulse),
         vec3_dot(rot_mat[2], angular_impulse));
 
-    Vec3 delta_angular = vec3_mul(local_angular, body->inv_inertia_local);
+    Vec3 delta_angular = vec3_mul(local_angular, physics_body_inv_inertia(world, body_index));
 
     Vec3 world_delta = vec3_create(
         rot_mat[0].x * delta_angular.x + rot_mat[1].x * delta_angular.y + rot_mat[2].x * delta_angular.z,
         rot_mat[0].y * delta_angular.x + rot_mat[1].y * delta_angular.y + rot_mat[2].y * delta_angular.z,
         rot_mat[0].z * delta_angular.x + rot_mat[1].z * delta_angular.y + rot_mat[2].z * delta_angular.z);
 
-    body->angular_velocity = vec3_add(body->angular_velocity, world_delta);
+    physics_body_store_angular_velocity(world, body_index,
+                                        vec3_add(physics_body_angular_velocity(world, body_index), world_delta));
 
     if (impulse_mag > 0.1f)
         physics_body_wake(world, body_index);
@@ -323,104 +384,16 @@ void physics_body_apply_torque(PhysicsWorld *world, int32_t body_index, Vec3 tor
     (void)torque;
 }
 
-static void get_obb_sample_points(VoxelObject *obj, Vec3 points[PHYS_TERRAIN_SAMPLE_POINTS])
-{
-    Vec3 he = obj->shape_half_extents;
-    float mat3[9];
-    quat_to_mat3(obj->orientation, mat3);
-
-    Vec3 axis_x = vec3_create(mat3[0], mat3[3], mat3[6]);
-    Vec3 axis_y = vec3_create(mat3[1], mat3[4], mat3[7]);
-    Vec3 axis_z = vec3_create(mat3[2], mat3[5], mat3[8]);
-
-    Vec3 scaled_x = vec3_scale(axis_x, he.x);
-    Vec3 scaled_y = vec3_scale(axis_y, he.y);
-    Vec3 scaled_z = vec3_scale(axis_z, he.z);
-
-    Vec3 c = obj->position;
-
-    points[0] = vec3_add(c, vec3_add(vec3_add(scaled_x, scaled_y), scaled_z));
-    points[1] = vec3_add(c, vec3_add(vec3_sub(scaled_x, scaled_y), scaled_z));
-    points[2] = vec3_add(c, vec3_sub(vec3_add(scaled_x, scaled_y), scaled_z));
-    points[3] = vec3_add(c, vec3_sub(vec3_sub(scaled_x, scaled_y), scaled_z));
-    points[4] = vec3_add(c, vec3_add(vec3_add(vec3_neg(scaled_x), scaled_y), scaled_z));
-    points[5] = vec3_add(c, vec3_add(vec3_sub(vec3_neg(scaled_x), scaled_y), scaled_z));
-    points[6] = vec3_add(c, vec3_sub(vec3_add(vec3_neg(scaled_x), scaled_y), scaled_z));
-    points[7] = vec3_add(c, vec3_sub(vec3_sub(vec3_neg(scaled_x), scaled_y), scaled_z));
-
-    points[8] = vec3_add(c, scaled_x);
-    points[9] = vec3_sub(c, scaled_x);
-    points[10] = vec3_add(c, scaled_y);
-    points[11] = vec3_sub(c, scaled_y);
-    points[12] = vec3_add(c, scaled_z);
-    points[13] = vec3_sub(c, scaled_z);
-}
-
-#define PHYS_MAX_COMPOUND_POINTS 64
-
-static int32_t get_collider_ground_points(VoxelObject *obj, Vec3 *points, int32_t max_points)
-{
-    Vec3 c = obj->position;
-    int32_t count = 0;
-
-    for (int32_t b = 0; b < obj->collider_box_count && count < max_points; b++)
-    {
-        ColliderBox *box = &obj->collider_boxes[b];
-
-        Vec3 box_center = vec3_scale(vec3_add(box->local_min, box->local_max), 0.5f);
-        Vec3 box_half = vec3_scale(vec3_sub(box->local_max, box->local_min), 0.5f);
-
-        for (int32_t corner = 0; corner < 8 && count < max_points; corner++)
-        {
-            Vec3 local = vec3_create(
-                box_center.x + ((corner & 1) ? box_half.x : -box_half.x),
-                box_center.y + ((corner & 2) ? box_half.y : -box_half.y),
-                box_center.z + ((corner & 4) ? box_half.z : -box_half.z));
-
-            points[count++] = vec3_add(c, quat_rotate_vec3(obj->orientation, local));
-        }
-    }
-
-    return count;
-}
-
-static Vec3 estimate_terrain_normal(VoxelVolume *terrain, Vec3 point, float probe_dist,
-                                    Vec3 obj_center)
-{
-    float scales[] = {1.0f, 2.0f, 4.0f};
-    for (int32_t s = 0; s < 3; s++)
-    {
-        float pd = probe_dist * scales[s];
-        float dx = (volume_get_at(terrain, vec3_create(point.x + pd, point.y, point.z)) != 0 ? 1.0f : 0.0f) -
-                   (volume_get_at(terrain, vec3_create(point.x - pd, point.y, point.z)) != 0 ? 1.0f : 0.0f);
-        float dy = (volume_get_at(terrain, vec3_create(point.x, point.y + pd, point.z)) != 0 ? 1.0f : 0.0f) -
-                   (volume_get_at(terrain, vec3_create(point.x, point.y - pd, point.z)) != 0 ? 1.0f : 0.0f);
-        float dz = (volume_get_at(terrain, vec3_create(point.x, point.y, point.z + pd)) != 0 ? 1.0f : 0.0f) -
-                   (volume_get_at(terrain, vec3_create(point.x, point.y, point.z - pd)) != 0 ? 1.0f : 0.0f);
-
-        Vec3 gradient = vec3_create(-dx, -dy, -dz);
-        float len = vec3_length(gradient);
-        if (len > K_EPSILON)
-            return vec3_scale(gradient, 1.0f / len);
-    }
-
-    Vec3 to_center = vec3_sub(obj_center, point);
-    float len = vec3_length(to_center);
-    if (len > K_EPSILON)
-        return vec3_scale(to_center, 1.0f / len);
-
-    return vec3_zero();
-}
-
-static float compute_effective_mass(RigidBody *body, VoxelObject *obj, Vec3 r, Vec3 n)
+static float compute_effective_mass(const PhysicsWorld *world, int32_t body_index, Vec3 r, Vec3 n)
 {
-    if (body->inv_mass == 0.0f)
+    float inv_mass = world->inv_mass[body_index];
+    if (inv_mass == 0.0f)
         return 0.0f;
 
     Vec3 r_cross_n = vec3_cross(r, n);
 
     float mat3[9];
-    quat_to_mat3(obj->orientation, mat3);
+    quat_to_mat3(voxel_object_orientation(world->objects, world->bodies[body_index].vobj_index), mat3);
     Vec3 rot_mat[3];
     rot_mat[0] = vec3_create(mat3[0], mat3[1], mat3[2]);
     rot_mat[1] = vec3_create(mat3[3], mat3[4], mat3[5]);
@@ -431,7 +404,7 @@ static float compute_effective_mass(RigidBody *body, VoxelObject *obj, Vec3 r, V
         vec3_dot(rot_mat[1], r_cross_n),
         vec3_dot(rot_mat[2], r_cross_n));
 
-    Vec3 scaled = vec3_mul(local_r_cross_n, body->inv_inertia_local);
+    Vec3 scaled = vec3_mul(local_r_cross_n, physics_body_inv_inertia(world, body_index));
 
     Vec3 world_scaled = vec3_create(
         rot_mat[0].x * scaled.x + rot_mat[1].x * scaled.y + rot_mat[2].x * scaled.z,
@@ -441,101 +414,99 @@ static float compute_effective_mass(RigidBody *body, VoxelObject *obj, Vec3 r, V
     Vec3 term = vec3_cross(world_scaled, r);
     float angular_term = vec3_dot(term, n);
 
-    return body->inv_mass + angular_term;
+    return inv_mass + angular_term;
 }
 
-static Vec3 vobj_world_com(VoxelObject *obj)
+static Vec3 vobj_world_com(const PhysicsWorld *world, int32_t body_index)
 {
-    Vec3 rotated_com = quat_rotate_vec3(obj->orientation, obj->local_com);
-    return vec3_add(obj->position, rotated_com);
+    int32_t vobj_index = world->bodies[body_index].vobj_index;
+    const VoxelObject *obj = &world->objects->objects[vobj_index];
+    VoxelObjectPose pose = voxel_object_pose(world->objects, vobj_index);
+    Vec3 rotated_com = quat_rotate_vec3(pose.orientation, obj->local_com);
+    return vec3_add(pose.position, rotated_com);
 }
 
-static Vec3 get_point_velocity(RigidBody *body, VoxelObject *obj, Vec3 world_point)
+static Vec3 get_point_velocity(const PhysicsWorld *world, int32_t body_index, Vec3 world_point)
 {
-    Vec3 r = vec3_sub(world_point, vobj_world_com(obj));
-    return vec3_add(body->velocity, vec3_cross(body->angular_velocity, r));
+    Vec3 r = vec3_sub(world_point, vobj_world_com(world, body_index));
+    return vec3_add(physics_body_velocity(world, body_index),
+                    vec3_cross(physics_body_angular_velocity(world, body_index), r));
 }
 
-static float estimate_penetration_depth(VoxelVolume *terrain, Vec3 point, Vec3 normal, float voxel_size)
+/* Chunks a supported body's terrain contacts can come from: its reach plus a voxel */
+static uint32_t body_support_version(const PhysicsWorld *world, const RigidBody *body)
 {
-    float max_probe = voxel_size * 2.0f;
-    float step = voxel_size * 0.25f;
+    const VoxelObject *obj = &world->objects->objects[body->vobj_index];
+    Vec3 position = voxel_object_position(world->objects, body->vobj_index);
+    float reach = obj->radius + world->terrain->voxel_size;
+    Vec3 extent = vec3_create(reach, reach, reach);
+    return physics_terrain_box_version(world->terrain, vec3_sub(position, extent),
+                                       vec3_add(position, extent));
+}
 
-    for (float d = 0.0f; d < max_probe; d += step)
-    {
-        Vec3 probe = vec3_add(point, vec3_scale(normal, d));
-        if (volume_get_at(terrain, probe) == 0)
-            return d;
-    }
-    return max_probe;
+/* Support centroid close enough under the center of mass to rest on */
+static bool support_is_stable(const VoxelObject *obj, Vec3 world_com, Vec3 support_centroid)
+{
+    float dx = world_com.x - support_centroid.x;
+    float dz = world_com.z - support_centroid.z;
+    float horizontal_offset = sqrtf(dx * dx + dz * dz);
+    float max_he = maxf(obj->shape_half_extents.x, obj->shape_half_extents.z);
+    return horizontal_offset < max_he * PHYS_STABLE_SUPPORT_RATIO;
 }
 
-static void solve_terrain_collision(PhysicsWorld *world, int32_t body_index, float dt)
+/* dt may cover several ticks of tick_dt: a far body's catch-up sweep */
+static void solve_terrain_collision(PhysicsWorld *world, int32_t body_index, float dt, float tick_dt)
 {
     RigidBody *body = &world->bodies[body_index];
+    uint8_t *flags = &world->flags[body_index];
     VoxelObject *obj = &world->objects->objects[body->vobj_index];
 
-    Vec3 sample_points[PHYS_TERRAIN_SAMPLE_POINTS];
-    get_obb_sample_points(obj, sample_points);
-
     float voxel_size = world->terrain->voxel_size;
-    float probe_dist = voxel_size * 0.5f;
 
-    float lin_speed = vec3_length(body->velocity);
-    float ang_speed = vec3_length(body->angular_velocity);
-    bool at_rest = (body->flags & PHYS_FLAG_GROUNDED) &&
+    /* Supported: resting on terrain that has not been edited since the last
+     * full sample. Sampling is skipped until a push or a nearby edit ends it. */
+    float lin_speed = vec3_length(physics_body_velocity(world, body_index));
+    float ang_speed = vec3_length(physics_body_angular_velocity(world, body_index));
+    bool at_rest = body->support_version != 0 && (*flags & PHYS_FLAG_GROUNDED) &&
                    body->ground_frames >= PHYS_GROUND_PERSIST_FRAMES &&
                    lin_speed < PHYS_SETTLE_LINEAR_THRESHOLD &&
                    ang_speed < PHYS_SETTLE_ANGULAR_THRESHOLD;
 
     if (at_rest)
     {
-        body->velocity = vec3_zero();
-        body->angular_velocity = vec3_zero();
+        physics_body_store_velocity(world, body_index, vec3_zero());
+        physics_body_store_angular_velocity(world, body_index, vec3_zero());
         return;
     }
 
-    int32_t ground_contacts = 0;
     int32_t correction_count = 0;
     Vec3 total_correction = vec3_zero();
-    Vec3 world_com = vobj_world_com(obj);
-
-    for (int32_t i = 0; i < PHYS_TERRAIN_SAMPLE_POINTS; i++)
-    {
-        Vec3 point = sample_points[i];
+    Vec3 world_com = vobj_world_com(world, body_index);
 
-        uint8_t mat_id = volume_get_at(world->terrain, point);
-        if (mat_id == 0)
-            continue;
+    TerrainContactSet contacts;
+    physics_terrain_contacts(world->terrain, obj, voxel_object_pose(world->objects, body->vobj_index), &contacts);
 
-        Vec3 normal = estimate_terrain_normal(world->terrain, point, probe_dist, obj->position);
-        float normal_len = vec3_length(normal);
-        if (normal_len < K_EPSILON)
-            continue;
+    for (int32_t i = 0; i < contacts.count; i++)
+    {
+        const TerrainContact *tc = &contacts.contacts[i];
+        Vec3 point = tc->point;
+        Vec3 normal = tc->normal;
+        uint8_t mat_id = tc->material;
 
+        /* Upward faces above the center of mass would lift a buried body */
         bool is_ground = normal.y > 0.85f && point.y < world_com.y;
-        if (is_ground)
-            ground_contacts++;
-
         if (!is_ground && normal.y > 0.0f)
-        {
-            normal.y = 0.0f;
-            float hlen = sqrtf(normal.x * normal.x + normal.z * normal.z);
-            if (hlen > K_EPSILON)
-                normal = vec3_create(normal.x / hlen, 0.0f, normal.z / hlen);
-            else
-                continue;
-        }
+            continue;
 
-        float penetration = estimate_penetration_depth(world->terrain, point, normal, voxel_size);
+        float penetration = tc->penetration;
         if (penetration < PHYS_SLOP)
             continue;
 
         Vec3 r = vec3_sub(point, world_com);
-        Vec3 point_vel = get_point_velocity(body, obj, point);
+        Vec3 point_vel = get_point_velocity(world, body_index, point);
         float v_n = vec3_dot(point_vel, normal);
 
-        float eff_mass = compute_effective_mass(body, obj, r, normal);
+        float eff_mass = compute_effective_mass(world, body_index, r, normal);
         if (eff_mass < K_EPSILON)
             continue;
 
@@ -586,65 +557,36 @@ static void solve_terrain_collision(PhysicsWorld *world, int32_t body_index, flo
         correction_count++;
     }
 
-    if (ground_contacts >= 1)
+    if (contacts.ground_count > 0)
     {
         body->ground_frames = PHYS_GROUND_PERSIST_FRAMES;
-        body->flags |= PHYS_FLAG_GROUNDED;
-
-        /* Use compound box corners for stability check — these follow actual
-         * voxel geometry and avoid phantom contacts in empty OBB regions. */
-        Vec3 compound_pts[PHYS_MAX_COMPOUND_POINTS];
-        int32_t compound_count = get_collider_ground_points(obj, compound_pts, PHYS_MAX_COMPOUND_POINTS);
-        Vec3 ground_centroid = vec3_zero();
-        int32_t centroid_count = 0;
-
-        for (int32_t i = 0; i < compound_count; i++)
-        {
-            if (compound_pts[i].y >= world_com.y)
-                continue;
-            Vec3 below = vec3_create(compound_pts[i].x,
-                                     compound_pts[i].y - voxel_size,
-                                     compound_pts[i].z);
-            uint8_t mat = volume_get_at(world->terrain, below);
-            if (mat == 0)
-                mat = volume_get_at(world->terrain, compound_pts[i]);
-            if (mat != 0)
-            {
-                centroid_count++;
-                ground_centroid = vec3_add(ground_centroid, compound_pts[i]);
-            }
-        }
+        *flags |= PHYS_FLAG_GROUNDED;
+        body->support_version = body_support_version(world, body);
 
-        if (centroid_count > 0)
-        {
-            ground_centroid = vec3_scale(ground_centroid, 1.0f / (float)centroid_count);
-            float dx = world_com.x - ground_centroid.x;
-            float dz = world_com.z - ground_centroid.z;
-            float horizontal_offset = sqrtf(dx * dx + dz * dz);
-            float max_he = maxf(obj->shape_half_extents.x, obj->shape_half_extents.z);
-            if (horizontal_offset < max_he * PHYS_STABLE_SUPPORT_RATIO)
-                body->flags |= PHYS_FLAG_STABLE;
-            else
-                body->flags &= ~PHYS_FLAG_STABLE;
-        }
+        /* Stability from every sample resting on an upward face, not just the
+         * reduced contacts: these follow the actual voxel footprint. */
+        if (support_is_stable(obj, world_com, contacts.support_centroid))
+            *flags |= PHYS_FLAG_STABLE;
         else
-        {
-            body->flags &= ~PHYS_FLAG_STABLE;
-        }
+            *flags &= ~PHYS_FLAG_STABLE;
     }
     else if (body->ground_frames > 0)
     {
-        body->ground_frames--;
+        /* Grounding persists for ticks, not sweeps: a catch-up sweep uses up all it covered */
+        int32_t ticks = dt > tick_dt ? (int32_t)(dt / tick_dt + 0.5f) : 1;
+        body->support_version = 0;
+        body->ground_frames = (uint8_t)(body->ground_frames > ticks ? body->ground_frames - ticks : 0);
         if (body->ground_frames == 0)
         {
-            body->flags &= ~PHYS_FLAG_GROUNDED;
-            body->flags &= ~PHYS_FLAG_STABLE;
+            *flags &= ~PHYS_FLAG_GROUNDED;
+            *flags &= ~PHYS_FLAG_STABLE;
         }
     }
     else
     {
-        body->flags &= ~PHYS_FLAG_GROUNDED;
-        body->flags &= ~PHYS_FLAG_STABLE;
+        body->support_version = 0;
+        *flags &= ~PHYS_FLAG_GROUNDED;
+        *flags &= ~PHYS_FLAG_STABLE;
     }
 
     if (correction_count > 0 && vec3_length(total_correction) > K_EPSILON)
@@ -656,106 +598,543 @@ static void solve_terrain_collision(PhysicsWorld *world, int32_t body_index, flo
         if (corr_len > max_corr)
             total_correction = vec3_scale(total_correction, max_corr / corr_len);
 
-        obj->position = vec3_add(obj->position, vec3_scale(total_correction, 0.8f));
+        voxel_object_set_position(world->objects, body->vobj_index,
+                                  vec3_add(voxel_object_position(world->objects, body->vobj_index),
+                                           vec3_scale(total_correction, 0.8f)));
     }
 
-    if (body->flags & PHYS_FLAG_GROUNDED)
+    if (*flags & PHYS_FLAG_GROUNDED)
     {
-        float vel_y = body->velocity.y;
+        float vel_y = world->velocity.y[body_index];
         if (vel_y < 0.0f && vel_y > -1.0f)
-            body->velocity.y = 0.0f;
+            world->velocity.y[body_index] = 0.0f;
 
-        float lin_speed = vec3_length(body->velocity);
-        float ang_speed = vec3_length(body->angular_velocity);
+        float lin_speed = vec3_length(physics_body_velocity(world, body_index));
+        float ang_speed = vec3_length(physics_body_angular_velocity(world, body_index));
 
         if (lin_speed < PHYS_SETTLE_LINEAR_THRESHOLD)
-            body->velocity = vec3_zero();
+            physics_body_store_velocity(world, body_index, vec3_zero());
         if (ang_speed < PHYS_SETTLE_ANGULAR_THRESHOLD)
-            body->angular_velocity = vec3_zero();
+            physics_body_store_angular_velocity(world, body_index, vec3_zero());
     }
 }
 
-static void integrate_body(PhysicsWorld *world, int32_t body_index, float dt)
+/* Static, kinematic and vanished bodies are not integrated; a body whose object went is removed */
+static bool body_integrates(PhysicsWorld *world, int32_t body_index)
 {
-    RigidBody *body = &world->bodies[body_index];
-    if (!(body->flags & PHYS_FLAG_ACTIVE) || (body->flags & PHYS_FLAG_SLEEPING))
-        return;
+    uint8_t flags = world->flags[body_index];
+    if (!(flags & PHYS_FLAG_ACTIVE) || (flags & PHYS_FLAG_SLEEPING))
+        return false;
 
-    if (body->flags & (PHYS_FLAG_STATIC | PHYS_FLAG_KINEMATIC))
-        return;
+    if (flags & (PHYS_FLAG_STATIC | PHYS_FLAG_KINEMATIC))
+        return false;
 
-    VoxelObject *obj = &world->objects->objects[body->vobj_index];
-    if (!obj->active)
+    if (!world->objects->objects[world->bodies[body_index].vobj_index].active)
     {
         physics_world_remove_body(world, body_index);
-        return;
+        return false;
     }
+    return true;
+}
+
+/*
+ * A far body's catch-up sweep can cover several ticks (dt > tick_dt). It is
+ * damped and displaced as the ticks would have been one by one, so one
+ * large step does not fall further than the full-rate body.
+ */
+static void integrate_body(PhysicsWorld *world, int32_t body_index, float dt, float tick_dt)
+{
+    if (!body_integrates(world, body_index))
+        return;
 
-    bool grounded = (body->flags & PHYS_FLAG_GROUNDED) != 0;
+    int32_t vobj_index = world->bodies[body_index].vobj_index;
+    bool grounded = (world->flags[body_index] & PHYS_FLAG_GROUNDED) != 0;
+    float ticks = dt > tick_dt ? dt / tick_dt : 1.0f;
+    Vec3 velocity = physics_body_velocity(world, body_index);
+    Vec3 angular_velocity = physics_body_angular_velocity(world, body_index);
 
     if (!grounded)
     {
-        body->velocity = vec3_add(body->velocity, vec3_scale(world->gravity, dt));
+        velocity = vec3_add(velocity, vec3_scale(world->gravity, dt));
     }
 
     float linear_damp = grounded ? PHYS_GROUND_LINEAR_DAMPING : PHYS_LINEAR_DAMPING;
     float angular_damp = grounded ? PHYS_GROUND_ANGULAR_DAMPING : PHYS_ANGULAR_DAMPING;
+    if (ticks > 1.0f)
+    {
+        linear_damp = powf(linear_damp, ticks);
+        angular_damp = powf(angular_damp, ticks);
+    }
+
+    velocity = vec3_scale(velocity, linear_damp);
+    angular_velocity = vec3_scale(angular_velocity, angular_damp);
 
-    body->velocity = vec3_scale(body->velocity, linear_damp);
-    body->angular_velocity = vec3_scale(body->angular_velocity, angular_damp);
+    velocity = vec3_clamp_length(velocity, PHYS_MAX_LINEAR_VELOCITY);
+    angular_velocity = vec3_clamp_length(angular_velocity, PHYS_MAX_ANGULAR_VELOCITY);
+    physics_body_store_velocity(world, body_index, velocity);
+    physics_body_store_angular_velocity(world, body_index, angular_velocity);
 
-    body->velocity = vec3_clamp_length(body->velocity, PHYS_MAX_LINEAR_VELOCITY);
-    body->angular_velocity = vec3_clamp_length(body->angular_velocity, PHYS_MAX_ANGULAR_VELOCITY);
+    VoxelObjectPose pose = voxel_object_pose(world->objects, vobj_index);
+    pose.position = vec3_add(pose.position, vec3_scale(velocity, dt));
 
-    obj->position = vec3_add(obj->position, vec3_scale(body->velocity, dt));
-    obj->orientation = quat_integrate(obj->orientation, body->angular_velocity, dt);
+    /* Tick by tick, gravity gained in later ticks moves the body for less time */
+    if (!grounded && ticks > 1.0f)
+        pose.position = vec3_sub(pose.position, vec3_scale(world->gravity, 0.5f * dt * (dt - tick_dt)));
+    pose.orientation = quat_integrate(pose.orientation, angular_velocity, dt);
+    voxel_object_set_pose(world->objects, vobj_index, pose);
+}
+
+#if PHYS_BODY_LANES > 1
+
+#if PHYS_BODY_LANES == 8
+typedef __m256 BodyLanes;
+static inline BodyLanes lanes_load(const float *p) { return _mm256_loadu_ps(p); }
+static inline void lanes_store(float *p, BodyLanes v) { _mm256_storeu_ps(p, v); }
+static inline BodyLanes lanes_set1(float f) { return _mm256_set1_ps(f); }
+static inline BodyLanes lanes_add(BodyLanes a, BodyLanes b) { return _mm256_add_ps(a, b); }
+static inline BodyLanes lanes_sub(BodyLanes a, BodyLanes b) { return _mm256_sub_ps(a, b); }
+static inline BodyLanes lanes_mul(BodyLanes a, BodyLanes b) { return _mm256_mul_ps(a, b); }
+static inline BodyLanes lanes_div(BodyLanes a, BodyLanes b) { return _mm256_div_ps(a, b); }
+static inline BodyLanes lanes_sqrt(BodyLanes a) { return _mm256_sqrt_ps(a); }
+static inline BodyLanes lanes_neg(BodyLanes a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+static inline BodyLanes lanes_gt(BodyLanes a, BodyLanes b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+static inline BodyLanes lanes_lt(BodyLanes a, BodyLanes b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+static inline BodyLanes lanes_and(BodyLanes a, BodyLanes b) { return _mm256_and_ps(a, b); }
+static inline BodyLanes lanes_select(BodyLanes mask, BodyLanes a, BodyLanes b) { return _mm256_blendv_ps(b, a, mask); }
+static inline int lanes_bits(BodyLanes mask) { return _mm256_movemask_ps(mask); }
+/* All bits set in lane l when bit l of bits is */
+static inline BodyLanes lanes_from_bits(int32_t bits) {
+    const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i set = _mm256_and_si256(_mm256_set1_epi32(bits), lane_bits);
+    return _mm256_castsi256_ps(_mm256_cmpeq_epi32(set, lane_bits));
+}
+#else
+typedef __m128 BodyLanes;
+static inline BodyLanes lanes_load(const float *p) { return _mm_loadu_ps(p); }
+static inline void lanes_store(float *p, BodyLanes v) { _mm_storeu_ps(p, v); }
+static inline BodyLanes lanes_set1(float f) { return _mm_set1_ps(f); }
+static inline BodyLanes lanes_add(BodyLanes a, BodyLanes b) { return _mm_add_ps(a, b); }
+static inline BodyLanes lanes_sub(BodyLanes a, BodyLanes b) { return _mm_sub_ps(a, b); }
+static inline BodyLanes lanes_mul(BodyLanes a, BodyLanes b) { return _mm_mul_ps(a, b); }
+static inline BodyLanes lanes_div(BodyLanes a, BodyLanes b) { return _mm_div_ps(a, b); }
+static inline BodyLanes lanes_sqrt(BodyLanes a) { return _mm_sqrt_ps(a); }
+static inline BodyLanes lanes_neg(BodyLanes a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+static inline BodyLanes lanes_gt(BodyLanes a, BodyLanes b) { return _mm_cmpgt_ps(a, b); }
+static inline BodyLanes lanes_lt(BodyLanes a, BodyLanes b) { return _mm_cmplt_ps(a, b); }
+static inline BodyLanes lanes_and(BodyLanes a, BodyLanes b) { return _mm_and_ps(a, b); }
+static inline BodyLanes lanes_select(BodyLanes mask, BodyLanes a, BodyLanes b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+static inline int lanes_bits(BodyLanes mask) { return _mm_movemask_ps(mask); }
+static inline BodyLanes lanes_from_bits(int32_t bits) {
+    const __m128i lane_bits = _mm_setr_epi32(1, 2, 4, 8);
+    __m128i set = _mm_and_si128(_mm_set1_epi32(bits), lane_bits);
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(set, lane_bits));
 }
+#endif
 
-static void update_sleep_state(PhysicsWorld *world, int32_t body_index)
+/* Scales each lane's vector down to max_len when longer, as vec3_clamp_length */
+static inline void lanes_clamp_length(BodyLanes *x, BodyLanes *y, BodyLanes *z, float max_len)
 {
-    RigidBody *body = &world->bodies[body_index];
-    if (!(body->flags & PHYS_FLAG_ACTIVE))
+    BodyLanes len_sq = lanes_add(lanes_add(lanes_mul(*x, *x), lanes_mul(*y, *y)), lanes_mul(*z, *z));
+    BodyLanes over = lanes_and(lanes_gt(len_sq, lanes_set1(max_len * max_len)),
+                               lanes_gt(len_sq, lanes_set1(K_EPSILON * K_EPSILON)));
+    if (!lanes_bits(over))
         return;
+    BodyLanes scale = lanes_mul(lanes_set1(max_len), lanes_div(lanes_set1(1.0f), lanes_sqrt(len_sq)));
+    *x = lanes_select(over, lanes_mul(*x, scale), *x);
+    *y = lanes_select(over, lanes_mul(*y, scale), *y);
+    *z = lanes_select(over, lanes_mul(*z, scale), *z);
+}
+
+/*
+ * Integrates the bodies marked in batch[] (awake, dynamic, one plain sweep
+ * this step) over whole lane blocks of slots [0, limit): gravity, damping,
+ * speed clamps, then position and orientation. Poses are gathered from and
+ * scattered back to the objects. Same operations in the same order as
+ * integrate_body with dt == tick_dt, so results match it bit for bit.
+ */
+static void integrate_batch(PhysicsWorld *world, const uint8_t *batch, int32_t limit, float dt)
+{
+    VoxelObjectPoses *poses = &world->objects->poses;
+    const BodyLanes one = lanes_set1(1.0f);
+    const BodyLanes gx = lanes_set1(world->gravity.x);
+    const BodyLanes gy = lanes_set1(world->gravity.y);
+    const BodyLanes gz = lanes_set1(world->gravity.z);
+    const BodyLanes h = lanes_set1(dt);
+    const BodyLanes half_h = lanes_set1(dt * 0.5f);
+    const BodyLanes air_linear = lanes_set1(PHYS_LINEAR_DAMPING);
+    const BodyLanes air_angular = lanes_set1(PHYS_ANGULAR_DAMPING);
+    const BodyLanes ground_linear = lanes_set1(PHYS_GROUND_LINEAR_DAMPING);
+    const BodyLanes ground_angular = lanes_set1(PHYS_GROUND_ANGULAR_DAMPING);
+    const BodyLanes min_len = lanes_set1(K_EPSILON);
+
+    for (int32_t i = 0; i < limit; i += PHYS_BODY_LANES)
+    {
+        int32_t due = 0, grounded_bits = 0;
+        int32_t vobj[PHYS_BODY_LANES];
+        for (int32_t l = 0; l < PHYS_BODY_LANES; l++)
+        {
+            due |= (batch[i + l] != 0) << l;
+            grounded_bits |= ((world->flags[i + l] & PHYS_FLAG_GROUNDED) != 0) << l;
+            vobj[l] = world->bodies[i + l].vobj_index;
+        }
+        if (!due)
+            continue;
+        BodyLanes moving = lanes_from_bits(due);
+        BodyLanes grounded = lanes_from_bits(grounded_bits);
+
+        BodyLanes vx = lanes_load(&world->velocity.x[i]);
+        BodyLanes vy = lanes_load(&world->velocity.y[i]);
+        BodyLanes vz = lanes_load(&world->velocity.z[i]);
+        BodyLanes wx = lanes_load(&world->angular_velocity.x[i]);
+        BodyLanes wy = lanes_load(&world->angular_velocity.y[i]);
+        BodyLanes wz = lanes_load(&world->angular_velocity.z[i]);
+
+        vx = lanes_select(grounded, vx, lanes_add(vx, lanes_mul(gx, h)));
+        vy = lanes_select(grounded, vy, lanes_add(vy, lanes_mul(gy, h)));
+        vz = lanes_select(grounded, vz, lanes_add(vz, lanes_mul(gz, h)));
+
+        BodyLanes linear_damp = lanes_select(grounded, ground_linear, air_linear);
+        BodyLanes angular_damp = lanes_select(grounded, ground_angular, air_angular);
+        vx = lanes_mul(vx, linear_damp);
+        vy = lanes_mul(vy, linear_damp);
+        vz = lanes_mul(vz, linear_damp);
+        wx = lanes_mul(wx, angular_damp);
+        wy = lanes_mul(wy, angular_damp);
+        wz = lanes_mul(wz, angular_damp);
+
+        lanes_clamp_length(&vx, &vy, &vz, PHYS_MAX_LINEAR_VELOCITY);
+        lanes_clamp_length(&wx, &wy, &wz, PHYS_MAX_ANGULAR_VELOCITY);
+
+        lanes_store(&world->velocity.x[i], lanes_select(moving, vx, lanes_load(&world->velocity.x[i])));
+        lanes_store(&world->velocity.y[i], lanes_select(moving, vy, lanes_load(&world->velocity.y[i])));
+        lanes_store(&world->velocity.z[i], lanes_select(moving, vz, lanes_load(&world->velocity.z[i])));
+        lanes_store(&world->angular_velocity.x[i],
+                    lanes_select(moving, wx, lanes_load(&world->angular_velocity.x[i])));
+        lanes_store(&world->angular_velocity.y[i],
+                    lanes_select(moving, wy, lanes_load(&world->angular_velocity.y[i])));
+        lanes_store(&world->angular_velocity.z[i],
+                    lanes_select(moving, wz, lanes_load(&world->angular_velocity.z[i])));
+
+        /* Poses are indexed by object: gather the due lanes, idle lanes integrate an identity pose */
+        float pose[7][PHYS_BODY_LANES];
+        for (int32_t l = 0; l < PHYS_BODY_LANES; l++)
+        {
+            bool lane_due = (due >> l) & 1;
+            int32_t o = vobj[l];
+            pose[0][l] = lane_due ? poses->px[o] : 0.0f;
+            pose[1][l] = lane_due ? poses->py[o] : 0.0f;
+            pose[2][l] = lane_due ? poses->pz[o] : 0.0f;
+            pose[3][l] = lane_due ? poses->qx[o] : 0.0f;
+            pose[4][l] = lane_due ? poses->qy[o] : 0.0f;
+            pose[5][l] = lane_due ? poses->qz[o] : 0.0f;
+            pose[6][l] = lane_due ? poses->qw[o] : 1.0f;
+        }
+
+        lanes_store(pose[0], lanes_add(lanes_load(pose[0]), lanes_mul(vx, h)));
+        lanes_store(pose[1], lanes_add(lanes_load(pose[1]), lanes_mul(vy, h)));
+        lanes_store(pose[2], lanes_add(lanes_load(pose[2]), lanes_mul(vz, h)));
+
+        /* quat_integrate */
+        BodyLanes qx = lanes_load(pose[3]);
+        BodyLanes qy = lanes_load(pose[4]);
+        BodyLanes qz = lanes_load(pose[5]);
+        BodyLanes qw = lanes_load(pose[6]);
+        BodyLanes dx = lanes_mul(half_h, lanes_sub(lanes_add(lanes_mul(wx, qw), lanes_mul(wy, qz)), lanes_mul(wz, qy)));
+        BodyLanes dy = lanes_mul(half_h, lanes_sub(lanes_add(lanes_mul(wy, qw), lanes_mul(wz, qx)), lanes_mul(wx, qz)));
+        BodyLanes dz = lanes_mul(half_h, lanes_sub(lanes_add(lanes_mul(wz, qw), lanes_mul(wx, qy)), lanes_mul(wy, qx)));
+        BodyLanes dw = lanes_mul(half_h, lanes_sub(lanes_sub(lanes_mul(lanes_neg(wx), qx), lanes_mul(wy, qy)),
+                                                   lanes_mul(wz, qz)));
+        qx = lanes_add(qx, dx);
+        qy = lanes_add(qy, dy);
+        qz = lanes_add(qz, dz);
+        qw = lanes_add(qw, dw);
+
+        /* quat_normalize */
+        BodyLanes len = lanes_sqrt(lanes_add(lanes_add(lanes_add(lanes_mul(qx, qx), lanes_mul(qy, qy)),
+                                                       lanes_mul(qz, qz)),
+                                             lanes_mul(qw, qw)));
+        BodyLanes normalize = lanes_gt(len, min_len);
+        BodyLanes inv = lanes_div(one, len);
+        lanes_store(pose[3], lanes_select(normalize, lanes_mul(qx, inv), qx));
+        lanes_store(pose[4], lanes_select(normalize, lanes_mul(qy, inv), qy));
+        lanes_store(pose[5], lanes_select(normalize, lanes_mul(qz, inv), qz));
+        lanes_store(pose[6], lanes_select(normalize, lanes_mul(qw, inv), qw));
+
+        for (int32_t l = 0; l < PHYS_BODY_LANES; l++)
+        {
+            if (!((due >> l) & 1))
+                continue;
+            int32_t o = vobj[l];
+            poses->px[o] = pose[0][l];
+            poses->py[o] = pose[1][l];
+            poses->pz[o] = pose[2][l];
+            poses->qx[o] = pose[3][l];
+            poses->qy[o] = pose[4][l];
+            poses->qz[o] = pose[5][l];
+            poses->qw[o] = pose[6][l];
+        }
+    }
+}
+
+/* quiet[i] = 1 when slot i moves slower than both sleep thresholds, over lane blocks of [0, limit) */
+static void sleep_quiet_batch(const PhysicsWorld *world, uint8_t *quiet, int32_t limit)
+{
+    const BodyLanes linear_limit = lanes_set1(PHYS_SLEEP_LINEAR_THRESHOLD);
+    const BodyLanes angular_limit = lanes_set1(PHYS_SLEEP_ANGULAR_THRESHOLD);
+    for (int32_t i = 0; i < limit; i += PHYS_BODY_LANES)
+    {
+        BodyLanes vx = lanes_load(&world->velocity.x[i]);
+        BodyLanes vy = lanes_load(&world->velocity.y[i]);
+        BodyLanes vz = lanes_load(&world->velocity.z[i]);
+        BodyLanes wx = lanes_load(&world->angular_velocity.x[i]);
+        BodyLanes wy = lanes_load(&world->angular_velocity.y[i]);
+        BodyLanes wz = lanes_load(&world->angular_velocity.z[i]);
+        BodyLanes linear = lanes_sqrt(lanes_add(lanes_add(lanes_mul(vx, vx), lanes_mul(vy, vy)), lanes_mul(vz, vz)));
+        BodyLanes angular = lanes_sqrt(lanes_add(lanes_add(lanes_mul(wx, wx), lanes_mul(wy, wy)), lanes_mul(wz, wz)));
+        int bits = lanes_bits(lanes_and(lanes_lt(linear, linear_limit), lanes_lt(angular, angular_limit)));
+        for (int32_t l = 0; l < PHYS_BODY_LANES; l++)
+            quiet[i + l] = (uint8_t)((bits >> l) & 1);
+    }
+}
+
+#else
+
+static void integrate_batch(PhysicsWorld *world, const uint8_t *batch, int32_t limit, float dt)
+{
+    for (int32_t i = 0; i < limit; i++)
+    {
+        if (batch[i])
+            integrate_body(world, i, dt, dt);
+    }
+}
+
+static void sleep_quiet_batch(const PhysicsWorld *world, uint8_t *quiet, int32_t limit)
+{
+    for (int32_t i = 0; i < limit; i++)
+    {
+        float linear_speed = vec3_length(physics_body_velocity(world, i));
+        float angular_speed = vec3_length(physics_body_angular_velocity(world, i));
+        quiet[i] = linear_speed < PHYS_SLEEP_LINEAR_THRESHOLD && angular_speed < PHYS_SLEEP_ANGULAR_THRESHOLD;
+    }
+}
+
+#endif
+
+/* Quiet time is counted in ticks, so a far body's catch-up update counts for all it covered */
+static void add_quiet_ticks(RigidBody *body, int32_t ticks)
+{
+    int32_t frames = body->sleep_frames + (ticks > 0 ? ticks : 1);
+    body->sleep_frames = (uint8_t)(frames < PHYS_SLEEP_FRAMES ? frames : PHYS_SLEEP_FRAMES);
+}
+
+static void put_to_sleep(PhysicsWorld *world, int32_t body_index)
+{
+    world->flags[body_index] |= PHYS_FLAG_SLEEPING;
+    physics_body_store_velocity(world, body_index, vec3_zero());
+    physics_body_store_angular_velocity(world, body_index, vec3_zero());
+}
 
-    if (body->flags & PHYS_FLAG_STATIC)
+/* quiet: below both sleep thresholds (sleep_quiet_batch) */
+static void update_sleep_state(PhysicsWorld *world, int32_t body_index, int32_t ticks, bool quiet)
+{
+    RigidBody *body = &world->bodies[body_index];
+    uint8_t flags = world->flags[body_index];
+    if (!(flags & PHYS_FLAG_ACTIVE))
         return;
 
-    float linear_speed = vec3_length(body->velocity);
-    float angular_speed = vec3_length(body->angular_velocity);
+    if (flags & PHYS_FLAG_STATIC)
+        return;
 
-    bool velocity_low = linear_speed < PHYS_SLEEP_LINEAR_THRESHOLD &&
-                        angular_speed < PHYS_SLEEP_ANGULAR_THRESHOLD;
-    bool has_support = (body->flags & (PHYS_FLAG_STABLE | PHYS_FLAG_OBJ_CONTACT)) != 0;
+    bool has_support = (flags & (PHYS_FLAG_STABLE | PHYS_FLAG_OBJ_CONTACT)) != 0;
 
-    if (velocity_low && has_support)
+    if (quiet && has_support)
     {
-        body->sleep_frames++;
+        add_quiet_ticks(body, ticks);
         if (body->sleep_frames >= PHYS_SLEEP_FRAMES)
-        {
-            body->flags |= PHYS_FLAG_SLEEPING;
-            body->velocity = vec3_zero();
-            body->angular_velocity = vec3_zero();
-        }
+            put_to_sleep(world, body_index);
     }
     else
     {
         body->sleep_frames = 0;
-        body->flags &= ~PHYS_FLAG_SLEEPING;
+        world->flags[body_index] &= ~PHYS_FLAG_SLEEPING;
+    }
+}
+
+/* Counts quiet frames; true once the body could sleep on its own */
+static bool island_body_ready(PhysicsWorld *world, int32_t body_index, int32_t ticks, bool quiet)
+{
+    RigidBody *body = &world->bodies[body_index];
+    bool has_support = (world->flags[body_index] & (PHYS_FLAG_STABLE | PHYS_FLAG_OBJ_CONTACT)) != 0;
+
+    if (!quiet || !has_support)
+    {
+        body->sleep_frames = 0;
+        return false;
+    }
+    add_quiet_ticks(body, ticks);
+    return body->sleep_frames >= PHYS_SLEEP_FRAMES;
+}
+
+/* An island sleeps only as a whole, so a settled body never sleeps under a moving one */
+static void update_island_sleep_state(PhysicsWorld *world, int32_t island, const uint8_t *step_ticks,
+                                      const uint8_t *quiet)
+{
+    const PhysicsIslands *islands = world->islands;
+    int32_t begin = islands->body_start[island];
+    int32_t end = islands->body_start[island + 1];
+
+    bool all_ready = true;
+    for (int32_t k = begin; k < end; k++)
+    {
+        int32_t i = islands->bodies[k];
+        if (!(world->flags[i] & PHYS_FLAG_ACTIVE) || (world->flags[i] & PHYS_FLAG_STATIC))
+            continue;
+        if (!island_body_ready(world, i, step_ticks[i], quiet[i]))
+            all_ready = false;
+    }
+
+    for (int32_t k = begin; k < end; k++)
+    {
+        int32_t i = islands->bodies[k];
+        if (!(world->flags[i] & PHYS_FLAG_ACTIVE) || (world->flags[i] & PHYS_FLAG_STATIC))
+            continue;
+
+        if (all_ready)
+            put_to_sleep(world, i);
+        else
+            world->flags[i] &= ~PHYS_FLAG_SLEEPING;
+    }
+}
+
+typedef struct
+{
+    const ObjectCollisionPair *pairs;
+    const int32_t *pair_manifold; /* -1 = cache full, single-point resolve; -2 = duplicate */
+    const bool *terrain_swept;    /* Terrain already solved on every sweep of the integration */
+    float dt;
+} IslandSolveContext;
+
+/*
+ * Same per-body operation order as a serial pass over all pairs followed by
+ * all terrain contacts, since no body belongs to two islands.
+ */
+static void solve_island(PhysicsWorld *world, int32_t island, void *ctx)
+{
+    const IslandSolveContext *solve = (const IslandSolveContext *)ctx;
+    const PhysicsIslands *islands = world->islands;
+
+    int32_t manifolds[PHYS_ISLAND_MAX_PAIRS];
+    int32_t manifold_count = 0;
+    for (int32_t k = islands->pair_start[island]; k < islands->pair_start[island + 1]; k++)
+    {
+        int32_t m = solve->pair_manifold[islands->pairs[k]];
+        if (m >= 0)
+            manifolds[manifold_count++] = m;
+    }
+    physics_manifolds_solve(world, world->manifolds, manifolds, manifold_count, solve->dt);
+
+    for (int32_t k = islands->pair_start[island]; k < islands->pair_start[island + 1]; k++)
+    {
+        if (solve->pair_manifold[islands->pairs[k]] != -1)
+            continue;
+        ObjectCollisionPair pair = solve->pairs[islands->pairs[k]];
+        physics_resolve_object_collision(world, &pair, solve->dt);
+    }
+
+    if (!world->terrain)
+        return;
+
+    for (int32_t k = islands->body_start[island]; k < islands->body_start[island + 1]; k++)
+    {
+        int32_t i = islands->bodies[k];
+        uint8_t flags = world->flags[i];
+        if (!(flags & PHYS_FLAG_ACTIVE) || (flags & PHYS_FLAG_SLEEPING))
+            continue;
+        if (solve->terrain_swept[i])
+            continue;
+
+        solve_terrain_collision(world, i, solve->dt, solve->dt);
     }
 }
 
-static void update_broadphase(PhysicsWorld *world)
+/* One sweep unless the body would move more than its thinnest extent this step */
+static int32_t body_sweep_count(PhysicsWorld *world, int32_t body_index, float dt)
+{
+    RigidBody *body = &world->bodies[body_index];
+    world->flags[body_index] &= ~PHYS_FLAG_FAST;
+    if (world->flags[body_index] & (PHYS_FLAG_STATIC | PHYS_FLAG_KINEMATIC))
+        return 1;
+
+    float speed = vec3_length(physics_body_velocity(world, body_index));
+    if (speed <= PHYS_SUBSTEP_VELOCITY_THRESHOLD)
+        return 1;
+    world->flags[body_index] |= PHYS_FLAG_FAST;
+
+    VoxelObject *obj = &world->objects->objects[body->vobj_index];
+    float min_extent = minf(obj->shape_half_extents.x,
+                            minf(obj->shape_half_extents.y, obj->shape_half_extents.z)) * 2.0f;
+    if (min_extent <= K_EPSILON)
+        return 1;
+
+    int32_t needed = (int32_t)ceilf(speed * dt / min_extent);
+    if (needed < 1)
+        needed = 1;
+    return needed > PHYS_MAX_SUBSTEPS ? PHYS_MAX_SUBSTEPS : needed;
+}
+
+/*
+ * Sweeps for a far body's catch-up update near terrain: one per voxel its
+ * surface moves, up to one per tick, so contacts are met as shallow as a
+ * full-rate body meets them. In flight, one sweep covers all its ticks.
+ */
+static int32_t catch_up_sweep_count(PhysicsWorld *world, int32_t body_index, float dt, int32_t ticks)
+{
+    if (!world->terrain)
+        return 1;
+
+    RigidBody *body = &world->bodies[body_index];
+    VoxelObject *obj = &world->objects->objects[body->vobj_index];
+    float voxel_size = world->terrain->voxel_size;
+    Vec3 velocity = physics_body_velocity(world, body_index);
+    float travel = (vec3_length(velocity) + vec3_length(physics_body_angular_velocity(world, body_index)) * obj->radius) * dt;
+    if (travel <= voxel_size)
+        return 1;
+
+    float reach = obj->radius + voxel_size;
+    Vec3 sweep = vec3_scale(velocity, dt);
+    Vec3 position = voxel_object_position(world->objects, body->vobj_index);
+    Vec3 aabb_min = vec3_sub(position, vec3_create(reach, reach, reach));
+    Vec3 aabb_max = vec3_add(position, vec3_create(reach, reach, reach));
+    aabb_min = vec3_add(aabb_min, vec3_create(minf(sweep.x, 0.0f), minf(sweep.y, 0.0f), minf(sweep.z, 0.0f)));
+    aabb_max = vec3_add(aabb_max, vec3_create(maxf(sweep.x, 0.0f), maxf(sweep.y, 0.0f), maxf(sweep.z, 0.0f)));
+    if (physics_terrain_box_empty(world->terrain, aabb_min, aabb_max))
+        return 1;
+
+    int32_t needed = (int32_t)ceilf(travel / voxel_size);
+    return needed < ticks ? needed : ticks;
+}
+
+/*
+ * Fast bodies get bounds swept over the next step so speculative pairs are
+ * found. Sleepers do not move, so their endpoints and pairs are left as is.
+ */
+static void update_broadphase(PhysicsWorld *world, float dt)
 {
     if (!world->broadphase)
         return;
 
     int32_t limit = world->max_body_index + 1;
     VoxelObjectWorld *obj_world = world->objects;
+    sap_clear_events(world->broadphase);
 
     for (int32_t i = 0; i < limit; i++)
     {
         RigidBody *body = &world->bodies[i];
-        bool active = (body->flags & PHYS_FLAG_ACTIVE) != 0;
+        uint8_t flags = world->flags[i];
+        bool active = (flags & PHYS_FLAG_ACTIVE) != 0;
+
+        if (active && (flags & PHYS_FLAG_SLEEPING))
+            continue;
 
         if (active)
         {
@@ -763,9 +1142,17 @@ static void update_broadphase(PhysicsWorld *world)
             if (obj->active)
             {
                 Vec3 he = obj->shape_half_extents;
-                Vec3 pos = obj->position;
+                Vec3 pos = voxel_object_position(obj_world, body->vobj_index);
                 Vec3 aabb_min = vec3_sub(pos, he);
                 Vec3 aabb_max = vec3_add(pos, he);
+                if (flags & PHYS_FLAG_FAST)
+                {
+                    Vec3 sweep = vec3_scale(physics_body_velocity(world, i), dt);
+                    aabb_min = vec3_add(aabb_min, vec3_create(minf(sweep.x, 0.0f), minf(sweep.y, 0.0f),
+                                                              minf(sweep.z, 0.0f)));
+                    aabb_max = vec3_add(aabb_max, vec3_create(maxf(sweep.x, 0.0f), maxf(sweep.y, 0.0f),
+                                                              maxf(sweep.z, 0.0f)));
+                }
                 sap_update_body(world->broadphase, i, aabb_min, aabb_max, true);
             }
             else
@@ -780,81 +1167,360 @@ static void update_broadphase(PhysicsWorld *world)
     }
 }
 
-void physics_world_step(PhysicsWorld *world, float dt)
+void physics_world_rebuild_broadphase(PhysicsWorld *world)
 {
-    if (!world || !world->objects)
+    if (!world || !world->broadphase)
         return;
 
-    PROFILE_BEGIN(PROFILE_SIM_PHYSICS);
+    for (int32_t i = 0; i < PHYS_MAX_BODIES; i++)
+    {
+        const RigidBody *body = &world->bodies[i];
+        const VoxelObject *obj = (i <= world->max_body_index && (world->flags[i] & PHYS_FLAG_ACTIVE))
+                                     ? &world->objects->objects[body->vobj_index]
+                                     : NULL;
+        if (obj && obj->active)
+        {
+            Vec3 position = voxel_object_position(world->objects, body->vobj_index);
+            sap_update_body(world->broadphase, i, vec3_sub(position, obj->shape_half_extents),
+                            vec3_add(position, obj->shape_half_extents), true);
+        }
+        else
+            sap_remove_body(world->broadphase, i);
+    }
+}
 
-    int32_t limit = world->max_body_index + 1;
+/*
+ * Terrain edits only matter to supported bodies near them. When the terrain
+ * changed since the last step, each supported body compares the chunk
+ * versions around it; on a change, one full sample decides whether it still
+ * rests on stable ground. Bodies that lost it are woken and fall.
+ */
+static void refresh_terrain_support(PhysicsWorld *world)
+{
+    if (!world->terrain || world->terrain->version_counter == world->terrain_version)
+        return;
+    world->terrain_version = world->terrain->version_counter;
 
-    for (int32_t i = 0; i < limit; i++)
+    for (int32_t k = 0; k < world->body_count; k++)
     {
-        if (world->bodies[i].flags & PHYS_FLAG_ACTIVE)
-            world->bodies[i].flags &= ~PHYS_FLAG_OBJ_CONTACT;
+        int32_t i = world->active_bodies[k];
+        RigidBody *body = &world->bodies[i];
+        if (body->support_version == 0)
+            continue;
+
+        VoxelObject *obj = &world->objects->objects[body->vobj_index];
+        uint32_t version = body_support_version(world, body);
+        if (version == body->support_version)
+            continue;
+
+        TerrainContactSet contacts;
+        physics_terrain_contacts(world->terrain, obj, voxel_object_pose(world->objects, body->vobj_index), &contacts);
+        bool stable = support_is_stable(obj, vobj_world_com(world, i), contacts.support_centroid);
+        if (contacts.ground_count > 0 && (stable || !(world->flags[i] & PHYS_FLAG_STABLE)))
+        {
+            body->support_version = version;
+            continue;
+        }
+
+        body->support_version = 0;
+        world->flags[i] &= ~(PHYS_FLAG_GROUNDED | PHYS_FLAG_STABLE);
+        body->ground_frames = 0;
+        physics_body_wake(world, i);
     }
+}
 
-    int32_t substeps = 1;
-    for (int32_t i = 0; i < limit; i++)
+/*
+ * Wake propagation over the contact graph: a sleeper resting on an awake
+ * body may lose its support, so it wakes, and so does whatever rests on it.
+ * Side and lower neighbours stay asleep; they wake only if an impact
+ * reaches them (PHYS_WAKE_IMPULSE_THRESHOLD). Runs before anything moves, on
+ * last step's manifolds.
+ */
+static void wake_supported_sleepers(PhysicsWorld *world)
+{
+    const PhysicsManifolds *manifolds = world->manifolds;
+    bool changed = true;
+    while (changed)
     {
-        uint8_t flags = world->bodies[i].flags;
-        if (!(flags & PHYS_FLAG_ACTIVE) || (flags & PHYS_FLAG_SLEEPING))
+        changed = false;
+        for (int32_t m = 0; m < manifolds->count; m++)
+        {
+            const ContactManifold *manifold = &manifolds->manifolds[m];
+            if (fabsf(manifold->normal.y) <= 0.5f)
+                continue;
+
+            /* Normal points from A to B: the body on top is the supported one */
+            int32_t upper = manifold->normal.y > 0.0f ? manifold->body_b : manifold->body_a;
+            int32_t lower = manifold->normal.y > 0.0f ? manifold->body_a : manifold->body_b;
+            uint8_t upper_flags = world->flags[upper];
+            uint8_t lower_flags = world->flags[lower];
+            if (!(upper_flags & PHYS_FLAG_SLEEPING) ||
+                (lower_flags & (PHYS_FLAG_SLEEPING | PHYS_FLAG_STATIC)) || !(lower_flags & PHYS_FLAG_ACTIVE))
+                continue;
+
+            physics_body_wake(world, upper);
+            changed = true;
+        }
+    }
+}
+
+/*
+ * Picks the awake bodies that skip this tick. They are held as sleepers
+ * (SLEEPING set) until the solve is over, so nothing integrates, sweeps or
+ * solves them and contacts treat them as static. Their next update covers
+ * the skipped ticks too.
+ */
+static void schedule_lod(PhysicsWorld *world, bool *deferred)
+{
+    PhysicsSimLod *lod = world->lod;
+    if (!lod)
+        return;
+
+    world->lod_tick++;
+    memset(lod->body_updates, 0, sizeof(lod->body_updates));
+    lod->body_deferred = 0;
+    lod->body_promoted = 0;
+
+    for (int32_t k = 0; k < world->body_count; k++)
+    {
+        int32_t i = world->active_bodies[k];
+        RigidBody *body = &world->bodies[i];
+        if (world->flags[i] & (PHYS_FLAG_SLEEPING | PHYS_FLAG_STATIC | PHYS_FLAG_KINEMATIC))
+            continue;
+
+        VoxelObject *obj = &world->objects->objects[body->vobj_index];
+        if (!obj->active)
             continue;
 
-        float speed = vec3_length(world->bodies[i].velocity);
-        if (speed > PHYS_SUBSTEP_VELOCITY_THRESHOLD)
+        uint8_t level = 0;
+        if (body->lod_hold > 0)
+            body->lod_hold--;
+        else
+            level = physics_lod_level(lod, voxel_object_position(world->objects, body->vobj_index), obj->radius);
+        body->lod_level = level;
+
+        if (physics_lod_due(world->lod_tick, i, level, body->lod_pending))
         {
-            VoxelObject *obj = &world->objects->objects[world->bodies[i].vobj_index];
-            float min_extent = minf(obj->shape_half_extents.x,
-                                    minf(obj->shape_half_extents.y,
-                                         obj->shape_half_extents.z)) * 2.0f;
-            if (min_extent > K_EPSILON)
-            {
-                int32_t needed = (int32_t)ceilf(speed * dt / min_extent);
-                if (needed > substeps)
-                    substeps = needed;
-            }
+            lod->body_updates[level]++;
+            continue;
         }
+
+        body->lod_pending++;
+        world->flags[i] |= PHYS_FLAG_SLEEPING;
+        deferred[i] = true;
+        lod->body_deferred++;
     }
-    if (substeps > PHYS_MAX_SUBSTEPS)
-        substeps = PHYS_MAX_SUBSTEPS;
+}
 
-    float sub_dt = dt / (float)substeps;
+/*
+ * Ends the hold on deferred bodies. A deferred body that was woken during
+ * the step (a moving body touched it, or an impact was strong enough) has
+ * been promoted and stays at full rate for PHYS_LOD_PROMOTE_TICKS.
+ */
+static void release_lod(PhysicsWorld *world, const bool *deferred)
+{
+    PhysicsSimLod *lod = world->lod;
+    if (!lod)
+        return;
 
-    for (int32_t s = 0; s < substeps; s++)
+    for (int32_t k = 0; k < world->body_count; k++)
     {
-        for (int32_t i = 0; i < limit; i++)
-        {
-            uint8_t flags = world->bodies[i].flags;
-            if (!(flags & PHYS_FLAG_ACTIVE) || (flags & PHYS_FLAG_SLEEPING))
-                continue;
+        int32_t i = world->active_bodies[k];
+        if (!deferred[i])
+            continue;
 
-            integrate_body(world, i, sub_dt);
+        RigidBody *body = &world->bodies[i];
+        if (world->flags[i] & PHYS_FLAG_SLEEPING)
+        {
+            world->flags[i] &= ~PHYS_FLAG_SLEEPING;
+            continue;
         }
+        body->lod_hold = PHYS_LOD_PROMOTE_TICKS;
+        lod->body_promoted++;
+    }
+
+    PROFILE_COUNTER_SET(PROFILE_COUNTER_LOD_BODY_FULL, lod->body_updates[0]);
+    PROFILE_COUNTER_SET(PROFILE_COUNTER_LOD_BODY_HALF, lod->body_updates[1]);
+    PROFILE_COUNTER_SET(PROFILE_COUNTER_LOD_BODY_QUARTER, lod->body_updates[2]);
+    PROFILE_COUNTER_SET(PROFILE_COUNTER_LOD_BODY_DEFERRED, lod->body_deferred);
+    PROFILE_COUNTER_SET(PROFILE_COUNTER_LOD_BODY_PROMOTED, lod->body_promoted);
+}
+
+void physics_world_step(PhysicsWorld *world, float dt)
+{
+    if (!world || !world->objects)
+        return;
+
+    PROFILE_BEGIN(PROFILE_SIM_PHYSICS);
+
+    refresh_terrain_support(world);
+    wake_supported_sleepers(world);
+
+    int32_t limit = world->max_body_index + 1;
+    int32_t lane_limit = (limit + PHYS_BODY_LANES - 1) / PHYS_BODY_LANES * PHYS_BODY_LANES;
+    bool deferred[PHYS_MAX_BODIES] = {false};
+    bool terrain_swept[PHYS_MAX_BODIES] = {false};
+    uint8_t step_ticks[PHYS_MAX_BODIES] = {0}; /* Ticks this step's update covered, 0 = not integrated */
+    uint8_t batch[PHYS_MAX_BODIES] = {0};      /* One plain sweep: integrated together by integrate_batch */
+    schedule_lod(world, deferred);
+
+    /* Backwards: a removed body's list entry is taken by one already visited */
+    for (int32_t k = world->body_count - 1; k >= 0; k--)
+    {
+        int32_t i = world->active_bodies[k];
+        RigidBody *body = &world->bodies[i];
+        if (world->flags[i] & PHYS_FLAG_SLEEPING)
+            continue;
+
+        /* Sleepers keep their object support: nothing re-detects contacts between them */
+        world->flags[i] &= ~PHYS_FLAG_OBJ_CONTACT;
 
-        update_broadphase(world);
-        physics_process_object_collisions(world, sub_dt);
+        /* A far body's update also covers the ticks it skipped */
+        int32_t ticks = body->lod_pending + 1;
+        body->lod_pending = 0;
 
-        if (world->terrain)
+        /* Fast and catching-up bodies sweep; each sweep checks terrain so thin walls hold */
+        int32_t sweeps = body_sweep_count(world, i, dt * (float)ticks);
+        if (ticks > 1 && sweeps < ticks)
         {
-            for (int32_t i = 0; i < limit; i++)
-            {
-                uint8_t flags = world->bodies[i].flags;
-                if (!(flags & PHYS_FLAG_ACTIVE) || (flags & PHYS_FLAG_SLEEPING))
-                    continue;
+            int32_t catch_up = catch_up_sweep_count(world, i, dt * (float)ticks, ticks);
+            if (sweeps < catch_up)
+                sweeps = catch_up;
+        }
+        terrain_swept[i] = (world->flags[i] & PHYS_FLAG_FAST) || ticks > 1;
+        step_ticks[i] = (uint8_t)ticks;
+        if (!terrain_swept[i])
+        {
+            batch[i] = body_integrates(world, i);
+            continue;
+        }
 
-                solve_terrain_collision(world, i, sub_dt);
-            }
+        float sweep_dt = dt * (float)ticks / (float)sweeps;
+        for (int32_t s = 0; s < sweeps; s++)
+        {
+            integrate_body(world, i, sweep_dt, dt);
+            if (world->terrain && (world->flags[i] & PHYS_FLAG_ACTIVE))
+                solve_terrain_collision(world, i, sweep_dt, dt);
         }
     }
+    integrate_batch(world, batch, lane_limit, dt);
 
-    for (int32_t i = 0; i < limit; i++)
+    update_broadphase(world, dt);
+
+    /* Detection stays serial: the hull cache is shared */
+    ObjectCollisionPair pairs[PHYS_ISLAND_MAX_PAIRS];
+    int32_t pair_count = physics_detect_object_pairs(world, pairs, PHYS_OBJ_COLLISION_BUDGET);
+
+    /* Manifold merge is serial too; the solve below only touches each island's own */
+    PhysicsManifolds *manifolds = world->manifolds;
+    int32_t pair_manifold[PHYS_ISLAND_MAX_PAIRS];
+    bool manifold_seen[PHYS_MAX_MANIFOLDS] = {false};
+    physics_manifolds_begin(manifolds, world);
+    for (int32_t p = 0; p < pair_count; p++)
+    {
+        int32_t m = physics_manifolds_add(manifolds, world, &pairs[p]);
+        if (m >= 0 && manifold_seen[m])
+            m = -2;
+        else if (m >= 0)
+            manifold_seen[m] = true;
+        pair_manifold[p] = m;
+    }
+
+    /* Live manifolds narrowphase missed (touching, not penetrating) keep holding */
+    for (int32_t m = 0; m < manifolds->count && pair_count < PHYS_ISLAND_MAX_PAIRS; m++)
+    {
+        const ContactManifold *manifold = &manifolds->manifolds[m];
+        uint8_t flags_a = world->flags[manifold->body_a];
+        uint8_t flags_b = world->flags[manifold->body_b];
+        bool resting = (flags_a & (PHYS_FLAG_SLEEPING | PHYS_FLAG_STATIC)) &&
+                       (flags_b & (PHYS_FLAG_SLEEPING | PHYS_FLAG_STATIC));
+        if (manifold_seen[m] || resting)
+            continue;
+        pairs[pair_count] = physics_manifold_as_pair(manifold);
+        pair_manifold[pair_count++] = m;
+    }
+
+    /* A moving body touching a deferred one promotes it into this step's solve */
+    for (int32_t p = 0; p < pair_count; p++)
+    {
+        if (!pairs[p].valid)
+            continue;
+        uint8_t flags_a = world->flags[pairs[p].body_a];
+        uint8_t flags_b = world->flags[pairs[p].body_b];
+        bool moving_a = !(flags_a & (PHYS_FLAG_SLEEPING | PHYS_FLAG_STATIC));
+        bool moving_b = !(flags_b & (PHYS_FLAG_SLEEPING | PHYS_FLAG_STATIC));
+        if (deferred[pairs[p].body_a] && (flags_a & PHYS_FLAG_SLEEPING) && moving_b)
+            physics_body_wake(world, pairs[p].body_a);
+        if (deferred[pairs[p].body_b] && (flags_b & PHYS_FLAG_SLEEPING) && moving_a)
+            physics_body_wake(world, pairs[p].body_b);
+    }
+
+    /* Sleepers are held as static; contacts that cannot hold them wake them up front */
+    for (int32_t p = 0; p < pair_count; p++)
     {
-        if (!(world->bodies[i].flags & PHYS_FLAG_ACTIVE))
+        if (!pairs[p].valid)
             continue;
+        uint8_t flags_a = world->flags[pairs[p].body_a];
+        uint8_t flags_b = world->flags[pairs[p].body_b];
+        bool fallback = pair_manifold[p] == -1; /* Single-point resolve writes both bodies */
+        if ((flags_a & PHYS_FLAG_SLEEPING) && (fallback || (flags_b & PHYS_FLAG_KINEMATIC)))
+            physics_body_wake(world, pairs[p].body_a);
+        if ((flags_b & PHYS_FLAG_SLEEPING) && (fallback || (flags_a & PHYS_FLAG_KINEMATIC)))
+            physics_body_wake(world, pairs[p].body_b);
+    }
+
+    PhysicsIslands *islands = world->islands;
+    physics_islands_build(islands, world, pairs, pair_count);
+
+    IslandSolveContext solve = {pairs, pair_manifold, terrain_swept, dt};
+    int32_t simulated = islands->body_start[islands->count];
+    physics_islands_run(simulated >= PHYS_PARALLEL_MIN_BODIES ? world->workers : NULL,
+                        world, islands, solve_island, &solve);
+
+    /* Impacts that exceeded a held sleeper's threshold; it joins an island next step */
+    for (int32_t m = 0; m < manifolds->count; m++)
+    {
+        ContactManifold *manifold = &manifolds->manifolds[m];
+        if (!manifold->wake)
+            continue;
+        manifold->wake = false;
+        if (world->flags[manifold->body_a] & PHYS_FLAG_SLEEPING)
+            physics_body_wake(world, manifold->body_a);
+        if (world->flags[manifold->body_b] & PHYS_FLAG_SLEEPING)
+            physics_body_wake(world, manifold->body_b);
+    }
+
+    release_lod(world, deferred);
+
+    /* Islands decide sleep; untouched sleepers keep the per-body rule */
+    uint8_t quiet[PHYS_MAX_BODIES];
+    sleep_quiet_batch(world, quiet, lane_limit);
+    for (int32_t k = 0; k < world->islands->count; k++)
+        update_island_sleep_state(world, k, step_ticks, quiet);
+
+    for (int32_t k = 0; k < world->body_count; k++)
+    {
+        int32_t i = world->active_bodies[k];
+        if (world->islands->body_island[i] >= 0)
+            continue;
+        if (deferred[i])
+            continue; /* Not updated this tick */
 
-        update_sleep_state(world, i);
+        update_sleep_state(world, i, step_ticks[i], quiet[i]);
+    }
+
+    /* Time spent asleep on the terrain, the freezing criterion */
+    for (int32_t k = 0; k < world->body_count; k++)
+    {
+        RigidBody *body = &world->bodies[world->active_bodies[k]];
+        uint8_t flags = world->flags[world->active_bodies[k]];
+        bool resting = (flags & (PHYS_FLAG_SLEEPING | PHYS_FLAG_GROUNDED)) ==
+                           (PHYS_FLAG_SLEEPING | PHYS_FLAG_GROUNDED) &&
+                       !(flags & (PHYS_FLAG_STATIC | PHYS_FLAG_KINEMATIC)) && body->support_version != 0;
+        if (!resting)
+            body->rest_ticks = 0;
+        else if (body->rest_ticks < UINT16_MAX)
+            body->rest_ticks++;
     }
 
     PROFILE_END(PROFILE_SIM_PHYSICS);
@@ -884,7 +1550,7 @@ void physics_world_sync_objects(PhysicsWorld *world)
     for (int32_t i = 0; i < limit; i++)
     {
         RigidBody *body = &world->bodies[i];
-        if (!(body->flags & PHYS_FLAG_ACTIVE))
+        if (!(world->flags[i] & PHYS_FLAG_ACTIVE))
             continue;
 
         if (body->vobj_index < 0 || body->vobj_index >= obj_world->object_count)
@@ -902,34 +1568,16 @@ void physics_world_sync_objects(PhysicsWorld *world)
 
         if (obj->voxel_revision != body->synced_revision)
         {
-            body->mass = obj->total_mass > K_EPSILON ? obj->total_mass
-                                                     : (float)obj->voxel_count * PHYS_VOXEL_DENSITY;
-            if (body->mass < K_EPSILON)
-                body->mass = K_EPSILON;
-            body->inv_mass = 1.0f / body->mass;
-
-            if (obj->inertia_diag.x > K_EPSILON && obj->inertia_diag.y > K_EPSILON &&
-                obj->inertia_diag.z > K_EPSILON)
-            {
-                body->inertia_local = obj->inertia_diag;
-                body->inv_inertia_local = vec3_create(
-                    1.0f / obj->inertia_diag.x,
-                    1.0f / obj->inertia_diag.y,
-                    1.0f / obj->inertia_diag.z);
-            }
-            else
-            {
-                physics_body_compute_inertia(body, obj->shape_half_extents);
-            }
-
+            body_set_mass_from_object(world, i, obj);
             body->synced_revision = obj->voxel_revision;
 
             /* Shape changed: clear grounded/sleep so body re-evaluates contacts.
              * Without this, at_rest short-circuits terrain collision and the body
              * stays frozen after splits or destruction shift its position. */
-            body->flags &= ~(PHYS_FLAG_SLEEPING | PHYS_FLAG_GROUNDED);
+            world->flags[i] &= ~(PHYS_FLAG_SLEEPING | PHYS_FLAG_GROUNDED);
             body->sleep_frames = 0;
             body->ground_frames = 0;
+            body->support_version = 0;
         }
     }
 }
@@ -939,26 +1587,26 @@ void physics_world_wake_in_region(PhysicsWorld *world, Vec3 center, float radius
     if (!world || !world->objects)
         return;
 
-    int32_t limit = world->max_body_index + 1;
-
-    for (int32_t i = 0; i < limit; i++)
+    for (int32_t k = 0; k < world->body_count; k++)
     {
+        int32_t i = world->active_bodies[k];
         RigidBody *body = &world->bodies[i];
-        if (!(body->flags & PHYS_FLAG_ACTIVE) || !(body->flags & PHYS_FLAG_SLEEPING))
+        if (!(world->flags[i] & PHYS_FLAG_SLEEPING))
             continue;
 
         VoxelObject *obj = &world->objects->objects[body->vobj_index];
         if (!obj->active)
             continue;
 
-        Vec3 delta = vec3_sub(obj->position, center);
+        Vec3 delta = vec3_sub(voxel_object_position(world->objects, body->vobj_index), center);
         float dist_sq = vec3_dot(delta, delta);
         float combined = radius + obj->radius;
         if (dist_sq <= combined * combined)
         {
             physics_body_wake(world, i);
-            body->flags &= ~(PHYS_FLAG_GROUNDED | PHYS_FLAG_STABLE);
+            world->flags[i] &= ~(PHYS_FLAG_GROUNDED | PHYS_FLAG_STABLE);
             body->ground_frames = 0;
+            body->support_version = 0;
         }
     }
 }
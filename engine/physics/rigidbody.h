@@ -34,9 +34,8 @@ extern "C"
 #define PHYS_BAUMGARTE_FACTOR 0.2f
 #define PHYS_SLOP 0.005f
 #define PHYS_MAX_COLLISION_PAIRS 128
-#define PHYS_TERRAIN_SAMPLE_POINTS 14
-#define PHYS_SUBSTEP_VELOCITY_THRESHOLD 10.0f
-#define PHYS_MAX_SUBSTEPS 4
+#define PHYS_SUBSTEP_VELOCITY_THRESHOLD 10.0f /* Faster bodies sweep alone and get speculative contacts */
+#define PHYS_MAX_SUBSTEPS 4                    /* Sweeps per fast body per step */
 #define PHYS_STABLE_SUPPORT_RATIO 0.8f
 
 #define PHYS_FLAG_ACTIVE     (1 << 0)
@@ -46,25 +45,35 @@ extern "C"
 #define PHYS_FLAG_GROUNDED     (1 << 4)
 #define PHYS_FLAG_OBJ_CONTACT  (1 << 5)
 #define PHYS_FLAG_STABLE       (1 << 6)
+#define PHYS_FLAG_FAST         (1 << 7) /* Above the substep threshold this step */
 
+    /* Per-body state the step does not stream; the hot state lives in PhysicsWorld's arrays */
     typedef struct
     {
         int32_t vobj_index;
-        Vec3 velocity;
-        Vec3 angular_velocity;
         float mass;
-        float inv_mass;
         Vec3 inertia_local;
-        Vec3 inv_inertia_local;
         float restitution;
         float friction;
         uint8_t sleep_frames;
         uint8_t ground_frames;
-        uint8_t flags;
+        uint8_t lod_level;   /* Update rate level (sim_lod.h) */
+        uint8_t lod_pending; /* Ticks skipped since the last update */
+        uint8_t lod_hold;    /* Full-rate ticks left after a near-field contact */
         int16_t next_free;
+        uint16_t rest_ticks;      /* Consecutive steps asleep on the terrain (body_freeze.h) */
         uint32_t synced_revision; /* last voxel_revision synced from VoxelObject */
+        uint32_t support_version; /* Terrain version under a body resting on it (0 = unsupported) */
     } RigidBody;
 
+    /* One Vec3 per body slot, stored as three component arrays */
+    typedef struct
+    {
+        float x[PHYS_MAX_BODIES];
+        float y[PHYS_MAX_BODIES];
+        float z[PHYS_MAX_BODIES];
+    } PhysicsVec3Array;
+
     typedef struct
     {
         int32_t body_a;
@@ -74,9 +83,33 @@ extern "C"
         float penetration;
     } CollisionPair;
 
+    struct PhysicsIslands;
+    struct PhysicsWorkers;
+    struct PhysicsManifolds;
+    struct PhysicsPairCache;
+    struct PhysicsSimLod;
+
+    /*
+     * Body storage is structure-of-arrays for the state integration and the
+     * sleep checks stream (velocities, inverse mass and inertia, flags):
+     * body i is slot i of every array and of bodies[]. Those passes run over
+     * whole lane blocks of slots, 8 lanes at a time with AVX2, 4 with SSE2,
+     * one at a time otherwise; all three give identical results. Positions
+     * and orientations are the objects' poses (VoxelObjectPoses).
+     *
+     * Live bodies are also listed in active_bodies, so per-body passes walk
+     * only those instead of every slot. Adding and removing is O(1).
+     */
     typedef struct PhysicsWorld
     {
         RigidBody bodies[PHYS_MAX_BODIES];
+        PhysicsVec3Array velocity;
+        PhysicsVec3Array angular_velocity;
+        PhysicsVec3Array inv_inertia_local;
+        float inv_mass[PHYS_MAX_BODIES];
+        uint8_t flags[PHYS_MAX_BODIES];           /* PHYS_FLAG_*, 0 = free slot */
+        int16_t active_bodies[PHYS_MAX_BODIES];   /* Live slots, body_count of them, in no particular order */
+        int16_t active_index[PHYS_MAX_BODIES];    /* Position in active_bodies, -1 = free slot */
         int32_t body_count;
         int32_t first_free;
         int32_t max_body_index;
@@ -87,11 +120,24 @@ extern "C"
         CollisionPair collision_pairs[PHYS_MAX_COLLISION_PAIRS];
         int32_t collision_pair_count;
         SAPBroadphase *broadphase;
+        struct PhysicsIslands *islands; /* Rebuilt every step (island.h) */
+        struct PhysicsWorkers *workers; /* NULL = islands solved on the stepping thread */
+        struct PhysicsManifolds *manifolds; /* Contact points persisting across steps (manifold.h) */
+        struct PhysicsPairCache *pair_cache; /* Narrowphase state per hull pair (collision_object.h) */
+        uint32_t terrain_version;            /* Terrain version_counter at the last support check */
+        struct PhysicsSimLod *lod;           /* Caller-owned rate scheduler, NULL = full rate (sim_lod.h) */
+        uint32_t lod_tick;
     } PhysicsWorld;
 
     PhysicsWorld *physics_world_create(VoxelObjectWorld *objects, VoxelVolume *terrain);
     void physics_world_destroy(PhysicsWorld *world);
 
+    /* Island solver threads (0 = serial); results do not depend on the count */
+    bool physics_world_set_worker_count(PhysicsWorld *world, int32_t worker_count);
+
+    /* Steps far bodies at reduced rates; the scheduler must outlive the world (NULL = off) */
+    void physics_world_set_lod(PhysicsWorld *world, struct PhysicsSimLod *lod);
+
     int32_t physics_world_add_body(PhysicsWorld *world, int32_t vobj_index);
     int32_t physics_world_add_body_with_mass(PhysicsWorld *world, int32_t vobj_index,
                                               float mass, Vec3 half_extents);
@@ -109,13 +155,53 @@ extern "C"
     void physics_body_apply_torque(PhysicsWorld *world, int32_t body_index, Vec3 torque);
     void physics_body_wake(PhysicsWorld *world, int32_t body_index);
 
+    /* Slot accessors; no liveness check (see physics_world_get_body) */
+    static inline Vec3 physics_body_velocity(const PhysicsWorld *world, int32_t body_index)
+    {
+        return vec3_create(world->velocity.x[body_index], world->velocity.y[body_index],
+                           world->velocity.z[body_index]);
+    }
+
+    static inline Vec3 physics_body_angular_velocity(const PhysicsWorld *world, int32_t body_index)
+    {
+        return vec3_create(world->angular_velocity.x[body_index], world->angular_velocity.y[body_index],
+                           world->angular_velocity.z[body_index]);
+    }
+
+    static inline Vec3 physics_body_inv_inertia(const PhysicsWorld *world, int32_t body_index)
+    {
+        return vec3_create(world->inv_inertia_local.x[body_index], world->inv_inertia_local.y[body_index],
+                           world->inv_inertia_local.z[body_index]);
+    }
+
+    /* Plain stores: unlike physics_body_set_velocity, these do not wake the body */
+    static inline void physics_body_store_velocity(PhysicsWorld *world, int32_t body_index, Vec3 velocity)
+    {
+        world->velocity.x[body_index] = velocity.x;
+        world->velocity.y[body_index] = velocity.y;
+        world->velocity.z[body_index] = velocity.z;
+    }
+
+    static inline void physics_body_store_angular_velocity(PhysicsWorld *world, int32_t body_index,
+                                                           Vec3 angular_velocity)
+    {
+        world->angular_velocity.x[body_index] = angular_velocity.x;
+        world->angular_velocity.y[body_index] = angular_velocity.y;
+        world->angular_velocity.z[body_index] = angular_velocity.z;
+    }
+
     void physics_body_set_velocity(PhysicsWorld *world, int32_t body_index, Vec3 velocity);
     void physics_body_set_angular_velocity(PhysicsWorld *world, int32_t body_index, Vec3 angular_velocity);
 
-    void physics_body_compute_inertia(RigidBody *body, Vec3 half_extents);
+    /* Box inertia for the body's mass; sets inertia_local and the inverse */
+    void physics_body_compute_inertia(PhysicsWorld *world, int32_t body_index, Vec3 half_extents);
 
     void physics_world_sync_objects(PhysicsWorld *world);
 
+    /* Re-enters every active body, sleepers included, after the body array was written directly */
+    void physics_world_rebuild_broadphase(PhysicsWorld *world);
+
+    /* Wakes sleepers overlapping the sphere; bodies resting on them wake at the next step */
     void physics_world_wake_in_region(PhysicsWorld *world, Vec3 center, float radius);
 
 #ifdef __cplusplus
@@ -0,0 +1,47 @@
+#include "sim_lod.h"
+#include <string.h>
+
+void physics_lod_init(PhysicsSimLod *lod)
+{
+    memset(lod, 0, sizeof(*lod));
+    lod->half_distance = PHYS_LOD_HALF_DISTANCE;
+    lod->quarter_distance = PHYS_LOD_QUARTER_DISTANCE;
+}
+
+void physics_lod_set_focus(PhysicsSimLod *lod, const Vec3 *points, int32_t count)
+{
+    if (count > PHYS_LOD_MAX_FOCUS)
+        count = PHYS_LOD_MAX_FOCUS;
+    if (count < 0)
+        count = 0;
+
+    for (int32_t i = 0; i < count; i++)
+        lod->focus[i] = points[i];
+    lod->focus_count = count;
+}
+
+uint8_t physics_lod_level(const PhysicsSimLod *lod, Vec3 center, float radius)
+{
+    if (!lod || lod->focus_count == 0)
+        return 0;
+
+    float nearest_sq = 1e30f;
+    for (int32_t i = 0; i < lod->focus_count; i++)
+    {
+        Vec3 delta = vec3_sub(center, lod->focus[i]);
+        float dist_sq = vec3_dot(delta, delta);
+        if (dist_sq < nearest_sq)
+            nearest_sq = dist_sq;
+    }
+
+    /* Compare squared distances, with the radius moved to the threshold side */
+    float half = lod->half_distance + radius;
+    if (nearest_sq <= half * half)
+        return 0;
+
+    float quarter = lod->quarter_distance + radius;
+    if (nearest_sq <= quarter * quarter)
+        return 1;
+
+    return 2;
+}
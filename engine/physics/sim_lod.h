@@ -0,0 +1,75 @@
+#ifndef PATCH_PHYSICS_SIM_LOD_H
+#define PATCH_PHYSICS_SIM_LOD_H
+
+#include "engine/core/types.h"
+#include "engine/core/math.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Simulation Level of Detail
+ *
+ * Bodies and particles far from every focus point (cameras, players) are
+ * updated less often. Level 0 updates every tick, level 1 every 2nd tick and
+ * level 2 every 4th tick. A skipped tick is not lost: its dt is carried over,
+ * and the next update integrates the sum. Updates are staggered by index, so
+ * each tick takes an even share of every far level. Without focus points,
+ * everything runs at level 0.
+ *
+ * The caller owns the scheduler. It sets the focus points once per tick and
+ * attaches the scheduler to a PhysicsWorld and a ParticleSystem; each of them
+ * reports its per-level work back into it.
+ */
+
+#define PHYS_LOD_LEVELS 3
+#define PHYS_LOD_MAX_FOCUS 4
+#define PHYS_LOD_HALF_DISTANCE 24.0f    /* Beyond this from every focus point: 1/2 rate */
+#define PHYS_LOD_QUARTER_DISTANCE 48.0f /* Beyond this: 1/4 rate */
+#define PHYS_LOD_PROMOTE_TICKS 30       /* Full-rate ticks for a far body after a near-field contact */
+
+    typedef struct PhysicsSimLod
+    {
+        Vec3 focus[PHYS_LOD_MAX_FOCUS];
+        int32_t focus_count;
+        float half_distance;
+        float quarter_distance;
+
+        /* Last tick's work (also published as profiler counters) */
+        int32_t body_updates[PHYS_LOD_LEVELS];
+        int32_t body_deferred;
+        int32_t body_promoted;
+        int32_t particle_updates[PHYS_LOD_LEVELS];
+        int32_t particle_deferred;
+    } PhysicsSimLod;
+
+    void physics_lod_init(PhysicsSimLod *lod);
+
+    /* Replaces the focus points; extra points beyond PHYS_LOD_MAX_FOCUS are ignored */
+    void physics_lod_set_focus(PhysicsSimLod *lod, const Vec3 *points, int32_t count);
+
+    /* Level for a sphere, by its nearest surface point to the nearest focus */
+    uint8_t physics_lod_level(const PhysicsSimLod *lod, Vec3 center, float radius);
+
+    /* Ticks one update covers at a level */
+    static inline int32_t physics_lod_interval(uint8_t level)
+    {
+        return 1 << level;
+    }
+
+    /* Whether an entry at a level updates on this tick, having skipped `pending` ticks */
+    static inline bool physics_lod_due(uint32_t tick, int32_t index, uint8_t level, uint8_t pending)
+    {
+        int32_t interval = physics_lod_interval(level);
+        return (int32_t)pending + 1 >= interval || ((tick + (uint32_t)index) & (uint32_t)(interval - 1)) == 0;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,415 @@
+#include "terrain_contact.h"
+#include <math.h>
+
+/* OBB corners and face centers, for objects whose surface list is empty or truncated */
+#define TERRAIN_OBB_SAMPLES 14
+#define TERRAIN_MAX_SAMPLES (VOBJ_MAX_SURFACE_VOXELS + TERRAIN_OBB_SAMPLES)
+
+typedef struct
+{
+    const VoxelVolume *vol;
+    const Chunk *chunk;
+    int32_t cx, cy, cz;
+    int32_t size_x, size_y, size_z; /* Volume extent in voxels */
+} TerrainCursor;
+
+static void cursor_init(TerrainCursor *cur, const VoxelVolume *vol)
+{
+    cur->vol = vol;
+    cur->chunk = NULL;
+    cur->cx = cur->cy = cur->cz = -1;
+    cur->size_x = vol->chunks_x * CHUNK_SIZE;
+    cur->size_y = vol->chunks_y * CHUNK_SIZE;
+    cur->size_z = vol->chunks_z * CHUNK_SIZE;
+}
+
+/* Chunk holding global voxel (gx, gy, gz), or NULL outside the volume; caches the last chunk */
+static inline const Chunk *cursor_chunk(TerrainCursor *cur, int32_t gx, int32_t gy, int32_t gz)
+{
+    if (gx < 0 || gy < 0 || gz < 0 || gx >= cur->size_x || gy >= cur->size_y || gz >= cur->size_z)
+        return NULL;
+
+    int32_t cx = gx >> CHUNK_SIZE_BITS;
+    int32_t cy = gy >> CHUNK_SIZE_BITS;
+    int32_t cz = gz >> CHUNK_SIZE_BITS;
+    if (cx != cur->cx || cy != cur->cy || cz != cur->cz)
+    {
+        cur->cx = cx;
+        cur->cy = cy;
+        cur->cz = cz;
+        cur->chunk = &cur->vol->chunks[volume_chunk_slot(cur->vol, cx, cy, cz)];
+    }
+    return cur->chunk;
+}
+
+static inline uint64_t region_bit(int32_t lx, int32_t ly, int32_t lz)
+{
+    int32_t rx = lx >> CHUNK_REGION_BITS;
+    int32_t ry = ly >> CHUNK_REGION_BITS;
+    int32_t rz = lz >> CHUNK_REGION_BITS;
+    return 1ull << (rx + ry * 4 + rz * 16);
+}
+
+/* Material at a global voxel; empty regions answer from the occupancy mask without touching voxels */
+static inline uint8_t cursor_get(TerrainCursor *cur, int32_t gx, int32_t gy, int32_t gz, bool *read)
+{
+    const Chunk *chunk = cursor_chunk(cur, gx, gy, gz);
+    if (!chunk || !chunk->occupancy.has_any)
+        return MATERIAL_EMPTY;
+
+    int32_t lx = gx & (CHUNK_SIZE - 1);
+    int32_t ly = gy & (CHUNK_SIZE - 1);
+    int32_t lz = gz & (CHUNK_SIZE - 1);
+    if (!(chunk->occupancy.level0 & region_bit(lx, ly, lz)))
+        return MATERIAL_EMPTY;
+
+    if (read)
+        *read = true;
+    return chunk->voxels[chunk_voxel_index(lx, ly, lz)].material;
+}
+
+/* Level0 bits of the regions a chunk-local voxel range [lo, hi] covers */
+static uint64_t region_range_mask(const int32_t lo[3], const int32_t hi[3])
+{
+    uint64_t mask = 0;
+    for (int32_t rz = lo[2] >> CHUNK_REGION_BITS; rz <= hi[2] >> CHUNK_REGION_BITS; rz++)
+        for (int32_t ry = lo[1] >> CHUNK_REGION_BITS; ry <= hi[1] >> CHUNK_REGION_BITS; ry++)
+            for (int32_t rx = lo[0] >> CHUNK_REGION_BITS; rx <= hi[0] >> CHUNK_REGION_BITS; rx++)
+                mask |= 1ull << (rx + ry * 4 + rz * 16);
+    return mask;
+}
+
+static inline int32_t floor_to_int(float v)
+{
+    int32_t i = (int32_t)v;
+    return ((float)i > v) ? i - 1 : i;
+}
+
+bool physics_terrain_box_empty(const VoxelVolume *terrain, Vec3 aabb_min, Vec3 aabb_max)
+{
+    float inv_vs = 1.0f / terrain->voxel_size;
+    int32_t vmin[3] = {
+        floor_to_int((aabb_min.x - terrain->bounds.min_x) * inv_vs),
+        floor_to_int((aabb_min.y - terrain->bounds.min_y) * inv_vs),
+        floor_to_int((aabb_min.z - terrain->bounds.min_z) * inv_vs)};
+    int32_t vmax[3] = {
+        floor_to_int((aabb_max.x - terrain->bounds.min_x) * inv_vs),
+        floor_to_int((aabb_max.y - terrain->bounds.min_y) * inv_vs),
+        floor_to_int((aabb_max.z - terrain->bounds.min_z) * inv_vs)};
+    int32_t size[3] = {terrain->chunks_x * CHUNK_SIZE, terrain->chunks_y * CHUNK_SIZE,
+                       terrain->chunks_z * CHUNK_SIZE};
+
+    for (int32_t a = 0; a < 3; a++)
+    {
+        if (vmin[a] < 0)
+            vmin[a] = 0;
+        if (vmax[a] >= size[a])
+            vmax[a] = size[a] - 1;
+        if (vmin[a] > vmax[a])
+            return true;
+    }
+
+    for (int32_t cz = vmin[2] >> CHUNK_SIZE_BITS; cz <= vmax[2] >> CHUNK_SIZE_BITS; cz++)
+    {
+        for (int32_t cy = vmin[1] >> CHUNK_SIZE_BITS; cy <= vmax[1] >> CHUNK_SIZE_BITS; cy++)
+        {
+            for (int32_t cx = vmin[0] >> CHUNK_SIZE_BITS; cx <= vmax[0] >> CHUNK_SIZE_BITS; cx++)
+            {
+                const Chunk *chunk = &terrain->chunks[volume_chunk_slot(terrain, cx, cy, cz)];
+                if (!chunk->occupancy.has_any)
+                    continue;
+
+                int32_t base[3] = {cx << CHUNK_SIZE_BITS, cy << CHUNK_SIZE_BITS, cz << CHUNK_SIZE_BITS};
+                int32_t lo[3], hi[3];
+                for (int32_t a = 0; a < 3; a++)
+                {
+                    lo[a] = vmin[a] > base[a] ? vmin[a] - base[a] : 0;
+                    hi[a] = vmax[a] < base[a] + CHUNK_SIZE - 1 ? vmax[a] - base[a] : CHUNK_SIZE - 1;
+                }
+
+                if (chunk->occupancy.level0 & region_range_mask(lo, hi))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+uint32_t physics_terrain_box_version(const VoxelVolume *terrain, Vec3 aabb_min, Vec3 aabb_max)
+{
+    float chunk_inv = 1.0f / (terrain->voxel_size * (float)CHUNK_SIZE);
+    int32_t cmin[3] = {
+        floor_to_int((aabb_min.x - terrain->bounds.min_x) * chunk_inv),
+        floor_to_int((aabb_min.y - terrain->bounds.min_y) * chunk_inv),
+        floor_to_int((aabb_min.z - terrain->bounds.min_z) * chunk_inv)};
+    int32_t cmax[3] = {
+        floor_to_int((aabb_max.x - terrain->bounds.min_x) * chunk_inv),
+        floor_to_int((aabb_max.y - terrain->bounds.min_y) * chunk_inv),
+        floor_to_int((aabb_max.z - terrain->bounds.min_z) * chunk_inv)};
+    int32_t size[3] = {terrain->chunks_x, terrain->chunks_y, terrain->chunks_z};
+
+    for (int32_t a = 0; a < 3; a++)
+    {
+        if (cmin[a] < 0)
+            cmin[a] = 0;
+        if (cmax[a] >= size[a])
+            cmax[a] = size[a] - 1;
+        if (cmin[a] > cmax[a])
+            return 0;
+    }
+
+    /* Versions are volume-unique and only grow, so the newest one moves on any edit */
+    uint32_t newest = 0;
+    for (int32_t cz = cmin[2]; cz <= cmax[2]; cz++)
+    {
+        for (int32_t cy = cmin[1]; cy <= cmax[1]; cy++)
+        {
+            for (int32_t cx = cmin[0]; cx <= cmax[0]; cx++)
+            {
+                uint32_t version = terrain->chunk_versions[volume_chunk_slot(terrain, cx, cy, cz)];
+                if (version > newest)
+                    newest = version;
+            }
+        }
+    }
+    return newest;
+}
+
+static int32_t gather_samples(const VoxelObject *obj, VoxelObjectPose pose, Vec3 *samples)
+{
+    float m[9];
+    quat_to_mat3(pose.orientation, m);
+    Vec3 c = pose.position;
+    int32_t count = 0;
+
+    for (int32_t i = 0; i < obj->surface_voxel_count; i++)
+    {
+        Vec3 l = obj->surface_voxels[i];
+        samples[count++] = vec3_create(c.x + m[0] * l.x + m[1] * l.y + m[2] * l.z,
+                                       c.y + m[3] * l.x + m[4] * l.y + m[5] * l.z,
+                                       c.z + m[6] * l.x + m[7] * l.y + m[8] * l.z);
+    }
+
+    if (obj->surface_voxel_count > 0 && obj->surface_voxel_count < VOBJ_MAX_SURFACE_VOXELS)
+        return count;
+
+    Vec3 he = obj->shape_half_extents;
+    Vec3 ax = vec3_create(m[0] * he.x, m[3] * he.x, m[6] * he.x);
+    Vec3 ay = vec3_create(m[1] * he.y, m[4] * he.y, m[7] * he.y);
+    Vec3 az = vec3_create(m[2] * he.z, m[5] * he.z, m[8] * he.z);
+
+    for (int32_t corner = 0; corner < 8; corner++)
+    {
+        Vec3 p = c;
+        p = vec3_add(p, (corner & 1) ? ax : vec3_neg(ax));
+        p = vec3_add(p, (corner & 2) ? ay : vec3_neg(ay));
+        p = vec3_add(p, (corner & 4) ? az : vec3_neg(az));
+        samples[count++] = p;
+    }
+    samples[count++] = vec3_add(c, ax);
+    samples[count++] = vec3_sub(c, ax);
+    samples[count++] = vec3_add(c, ay);
+    samples[count++] = vec3_sub(c, ay);
+    samples[count++] = vec3_add(c, az);
+    samples[count++] = vec3_sub(c, az);
+    return count;
+}
+
+/*
+ * Nearest face of solid voxel g with an empty voxel beyond it, searching
+ * PHYS_TERRAIN_EXIT_VOXELS deep per direction. Ties go to the face looking
+ * toward the object. Returns false when the sample is buried deeper.
+ */
+static bool nearest_exit(TerrainCursor *cur, const int32_t g[3], const float local[3], float voxel_size,
+                         Vec3 to_object, Vec3 *out_normal, float *out_depth)
+{
+    static const int32_t dirs[6][3] = {{0, 1, 0}, {0, -1, 0}, {1, 0, 0}, {-1, 0, 0}, {0, 0, 1}, {0, 0, -1}};
+    float best_depth = 0.0f;
+    float best_facing = 0.0f;
+    int32_t best = -1;
+
+    for (int32_t d = 0; d < 6; d++)
+    {
+        int32_t axis = dirs[d][0] ? 0 : (dirs[d][1] ? 1 : 2);
+        int32_t step = dirs[d][axis];
+
+        for (int32_t k = 1; k <= PHYS_TERRAIN_EXIT_VOXELS; k++)
+        {
+            int32_t n[3] = {g[0], g[1], g[2]};
+            n[axis] += step * k;
+
+            /* Face between voxel n - step and n; deeper faces cannot win once past the best */
+            float face = (step > 0) ? (float)n[axis] * voxel_size : (float)(n[axis] + 1) * voxel_size;
+            float depth = fabsf(face - local[axis]);
+            if (best >= 0 && depth > best_depth + 1e-5f)
+                break;
+            if (cursor_get(cur, n[0], n[1], n[2], NULL) != MATERIAL_EMPTY)
+                continue;
+
+            Vec3 normal = vec3_create((float)dirs[d][0], (float)dirs[d][1], (float)dirs[d][2]);
+            float facing = vec3_dot(normal, to_object);
+
+            if (best < 0 || depth < best_depth - 1e-5f ||
+                (depth < best_depth + 1e-5f && facing > best_facing))
+            {
+                best = d;
+                best_depth = depth;
+                best_facing = facing;
+                *out_normal = normal;
+            }
+            break;
+        }
+    }
+
+    if (best < 0)
+        return false;
+    *out_depth = best_depth;
+    return true;
+}
+
+static float tri_area2(Vec3 a, Vec3 b, Vec3 c, Vec3 n)
+{
+    return vec3_dot(vec3_cross(vec3_sub(b, a), vec3_sub(c, a)), n);
+}
+
+/* Deepest point first, then the points spanning the largest area */
+static int32_t reduce_contacts(const TerrainContact *cand, int32_t count, TerrainContact *out)
+{
+    if (count <= PHYS_TERRAIN_MAX_CONTACTS)
+    {
+        for (int32_t i = 0; i < count; i++)
+            out[i] = cand[i];
+        return count;
+    }
+
+    int32_t a = 0;
+    for (int32_t i = 1; i < count; i++)
+        if (cand[i].penetration > cand[a].penetration)
+            a = i;
+
+    int32_t b = -1;
+    float best = 0.0f;
+    for (int32_t i = 0; i < count; i++)
+    {
+        float d = vec3_length_sq(vec3_sub(cand[i].point, cand[a].point));
+        if (d > best)
+        {
+            best = d;
+            b = i;
+        }
+    }
+    out[0] = cand[a];
+    if (b < 0)
+        return 1;
+    out[1] = cand[b];
+
+    Vec3 pa = cand[a].point;
+    Vec3 pb = cand[b].point;
+    Vec3 ab = vec3_sub(pb, pa);
+    int32_t c = -1;
+    best = 0.0f;
+    for (int32_t i = 0; i < count; i++)
+    {
+        float area = vec3_length_sq(vec3_cross(ab, vec3_sub(cand[i].point, pa)));
+        if (area > best)
+        {
+            best = area;
+            c = i;
+        }
+    }
+    if (c < 0)
+        return 2;
+    out[2] = cand[c];
+
+    /* Fourth: furthest outside one of the triangle's edges */
+    Vec3 pc = cand[c].point;
+    Vec3 n = vec3_cross(ab, vec3_sub(pc, pa));
+    int32_t d = -1;
+    best = 0.0f;
+    for (int32_t i = 0; i < count; i++)
+    {
+        Vec3 p = cand[i].point;
+        float outside = minf(tri_area2(pa, pb, p, n), minf(tri_area2(pb, pc, p, n), tri_area2(pc, pa, p, n)));
+        if (outside < best)
+        {
+            best = outside;
+            d = i;
+        }
+    }
+    if (d < 0)
+        return 3;
+    out[3] = cand[d];
+    return 4;
+}
+
+int32_t physics_terrain_contacts(const VoxelVolume *terrain, const VoxelObject *obj,
+                                 VoxelObjectPose pose, TerrainContactSet *out)
+{
+    out->count = 0;
+    out->ground_count = 0;
+    out->support_centroid = vec3_zero();
+    out->support_count = 0;
+    out->candidate_count = 0;
+    out->samples_read = 0;
+
+    Vec3 reach = vec3_create(obj->radius, obj->radius, obj->radius);
+    if (physics_terrain_box_empty(terrain, vec3_sub(pose.position, reach), vec3_add(pose.position, reach)))
+        return 0;
+
+    Vec3 samples[TERRAIN_MAX_SAMPLES];
+    TerrainContact cand[TERRAIN_MAX_SAMPLES];
+    int32_t sample_count = gather_samples(obj, pose, samples);
+
+    TerrainCursor cur;
+    cursor_init(&cur, terrain);
+    float voxel_size = terrain->voxel_size;
+    float inv_vs = 1.0f / voxel_size;
+    Vec3 origin = vec3_create(terrain->bounds.min_x, terrain->bounds.min_y, terrain->bounds.min_z);
+    Vec3 com = vec3_add(pose.position, quat_rotate_vec3(pose.orientation, obj->local_com));
+
+    for (int32_t i = 0; i < sample_count; i++)
+    {
+        Vec3 p = samples[i];
+        float local[3] = {p.x - origin.x, p.y - origin.y, p.z - origin.z};
+        int32_t g[3] = {floor_to_int(local[0] * inv_vs), floor_to_int(local[1] * inv_vs),
+                        floor_to_int(local[2] * inv_vs)};
+
+        bool read = false;
+        uint8_t material = cursor_get(&cur, g[0], g[1], g[2], &read);
+        if (read)
+            out->samples_read++;
+        if (material == MATERIAL_EMPTY)
+        {
+            /* Resting just above the surface still supports the body */
+            if (p.y < com.y && cursor_get(&cur, g[0], g[1] - 1, g[2], &read) != MATERIAL_EMPTY)
+            {
+                out->support_centroid = vec3_add(out->support_centroid, p);
+                out->support_count++;
+            }
+            continue;
+        }
+
+        Vec3 normal = vec3_create(0.0f, 1.0f, 0.0f);
+        float depth = voxel_size * (float)PHYS_TERRAIN_EXIT_VOXELS;
+        nearest_exit(&cur, g, local, voxel_size, vec3_sub(pose.position, p), &normal, &depth);
+
+        TerrainContact *tc = &cand[out->candidate_count++];
+        tc->point = p;
+        tc->normal = normal;
+        tc->penetration = depth;
+        tc->material = material;
+
+        if (normal.y > 0.85f && p.y < com.y)
+        {
+            out->ground_count++;
+            out->support_centroid = vec3_add(out->support_centroid, p);
+            out->support_count++;
+        }
+    }
+
+    if (out->support_count > 0)
+        out->support_centroid = vec3_scale(out->support_centroid, 1.0f / (float)out->support_count);
+
+    out->count = reduce_contacts(cand, out->candidate_count, out->contacts);
+    return out->count;
+}
@@ -0,0 +1,75 @@
+#ifndef PATCH_PHYSICS_TERRAIN_CONTACT_H
+#define PATCH_PHYSICS_TERRAIN_CONTACT_H
+
+#include "engine/core/types.h"
+#include "engine/core/math.h"
+#include "engine/voxel/volume.h"
+#include "engine/voxel/voxel_object.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Voxel Terrain Contacts
+ *
+ * An object's surface voxels are moved into terrain voxel space and looked
+ * up cell by cell. Occupancy masks gate every lookup:
+ * - the object's AABB is turned into a level0 region mask per chunk and
+ *   ANDed with the chunk's occupancy; no overlap = no contacts, no voxel
+ *   reads (chunks without has_any are skipped outright)
+ * - each sample checks its region bit before reading voxel bytes
+ * A sample inside solid terrain takes the nearest face with an empty
+ * neighbour as its normal and the distance to that face as its depth, so
+ * normals are exact face normals instead of sampled gradients. The
+ * candidates are reduced to PHYS_TERRAIN_MAX_CONTACTS: the deepest point,
+ * then the points spanning the largest contact area.
+ */
+
+#define PHYS_TERRAIN_MAX_CONTACTS 4
+#define PHYS_TERRAIN_EXIT_VOXELS 3 /* Search depth for an empty neighbour along each axis */
+
+    typedef struct
+    {
+        Vec3 point;   /* Object surface sample, world space */
+        Vec3 normal;  /* Terrain face normal, out of the terrain */
+        float penetration;
+        uint8_t material;
+    } TerrainContact;
+
+    typedef struct
+    {
+        TerrainContact contacts[PHYS_TERRAIN_MAX_CONTACTS];
+        int32_t count;
+
+        /* Over every sample below the center of mass, before reduction */
+        int32_t ground_count;  /* Penetrating an upward face */
+        Vec3 support_centroid; /* Mean of samples in or within a voxel above an upward face */
+        int32_t support_count;
+        int32_t candidate_count; /* Penetrating samples */
+
+        int32_t samples_read; /* Samples that reached voxel data (stats) */
+    } TerrainContactSet;
+
+    /* True when no occupancy region overlapping the box holds a solid voxel */
+    bool physics_terrain_box_empty(const VoxelVolume *terrain, Vec3 aabb_min, Vec3 aabb_max);
+
+    /*
+     * Newest chunk version (VoxelVolume::chunk_versions) among the chunks the
+     * box overlaps; changes whenever terrain there is edited. 0 = box outside
+     * the volume.
+     */
+    uint32_t physics_terrain_box_version(const VoxelVolume *terrain, Vec3 aabb_min, Vec3 aabb_max);
+
+    /* Contacts of an object against terrain; returns the reduced contact count */
+    int32_t physics_terrain_contacts(const VoxelVolume *terrain, const VoxelObject *obj,
+                                     VoxelObjectPose pose, TerrainContactSet *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -14,6 +14,7 @@ static int64_t g_frequency = 0;
 #ifdef PATCH_PROFILE
 ProfileSlot g_profile_slots[PROFILE_COUNT] = {0};
 ProfileBudget g_profile_budget = {0};
+int32_t g_profile_counters[PROFILE_COUNTER_COUNT] = {0};
 #endif
 
 void platform_time_init(void)
@@ -56,3 +57,73 @@ int64_t platform_get_frequency(void)
     }
     return g_frequency;
 }
+
+bool platform_file_map(const char *path, PlatformFileMap *out_map)
+{
+    if (!path || !out_map)
+        return false;
+
+    out_map->data = NULL;
+    out_map->size = 0;
+    out_map->file_handle = NULL;
+    out_map->mapping_handle = NULL;
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    /* PAGE_WRITECOPY: callers may patch adopted data without touching the file */
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    out_map->data = view;
+    out_map->size = (size_t)file_size.QuadPart;
+    out_map->file_handle = file;
+    out_map->mapping_handle = mapping;
+    return true;
+}
+
+void platform_file_unmap(PlatformFileMap *map)
+{
+    if (!map)
+        return;
+
+    if (map->data)
+        UnmapViewOfFile(map->data);
+    if (map->mapping_handle)
+        CloseHandle((HANDLE)map->mapping_handle);
+    if (map->file_handle)
+        CloseHandle((HANDLE)map->file_handle);
+
+    map->data = NULL;
+    map->size = 0;
+    map->file_handle = NULL;
+    map->mapping_handle = NULL;
+}
+
+bool platform_file_seek(FILE *f, uint64_t offset)
+{
+    if (!f || offset > (uint64_t)INT64_MAX)
+        return false;
+    return _fseeki64(f, (__int64)offset, SEEK_SET) == 0;
+}
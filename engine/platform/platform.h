@@ -3,6 +3,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -22,6 +24,21 @@ extern "C"
     int64_t platform_get_ticks(void);
     int64_t platform_get_frequency(void);
 
+    /* Read-only file mapping with copy-on-write pages (writes stay private) */
+    typedef struct
+    {
+        void *data;
+        size_t size;
+        void *file_handle;
+        void *mapping_handle;
+    } PlatformFileMap;
+
+    bool platform_file_map(const char *path, PlatformFileMap *out_map);
+    void platform_file_unmap(PlatformFileMap *map);
+
+    /* Absolute seek with a 64-bit offset (fseek takes a 32-bit long on Windows) */
+    bool platform_file_seek(FILE *f, uint64_t offset);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,7 +19,7 @@ extern "C"
 /* Maximum materials in palette */
 #define GPU_MATERIAL_PALETTE_SIZE 256
 
-/* Chunk data size in bytes (32³ voxels × 1 byte) */
+/* Chunk data size in bytes (CHUNK_SIZE³ voxels × 1 byte) */
 #define GPU_CHUNK_DATA_SIZE CHUNK_VOXEL_COUNT
 
     /*
@@ -37,7 +37,7 @@ extern "C"
         int32_t chunks_y;       /* Number of chunks in Y */
         int32_t chunks_z;       /* Number of chunks in Z */
         int32_t total_chunks;   /* Total chunk count */
-        int32_t voxels_x;       /* Total voxels in X (chunks_x * 32) */
+        int32_t voxels_x;       /* Total voxels in X (chunks_x * CHUNK_SIZE) */
         int32_t voxels_y;       /* Total voxels in Y */
         int32_t voxels_z;       /* Total voxels in Z */
         int32_t pad;            /* Padding for 16-byte alignment */
@@ -48,20 +48,21 @@ static_assert(sizeof(GPUVolumeInfo) == 72, "GPUVolumeInfo must be 72 bytes");
     /*
      * GPUChunkHeader: Per-chunk metadata for hierarchical traversal.
      * Contains occupancy bitmasks for skipping empty regions.
-     * Stored in array indexed by chunk index.
+     * Stored in array indexed by logical chunk index. Voxel data stays in
+     * storage-slot order so a window scroll only rewrites this table.
      */
     typedef struct
     {
         /*
          * Matches shader layout: `uvec4 chunk_headers[]`.
          * .x/.y = level0 occupancy as two uint32 (low/high)
-         * .z    = packed: has_any (bits 0-7), level1 (bits 8-15), solid_count (bits 16-31)
-         * .w    = unused/pad
+         * .z    = packed: has_any (bits 0-7), level1 (bits 8-15), solid_count (bits 16-31, saturated)
+         * .w    = storage slot holding this chunk's voxel data
          */
         uint32_t level0_lo;
         uint32_t level0_hi;
         uint32_t packed;
-        uint32_t pad;
+        uint32_t data_slot;
     } GPUChunkHeader;
 
 static_assert(sizeof(GPUChunkHeader) == 16, "GPUChunkHeader must be 16 bytes");
@@ -139,7 +140,7 @@ static_assert(sizeof(GPUMaterialPalette) == 8192, "GPUMaterialPalette must be 81
     }
 
     /*
-     * Build GPUChunkHeader from a Chunk.
+     * Build GPUChunkHeader from a Chunk (data_slot is left 0 for the caller).
      */
     static inline GPUChunkHeader gpu_chunk_header_from_chunk(const Chunk *chunk)
     {
@@ -147,23 +148,57 @@ static_assert(sizeof(GPUMaterialPalette) == 8192, "GPUMaterialPalette must be 81
         uint64_t level0 = chunk->occupancy.level0;
         header.level0_lo = (uint32_t)(level0 & 0xFFFFFFFFu);
         header.level0_hi = (uint32_t)((level0 >> 32) & 0xFFFFFFFFu);
+#if CHUNK_SIZE_BITS > 5
+        uint32_t solid_count = chunk->occupancy.solid_count > 0xFFFFu ? 0xFFFFu : chunk->occupancy.solid_count;
+#else
+        uint32_t solid_count = chunk->occupancy.solid_count; /* uint16_t: already fits */
+#endif
         header.packed = (uint32_t)chunk->occupancy.has_any |
                         ((uint32_t)chunk->occupancy.level1 << 8) |
-                        ((uint32_t)chunk->occupancy.solid_count << 16);
-        header.pad = 0u;
+                        (solid_count << 16);
+        header.data_slot = 0u;
         return header;
     }
 
     /*
      * Copy chunk voxel data (material IDs only) to output buffer.
+     * Output is always row-major (x + y*CHUNK_SIZE + z*CHUNK_SIZE²) as the shaders expect,
+     * regardless of the CPU-side CHUNK_LAYOUT.
      * Returns size in bytes (always CHUNK_VOXEL_COUNT).
      */
     static inline int32_t gpu_chunk_copy_voxels(const Chunk *chunk, uint8_t *out_data)
     {
+#if CHUNK_LAYOUT == CHUNK_LAYOUT_LINEAR
         for (int32_t i = 0; i < CHUNK_VOXEL_COUNT; i++)
         {
             out_data[i] = chunk->voxels[i].material;
         }
+#elif CHUNK_LAYOUT == CHUNK_LAYOUT_BRICK
+        /* Each brick row of 8 voxels is contiguous */
+        for (int32_t z = 0; z < CHUNK_SIZE; z++)
+        {
+            for (int32_t y = 0; y < CHUNK_SIZE; y++)
+            {
+                uint8_t *dst = out_data + chunk_voxel_index_linear(0, y, z);
+                for (int32_t x = 0; x < CHUNK_SIZE; x += CHUNK_BRICK_SIZE)
+                {
+                    const VoxelCell *src = &chunk->voxels[chunk_voxel_index(x, y, z)];
+                    for (int32_t i = 0; i < CHUNK_BRICK_SIZE; i++)
+                        dst[x + i] = src[i].material;
+                }
+            }
+        }
+#else
+        for (int32_t z = 0; z < CHUNK_SIZE; z++)
+        {
+            for (int32_t y = 0; y < CHUNK_SIZE; y++)
+            {
+                uint8_t *dst = out_data + chunk_voxel_index_linear(0, y, z);
+                for (int32_t x = 0; x < CHUNK_SIZE; x++)
+                    dst[x] = chunk->voxels[chunk_voxel_index(x, y, z)].material;
+            }
+        }
+#endif
         return CHUNK_VOXEL_COUNT;
     }
 
@@ -10,6 +10,7 @@
 #include "engine/render/draw_list.h"
 #include "engine/render/voxel_push_constants.h"
 #include "engine/render/gpu_bvh.h"
+#include "engine/render/gpu_volume.h"
 #include "engine/render/gpu_memory.h"
 #include "engine/platform/window.h"
 #include <cstdint>
@@ -255,6 +256,7 @@ namespace patch
         void destroy_pipeline_cache();
         bool create_voxel_descriptor_layout();
         bool create_voxel_descriptors(int32_t total_chunks);
+        void upload_all_chunks(const VoxelVolume *vol);
         void update_voxel_depth_descriptor();
         bool create_compute_pipeline(const uint32_t *code, size_t code_size,
                                      VkPipelineLayout layout, VkPipeline *out_pipeline);
@@ -391,6 +393,8 @@ namespace patch
         void *staging_headers_mapped_ = nullptr;
 
         int32_t voxel_total_chunks_ = 0;
+        uint32_t voxel_ring_generation_ = 0;               /* Last uploaded window layout */
+        std::vector<GPUChunkHeader> voxel_slot_headers_; /* Last uploaded header per storage slot */
         bool voxel_resources_initialized_ = false;
 
         bool rt_supported_ = false;
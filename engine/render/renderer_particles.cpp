@@ -312,27 +312,28 @@ namespace patch
 
         float alpha = interp_alpha_;
 
-        for (int32_t i = 0; i < sys->count && active_count < MAX_PARTICLE_INSTANCES; i++)
+        for (int32_t l = 0; l < PARTICLE_LIST_COUNT; l++)
         {
-            const Particle *p = &sys->particles[i];
-            if (!p->active)
-                continue;
-
-            /* Interpolate between previous and current position for smooth rendering */
-            float interp_x = p->prev_position.x + alpha * (p->position.x - p->prev_position.x);
-            float interp_y = p->prev_position.y + alpha * (p->position.y - p->prev_position.y);
-            float interp_z = p->prev_position.z + alpha * (p->position.z - p->prev_position.z);
-
-            gpu_data[active_count].position[0] = interp_x;
-            gpu_data[active_count].position[1] = interp_y;
-            gpu_data[active_count].position[2] = interp_z;
-            gpu_data[active_count].radius = p->radius;
-            gpu_data[active_count].color[0] = p->color.x;
-            gpu_data[active_count].color[1] = p->color.y;
-            gpu_data[active_count].color[2] = p->color.z;
-            gpu_data[active_count].flags = 1.0f;
-
-            active_count++;
+            const ParticleIndexList *list = &sys->lists[l];
+            for (int32_t k = 0; k < list->count && active_count < MAX_PARTICLE_INSTANCES; k++)
+            {
+                int32_t i = list->slots[k];
+
+                /* Interpolate between previous and current position for smooth rendering */
+                Vec3 interp = particle_system_interpolated_position(sys, i, alpha);
+                float radius = sys->radius[i];
+
+                gpu_data[active_count].position[0] = interp.x;
+                gpu_data[active_count].position[1] = interp.y;
+                gpu_data[active_count].position[2] = interp.z;
+                gpu_data[active_count].radius = radius;
+                gpu_data[active_count].color[0] = sys->color[i].x;
+                gpu_data[active_count].color[1] = sys->color[i].y;
+                gpu_data[active_count].color[2] = sys->color[i].z;
+                gpu_data[active_count].flags = 1.0f;
+
+                active_count++;
+            }
         }
 
         gpu_allocator_.unmap(particle_ssbo_.memory);
@@ -124,7 +124,9 @@ namespace patch
 
         /* Create persistent staging buffers for chunk uploads (avoids per-frame allocation) */
         VkDeviceSize staging_voxel_size = static_cast<VkDeviceSize>(VOLUME_MAX_DIRTY_PER_FRAME) * GPU_CHUNK_DATA_SIZE;
-        VkDeviceSize staging_header_size = static_cast<VkDeviceSize>(VOLUME_MAX_DIRTY_PER_FRAME) * sizeof(GPUChunkHeader);
+        /* Header staging also holds a full logical table for window scrolls */
+        VkDeviceSize staging_header_size = static_cast<VkDeviceSize>(VOLUME_MAX_DIRTY_PER_FRAME + total_chunks) *
+                                           sizeof(GPUChunkHeader);
 
         create_buffer(staging_voxel_size,
                       VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
@@ -235,6 +237,81 @@ namespace patch
         }
     }
 
+    /*
+     * Full synchronous copy of every chunk (scene init). Window scrolls go
+     * through upload_dirty_chunks, which only rewrites the header table.
+     */
+    void Renderer::upload_all_chunks(const VoxelVolume *vol)
+    {
+        VkDeviceSize voxel_data_size = static_cast<VkDeviceSize>(vol->total_chunks) * GPU_CHUNK_DATA_SIZE;
+        VkDeviceSize headers_size = static_cast<VkDeviceSize>(vol->total_chunks) * sizeof(GPUChunkHeader);
+
+        VulkanBuffer staging_voxels{};
+        create_buffer(voxel_data_size,
+                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                      &staging_voxels);
+
+        VulkanBuffer staging_headers{};
+        create_buffer(headers_size,
+                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                      &staging_headers);
+
+        /* Voxel data in storage-slot order, headers in logical order pointing at their slot */
+        voxel_slot_headers_.assign(static_cast<size_t>(vol->total_chunks), GPUChunkHeader{});
+        uint8_t *voxel_mapped = static_cast<uint8_t *>(gpu_allocator_.map(staging_voxels.allocation));
+        GPUChunkHeader *headers_mapped = static_cast<GPUChunkHeader *>(gpu_allocator_.map(staging_headers.allocation));
+        for (int32_t ci = 0; ci < vol->total_chunks; ci++)
+        {
+            int32_t li = volume_slot_to_logical(vol, ci);
+            gpu_chunk_copy_voxels(&vol->chunks[ci], voxel_mapped + ci * GPU_CHUNK_DATA_SIZE);
+            GPUChunkHeader header = gpu_chunk_header_from_chunk(&vol->chunks[ci]);
+            header.data_slot = static_cast<uint32_t>(ci);
+            voxel_slot_headers_[ci] = header;
+            headers_mapped[li] = header;
+        }
+        gpu_allocator_.unmap(staging_headers.allocation);
+        gpu_allocator_.unmap(staging_voxels.allocation);
+
+        VkCommandBufferAllocateInfo alloc_info{};
+        alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        alloc_info.commandPool = command_pool_;
+        alloc_info.commandBufferCount = 1;
+
+        VkCommandBuffer cmd;
+        vkAllocateCommandBuffers(device_, &alloc_info, &cmd);
+
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(cmd, &begin_info);
+
+        VkBufferCopy copy_region{};
+        copy_region.size = voxel_data_size;
+        vkCmdCopyBuffer(cmd, staging_voxels.buffer, voxel_data_buffer_.buffer, 1, &copy_region);
+
+        copy_region.size = headers_size;
+        vkCmdCopyBuffer(cmd, staging_headers.buffer, voxel_headers_buffer_.buffer, 1, &copy_region);
+
+        vkEndCommandBuffer(cmd);
+
+        VkSubmitInfo submit_info{};
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = &cmd;
+
+        vkQueueSubmit(graphics_queue_, 1, &submit_info, VK_NULL_HANDLE);
+        vkQueueWaitIdle(graphics_queue_);
+
+        vkFreeCommandBuffers(device_, command_pool_, 1, &cmd);
+        destroy_buffer(&staging_voxels);
+        destroy_buffer(&staging_headers);
+
+        voxel_ring_generation_ = vol->ring_generation;
+    }
+
     void Renderer::init_volume_for_raymarching(const VoxelVolume *vol)
     {
         PROFILE_BEGIN(PROFILE_VOLUME_INIT);
@@ -342,85 +419,7 @@ namespace patch
         memcpy(mapped, &palette, palette_upload_size);
         gpu_allocator_.unmap(voxel_material_buffer_.allocation);
 
-        VkDeviceSize voxel_data_size = static_cast<VkDeviceSize>(vol->total_chunks) * GPU_CHUNK_DATA_SIZE;
-        VkDeviceSize headers_size = static_cast<VkDeviceSize>(vol->total_chunks) * sizeof(GPUChunkHeader);
-
-        VulkanBuffer staging_voxels{};
-        create_buffer(voxel_data_size,
-                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                      &staging_voxels);
-
-        VulkanBuffer staging_headers{};
-        create_buffer(headers_size,
-                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                      &staging_headers);
-
-        uint8_t *voxel_mapped = static_cast<uint8_t *>(gpu_allocator_.map(staging_voxels.allocation));
-        int32_t total_solid = 0;
-        for (int32_t ci = 0; ci < vol->total_chunks; ci++)
-        {
-            gpu_chunk_copy_voxels(&vol->chunks[ci], voxel_mapped + ci * GPU_CHUNK_DATA_SIZE);
-        }
-        /* DEBUG: Check chunk 0 data */
-        for (int32_t i = 0; i < 160; i++) /* First 5 Y layers: 32*5 = 160 voxels */
-        {
-            if (voxel_mapped[i] != 0)
-                total_solid++;
-        }
-        printf("  DEBUG: Chunk 0 first 160 voxels have %d solid\n", total_solid);
-        printf("  DEBUG: First 8 bytes: %02x %02x %02x %02x %02x %02x %02x %02x\n",
-               voxel_mapped[0], voxel_mapped[1], voxel_mapped[2], voxel_mapped[3],
-               voxel_mapped[4], voxel_mapped[5], voxel_mapped[6], voxel_mapped[7]);
-        gpu_allocator_.unmap(staging_voxels.allocation);
-
-        GPUChunkHeader *headers_mapped = static_cast<GPUChunkHeader *>(gpu_allocator_.map(staging_headers.allocation));
-        for (int32_t ci = 0; ci < vol->total_chunks; ci++)
-        {
-            headers_mapped[ci] = gpu_chunk_header_from_chunk(&vol->chunks[ci]);
-        }
-        /* DEBUG: Show chunk 0 header */
-        printf("  DEBUG: Chunk 0 header: level0_lo=%08x level0_hi=%08x packed=%08x\n",
-               headers_mapped[0].level0_lo, headers_mapped[0].level0_hi, headers_mapped[0].packed);
-        printf("  DEBUG: Chunk 0 has_any=%d solid_count=%d\n",
-               (headers_mapped[0].packed & 0xFF), (headers_mapped[0].packed >> 16));
-        gpu_allocator_.unmap(staging_headers.allocation);
-
-        VkCommandBufferAllocateInfo alloc_info{};
-        alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        alloc_info.commandPool = command_pool_;
-        alloc_info.commandBufferCount = 1;
-
-        VkCommandBuffer cmd;
-        vkAllocateCommandBuffers(device_, &alloc_info, &cmd);
-
-        VkCommandBufferBeginInfo begin_info{};
-        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        vkBeginCommandBuffer(cmd, &begin_info);
-
-        VkBufferCopy copy_region{};
-        copy_region.size = voxel_data_size;
-        vkCmdCopyBuffer(cmd, staging_voxels.buffer, voxel_data_buffer_.buffer, 1, &copy_region);
-
-        copy_region.size = headers_size;
-        vkCmdCopyBuffer(cmd, staging_headers.buffer, voxel_headers_buffer_.buffer, 1, &copy_region);
-
-        vkEndCommandBuffer(cmd);
-
-        VkSubmitInfo submit_info{};
-        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        submit_info.commandBufferCount = 1;
-        submit_info.pCommandBuffers = &cmd;
-
-        vkQueueSubmit(graphics_queue_, 1, &submit_info, VK_NULL_HANDLE);
-        vkQueueWaitIdle(graphics_queue_);
-
-        vkFreeCommandBuffers(device_, command_pool_, 1, &cmd);
-        destroy_buffer(&staging_voxels);
-        destroy_buffer(&staging_headers);
+        upload_all_chunks(vol);
 
         int32_t voxels_x = vol->chunks_x * CHUNK_SIZE;
         int32_t voxels_y = vol->chunks_y * CHUNK_SIZE;
@@ -577,17 +576,19 @@ namespace patch
                 }
                 else
                 {
+                    const VoxelObjectPose pose = voxel_object_pose(objects, i);
+
                     /* Check position delta */
-                    float dx = obj->position.x - state->position.x;
-                    float dy = obj->position.y - state->position.y;
-                    float dz = obj->position.z - state->position.z;
+                    float dx = pose.position.x - state->position.x;
+                    float dy = pose.position.y - state->position.y;
+                    float dz = pose.position.z - state->position.z;
                     float dist_sq = dx * dx + dy * dy + dz * dz;
 
                     /* Check orientation delta (dot product for quaternion difference) */
-                    float dot = obj->orientation.x * state->orientation.x +
-                                obj->orientation.y * state->orientation.y +
-                                obj->orientation.z * state->orientation.z +
-                                obj->orientation.w * state->orientation.w;
+                    float dot = pose.orientation.x * state->orientation.x +
+                                pose.orientation.y * state->orientation.y +
+                                pose.orientation.z * state->orientation.z +
+                                pose.orientation.w * state->orientation.w;
                     float orient_diff = 1.0f - dot * dot;
 
                     if (dist_sq > SHADOW_POSITION_THRESHOLD * SHADOW_POSITION_THRESHOLD ||
@@ -604,57 +605,58 @@ namespace patch
 
         if (particles && particles->count > 0)
         {
-            for (int32_t i = 0; i < particles->count; i++)
+            for (int32_t l = 0; l < PARTICLE_LIST_COUNT; l++)
             {
-                const Particle *p = &particles->particles[i];
-                if (!p->active)
-                    continue;
-
-                float interp_x = p->prev_position.x + interp_alpha_ * (p->position.x - p->prev_position.x);
-                float interp_y = p->prev_position.y + interp_alpha_ * (p->position.y - p->prev_position.y);
-                float interp_z = p->prev_position.z + interp_alpha_ * (p->position.z - p->prev_position.z);
-
-                float rel_x = interp_x - vol->bounds.min_x;
-                float rel_y = interp_y - vol->bounds.min_y;
-                float rel_z = interp_z - vol->bounds.min_z;
-
-                int32_t min_vx = (int32_t)((rel_x - p->radius) / vol->voxel_size);
-                int32_t min_vy = (int32_t)((rel_y - p->radius) / vol->voxel_size);
-                int32_t min_vz = (int32_t)((rel_z - p->radius) / vol->voxel_size);
-                int32_t max_vx = (int32_t)((rel_x + p->radius) / vol->voxel_size);
-                int32_t max_vy = (int32_t)((rel_y + p->radius) / vol->voxel_size);
-                int32_t max_vz = (int32_t)((rel_z + p->radius) / vol->voxel_size);
-
-                if (min_vx < 0)
-                    min_vx = 0;
-                if (min_vy < 0)
-                    min_vy = 0;
-                if (min_vz < 0)
-                    min_vz = 0;
-                if (max_vx >= voxels_x)
-                    max_vx = voxels_x - 1;
-                if (max_vy >= voxels_y)
-                    max_vy = voxels_y - 1;
-                if (max_vz >= voxels_z)
-                    max_vz = voxels_z - 1;
-
-                if (min_vx > max_vx || min_vy > max_vy || min_vz > max_vz)
-                    continue;
-
-                if (min_vx < particle_min[0])
-                    particle_min[0] = min_vx;
-                if (min_vy < particle_min[1])
-                    particle_min[1] = min_vy;
-                if (min_vz < particle_min[2])
-                    particle_min[2] = min_vz;
-                if (max_vx > particle_max[0])
-                    particle_max[0] = max_vx;
-                if (max_vy > particle_max[1])
-                    particle_max[1] = max_vy;
-                if (max_vz > particle_max[2])
-                    particle_max[2] = max_vz;
-
-                active_particle_count++;
+                const ParticleIndexList *list = &particles->lists[l];
+                for (int32_t k = 0; k < list->count; k++)
+                {
+                    int32_t i = list->slots[k];
+
+                    Vec3 interp = particle_system_interpolated_position(particles, i, interp_alpha_);
+                    float radius = particles->radius[i];
+
+                    float rel_x = interp.x - vol->bounds.min_x;
+                    float rel_y = interp.y - vol->bounds.min_y;
+                    float rel_z = interp.z - vol->bounds.min_z;
+
+                    int32_t min_vx = (int32_t)((rel_x - radius) / vol->voxel_size);
+                    int32_t min_vy = (int32_t)((rel_y - radius) / vol->voxel_size);
+                    int32_t min_vz = (int32_t)((rel_z - radius) / vol->voxel_size);
+                    int32_t max_vx = (int32_t)((rel_x + radius) / vol->voxel_size);
+                    int32_t max_vy = (int32_t)((rel_y + radius) / vol->voxel_size);
+                    int32_t max_vz = (int32_t)((rel_z + radius) / vol->voxel_size);
+
+                    if (min_vx < 0)
+                        min_vx = 0;
+                    if (min_vy < 0)
+                        min_vy = 0;
+                    if (min_vz < 0)
+                        min_vz = 0;
+                    if (max_vx >= voxels_x)
+                        max_vx = voxels_x - 1;
+                    if (max_vy >= voxels_y)
+                        max_vy = voxels_y - 1;
+                    if (max_vz >= voxels_z)
+                        max_vz = voxels_z - 1;
+
+                    if (min_vx > max_vx || min_vy > max_vy || min_vz > max_vz)
+                        continue;
+
+                    if (min_vx < particle_min[0])
+                        particle_min[0] = min_vx;
+                    if (min_vy < particle_min[1])
+                        particle_min[1] = min_vy;
+                    if (min_vz < particle_min[2])
+                        particle_min[2] = min_vz;
+                    if (max_vx > particle_max[0])
+                        particle_max[0] = max_vx;
+                    if (max_vy > particle_max[1])
+                        particle_max[1] = max_vy;
+                    if (max_vz > particle_max[2])
+                        particle_max[2] = max_vz;
+
+                    active_particle_count++;
+                }
             }
         }
 
@@ -790,10 +792,8 @@ namespace patch
 
                 for (int32_t i = 0; i < dirty_count; i++)
                 {
-                    int32_t chunk_idx = dirty_chunks[i];
-                    int32_t cx = chunk_idx % vol->chunks_x;
-                    int32_t cy = (chunk_idx / vol->chunks_x) % vol->chunks_y;
-                    int32_t cz = chunk_idx / (vol->chunks_x * vol->chunks_y);
+                    int32_t cx, cy, cz;
+                    volume_slot_to_chunk(vol, dirty_chunks[i], &cx, &cy, &cz);
 
                     if (cx < min_cx)
                         min_cx = cx;
@@ -878,10 +878,28 @@ namespace patch
             pending_destroy_count_ = write_idx;
         }
 
+        /*
+         * Window scrolled: voxel data stays in its storage slot, only the
+         * logical header table moves. Recycled slots were cleared on the CPU
+         * (LOADING) and read as empty until their streamed data arrives dirty.
+         */
+        bool ring_changed = vol->ring_generation != voxel_ring_generation_;
+        if (ring_changed)
+        {
+            for (int32_t ci = 0; ci < vol->total_chunks; ci++)
+            {
+                if (vol->chunks[ci].state == CHUNK_STATE_LOADING)
+                {
+                    voxel_slot_headers_[ci] = GPUChunkHeader{};
+                    voxel_slot_headers_[ci].data_slot = static_cast<uint32_t>(ci);
+                }
+            }
+        }
+
         int32_t dirty_indices[VOLUME_MAX_UPLOADS_PER_FRAME];
         int32_t dirty_count = volume_get_dirty_chunks(vol, dirty_indices, VOLUME_MAX_UPLOADS_PER_FRAME);
 
-        if (dirty_count <= 0)
+        if (dirty_count <= 0 && !ring_changed)
         {
             PROFILE_END(PROFILE_CHUNK_UPLOAD);
             return 0;
@@ -932,7 +950,10 @@ namespace patch
                 continue;
 
             gpu_chunk_copy_voxels(&vol->chunks[ci], voxel_mapped + staging_idx * GPU_CHUNK_DATA_SIZE);
-            headers_mapped[staging_idx] = gpu_chunk_header_from_chunk(&vol->chunks[ci]);
+            GPUChunkHeader header = gpu_chunk_header_from_chunk(&vol->chunks[ci]);
+            header.data_slot = static_cast<uint32_t>(ci);
+            voxel_slot_headers_[ci] = header;
+            headers_mapped[staging_idx] = header;
 
             VkBufferCopy voxel_copy{};
             voxel_copy.srcOffset = staging_idx * GPU_CHUNK_DATA_SIZE;
@@ -940,13 +961,33 @@ namespace patch
             voxel_copy.size = GPU_CHUNK_DATA_SIZE;
             voxel_copies.push_back(voxel_copy);
 
+            /* The full table below already carries this header */
+            if (ring_changed)
+                continue;
+
+            int32_t li = volume_slot_to_logical(vol, ci);
             VkBufferCopy header_copy{};
             header_copy.srcOffset = staging_idx * sizeof(GPUChunkHeader);
-            header_copy.dstOffset = ci * sizeof(GPUChunkHeader);
+            header_copy.dstOffset = li * sizeof(GPUChunkHeader);
             header_copy.size = sizeof(GPUChunkHeader);
             header_copies.push_back(header_copy);
         }
 
+        /* Whole header table in logical order after the per-chunk entries (one copy) */
+        if (ring_changed)
+        {
+            GPUChunkHeader *table = headers_mapped + VOLUME_MAX_DIRTY_PER_FRAME;
+            for (int32_t ci = 0; ci < vol->total_chunks; ci++)
+                table[volume_slot_to_logical(vol, ci)] = voxel_slot_headers_[ci];
+
+            VkBufferCopy table_copy{};
+            table_copy.srcOffset = static_cast<VkDeviceSize>(VOLUME_MAX_DIRTY_PER_FRAME) * sizeof(GPUChunkHeader);
+            table_copy.dstOffset = 0;
+            table_copy.size = static_cast<VkDeviceSize>(vol->total_chunks) * sizeof(GPUChunkHeader);
+            header_copies.push_back(table_copy);
+            voxel_ring_generation_ = vol->ring_generation;
+        }
+
         /* No unmap needed - persistent buffers stay mapped */
 
         VkCommandBuffer upload_cmd = upload_cmd_[current_frame_];
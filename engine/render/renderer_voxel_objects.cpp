@@ -717,13 +717,14 @@ namespace patch
             VoxelObjectGPU *gpu = &gpu_data[i];
 
             float vs = obj->voxel_size;
+            const VoxelObjectPose pose = voxel_object_pose(world, i);
 
             /* Check if object should be rendered (for visible count tracking) */
             float max_half_ext = (std::max)(obj->shape_half_extents.x,
                                            (std::max)(obj->shape_half_extents.y,
                                                       obj->shape_half_extents.z));
             float bounding_radius = max_half_ext * 1.732051f;
-            FrustumResult cull_result = frustum_test_sphere(&frustum, obj->position, bounding_radius);
+            FrustumResult cull_result = frustum_test_sphere(&frustum, pose.position, bounding_radius);
             bool atlas_ready = !is_vobj_dirty(static_cast<uint32_t>(i));
             bool render_ready = obj->render_delay <= 0;
             bool visible = (cull_result != FRUSTUM_OUTSIDE) && obj->active && atlas_ready && render_ready;
@@ -740,10 +741,10 @@ namespace patch
             }
 
             float rot_mat[9];
-            quat_to_mat3(obj->orientation, rot_mat);
+            quat_to_mat3(pose.orientation, rot_mat);
 
             /* Position is the object center; no center-of-mass offset. */
-            const Vec3 translation = obj->position;
+            const Vec3 translation = pose.position;
 
             /* Column-major local_to_world = [R * voxel_size, pos] */
             float world_mat[16] = {
@@ -778,9 +779,9 @@ namespace patch
             gpu->bounds_max[2] = obj->shape_half_extents.z;
             gpu->bounds_max[3] = static_cast<float>(VOBJ_GRID_SIZE);
 
-            gpu->position[0] = obj->position.x;
-            gpu->position[1] = obj->position.y;
-            gpu->position[2] = obj->position.z;
+            gpu->position[0] = pose.position.x;
+            gpu->position[1] = pose.position.y;
+            gpu->position[2] = pose.position.z;
             /* Only mark as active if atlas data is ready - prevents flickering during spawn */
             bool atlas_ready_for_gpu = !is_vobj_dirty(static_cast<uint32_t>(i));
             gpu->position[3] = (obj->active && atlas_ready_for_gpu) ? 1.0f : 0.0f;
@@ -23,64 +23,101 @@ int32_t detach_object_at_point(VoxelObjectWorld *world, int32_t obj_index,
     }
 
     int32_t destroyed_count = 0;
-    float half_size = obj->voxel_size * (float)VOBJ_GRID_SIZE * 0.5f;
-    float rot_mat[9];
-    quat_to_mat3(obj->orientation, rot_mat);
-    Vec3 pivot = obj->position;
+    int32_t removed = 0;
+    float vs = obj->voxel_size;
+    float half_size = vs * (float)VOBJ_GRID_SIZE * 0.5f;
+    float rot_mat[9], inv_rot[9];
+    VoxelObjectPose pose = voxel_object_pose(world, obj_index);
+    quat_to_mat3(pose.orientation, rot_mat);
+    mat3_transpose(rot_mat, inv_rot);
+    Vec3 pivot = pose.position;
+
+    /* Impact in grid units, where voxel (x, y, z) is centred at (x, y, z) */
+    Vec3 local_impact = mat3_transform_vec3(inv_rot, vec3_sub(impact_point, pivot));
+    float inv_vs = 1.0f / vs;
+    float c[3] = {(local_impact.x + half_size) * inv_vs - 0.5f,
+                  (local_impact.y + half_size) * inv_vs - 0.5f,
+                  (local_impact.z + half_size) * inv_vs - 0.5f};
+    float r = destroy_radius * inv_vs;
+    float r_sq = r * r;
+
+    /* Voxel box of the destroy sphere, clamped to the grid */
+    int32_t lo[3] = {0, 0, 0};
+    int32_t hi[3] = {-1, -1, -1};
+    if (destroy_radius > 0.0f)
+    {
+        for (int32_t a = 0; a < 3; a++)
+        {
+            float fl = ceilf(c[a] - r);
+            float fh = floorf(c[a] + r);
+            lo[a] = fl < 0.0f ? 0 : (fl > (float)VOBJ_GRID_SIZE ? VOBJ_GRID_SIZE : (int32_t)fl);
+            hi[a] = fh > (float)(VOBJ_GRID_SIZE - 1) ? VOBJ_GRID_SIZE - 1 : (fh < -1.0f ? -1 : (int32_t)fh);
+        }
+    }
 
-    for (int32_t z = 0; z < VOBJ_GRID_SIZE; z++)
+    for (int32_t z = lo[2]; z <= hi[2]; z++)
     {
-        for (int32_t y = 0; y < VOBJ_GRID_SIZE; y++)
+        float dz = (float)z - c[2];
+        for (int32_t y = lo[1]; y <= hi[1]; y++)
         {
-            for (int32_t x = 0; x < VOBJ_GRID_SIZE; x++)
+            float dy = (float)y - c[1];
+            float dyz_sq = dy * dy + dz * dz;
+            if (dyz_sq >= r_sq)
+                continue;
+
+            /* Only the sphere's chord through this row */
+            float chord = sqrtf(r_sq - dyz_sq);
+            float fl = ceilf(c[0] - chord);
+            float fh = floorf(c[0] + chord);
+            int32_t x0 = fl < (float)lo[0] ? lo[0] : (int32_t)fl;
+            int32_t x1 = fh > (float)hi[0] ? hi[0] : (int32_t)fh;
+
+            VObjVoxel *row = &obj->voxels[vobj_index(0, y, z)];
+            for (int32_t x = x0; x <= x1; x++)
             {
-                int32_t idx = vobj_index(x, y, z);
-                if (obj->voxels[idx].material == 0)
+                if (row[x].material == 0)
                     continue;
 
-                Vec3 local_pos;
-                local_pos.x = ((float)x + 0.5f) * obj->voxel_size - half_size;
-                local_pos.y = ((float)y + 0.5f) * obj->voxel_size - half_size;
-                local_pos.z = ((float)z + 0.5f) * obj->voxel_size - half_size;
-
-                Vec3 rotated = mat3_transform_vec3(rot_mat, local_pos);
-                Vec3 voxel_pos = vec3_add(pivot, rotated);
-
-                float dist = vec3_length(vec3_sub(voxel_pos, impact_point));
+                float dx = (float)x - c[0];
+                if (dx * dx + dyz_sq >= r_sq)
+                    continue;
 
-                if (dist < destroy_radius)
+                if (destroyed_count < max_output)
                 {
-                    if (destroyed_count < max_output)
+                    if (out_positions)
                     {
-                        if (out_positions)
-                            out_positions[destroyed_count] = voxel_pos;
-                        if (out_materials)
-                            out_materials[destroyed_count] = obj->voxels[idx].material;
-                        destroyed_count++;
+                        Vec3 local_pos = vec3_create(((float)x + 0.5f) * vs - half_size,
+                                                     ((float)y + 0.5f) * vs - half_size,
+                                                     ((float)z + 0.5f) * vs - half_size);
+                        out_positions[destroyed_count] = vec3_add(pivot, mat3_transform_vec3(rot_mat, local_pos));
                     }
-
-                    obj->voxels[idx].material = 0;
-                    obj->voxel_count--;
+                    if (out_materials)
+                        out_materials[destroyed_count] = row[x].material;
+                    destroyed_count++;
                 }
+
+                row[x].material = 0;
+                obj->voxel_count--;
+                removed++;
             }
         }
     }
 
-    if (obj->voxel_count <= 0)
-    {
-        obj->active = false;
-        voxel_object_world_free_slot(world, obj_index);
-    }
-    else
-    {
-        /* Defer shape recalc and island splitting to per-frame budget */
-        voxel_object_world_mark_dirty(world, obj_index);
-        voxel_object_world_queue_split(world, obj_index);
-    }
-
-    if (destroyed_count > 0)
+    /* A miss leaves the shape alone: nothing to recalc or split */
+    if (removed > 0)
     {
         obj->voxel_revision++;
+        if (obj->voxel_count <= 0)
+        {
+            obj->active = false;
+            voxel_object_world_free_slot(world, obj_index);
+        }
+        else
+        {
+            /* Defer shape recalc and island splitting to per-frame budget */
+            voxel_object_world_mark_dirty(world, obj_index);
+            voxel_object_world_queue_split(world, obj_index);
+        }
     }
 
     PROFILE_END(PROFILE_SIM_VOXEL_UPDATE);
@@ -126,6 +163,44 @@ void detach_terrain_process(VoxelVolume *vol,
 
         local_result.islands_processed++;
 
+        int32_t ext_size_x = island->voxel_max_x - island->voxel_min_x + 1;
+        int32_t ext_size_y = island->voxel_max_y - island->voxel_min_y + 1;
+        int32_t ext_size_z = island->voxel_max_z - island->voxel_min_z + 1;
+        bool oversized = ext_size_x > VOBJ_GRID_SIZE || ext_size_y > VOBJ_GRID_SIZE || ext_size_z > VOBJ_GRID_SIZE;
+
+        uint8_t extract_buf[VOBJ_TOTAL_VOXELS];
+        Vec3 extract_origin;
+        int32_t extracted = -1; /* Not extracted yet */
+
+        /* Offer the island as debris before any object is considered */
+        if (config->debris_fn && !oversized)
+        {
+            extracted = connectivity_extract_island_with_ids(vol, island, work,
+                                                             extract_buf,
+                                                             ext_size_x, ext_size_y, ext_size_z,
+                                                             &extract_origin);
+            if (extracted > 0)
+            {
+                DetachFragment fragment;
+                fragment.voxels = extract_buf;
+                fragment.size_x = ext_size_x;
+                fragment.size_y = ext_size_y;
+                fragment.size_z = ext_size_z;
+                fragment.origin = extract_origin;
+                fragment.voxel_size = vol->voxel_size;
+                fragment.voxel_count = extracted;
+                fragment.active_bodies = active_bodies;
+
+                if (config->debris_fn(config->debris_user, &fragment))
+                {
+                    connectivity_remove_island(vol, island, work);
+                    local_result.islands_demoted++;
+                    processed++;
+                    continue;
+                }
+            }
+        }
+
         if (island->voxel_count < config->min_voxels_per_island)
         {
             connectivity_remove_island(vol, island, work);
@@ -141,12 +216,8 @@ void detach_terrain_process(VoxelVolume *vol,
             continue;
         }
 
-        int32_t ext_size_x = island->voxel_max_x - island->voxel_min_x + 1;
-        int32_t ext_size_y = island->voxel_max_y - island->voxel_min_y + 1;
-        int32_t ext_size_z = island->voxel_max_z - island->voxel_min_z + 1;
-
         /* Oversized islands: BFS-based subdivision into organic 32³ chunks */
-        if (ext_size_x > VOBJ_GRID_SIZE || ext_size_y > VOBJ_GRID_SIZE || ext_size_z > VOBJ_GRID_SIZE)
+        if (oversized)
         {
             uint8_t target_id = (uint8_t)island->island_id;
             bool any_spawned = false;
@@ -340,14 +411,13 @@ void detach_terrain_process(VoxelVolume *vol,
             continue;
         }
 
-        uint8_t extract_buf[VOBJ_TOTAL_VOXELS];
-        memset(extract_buf, 0, sizeof(extract_buf));
-
-        Vec3 extract_origin;
-        int32_t extracted = connectivity_extract_island_with_ids(vol, island, work,
-                                                                 extract_buf,
-                                                                 ext_size_x, ext_size_y, ext_size_z,
-                                                                 &extract_origin);
+        if (extracted < 0)
+        {
+            extracted = connectivity_extract_island_with_ids(vol, island, work,
+                                                             extract_buf,
+                                                             ext_size_x, ext_size_y, ext_size_z,
+                                                             &extract_origin);
+        }
 
         if (extracted <= 0)
         {
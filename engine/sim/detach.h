@@ -22,6 +22,20 @@ extern "C"
  * 2. Terrain detachment - convert floating terrain islands to objects
  */
 
+/* A floating island offered as debris, in the layout voxel_object_world_add_from_voxels takes */
+typedef struct
+{
+    const uint8_t *voxels; /* size_x * size_y * size_z materials, x fastest, 0 = empty */
+    int32_t size_x, size_y, size_z;
+    Vec3 origin;           /* World min corner of voxel (0, 0, 0) */
+    float voxel_size;
+    int32_t voxel_count;
+    int32_t active_bodies; /* Active voxel objects when offered */
+} DetachFragment;
+
+/* Returns true when it took the fragment; the island is then removed without spawning an object */
+typedef bool (*DetachDebrisFn)(void *user, const DetachFragment *fragment);
+
 /* Configuration for terrain detach behavior */
 typedef struct
 {
@@ -30,6 +44,8 @@ typedef struct
     int32_t min_voxels_per_island;
     int32_t max_bodies_alive;
     float anchor_y_offset;
+    DetachDebrisFn debris_fn; /* Offered every island that fits one object first, NULL = none */
+    void *debris_user;
 } DetachConfig;
 
 #define DETACH_MAX_SPAWNED 16
@@ -41,6 +57,7 @@ typedef struct
     int32_t bodies_spawned;
     int32_t voxels_removed;
     int32_t islands_skipped;
+    int32_t islands_demoted; /* Taken by debris_fn */
     int32_t spawned_indices[DETACH_MAX_SPAWNED];
 } DetachResult;
 
@@ -53,6 +70,8 @@ static inline DetachConfig detach_config_default(void)
     cfg.min_voxels_per_island = 4;
     cfg.max_bodies_alive = VOBJ_MAX_OBJECTS - 8;
     cfg.anchor_y_offset = 0.1f;
+    cfg.debris_fn = NULL;
+    cfg.debris_user = NULL;
     return cfg;
 }
 
@@ -70,7 +89,9 @@ int32_t detach_object_at_point(VoxelObjectWorld *world, int32_t obj_index,
 
 /*
  * Process terrain detachment after voxel edits.
- * Finds floating islands and converts them to voxel objects.
+ * Finds floating islands and converts them to voxel objects. With a
+ * debris_fn, islands it takes (tiny ones included) leave the terrain
+ * without becoming objects, even when max_bodies_alive is reached.
  *
  * Call after volume_edit_end() when voxels have been removed.
  */
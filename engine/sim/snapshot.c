@@ -0,0 +1,426 @@
+#include "snapshot.h"
+#include "engine/voxel/bvh.h"
+#include "engine/core/profile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint64_t snapshot_align(uint64_t offset, uint64_t alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+static int32_t count_active_objects(const VoxelObjectWorld *objects)
+{
+    int32_t count = 0;
+    if (!objects)
+        return 0;
+    for (int32_t i = 0; i < objects->object_count; i++)
+    {
+        if (objects->objects[i].active)
+            count++;
+    }
+    return count;
+}
+
+/* Section offsets and file size from the header's counts, as snapshot_save lays them out */
+static void snapshot_fill_offsets(SnapshotHeader *header)
+{
+    header->chunk_offset = snapshot_align(sizeof(SnapshotHeader), SNAPSHOT_ALIGNMENT);
+    uint64_t chunk_end = header->chunk_offset + (uint64_t)header->total_chunks * sizeof(Chunk);
+    header->object_offset = snapshot_align(chunk_end, 16);
+    uint64_t object_end = header->object_offset + (uint64_t)header->object_count * sizeof(SnapshotObjectRecord);
+    header->body_offset = snapshot_align(object_end, 16);
+    uint64_t body_end = header->body_offset + (uint64_t)header->body_slot_count * sizeof(SnapshotBodyRecord);
+
+    /* Alignment padding after the last non-empty section is never written */
+    if (header->body_slot_count > 0)
+        header->file_size = body_end;
+    else if (header->object_count > 0)
+        header->file_size = object_end;
+    else
+        header->file_size = chunk_end;
+}
+
+static void snapshot_fill_layout(SnapshotHeader *header, const VoxelVolume *vol,
+                                 const VoxelObjectWorld *objects, const PhysicsWorld *physics)
+{
+    memset(header, 0, sizeof(*header));
+    header->magic = SNAPSHOT_MAGIC;
+    header->version = SNAPSHOT_VERSION;
+    header->header_size = (uint32_t)sizeof(SnapshotHeader);
+    header->chunk_size = CHUNK_SIZE;
+    header->chunk_record_size = (uint32_t)sizeof(Chunk);
+    header->object_record_size = (uint32_t)sizeof(SnapshotObjectRecord);
+    header->body_record_size = (uint32_t)sizeof(SnapshotBodyRecord);
+    header->voxel_layout = CHUNK_LAYOUT;
+
+    header->chunks_x = vol->chunks_x;
+    header->chunks_y = vol->chunks_y;
+    header->chunks_z = vol->chunks_z;
+    header->total_chunks = vol->total_chunks;
+    header->bounds = vol->bounds;
+    header->voxel_size = vol->voxel_size;
+
+    header->object_count = count_active_objects(objects);
+    header->object_slot_count = objects ? objects->object_count : 0;
+    header->body_slot_count = physics ? physics->max_body_index + 1 : 0;
+    header->gravity = physics ? physics->gravity : vec3_create(0.0f, PHYS_GRAVITY_Y, 0.0f);
+    snapshot_fill_offsets(header);
+}
+
+static bool snapshot_header_valid(const SnapshotHeader *header)
+{
+    if (!(header->magic == SNAPSHOT_MAGIC &&
+          header->version == SNAPSHOT_VERSION &&
+          header->header_size == sizeof(SnapshotHeader) &&
+          header->chunk_size == CHUNK_SIZE &&
+          header->chunk_record_size == sizeof(Chunk) &&
+          header->object_record_size == sizeof(SnapshotObjectRecord) &&
+          header->body_record_size == sizeof(SnapshotBodyRecord) &&
+          header->voxel_layout == CHUNK_LAYOUT &&
+          header->chunks_x > 0 && header->chunks_x <= VOLUME_MAX_CHUNKS_X &&
+          header->chunks_y > 0 && header->chunks_y <= VOLUME_MAX_CHUNKS_Y &&
+          header->chunks_z > 0 && header->chunks_z <= VOLUME_MAX_CHUNKS_Z &&
+          header->total_chunks == header->chunks_x * header->chunks_y * header->chunks_z &&
+          header->object_count >= 0 && header->object_count <= VOBJ_MAX_OBJECTS &&
+          header->object_slot_count >= 0 && header->object_slot_count <= VOBJ_MAX_OBJECTS &&
+          header->body_slot_count >= 0 && header->body_slot_count <= PHYS_MAX_BODIES))
+        return false;
+
+    /* Sections must sit exactly where snapshot_save puts them for these counts */
+    SnapshotHeader layout = *header;
+    snapshot_fill_offsets(&layout);
+    return layout.chunk_offset == header->chunk_offset &&
+           layout.object_offset == header->object_offset &&
+           layout.body_offset == header->body_offset &&
+           layout.file_size == header->file_size;
+}
+
+static bool write_at(FILE *f, uint64_t offset, const void *data, size_t size)
+{
+    if (!platform_file_seek(f, offset))
+        return false;
+    return size == 0 || fwrite(data, size, 1, f) == 1;
+}
+
+/* Chunks are stored in ACTIVE state and logical order (ring offsets resolved)
+   so adopted pages need no fixup on load */
+static bool write_chunk(FILE *f, const SnapshotHeader *header, const VoxelVolume *vol,
+                        int32_t slot, Chunk *scratch)
+{
+    memcpy(scratch, &vol->chunks[slot], sizeof(Chunk));
+    scratch->state = CHUNK_STATE_ACTIVE;
+    scratch->dirty_frame = 0;
+    int32_t chunk_index = volume_slot_to_logical(vol, slot);
+    uint64_t offset = header->chunk_offset + (uint64_t)chunk_index * sizeof(Chunk);
+    return write_at(f, offset, scratch, sizeof(Chunk));
+}
+
+static bool write_object_and_body_sections(FILE *f, const SnapshotHeader *header,
+                                           const VoxelObjectWorld *objects,
+                                           const PhysicsWorld *physics)
+{
+    if (objects && header->object_count > 0)
+    {
+        SnapshotObjectRecord *record = (SnapshotObjectRecord *)calloc(1, sizeof(SnapshotObjectRecord));
+        if (!record)
+            return false;
+
+        if (!platform_file_seek(f, header->object_offset))
+        {
+            free(record);
+            return false;
+        }
+
+        for (int32_t i = 0; i < objects->object_count; i++)
+        {
+            const VoxelObject *obj = &objects->objects[i];
+            if (!obj->active)
+                continue;
+
+            record->slot = i;
+            record->object = *obj;
+            record->pose = voxel_object_pose(objects, i);
+            if (fwrite(record, sizeof(SnapshotObjectRecord), 1, f) != 1)
+            {
+                free(record);
+                return false;
+            }
+        }
+        free(record);
+    }
+
+    if (physics && header->body_slot_count > 0)
+    {
+        if (!platform_file_seek(f, header->body_offset))
+            return false;
+
+        for (int32_t i = 0; i < header->body_slot_count; i++)
+        {
+            SnapshotBodyRecord record;
+            memset(&record, 0, sizeof(record));
+            record.body = physics->bodies[i];
+            record.velocity = physics_body_velocity(physics, i);
+            record.angular_velocity = physics_body_angular_velocity(physics, i);
+            record.inv_inertia_local = physics_body_inv_inertia(physics, i);
+            record.inv_mass = physics->inv_mass[i];
+            record.flags = physics->flags[i];
+            if (fwrite(&record, sizeof(record), 1, f) != 1)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool snapshot_save(const char *path, VoxelVolume *vol,
+                   const VoxelObjectWorld *objects, const PhysicsWorld *physics)
+{
+    if (!path || !vol)
+        return false;
+
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+
+    Chunk *scratch = (Chunk *)malloc(sizeof(Chunk));
+    if (!scratch)
+    {
+        fclose(f);
+        return false;
+    }
+
+    SnapshotHeader header;
+    snapshot_fill_layout(&header, vol, objects, physics);
+
+    bool ok = write_at(f, 0, &header, sizeof(header));
+    for (int32_t i = 0; ok && i < vol->total_chunks; i++)
+        ok = write_chunk(f, &header, vol, i, scratch);
+    if (ok)
+        ok = write_object_and_body_sections(f, &header, objects, physics);
+
+    free(scratch);
+    if (fclose(f) != 0)
+        ok = false;
+
+    if (ok)
+        volume_clear_snapshot_dirty(vol);
+    return ok;
+}
+
+int32_t snapshot_save_dirty(const char *path, VoxelVolume *vol,
+                            const VoxelObjectWorld *objects, const PhysicsWorld *physics)
+{
+    if (!path || !vol)
+        return -1;
+
+    FILE *f = fopen(path, "r+b");
+    SnapshotHeader existing;
+    bool reusable = f && fread(&existing, sizeof(existing), 1, f) == 1 &&
+                    snapshot_header_valid(&existing) &&
+                    existing.chunks_x == vol->chunks_x &&
+                    existing.chunks_y == vol->chunks_y &&
+                    existing.chunks_z == vol->chunks_z;
+    if (!reusable)
+    {
+        if (f)
+            fclose(f);
+        return snapshot_save(path, vol, objects, physics) ? vol->total_chunks : -1;
+    }
+
+    Chunk *scratch = (Chunk *)malloc(sizeof(Chunk));
+    if (!scratch)
+    {
+        fclose(f);
+        return -1;
+    }
+
+    /* Chunk section has a fixed layout for a given volume size; only object
+       and body sections move, and they are rewritten in full */
+    SnapshotHeader header;
+    snapshot_fill_layout(&header, vol, objects, physics);
+
+    int32_t dirty[VOLUME_MAX_CHUNKS];
+    int32_t dirty_count = volume_get_snapshot_dirty_chunks(vol, dirty, VOLUME_MAX_CHUNKS);
+
+    bool ok = true;
+    for (int32_t i = 0; ok && i < dirty_count; i++)
+        ok = write_chunk(f, &header, vol, dirty[i], scratch);
+    if (ok)
+        ok = write_object_and_body_sections(f, &header, objects, physics);
+    if (ok)
+        ok = write_at(f, 0, &header, sizeof(header));
+
+    free(scratch);
+    if (fclose(f) != 0)
+        ok = false;
+
+    if (!ok)
+        return -1;
+
+    volume_clear_snapshot_dirty(vol);
+    return dirty_count;
+}
+
+SceneSnapshot *snapshot_open(const char *path)
+{
+    SceneSnapshot *snap = (SceneSnapshot *)calloc(1, sizeof(SceneSnapshot));
+    if (!snap)
+        return NULL;
+
+    if (!platform_file_map(path, &snap->map))
+    {
+        free(snap);
+        return NULL;
+    }
+
+    const SnapshotHeader *header = (const SnapshotHeader *)snap->map.data;
+    if (snap->map.size < sizeof(SnapshotHeader) || !snapshot_header_valid(header) ||
+        header->file_size > snap->map.size)
+    {
+        snapshot_close(snap);
+        return NULL;
+    }
+
+    snap->header = header;
+    return snap;
+}
+
+void snapshot_close(SceneSnapshot *snap)
+{
+    if (!snap)
+        return;
+    platform_file_unmap(&snap->map);
+    free(snap);
+}
+
+VoxelVolume *snapshot_load_volume(SceneSnapshot *snap)
+{
+    if (!snap || !snap->header)
+        return NULL;
+
+    PROFILE_BEGIN(PROFILE_VOLUME_INIT);
+
+    const SnapshotHeader *header = snap->header;
+    Chunk *chunks = (Chunk *)((uint8_t *)snap->map.data + header->chunk_offset);
+    VoxelVolume *vol = volume_create_from_chunks(chunks,
+                                                 header->chunks_x, header->chunks_y, header->chunks_z,
+                                                 header->bounds, header->voxel_size);
+
+    PROFILE_END(PROFILE_VOLUME_INIT);
+    return vol;
+}
+
+int32_t snapshot_load_objects(const SceneSnapshot *snap, VoxelObjectWorld *world)
+{
+    if (!snap || !snap->header || !world || world->object_count != 0)
+        return -1;
+
+    const SnapshotHeader *header = snap->header;
+    const SnapshotObjectRecord *records =
+        (const SnapshotObjectRecord *)((const uint8_t *)snap->map.data + header->object_offset);
+
+    int32_t restored = 0;
+    for (int32_t i = 0; i < header->object_count; i++)
+    {
+        const SnapshotObjectRecord *record = &records[i];
+        if (record->slot < 0 || record->slot >= header->object_slot_count)
+            continue;
+
+        VoxelObject *obj = &world->objects[record->slot];
+        *obj = record->object;
+        voxel_object_set_pose(world, record->slot, record->pose);
+        obj->next_free = -1;
+        obj->next_dirty = -1;
+
+        /* Objects saved mid-recalc go back on the dirty list */
+        bool needs_recalc = obj->shape_dirty;
+        obj->shape_dirty = false;
+        if (record->slot >= world->object_count)
+            world->object_count = record->slot + 1;
+        if (needs_recalc)
+            voxel_object_world_mark_dirty(world, record->slot);
+        restored++;
+    }
+
+    if (header->object_slot_count > world->object_count)
+        world->object_count = header->object_slot_count;
+
+    /* Rebuild free list so the lowest free slot is reused first */
+    for (int32_t i = world->object_count - 1; i >= 0; i--)
+    {
+        if (!world->objects[i].active)
+            voxel_object_world_free_slot(world, i);
+    }
+
+    voxel_object_world_update_raycast_grid(world);
+    if (world->bvh)
+        bvh_build(world->bvh, world);
+
+    return restored;
+}
+
+int32_t snapshot_load_physics(const SceneSnapshot *snap, PhysicsWorld *physics)
+{
+    if (!snap || !snap->header || !physics || physics->body_count != 0)
+        return -1;
+
+    const SnapshotHeader *header = snap->header;
+    const SnapshotBodyRecord *records =
+        (const SnapshotBodyRecord *)((const uint8_t *)snap->map.data + header->body_offset);
+
+    physics->gravity = header->gravity;
+    physics->first_free = -1;
+    physics->max_body_index = header->body_slot_count - 1;
+    physics->body_count = 0;
+    for (int32_t i = 0; i < VOBJ_MAX_OBJECTS; i++)
+        physics->vobj_to_body[i] = -1;
+
+    for (int32_t i = 0; i < header->body_slot_count; i++)
+    {
+        const SnapshotBodyRecord *record = &records[i];
+        physics->bodies[i] = record->body;
+        physics->velocity.x[i] = record->velocity.x;
+        physics->velocity.y[i] = record->velocity.y;
+        physics->velocity.z[i] = record->velocity.z;
+        physics->angular_velocity.x[i] = record->angular_velocity.x;
+        physics->angular_velocity.y[i] = record->angular_velocity.y;
+        physics->angular_velocity.z[i] = record->angular_velocity.z;
+        physics->inv_inertia_local.x[i] = record->inv_inertia_local.x;
+        physics->inv_inertia_local.y[i] = record->inv_inertia_local.y;
+        physics->inv_inertia_local.z[i] = record->inv_inertia_local.z;
+        physics->inv_mass[i] = record->inv_mass;
+        physics->flags[i] = record->flags;
+        physics->active_index[i] = -1;
+    }
+
+    for (int32_t i = header->body_slot_count - 1; i >= 0; i--)
+    {
+        RigidBody *body = &physics->bodies[i];
+        if ((physics->flags[i] & PHYS_FLAG_ACTIVE) && body->vobj_index >= 0 && body->vobj_index < VOBJ_MAX_OBJECTS)
+        {
+            body->next_free = -1;
+            physics->vobj_to_body[body->vobj_index] = (int16_t)i;
+        }
+        else
+        {
+            physics->flags[i] = 0;
+            body->next_free = (int16_t)physics->first_free;
+            physics->first_free = i;
+        }
+    }
+
+    /* Active list in slot order */
+    for (int32_t i = 0; i < header->body_slot_count; i++)
+    {
+        if (!physics->flags[i])
+            continue;
+        physics->active_index[i] = (int16_t)physics->body_count;
+        physics->active_bodies[physics->body_count++] = (int16_t)i;
+    }
+
+    /* The step only refreshes awake bodies; restored sleepers must be entered here */
+    physics_world_rebuild_broadphase(physics);
+    return physics->body_count;
+}
@@ -0,0 +1,123 @@
+#ifndef PATCH_SIM_SNAPSHOT_H
+#define PATCH_SIM_SNAPSHOT_H
+
+#include "engine/core/types.h"
+#include "engine/voxel/volume.h"
+#include "engine/voxel/voxel_object.h"
+#include "engine/physics/rigidbody.h"
+#include "engine/platform/platform.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Scene Snapshot
+ *
+ * Versioned binary image of simulation state:
+ * 1. Terrain chunks (voxels + occupancy), page-aligned for zero-copy adoption
+ * 2. Active voxel objects (verbatim with their pose, shape data included -
+ *    no recalc on load)
+ * 3. Rigid body state, one record per slot gathering the body's cold fields
+ *    and its entries in the PhysicsWorld arrays
+ *
+ * Layout is native-endian and tied to the build's struct layout; the header
+ * records record sizes so mismatched builds are rejected instead of misread.
+ * Chunk records sit at fixed offsets, so incremental saves rewrite only the
+ * chunks modified since the previous save.
+ */
+
+#define SNAPSHOT_MAGIC 0x504E5350u /* "PSNP" */
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_ALIGNMENT 4096
+
+    typedef struct
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t header_size;
+        uint32_t chunk_size;
+
+        uint32_t chunk_record_size;
+        uint32_t object_record_size;
+        uint32_t body_record_size;
+        uint32_t voxel_layout; /* CHUNK_LAYOUT of the stored voxel arrays */
+
+        int32_t chunks_x, chunks_y, chunks_z;
+        int32_t total_chunks;
+        Bounds3D bounds;
+        float voxel_size;
+
+        int32_t object_count;      /* Records in object section */
+        int32_t object_slot_count; /* VoxelObjectWorld::object_count at save */
+        int32_t body_slot_count;   /* max_body_index + 1 at save */
+        Vec3 gravity;
+
+        uint64_t chunk_offset;
+        uint64_t object_offset;
+        uint64_t body_offset;
+        uint64_t file_size;
+    } SnapshotHeader;
+
+    typedef struct
+    {
+        int32_t slot;
+        int32_t _pad;
+        VoxelObject object;
+        VoxelObjectPose pose;
+    } SnapshotObjectRecord;
+
+    typedef struct
+    {
+        RigidBody body;
+        Vec3 velocity;
+        Vec3 angular_velocity;
+        Vec3 inv_inertia_local;
+        float inv_mass;
+        uint8_t flags;
+        uint8_t _pad[3];
+    } SnapshotBodyRecord;
+
+    typedef struct
+    {
+        PlatformFileMap map;
+        const SnapshotHeader *header;
+    } SceneSnapshot;
+
+    /* Full save. Clears the volume's snapshot-dirty tracking on success. */
+    bool snapshot_save(const char *path, VoxelVolume *vol,
+                       const VoxelObjectWorld *objects, const PhysicsWorld *physics);
+
+    /*
+     * Incremental save: rewrites only chunks modified since the last save,
+     * plus the object/body sections. Falls back to a full save when the file
+     * is missing or was written for a different volume layout.
+     * Returns number of chunk records written, or -1 on failure.
+     */
+    int32_t snapshot_save_dirty(const char *path, VoxelVolume *vol,
+                                const VoxelObjectWorld *objects, const PhysicsWorld *physics);
+
+    /* Maps a snapshot file (copy-on-write). Returns NULL on I/O or version mismatch. */
+    SceneSnapshot *snapshot_open(const char *path);
+    void snapshot_close(SceneSnapshot *snap);
+
+    /*
+     * Creates a volume whose chunks point directly into the mapping.
+     * The snapshot must stay open until the volume is destroyed.
+     */
+    VoxelVolume *snapshot_load_volume(SceneSnapshot *snap);
+
+    /* Restores objects into an empty world. Returns objects restored, or -1. */
+    int32_t snapshot_load_objects(const SceneSnapshot *snap, VoxelObjectWorld *world);
+
+    /* Restores body state into an empty physics world (objects loaded first). */
+    int32_t snapshot_load_physics(const SceneSnapshot *snap, PhysicsWorld *physics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PATCH_SIM_SNAPSHOT_H */
@@ -260,13 +260,14 @@ void bvh_build(BVH *bvh, const VoxelObjectWorld *world)
         /* Store AABBs/centroids at WORLD index (i), not BVH-internal index (idx).
            update_node_bounds reads via object_indices[] which yields world indices. */
         float r = obj->radius;
-        bvh->obj_centroids[i] = obj->position;
-        bvh->obj_aabb_min[i][0] = obj->position.x - r;
-        bvh->obj_aabb_min[i][1] = obj->position.y - r;
-        bvh->obj_aabb_min[i][2] = obj->position.z - r;
-        bvh->obj_aabb_max[i][0] = obj->position.x + r;
-        bvh->obj_aabb_max[i][1] = obj->position.y + r;
-        bvh->obj_aabb_max[i][2] = obj->position.z + r;
+        Vec3 position = voxel_object_position(world, i);
+        bvh->obj_centroids[i] = position;
+        bvh->obj_aabb_min[i][0] = position.x - r;
+        bvh->obj_aabb_min[i][1] = position.y - r;
+        bvh->obj_aabb_min[i][2] = position.z - r;
+        bvh->obj_aabb_max[i][0] = position.x + r;
+        bvh->obj_aabb_max[i][1] = position.y + r;
+        bvh->obj_aabb_max[i][2] = position.z + r;
     }
 
     if (bvh->object_count == 0)
@@ -289,13 +290,14 @@ void bvh_refit(BVH *bvh, const VoxelObjectWorld *world)
         float r = obj->radius;
 
         /* Store at WORLD index to match update_node_bounds which reads via object_indices */
-        bvh->obj_centroids[world_idx] = obj->position;
-        bvh->obj_aabb_min[world_idx][0] = obj->position.x - r;
-        bvh->obj_aabb_min[world_idx][1] = obj->position.y - r;
-        bvh->obj_aabb_min[world_idx][2] = obj->position.z - r;
-        bvh->obj_aabb_max[world_idx][0] = obj->position.x + r;
-        bvh->obj_aabb_max[world_idx][1] = obj->position.y + r;
-        bvh->obj_aabb_max[world_idx][2] = obj->position.z + r;
+        Vec3 position = voxel_object_position(world, world_idx);
+        bvh->obj_centroids[world_idx] = position;
+        bvh->obj_aabb_min[world_idx][0] = position.x - r;
+        bvh->obj_aabb_min[world_idx][1] = position.y - r;
+        bvh->obj_aabb_min[world_idx][2] = position.z - r;
+        bvh->obj_aabb_max[world_idx][0] = position.x + r;
+        bvh->obj_aabb_max[world_idx][1] = position.y + r;
+        bvh->obj_aabb_max[world_idx][2] = position.z + r;
     }
 
     for (int32_t i = bvh->node_count - 1; i >= 0; i--)
@@ -1,5 +1,67 @@
 #include "chunk.h"
 #include <math.h>
+#include <string.h>
+
+/* Check if one level0 occupancy region has any solid voxels */
+static bool chunk_region_has_solid(const Chunk *chunk, int32_t region_x, int32_t region_y, int32_t region_z)
+{
+    int32_t base_x = region_x << CHUNK_REGION_BITS;
+    int32_t base_y = region_y << CHUNK_REGION_BITS;
+    int32_t base_z = region_z << CHUNK_REGION_BITS;
+
+#if CHUNK_LAYOUT_REGION_CONTIGUOUS
+    /* Region is one contiguous run: OR it eight bytes at a time */
+    const uint8_t *run = &chunk->voxels[chunk_voxel_index(base_x, base_y, base_z)].material;
+    uint64_t any = 0;
+    for (int32_t i = 0; i < CHUNK_BRICK_VOXELS; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, run + i, sizeof(word));
+        any |= word;
+    }
+    return any != 0;
+#else
+    for (int32_t z = 0; z < CHUNK_REGION_SIZE; z++)
+    {
+        for (int32_t y = 0; y < CHUNK_REGION_SIZE; y++)
+        {
+            for (int32_t x = 0; x < CHUNK_REGION_SIZE; x++)
+            {
+                int32_t idx = chunk_voxel_index(base_x + x, base_y + y, base_z + z);
+                if (chunk->voxels[idx].material != MATERIAL_EMPTY)
+                    return true;
+            }
+        }
+    }
+    return false;
+#endif
+}
+
+/* Count the solid voxels of one level0 region, so a rebuild reads each voxel once */
+static int32_t chunk_region_solid_count(const Chunk *chunk, int32_t region_x, int32_t region_y, int32_t region_z)
+{
+    int32_t base_x = region_x << CHUNK_REGION_BITS;
+    int32_t base_y = region_y << CHUNK_REGION_BITS;
+    int32_t base_z = region_z << CHUNK_REGION_BITS;
+    int32_t count = 0;
+
+#if CHUNK_LAYOUT_REGION_CONTIGUOUS
+    const VoxelCell *run = &chunk->voxels[chunk_voxel_index(base_x, base_y, base_z)];
+    for (int32_t i = 0; i < CHUNK_BRICK_VOXELS; i++)
+        count += run[i].material != MATERIAL_EMPTY;
+#else
+    for (int32_t z = 0; z < CHUNK_REGION_SIZE; z++)
+    {
+        for (int32_t y = 0; y < CHUNK_REGION_SIZE; y++)
+        {
+            const VoxelCell *row = &chunk->voxels[chunk_voxel_index(base_x, base_y + y, base_z + z)];
+            for (int32_t x = 0; x < CHUNK_REGION_SIZE; x++)
+                count += row[x].material != MATERIAL_EMPTY;
+        }
+    }
+#endif
+    return count;
+}
 
 void chunk_rebuild_occupancy(Chunk *chunk)
 {
@@ -13,28 +75,10 @@ void chunk_rebuild_occupancy(Chunk *chunk)
         {
             for (int32_t rx = 0; rx < CHUNK_MIP0_SIZE; rx++)
             {
-                bool region_has_solid = false;
-                int32_t base_x = rx * 8;
-                int32_t base_y = ry * 8;
-                int32_t base_z = rz * 8;
+                int32_t region_solid = chunk_region_solid_count(chunk, rx, ry, rz);
+                chunk->occupancy.solid_count += region_solid;
 
-                for (int32_t z = 0; z < 8 && !region_has_solid; z++)
-                {
-                    for (int32_t y = 0; y < 8 && !region_has_solid; y++)
-                    {
-                        for (int32_t x = 0; x < 8; x++)
-                        {
-                            int32_t idx = chunk_voxel_index(base_x + x, base_y + y, base_z + z);
-                            if (chunk->voxels[idx].material != MATERIAL_EMPTY)
-                            {
-                                region_has_solid = true;
-                                break;
-                            }
-                        }
-                    }
-                }
-
-                if (region_has_solid)
+                if (region_solid > 0)
                 {
                     int32_t bit_idx = rx + ry * CHUNK_MIP0_SIZE + rz * CHUNK_MIP0_SIZE * CHUNK_MIP0_SIZE;
                     chunk->occupancy.level0 |= (1ULL << bit_idx);
@@ -78,15 +122,6 @@ void chunk_rebuild_occupancy(Chunk *chunk)
         }
     }
 
-    /* Count solid voxels */
-    for (int32_t i = 0; i < CHUNK_VOXEL_COUNT; i++)
-    {
-        if (chunk->voxels[i].material != MATERIAL_EMPTY)
-        {
-            chunk->occupancy.solid_count++;
-        }
-    }
-
     chunk->occupancy.has_any = (chunk->occupancy.solid_count > 0) ? 1 : 0;
 }
 
@@ -97,27 +132,8 @@ void chunk_update_occupancy_region(Chunk *chunk, int32_t region_x, int32_t regio
         region_z < 0 || region_z >= CHUNK_MIP0_SIZE)
         return;
 
-    /* Check if this 8x8x8 region has any solid voxels */
-    bool region_has_solid = false;
-    int32_t base_x = region_x * 8;
-    int32_t base_y = region_y * 8;
-    int32_t base_z = region_z * 8;
-
-    for (int32_t z = 0; z < 8 && !region_has_solid; z++)
-    {
-        for (int32_t y = 0; y < 8 && !region_has_solid; y++)
-        {
-            for (int32_t x = 0; x < 8; x++)
-            {
-                int32_t idx = chunk_voxel_index(base_x + x, base_y + y, base_z + z);
-                if (chunk->voxels[idx].material != MATERIAL_EMPTY)
-                {
-                    region_has_solid = true;
-                    break;
-                }
-            }
-        }
-    }
+    /* Check if this level0 region has any solid voxels */
+    bool region_has_solid = chunk_region_has_solid(chunk, region_x, region_y, region_z);
 
     /* Update level0 bit */
     int32_t l0_bit = region_x + region_y * CHUNK_MIP0_SIZE + region_z * CHUNK_MIP0_SIZE * CHUNK_MIP0_SIZE;
@@ -183,13 +199,13 @@ void chunk_update_occupancy_range(Chunk *chunk, int32_t x0, int32_t y0, int32_t
     if (z1 >= CHUNK_SIZE)
         z1 = CHUNK_SIZE - 1;
 
-    /* Find affected 8x8x8 regions */
-    int32_t region_x0 = x0 / 8;
-    int32_t region_y0 = y0 / 8;
-    int32_t region_z0 = z0 / 8;
-    int32_t region_x1 = x1 / 8;
-    int32_t region_y1 = y1 / 8;
-    int32_t region_z1 = z1 / 8;
+    /* Find affected level0 regions */
+    int32_t region_x0 = x0 >> CHUNK_REGION_BITS;
+    int32_t region_y0 = y0 >> CHUNK_REGION_BITS;
+    int32_t region_z0 = z0 >> CHUNK_REGION_BITS;
+    int32_t region_x1 = x1 >> CHUNK_REGION_BITS;
+    int32_t region_y1 = y1 >> CHUNK_REGION_BITS;
+    int32_t region_z1 = z1 >> CHUNK_REGION_BITS;
 
     /* Update each affected region */
     for (int32_t rz = region_z0; rz <= region_z1; rz++)
@@ -10,7 +10,17 @@ extern "C"
 {
 #endif
 
+/*
+ * Chunk edge is a per-build specialization (PATCH_CHUNK_SIZE in CMake):
+ * 4 = 16³ (cheap dirty uploads), 5 = 32³ (default), 6 = 64³ (fewer headers).
+ * Occupancy keeps a 4x4x4 level0 grid, so region size scales with the chunk.
+ */
+#ifndef CHUNK_SIZE_BITS
 #define CHUNK_SIZE_BITS 5
+#endif
+
+static_assert(CHUNK_SIZE_BITS >= 4 && CHUNK_SIZE_BITS <= 6, "CHUNK_SIZE_BITS must be 4, 5 or 6");
+
 #define CHUNK_SIZE (1 << CHUNK_SIZE_BITS)
 #define CHUNK_SIZE_MASK (CHUNK_SIZE - 1)
 #define CHUNK_VOXEL_COUNT (CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE)
@@ -45,8 +55,8 @@ static_assert(sizeof(VoxelCell) == 1, "VoxelCell must be 1 byte");
 /*
  * Hierarchical occupancy for traversal acceleration.
  * Each level is a bitmask where 1 = subtree contains solid voxels.
- * Level 0: 4x4x4 = 64 bits (8 bytes) covering 8x8x8 voxel regions
- * Level 1: 2x2x2 = 8 bits covering 16x16x16 regions
+ * Level 0: 4x4x4 = 64 bits (8 bytes) covering CHUNK_SIZE/4 voxel regions (8³ at 32³)
+ * Level 1: 2x2x2 = 8 bits covering CHUNK_SIZE/2 regions
  * Level 2: 1 bit for entire chunk
  */
 #define CHUNK_MIP0_SIZE 4
@@ -54,12 +64,22 @@ static_assert(sizeof(VoxelCell) == 1, "VoxelCell must be 1 byte");
 #define CHUNK_MIP1_SIZE 2
 #define CHUNK_MIP1_BITS (CHUNK_MIP1_SIZE * CHUNK_MIP1_SIZE * CHUNK_MIP1_SIZE)
 
+#define CHUNK_REGION_BITS (CHUNK_SIZE_BITS - 2)
+#define CHUNK_REGION_SIZE (1 << CHUNK_REGION_BITS)
+
+/* 64³ chunks hold more solid voxels than a uint16_t can count */
+#if CHUNK_SIZE_BITS > 5
+    typedef uint32_t ChunkSolidCount;
+#else
+    typedef uint16_t ChunkSolidCount;
+#endif
+
     typedef struct
     {
-        uint64_t level0;      /* 64 bits: 4x4x4 regions of 8x8x8 voxels */
-        uint8_t level1;       /* 8 bits: 2x2x2 regions of 16x16x16 voxels */
-        uint8_t has_any;      /* 1 if any voxel is solid */
-        uint16_t solid_count; /* Number of solid voxels (for quick empty check) */
+        uint64_t level0;             /* 64 bits: 4x4x4 regions */
+        uint8_t level1;              /* 8 bits: 2x2x2 regions */
+        uint8_t has_any;             /* 1 if any voxel is solid */
+        ChunkSolidCount solid_count; /* Number of solid voxels (for quick empty check) */
     } ChunkOccupancy;
 
     /*
@@ -74,18 +94,110 @@ static_assert(sizeof(VoxelCell) == 1, "VoxelCell must be 1 byte");
         int32_t coord_x, coord_y, coord_z; /* Chunk coordinates in volume */
     } Chunk;
 
-    /* Linear index from local voxel coordinates within chunk */
-    static inline int32_t chunk_voxel_index(int32_t x, int32_t y, int32_t z)
+/*
+ * Voxel storage order inside Chunk::voxels, fixed at compile time.
+ * LINEAR: x + y*CHUNK_SIZE + z*CHUNK_SIZE² (row-major, matches the GPU voxel buffer)
+ * BRICK:  occupancy-region bricks stored contiguously; brick number == level0 bit
+ * MORTON: Z-order curve; every aligned power-of-two cube is contiguous
+ * BRICK and MORTON keep each occupancy region in one 512-byte run, so region
+ * scans and neighbor-heavy kernels (flood fill, sphere fill) stay in cache.
+ * All access goes through chunk_voxel_index(); code that needs row-major
+ * order (GPU upload) converts with chunk_voxel_index_linear().
+ */
+#define CHUNK_LAYOUT_LINEAR 0
+#define CHUNK_LAYOUT_BRICK 1
+#define CHUNK_LAYOUT_MORTON 2
+
+/* LINEAR stays default: tests/test_chunk_layout.c shows no consistent win yet */
+#ifndef CHUNK_LAYOUT
+#define CHUNK_LAYOUT CHUNK_LAYOUT_LINEAR
+#endif
+
+#define CHUNK_BRICK_BITS CHUNK_REGION_BITS
+#define CHUNK_BRICK_SIZE (1 << CHUNK_BRICK_BITS)
+#define CHUNK_BRICK_MASK (CHUNK_BRICK_SIZE - 1)
+#define CHUNK_BRICK_VOXELS (CHUNK_BRICK_SIZE * CHUNK_BRICK_SIZE * CHUNK_BRICK_SIZE)
+#define CHUNK_BRICKS_BITS (CHUNK_SIZE_BITS - CHUNK_BRICK_BITS)
+
+/* Each occupancy level0 region is one contiguous run of CHUNK_BRICK_VOXELS */
+#define CHUNK_LAYOUT_REGION_CONTIGUOUS (CHUNK_LAYOUT != CHUNK_LAYOUT_LINEAR)
+
+    static inline int32_t chunk_voxel_index_linear(int32_t x, int32_t y, int32_t z)
     {
         return x + (y << CHUNK_SIZE_BITS) + (z << (CHUNK_SIZE_BITS * 2));
     }
 
-    /* Extract local coordinates from linear index */
+    static inline int32_t chunk_voxel_index_brick(int32_t x, int32_t y, int32_t z)
+    {
+        int32_t brick = (x >> CHUNK_BRICK_BITS) +
+                        ((y >> CHUNK_BRICK_BITS) << CHUNK_BRICKS_BITS) +
+                        ((z >> CHUNK_BRICK_BITS) << (CHUNK_BRICKS_BITS * 2));
+        int32_t inner = (x & CHUNK_BRICK_MASK) +
+                        ((y & CHUNK_BRICK_MASK) << CHUNK_BRICK_BITS) +
+                        ((z & CHUNK_BRICK_MASK) << (CHUNK_BRICK_BITS * 2));
+        return (brick << (CHUNK_BRICK_BITS * 3)) + inner;
+    }
+
+    /* Spreads the low 10 bits of v so bit i lands on bit 3i */
+    static inline uint32_t chunk_morton_spread(uint32_t v)
+    {
+        v &= 0x3FFu;
+        v = (v | (v << 16)) & 0x030000FFu;
+        v = (v | (v << 8)) & 0x0300F00Fu;
+        v = (v | (v << 4)) & 0x030C30C3u;
+        v = (v | (v << 2)) & 0x09249249u;
+        return v;
+    }
+
+    static inline uint32_t chunk_morton_compact(uint32_t v)
+    {
+        v &= 0x09249249u;
+        v = (v | (v >> 2)) & 0x030C30C3u;
+        v = (v | (v >> 4)) & 0x0300F00Fu;
+        v = (v | (v >> 8)) & 0x030000FFu;
+        v = (v | (v >> 16)) & 0x3FFu;
+        return v;
+    }
+
+    static inline int32_t chunk_voxel_index_morton(int32_t x, int32_t y, int32_t z)
+    {
+        return (int32_t)(chunk_morton_spread((uint32_t)x) |
+                         (chunk_morton_spread((uint32_t)y) << 1) |
+                         (chunk_morton_spread((uint32_t)z) << 2));
+    }
+
+    /* Storage index from local voxel coordinates within chunk */
+    static inline int32_t chunk_voxel_index(int32_t x, int32_t y, int32_t z)
+    {
+#if CHUNK_LAYOUT == CHUNK_LAYOUT_BRICK
+        return chunk_voxel_index_brick(x, y, z);
+#elif CHUNK_LAYOUT == CHUNK_LAYOUT_MORTON
+        return chunk_voxel_index_morton(x, y, z);
+#else
+        return chunk_voxel_index_linear(x, y, z);
+#endif
+    }
+
+    /* Extract local coordinates from storage index */
     static inline void chunk_voxel_coords(int32_t index, int32_t *x, int32_t *y, int32_t *z)
     {
+#if CHUNK_LAYOUT == CHUNK_LAYOUT_BRICK
+        int32_t brick = index >> (CHUNK_BRICK_BITS * 3);
+        int32_t bricks_mask = (1 << CHUNK_BRICKS_BITS) - 1;
+        *x = ((brick & bricks_mask) << CHUNK_BRICK_BITS) + (index & CHUNK_BRICK_MASK);
+        *y = (((brick >> CHUNK_BRICKS_BITS) & bricks_mask) << CHUNK_BRICK_BITS) +
+             ((index >> CHUNK_BRICK_BITS) & CHUNK_BRICK_MASK);
+        *z = ((brick >> (CHUNK_BRICKS_BITS * 2)) << CHUNK_BRICK_BITS) +
+             ((index >> (CHUNK_BRICK_BITS * 2)) & CHUNK_BRICK_MASK);
+#elif CHUNK_LAYOUT == CHUNK_LAYOUT_MORTON
+        *x = (int32_t)chunk_morton_compact((uint32_t)index);
+        *y = (int32_t)chunk_morton_compact((uint32_t)index >> 1);
+        *z = (int32_t)chunk_morton_compact((uint32_t)index >> 2);
+#else
         *x = index & CHUNK_SIZE_MASK;
         *y = (index >> CHUNK_SIZE_BITS) & CHUNK_SIZE_MASK;
         *z = (index >> (CHUNK_SIZE_BITS * 2)) & CHUNK_SIZE_MASK;
+#endif
     }
 
     /* Check if local coordinates are within chunk bounds */
@@ -132,7 +244,8 @@ static_assert(sizeof(VoxelCell) == 1, "VoxelCell must be 1 byte");
             chunk->occupancy.has_any = (chunk->occupancy.solid_count > 0) ? 1 : 0;
 
             /* Update hierarchical occupancy for the affected region */
-            chunk_update_occupancy_region(chunk, x / 8, y / 8, z / 8);
+            chunk_update_occupancy_region(chunk, x >> CHUNK_REGION_BITS, y >> CHUNK_REGION_BITS,
+                                              z >> CHUNK_REGION_BITS);
 
             if (chunk->state == CHUNK_STATE_ACTIVE)
             {
@@ -119,30 +119,31 @@ static inline void set_island_id(ConnectivityWorkBuffer *work, int32_t global_id
 static const int32_t NEIGHBOR_OFFSETS[6][3] = {
     {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}};
 
+/*
+ * Packed layout (low to high): lz, ly, lx with CHUNK_SIZE_BITS each, then the
+ * chunk index within the VOLUME_MAX_CHUNKS grid. Fits 31 bits up to 64³ chunks.
+ */
+#define PACK_LOCAL_BITS (CHUNK_SIZE_BITS * 3)
+static_assert(((int64_t)VOLUME_MAX_CHUNKS << PACK_LOCAL_BITS) <= INT32_MAX, "packed voxel position overflows");
+
 static inline int32_t pack_voxel_pos(int32_t cx, int32_t cy, int32_t cz,
                                      int32_t lx, int32_t ly, int32_t lz)
 {
-    /* Bit layout (32 bits total):
-     * cx: bits 26-31 (6 bits, 0-63)
-     * cy: bits 21-25 (5 bits, 0-31)
-     * cz: bits 15-20 (6 bits, 0-63)
-     * lx: bits 10-14 (5 bits, 0-31)
-     * ly: bits 5-9  (5 bits, 0-31)
-     * lz: bits 0-4  (5 bits, 0-31)
-     */
-    return (cx << 26) | (cy << 21) | (cz << 15) | (lx << 10) | (ly << 5) | lz;
+    int32_t chunk = cx + cy * VOLUME_MAX_CHUNKS_X + cz * VOLUME_MAX_CHUNKS_X * VOLUME_MAX_CHUNKS_Y;
+    return (chunk << PACK_LOCAL_BITS) | (lx << (CHUNK_SIZE_BITS * 2)) | (ly << CHUNK_SIZE_BITS) | lz;
 }
 
 static inline void unpack_voxel_pos(int32_t packed,
                                     int32_t *cx, int32_t *cy, int32_t *cz,
                                     int32_t *lx, int32_t *ly, int32_t *lz)
 {
-    *cx = (packed >> 26) & 0x3F;  /* 6 bits */
-    *cy = (packed >> 21) & 0x1F;  /* 5 bits */
-    *cz = (packed >> 15) & 0x3F;  /* 6 bits */
-    *lx = (packed >> 10) & 0x1F;  /* 5 bits */
-    *ly = (packed >> 5) & 0x1F;   /* 5 bits */
-    *lz = packed & 0x1F;          /* 5 bits */
+    int32_t chunk = packed >> PACK_LOCAL_BITS;
+    *cx = chunk % VOLUME_MAX_CHUNKS_X;
+    *cy = (chunk / VOLUME_MAX_CHUNKS_X) % VOLUME_MAX_CHUNKS_Y;
+    *cz = chunk / (VOLUME_MAX_CHUNKS_X * VOLUME_MAX_CHUNKS_Y);
+    *lx = (packed >> (CHUNK_SIZE_BITS * 2)) & CHUNK_SIZE_MASK;
+    *ly = (packed >> CHUNK_SIZE_BITS) & CHUNK_SIZE_MASK;
+    *lz = packed & CHUNK_SIZE_MASK;
 }
 
 typedef struct {
@@ -382,52 +383,63 @@ void connectivity_analyze_region(const VoxelVolume *vol,
                 if (!chunk || !chunk->occupancy.has_any)
                     continue;
 
-                for (int32_t lz = 0; lz < CHUNK_SIZE; lz++)
+                /* Seeds only come from occupied level0 regions; the fill itself crosses empty ones */
+                for (int32_t region = 0; region < CHUNK_MIP0_BITS; region++)
                 {
-                    for (int32_t ly = 0; ly < CHUNK_SIZE; ly++)
-                    {
-                        for (int32_t lx = 0; lx < CHUNK_SIZE; lx++)
-                        {
-                            int32_t global_idx = global_voxel_index(vol, cx, cy, cz, lx, ly, lz);
+                    if (!((chunk->occupancy.level0 >> region) & 1))
+                        continue;
 
-                            if (is_visited(work, global_idx))
-                                continue;
+                    int32_t rx = (region % CHUNK_MIP0_SIZE) << CHUNK_REGION_BITS;
+                    int32_t ry = ((region / CHUNK_MIP0_SIZE) % CHUNK_MIP0_SIZE) << CHUNK_REGION_BITS;
+                    int32_t rz = (region / (CHUNK_MIP0_SIZE * CHUNK_MIP0_SIZE)) << CHUNK_REGION_BITS;
 
-                            uint8_t mat = chunk_get(chunk, lx, ly, lz);
-                            if (mat == 0)
+                    for (int32_t lz = rz; lz < rz + CHUNK_REGION_SIZE; lz++)
+                    {
+                        for (int32_t ly = ry; ly < ry + CHUNK_REGION_SIZE; ly++)
+                        {
+                            for (int32_t lx = rx; lx < rx + CHUNK_REGION_SIZE; lx++)
                             {
-                                set_visited(work, global_idx);
-                                continue;
+                                int32_t global_idx = global_voxel_index(vol, cx, cy, cz, lx, ly, lz);
+
+                                if (is_visited(work, global_idx))
+                                    continue;
+
+                                uint8_t mat = chunk_get(chunk, lx, ly, lz);
+                                if (mat == 0)
+                                {
+                                    set_visited(work, global_idx);
+                                    continue;
+                                }
+
+                                result->total_voxels_checked++;
+
+                                if (result->island_count >= CONNECTIVITY_MAX_ISLANDS)
+                                    break;
+
+                                IslandInfo *island = &result->islands[result->island_count];
+                                memset(island, 0, sizeof(IslandInfo));
+                                island->island_id = next_island_id;
+                                island->min_corner = vec3_create(1e30f, 1e30f, 1e30f);
+                                island->max_corner = vec3_create(-1e30f, -1e30f, -1e30f);
+                                island->voxel_min_x = INT32_MAX;
+                                island->voxel_min_y = INT32_MAX;
+                                island->voxel_min_z = INT32_MAX;
+                                island->voxel_max_x = INT32_MIN;
+                                island->voxel_max_y = INT32_MIN;
+                                island->voxel_max_z = INT32_MIN;
+
+                                flood_fill_island(vol, work, cx, cy, cz, lx, ly, lz,
+                                                  next_island_id, island, anchor_y, anchor_material,
+                                                  &bounds);
+
+                                if (island->is_floating)
+                                    result->floating_count++;
+                                else
+                                    result->anchored_count++;
+
+                                result->island_count++;
+                                next_island_id++;
                             }
-
-                            result->total_voxels_checked++;
-
-                            if (result->island_count >= CONNECTIVITY_MAX_ISLANDS)
-                                break;
-
-                            IslandInfo *island = &result->islands[result->island_count];
-                            memset(island, 0, sizeof(IslandInfo));
-                            island->island_id = next_island_id;
-                            island->min_corner = vec3_create(1e30f, 1e30f, 1e30f);
-                            island->max_corner = vec3_create(-1e30f, -1e30f, -1e30f);
-                            island->voxel_min_x = INT32_MAX;
-                            island->voxel_min_y = INT32_MAX;
-                            island->voxel_min_z = INT32_MAX;
-                            island->voxel_max_x = INT32_MIN;
-                            island->voxel_max_y = INT32_MIN;
-                            island->voxel_max_z = INT32_MIN;
-
-                            flood_fill_island(vol, work, cx, cy, cz, lx, ly, lz,
-                                              next_island_id, island, anchor_y, anchor_material,
-                                              &bounds);
-
-                            if (island->is_floating)
-                                result->floating_count++;
-                            else
-                                result->anchored_count++;
-
-                            result->island_count++;
-                            next_island_id++;
                         }
                     }
                 }
@@ -490,9 +502,8 @@ void connectivity_analyze_dirty(const VoxelVolume *vol,
         if (chunk_idx < 0 || chunk_idx >= vol->total_chunks)
             continue;
 
-        chunk_cx[chunk_count] = chunk_idx % vol->chunks_x;
-        chunk_cy[chunk_count] = (chunk_idx / vol->chunks_x) % vol->chunks_y;
-        chunk_cz[chunk_count] = chunk_idx / (vol->chunks_x * vol->chunks_y);
+        volume_slot_to_chunk(vol, chunk_idx, &chunk_cx[chunk_count],
+                             &chunk_cy[chunk_count], &chunk_cz[chunk_count]);
         chunk_count++;
     }
 
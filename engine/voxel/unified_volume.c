@@ -131,7 +131,7 @@ void unified_volume_stamp_terrain(UnifiedVolume *vol, const VoxelVolume *terrain
             {
                 for (int32_t x = 0; x < CHUNK_SIZE; x++)
                 {
-                    int32_t local_idx = x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE;
+                    int32_t local_idx = chunk_voxel_index(x, y, z);
                     uint8_t mat = chunk->voxels[local_idx].material;
                     if (mat == 0)
                         continue;
@@ -156,7 +156,7 @@ void unified_volume_stamp_terrain(UnifiedVolume *vol, const VoxelVolume *terrain
     vol->terrain_stamped = true;
 }
 
-void unified_volume_stamp_object(UnifiedVolume *vol, const VoxelObject *obj)
+void unified_volume_stamp_object(UnifiedVolume *vol, const VoxelObject *obj, VoxelObjectPose pose)
 {
     if (!vol || !obj || !obj->active)
         return;
@@ -179,10 +179,10 @@ void unified_volume_stamp_object(UnifiedVolume *vol, const VoxelObject *obj)
                 float local_z = (oz + 0.5f) * obj->voxel_size - half_grid;
 
                 Vec3 local_pos = {local_x, local_y, local_z};
-                Vec3 world_pos = quat_rotate_vec3(obj->orientation, local_pos);
-                world_pos.x += obj->position.x;
-                world_pos.y += obj->position.y;
-                world_pos.z += obj->position.z;
+                Vec3 world_pos = quat_rotate_vec3(pose.orientation, local_pos);
+                world_pos.x += pose.position.x;
+                world_pos.y += pose.position.y;
+                world_pos.z += pose.position.z;
 
                 int32_t vx, vy, vz;
                 unified_volume_world_to_voxel(vol, world_pos, &vx, &vy, &vz);
@@ -249,7 +249,7 @@ void unified_volume_stamp_objects(UnifiedVolume *vol, const VoxelObjectWorld *wo
         const VoxelObject *obj = &world->objects[i];
         if (obj->active)
         {
-            unified_volume_stamp_object(vol, obj);
+            unified_volume_stamp_object(vol, obj, voxel_object_pose(world, i));
         }
     }
 }
@@ -259,14 +259,16 @@ void unified_volume_stamp_particles(UnifiedVolume *vol, const ParticleSystem *pa
     if (!vol || !particles)
         return;
 
-    for (int32_t i = 0; i < particles->count; i++)
+    for (int32_t l = 0; l < PARTICLE_LIST_COUNT; l++)
     {
-        const Particle *p = &particles->particles[i];
-        if (!p->active)
-            continue;
+        const ParticleIndexList *list = &particles->lists[l];
+        for (int32_t k = 0; k < list->count; k++)
+        {
+            int32_t i = list->slots[k];
 
-        /* Particles use a default material (254) since they store color, not material ID */
-        unified_volume_stamp_particle(vol, p->position, p->radius, 254);
+            /* Particles use a default material (254) since they store color, not material ID */
+            unified_volume_stamp_particle(vol, particle_system_position(particles, i), particles->radius[i], 254);
+        }
     }
 }
 
@@ -357,38 +359,39 @@ void unified_volume_stamp_particles_to_shadow(uint8_t *shadow_mip0, uint32_t w,
     if (!shadow_mip0 || !terrain || !particles)
         return;
 
-    for (int32_t i = 0; i < particles->count; i++)
+    for (int32_t l = 0; l < PARTICLE_LIST_COUNT; l++)
     {
-        const Particle *p = &particles->particles[i];
-        if (!p->active)
-            continue;
+        const ParticleIndexList *list = &particles->lists[l];
+        for (int32_t k = 0; k < list->count; k++)
+        {
+            int32_t i = list->slots[k];
 
-        /* Interpolate between previous and current position */
-        float interp_x = p->prev_position.x + interp_alpha * (p->position.x - p->prev_position.x);
-        float interp_y = p->prev_position.y + interp_alpha * (p->position.y - p->prev_position.y);
-        float interp_z = p->prev_position.z + interp_alpha * (p->position.z - p->prev_position.z);
+            /* Interpolate between previous and current position */
+            Vec3 interp = particle_system_interpolated_position(particles, i, interp_alpha);
+            float radius = particles->radius[i];
 
-        float rel_x = interp_x - terrain->bounds.min_x;
-        float rel_y = interp_y - terrain->bounds.min_y;
-        float rel_z = interp_z - terrain->bounds.min_z;
+            float rel_x = interp.x - terrain->bounds.min_x;
+            float rel_y = interp.y - terrain->bounds.min_y;
+            float rel_z = interp.z - terrain->bounds.min_z;
 
-        float radius_voxels = p->radius / terrain->voxel_size;
-        int32_t min_vx = (int32_t)((rel_x - p->radius) / terrain->voxel_size);
-        int32_t min_vy = (int32_t)((rel_y - p->radius) / terrain->voxel_size);
-        int32_t min_vz = (int32_t)((rel_z - p->radius) / terrain->voxel_size);
-        int32_t max_vx = (int32_t)((rel_x + p->radius) / terrain->voxel_size);
-        int32_t max_vy = (int32_t)((rel_y + p->radius) / terrain->voxel_size);
-        int32_t max_vz = (int32_t)((rel_z + p->radius) / terrain->voxel_size);
+            float radius_voxels = radius / terrain->voxel_size;
+            int32_t min_vx = (int32_t)((rel_x - radius) / terrain->voxel_size);
+            int32_t min_vy = (int32_t)((rel_y - radius) / terrain->voxel_size);
+            int32_t min_vz = (int32_t)((rel_z - radius) / terrain->voxel_size);
+            int32_t max_vx = (int32_t)((rel_x + radius) / terrain->voxel_size);
+            int32_t max_vy = (int32_t)((rel_y + radius) / terrain->voxel_size);
+            int32_t max_vz = (int32_t)((rel_z + radius) / terrain->voxel_size);
 
-        (void)radius_voxels;
+            (void)radius_voxels;
 
-        for (int32_t vz = min_vz; vz <= max_vz; vz++)
-        {
-            for (int32_t vy = min_vy; vy <= max_vy; vy++)
+            for (int32_t vz = min_vz; vz <= max_vz; vz++)
             {
-                for (int32_t vx = min_vx; vx <= max_vx; vx++)
+                for (int32_t vy = min_vy; vy <= max_vy; vy++)
                 {
-                    stamp_voxel_to_shadow(shadow_mip0, w, h, d, vx, vy, vz);
+                    for (int32_t vx = min_vx; vx <= max_vx; vx++)
+                    {
+                        stamp_voxel_to_shadow(shadow_mip0, w, h, d, vx, vy, vz);
+                    }
                 }
             }
         }
@@ -402,34 +405,35 @@ void unified_volume_stamp_particles_to_shadow_fullres(uint8_t *shadow_mip0, uint
     if (!shadow_mip0 || !terrain || !particles)
         return;
 
-    for (int32_t i = 0; i < particles->count; i++)
+    for (int32_t l = 0; l < PARTICLE_LIST_COUNT; l++)
     {
-        const Particle *p = &particles->particles[i];
-        if (!p->active)
-            continue;
+        const ParticleIndexList *list = &particles->lists[l];
+        for (int32_t k = 0; k < list->count; k++)
+        {
+            int32_t i = list->slots[k];
 
-        float interp_x = p->prev_position.x + interp_alpha * (p->position.x - p->prev_position.x);
-        float interp_y = p->prev_position.y + interp_alpha * (p->position.y - p->prev_position.y);
-        float interp_z = p->prev_position.z + interp_alpha * (p->position.z - p->prev_position.z);
+            Vec3 interp = particle_system_interpolated_position(particles, i, interp_alpha);
+            float radius = particles->radius[i];
 
-        float rel_x = interp_x - terrain->bounds.min_x;
-        float rel_y = interp_y - terrain->bounds.min_y;
-        float rel_z = interp_z - terrain->bounds.min_z;
+            float rel_x = interp.x - terrain->bounds.min_x;
+            float rel_y = interp.y - terrain->bounds.min_y;
+            float rel_z = interp.z - terrain->bounds.min_z;
 
-        int32_t min_vx = (int32_t)((rel_x - p->radius) / terrain->voxel_size);
-        int32_t min_vy = (int32_t)((rel_y - p->radius) / terrain->voxel_size);
-        int32_t min_vz = (int32_t)((rel_z - p->radius) / terrain->voxel_size);
-        int32_t max_vx = (int32_t)((rel_x + p->radius) / terrain->voxel_size);
-        int32_t max_vy = (int32_t)((rel_y + p->radius) / terrain->voxel_size);
-        int32_t max_vz = (int32_t)((rel_z + p->radius) / terrain->voxel_size);
+            int32_t min_vx = (int32_t)((rel_x - radius) / terrain->voxel_size);
+            int32_t min_vy = (int32_t)((rel_y - radius) / terrain->voxel_size);
+            int32_t min_vz = (int32_t)((rel_z - radius) / terrain->voxel_size);
+            int32_t max_vx = (int32_t)((rel_x + radius) / terrain->voxel_size);
+            int32_t max_vy = (int32_t)((rel_y + radius) / terrain->voxel_size);
+            int32_t max_vz = (int32_t)((rel_z + radius) / terrain->voxel_size);
 
-        for (int32_t vz = min_vz; vz <= max_vz; vz++)
-        {
-            for (int32_t vy = min_vy; vy <= max_vy; vy++)
+            for (int32_t vz = min_vz; vz <= max_vz; vz++)
             {
-                for (int32_t vx = min_vx; vx <= max_vx; vx++)
+                for (int32_t vy = min_vy; vy <= max_vy; vy++)
                 {
-                    stamp_voxel_to_shadow_fullres(shadow_mip0, w, h, d, vx, vy, vz);
+                    for (int32_t vx = min_vx; vx <= max_vx; vx++)
+                    {
+                        stamp_voxel_to_shadow_fullres(shadow_mip0, w, h, d, vx, vy, vz);
+                    }
                 }
             }
         }
@@ -56,7 +56,7 @@ extern "C"
 
     void unified_volume_stamp_terrain(UnifiedVolume *vol, const VoxelVolume *terrain);
 
-    void unified_volume_stamp_object(UnifiedVolume *vol, const VoxelObject *obj);
+    void unified_volume_stamp_object(UnifiedVolume *vol, const VoxelObject *obj, VoxelObjectPose pose);
 
     void unified_volume_stamp_particle(UnifiedVolume *vol, Vec3 pos, float radius, uint8_t material);
 
@@ -50,7 +50,7 @@ static inline int32_t bitmap_find_first_set(const uint64_t *bitmap, int32_t word
 }
 
 static VoxelVolume *volume_create_internal(int32_t chunks_x, int32_t chunks_y, int32_t chunks_z,
-                                           Bounds3D bounds, float voxel_size)
+                                           Bounds3D bounds, float voxel_size, Chunk *external_chunks)
 {
     PROFILE_BEGIN(PROFILE_VOLUME_INIT);
 
@@ -74,7 +74,15 @@ static VoxelVolume *volume_create_internal(int32_t chunks_x, int32_t chunks_y, i
     }
 
     int32_t total = chunks_x * chunks_y * chunks_z;
-    vol->chunks = (Chunk *)calloc((size_t)total, sizeof(Chunk));
+    if (external_chunks)
+    {
+        vol->chunks = external_chunks;
+        vol->chunks_borrowed = true;
+    }
+    else
+    {
+        vol->chunks = (Chunk *)calloc((size_t)total, sizeof(Chunk));
+    }
     if (!vol->chunks)
     {
         free(vol);
@@ -89,19 +97,6 @@ static VoxelVolume *volume_create_internal(int32_t chunks_x, int32_t chunks_y, i
     vol->bounds = bounds;
     vol->voxel_size = voxel_size;
 
-    for (int32_t cz = 0; cz < chunks_z; cz++)
-    {
-        for (int32_t cy = 0; cy < chunks_y; cy++)
-        {
-            for (int32_t cx = 0; cx < chunks_x; cx++)
-            {
-                int32_t idx = cx + cy * chunks_x + cz * chunks_x * chunks_y;
-                chunk_init(&vol->chunks[idx], cx, cy, cz);
-                vol->chunks[idx].state = CHUNK_STATE_ACTIVE;
-            }
-        }
-    }
-
     vol->dirty_count = 0;
     vol->current_frame = 0;
     vol->dirty_ring_head = 0;
@@ -109,18 +104,64 @@ static VoxelVolume *volume_create_internal(int32_t chunks_x, int32_t chunks_y, i
     vol->total_solid_voxels = 0;
     vol->active_chunks = total;
 
+    if (external_chunks)
+    {
+        /* Adopted chunks keep their voxels and occupancy; only derive totals */
+        vol->active_chunks = 0;
+        for (int32_t i = 0; i < total; i++)
+        {
+            vol->total_solid_voxels += vol->chunks[i].occupancy.solid_count;
+            if (vol->chunks[i].occupancy.has_any)
+                vol->active_chunks++;
+        }
+    }
+    else
+    {
+        for (int32_t cz = 0; cz < chunks_z; cz++)
+        {
+            for (int32_t cy = 0; cy < chunks_y; cy++)
+            {
+                for (int32_t cx = 0; cx < chunks_x; cx++)
+                {
+                    int32_t idx = cx + cy * chunks_x + cz * chunks_x * chunks_y;
+                    chunk_init(&vol->chunks[idx], cx, cy, cz);
+                    vol->chunks[idx].state = CHUNK_STATE_ACTIVE;
+                }
+            }
+        }
+    }
+
     vol->shadow_dirty_count = 0;
     vol->shadow_needs_full_rebuild = true;
 
+    /* Nonzero from the start so a fresh reader (all versions 0) sees every chunk */
+    for (int32_t i = 0; i < total; i++)
+        vol->chunk_versions[i] = ++vol->version_counter;
+
     PROFILE_END(PROFILE_VOLUME_INIT);
     return vol;
 }
 
+/* Record a content change for snapshot/streaming persistence and published views */
+static inline void volume_note_modified(VoxelVolume *vol, int32_t chunk_index)
+{
+    bitmap_set(vol->snapshot_dirty_bitmap, chunk_index);
+    bitmap_set(vol->modified_bitmap, chunk_index);
+    vol->chunk_versions[chunk_index] = ++vol->version_counter;
+}
+
+static void volume_bump_all_versions(VoxelVolume *vol)
+{
+    for (int32_t i = 0; i < vol->total_chunks; i++)
+        vol->chunk_versions[i] = ++vol->version_counter;
+}
+
 /* Push a chunk index to the dirty ring buffer (dedup: skip if chunk already dirty) */
 static void volume_push_dirty_ring(VoxelVolume *vol, int32_t chunk_index)
 {
     /* Always set dirty bitmap for O(1) recovery during overflow */
     bitmap_set(vol->dirty_bitmap, chunk_index);
+    volume_note_modified(vol, chunk_index);
 
     int32_t next_head = (vol->dirty_ring_head + 1) % VOLUME_DIRTY_RING_SIZE;
     if (next_head == vol->dirty_ring_tail)
@@ -148,7 +189,7 @@ VoxelVolume *volume_create(int32_t chunks_x, int32_t chunks_y, int32_t chunks_z,
     float vs_z = depth / voxels_z;
     float voxel_size = (vs_x < vs_y) ? (vs_x < vs_z ? vs_x : vs_z) : (vs_y < vs_z ? vs_y : vs_z);
 
-    return volume_create_internal(chunks_x, chunks_y, chunks_z, bounds, voxel_size);
+    return volume_create_internal(chunks_x, chunks_y, chunks_z, bounds, voxel_size, NULL);
 }
 
 VoxelVolume *volume_create_dims(int32_t chunks_x, int32_t chunks_y, int32_t chunks_z,
@@ -163,14 +204,26 @@ VoxelVolume *volume_create_dims(int32_t chunks_x, int32_t chunks_y, int32_t chun
     bounds.max_y = origin.y + chunks_y * chunk_world_size;
     bounds.max_z = origin.z + chunks_z * chunk_world_size;
 
-    return volume_create_internal(chunks_x, chunks_y, chunks_z, bounds, voxel_size);
+    return volume_create_internal(chunks_x, chunks_y, chunks_z, bounds, voxel_size, NULL);
+}
+
+VoxelVolume *volume_create_from_chunks(Chunk *chunks,
+                                       int32_t chunks_x, int32_t chunks_y, int32_t chunks_z,
+                                       Bounds3D bounds, float voxel_size)
+{
+    if (!chunks || chunks_x > VOLUME_MAX_CHUNKS_X || chunks_y > VOLUME_MAX_CHUNKS_Y ||
+        chunks_z > VOLUME_MAX_CHUNKS_Z)
+        return NULL;
+
+    return volume_create_internal(chunks_x, chunks_y, chunks_z, bounds, voxel_size, chunks);
 }
 
 void volume_destroy(VoxelVolume *vol)
 {
     if (vol)
     {
-        free(vol->chunks);
+        if (!vol->chunks_borrowed)
+            free(vol->chunks);
         free(vol);
     }
 }
@@ -183,6 +236,10 @@ void volume_clear(VoxelVolume *vol)
         vol->chunks[i].state = CHUNK_STATE_DIRTY;
     }
     vol->total_solid_voxels = 0;
+    volume_mark_all_snapshot_dirty(vol);
+    volume_bump_all_versions(vol);
+    for (int32_t i = 0; i < vol->total_chunks; i++)
+        bitmap_set(vol->modified_bitmap, i);
 }
 
 uint8_t volume_get_at(const VoxelVolume *vol, Vec3 pos)
@@ -197,7 +254,7 @@ uint8_t volume_get_at(const VoxelVolume *vol, Vec3 pos)
         return MATERIAL_EMPTY;
     }
 
-    int32_t idx = cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+    int32_t idx = volume_chunk_slot(vol, cx, cy, cz);
     return chunk_get(&vol->chunks[idx], lx, ly, lz);
 }
 
@@ -213,7 +270,7 @@ void volume_set_at(VoxelVolume *vol, Vec3 pos, uint8_t material)
         return;
     }
 
-    int32_t idx = cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+    int32_t idx = volume_chunk_slot(vol, cx, cy, cz);
     Chunk *chunk = &vol->chunks[idx];
 
     uint8_t old_mat = chunk_get(chunk, lx, ly, lz);
@@ -297,7 +354,8 @@ int32_t volume_fill_sphere(VoxelVolume *vol, Vec3 center, float radius, uint8_t
                     vol->total_solid_voxels += (new_solid - old_solid);
                     total_modified += modified;
 
-                    int32_t chunk_idx = cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+                    int32_t chunk_idx = volume_chunk_slot(vol, cx, cy, cz);
+                    volume_note_modified(vol, chunk_idx);
 
                     if (vol->edit_batch_active)
                     {
@@ -394,7 +452,8 @@ int32_t volume_fill_box(VoxelVolume *vol, Vec3 min_corner, Vec3 max_corner, uint
                     vol->total_solid_voxels += (new_solid - old_solid);
                     total_modified += modified;
 
-                    int32_t chunk_idx = cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+                    int32_t chunk_idx = volume_chunk_slot(vol, cx, cy, cz);
+                    volume_note_modified(vol, chunk_idx);
 
                     if (vol->edit_batch_active)
                     {
@@ -645,15 +704,31 @@ void volume_edit_set(VoxelVolume *vol, Vec3 pos, uint8_t material)
         return;
     }
 
-    int32_t chunk_idx = cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+    int32_t chunk_idx = volume_chunk_slot(vol, cx, cy, cz);
     Chunk *chunk = &vol->chunks[chunk_idx];
 
     uint8_t old_mat = chunk_get(chunk, lx, ly, lz);
     if (old_mat == material)
         return;
 
-    /* Perform the edit */
-    chunk_set(chunk, lx, ly, lz, material);
+    /* Perform the edit. While the touched list has room every touched chunk is
+     * on it and volume_edit_end rebuilds its occupancy, so the per-voxel region
+     * rescan is skipped; only the solid count is kept current. */
+    if (vol->edit_touched_count < VOLUME_EDIT_BATCH_MAX_CHUNKS)
+    {
+        chunk->voxels[chunk_voxel_index(lx, ly, lz)].material = material;
+        if (material == MATERIAL_EMPTY)
+            chunk->occupancy.solid_count--;
+        else if (old_mat == MATERIAL_EMPTY)
+            chunk->occupancy.solid_count++;
+        chunk->occupancy.has_any = chunk->occupancy.solid_count > 0;
+        if (chunk->state == CHUNK_STATE_ACTIVE)
+            chunk->state = CHUNK_STATE_DIRTY;
+    }
+    else
+    {
+        chunk_set(chunk, lx, ly, lz, material);
+    }
     vol->edit_count++;
 
     /* Track solid voxel delta */
@@ -718,6 +793,7 @@ int32_t volume_edit_end(VoxelVolume *vol)
 
         /* Mark for shadow volume update */
         volume_mark_shadow_dirty(vol, chunk_idx);
+        volume_note_modified(vol, chunk_idx);
 
         /* Ensure GPU upload scheduling for edit batches.
            chunk_set() marks ACTIVE->DIRTY but does not set dirty_frame or enqueue. */
@@ -739,6 +815,136 @@ int32_t volume_edit_end(VoxelVolume *vol)
     return total_edits;
 }
 
+int32_t volume_scroll(VoxelVolume *vol, int32_t dx, int32_t dy, int32_t dz,
+                      int32_t *out_slots, int32_t max_slots)
+{
+    if (!vol || (dx == 0 && dy == 0 && dz == 0))
+        return 0;
+
+    /* Old logical chunk c becomes c - d; slots whose new coordinate falls
+       outside the window wrap around to the incoming face */
+    int32_t recycled = 0;
+    for (int32_t slot = 0; slot < vol->total_chunks; slot++)
+    {
+        int32_t cx, cy, cz;
+        volume_slot_to_chunk(vol, slot, &cx, &cy, &cz);
+        int32_t nx = cx - dx;
+        int32_t ny = cy - dy;
+        int32_t nz = cz - dz;
+        if (nx >= 0 && nx < vol->chunks_x &&
+            ny >= 0 && ny < vol->chunks_y &&
+            nz >= 0 && nz < vol->chunks_z)
+            continue;
+
+        Chunk *chunk = &vol->chunks[slot];
+        vol->total_solid_voxels -= chunk->occupancy.solid_count;
+        if (chunk->occupancy.has_any)
+            vol->active_chunks--;
+        chunk_fill(chunk, MATERIAL_EMPTY);
+        chunk->state = CHUNK_STATE_LOADING;
+        bitmap_clear(vol->modified_bitmap, slot);
+        bitmap_clear(vol->dirty_bitmap, slot);
+
+        if (out_slots && recycled < max_slots)
+            out_slots[recycled] = slot;
+        recycled++;
+    }
+
+    vol->ring_x = ((vol->ring_x + dx) % vol->chunks_x + vol->chunks_x) % vol->chunks_x;
+    vol->ring_y = ((vol->ring_y + dy) % vol->chunks_y + vol->chunks_y) % vol->chunks_y;
+    vol->ring_z = ((vol->ring_z + dz) % vol->chunks_z + vol->chunks_z) % vol->chunks_z;
+    vol->ring_generation++;
+
+    float chunk_world_size = vol->voxel_size * CHUNK_SIZE;
+    vol->bounds.min_x += dx * chunk_world_size;
+    vol->bounds.max_x += dx * chunk_world_size;
+    vol->bounds.min_y += dy * chunk_world_size;
+    vol->bounds.max_y += dy * chunk_world_size;
+    vol->bounds.min_z += dz * chunk_world_size;
+    vol->bounds.max_z += dz * chunk_world_size;
+
+    for (int32_t slot = 0; slot < vol->total_chunks; slot++)
+    {
+        Chunk *chunk = &vol->chunks[slot];
+        volume_slot_to_chunk(vol, slot, &chunk->coord_x, &chunk->coord_y, &chunk->coord_z);
+    }
+
+    /* Every logical position moved: edit history and packed layouts are stale */
+    vol->last_edit_count = 0;
+    vol->shadow_needs_full_rebuild = true;
+    volume_mark_all_snapshot_dirty(vol);
+    volume_bump_all_versions(vol);
+
+    return (recycled < max_slots) ? recycled : max_slots;
+}
+
+void volume_load_chunk(VoxelVolume *vol, int32_t slot, const VoxelCell *voxels)
+{
+    if (!vol || !voxels || slot < 0 || slot >= vol->total_chunks)
+        return;
+
+    Chunk *chunk = &vol->chunks[slot];
+    vol->total_solid_voxels -= chunk->occupancy.solid_count;
+    if (chunk->occupancy.has_any)
+        vol->active_chunks--;
+
+    memcpy(chunk->voxels, voxels, sizeof(chunk->voxels));
+    chunk_rebuild_occupancy(chunk);
+
+    vol->total_solid_voxels += chunk->occupancy.solid_count;
+    if (chunk->occupancy.has_any)
+        vol->active_chunks++;
+
+    chunk->state = CHUNK_STATE_ACTIVE;
+    volume_mark_chunk_dirty(vol, slot);
+    volume_mark_shadow_dirty(vol, slot);
+
+    /* Freshly loaded content matches its backing store */
+    bitmap_clear(vol->modified_bitmap, slot);
+}
+
+int32_t volume_get_snapshot_dirty_chunks(const VoxelVolume *vol, int32_t *out_indices, int32_t max_count)
+{
+    if (!vol || !out_indices)
+        return 0;
+
+    int32_t count = 0;
+    int32_t bitmap_words = (vol->total_chunks + 63) >> 6;
+    for (int32_t w = 0; w < bitmap_words && count < max_count; w++)
+    {
+        uint64_t bits = vol->snapshot_dirty_bitmap[w];
+        while (bits != 0 && count < max_count)
+        {
+#ifdef _MSC_VER
+            unsigned long bit_index;
+            _BitScanForward64(&bit_index, bits);
+            int32_t chunk_idx = w * 64 + (int32_t)bit_index;
+#else
+            int32_t chunk_idx = w * 64 + __builtin_ctzll(bits);
+#endif
+            if (chunk_idx >= vol->total_chunks)
+                break;
+            out_indices[count++] = chunk_idx;
+            bits &= bits - 1;
+        }
+    }
+    return count;
+}
+
+void volume_clear_snapshot_dirty(VoxelVolume *vol)
+{
+    if (vol)
+        bitmap_clear_all(vol->snapshot_dirty_bitmap, VOLUME_CHUNK_BITMAP_SIZE);
+}
+
+void volume_mark_all_snapshot_dirty(VoxelVolume *vol)
+{
+    if (!vol)
+        return;
+    for (int32_t i = 0; i < vol->total_chunks; i++)
+        bitmap_set(vol->snapshot_dirty_bitmap, i);
+}
+
 /* volume_ray_hits_any_occupancy moved to volume_raycast.c */
 
 /* Shadow volume functions moved to volume_shadow.c */
@@ -11,20 +11,27 @@ extern "C"
 {
 #endif
 
-#define VOLUME_MAX_CHUNKS_X 16
-#define VOLUME_MAX_CHUNKS_Y 8
-#define VOLUME_MAX_CHUNKS_Z 16
+/* Volume limits are fixed in voxels; chunk limits follow CHUNK_SIZE */
+#define VOLUME_MAX_VOXELS_X 512
+#define VOLUME_MAX_VOXELS_Y 256
+#define VOLUME_MAX_VOXELS_Z 512
+#define VOLUME_MAX_CHUNKS_X (VOLUME_MAX_VOXELS_X / CHUNK_SIZE)
+#define VOLUME_MAX_CHUNKS_Y (VOLUME_MAX_VOXELS_Y / CHUNK_SIZE)
+#define VOLUME_MAX_CHUNKS_Z (VOLUME_MAX_VOXELS_Z / CHUNK_SIZE)
 #define VOLUME_MAX_CHUNKS (VOLUME_MAX_CHUNKS_X * VOLUME_MAX_CHUNKS_Y * VOLUME_MAX_CHUNKS_Z)
 
-#define VOLUME_MAX_DIRTY_PER_FRAME 16
+/* Chunk-count budgets are tuned for 32³; smaller chunks get proportionally more */
+#define VOLUME_CHUNK_BUDGET_SCALE ((32 * 32 * 32) / CHUNK_VOXEL_COUNT > 1 ? (32 * 32 * 32) / CHUNK_VOXEL_COUNT : 1)
+
+#define VOLUME_MAX_DIRTY_PER_FRAME (16 * VOLUME_CHUNK_BUDGET_SCALE)
 #define VOLUME_MAX_EDITS_PER_TICK 4096
-#define VOLUME_MAX_UPLOADS_PER_FRAME 16
+#define VOLUME_MAX_UPLOADS_PER_FRAME (16 * VOLUME_CHUNK_BUDGET_SCALE)
 #define VOLUME_MAX_FRAGMENTS_PER_TICK 32
 
-#define VOLUME_DIRTY_RING_SIZE 64
-#define VOLUME_EDIT_BATCH_MAX_CHUNKS 64
+#define VOLUME_DIRTY_RING_SIZE (64 * VOLUME_CHUNK_BUDGET_SCALE)
+#define VOLUME_EDIT_BATCH_MAX_CHUNKS (64 * VOLUME_CHUNK_BUDGET_SCALE)
 #define VOLUME_CHUNK_BITMAP_SIZE ((VOLUME_MAX_CHUNKS + 63) / 64)
-#define VOLUME_SHADOW_DIRTY_MAX 256
+#define VOLUME_SHADOW_DIRTY_MAX (256 * VOLUME_CHUNK_BUDGET_SCALE)
 
     typedef struct
     {
@@ -71,6 +78,28 @@ extern "C"
         int32_t shadow_dirty_chunks[VOLUME_SHADOW_DIRTY_MAX];
         int32_t shadow_dirty_count;
         bool shadow_needs_full_rebuild;
+
+        /* Chunks modified since the last snapshot save (incremental checkpoints) */
+        uint64_t snapshot_dirty_bitmap[VOLUME_CHUNK_BITMAP_SIZE];
+
+        /* Chunk storage is owned externally (e.g. a mapped snapshot), not freed on destroy */
+        bool chunks_borrowed;
+
+        /*
+         * Toroidal addressing for streamed windows: storage slot of logical
+         * chunk (0,0,0). Zero for static volumes, where slot == logical index.
+         * Chunk indices stored in dirty queues/bitmaps are always storage slots.
+         */
+        int32_t ring_x, ring_y, ring_z;
+        uint32_t ring_generation; /* Bumped on every scroll (GPU layout resync) */
+
+        /* Chunks modified since they were loaded (persist on eviction) */
+        uint64_t modified_bitmap[VOLUME_CHUNK_BITMAP_SIZE];
+
+        /* Volume-unique content version per slot, bumped on every modification
+           (copy-on-write publishing in volume_version.h) */
+        uint32_t chunk_versions[VOLUME_MAX_CHUNKS];
+        uint32_t version_counter;
     } VoxelVolume;
 
     VoxelVolume *volume_create(int32_t chunks_x, int32_t chunks_y, int32_t chunks_z,
@@ -79,6 +108,12 @@ extern "C"
     VoxelVolume *volume_create_dims(int32_t chunks_x, int32_t chunks_y, int32_t chunks_z,
                                     Vec3 origin, float voxel_size);
 
+    /* Adopts pre-built chunk storage (zero-copy). Chunks must hold valid occupancy.
+       The caller keeps ownership of the storage and must outlive the volume. */
+    VoxelVolume *volume_create_from_chunks(Chunk *chunks,
+                                           int32_t chunks_x, int32_t chunks_y, int32_t chunks_z,
+                                           Bounds3D bounds, float voxel_size);
+
     void volume_destroy(VoxelVolume *vol);
 
     void volume_clear(VoxelVolume *vol);
@@ -182,6 +217,41 @@ extern "C"
         return volume_voxel_to_world(vol, cx, cy, cz, lx, ly, lz);
     }
 
+    /* Storage slot for in-range logical chunk coordinates (no bounds check) */
+    static inline int32_t volume_chunk_slot(const VoxelVolume *vol, int32_t cx, int32_t cy, int32_t cz)
+    {
+        int32_t px = cx + vol->ring_x;
+        int32_t py = cy + vol->ring_y;
+        int32_t pz = cz + vol->ring_z;
+        if (px >= vol->chunks_x)
+            px -= vol->chunks_x;
+        if (py >= vol->chunks_y)
+            py -= vol->chunks_y;
+        if (pz >= vol->chunks_z)
+            pz -= vol->chunks_z;
+        return px + py * vol->chunks_x + pz * vol->chunks_x * vol->chunks_y;
+    }
+
+    /* Logical chunk coordinates of a storage slot (inverse of volume_chunk_slot) */
+    static inline void volume_slot_to_chunk(const VoxelVolume *vol, int32_t slot,
+                                            int32_t *cx, int32_t *cy, int32_t *cz)
+    {
+        int32_t x = slot % vol->chunks_x - vol->ring_x;
+        int32_t y = (slot / vol->chunks_x) % vol->chunks_y - vol->ring_y;
+        int32_t z = slot / (vol->chunks_x * vol->chunks_y) - vol->ring_z;
+        *cx = (x < 0) ? x + vol->chunks_x : x;
+        *cy = (y < 0) ? y + vol->chunks_y : y;
+        *cz = (z < 0) ? z + vol->chunks_z : z;
+    }
+
+    /* Row-major logical index of a storage slot (GPU and snapshot layout) */
+    static inline int32_t volume_slot_to_logical(const VoxelVolume *vol, int32_t slot)
+    {
+        int32_t cx, cy, cz;
+        volume_slot_to_chunk(vol, slot, &cx, &cy, &cz);
+        return cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+    }
+
     static inline Chunk *volume_get_chunk(VoxelVolume *vol, int32_t cx, int32_t cy, int32_t cz)
     {
         if (cx < 0 || cx >= vol->chunks_x ||
@@ -190,8 +260,7 @@ extern "C"
         {
             return NULL;
         }
-        int32_t idx = cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
-        return &vol->chunks[idx];
+        return &vol->chunks[volume_chunk_slot(vol, cx, cy, cz)];
     }
 
     static inline int32_t volume_chunk_index(const VoxelVolume *vol, int32_t cx, int32_t cy, int32_t cz)
@@ -202,7 +271,7 @@ extern "C"
         {
             return -1;
         }
-        return cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+        return volume_chunk_slot(vol, cx, cy, cz);
     }
 
     uint8_t volume_get_at(const VoxelVolume *vol, Vec3 pos);
@@ -225,6 +294,33 @@ extern "C"
 
     bool volume_ray_hits_any_occupancy(const VoxelVolume *vol, Vec3 origin, Vec3 dir, float max_dist);
 
+    /* Snapshot tracking: chunks modified since the last save */
+    int32_t volume_get_snapshot_dirty_chunks(const VoxelVolume *vol, int32_t *out_indices, int32_t max_count);
+    void volume_clear_snapshot_dirty(VoxelVolume *vol);
+    void volume_mark_all_snapshot_dirty(VoxelVolume *vol);
+
+    /*
+     * Window scrolling (toroidal). Moves bounds by whole chunks and rotates the
+     * ring so no voxel data is copied. Slots that wrap around are cleared and
+     * left in CHUNK_STATE_LOADING; their indices are written to out_slots.
+     * Callers persist outgoing chunks beforehand. Returns recycled slot count.
+     */
+    int32_t volume_scroll(VoxelVolume *vol, int32_t dx, int32_t dy, int32_t dz,
+                          int32_t *out_slots, int32_t max_slots);
+
+    /* Installs streamed voxel data into a slot and schedules GPU/shadow upload */
+    void volume_load_chunk(VoxelVolume *vol, int32_t slot, const VoxelCell *voxels);
+
+    static inline bool volume_chunk_modified(const VoxelVolume *vol, int32_t slot)
+    {
+        return (vol->modified_bitmap[slot >> 6] & (1ULL << (slot & 63))) != 0;
+    }
+
+    static inline void volume_mark_chunk_persisted(VoxelVolume *vol, int32_t slot)
+    {
+        vol->modified_bitmap[slot >> 6] &= ~(1ULL << (slot & 63));
+    }
+
     void volume_pack_shadow_volume(const VoxelVolume *vol, uint8_t *out_packed,
                                    uint32_t *out_width, uint32_t *out_height, uint32_t *out_depth);
 
@@ -238,6 +334,9 @@ extern "C"
     void volume_pack_shadow_chunk(const VoxelVolume *vol, int32_t chunk_idx,
                                   uint8_t *mip0, uint32_t w0, uint32_t h0, uint32_t d0);
 
+    /* Same packing from a standalone chunk (e.g. a published VolumeView page) */
+    void volume_pack_shadow_from_chunk(const Chunk *chunk, uint8_t *mip0, uint32_t w0, uint32_t h0);
+
     void volume_generate_shadow_mips_for_chunk(int32_t chunk_idx,
                                                int32_t chunks_x, int32_t chunks_y, int32_t chunks_z,
                                                const uint8_t *mip0, uint32_t w0, uint32_t h0, uint32_t d0,
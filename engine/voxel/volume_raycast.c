@@ -76,7 +76,7 @@ float volume_raycast(const VoxelVolume *vol, Vec3 origin, Vec3 dir, float max_di
             int32_t ly = vy % CHUNK_SIZE;
             int32_t lz = vz % CHUNK_SIZE;
 
-            int32_t chunk_idx = cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+            int32_t chunk_idx = volume_chunk_slot(vol, cx, cy, cz);
 
             /* Cache chunk occupancy when entering new chunk */
             if (chunk_idx != last_chunk_idx)
@@ -94,10 +94,10 @@ float volume_raycast(const VoxelVolume *vol, Vec3 origin, Vec3 dir, float max_di
                 goto advance_voxel;
             }
 
-            /* Check 8x8x8 region occupancy (level0) */
-            int32_t rx = lx / 8;
-            int32_t ry = ly / 8;
-            int32_t rz = lz / 8;
+            /* Check region occupancy (level0) */
+            int32_t rx = lx >> CHUNK_REGION_BITS;
+            int32_t ry = ly >> CHUNK_REGION_BITS;
+            int32_t rz = lz >> CHUNK_REGION_BITS;
             int32_t region_bit = rx + ry * CHUNK_MIP0_SIZE + rz * CHUNK_MIP0_SIZE * CHUNK_MIP0_SIZE;
 
             if (!((chunk_level0 >> region_bit) & 1))
@@ -219,7 +219,7 @@ bool volume_ray_hits_any_occupancy(const VoxelVolume *vol, Vec3 origin, Vec3 dir
             cy >= 0 && cy < vol->chunks_y &&
             cz >= 0 && cz < vol->chunks_z)
         {
-            int32_t chunk_idx = cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+            int32_t chunk_idx = volume_chunk_slot(vol, cx, cy, cz);
             if (vol->chunks[chunk_idx].occupancy.has_any)
             {
                 return true;
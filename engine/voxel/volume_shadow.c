@@ -28,7 +28,7 @@ void volume_pack_shadow_volume(const VoxelVolume *vol, uint8_t *out_packed,
         {
             for (int32_t cx = 0; cx < vol->chunks_x; cx++)
             {
-                int32_t chunk_idx = cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+                int32_t chunk_idx = volume_chunk_slot(vol, cx, cy, cz);
                 const Chunk *chunk = &vol->chunks[chunk_idx];
 
                 if (!chunk->occupancy.has_any)
@@ -212,7 +212,14 @@ void volume_pack_shadow_chunk(const VoxelVolume *vol, int32_t chunk_idx,
     if (!vol || !mip0 || chunk_idx < 0 || chunk_idx >= vol->total_chunks)
         return;
 
-    const Chunk *chunk = &vol->chunks[chunk_idx];
+    volume_pack_shadow_from_chunk(&vol->chunks[chunk_idx], mip0, w0, h0);
+}
+
+void volume_pack_shadow_from_chunk(const Chunk *chunk, uint8_t *mip0, uint32_t w0, uint32_t h0)
+{
+    if (!chunk || !mip0)
+        return;
+
     int32_t cx = chunk->coord_x;
     int32_t cy = chunk->coord_y;
     int32_t cz = chunk->coord_z;
@@ -402,7 +409,7 @@ void volume_restore_shadow_region(const VoxelVolume *vol, uint8_t *mip0,
                 int32_t cx = vx / CHUNK_SIZE;
                 int32_t lx = vx % CHUNK_SIZE;
 
-                int32_t chunk_idx = cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y;
+                int32_t chunk_idx = volume_chunk_slot(vol, cx, cy, cz);
                 const Chunk *chunk = &vol->chunks[chunk_idx];
                 if (!chunk->occupancy.has_any)
                     continue;
@@ -0,0 +1,795 @@
+#include "volume_stream.h"
+#include "engine/core/math.h"
+#include <threads.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define VOLUME_STREAM_FILE_MAGIC 0x4B4E4843u /* "CHNK" */
+#define VOLUME_STREAM_FILE_VERSION 2
+#define VOLUME_STREAM_JOB_QUEUE_SIZE (VOLUME_STREAM_MAX_IN_FLIGHT + VOLUME_STREAM_MAX_PENDING_SAVES)
+
+typedef enum
+{
+    STREAM_SLOT_RESIDENT,
+    STREAM_SLOT_WANT,     /* Waiting for a load request */
+    STREAM_SLOT_REQUESTED /* Load queued or running */
+} StreamSlotState;
+
+typedef enum
+{
+    STREAM_JOB_LOAD,
+    STREAM_JOB_SAVE
+} StreamJobType;
+
+typedef struct
+{
+    StreamJobType type;
+    int32_t slot;       /* LOAD: destination slot */
+    uint32_t ticket;    /* LOAD: slot ticket at request time */
+    int32_t save_index; /* SAVE: pending save entry */
+    int32_t gcx, gcy, gcz;
+} StreamJob;
+
+typedef struct
+{
+    int32_t slot;
+    uint32_t ticket;
+    VoxelCell *voxels; /* NULL if allocation failed (slot is re-requested) */
+    bool from_disk;
+} StreamResult;
+
+/* Evicted chunk copy; owned by main thread, read by the writing worker */
+typedef struct
+{
+    int32_t gcx, gcy, gcz;
+    VoxelCell *voxels;
+    bool in_use;
+    bool done;   /* Set by worker under lock once the write finished */
+    bool failed; /* Write failed; the copy is kept and the save retried */
+} StreamSave;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    int32_t gcx, gcy, gcz;
+    int32_t voxel_count;
+    uint32_t layout; /* CHUNK_LAYOUT of the stored voxels */
+} StreamChunkFileHeader;
+
+struct VolumeStream
+{
+    VoxelVolume *volume;
+    VolumeStreamDesc desc;
+    char persist_dir[VOLUME_STREAM_PATH_MAX];
+    bool persist;
+
+    /* Global chunk coordinates of logical chunk (0,0,0) */
+    int32_t origin_x, origin_y, origin_z;
+
+    uint8_t slot_state[VOLUME_MAX_CHUNKS];
+    uint32_t slot_ticket[VOLUME_MAX_CHUNKS]; /* Bumped when a slot is recycled */
+
+    int32_t want[VOLUME_MAX_CHUNKS]; /* FIFO of slots in STREAM_SLOT_WANT */
+    int32_t want_head;
+    int32_t want_count;
+
+    /* Scroll in progress: one unit step, outgoing plane evicted across frames */
+    bool scroll_pending;
+    int32_t scroll_dx, scroll_dy, scroll_dz;
+    int32_t evict_cursor;
+
+    StreamSave saves[VOLUME_STREAM_MAX_PENDING_SAVES];
+    int32_t in_flight; /* Loads requested and not yet consumed */
+
+    /* Shared with workers (guarded by lock) */
+    mtx_t lock;
+    cnd_t job_ready;
+    StreamJob jobs[VOLUME_STREAM_JOB_QUEUE_SIZE];
+    int32_t job_head;
+    int32_t job_count;
+    StreamResult results[VOLUME_STREAM_MAX_IN_FLIGHT];
+    int32_t result_head;
+    int32_t result_count;
+    bool shutdown;
+
+    thrd_t workers[VOLUME_STREAM_MAX_WORKERS];
+    int32_t worker_count;
+
+    VolumeStreamStats stats;
+};
+
+static void stream_chunk_path(const VolumeStream *stream, int32_t gcx, int32_t gcy, int32_t gcz,
+                              char *out_path, size_t out_size)
+{
+    snprintf(out_path, out_size, "%s/chunk_%d_%d_%d.bin", stream->persist_dir, gcx, gcy, gcz);
+}
+
+static bool stream_read_chunk(const VolumeStream *stream, int32_t gcx, int32_t gcy, int32_t gcz,
+                              VoxelCell *out_voxels)
+{
+    char path[VOLUME_STREAM_PATH_MAX + 64];
+    stream_chunk_path(stream, gcx, gcy, gcz, path, sizeof(path));
+
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+
+    StreamChunkFileHeader header;
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+              header.magic == VOLUME_STREAM_FILE_MAGIC &&
+              header.version == VOLUME_STREAM_FILE_VERSION &&
+              header.gcx == gcx && header.gcy == gcy && header.gcz == gcz &&
+              header.voxel_count == CHUNK_VOXEL_COUNT &&
+              header.layout == CHUNK_LAYOUT &&
+              fread(out_voxels, sizeof(VoxelCell), CHUNK_VOXEL_COUNT, f) == CHUNK_VOXEL_COUNT;
+    fclose(f);
+    return ok;
+}
+
+static bool stream_write_chunk(const VolumeStream *stream, int32_t gcx, int32_t gcy, int32_t gcz,
+                               const VoxelCell *voxels)
+{
+    char path[VOLUME_STREAM_PATH_MAX + 64];
+    stream_chunk_path(stream, gcx, gcy, gcz, path, sizeof(path));
+
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+
+    StreamChunkFileHeader header = {VOLUME_STREAM_FILE_MAGIC, VOLUME_STREAM_FILE_VERSION,
+                                    gcx, gcy, gcz, CHUNK_VOXEL_COUNT, CHUNK_LAYOUT};
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+              fwrite(voxels, sizeof(VoxelCell), CHUNK_VOXEL_COUNT, f) == CHUNK_VOXEL_COUNT;
+    if (fclose(f) != 0)
+        ok = false;
+    return ok;
+}
+
+static void stream_slot_global(const VolumeStream *stream, int32_t slot,
+                               int32_t *gcx, int32_t *gcy, int32_t *gcz)
+{
+    int32_t cx, cy, cz;
+    volume_slot_to_chunk(stream->volume, slot, &cx, &cy, &cz);
+    *gcx = stream->origin_x + cx;
+    *gcy = stream->origin_y + cy;
+    *gcz = stream->origin_z + cz;
+}
+
+static void stream_push_want(VolumeStream *stream, int32_t slot)
+{
+    if (stream->slot_state[slot] == STREAM_SLOT_WANT)
+        return;
+    stream->slot_state[slot] = STREAM_SLOT_WANT;
+    int32_t tail = (stream->want_head + stream->want_count) % VOLUME_MAX_CHUNKS;
+    stream->want[tail] = slot;
+    stream->want_count++;
+}
+
+/* Caller holds lock */
+static void stream_push_job(VolumeStream *stream, const StreamJob *job)
+{
+    int32_t tail = (stream->job_head + stream->job_count) % VOLUME_STREAM_JOB_QUEUE_SIZE;
+    stream->jobs[tail] = *job;
+    stream->job_count++;
+}
+
+static void stream_execute_job(VolumeStream *stream, const StreamJob *job)
+{
+    if (job->type == STREAM_JOB_SAVE)
+    {
+        StreamSave *save = &stream->saves[job->save_index];
+        bool written = stream_write_chunk(stream, job->gcx, job->gcy, job->gcz, save->voxels);
+
+        mtx_lock(&stream->lock);
+        save->done = true;
+        save->failed = !written;
+        mtx_unlock(&stream->lock);
+        return;
+    }
+
+    StreamResult result;
+    result.slot = job->slot;
+    result.ticket = job->ticket;
+    result.from_disk = false;
+    result.voxels = (VoxelCell *)calloc(CHUNK_VOXEL_COUNT, sizeof(VoxelCell));
+    if (result.voxels)
+    {
+        if (stream->persist)
+            result.from_disk = stream_read_chunk(stream, job->gcx, job->gcy, job->gcz, result.voxels);
+        if (!result.from_disk && stream->desc.generate)
+            stream->desc.generate(stream->desc.user, job->gcx, job->gcy, job->gcz, result.voxels);
+    }
+
+    mtx_lock(&stream->lock);
+    int32_t tail = (stream->result_head + stream->result_count) % VOLUME_STREAM_MAX_IN_FLIGHT;
+    stream->results[tail] = result;
+    stream->result_count++;
+    mtx_unlock(&stream->lock);
+}
+
+static int stream_worker_main(void *arg)
+{
+    VolumeStream *stream = (VolumeStream *)arg;
+
+    mtx_lock(&stream->lock);
+    for (;;)
+    {
+        while (stream->job_count == 0 && !stream->shutdown)
+            cnd_wait(&stream->job_ready, &stream->lock);
+        if (stream->job_count == 0)
+            break;
+
+        StreamJob job = stream->jobs[stream->job_head];
+        stream->job_head = (stream->job_head + 1) % VOLUME_STREAM_JOB_QUEUE_SIZE;
+        stream->job_count--;
+        mtx_unlock(&stream->lock);
+
+        stream_execute_job(stream, &job);
+
+        mtx_lock(&stream->lock);
+    }
+    mtx_unlock(&stream->lock);
+    return 0;
+}
+
+/* Inline mode: drain the queue on the calling thread */
+static void stream_run_inline(VolumeStream *stream)
+{
+    for (;;)
+    {
+        mtx_lock(&stream->lock);
+        if (stream->job_count == 0)
+        {
+            mtx_unlock(&stream->lock);
+            return;
+        }
+        StreamJob job = stream->jobs[stream->job_head];
+        stream->job_head = (stream->job_head + 1) % VOLUME_STREAM_JOB_QUEUE_SIZE;
+        stream->job_count--;
+        mtx_unlock(&stream->lock);
+
+        stream_execute_job(stream, &job);
+    }
+}
+
+static int32_t stream_find_save(const VolumeStream *stream, int32_t gcx, int32_t gcy, int32_t gcz)
+{
+    for (int32_t i = 0; i < VOLUME_STREAM_MAX_PENDING_SAVES; i++)
+    {
+        const StreamSave *save = &stream->saves[i];
+        if (save->in_use && save->gcx == gcx && save->gcy == gcy && save->gcz == gcz)
+            return i;
+    }
+    return -1;
+}
+
+/*
+ * Releases written saves. Failed writes keep their copy (re-entering loads
+ * are still served from it) and are requeued, one attempt per update.
+ */
+static void stream_reap_saves(VolumeStream *stream)
+{
+    mtx_lock(&stream->lock);
+    for (int32_t i = 0; i < VOLUME_STREAM_MAX_PENDING_SAVES; i++)
+    {
+        StreamSave *save = &stream->saves[i];
+        if (save->in_use && save->done && save->failed)
+        {
+            save->done = false;
+            save->failed = false;
+            stream->stats.save_failures++;
+            if (!stream->shutdown)
+            {
+                StreamJob job = {STREAM_JOB_SAVE, -1, 0, i, save->gcx, save->gcy, save->gcz};
+                stream_push_job(stream, &job);
+                cnd_signal(&stream->job_ready);
+            }
+        }
+        else if (save->in_use && save->done)
+        {
+            free(save->voxels);
+            save->voxels = NULL;
+            save->in_use = false;
+            save->done = false;
+            stream->stats.chunks_persisted++;
+        }
+    }
+    mtx_unlock(&stream->lock);
+}
+
+/*
+ * Copies a resident chunk aside and queues it for writing. Fails (retry next
+ * frame) when the save table is full or an older copy of the same chunk is
+ * still being written, which keeps per-chunk writes ordered.
+ */
+static bool stream_queue_save(VolumeStream *stream, int32_t slot)
+{
+    int32_t gcx, gcy, gcz;
+    stream_slot_global(stream, slot, &gcx, &gcy, &gcz);
+    if (stream_find_save(stream, gcx, gcy, gcz) >= 0)
+        return false;
+
+    int32_t index = -1;
+    for (int32_t i = 0; i < VOLUME_STREAM_MAX_PENDING_SAVES; i++)
+    {
+        if (!stream->saves[i].in_use)
+        {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0)
+        return false;
+
+    VoxelCell *copy = (VoxelCell *)malloc(sizeof(stream->volume->chunks[slot].voxels));
+    if (!copy)
+        return false;
+    memcpy(copy, stream->volume->chunks[slot].voxels, sizeof(stream->volume->chunks[slot].voxels));
+
+    StreamSave *save = &stream->saves[index];
+    save->gcx = gcx;
+    save->gcy = gcy;
+    save->gcz = gcz;
+    save->voxels = copy;
+    save->done = false;
+    save->failed = false;
+    save->in_use = true;
+
+    StreamJob job = {STREAM_JOB_SAVE, -1, 0, index, gcx, gcy, gcz};
+    mtx_lock(&stream->lock);
+    stream_push_job(stream, &job);
+    cnd_signal(&stream->job_ready);
+    mtx_unlock(&stream->lock);
+
+    volume_mark_chunk_persisted(stream->volume, slot);
+    return true;
+}
+
+static int32_t stream_focus_chunk(float coord, float origin, float chunk_world_size)
+{
+    return (int32_t)floorf((coord - origin) / chunk_world_size);
+}
+
+static void stream_plan_scroll(VolumeStream *stream, Vec3 focus)
+{
+    const VoxelVolume *vol = stream->volume;
+    float chunk_world_size = vol->voxel_size * CHUNK_SIZE;
+
+    int32_t delta[3];
+    delta[0] = stream_focus_chunk(focus.x, stream->desc.world_origin.x, chunk_world_size) -
+               (stream->origin_x + vol->chunks_x / 2);
+    delta[1] = stream_focus_chunk(focus.y, stream->desc.world_origin.y, chunk_world_size) -
+               (stream->origin_y + vol->chunks_y / 2);
+    delta[2] = stream_focus_chunk(focus.z, stream->desc.world_origin.z, chunk_world_size) -
+               (stream->origin_z + vol->chunks_z / 2);
+    if (stream->desc.fixed_y)
+        delta[1] = 0;
+
+    /* Largest offset first; one plane per scroll keeps eviction bounded */
+    int32_t axis = -1;
+    int32_t best = VOLUME_STREAM_HYSTERESIS;
+    for (int32_t a = 0; a < 3; a++)
+    {
+        int32_t mag = delta[a] < 0 ? -delta[a] : delta[a];
+        if (mag > best)
+        {
+            best = mag;
+            axis = a;
+        }
+    }
+    if (axis < 0)
+        return;
+
+    int32_t step = delta[axis] > 0 ? 1 : -1;
+    stream->scroll_dx = (axis == 0) ? step : 0;
+    stream->scroll_dy = (axis == 1) ? step : 0;
+    stream->scroll_dz = (axis == 2) ? step : 0;
+    stream->evict_cursor = 0;
+    stream->scroll_pending = true;
+}
+
+/* Logical coordinates of the i-th chunk on the outgoing plane */
+static bool stream_outgoing_cell(const VolumeStream *stream, int32_t i,
+                                 int32_t *cx, int32_t *cy, int32_t *cz)
+{
+    const VoxelVolume *vol = stream->volume;
+    if (stream->scroll_dx != 0)
+    {
+        if (i >= vol->chunks_y * vol->chunks_z)
+            return false;
+        *cx = stream->scroll_dx > 0 ? 0 : vol->chunks_x - 1;
+        *cy = i % vol->chunks_y;
+        *cz = i / vol->chunks_y;
+    }
+    else if (stream->scroll_dy != 0)
+    {
+        if (i >= vol->chunks_x * vol->chunks_z)
+            return false;
+        *cx = i % vol->chunks_x;
+        *cy = stream->scroll_dy > 0 ? 0 : vol->chunks_y - 1;
+        *cz = i / vol->chunks_x;
+    }
+    else
+    {
+        if (i >= vol->chunks_x * vol->chunks_y)
+            return false;
+        *cx = i % vol->chunks_x;
+        *cy = i / vol->chunks_x;
+        *cz = stream->scroll_dz > 0 ? 0 : vol->chunks_z - 1;
+    }
+    return true;
+}
+
+static void stream_finish_scroll(VolumeStream *stream)
+{
+    VoxelVolume *vol = stream->volume;
+
+    /* Catch outgoing chunks edited after their save was queued */
+    if (stream->persist)
+    {
+        int32_t cx, cy, cz;
+        for (int32_t i = 0; stream_outgoing_cell(stream, i, &cx, &cy, &cz); i++)
+        {
+            int32_t slot = volume_chunk_slot(vol, cx, cy, cz);
+            if (stream->slot_state[slot] == STREAM_SLOT_RESIDENT && volume_chunk_modified(vol, slot))
+            {
+                stream->evict_cursor = i;
+                return;
+            }
+        }
+    }
+
+    int32_t recycled[VOLUME_MAX_CHUNKS];
+    int32_t count = volume_scroll(vol, stream->scroll_dx, stream->scroll_dy, stream->scroll_dz,
+                                  recycled, VOLUME_MAX_CHUNKS);
+    stream->origin_x += stream->scroll_dx;
+    stream->origin_y += stream->scroll_dy;
+    stream->origin_z += stream->scroll_dz;
+
+    for (int32_t i = 0; i < count; i++)
+    {
+        int32_t slot = recycled[i];
+        stream->slot_ticket[slot]++;
+        stream_push_want(stream, slot);
+    }
+
+    stream->scroll_pending = false;
+    stream->stats.scrolls++;
+}
+
+static void stream_evict(VolumeStream *stream)
+{
+    VoxelVolume *vol = stream->volume;
+    int32_t budget = stream->desc.evictions_per_frame;
+
+    while (budget > 0)
+    {
+        int32_t cx, cy, cz;
+        if (!stream_outgoing_cell(stream, stream->evict_cursor, &cx, &cy, &cz))
+        {
+            stream_finish_scroll(stream);
+            return;
+        }
+
+        int32_t slot = volume_chunk_slot(vol, cx, cy, cz);
+        if (stream->persist && stream->slot_state[slot] == STREAM_SLOT_RESIDENT &&
+            volume_chunk_modified(vol, slot))
+        {
+            if (!stream_queue_save(stream, slot))
+                return;
+        }
+
+        stream->evict_cursor++;
+        stream->stats.evictions++;
+        budget--;
+    }
+
+    /* Budget consumed exactly at the end of the plane */
+    int32_t cx, cy, cz;
+    if (!stream_outgoing_cell(stream, stream->evict_cursor, &cx, &cy, &cz))
+        stream_finish_scroll(stream);
+}
+
+static void stream_issue_loads(VolumeStream *stream)
+{
+    bool queued = false;
+
+    while (stream->want_count > 0 && stream->in_flight < VOLUME_STREAM_MAX_IN_FLIGHT)
+    {
+        int32_t slot = stream->want[stream->want_head];
+        stream->want_head = (stream->want_head + 1) % VOLUME_MAX_CHUNKS;
+        stream->want_count--;
+        if (stream->slot_state[slot] != STREAM_SLOT_WANT)
+            continue;
+
+        stream->slot_state[slot] = STREAM_SLOT_REQUESTED;
+        stream->in_flight++;
+
+        int32_t gcx, gcy, gcz;
+        stream_slot_global(stream, slot, &gcx, &gcy, &gcz);
+
+        /* Chunk re-entered before its save finished: serve the in-memory copy */
+        int32_t save_index = stream_find_save(stream, gcx, gcy, gcz);
+        if (save_index >= 0)
+        {
+            StreamResult result = {slot, stream->slot_ticket[slot], NULL, true};
+            result.voxels = (VoxelCell *)malloc(CHUNK_VOXEL_COUNT * sizeof(VoxelCell));
+            if (result.voxels)
+                memcpy(result.voxels, stream->saves[save_index].voxels, CHUNK_VOXEL_COUNT * sizeof(VoxelCell));
+
+            mtx_lock(&stream->lock);
+            int32_t tail = (stream->result_head + stream->result_count) % VOLUME_STREAM_MAX_IN_FLIGHT;
+            stream->results[tail] = result;
+            stream->result_count++;
+            mtx_unlock(&stream->lock);
+            continue;
+        }
+
+        StreamJob job = {STREAM_JOB_LOAD, slot, stream->slot_ticket[slot], -1, gcx, gcy, gcz};
+        mtx_lock(&stream->lock);
+        stream_push_job(stream, &job);
+        mtx_unlock(&stream->lock);
+        queued = true;
+    }
+
+    if (queued && stream->worker_count > 0)
+    {
+        mtx_lock(&stream->lock);
+        cnd_broadcast(&stream->job_ready);
+        mtx_unlock(&stream->lock);
+    }
+}
+
+static void stream_commit_loads(VolumeStream *stream)
+{
+    int32_t budget = stream->desc.loads_per_frame;
+
+    while (budget > 0)
+    {
+        mtx_lock(&stream->lock);
+        if (stream->result_count == 0)
+        {
+            mtx_unlock(&stream->lock);
+            break;
+        }
+        StreamResult result = stream->results[stream->result_head];
+        stream->result_head = (stream->result_head + 1) % VOLUME_STREAM_MAX_IN_FLIGHT;
+        stream->result_count--;
+        mtx_unlock(&stream->lock);
+
+        stream->in_flight--;
+
+        /* Slot scrolled away (and possibly re-requested) since this load was queued */
+        bool current = stream->slot_state[result.slot] == STREAM_SLOT_REQUESTED &&
+                       stream->slot_ticket[result.slot] == result.ticket;
+        if (!current)
+        {
+            stream->stats.loads_discarded++;
+        }
+        else if (!result.voxels)
+        {
+            stream->slot_state[result.slot] = STREAM_SLOT_RESIDENT;
+            stream_push_want(stream, result.slot);
+        }
+        else
+        {
+            volume_load_chunk(stream->volume, result.slot, result.voxels);
+            stream->slot_state[result.slot] = STREAM_SLOT_RESIDENT;
+            stream->stats.loads_committed++;
+            if (result.from_disk)
+                stream->stats.loads_from_disk++;
+            budget--;
+        }
+        free(result.voxels);
+    }
+}
+
+void volume_stream_desc_defaults(VolumeStreamDesc *desc)
+{
+    if (!desc)
+        return;
+    memset(desc, 0, sizeof(*desc));
+    desc->chunks_x = VOLUME_MAX_CHUNKS_X;
+    desc->chunks_y = VOLUME_MAX_CHUNKS_Y;
+    desc->chunks_z = VOLUME_MAX_CHUNKS_Z;
+    desc->voxel_size = 0.1f;
+    desc->worker_count = VOLUME_STREAM_DEFAULT_WORKERS;
+    desc->loads_per_frame = VOLUME_STREAM_DEFAULT_LOADS_PER_FRAME;
+    desc->evictions_per_frame = VOLUME_STREAM_DEFAULT_EVICTIONS_PER_FRAME;
+}
+
+VolumeStream *volume_stream_create(const VolumeStreamDesc *desc, Vec3 focus)
+{
+    if (!desc || desc->voxel_size <= 0.0f || desc->loads_per_frame <= 0 || desc->evictions_per_frame <= 0)
+        return NULL;
+
+    VolumeStream *stream = (VolumeStream *)calloc(1, sizeof(VolumeStream));
+    if (!stream)
+        return NULL;
+
+    stream->desc = *desc;
+    stream->desc.persist_dir = NULL;
+    if (desc->persist_dir && desc->persist_dir[0])
+    {
+        snprintf(stream->persist_dir, sizeof(stream->persist_dir), "%s", desc->persist_dir);
+        stream->persist = true;
+    }
+
+    float chunk_world_size = desc->voxel_size * CHUNK_SIZE;
+    int32_t chunks_x = desc->chunks_x < VOLUME_MAX_CHUNKS_X ? desc->chunks_x : VOLUME_MAX_CHUNKS_X;
+    int32_t chunks_y = desc->chunks_y < VOLUME_MAX_CHUNKS_Y ? desc->chunks_y : VOLUME_MAX_CHUNKS_Y;
+    int32_t chunks_z = desc->chunks_z < VOLUME_MAX_CHUNKS_Z ? desc->chunks_z : VOLUME_MAX_CHUNKS_Z;
+
+    stream->origin_x = stream_focus_chunk(focus.x, desc->world_origin.x, chunk_world_size) - chunks_x / 2;
+    stream->origin_y = desc->fixed_y ? 0 : stream_focus_chunk(focus.y, desc->world_origin.y, chunk_world_size) - chunks_y / 2;
+    stream->origin_z = stream_focus_chunk(focus.z, desc->world_origin.z, chunk_world_size) - chunks_z / 2;
+
+    Vec3 window_origin = vec3_create(desc->world_origin.x + stream->origin_x * chunk_world_size,
+                                     desc->world_origin.y + stream->origin_y * chunk_world_size,
+                                     desc->world_origin.z + stream->origin_z * chunk_world_size);
+    stream->volume = volume_create_dims(chunks_x, chunks_y, chunks_z, window_origin, desc->voxel_size);
+    if (!stream->volume)
+    {
+        free(stream);
+        return NULL;
+    }
+
+    if (mtx_init(&stream->lock, mtx_plain) != thrd_success)
+    {
+        volume_destroy(stream->volume);
+        free(stream);
+        return NULL;
+    }
+    if (cnd_init(&stream->job_ready) != thrd_success)
+    {
+        mtx_destroy(&stream->lock);
+        volume_destroy(stream->volume);
+        free(stream);
+        return NULL;
+    }
+
+    /* Queue the whole window nearest-first (bucketed by squared chunk distance) */
+    VoxelVolume *vol = stream->volume;
+    int32_t hx = vol->chunks_x / 2, hy = vol->chunks_y / 2, hz = vol->chunks_z / 2;
+    int32_t max_dist2 = hx * hx + hy * hy + hz * hz;
+    for (int32_t d2 = 0; d2 <= max_dist2; d2++)
+    {
+        for (int32_t slot = 0; slot < vol->total_chunks; slot++)
+        {
+            int32_t cx, cy, cz;
+            volume_slot_to_chunk(vol, slot, &cx, &cy, &cz);
+            int32_t ox = cx - hx, oy = cy - hy, oz = cz - hz;
+            if (ox * ox + oy * oy + oz * oz == d2)
+            {
+                vol->chunks[slot].state = CHUNK_STATE_LOADING;
+                stream_push_want(stream, slot);
+            }
+        }
+    }
+
+    int32_t workers = desc->worker_count;
+    if (workers > VOLUME_STREAM_MAX_WORKERS)
+        workers = VOLUME_STREAM_MAX_WORKERS;
+    for (int32_t i = 0; i < workers; i++)
+    {
+        if (thrd_create(&stream->workers[i], stream_worker_main, stream) != thrd_success)
+            break;
+        stream->worker_count++;
+    }
+
+    return stream;
+}
+
+void volume_stream_destroy(VolumeStream *stream)
+{
+    if (!stream)
+        return;
+
+    /* Drop queued loads; saves must still reach disk */
+    mtx_lock(&stream->lock);
+    int32_t kept = 0;
+    for (int32_t i = 0; i < stream->job_count; i++)
+    {
+        StreamJob job = stream->jobs[(stream->job_head + i) % VOLUME_STREAM_JOB_QUEUE_SIZE];
+        if (job.type == STREAM_JOB_SAVE)
+            stream->jobs[(stream->job_head + kept++) % VOLUME_STREAM_JOB_QUEUE_SIZE] = job;
+    }
+    stream->job_count = kept;
+    stream->shutdown = true;
+    cnd_broadcast(&stream->job_ready);
+    mtx_unlock(&stream->lock);
+
+    for (int32_t i = 0; i < stream->worker_count; i++)
+        thrd_join(stream->workers[i], NULL);
+    stream_run_inline(stream);
+
+    for (int32_t i = 0; i < stream->result_count; i++)
+        free(stream->results[(stream->result_head + i) % VOLUME_STREAM_MAX_IN_FLIGHT].voxels);
+    for (int32_t i = 0; i < VOLUME_STREAM_MAX_PENDING_SAVES; i++)
+        free(stream->saves[i].voxels);
+
+    cnd_destroy(&stream->job_ready);
+    mtx_destroy(&stream->lock);
+    volume_destroy(stream->volume);
+    free(stream);
+}
+
+VoxelVolume *volume_stream_volume(VolumeStream *stream)
+{
+    return stream ? stream->volume : NULL;
+}
+
+void volume_stream_update(VolumeStream *stream, Vec3 focus)
+{
+    if (!stream)
+        return;
+
+    stream_reap_saves(stream);
+
+    if (!stream->scroll_pending)
+        stream_plan_scroll(stream, focus);
+    if (stream->scroll_pending)
+        stream_evict(stream);
+
+    stream_issue_loads(stream);
+    if (stream->worker_count == 0)
+        stream_run_inline(stream);
+    stream_commit_loads(stream);
+
+    if (stream->worker_count == 0)
+        stream_reap_saves(stream);
+}
+
+int32_t volume_stream_flush(VolumeStream *stream)
+{
+    if (!stream || !stream->persist)
+        return 0;
+
+    int32_t queued = 0;
+    VoxelVolume *vol = stream->volume;
+    for (int32_t slot = 0; slot < vol->total_chunks; slot++)
+    {
+        if (stream->slot_state[slot] != STREAM_SLOT_RESIDENT || !volume_chunk_modified(vol, slot))
+            continue;
+        if (stream_queue_save(stream, slot))
+            queued++;
+    }
+
+    if (stream->worker_count == 0)
+    {
+        stream_run_inline(stream);
+        stream_reap_saves(stream);
+    }
+    return queued;
+}
+
+void volume_stream_get_origin(const VolumeStream *stream, int32_t *gcx, int32_t *gcy, int32_t *gcz)
+{
+    if (!stream)
+        return;
+    if (gcx)
+        *gcx = stream->origin_x;
+    if (gcy)
+        *gcy = stream->origin_y;
+    if (gcz)
+        *gcz = stream->origin_z;
+}
+
+VolumeStreamStats volume_stream_get_stats(const VolumeStream *stream)
+{
+    VolumeStreamStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (!stream)
+        return stats;
+
+    stats = stream->stats;
+    for (int32_t slot = 0; slot < stream->volume->total_chunks; slot++)
+    {
+        if (stream->slot_state[slot] != STREAM_SLOT_RESIDENT)
+            stats.pending_loads++;
+    }
+    return stats;
+}
@@ -0,0 +1,103 @@
+#ifndef PATCH_VOXEL_VOLUME_STREAM_H
+#define PATCH_VOXEL_VOLUME_STREAM_H
+
+#include "engine/voxel/volume.h"
+#include "engine/core/types.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Streaming Chunk Window
+ *
+ * Presents an unbounded world through a fixed-size VoxelVolume that follows
+ * a focus point (usually the player). The window scrolls one chunk plane at
+ * a time by rotating the volume's ring offsets, so resident chunks are never
+ * copied:
+ * 1. Outgoing plane is evicted (edited chunks queued for persistence)
+ * 2. volume_scroll() moves bounds and recycles the outgoing slots
+ * 3. Recycled slots are loaded from disk or generated on worker threads
+ * 4. Finished loads are committed into the volume on the main thread
+ *
+ * All volume mutation happens inside volume_stream_update(), so calling it
+ * between simulation ticks keeps connectivity, raycasts and physics on a
+ * consistent window. Slots still loading read as empty space.
+ */
+
+#define VOLUME_STREAM_MAX_WORKERS 8
+#define VOLUME_STREAM_DEFAULT_WORKERS 2
+#define VOLUME_STREAM_DEFAULT_LOADS_PER_FRAME 8
+#define VOLUME_STREAM_DEFAULT_EVICTIONS_PER_FRAME 32
+#define VOLUME_STREAM_MAX_IN_FLIGHT 64
+#define VOLUME_STREAM_MAX_PENDING_SAVES 128
+#define VOLUME_STREAM_HYSTERESIS 1
+#define VOLUME_STREAM_PATH_MAX 256
+
+    /*
+     * Fills one chunk of voxels (pre-cleared to empty) for global chunk
+     * coordinates. Runs on worker threads; must be thread-safe.
+     */
+    typedef void (*VolumeStreamGenerateFn)(void *user, int32_t gcx, int32_t gcy, int32_t gcz,
+                                           VoxelCell *out_voxels);
+
+    typedef struct
+    {
+        int32_t chunks_x, chunks_y, chunks_z; /* Window size (clamped to VOLUME_MAX_CHUNKS_*) */
+        Vec3 world_origin;                    /* World position of global chunk (0,0,0) */
+        float voxel_size;
+        bool fixed_y; /* Never scroll vertically (world height fits the window) */
+
+        VolumeStreamGenerateFn generate;
+        void *user;
+
+        const char *persist_dir; /* Edited chunks saved here on eviction; NULL discards edits */
+
+        int32_t worker_count;        /* 0 = run jobs inline during update (deterministic) */
+        int32_t loads_per_frame;     /* Chunk commits per update */
+        int32_t evictions_per_frame; /* Outgoing chunks processed per update */
+    } VolumeStreamDesc;
+
+    typedef struct
+    {
+        int32_t loads_committed;
+        int32_t loads_discarded; /* Stale results for slots that scrolled away */
+        int32_t loads_from_disk;
+        int32_t evictions;
+        int32_t chunks_persisted;
+        int32_t save_failures; /* Write attempts that failed (the save is retried) */
+        int32_t scrolls;
+        int32_t pending_loads; /* Slots currently reading as empty */
+    } VolumeStreamStats;
+
+    typedef struct VolumeStream VolumeStream;
+
+    void volume_stream_desc_defaults(VolumeStreamDesc *desc);
+
+    /* Creates the window centered on focus and queues every chunk for loading */
+    VolumeStream *volume_stream_create(const VolumeStreamDesc *desc, Vec3 focus);
+
+    /* Finishes queued saves, joins workers. Resident edits are not persisted. */
+    void volume_stream_destroy(VolumeStream *stream);
+
+    VoxelVolume *volume_stream_volume(VolumeStream *stream);
+
+    /* Per-frame step on the main thread: scroll toward focus, evict, commit loads */
+    void volume_stream_update(VolumeStream *stream, Vec3 focus);
+
+    /* Queues saves for every edited resident chunk (e.g. before shutdown) */
+    int32_t volume_stream_flush(VolumeStream *stream);
+
+    /* Global chunk coordinates of the window's logical chunk (0,0,0) */
+    void volume_stream_get_origin(const VolumeStream *stream, int32_t *gcx, int32_t *gcy, int32_t *gcz);
+
+    VolumeStreamStats volume_stream_get_stats(const VolumeStream *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PATCH_VOXEL_VOLUME_STREAM_H */
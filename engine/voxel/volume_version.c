@@ -0,0 +1,352 @@
+#include "volume_version.h"
+#include <threads.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct VolumePage
+{
+    Chunk chunk; /* First member: view chunk pointers alias pages */
+    uint32_t version;
+    uint64_t retire_epoch;
+    struct VolumePage *next;
+} VolumePage;
+
+/* View header; chunk pointer and version arrays follow in the same allocation */
+typedef struct VolumeViewNode
+{
+    VolumeView view;
+    uint64_t retire_epoch;
+    struct VolumeViewNode *next;
+} VolumeViewNode;
+
+struct VolumeVersionStore
+{
+    /* Guards current, epoch, reader pins, retired lists and stats */
+    mtx_t lock;
+
+    int32_t chunks_x, chunks_y, chunks_z;
+    int32_t total_chunks;
+
+    VolumeViewNode *current;
+    uint64_t epoch;
+    uint64_t reader_epoch[VOLUME_VERSION_MAX_READERS]; /* 0 = not reading */
+
+    /* Writer side: latest page per storage slot (all referenced by current) */
+    VolumePage **slot_pages;
+
+    VolumePage *retired_pages;
+    VolumeViewNode *retired_views;
+
+    /* Pools are only touched by the publishing thread */
+    VolumePage *free_pages;
+    VolumeViewNode *free_views;
+    int32_t pooled_count;
+
+    VolumeVersionStats stats;
+};
+
+static size_t view_node_size(int32_t total_chunks)
+{
+    return sizeof(VolumeViewNode) + (size_t)total_chunks * (sizeof(const Chunk *) + sizeof(uint32_t));
+}
+
+static VolumeViewNode *view_node_take(VolumeVersionStore *store)
+{
+    VolumeViewNode *node = store->free_views;
+    if (node)
+    {
+        store->free_views = node->next;
+        return node;
+    }
+    return (VolumeViewNode *)malloc(view_node_size(store->total_chunks));
+}
+
+static void free_page_list(VolumePage *page)
+{
+    while (page)
+    {
+        VolumePage *next = page->next;
+        free(page);
+        page = next;
+    }
+}
+
+static void free_view_list(VolumeViewNode *node)
+{
+    while (node)
+    {
+        VolumeViewNode *next = node->next;
+        free(node);
+        node = next;
+    }
+}
+
+/* Moves retired pages/views no pinned reader can reach into the pools.
+   Caller holds the lock and is the publishing thread. */
+static void reclaim_locked(VolumeVersionStore *store)
+{
+    uint64_t min_pinned = UINT64_MAX;
+    for (int32_t r = 0; r < VOLUME_VERSION_MAX_READERS; r++)
+    {
+        if (store->reader_epoch[r] != 0 && store->reader_epoch[r] < min_pinned)
+            min_pinned = store->reader_epoch[r];
+    }
+
+    /* Retired at epoch E means only views older than E reference it */
+    VolumePage **page_link = &store->retired_pages;
+    while (*page_link)
+    {
+        VolumePage *page = *page_link;
+        if (page->retire_epoch <= min_pinned)
+        {
+            *page_link = page->next;
+            page->next = store->free_pages;
+            store->free_pages = page;
+            store->pooled_count++;
+            store->stats.pages_retired--;
+            store->stats.pages_reclaimed++;
+        }
+        else
+        {
+            page_link = &page->next;
+        }
+    }
+
+    VolumeViewNode **view_link = &store->retired_views;
+    while (*view_link)
+    {
+        VolumeViewNode *node = *view_link;
+        if (node->retire_epoch <= min_pinned)
+        {
+            *view_link = node->next;
+            node->next = store->free_views;
+            store->free_views = node;
+        }
+        else
+        {
+            view_link = &node->next;
+        }
+    }
+}
+
+VolumeVersionStore *volume_versions_create(const VoxelVolume *vol)
+{
+    if (!vol || vol->total_chunks <= 0)
+        return NULL;
+
+    VolumeVersionStore *store = (VolumeVersionStore *)calloc(1, sizeof(VolumeVersionStore));
+    if (!store)
+        return NULL;
+
+    store->chunks_x = vol->chunks_x;
+    store->chunks_y = vol->chunks_y;
+    store->chunks_z = vol->chunks_z;
+    store->total_chunks = vol->total_chunks;
+
+    store->slot_pages = (VolumePage **)calloc((size_t)vol->total_chunks, sizeof(VolumePage *));
+    if (!store->slot_pages || mtx_init(&store->lock, mtx_plain) != thrd_success)
+    {
+        free(store->slot_pages);
+        free(store);
+        return NULL;
+    }
+    return store;
+}
+
+void volume_versions_destroy(VolumeVersionStore *store)
+{
+    if (!store)
+        return;
+
+    for (int32_t i = 0; i < store->total_chunks; i++)
+        free(store->slot_pages[i]);
+    free(store->slot_pages);
+
+    free_page_list(store->retired_pages);
+    free_page_list(store->free_pages);
+    free(store->current);
+    free_view_list(store->retired_views);
+    free_view_list(store->free_views);
+
+    mtx_destroy(&store->lock);
+    free(store);
+}
+
+uint64_t volume_versions_publish(VolumeVersionStore *store, const VoxelVolume *vol)
+{
+    if (!store || !vol || vol->chunks_x != store->chunks_x || vol->chunks_y != store->chunks_y ||
+        vol->chunks_z != store->chunks_z)
+        return 0;
+
+    int32_t needed = 0;
+    for (int32_t slot = 0; slot < store->total_chunks; slot++)
+    {
+        const VolumePage *page = store->slot_pages[slot];
+        if (!page || page->version != vol->chunk_versions[slot])
+            needed++;
+    }
+
+    /* Reserve every page and the view first so a failed allocation leaves
+       the published state untouched (spares stay pooled) */
+    int32_t allocated = 0;
+    while (store->pooled_count < needed)
+    {
+        VolumePage *page = (VolumePage *)malloc(sizeof(VolumePage));
+        if (!page)
+            break;
+        page->next = store->free_pages;
+        store->free_pages = page;
+        store->pooled_count++;
+        allocated++;
+    }
+
+    VolumeViewNode *node = (store->pooled_count >= needed) ? view_node_take(store) : NULL;
+    if (!node)
+    {
+        mtx_lock(&store->lock);
+        store->stats.pages_allocated += allocated;
+        store->stats.pages_pooled = store->pooled_count;
+        mtx_unlock(&store->lock);
+        return 0;
+    }
+
+    /* Copy changed chunks; replaced pages stay valid for readers of older views */
+    uint64_t epoch = store->epoch + 1;
+    VolumePage *replaced = NULL;
+    int32_t replaced_count = 0;
+    for (int32_t slot = 0; slot < store->total_chunks; slot++)
+    {
+        VolumePage *old_page = store->slot_pages[slot];
+        uint32_t version = vol->chunk_versions[slot];
+        if (old_page && old_page->version == version)
+            continue;
+
+        VolumePage *page = store->free_pages;
+        store->free_pages = page->next;
+        store->pooled_count--;
+
+        memcpy(&page->chunk, &vol->chunks[slot], sizeof(Chunk));
+        page->version = version;
+        page->next = NULL;
+        store->slot_pages[slot] = page;
+
+        if (old_page)
+        {
+            old_page->retire_epoch = epoch;
+            old_page->next = replaced;
+            replaced = old_page;
+            replaced_count++;
+        }
+    }
+
+    /* Logical order: readers never see ring offsets */
+    VolumeView *view = &node->view;
+    const Chunk **chunks = (const Chunk **)(node + 1);
+    uint32_t *versions = (uint32_t *)(chunks + store->total_chunks);
+    view->epoch = epoch;
+    view->chunks_x = vol->chunks_x;
+    view->chunks_y = vol->chunks_y;
+    view->chunks_z = vol->chunks_z;
+    view->total_chunks = vol->total_chunks;
+    view->bounds = vol->bounds;
+    view->voxel_size = vol->voxel_size;
+    view->chunks = chunks;
+    view->versions = versions;
+
+    int32_t logical = 0;
+    for (int32_t cz = 0; cz < vol->chunks_z; cz++)
+    {
+        for (int32_t cy = 0; cy < vol->chunks_y; cy++)
+        {
+            for (int32_t cx = 0; cx < vol->chunks_x; cx++)
+            {
+                const VolumePage *page = store->slot_pages[volume_chunk_slot(vol, cx, cy, cz)];
+                chunks[logical] = &page->chunk;
+                versions[logical] = page->version;
+                logical++;
+            }
+        }
+    }
+
+    mtx_lock(&store->lock);
+    VolumeViewNode *previous = store->current;
+    store->current = node;
+    store->epoch = epoch;
+    if (previous)
+    {
+        previous->retire_epoch = epoch;
+        previous->next = store->retired_views;
+        store->retired_views = previous;
+    }
+    while (replaced)
+    {
+        VolumePage *next = replaced->next;
+        replaced->next = store->retired_pages;
+        store->retired_pages = replaced;
+        replaced = next;
+    }
+    store->stats.epoch = epoch;
+    store->stats.pages_copied = needed;
+    store->stats.pages_allocated += allocated;
+    store->stats.pages_retired += replaced_count;
+    reclaim_locked(store);
+    store->stats.pages_pooled = store->pooled_count;
+    mtx_unlock(&store->lock);
+
+    return epoch;
+}
+
+const VolumeView *volume_versions_acquire(VolumeVersionStore *store, int32_t reader)
+{
+    if (!store || reader < 0 || reader >= VOLUME_VERSION_MAX_READERS)
+        return NULL;
+
+    mtx_lock(&store->lock);
+    const VolumeView *view = NULL;
+    if (store->current)
+    {
+        view = &store->current->view;
+        store->reader_epoch[reader] = view->epoch;
+    }
+    mtx_unlock(&store->lock);
+    return view;
+}
+
+void volume_versions_release(VolumeVersionStore *store, int32_t reader)
+{
+    if (!store || reader < 0 || reader >= VOLUME_VERSION_MAX_READERS)
+        return;
+
+    mtx_lock(&store->lock);
+    store->reader_epoch[reader] = 0;
+    mtx_unlock(&store->lock);
+}
+
+int32_t volume_view_changed_chunks(const VolumeView *view, uint32_t *seen_versions,
+                                   int32_t *out_indices, int32_t max_count)
+{
+    if (!view || !seen_versions || !out_indices)
+        return 0;
+
+    int32_t count = 0;
+    for (int32_t i = 0; i < view->total_chunks && count < max_count; i++)
+    {
+        if (seen_versions[i] == view->versions[i])
+            continue;
+        seen_versions[i] = view->versions[i];
+        out_indices[count++] = i;
+    }
+    return count;
+}
+
+VolumeVersionStats volume_versions_get_stats(VolumeVersionStore *store)
+{
+    VolumeVersionStats stats = {0};
+    if (!store)
+        return stats;
+
+    mtx_lock(&store->lock);
+    stats = store->stats;
+    mtx_unlock(&store->lock);
+    return stats;
+}
@@ -0,0 +1,104 @@
+#ifndef PATCH_VOXEL_VOLUME_VERSION_H
+#define PATCH_VOXEL_VOLUME_VERSION_H
+
+#include "engine/voxel/volume.h"
+#include "engine/core/types.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+ * Versioned Chunk Views
+ *
+ * Lets render/worker threads read a consistent copy of the terrain while the
+ * sim thread keeps editing the live VoxelVolume:
+ * 1. Every chunk modification stamps a volume-unique version (chunk_versions)
+ * 2. volume_versions_publish() copies only chunks whose version changed into
+ *    immutable pages; unchanged chunks share the previous view's pages
+ * 3. Readers pin the current view with acquire/release and never block edits
+ * 4. Replaced pages and views are retired with the epoch that replaced them
+ *    and recycled once no reader is pinned to an older epoch
+ *
+ * Publish on the editing thread at a tick boundary, after occupancy is
+ * rebuilt. Views are in logical (row-major) order, like GPU buffers and
+ * snapshots, so readers never see ring offsets. Scrolling re-versions every
+ * chunk (coordinates change), matching the full shadow rebuild it triggers.
+ */
+
+#define VOLUME_VERSION_MAX_READERS 8
+
+    typedef struct
+    {
+        uint64_t epoch;
+        int32_t chunks_x, chunks_y, chunks_z;
+        int32_t total_chunks;
+        Bounds3D bounds;
+        float voxel_size;
+
+        /* Logical chunk i: immutable contents and the version they were copied at */
+        const Chunk *const *chunks;
+        const uint32_t *versions;
+    } VolumeView;
+
+    typedef struct
+    {
+        uint64_t epoch;
+        int32_t pages_copied;    /* Chunks copied by the last publish */
+        int32_t pages_allocated; /* Current + retired + pooled */
+        int32_t pages_retired;   /* Waiting for readers to move past their epoch */
+        int32_t pages_pooled;    /* Reclaimed pages kept for reuse */
+        int32_t pages_reclaimed; /* Total since creation */
+    } VolumeVersionStats;
+
+    typedef struct VolumeVersionStore VolumeVersionStore;
+
+    /* Store sized for vol's chunk grid; nothing is published until the first publish */
+    VolumeVersionStore *volume_versions_create(const VoxelVolume *vol);
+
+    /* All readers must have released their views */
+    void volume_versions_destroy(VolumeVersionStore *store);
+
+    /*
+     * Publishes the volume's current contents as a new view. Only chunks whose
+     * version differs from the previous view are copied. Returns the new epoch,
+     * or 0 on allocation failure or grid mismatch (previous view stays current).
+     */
+    uint64_t volume_versions_publish(VolumeVersionStore *store, const VoxelVolume *vol);
+
+    /*
+     * Pins and returns the latest view for reader slot [0, VOLUME_VERSION_MAX_READERS).
+     * Each slot is owned by one thread and holds at most one view at a time.
+     * Returns NULL before the first publish.
+     */
+    const VolumeView *volume_versions_acquire(VolumeVersionStore *store, int32_t reader);
+    void volume_versions_release(VolumeVersionStore *store, int32_t reader);
+
+    /*
+     * Reader-side diff: writes logical indices whose version differs from
+     * seen_versions (total_chunks entries, zero-initialized) and updates them.
+     */
+    int32_t volume_view_changed_chunks(const VolumeView *view, uint32_t *seen_versions,
+                                       int32_t *out_indices, int32_t max_count);
+
+    VolumeVersionStats volume_versions_get_stats(VolumeVersionStore *store);
+
+    static inline const Chunk *volume_view_get_chunk(const VolumeView *view, int32_t cx, int32_t cy, int32_t cz)
+    {
+        if (cx < 0 || cx >= view->chunks_x ||
+            cy < 0 || cy >= view->chunks_y ||
+            cz < 0 || cz >= view->chunks_z)
+        {
+            return NULL;
+        }
+        return view->chunks[cx + cy * view->chunks_x + cz * view->chunks_x * view->chunks_y];
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PATCH_VOXEL_VOLUME_VERSION_H */
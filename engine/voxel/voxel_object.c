@@ -139,8 +139,9 @@ static void compute_collider_boxes(VoxelObject *obj)
     }
 }
 
-void voxel_object_recalc_shape(VoxelObject *obj)
+void voxel_object_recalc_shape(VoxelObjectWorld *world, int32_t obj_index)
 {
+    VoxelObject *obj = &world->objects[obj_index];
     if (obj->voxel_count <= 0)
     {
         obj->active = false;
@@ -150,7 +151,7 @@ void voxel_object_recalc_shape(VoxelObject *obj)
         return;
     }
 
-    /* Recenter voxels in the 32³ grid so OBB/collision shapes align with obj->position.
+    /* Recenter voxels in the 32³ grid so OBB/collision shapes align with the pose position.
      * After splits or destruction, voxels may be clustered in one corner of the grid.
      * The OBB and terrain sample points assume voxels are centered around grid position 16. */
     {
@@ -189,8 +190,8 @@ void voxel_object_recalc_shape(VoxelObject *obj)
                 -(float)sx * obj->voxel_size,
                 -(float)sy * obj->voxel_size,
                 -(float)sz * obj->voxel_size);
-            obj->position = vec3_add(obj->position,
-                                     quat_rotate_vec3(obj->orientation, local_shift));
+            Vec3 shift = quat_rotate_vec3(voxel_object_orientation(world, obj_index), local_shift);
+            voxel_object_set_position(world, obj_index, vec3_add(voxel_object_position(world, obj_index), shift));
 
             VObjVoxel tmp[VOBJ_TOTAL_VOXELS];
             memset(tmp, 0, sizeof(tmp));
@@ -364,9 +365,9 @@ void voxel_object_recalc_shape(VoxelObject *obj)
     com_y *= inv_count;
     com_z *= inv_count;
 
-    /* Radius: calculate from GRID CENTER (which corresponds to obj->position) to corners.
+    /* Radius: calculate from GRID CENTER (which corresponds to the pose position) to corners.
      * This is critical for split objects where voxels may be off-center in the grid.
-     * The raycast bounding sphere test uses obj->position, not COM. */
+     * The raycast bounding sphere test uses the pose position, not COM. */
     float grid_center = (float)VOBJ_GRID_SIZE * 0.5f;
     float max_dist_sq = 0.0f;
     for (int32_t c = 0; c < 8; c++)
@@ -479,8 +480,8 @@ int32_t voxel_object_world_add_sphere(VoxelObjectWorld *world, Vec3 position,
     VoxelObject *obj = &world->objects[slot];
     memset(obj, 0, sizeof(VoxelObject));
 
-    obj->position = position;
-    obj->orientation = quat_identity();
+    voxel_object_set_position(world, slot, position);
+    voxel_object_set_orientation(world, slot, quat_identity());
     obj->active = true;
 
     obj->voxel_size = world->voxel_size;
@@ -512,7 +513,7 @@ int32_t voxel_object_world_add_sphere(VoxelObjectWorld *world, Vec3 position,
 
     obj->voxel_revision = 1;
 
-    voxel_object_recalc_shape(obj);
+    voxel_object_recalc_shape(world, slot);
     return slot;
 }
 
@@ -526,8 +527,8 @@ int32_t voxel_object_world_add_box(VoxelObjectWorld *world, Vec3 position,
     VoxelObject *obj = &world->objects[slot];
     memset(obj, 0, sizeof(VoxelObject));
 
-    obj->position = position;
-    obj->orientation = quat_identity();
+    voxel_object_set_position(world, slot, position);
+    voxel_object_set_orientation(world, slot, quat_identity());
     obj->active = true;
 
     obj->voxel_size = world->voxel_size;
@@ -559,7 +560,7 @@ int32_t voxel_object_world_add_box(VoxelObjectWorld *world, Vec3 position,
 
     obj->voxel_revision = 1;
 
-    voxel_object_recalc_shape(obj);
+    voxel_object_recalc_shape(world, slot);
     return slot;
 }
 
@@ -584,7 +585,7 @@ int32_t voxel_object_world_add_from_voxels(VoxelObjectWorld *world,
     obj->voxel_size = voxel_size;
     obj->voxel_count = 0;
     obj->active = true;
-    obj->orientation = quat_identity();
+    voxel_object_set_orientation(world, slot, quat_identity());
 
     int32_t offset_x = (VOBJ_GRID_SIZE - size_x) / 2;
     int32_t offset_y = (VOBJ_GRID_SIZE - size_y) / 2;
@@ -624,12 +625,135 @@ int32_t voxel_object_world_add_from_voxels(VoxelObjectWorld *world,
     float src_center_y = origin.y + (float)size_y * voxel_size * 0.5f;
     float src_center_z = origin.z + (float)size_z * voxel_size * 0.5f;
 
-    obj->position = vec3_create(src_center_x, src_center_y, src_center_z);
+    voxel_object_set_position(world, slot, vec3_create(src_center_x, src_center_y, src_center_z));
 
-    voxel_object_recalc_shape(obj);
+    voxel_object_recalc_shape(world, slot);
     return slot;
 }
 
+int32_t voxel_object_stamp_volume(const VoxelObject *obj, VoxelObjectPose pose, VoxelVolume *vol, bool write,
+                                  int32_t *out_chunks)
+{
+    if (out_chunks)
+        *out_chunks = 0;
+    if (!obj || !vol || !obj->active || obj->voxel_count <= 0)
+        return 0;
+
+    /* Grid bounds of the solid voxels */
+    int32_t solid_min[3] = {VOBJ_GRID_SIZE, VOBJ_GRID_SIZE, VOBJ_GRID_SIZE};
+    int32_t solid_max[3] = {-1, -1, -1};
+    for (int32_t i = 0; i < VOBJ_TOTAL_VOXELS; i++)
+    {
+        if (obj->voxels[i].material == 0)
+            continue;
+        int32_t c[3];
+        vobj_coords(i, &c[0], &c[1], &c[2]);
+        for (int32_t a = 0; a < 3; a++)
+        {
+            if (c[a] < solid_min[a])
+                solid_min[a] = c[a];
+            if (c[a] > solid_max[a])
+                solid_max[a] = c[a];
+        }
+    }
+    if (solid_max[0] < 0)
+        return 0;
+
+    float half_grid = (float)VOBJ_GRID_SIZE * obj->voxel_size * 0.5f;
+    float rot[9], inv_rot[9];
+    quat_to_mat3(pose.orientation, rot);
+    mat3_transpose(rot, inv_rot);
+
+    /* Volume voxel range covering the rotated solid box */
+    float lo[3] = {1e30f, 1e30f, 1e30f};
+    float hi[3] = {-1e30f, -1e30f, -1e30f};
+    for (int32_t corner = 0; corner < 8; corner++)
+    {
+        Vec3 local = vec3_create((float)((corner & 1) ? solid_max[0] + 1 : solid_min[0]) * obj->voxel_size - half_grid,
+                                 (float)((corner & 2) ? solid_max[1] + 1 : solid_min[1]) * obj->voxel_size - half_grid,
+                                 (float)((corner & 4) ? solid_max[2] + 1 : solid_min[2]) * obj->voxel_size - half_grid);
+        Vec3 world = vec3_add(pose.position, mat3_transform_vec3(rot, local));
+        float w[3] = {world.x, world.y, world.z};
+        for (int32_t a = 0; a < 3; a++)
+        {
+            if (w[a] < lo[a])
+                lo[a] = w[a];
+            if (w[a] > hi[a])
+                hi[a] = w[a];
+        }
+    }
+
+    const float vol_min[3] = {vol->bounds.min_x, vol->bounds.min_y, vol->bounds.min_z};
+    const int32_t vol_size[3] = {vol->chunks_x * CHUNK_SIZE, vol->chunks_y * CHUNK_SIZE, vol->chunks_z * CHUNK_SIZE};
+    int32_t g0[3], g1[3];
+    for (int32_t a = 0; a < 3; a++)
+    {
+        g0[a] = (int32_t)floorf((lo[a] - vol_min[a]) / vol->voxel_size);
+        g1[a] = (int32_t)floorf((hi[a] - vol_min[a]) / vol->voxel_size);
+        if (g0[a] < 0)
+            g0[a] = 0;
+        if (g1[a] >= vol_size[a])
+            g1[a] = vol_size[a] - 1;
+        if (g0[a] > g1[a])
+            return 0;
+    }
+    if (out_chunks)
+    {
+        *out_chunks = (g1[0] / CHUNK_SIZE - g0[0] / CHUNK_SIZE + 1) *
+                      (g1[1] / CHUNK_SIZE - g0[1] / CHUNK_SIZE + 1) *
+                      (g1[2] / CHUNK_SIZE - g0[2] / CHUNK_SIZE + 1);
+    }
+
+    /* Centre, then eight points inset 0.35 voxel from the corners */
+    static const float sample_offsets[9][3] = {
+        {0.0f, 0.0f, 0.0f},
+        {-0.35f, -0.35f, -0.35f}, {0.35f, -0.35f, -0.35f}, {-0.35f, 0.35f, -0.35f}, {0.35f, 0.35f, -0.35f},
+        {-0.35f, -0.35f, 0.35f}, {0.35f, -0.35f, 0.35f}, {-0.35f, 0.35f, 0.35f}, {0.35f, 0.35f, 0.35f}};
+
+    float inv_voxel = 1.0f / obj->voxel_size;
+    int32_t written = 0;
+    for (int32_t gz = g0[2]; gz <= g1[2]; gz++)
+    {
+        for (int32_t gy = g0[1]; gy <= g1[1]; gy++)
+        {
+            for (int32_t gx = g0[0]; gx <= g1[0]; gx++)
+            {
+                Chunk *chunk = volume_get_chunk(vol, gx / CHUNK_SIZE, gy / CHUNK_SIZE, gz / CHUNK_SIZE);
+                if (!chunk || chunk_get(chunk, gx % CHUNK_SIZE, gy % CHUNK_SIZE, gz % CHUNK_SIZE) != 0)
+                    continue;
+
+                Vec3 center = vec3_create(vol_min[0] + ((float)gx + 0.5f) * vol->voxel_size,
+                                          vol_min[1] + ((float)gy + 0.5f) * vol->voxel_size,
+                                          vol_min[2] + ((float)gz + 0.5f) * vol->voxel_size);
+                uint8_t mat = 0;
+                for (int32_t s = 0; s < 9 && mat == 0; s++)
+                {
+                    Vec3 sample = vec3_create(center.x + sample_offsets[s][0] * vol->voxel_size,
+                                              center.y + sample_offsets[s][1] * vol->voxel_size,
+                                              center.z + sample_offsets[s][2] * vol->voxel_size);
+                    Vec3 local = mat3_transform_vec3(inv_rot, vec3_sub(sample, pose.position));
+                    float fx = (local.x + half_grid) * inv_voxel;
+                    float fy = (local.y + half_grid) * inv_voxel;
+                    float fz = (local.z + half_grid) * inv_voxel;
+                    if (fx < 0.0f || fy < 0.0f || fz < 0.0f)
+                        continue;
+                    int32_t ox = (int32_t)fx, oy = (int32_t)fy, oz = (int32_t)fz;
+                    if (ox >= VOBJ_GRID_SIZE || oy >= VOBJ_GRID_SIZE || oz >= VOBJ_GRID_SIZE)
+                        continue;
+                    mat = obj->voxels[vobj_index(ox, oy, oz)].material;
+                }
+                if (mat == 0)
+                    continue;
+
+                if (write)
+                    volume_edit_set(vol, center, mat);
+                written++;
+            }
+        }
+    }
+    return written;
+}
+
 VoxelObjectHit voxel_object_world_raycast(VoxelObjectWorld *world, Vec3 origin, Vec3 dir)
 {
     PROFILE_BEGIN(PROFILE_VOXEL_RAYCAST);
@@ -659,7 +783,7 @@ VoxelObjectHit voxel_object_world_raycast(VoxelObjectWorld *world, Vec3 origin,
         if (!obj->active || obj->voxel_count == 0)
             continue;
 
-        Vec3 pivot = obj->position;
+        Vec3 pivot = voxel_object_position(world, i);
         Vec3 oc = vec3_sub(origin, pivot);
         float a = vec3_dot(dir, dir);
         float b = 2.0f * vec3_dot(oc, dir);
@@ -682,7 +806,7 @@ VoxelObjectHit voxel_object_world_raycast(VoxelObjectWorld *world, Vec3 origin,
             continue;
 
         float rot_mat[9], inv_rot_mat[9];
-        quat_to_mat3(obj->orientation, rot_mat);
+        quat_to_mat3(voxel_object_orientation(world, i), rot_mat);
         mat3_transpose(rot_mat, inv_rot_mat);
 
         Vec3 local_origin = mat3_transform_vec3(inv_rot_mat, vec3_sub(origin, pivot));
@@ -803,12 +927,12 @@ VoxelObjectPointTest voxel_object_world_test_point(const VoxelObjectWorld *world
         if (!obj->active || obj->voxel_count == 0)
             continue;
 
-        Vec3 to_obj = vec3_sub(world_pos, obj->position);
+        Vec3 to_obj = vec3_sub(world_pos, voxel_object_position(world, i));
         if (vec3_length_sq(to_obj) > obj->radius * obj->radius)
             continue;
 
         float rot_mat[9], inv_rot_mat[9];
-        quat_to_mat3(obj->orientation, rot_mat);
+        quat_to_mat3(voxel_object_orientation(world, i), rot_mat);
         mat3_transpose(rot_mat, inv_rot_mat);
 
         Vec3 local_pos = mat3_transform_vec3(inv_rot_mat, to_obj);
@@ -870,7 +994,7 @@ void voxel_object_world_update_raycast_grid(VoxelObjectWorld *world)
         VoxelObject *obj = &world->objects[i];
         if (obj->active && obj->voxel_count > 0)
         {
-            spatial_hash_insert(world->raycast_grid, i, obj->position, obj->radius);
+            spatial_hash_insert(world->raycast_grid, i, voxel_object_position(world, i), obj->radius);
         }
     }
 
@@ -920,7 +1044,7 @@ void voxel_object_world_process_recalcs(VoxelObjectWorld *world)
 
         if (obj->active && obj->shape_dirty)
         {
-            voxel_object_recalc_shape(obj);
+            voxel_object_recalc_shape(world, curr_idx);
             obj->next_dirty = -1;
             world->dirty_count--;
 
@@ -1009,13 +1133,26 @@ static void flood_fill_voxels_local(const VoxelObject *obj, uint8_t *visited,
     }
 }
 
+static void note_split_touched(VoxelObjectWorld *world, int32_t obj_index, int32_t source)
+{
+    int32_t capacity = (int32_t)(sizeof(world->split_touched) / sizeof(world->split_touched[0]));
+    if (world->split_touched_count >= capacity)
+        return;
+    world->split_touched[world->split_touched_count] = obj_index;
+    world->split_source[world->split_touched_count] = source;
+    world->split_touched_count++;
+}
+
 static bool split_one_island(VoxelObjectWorld *world, int32_t obj_index)
 {
     if (obj_index < 0 || obj_index >= world->object_count)
         return false;
 
     VoxelObject *obj = &world->objects[obj_index];
-    if (!obj->active || obj->voxel_count <= 1)
+    if (!obj->active)
+        return false;
+    note_split_touched(world, obj_index, obj_index);
+    if (obj->voxel_count <= 1)
         return false;
 
     uint8_t visited[VOBJ_TOTAL_VOXELS] = {0};
@@ -1050,8 +1187,7 @@ static bool split_one_island(VoxelObjectWorld *world, int32_t obj_index)
 
     VoxelObject *new_obj = &world->objects[new_obj_idx];
     memset(new_obj, 0, sizeof(VoxelObject));
-    new_obj->position = obj->position;
-    new_obj->orientation = obj->orientation;
+    voxel_object_set_pose(world, new_obj_idx, voxel_object_pose(world, obj_index));
     new_obj->voxel_size = obj->voxel_size;
     new_obj->active = true;
     new_obj->voxel_count = 0;
@@ -1070,8 +1206,9 @@ static bool split_one_island(VoxelObjectWorld *world, int32_t obj_index)
     obj->voxel_revision++;
     new_obj->voxel_revision = 1;
 
-    voxel_object_recalc_shape(new_obj);
-    voxel_object_recalc_shape(obj);
+    voxel_object_recalc_shape(world, new_obj_idx);
+    voxel_object_recalc_shape(world, obj_index);
+    note_split_touched(world, new_obj_idx, obj_index);
 
     /* Queue both for further splitting */
     voxel_object_world_queue_split(world, obj_index);
@@ -1087,6 +1224,8 @@ void voxel_object_world_process_splits(VoxelObjectWorld *world)
 
     PROFILE_BEGIN(PROFILE_SIM_VOXEL_UPDATE);
 
+    world->split_touched_count = 0;
+
     int32_t processed = 0;
     while (world->split_queue_head != world->split_queue_tail &&
            processed < VOBJ_MAX_SPLITS_PER_TICK)
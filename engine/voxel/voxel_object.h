@@ -42,11 +42,12 @@ extern "C"
         uint8_t material;
     } VObjVoxel;
 
+    /*
+     * An object's pose lives in its world's pose arrays, not in the object:
+     * see voxel_object_pose() and friends below.
+     */
     typedef struct VoxelObject
     {
-        Vec3 position;
-        Quat orientation;
-
         VObjVoxel voxels[VOBJ_TOTAL_VOXELS];
         float voxel_size;
         int32_t voxel_count;
@@ -72,6 +73,30 @@ extern "C"
         int32_t next_dirty;     /* Dirty-list chain (-1 = end or not dirty) */
     } VoxelObject;
 
+    /* Where an object is: its grid center in world space, and its rotation */
+    typedef struct
+    {
+        Vec3 position;
+        Quat orientation;
+    } VoxelObjectPose;
+
+    /*
+     * Object poses, structure-of-arrays: object i is slot i of every array.
+     * Poses are the part of an object the simulation rewrites every tick;
+     * kept apart from the ~40 KB objects, physics integrates them in SIMD
+     * lanes and the renderer streams them without touching voxel data.
+     */
+    typedef struct
+    {
+        float px[VOBJ_MAX_OBJECTS];
+        float py[VOBJ_MAX_OBJECTS];
+        float pz[VOBJ_MAX_OBJECTS];
+        float qx[VOBJ_MAX_OBJECTS];
+        float qy[VOBJ_MAX_OBJECTS];
+        float qz[VOBJ_MAX_OBJECTS];
+        float qw[VOBJ_MAX_OBJECTS];
+    } VoxelObjectPoses;
+
 #define VOBJ_SPLIT_QUEUE_SIZE 256
 #define VOBJ_MAX_SPLITS_PER_TICK 4
 #define VOBJ_MAX_RECALCS_PER_TICK 8
@@ -79,6 +104,7 @@ extern "C"
     typedef struct VoxelObjectWorld
     {
         VoxelObject objects[VOBJ_MAX_OBJECTS];
+        VoxelObjectPoses poses;
         int32_t object_count;
 
         Bounds3D bounds;
@@ -98,6 +124,12 @@ extern "C"
         int32_t split_queue_head;
         int32_t split_queue_tail;
 
+        /* Objects the last process_splits call checked or created, each with
+         * the object whose motion it shares (itself, or the one it split from) */
+        int32_t split_touched[VOBJ_SPLIT_QUEUE_SIZE + VOBJ_MAX_SPLITS_PER_TICK];
+        int32_t split_source[VOBJ_SPLIT_QUEUE_SIZE + VOBJ_MAX_SPLITS_PER_TICK];
+        int32_t split_touched_count;
+
         /* Spatial hash for raycast acceleration (legacy) */
         SpatialHashGrid *raycast_grid;
         bool raycast_grid_valid;
@@ -128,6 +160,47 @@ extern "C"
         *z = idx / (VOBJ_GRID_SIZE * VOBJ_GRID_SIZE);
     }
 
+    static inline Vec3 voxel_object_position(const VoxelObjectWorld *world, int32_t obj_index)
+    {
+        const VoxelObjectPoses *p = &world->poses;
+        return vec3_create(p->px[obj_index], p->py[obj_index], p->pz[obj_index]);
+    }
+
+    static inline Quat voxel_object_orientation(const VoxelObjectWorld *world, int32_t obj_index)
+    {
+        const VoxelObjectPoses *p = &world->poses;
+        return quat_create(p->qx[obj_index], p->qy[obj_index], p->qz[obj_index], p->qw[obj_index]);
+    }
+
+    static inline VoxelObjectPose voxel_object_pose(const VoxelObjectWorld *world, int32_t obj_index)
+    {
+        VoxelObjectPose pose = {voxel_object_position(world, obj_index), voxel_object_orientation(world, obj_index)};
+        return pose;
+    }
+
+    static inline void voxel_object_set_position(VoxelObjectWorld *world, int32_t obj_index, Vec3 position)
+    {
+        VoxelObjectPoses *p = &world->poses;
+        p->px[obj_index] = position.x;
+        p->py[obj_index] = position.y;
+        p->pz[obj_index] = position.z;
+    }
+
+    static inline void voxel_object_set_orientation(VoxelObjectWorld *world, int32_t obj_index, Quat orientation)
+    {
+        VoxelObjectPoses *p = &world->poses;
+        p->qx[obj_index] = orientation.x;
+        p->qy[obj_index] = orientation.y;
+        p->qz[obj_index] = orientation.z;
+        p->qw[obj_index] = orientation.w;
+    }
+
+    static inline void voxel_object_set_pose(VoxelObjectWorld *world, int32_t obj_index, VoxelObjectPose pose)
+    {
+        voxel_object_set_position(world, obj_index, pose.position);
+        voxel_object_set_orientation(world, obj_index, pose.orientation);
+    }
+
     VoxelObjectWorld *voxel_object_world_create(Bounds3D bounds, float voxel_size);
     void voxel_object_world_destroy(VoxelObjectWorld *world);
 
@@ -153,13 +226,27 @@ extern "C"
 
     VoxelObjectPointTest voxel_object_world_test_point(const VoxelObjectWorld *world, Vec3 world_pos);
 
-    void voxel_object_recalc_shape(VoxelObject *obj);
+    /* Recomputes shape data after voxel edits; recentering the grid moves the pose */
+    void voxel_object_recalc_shape(VoxelObjectWorld *world, int32_t obj_index);
     void voxel_object_mark_dirty(VoxelObject *obj);
     void voxel_object_world_mark_dirty(VoxelObjectWorld *world, int32_t obj_index);
     void voxel_object_world_free_slot(VoxelObjectWorld *world, int32_t slot);
 
     int32_t voxel_object_world_alloc_slot(VoxelObjectWorld *world);
 
+    /*
+     * Rasterizes an object into a volume at its current pose, through the
+     * volume's open edit batch. Only empty volume voxels are written. A voxel
+     * is filled when its centre, or one of eight points inset towards its
+     * corners, lies in a solid object voxel, whose material it takes (the
+     * centre's first), so rotated thin parts keep their voxels. With write
+     * false nothing changes and the voxels are only counted. Returns the
+     * voxels written; out_chunks (optional) receives the number of chunks
+     * the stamp can touch.
+     */
+    int32_t voxel_object_stamp_volume(const VoxelObject *obj, VoxelObjectPose pose, VoxelVolume *vol, bool write,
+                                      int32_t *out_chunks);
+
     /* Per-frame deferred processing */
     void voxel_object_world_process_splits(VoxelObjectWorld *world);
     void voxel_object_world_process_recalcs(VoxelObjectWorld *world);
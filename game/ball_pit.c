@@ -6,6 +6,7 @@
 #include "engine/core/rng.h"
 #include "engine/sim/detach.h"
 #include "engine/physics/collision_object.h"
+#include "engine/physics/island.h"
 #include "content/voxel_shapes.h"
 #include "content/materials.h"
 #include "content/scenes.h"
@@ -153,27 +154,72 @@ static void ball_pit_init(Scene *scene)
 
     const SceneDescriptor *desc = scene_get_descriptor(SCENE_TYPE_BALL_PIT);
 
-    Vec3 origin = vec3_create(scene->bounds.min_x, scene->bounds.min_y, scene->bounds.min_z);
-    data->terrain = volume_create_dims(desc->chunks_x, desc->chunks_y, desc->chunks_z,
-                                       origin, data->voxel_size);
-
-    terrain_gen_heightmap(data->terrain, data->voxel_size,
-                          p->terrain_amplitude, p->terrain_frequency, desc->rng_seed);
-    terrain_gen_pillars(data->terrain, data->voxel_size,
-                        p->num_pillars, p->terrain_amplitude, p->terrain_frequency, desc->rng_seed);
+    /* Optional startup snapshot: adopt mapped terrain instead of regenerating */
+    const char *snapshot_path = getenv("PATCH_SCENE_SNAPSHOT");
+    if (snapshot_path)
+    {
+        data->snapshot = snapshot_open(snapshot_path);
+        if (data->snapshot)
+        {
+            data->terrain = snapshot_load_volume(data->snapshot);
+            if (!data->terrain)
+            {
+                snapshot_close(data->snapshot);
+                data->snapshot = NULL;
+            }
+        }
+    }
 
-    volume_rebuild_all_occupancy(data->terrain);
+    bool from_snapshot = data->terrain != NULL;
+    if (!from_snapshot)
+    {
+        Vec3 origin = vec3_create(scene->bounds.min_x, scene->bounds.min_y, scene->bounds.min_z);
+        data->terrain = volume_create_dims(desc->chunks_x * SCENE_CHUNK_VOXELS / CHUNK_SIZE,
+                                           desc->chunks_y * SCENE_CHUNK_VOXELS / CHUNK_SIZE,
+                                           desc->chunks_z * SCENE_CHUNK_VOXELS / CHUNK_SIZE,
+                                           origin, data->voxel_size);
+
+        terrain_gen_heightmap(data->terrain, data->voxel_size,
+                              p->terrain_amplitude, p->terrain_frequency, desc->rng_seed);
+        terrain_gen_pillars(data->terrain, data->voxel_size,
+                            p->num_pillars, p->terrain_amplitude, p->terrain_frequency, desc->rng_seed);
+
+        volume_rebuild_all_occupancy(data->terrain);
+    }
 
     data->detach_ready = connectivity_work_init(&data->detach_work, data->terrain);
 
     data->objects = voxel_object_world_create(scene->bounds, data->voxel_size);
     voxel_object_world_set_terrain(data->objects, data->terrain);
 
-    spawn_gary_on_terrain(data->objects, scene->bounds,
-                          p->terrain_amplitude, p->terrain_frequency, desc->rng_seed);
+    if (from_snapshot)
+        snapshot_load_objects(data->snapshot, data->objects);
+    else
+        spawn_gary_on_terrain(data->objects, scene->bounds,
+                              p->terrain_amplitude, p->terrain_frequency, desc->rng_seed);
 
     data->particles = particle_system_create(scene->bounds);
     data->physics = physics_world_create(data->objects, data->terrain);
+    physics_world_set_worker_count(data->physics, PHYS_DEFAULT_WORKERS);
+
+    physics_lod_init(&data->sim_lod);
+    physics_world_set_lod(data->physics, &data->sim_lod);
+    if (data->particles)
+    {
+        particle_system_set_lod(data->particles, &data->sim_lod);
+        particle_system_set_workers(data->particles, data->physics ? data->physics->workers : NULL);
+    }
+
+    debris_lod_init(&data->debris_lod, data->particles, &scene->rng);
+    data->debris_lod.max_voxels = p->debris_max_voxels;
+    data->debris_lod.max_bodies = detach_config_default().max_bodies_alive;
+    physics_freeze_init(&data->freeze);
+    data->freeze.rest_ticks = p->freeze_rest_ticks;
+
+    if (from_snapshot)
+        snapshot_load_physics(data->snapshot, data->physics);
+    else if (snapshot_path)
+        snapshot_save(snapshot_path, data->terrain, data->objects, data->physics);
 
     int32_t spawn_target = p->initial_spawns;
     const char *stress_env = getenv("PATCH_STRESS_OBJECTS");
@@ -209,6 +255,10 @@ static void ball_pit_destroy_impl(Scene *scene)
     if (data->terrain)
         volume_destroy(data->terrain);
 
+    /* Mapping backs adopted terrain chunks: close only after the volume is gone */
+    if (data->snapshot)
+        snapshot_close(data->snapshot);
+
     free(data);
     free(scene);
 }
@@ -238,14 +288,21 @@ static void ball_pit_tick(Scene *scene)
         PROFILE_END(PROFILE_PROP_SPAWN);
     }
 
+    /* The ray starts at the camera */
+    physics_lod_set_focus(&data->sim_lod, &data->ray_origin, 1);
+
     PROFILE_BEGIN(PROFILE_SIM_PARTICLES);
     particle_system_update(data->particles, dt, data->terrain, data->objects);
+    if (p->particle_deposit_ticks > 0)
+        particle_system_deposit_settled(data->particles, data->terrain, p->particle_deposit_ticks, MAT_DIRT);
     PROFILE_END(PROFILE_SIM_PARTICLES);
 
     /* Process deferred voxel object work (budgeted per-frame) */
     if (data->objects)
     {
         voxel_object_world_process_splits(data->objects);
+        if (p->debris_max_voxels > 0)
+            debris_lod_process_splits(&data->debris_lod, data->objects, data->physics);
         voxel_object_world_process_recalcs(data->objects);
         voxel_object_world_tick_render_delays(data->objects);
         voxel_object_world_update_raycast_grid(data->objects);
@@ -255,6 +312,8 @@ static void ball_pit_tick(Scene *scene)
     {
         physics_world_sync_objects(data->physics);
         physics_world_step(data->physics, dt);
+        if (p->freeze_rest_ticks > 0)
+            physics_freeze_resting(&data->freeze, data->physics);
     }
 
     PlatformTime t1 = platform_time_now();
@@ -346,9 +405,10 @@ static void ball_pit_handle_input(Scene *scene, float mouse_x, float mouse_y, bo
                 Vec3 velocity = vec3_scale(dir, speed);
                 velocity.y += 1.0f;
 
-                particle_system_add(data->particles, &scene->rng,
-                                    destroyed_positions[i], velocity, color,
-                                    voxel_size * 0.4f);
+                int32_t slot = particle_system_add(data->particles, &scene->rng,
+                                                   destroyed_positions[i], velocity, color,
+                                                   voxel_size * 0.4f);
+                data->particles->material[slot] = destroyed_materials[i];
             }
 #undef MAX_DESTROYED
         }
@@ -360,6 +420,7 @@ static void ball_pit_handle_input(Scene *scene, float mouse_x, float mouse_y, bo
 #define MAX_TERRAIN_DESTROYED 64
             Vec3 destroyed_positions[MAX_TERRAIN_DESTROYED];
             Vec3 destroyed_colors[MAX_TERRAIN_DESTROYED];
+            uint8_t destroyed_materials[MAX_TERRAIN_DESTROYED];
             int32_t destroyed_count = 0;
 
             volume_edit_begin(data->terrain);
@@ -384,6 +445,7 @@ static void ball_pit_handle_input(Scene *scene, float mouse_x, float mouse_y, bo
                                 {
                                     destroyed_positions[destroyed_count] = pos;
                                     destroyed_colors[destroyed_count] = material_get_color(mat);
+                                    destroyed_materials[destroyed_count] = mat;
                                     destroyed_count++;
                                 }
                             }
@@ -409,9 +471,10 @@ static void ball_pit_handle_input(Scene *scene, float mouse_x, float mouse_y, bo
                 Vec3 velocity = vec3_scale(dir, speed);
                 velocity.y += 1.0f;
 
-                particle_system_add(data->particles, &scene->rng,
-                                    destroyed_positions[i], velocity, destroyed_colors[i],
-                                    data->terrain->voxel_size * 0.4f);
+                int32_t slot = particle_system_add(data->particles, &scene->rng,
+                                                   destroyed_positions[i], velocity, destroyed_colors[i],
+                                                   data->terrain->voxel_size * 0.4f);
+                data->particles->material[slot] = destroyed_materials[i];
             }
 #undef MAX_TERRAIN_DESTROYED
 
@@ -436,6 +499,11 @@ static void ball_pit_handle_input(Scene *scene, float mouse_x, float mouse_y, bo
             if (cooldown_ok)
             {
                 DetachConfig cfg = detach_config_default();
+                if (data->params.debris_max_voxels > 0)
+                {
+                    cfg.debris_fn = debris_lod_take_island;
+                    cfg.debris_user = &data->debris_lod;
+                }
                 DetachResult detach_result;
                 detach_terrain_process(data->terrain, data->objects, &cfg, &data->detach_work, &detach_result);
 
@@ -459,7 +527,7 @@ static void ball_pit_handle_input(Scene *scene, float mouse_x, float mouse_y, bo
                         if (body_idx < 0)
                             continue;
 
-                        Vec3 dir = vec3_sub(obj->position, data->last_destroy_point);
+                        Vec3 dir = vec3_sub(voxel_object_position(data->objects, obj_idx), data->last_destroy_point);
                         float dist = vec3_length(dir);
                         if (dist > 0.001f)
                             dir = vec3_scale(dir, 1.0f / dist);
@@ -474,7 +542,7 @@ static void ball_pit_handle_input(Scene *scene, float mouse_x, float mouse_y, bo
                         RigidBody *body = physics_world_get_body(data->physics, body_idx);
                         if (body)
                         {
-                            body->flags &= ~PHYS_FLAG_GROUNDED;
+                            data->physics->flags[body_idx] &= ~PHYS_FLAG_GROUNDED;
                             body->ground_frames = 0;
                         }
                     }
@@ -511,6 +579,9 @@ BallPitParams ball_pit_default_params(void)
     p.num_pillars = 60;
     p.terrain_amplitude = 3.0f;
     p.terrain_frequency = 0.1f;
+    p.particle_deposit_ticks = 0; /* Settled debris stays pickable */
+    p.debris_max_voxels = DEBRIS_LOD_MAX_VOXELS;
+    p.freeze_rest_ticks = PHYS_FREEZE_REST_TICKS;
     return p;
 }
 
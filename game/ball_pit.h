@@ -2,11 +2,15 @@
 #define PATCH_SCENES_BALL_PIT_H
 
 #include "engine/sim/scene.h"
+#include "engine/sim/snapshot.h"
 #include "engine/voxel/volume.h"
 #include "engine/voxel/connectivity.h"
 #include "engine/voxel/voxel_object.h"
 #include "engine/physics/particles.h"
 #include "engine/physics/rigidbody.h"
+#include "engine/physics/sim_lod.h"
+#include "engine/physics/debris_lod.h"
+#include "engine/physics/body_freeze.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -22,6 +26,9 @@ extern "C"
         int32_t num_pillars;
         float terrain_amplitude;
         float terrain_frequency;
+        uint32_t particle_deposit_ticks; /* Settled updates before debris joins the terrain, 0 = never */
+        int32_t debris_max_voxels;       /* Fragments up to this size become particles, 0 = always objects */
+        int32_t freeze_rest_ticks;       /* Steps asleep on the terrain before an object rejoins it, 0 = never */
     } BallPitParams;
 
     typedef struct
@@ -46,6 +53,12 @@ extern "C"
         VoxelObjectWorld *objects;
         ParticleSystem *particles;
         PhysicsWorld *physics;
+        PhysicsSimLod sim_lod; /* Update rates by distance from the camera */
+        DebrisLod debris_lod;  /* Small fragments as particles instead of objects */
+        PhysicsFreeze freeze;  /* Resting objects back into the terrain */
+
+        /* Mapped startup snapshot backing terrain chunks (NULL if generated) */
+        SceneSnapshot *snapshot;
 
         /* Terrain detachment (floating islands -> voxel objects) */
         ConnectivityWorkBuffer detach_work;
@@ -33,7 +33,7 @@ uvec2 terrain_get_level0(int chunk_idx) {
     return chunk_headers[chunk_idx].xy;
 }
 
-/* Check if 8x8x8 region is occupied (level 1 hierarchy) */
+/* Check if REGION_SIZE³ region is occupied (level 1 hierarchy) */
 bool sample_occupancy_region(int chunk_idx, ivec3 region) {
     uvec2 level0 = terrain_get_level0(chunk_idx);
     int bit = region.x + region.y * 4 + region.z * 16;
@@ -59,7 +59,8 @@ uint sample_material(ivec3 p) {
     ivec3 local = p - chunk_pos * CHUNK_SIZE;
     int local_idx = local.x + local.y * CHUNK_SIZE + local.z * CHUNK_SIZE * CHUNK_SIZE;
 
-    int chunk_data_offset = chunk_idx * CHUNK_UINT_COUNT;
+    /* Voxel data is stored by ring slot; the header maps logical -> slot */
+    int chunk_data_offset = int(chunk_headers[chunk_idx].w) * CHUNK_UINT_COUNT;
     int uint_idx = local_idx / 4;
     int byte_idx = local_idx % 4;
 
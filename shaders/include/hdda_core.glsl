@@ -173,7 +173,7 @@ HitInfo hdda_march_terrain(
             continue;
         }
 
-        /* Level 1: Region occupancy check (8x8x8 regions) */
+        /* Level 1: Region occupancy check (REGION_SIZE³ regions) */
         ivec3 local_pos = dda.map_pos - current_chunk * CHUNK_SIZE;
         ivec3 current_region = hdda_region_coord(local_pos);
         if (current_region != last_region) {
@@ -31,9 +31,14 @@ struct DDAState {
     bvec3 last_mask;    /* Which axis was stepped last (for normal) */
 };
 
-const int CHUNK_SIZE = 32;          /* Voxels per chunk dimension */
-const int REGION_SIZE = 8;          /* Voxels per region dimension (8x8x8) */
-const int REGIONS_PER_CHUNK = 4;    /* Regions per chunk dimension (4x4x4 = 64 regions) */
-const int CHUNK_UINT_COUNT = 8192;  /* uint32s per chunk for voxel data (32768 voxels / 4) */
+/* Must match engine/voxel/chunk.h; the build passes -DCHUNK_SIZE_BITS=N to glslc */
+#ifndef CHUNK_SIZE_BITS
+#define CHUNK_SIZE_BITS 5
+#endif
+
+const int CHUNK_SIZE = 1 << CHUNK_SIZE_BITS;                          /* Voxels per chunk dimension */
+const int REGION_SIZE = CHUNK_SIZE / 4;                               /* Voxels per region dimension */
+const int REGIONS_PER_CHUNK = 4;                                      /* Regions per chunk dimension (4x4x4 = 64 regions) */
+const int CHUNK_UINT_COUNT = (CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE) / 4; /* uint32s per chunk for voxel data */
 
 #endif /* HDDA_TYPES_GLSL */
@@ -0,0 +1,474 @@
+#include "engine/core/types.h"
+#include "engine/core/math.h"
+#include "engine/core/rng.h"
+#include "engine/voxel/volume.h"
+#include "engine/voxel/connectivity.h"
+#include "engine/render/gpu_volume.h"
+#include "engine/platform/platform.h"
+#include "content/materials.h"
+#include "test_common.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*
+ * Chunk voxel layout tests and benchmarks.
+ * CHUNK_LAYOUT is compile-time, so the benchmark instantiates the same
+ * raycast / flood fill / sphere fill kernels once per index function over a
+ * raw 4x4x4-chunk grid. Results must match exactly; timings are printed.
+ */
+
+#define LB_CHUNKS_AXIS 4
+#define LB_VOXELS_AXIS (LB_CHUNKS_AXIS * CHUNK_SIZE)
+#define LB_TOTAL_VOXELS (LB_CHUNKS_AXIS * LB_CHUNKS_AXIS * LB_CHUNKS_AXIS * CHUNK_VOXEL_COUNT)
+#define LB_SPHERE_COUNT 600
+#define LB_RAY_COUNT 8192
+#define LB_RAY_MAX_STEPS 512
+#define LB_ITERATIONS 4
+
+typedef struct
+{
+    int32_t cx, cy, cz;
+    int32_t radius;
+    uint8_t material;
+} LayoutSphere;
+
+typedef struct
+{
+    float ox, oy, oz;
+    float dx, dy, dz;
+} LayoutRay;
+
+typedef struct
+{
+    int64_t filled;
+    uint64_t hash;
+    int32_t flood_count;
+    int64_t ray_steps;
+    float fill_ms;
+    float flood_ms;
+    float raycast_ms;
+} LayoutBenchResult;
+
+static inline bool lb_in_grid(int32_t x, int32_t y, int32_t z)
+{
+    return x >= 0 && x < LB_VOXELS_AXIS && y >= 0 && y < LB_VOXELS_AXIS && z >= 0 && z < LB_VOXELS_AXIS;
+}
+
+/* Defines lb_<kernel>_<NAME> using IDX(x, y, z) for the in-chunk index */
+#define DEFINE_LAYOUT_KERNELS(NAME, IDX)                                                              \
+    static inline int32_t lb_index_##NAME(int32_t x, int32_t y, int32_t z)                            \
+    {                                                                                                 \
+        int32_t chunk = (x >> CHUNK_SIZE_BITS) + (y >> CHUNK_SIZE_BITS) * LB_CHUNKS_AXIS +            \
+                        (z >> CHUNK_SIZE_BITS) * LB_CHUNKS_AXIS * LB_CHUNKS_AXIS;                     \
+        return chunk * CHUNK_VOXEL_COUNT + IDX(x & CHUNK_SIZE_MASK, y & CHUNK_SIZE_MASK,              \
+                                               z & CHUNK_SIZE_MASK);                                  \
+    }                                                                                                 \
+                                                                                                      \
+    static int64_t lb_sphere_fill_##NAME(uint8_t *grid, const LayoutSphere *spheres, int32_t count)   \
+    {                                                                                                 \
+        int64_t modified = 0;                                                                         \
+        for (int32_t s = 0; s < count; s++)                                                           \
+        {                                                                                             \
+            const LayoutSphere *sp = &spheres[s];                                                     \
+            int32_t r2 = sp->radius * sp->radius;                                                     \
+            for (int32_t z = sp->cz - sp->radius; z <= sp->cz + sp->radius; z++)                      \
+                for (int32_t y = sp->cy - sp->radius; y <= sp->cy + sp->radius; y++)                  \
+                    for (int32_t x = sp->cx - sp->radius; x <= sp->cx + sp->radius; x++)              \
+                    {                                                                                 \
+                        int32_t dx = x - sp->cx, dy = y - sp->cy, dz = z - sp->cz;                    \
+                        if (!lb_in_grid(x, y, z) || dx * dx + dy * dy + dz * dz > r2)                 \
+                            continue;                                                                 \
+                        int32_t i = lb_index_##NAME(x, y, z);                                         \
+                        if (grid[i] != sp->material)                                                  \
+                        {                                                                             \
+                            grid[i] = sp->material;                                                   \
+                            modified++;                                                               \
+                        }                                                                             \
+                    }                                                                                 \
+        }                                                                                             \
+        return modified;                                                                              \
+    }                                                                                                 \
+                                                                                                      \
+    static uint64_t lb_hash_##NAME(const uint8_t *grid)                                               \
+    {                                                                                                 \
+        uint64_t h = 1469598103934665603ull;                                                          \
+        for (int32_t z = 0; z < LB_VOXELS_AXIS; z++)                                                  \
+            for (int32_t y = 0; y < LB_VOXELS_AXIS; y++)                                              \
+                for (int32_t x = 0; x < LB_VOXELS_AXIS; x++)                                          \
+                    h = (h ^ grid[lb_index_##NAME(x, y, z)]) * 1099511628211ull;                      \
+        return h;                                                                                     \
+    }                                                                                                 \
+                                                                                                      \
+    static int32_t lb_flood_fill_##NAME(const uint8_t *grid, uint8_t *visited, int32_t *stack,        \
+                                        int32_t sx, int32_t sy, int32_t sz)                           \
+    {                                                                                                 \
+        static const int32_t ndx[6] = {1, -1, 0, 0, 0, 0};                                            \
+        static const int32_t ndy[6] = {0, 0, 1, -1, 0, 0};                                            \
+        static const int32_t ndz[6] = {0, 0, 0, 0, 1, -1};                                            \
+        int32_t seed = lb_index_##NAME(sx, sy, sz);                                                   \
+        if (grid[seed] == 0)                                                                          \
+            return 0;                                                                                 \
+        int32_t top = 0, count = 0;                                                                   \
+        visited[seed] = 1;                                                                            \
+        stack[top++] = sx | (sy << 10) | (sz << 20);                                                  \
+        while (top > 0)                                                                               \
+        {                                                                                             \
+            int32_t packed = stack[--top];                                                            \
+            int32_t x = packed & 1023, y = (packed >> 10) & 1023, z = packed >> 20;                   \
+            count++;                                                                                  \
+            for (int32_t d = 0; d < 6; d++)                                                           \
+            {                                                                                         \
+                int32_t nx = x + ndx[d], ny = y + ndy[d], nz = z + ndz[d];                            \
+                if (!lb_in_grid(nx, ny, nz))                                                          \
+                    continue;                                                                         \
+                int32_t ni = lb_index_##NAME(nx, ny, nz);                                             \
+                if (grid[ni] == 0 || visited[ni])                                                     \
+                    continue;                                                                         \
+                visited[ni] = 1;                                                                      \
+                stack[top++] = nx | (ny << 10) | (nz << 20);                                          \
+            }                                                                                         \
+        }                                                                                             \
+        return count;                                                                                 \
+    }                                                                                                 \
+                                                                                                      \
+    static int64_t lb_raycast_##NAME(const uint8_t *grid, const LayoutRay *rays, int32_t count)       \
+    {                                                                                                 \
+        int64_t total_steps = 0;                                                                      \
+        for (int32_t r = 0; r < count; r++)                                                           \
+        {                                                                                             \
+            const LayoutRay *ray = &rays[r];                                                          \
+            int32_t vx = (int32_t)floorf(ray->ox), vy = (int32_t)floorf(ray->oy);                     \
+            int32_t vz = (int32_t)floorf(ray->oz);                                                    \
+            int32_t step_x = ray->dx >= 0.0f ? 1 : -1, step_y = ray->dy >= 0.0f ? 1 : -1;             \
+            int32_t step_z = ray->dz >= 0.0f ? 1 : -1;                                                \
+            float delta_x = fabsf(1.0f / ray->dx), delta_y = fabsf(1.0f / ray->dy);                   \
+            float delta_z = fabsf(1.0f / ray->dz);                                                    \
+            float t_x = ((step_x > 0 ? (float)(vx + 1) : (float)vx) - ray->ox) / ray->dx;             \
+            float t_y = ((step_y > 0 ? (float)(vy + 1) : (float)vy) - ray->oy) / ray->dy;             \
+            float t_z = ((step_z > 0 ? (float)(vz + 1) : (float)vz) - ray->oz) / ray->dz;             \
+            int32_t steps = 0;                                                                        \
+            while (steps < LB_RAY_MAX_STEPS && lb_in_grid(vx, vy, vz))                                \
+            {                                                                                         \
+                if (grid[lb_index_##NAME(vx, vy, vz)] != 0)                                           \
+                    break;                                                                            \
+                if (t_x < t_y && t_x < t_z)                                                           \
+                {                                                                                     \
+                    vx += step_x;                                                                     \
+                    t_x += delta_x;                                                                   \
+                }                                                                                     \
+                else if (t_y < t_z)                                                                   \
+                {                                                                                     \
+                    vy += step_y;                                                                     \
+                    t_y += delta_y;                                                                   \
+                }                                                                                     \
+                else                                                                                  \
+                {                                                                                     \
+                    vz += step_z;                                                                     \
+                    t_z += delta_z;                                                                   \
+                }                                                                                     \
+                steps++;                                                                              \
+            }                                                                                         \
+            total_steps += steps;                                                                     \
+        }                                                                                             \
+        return total_steps;                                                                           \
+    }
+
+DEFINE_LAYOUT_KERNELS(linear, chunk_voxel_index_linear)
+DEFINE_LAYOUT_KERNELS(brick, chunk_voxel_index_brick)
+DEFINE_LAYOUT_KERNELS(morton, chunk_voxel_index_morton)
+
+static float lb_elapsed_ms(PlatformTime t0)
+{
+    return platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+}
+
+/* Runs every kernel LB_ITERATIONS times for one layout and keeps the best time */
+#define RUN_LAYOUT_BENCH(NAME, grid, visited, stack, spheres, rays, out)                              \
+    do                                                                                                \
+    {                                                                                                 \
+        (out)->fill_ms = (out)->flood_ms = (out)->raycast_ms = 1e30f;                                 \
+        for (int32_t it = 0; it < LB_ITERATIONS; it++)                                                \
+        {                                                                                             \
+            memset(grid, 0, LB_TOTAL_VOXELS);                                                         \
+            PlatformTime t0 = platform_time_now();                                                    \
+            (out)->filled = lb_sphere_fill_##NAME(grid, spheres, LB_SPHERE_COUNT);                    \
+            float ms = lb_elapsed_ms(t0);                                                             \
+            if (ms < (out)->fill_ms)                                                                  \
+                (out)->fill_ms = ms;                                                                  \
+                                                                                                      \
+            memset(visited, 0, LB_TOTAL_VOXELS);                                                      \
+            t0 = platform_time_now();                                                                 \
+            (out)->flood_count = lb_flood_fill_##NAME(grid, visited, stack, spheres[0].cx,            \
+                                                      spheres[0].cy, spheres[0].cz);                  \
+            ms = lb_elapsed_ms(t0);                                                                   \
+            if (ms < (out)->flood_ms)                                                                 \
+                (out)->flood_ms = ms;                                                                 \
+                                                                                                      \
+            t0 = platform_time_now();                                                                 \
+            (out)->ray_steps = lb_raycast_##NAME(grid, rays, LB_RAY_COUNT);                           \
+            ms = lb_elapsed_ms(t0);                                                                   \
+            if (ms < (out)->raycast_ms)                                                               \
+                (out)->raycast_ms = ms;                                                               \
+        }                                                                                             \
+        (out)->hash = lb_hash_##NAME(grid);                                                           \
+    } while (0)
+
+static bool check_index_bijection(int32_t (*index_fn)(int32_t, int32_t, int32_t))
+{
+    static uint8_t seen[CHUNK_VOXEL_COUNT];
+    memset(seen, 0, sizeof(seen));
+    for (int32_t z = 0; z < CHUNK_SIZE; z++)
+        for (int32_t y = 0; y < CHUNK_SIZE; y++)
+            for (int32_t x = 0; x < CHUNK_SIZE; x++)
+            {
+                int32_t i = index_fn(x, y, z);
+                if (i < 0 || i >= CHUNK_VOXEL_COUNT || seen[i])
+                    return false;
+                seen[i] = 1;
+            }
+    return true;
+}
+
+/* Every occupancy region (one brick) must occupy [base, base + CHUNK_BRICK_VOXELS) */
+static bool check_region_runs(int32_t (*index_fn)(int32_t, int32_t, int32_t))
+{
+    for (int32_t rz = 0; rz < CHUNK_SIZE; rz += CHUNK_BRICK_SIZE)
+        for (int32_t ry = 0; ry < CHUNK_SIZE; ry += CHUNK_BRICK_SIZE)
+            for (int32_t rx = 0; rx < CHUNK_SIZE; rx += CHUNK_BRICK_SIZE)
+            {
+                int32_t base = index_fn(rx, ry, rz);
+                if (base % CHUNK_BRICK_VOXELS != 0)
+                    return false;
+                for (int32_t z = 0; z < CHUNK_BRICK_SIZE; z++)
+                    for (int32_t y = 0; y < CHUNK_BRICK_SIZE; y++)
+                        for (int32_t x = 0; x < CHUNK_BRICK_SIZE; x++)
+                        {
+                            int32_t i = index_fn(rx + x, ry + y, rz + z);
+                            if (i < base || i >= base + CHUNK_BRICK_VOXELS)
+                                return false;
+                        }
+            }
+    return true;
+}
+
+TEST(index_functions_are_bijections)
+{
+    ASSERT(check_index_bijection(chunk_voxel_index_linear));
+    ASSERT(check_index_bijection(chunk_voxel_index_brick));
+    ASSERT(check_index_bijection(chunk_voxel_index_morton));
+    ASSERT(check_index_bijection(chunk_voxel_index));
+    return 1;
+}
+
+TEST(brick_and_morton_regions_contiguous)
+{
+    ASSERT(check_region_runs(chunk_voxel_index_brick));
+    ASSERT(check_region_runs(chunk_voxel_index_morton));
+
+    /* Brick number doubles as the occupancy level0 bit */
+    ASSERT_EQ(chunk_voxel_index_brick(CHUNK_BRICK_SIZE, 2 * CHUNK_BRICK_SIZE, 3 * CHUNK_BRICK_SIZE) / CHUNK_BRICK_VOXELS,
+              1 + 2 * CHUNK_MIP0_SIZE + 3 * CHUNK_MIP0_SIZE * CHUNK_MIP0_SIZE);
+    return 1;
+}
+
+TEST(coords_roundtrip_active_layout)
+{
+    for (int32_t i = 0; i < CHUNK_VOXEL_COUNT; i++)
+    {
+        int32_t x, y, z;
+        chunk_voxel_coords(i, &x, &y, &z);
+        ASSERT(chunk_in_bounds(x, y, z));
+        ASSERT_EQ(chunk_voxel_index(x, y, z), i);
+    }
+    return 1;
+}
+
+TEST(occupancy_matches_voxels)
+{
+    Chunk *chunk = (Chunk *)calloc(1, sizeof(Chunk));
+    ASSERT(chunk != NULL);
+    chunk_init(chunk, 0, 0, 0);
+
+    RngState rng;
+    rng_seed(&rng, 0x1A70u);
+    for (int32_t n = 0; n < 40; n++)
+    {
+        chunk_set(chunk, rng_range_i32(&rng, 0, CHUNK_SIZE - 1), rng_range_i32(&rng, 0, CHUNK_SIZE - 1),
+                  rng_range_i32(&rng, 0, CHUNK_SIZE - 1), MAT_STONE);
+    }
+    uint64_t incremental = chunk->occupancy.level0;
+    uint8_t incremental_l1 = chunk->occupancy.level1;
+
+    uint64_t expected = 0;
+    for (int32_t z = 0; z < CHUNK_SIZE; z++)
+        for (int32_t y = 0; y < CHUNK_SIZE; y++)
+            for (int32_t x = 0; x < CHUNK_SIZE; x++)
+                if (chunk_get(chunk, x, y, z) != MATERIAL_EMPTY)
+                    expected |= 1ULL << ((x / CHUNK_REGION_SIZE) + (y / CHUNK_REGION_SIZE) * CHUNK_MIP0_SIZE +
+                                         (z / CHUNK_REGION_SIZE) * CHUNK_MIP0_SIZE * CHUNK_MIP0_SIZE);
+
+    chunk_rebuild_occupancy(chunk);
+    ASSERT(chunk->occupancy.level0 == expected);
+    ASSERT(incremental == expected);
+    ASSERT_EQ(chunk->occupancy.level1, incremental_l1);
+
+    free(chunk);
+    return 1;
+}
+
+TEST(gpu_copy_is_row_major)
+{
+    Chunk *chunk = (Chunk *)calloc(1, sizeof(Chunk));
+    uint8_t *out = (uint8_t *)malloc(CHUNK_VOXEL_COUNT);
+    ASSERT(chunk != NULL && out != NULL);
+    chunk_init(chunk, 0, 0, 0);
+
+    for (int32_t z = 0; z < CHUNK_SIZE; z++)
+        for (int32_t y = 0; y < CHUNK_SIZE; y++)
+            for (int32_t x = 0; x < CHUNK_SIZE; x++)
+                chunk_set(chunk, x, y, z, (uint8_t)(1 + ((x * 7 + y * 3 + z) % 200)));
+
+    ASSERT_EQ(gpu_chunk_copy_voxels(chunk, out), CHUNK_VOXEL_COUNT);
+    for (int32_t z = 0; z < CHUNK_SIZE; z++)
+        for (int32_t y = 0; y < CHUNK_SIZE; y++)
+            for (int32_t x = 0; x < CHUNK_SIZE; x++)
+                ASSERT_EQ(out[x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_SIZE], chunk_get(chunk, x, y, z));
+
+    free(out);
+    free(chunk);
+    return 1;
+}
+
+TEST(layout_benchmark)
+{
+    uint8_t *grid = (uint8_t *)malloc(LB_TOTAL_VOXELS);
+    uint8_t *visited = (uint8_t *)malloc(LB_TOTAL_VOXELS);
+    int32_t *stack = (int32_t *)malloc(sizeof(int32_t) * LB_TOTAL_VOXELS);
+    LayoutSphere *spheres = (LayoutSphere *)malloc(sizeof(LayoutSphere) * LB_SPHERE_COUNT);
+    LayoutRay *rays = (LayoutRay *)malloc(sizeof(LayoutRay) * LB_RAY_COUNT);
+    ASSERT(grid && visited && stack && spheres && rays);
+
+    RngState rng;
+    rng_seed(&rng, 0xB41C5u);
+    for (int32_t i = 0; i < LB_SPHERE_COUNT; i++)
+    {
+        spheres[i].cx = rng_range_i32(&rng, 0, LB_VOXELS_AXIS - 1);
+        spheres[i].cy = rng_range_i32(&rng, 0, LB_VOXELS_AXIS / 2);
+        spheres[i].cz = rng_range_i32(&rng, 0, LB_VOXELS_AXIS - 1);
+        spheres[i].radius = rng_range_i32(&rng, 3, 12);
+        spheres[i].material = (uint8_t)rng_range_i32(&rng, 1, 8);
+    }
+    for (int32_t i = 0; i < LB_RAY_COUNT; i++)
+    {
+        rays[i].ox = rng_range_f32(&rng, 0.5f, LB_VOXELS_AXIS - 0.5f);
+        rays[i].oy = LB_VOXELS_AXIS - 0.5f;
+        rays[i].oz = rng_range_f32(&rng, 0.5f, LB_VOXELS_AXIS - 0.5f);
+        Vec3 d = vec3_normalize(vec3_create(rng_range_f32(&rng, -1.0f, 1.0f), rng_range_f32(&rng, -1.0f, -0.2f),
+                                            rng_range_f32(&rng, -1.0f, 1.0f)));
+        rays[i].dx = d.x;
+        rays[i].dy = d.y;
+        rays[i].dz = d.z;
+    }
+
+    LayoutBenchResult linear, brick, morton;
+    RUN_LAYOUT_BENCH(linear, grid, visited, stack, spheres, rays, &linear);
+    RUN_LAYOUT_BENCH(brick, grid, visited, stack, spheres, rays, &brick);
+    RUN_LAYOUT_BENCH(morton, grid, visited, stack, spheres, rays, &morton);
+
+    printf("\n    %d^3 voxels, %d spheres, %d rays, best of %d\n", LB_VOXELS_AXIS, LB_SPHERE_COUNT,
+           LB_RAY_COUNT, LB_ITERATIONS);
+    const char *names[3] = {"linear", "brick", "morton"};
+    const LayoutBenchResult *results[3] = {&linear, &brick, &morton};
+    for (int32_t i = 0; i < 3; i++)
+    {
+        printf("    %-8s sphere_fill=%7.2fms  flood_fill=%7.2fms  raycast=%7.2fms\n", names[i],
+               results[i]->fill_ms, results[i]->flood_ms, results[i]->raycast_ms);
+    }
+    printf("    (active CHUNK_LAYOUT = %s)\n    ", names[CHUNK_LAYOUT]);
+
+    /* Layout must never change results */
+    for (int32_t i = 1; i < 3; i++)
+    {
+        ASSERT(results[i]->filled == linear.filled);
+        ASSERT(results[i]->hash == linear.hash);
+        ASSERT_EQ(results[i]->flood_count, linear.flood_count);
+        ASSERT(results[i]->ray_steps == linear.ray_steps);
+    }
+    ASSERT(linear.flood_count > 0);
+
+    free(rays);
+    free(spheres);
+    free(stack);
+    free(visited);
+    free(grid);
+    return 1;
+}
+
+TEST(engine_kernels_active_layout)
+{
+    Bounds3D bounds = {-32.0f, 32.0f, 0.0f, 32.0f, -32.0f, 32.0f};
+    VoxelVolume *vol = volume_create(4, 2, 4, bounds);
+    ASSERT(vol != NULL);
+    float voxel_size = vol->voxel_size;
+
+    RngState rng;
+    rng_seed(&rng, 0xE61u);
+
+    PlatformTime t0 = platform_time_now();
+    volume_fill_box(vol, vec3_create(-32.0f, 0.0f, -32.0f), vec3_create(32.0f, 4.0f, 32.0f), MAT_STONE);
+    for (int32_t i = 0; i < 200; i++)
+    {
+        Vec3 c = vec3_create(rng_range_f32(&rng, -28.0f, 28.0f), rng_range_f32(&rng, 2.0f, 12.0f),
+                             rng_range_f32(&rng, -28.0f, 28.0f));
+        volume_fill_sphere(vol, c, rng_range_f32(&rng, 8.0f, 24.0f) * voxel_size, MAT_STONE);
+    }
+    float fill_ms = lb_elapsed_ms(t0);
+
+    ConnectivityWorkBuffer work;
+    ASSERT(connectivity_work_init(&work, vol));
+    ConnectivityResult result;
+    t0 = platform_time_now();
+    connectivity_analyze_volume(vol, bounds.min_y + 0.1f, 0, &work, &result);
+    float flood_ms = lb_elapsed_ms(t0);
+    ASSERT(result.anchored_count >= 1);
+
+    t0 = platform_time_now();
+    int32_t hits = 0;
+    for (int32_t i = 0; i < 4096; i++)
+    {
+        Vec3 origin = vec3_create(rng_range_f32(&rng, -30.0f, 30.0f), 31.0f, rng_range_f32(&rng, -30.0f, 30.0f));
+        Vec3 dir = vec3_normalize(vec3_create(rng_range_f32(&rng, -1.0f, 1.0f), -1.0f,
+                                              rng_range_f32(&rng, -1.0f, 1.0f)));
+        Vec3 hit_pos, hit_normal;
+        uint8_t mat;
+        if (volume_raycast(vol, origin, dir, 100.0f, &hit_pos, &hit_normal, &mat) >= 0.0f)
+            hits++;
+    }
+    float ray_ms = lb_elapsed_ms(t0);
+    ASSERT(hits > 0);
+
+    printf("\n    engine sphere_fill=%7.2fms  connectivity=%7.2fms  raycast=%7.2fms\n    ",
+           fill_ms, flood_ms, ray_ms);
+
+    connectivity_work_destroy(&work);
+    volume_destroy(vol);
+    return 1;
+}
+
+int main(void)
+{
+    printf("=== Chunk Layout Tests ===\n");
+    platform_time_init();
+
+    RUN_TEST(index_functions_are_bijections);
+    RUN_TEST(brick_and_morton_regions_contiguous);
+    RUN_TEST(coords_roundtrip_active_layout);
+    RUN_TEST(occupancy_matches_voxels);
+    RUN_TEST(gpu_copy_is_row_major);
+    RUN_TEST(layout_benchmark);
+    RUN_TEST(engine_kernels_active_layout);
+
+    printf("\nResults: %d/%d passed\n", g_tests_passed, g_tests_run);
+    return (g_tests_passed == g_tests_run) ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+#include "engine/core/types.h"
+#include "engine/core/math.h"
+#include "engine/core/rng.h"
+#include "engine/voxel/volume.h"
+#include "engine/voxel/connectivity.h"
+#include "engine/render/gpu_volume.h"
+#include "engine/platform/platform.h"
+#include "content/materials.h"
+#include "test_common.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/*
+ * Chunk size specialization tests and benchmarks.
+ * CHUNK_SIZE is fixed per build (PATCH_CHUNK_SIZE), so the benchmark reports
+ * edit / upload / raycast costs for the built size over a world of fixed
+ * voxel dimensions. Build with 16, 32 and 64 to compare.
+ */
+
+#define CS_WORLD_VOXELS_X 256
+#define CS_WORLD_VOXELS_Y 128
+#define CS_WORLD_VOXELS_Z 256
+#define CS_VOXEL_SIZE 0.1f
+#define CS_EDIT_COUNT 200
+#define CS_RAY_COUNT 8192
+
+static VoxelVolume *create_world(void)
+{
+    VoxelVolume *vol = volume_create_dims(CS_WORLD_VOXELS_X / CHUNK_SIZE, CS_WORLD_VOXELS_Y / CHUNK_SIZE,
+                                          CS_WORLD_VOXELS_Z / CHUNK_SIZE, vec3_zero(), CS_VOXEL_SIZE);
+    if (!vol)
+        return NULL;
+    volume_fill_box(vol, vec3_zero(),
+                    vec3_create(CS_WORLD_VOXELS_X * CS_VOXEL_SIZE, 4.0f, CS_WORLD_VOXELS_Z * CS_VOXEL_SIZE),
+                    MAT_STONE);
+    volume_rebuild_all_occupancy(vol);
+    return vol;
+}
+
+TEST(derived_constants)
+{
+    ASSERT_EQ(CHUNK_SIZE, 1 << CHUNK_SIZE_BITS);
+    ASSERT_EQ(CHUNK_REGION_SIZE * CHUNK_MIP0_SIZE, CHUNK_SIZE);
+    ASSERT_EQ(VOLUME_MAX_CHUNKS_X * CHUNK_SIZE, VOLUME_MAX_VOXELS_X);
+    ASSERT_EQ(VOLUME_MAX_CHUNKS_Y * CHUNK_SIZE, VOLUME_MAX_VOXELS_Y);
+    ASSERT(VOLUME_MAX_DIRTY_PER_FRAME * CHUNK_VOXEL_COUNT >= 16 * 32 * 32 * 32);
+
+    /* solid_count must hold a full chunk */
+    Chunk *chunk = (Chunk *)calloc(1, sizeof(Chunk));
+    ASSERT(chunk != NULL);
+    chunk_init(chunk, 0, 0, 0);
+    chunk_fill(chunk, MAT_STONE);
+    ASSERT(chunk->occupancy.solid_count == CHUNK_VOXEL_COUNT);
+    chunk_rebuild_occupancy(chunk);
+    ASSERT(chunk->occupancy.solid_count == CHUNK_VOXEL_COUNT);
+    ASSERT(chunk->occupancy.level0 == 0xFFFFFFFFFFFFFFFFULL);
+    ASSERT_EQ(chunk->occupancy.level1, 0xFF);
+
+    GPUChunkHeader header = gpu_chunk_header_from_chunk(chunk);
+    ASSERT_EQ(header.packed & 0xFFu, 1u);
+    free(chunk);
+    return 1;
+}
+
+TEST(region_occupancy_follows_chunk_size)
+{
+    Chunk *chunk = (Chunk *)calloc(1, sizeof(Chunk));
+    ASSERT(chunk != NULL);
+    chunk_init(chunk, 0, 0, 0);
+
+    /* Last voxel of region (1,2,3) and first voxel of region (3,3,3) */
+    chunk_set(chunk, 2 * CHUNK_REGION_SIZE - 1, 3 * CHUNK_REGION_SIZE - 1, 4 * CHUNK_REGION_SIZE - 1, MAT_STONE);
+    chunk_set(chunk, 3 * CHUNK_REGION_SIZE, 3 * CHUNK_REGION_SIZE, 3 * CHUNK_REGION_SIZE, MAT_STONE);
+    uint64_t expected = (1ULL << (1 + 2 * 4 + 3 * 16)) | (1ULL << (3 + 3 * 4 + 3 * 16));
+    ASSERT(chunk->occupancy.level0 == expected);
+    ASSERT_EQ(chunk->occupancy.level1, 1 << (0 + 1 * 2 + 1 * 4) | 1 << (1 + 1 * 2 + 1 * 4));
+
+    chunk_rebuild_occupancy(chunk);
+    ASSERT(chunk->occupancy.level0 == expected);
+    free(chunk);
+    return 1;
+}
+
+TEST(world_is_size_independent)
+{
+    VoxelVolume *vol = create_world();
+    ASSERT(vol != NULL);
+
+    /* Same world-space contents regardless of chunk edge */
+    int32_t floor_voxels = CS_WORLD_VOXELS_X * CS_WORLD_VOXELS_Z * 40;
+    ASSERT_EQ(vol->total_solid_voxels, floor_voxels);
+
+    Vec3 hit_pos, hit_normal;
+    uint8_t mat = 0;
+    float t = volume_raycast(vol, vec3_create(12.35f, 10.0f, 7.65f), vec3_create(0.0f, -1.0f, 0.0f), 20.0f,
+                             &hit_pos, &hit_normal, &mat);
+    ASSERT_NEAR(t, 6.0f, 0.05f);
+    ASSERT_EQ(mat, MAT_STONE);
+
+    volume_destroy(vol);
+
+    /* Floating block straddling the 32-voxel plane is one island for every size */
+    vol = volume_create_dims(64 / CHUNK_SIZE, 64 / CHUNK_SIZE, 64 / CHUNK_SIZE, vec3_zero(), CS_VOXEL_SIZE);
+    ASSERT(vol != NULL);
+    volume_fill_box(vol, vec3_zero(), vec3_create(6.4f, 0.1f, 6.4f), MAT_STONE);
+    volume_fill_box(vol, vec3_create(2.7f, 2.7f, 2.7f), vec3_create(3.7f, 3.7f, 3.7f), MAT_BRICK);
+    ConnectivityWorkBuffer work;
+    ASSERT(connectivity_work_init(&work, vol));
+    ConnectivityResult result;
+    connectivity_analyze_volume(vol, 0.05f, 0, &work, &result);
+    ASSERT_EQ(result.floating_count, 1);
+    ASSERT_EQ(result.anchored_count, 1);
+
+    connectivity_work_destroy(&work);
+    volume_destroy(vol);
+    return 1;
+}
+
+TEST(chunk_size_benchmark)
+{
+    VoxelVolume *vol = create_world();
+    ASSERT(vol != NULL);
+    volume_clear_snapshot_dirty(vol);
+
+    RngState rng;
+    rng_seed(&rng, 0xC5u);
+    Vec3 *centers = (Vec3 *)malloc(sizeof(Vec3) * CS_EDIT_COUNT);
+    ASSERT(centers != NULL);
+    for (int32_t i = 0; i < CS_EDIT_COUNT; i++)
+    {
+        centers[i] = vec3_create(rng_range_f32(&rng, 1.0f, CS_WORLD_VOXELS_X * CS_VOXEL_SIZE - 1.0f),
+                                 rng_range_f32(&rng, 2.0f, 4.0f),
+                                 rng_range_f32(&rng, 1.0f, CS_WORLD_VOXELS_Z * CS_VOXEL_SIZE - 1.0f));
+    }
+
+    /* Edit: carve craters, counting chunks that must be re-uploaded */
+    PlatformTime t0 = platform_time_now();
+    for (int32_t i = 0; i < CS_EDIT_COUNT; i++)
+        volume_fill_sphere(vol, centers[i], 0.6f, MAT_AIR);
+    float edit_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+
+    int32_t *dirty = (int32_t *)malloc(sizeof(int32_t) * VOLUME_MAX_CHUNKS);
+    ASSERT(dirty != NULL);
+    int32_t dirty_count = volume_get_snapshot_dirty_chunks(vol, dirty, VOLUME_MAX_CHUNKS);
+    ASSERT(dirty_count > 0);
+
+    /* Upload: pack dirty chunk voxels + headers as the renderer's staging copy does */
+    uint8_t *staging = (uint8_t *)malloc((size_t)dirty_count * GPU_CHUNK_DATA_SIZE);
+    GPUChunkHeader *headers = (GPUChunkHeader *)malloc(sizeof(GPUChunkHeader) * (size_t)dirty_count);
+    ASSERT(staging != NULL && headers != NULL);
+    t0 = platform_time_now();
+    for (int32_t i = 0; i < dirty_count; i++)
+    {
+        gpu_chunk_copy_voxels(&vol->chunks[dirty[i]], staging + (size_t)i * GPU_CHUNK_DATA_SIZE);
+        headers[i] = gpu_chunk_header_from_chunk(&vol->chunks[dirty[i]]);
+    }
+    float upload_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+    float upload_kb = (float)dirty_count * (GPU_CHUNK_DATA_SIZE + sizeof(GPUChunkHeader)) / 1024.0f;
+
+    /* Raycast: grazing rays cross many chunks and regions before hitting the floor */
+    int32_t hits = 0;
+    t0 = platform_time_now();
+    for (int32_t i = 0; i < CS_RAY_COUNT; i++)
+    {
+        Vec3 origin = vec3_create(rng_range_f32(&rng, 0.5f, CS_WORLD_VOXELS_X * CS_VOXEL_SIZE - 0.5f),
+                                  rng_range_f32(&rng, 6.0f, 12.0f),
+                                  rng_range_f32(&rng, 0.5f, CS_WORLD_VOXELS_Z * CS_VOXEL_SIZE - 0.5f));
+        Vec3 dir = vec3_normalize(vec3_create(rng_range_f32(&rng, -1.0f, 1.0f), -0.25f,
+                                              rng_range_f32(&rng, -1.0f, 1.0f)));
+        Vec3 hit_pos, hit_normal;
+        uint8_t mat;
+        if (volume_raycast(vol, origin, dir, 60.0f, &hit_pos, &hit_normal, &mat) >= 0.0f)
+            hits++;
+    }
+    float ray_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+    ASSERT(hits > 0);
+
+    printf("\n    chunk=%d^3 chunks=%d headers=%.1fKB\n", CHUNK_SIZE, vol->total_chunks,
+           vol->total_chunks * sizeof(GPUChunkHeader) / 1024.0f);
+    printf("    edit=%6.2fms  dirty=%4d chunks  upload=%6.2fms (%.0fKB)  raycast=%6.2fms (%d rays)\n    ",
+           edit_ms, dirty_count, upload_ms, upload_kb, ray_ms, CS_RAY_COUNT);
+
+    free(headers);
+    free(staging);
+    free(dirty);
+    free(centers);
+    volume_destroy(vol);
+    return 1;
+}
+
+int main(void)
+{
+    printf("=== Chunk Size Tests ===\n");
+    platform_time_init();
+
+    RUN_TEST(derived_constants);
+    RUN_TEST(region_occupancy_follows_chunk_size);
+    RUN_TEST(world_is_size_independent);
+    RUN_TEST(chunk_size_benchmark);
+
+    printf("\nResults: %d/%d passed\n", g_tests_passed, g_tests_run);
+    return (g_tests_passed == g_tests_run) ? 0 : 1;
+}
@@ -72,7 +72,7 @@ TEST(gpu_chunk_header_matches_uvec4)
     ASSERT(offsetof(GPUChunkHeader, level0_lo) == 0);
     ASSERT(offsetof(GPUChunkHeader, level0_hi) == 4);
     ASSERT(offsetof(GPUChunkHeader, packed) == 8);
-    ASSERT(offsetof(GPUChunkHeader, pad) == 12);
+    ASSERT(offsetof(GPUChunkHeader, data_slot) == 12);
     return 1;
 }
 
@@ -266,7 +266,7 @@ TEST(chunk_header_full_occupancy)
     ASSERT(header.level0_hi == 0xFFFFFFFF);
     ASSERT((header.packed & 0xFF) == 1);                /* has_any = 1 */
     ASSERT(((header.packed >> 8) & 0xFF) == 0xFF);      /* level1 = 0xFF */
-    ASSERT((header.packed >> 16) == CHUNK_VOXEL_COUNT); /* solid_count */
+    ASSERT((header.packed >> 16) == (CHUNK_VOXEL_COUNT > 0xFFFF ? 0xFFFF : CHUNK_VOXEL_COUNT)); /* solid_count, saturated */
     return 1;
 }
 
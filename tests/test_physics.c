@@ -6,13 +6,28 @@
 #include "engine/voxel/volume.h"
 #include "engine/physics/rigidbody.h"
 #include "engine/physics/collision_object.h"
+#include "engine/physics/convex_hull.h"
+#include "engine/physics/broadphase.h"
+#include "engine/physics/island.h"
+#include "engine/voxel/bvh.h"
+#include "engine/physics/manifold.h"
+#include "engine/physics/terrain_contact.h"
+#include "engine/physics/sim_lod.h"
+#include "engine/physics/debris_lod.h"
+#include "engine/physics/body_freeze.h"
+#include "engine/physics/particle_terrain.h"
+#include "engine/physics/particle_cells.h"
+#include "engine/physics/particles.h"
 #include "engine/physics/character.h"
 #include "engine/physics/projectile.h"
 #include "engine/physics/ragdoll.h"
 #include "engine/platform/platform.h"
+#include "engine/core/profile.h"
+#include "engine/core/spatial_hash.h"
 #include "content/materials.h"
 #include "test_common.h"
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
 
 TEST(mat3_multiply_identity)
@@ -124,8 +139,8 @@ static int32_t create_dumbbell_object(VoxelObjectWorld *world, Vec3 position, ui
     VoxelObject *obj = &world->objects[slot];
     memset(obj, 0, sizeof(VoxelObject));
 
-    obj->position = position;
-    obj->orientation = quat_identity();
+    voxel_object_set_position(world, slot, position);
+    voxel_object_set_orientation(world, slot, quat_identity());
     obj->active = true;
     obj->voxel_size = world->voxel_size;
     obj->voxel_count = 0;
@@ -156,7 +171,7 @@ static int32_t create_dumbbell_object(VoxelObjectWorld *world, Vec3 position, ui
         }
     }
 
-    voxel_object_recalc_shape(obj);
+    voxel_object_recalc_shape(world, slot);
     return slot;
 }
 
@@ -358,7 +373,7 @@ TEST(physics_body_add_remove)
 
     RigidBody *body = physics_world_get_body(physics, body_idx);
     ASSERT(body != NULL);
-    ASSERT((body->flags & PHYS_FLAG_ACTIVE) != 0);
+    ASSERT((physics->flags[body_idx] & PHYS_FLAG_ACTIVE) != 0);
     ASSERT(body->mass > 0.0f);
 
     physics_world_remove_body(physics, body_idx);
@@ -400,15 +415,13 @@ TEST(physics_integration_gravity)
                                                  vec3_create(1.0f, 1.0f, 1.0f), MAT_STONE);
     int32_t body_idx = physics_world_add_body(physics, obj_idx);
 
-    VoxelObject *obj = &obj_world->objects[obj_idx];
-    float initial_y = obj->position.y;
+    float initial_y = voxel_object_position(obj_world, obj_idx).y;
 
     physics_world_step(physics, 1.0f / 60.0f);
 
-    ASSERT(obj->position.y < initial_y);
+    ASSERT(voxel_object_position(obj_world, obj_idx).y < initial_y);
 
-    RigidBody *body = physics_world_get_body(physics, body_idx);
-    ASSERT(body->velocity.y < 0.0f);
+    ASSERT(physics->velocity.y[body_idx] < 0.0f);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -426,12 +439,12 @@ TEST(physics_sleep_from_rest)
     int32_t body_idx = physics_world_add_body(physics, obj_idx);
 
     RigidBody *body = physics_world_get_body(physics, body_idx);
-    ASSERT((body->flags & PHYS_FLAG_SLEEPING) == 0);
+    ASSERT((physics->flags[body_idx] & PHYS_FLAG_SLEEPING) == 0);
 
-    body->velocity = vec3_zero();
-    body->angular_velocity = vec3_zero();
+    physics_body_store_velocity(physics, body_idx, vec3_zero());
+    physics_body_store_angular_velocity(physics, body_idx, vec3_zero());
     body->sleep_frames = PHYS_SLEEP_FRAMES;
-    body->flags |= PHYS_FLAG_SLEEPING;
+    physics->flags[body_idx] |= PHYS_FLAG_SLEEPING;
 
     ASSERT(physics_body_is_sleeping(physics, body_idx) == true);
 
@@ -455,11 +468,11 @@ TEST(physics_wake_on_impulse)
     int32_t body_idx = physics_world_add_body(physics, obj_idx);
 
     RigidBody *body = physics_world_get_body(physics, body_idx);
-    body->flags |= PHYS_FLAG_SLEEPING;
+    physics->flags[body_idx] |= PHYS_FLAG_SLEEPING;
     body->sleep_frames = PHYS_SLEEP_FRAMES;
 
     Vec3 impulse = vec3_create(5.0f, 0.0f, 0.0f);
-    Vec3 point = obj_world->objects[obj_idx].position;
+    Vec3 point = voxel_object_position(obj_world, obj_idx);
     physics_body_apply_impulse(physics, body_idx, impulse, point);
 
     ASSERT(physics_body_is_sleeping(physics, body_idx) == false);
@@ -483,8 +496,7 @@ TEST(physics_velocity_clamping)
 
     physics_world_step(physics, 1.0f / 60.0f);
 
-    RigidBody *body = physics_world_get_body(physics, body_idx);
-    float speed = vec3_length(body->velocity);
+    float speed = vec3_length(physics_body_velocity(physics, body_idx));
     ASSERT(speed <= PHYS_MAX_LINEAR_VELOCITY + 1.0f);
 
     physics_world_destroy(physics);
@@ -492,6 +504,14 @@ TEST(physics_velocity_clamping)
     return 1;
 }
 
+static float body_kinetic_energy(const PhysicsWorld *physics, int32_t body_idx)
+{
+    const RigidBody *body = &physics->bodies[body_idx];
+    Vec3 w = physics_body_angular_velocity(physics, body_idx);
+    return 0.5f * body->mass * vec3_length_sq(physics_body_velocity(physics, body_idx)) +
+           0.5f * vec3_dot(body->inertia_local, vec3_mul(w, w));
+}
+
 TEST(physics_energy_decreases)
 {
     Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
@@ -505,18 +525,15 @@ TEST(physics_energy_decreases)
     physics_body_set_velocity(physics, body_idx, vec3_create(5.0f, 0.0f, 0.0f));
     physics_body_set_angular_velocity(physics, body_idx, vec3_create(0.0f, 2.0f, 0.0f));
 
-    RigidBody *body = physics_world_get_body(physics, body_idx);
-    float initial_ke = 0.5f * body->mass * vec3_length_sq(body->velocity);
-    initial_ke += 0.5f * vec3_dot(body->inertia_local, vec3_mul(body->angular_velocity, body->angular_velocity));
+    float initial_ke = body_kinetic_energy(physics, body_idx);
 
     for (int32_t i = 0; i < 60; i++)
     {
-        body->velocity.y = 0.0f;
+        physics->velocity.y[body_idx] = 0.0f;
         physics_world_step(physics, 1.0f / 60.0f);
     }
 
-    float final_ke = 0.5f * body->mass * vec3_length_sq(body->velocity);
-    final_ke += 0.5f * vec3_dot(body->inertia_local, vec3_mul(body->angular_velocity, body->angular_velocity));
+    float final_ke = body_kinetic_energy(physics, body_idx);
 
     ASSERT(final_ke < initial_ke);
 
@@ -537,8 +554,8 @@ TEST(physics_zero_mass_guard)
 
     RigidBody *body = physics_world_get_body(physics, body_idx);
     ASSERT(body->mass > 0.0f);
-    ASSERT(body->inv_mass > 0.0f);
-    ASSERT(body->inv_mass < 1e6f);
+    ASSERT(physics->inv_mass[body_idx] > 0.0f);
+    ASSERT(physics->inv_mass[body_idx] < 1e6f);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -568,18 +585,16 @@ TEST(physics_terrain_contact)
     int32_t body_idx = physics_world_add_body(physics, obj_idx);
     ASSERT(body_idx >= 0);
 
-    RigidBody *body = physics_world_get_body(physics, body_idx);
-    VoxelObject *obj = &obj_world->objects[obj_idx];
 
     for (int32_t tick = 0; tick < 60; tick++)
     {
         physics_world_step(physics, 1.0f / 60.0f);
     }
 
-    ASSERT(obj->position.y < floor_surface + 1.0f);
-    ASSERT(obj->position.y > floor_surface - 0.5f);
+    ASSERT(voxel_object_position(obj_world, obj_idx).y < floor_surface + 1.0f);
+    ASSERT(voxel_object_position(obj_world, obj_idx).y > floor_surface - 0.5f);
 
-    printf("(y=%.2f, grnd=%d) ", obj->position.y, (body->flags & PHYS_FLAG_GROUNDED) ? 1 : 0);
+    printf("(y=%.2f, grnd=%d) ", voxel_object_position(obj_world, obj_idx).y, (physics->flags[body_idx] & PHYS_FLAG_GROUNDED) ? 1 : 0);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -611,7 +626,6 @@ TEST(physics_terrain_settling)
     ASSERT(body_idx >= 0);
 
     RigidBody *body = physics_world_get_body(physics, body_idx);
-    VoxelObject *obj = &obj_world->objects[obj_idx];
 
     int32_t settled_tick = -1;
     int32_t first_grounded = -1;
@@ -622,18 +636,18 @@ TEST(physics_terrain_settling)
     {
         physics_world_step(physics, 1.0f / 60.0f);
 
-        if (first_grounded < 0 && (body->flags & PHYS_FLAG_GROUNDED))
+        if (first_grounded < 0 && (physics->flags[body_idx] & PHYS_FLAG_GROUNDED))
             first_grounded = tick;
 
         if (body->sleep_frames > max_sleep_frames)
             max_sleep_frames = body->sleep_frames;
 
-        float lin = vec3_length(body->velocity);
-        float ang = vec3_length(body->angular_velocity);
+        float lin = vec3_length(physics_body_velocity(physics, body_idx));
+        float ang = vec3_length(physics_body_angular_velocity(physics, body_idx));
         if (lin >= 0.05f || ang >= 0.1f)
             above_threshold_count++;
 
-        if (body->flags & PHYS_FLAG_SLEEPING)
+        if (physics->flags[body_idx] & PHYS_FLAG_SLEEPING)
         {
             settled_tick = tick;
             break;
@@ -641,12 +655,12 @@ TEST(physics_terrain_settling)
     }
 
     printf("(y=%.2f, vel=%.3f, grnd=%d, sleep=%d, max_frames=%d, above=%d) ",
-           obj->position.y, vec3_length(body->velocity),
+           voxel_object_position(obj_world, obj_idx).y, vec3_length(physics_body_velocity(physics, body_idx)),
            first_grounded, settled_tick, max_sleep_frames, above_threshold_count);
 
     ASSERT(first_grounded >= 0);
     ASSERT(settled_tick >= 0);
-    ASSERT((body->flags & PHYS_FLAG_SLEEPING) != 0);
+    ASSERT((physics->flags[body_idx] & PHYS_FLAG_SLEEPING) != 0);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -676,38 +690,36 @@ TEST(physics_no_jitter_after_sleep)
                                                  vec3_create(0.3f, 0.3f, 0.3f), MAT_STONE);
     int32_t body_idx = physics_world_add_body(physics, obj_idx);
 
-    RigidBody *body = physics_world_get_body(physics, body_idx);
-    VoxelObject *obj = &obj_world->objects[obj_idx];
 
     for (int32_t tick = 0; tick < 900; tick++)
     {
         physics_world_step(physics, 1.0f / 60.0f);
-        if (body->flags & PHYS_FLAG_SLEEPING)
+        if (physics->flags[body_idx] & PHYS_FLAG_SLEEPING)
             break;
     }
 
-    if (!(body->flags & PHYS_FLAG_SLEEPING))
+    if (!(physics->flags[body_idx] & PHYS_FLAG_SLEEPING))
     {
         printf("(NEVER SLEPT: y=%.2f, vel=%.3f,%.3f,%.3f, grnd=%d) ",
-               obj->position.y, body->velocity.x, body->velocity.y, body->velocity.z,
-               (body->flags & PHYS_FLAG_GROUNDED) ? 1 : 0);
+               voxel_object_position(obj_world, obj_idx).y, physics->velocity.x[body_idx], physics->velocity.y[body_idx], physics->velocity.z[body_idx],
+               (physics->flags[body_idx] & PHYS_FLAG_GROUNDED) ? 1 : 0);
         ASSERT(0);
     }
 
-    Vec3 sleep_pos = obj->position;
+    Vec3 sleep_pos = voxel_object_position(obj_world, obj_idx);
 
     for (int32_t tick = 0; tick < 120; tick++)
     {
         physics_world_step(physics, 1.0f / 60.0f);
     }
 
-    Vec3 after_pos = obj->position;
+    Vec3 after_pos = voxel_object_position(obj_world, obj_idx);
     float drift = vec3_length(vec3_sub(after_pos, sleep_pos));
 
     printf("(drift=%.4f) ", drift);
 
     ASSERT(drift < 0.001f);
-    ASSERT((body->flags & PHYS_FLAG_SLEEPING) != 0);
+    ASSERT((physics->flags[body_idx] & PHYS_FLAG_SLEEPING) != 0);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -867,16 +879,14 @@ TEST(physics_static_flag)
                                                  vec3_create(1.0f, 1.0f, 1.0f), MAT_STONE);
     int32_t body_idx = physics_world_add_body(physics, obj_idx);
 
-    RigidBody *body = physics_world_get_body(physics, body_idx);
-    body->flags |= PHYS_FLAG_STATIC;
+    physics->flags[body_idx] |= PHYS_FLAG_STATIC;
 
-    VoxelObject *obj = &obj_world->objects[obj_idx];
-    float initial_y = obj->position.y;
+    float initial_y = voxel_object_position(obj_world, obj_idx).y;
 
     for (int32_t i = 0; i < 60; i++)
         physics_world_step(physics, 1.0f / 60.0f);
 
-    ASSERT_NEAR(obj->position.y, initial_y, 0.01f);
+    ASSERT_NEAR(voxel_object_position(obj_world, obj_idx).y, initial_y, 0.01f);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -893,15 +903,13 @@ TEST(physics_kinematic_flag)
                                                  vec3_create(1.0f, 1.0f, 1.0f), MAT_STONE);
     int32_t body_idx = physics_world_add_body(physics, obj_idx);
 
-    RigidBody *body = physics_world_get_body(physics, body_idx);
-    body->flags |= PHYS_FLAG_KINEMATIC;
+    physics->flags[body_idx] |= PHYS_FLAG_KINEMATIC;
 
-    VoxelObject *obj = &obj_world->objects[obj_idx];
-    float initial_y = obj->position.y;
+    float initial_y = voxel_object_position(obj_world, obj_idx).y;
 
     physics_world_step(physics, 1.0f / 60.0f);
 
-    ASSERT_NEAR(obj->position.y, initial_y, 0.01f);
+    ASSERT_NEAR(voxel_object_position(obj_world, obj_idx).y, initial_y, 0.01f);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -926,7 +934,7 @@ TEST(physics_add_body_with_mass)
     RigidBody *body = physics_world_get_body(physics, body_idx);
     ASSERT(body != NULL);
     ASSERT_NEAR(body->mass, custom_mass, K_EPSILON);
-    ASSERT_NEAR(body->inv_mass, 1.0f / custom_mass, K_EPSILON);
+    ASSERT_NEAR(physics->inv_mass[body_idx], 1.0f / custom_mass, K_EPSILON);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -1019,23 +1027,21 @@ TEST(object_collision_basic)
     int32_t body_b = physics_world_add_body(physics, obj_b);
     ASSERT(body_a >= 0 && body_b >= 0);
 
-    RigidBody *rb_a = physics_world_get_body(physics, body_a);
-    RigidBody *rb_b = physics_world_get_body(physics, body_b);
-    rb_a->flags |= PHYS_FLAG_KINEMATIC;
-    rb_b->flags |= PHYS_FLAG_KINEMATIC;
-    rb_a->flags &= ~PHYS_FLAG_KINEMATIC;
-    rb_b->flags &= ~PHYS_FLAG_KINEMATIC;
+    physics->flags[body_a] |= PHYS_FLAG_KINEMATIC;
+    physics->flags[body_b] |= PHYS_FLAG_KINEMATIC;
+    physics->flags[body_a] &= ~PHYS_FLAG_KINEMATIC;
+    physics->flags[body_b] &= ~PHYS_FLAG_KINEMATIC;
 
-    Vec3 initial_pos_a = obj_world->objects[obj_a].position;
-    Vec3 initial_pos_b = obj_world->objects[obj_b].position;
+    Vec3 initial_pos_a = voxel_object_position(obj_world, obj_a);
+    Vec3 initial_pos_b = voxel_object_position(obj_world, obj_b);
 
     for (int32_t tick = 0; tick < 30; tick++)
     {
         physics_world_step(physics, 1.0f / 60.0f);
     }
 
-    Vec3 final_pos_a = obj_world->objects[obj_a].position;
-    Vec3 final_pos_b = obj_world->objects[obj_b].position;
+    Vec3 final_pos_a = voxel_object_position(obj_world, obj_a);
+    Vec3 final_pos_b = voxel_object_position(obj_world, obj_b);
 
     float initial_dist = fabsf(initial_pos_b.x - initial_pos_a.x);
     float final_dist = fabsf(final_pos_b.x - final_pos_a.x);
@@ -1058,8 +1064,8 @@ static int32_t create_small_box_object(VoxelObjectWorld *world, Vec3 position, u
     VoxelObject *obj = &world->objects[slot];
     memset(obj, 0, sizeof(VoxelObject));
 
-    obj->position = position;
-    obj->orientation = quat_identity();
+    voxel_object_set_position(world, slot, position);
+    voxel_object_set_orientation(world, slot, quat_identity());
     obj->active = true;
     obj->voxel_size = world->voxel_size;
     obj->voxel_count = 0;
@@ -1081,7 +1087,7 @@ static int32_t create_small_box_object(VoxelObjectWorld *world, Vec3 position, u
     }
 
     obj->voxel_revision = 1;
-    voxel_object_recalc_shape(obj);
+    voxel_object_recalc_shape(world, slot);
     return slot;
 }
 
@@ -1101,20 +1107,18 @@ TEST(object_collision_dumbbell_gap)
     int32_t body_small = physics_world_add_body(physics, small_box);
     ASSERT(body_dumbbell >= 0 && body_small >= 0);
 
-    RigidBody *rb_dumbbell = physics_world_get_body(physics, body_dumbbell);
-    rb_dumbbell->flags |= PHYS_FLAG_STATIC;
+    physics->flags[body_dumbbell] |= PHYS_FLAG_STATIC;
 
-    RigidBody *rb_small = physics_world_get_body(physics, body_small);
-    rb_small->velocity = vec3_create(0.0f, -2.0f, 0.0f);
+    physics_body_store_velocity(physics, body_small, vec3_create(0.0f, -2.0f, 0.0f));
 
-    float initial_y = obj_world->objects[small_box].position.y;
+    float initial_y = voxel_object_position(obj_world, small_box).y;
 
     for (int32_t tick = 0; tick < 60; tick++)
     {
         physics_world_step(physics, 1.0f / 60.0f);
     }
 
-    float final_y = obj_world->objects[small_box].position.y;
+    float final_y = voxel_object_position(obj_world, small_box).y;
 
     printf("(initial_y=%.2f, final_y=%.2f) ", initial_y, final_y);
 
@@ -1134,8 +1138,8 @@ static int32_t create_l_shape_object(VoxelObjectWorld *world, Vec3 position, uin
     VoxelObject *obj = &world->objects[slot];
     memset(obj, 0, sizeof(VoxelObject));
 
-    obj->position = position;
-    obj->orientation = quat_identity();
+    voxel_object_set_position(world, slot, position);
+    voxel_object_set_orientation(world, slot, quat_identity());
     obj->active = true;
     obj->voxel_size = world->voxel_size;
     obj->voxel_count = 0;
@@ -1167,7 +1171,7 @@ static int32_t create_l_shape_object(VoxelObjectWorld *world, Vec3 position, uin
     }
 
     obj->voxel_revision = 1;
-    voxel_object_recalc_shape(obj);
+    voxel_object_recalc_shape(world, slot);
     return slot;
 }
 
@@ -1187,20 +1191,18 @@ TEST(object_collision_l_shape)
     int32_t body_small = physics_world_add_body(physics, small_box);
     ASSERT(body_l >= 0 && body_small >= 0);
 
-    RigidBody *rb_l = physics_world_get_body(physics, body_l);
-    rb_l->flags |= PHYS_FLAG_STATIC;
+    physics->flags[body_l] |= PHYS_FLAG_STATIC;
 
-    RigidBody *rb_small = physics_world_get_body(physics, body_small);
-    rb_small->velocity = vec3_create(0.0f, -2.0f, 0.0f);
+    physics_body_store_velocity(physics, body_small, vec3_create(0.0f, -2.0f, 0.0f));
 
-    float initial_y = obj_world->objects[small_box].position.y;
+    float initial_y = voxel_object_position(obj_world, small_box).y;
 
     for (int32_t tick = 0; tick < 60; tick++)
     {
         physics_world_step(physics, 1.0f / 60.0f);
     }
 
-    float final_y = obj_world->objects[small_box].position.y;
+    float final_y = voxel_object_position(obj_world, small_box).y;
 
     printf("(initial_y=%.2f, final_y=%.2f) ", initial_y, final_y);
 
@@ -1236,8 +1238,8 @@ TEST(object_collision_contact_accuracy)
     {
         ObjectCollisionPair *pair = &pairs[0];
 
-        Vec3 pos_a = obj_world->objects[obj_a].position;
-        Vec3 pos_b = obj_world->objects[obj_b].position;
+        Vec3 pos_a = voxel_object_position(obj_world, obj_a);
+        Vec3 pos_b = voxel_object_position(obj_world, obj_b);
         Vec3 expected_contact = vec3_scale(vec3_add(pos_a, pos_b), 0.5f);
 
         float contact_error = vec3_length(vec3_sub(pair->contact_point, expected_contact));
@@ -1270,19 +1272,17 @@ TEST(object_collision_moving_head_on)
     int32_t body_b = physics_world_add_body(physics, obj_b);
     ASSERT(body_a >= 0 && body_b >= 0);
 
-    RigidBody *rb_a = physics_world_get_body(physics, body_a);
-    RigidBody *rb_b = physics_world_get_body(physics, body_b);
 
-    rb_a->velocity = vec3_create(10.0f, 0.0f, 0.0f);
-    rb_b->velocity = vec3_create(-10.0f, 0.0f, 0.0f);
+    physics_body_store_velocity(physics, body_a, vec3_create(10.0f, 0.0f, 0.0f));
+    physics_body_store_velocity(physics, body_b, vec3_create(-10.0f, 0.0f, 0.0f));
 
     for (int32_t tick = 0; tick < 120; tick++)
     {
         physics_world_step(physics, 1.0f / 60.0f);
     }
 
-    Vec3 final_pos_a = obj_world->objects[obj_a].position;
-    Vec3 final_pos_b = obj_world->objects[obj_b].position;
+    Vec3 final_pos_a = voxel_object_position(obj_world, obj_a);
+    Vec3 final_pos_b = voxel_object_position(obj_world, obj_b);
     float final_dist = fabsf(final_pos_b.x - final_pos_a.x);
 
     float half_ext_a = obj_world->objects[obj_a].shape_half_extents.x;
@@ -1290,11 +1290,11 @@ TEST(object_collision_moving_head_on)
     float min_separation = (half_ext_a + half_ext_b) * 2.0f;
 
     printf("(final_dist=%.3f, min_sep=%.3f, vel_a=%.2f, vel_b=%.2f) ",
-           final_dist, min_separation, rb_a->velocity.x, rb_b->velocity.x);
+           final_dist, min_separation, physics->velocity.x[body_a], physics->velocity.x[body_b]);
 
     ASSERT(final_dist >= min_separation - 0.5f);
-    ASSERT(rb_a->velocity.x <= 0.1f);
-    ASSERT(rb_b->velocity.x >= -0.1f);
+    ASSERT(physics->velocity.x[body_a] <= 0.1f);
+    ASSERT(physics->velocity.x[body_b] >= -0.1f);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -1317,11 +1317,10 @@ TEST(object_collision_stacking)
     int32_t body_top = physics_world_add_body(physics, obj_top);
     ASSERT(body_base >= 0 && body_top >= 0);
 
-    RigidBody *rb_base = physics_world_get_body(physics, body_base);
-    rb_base->flags |= PHYS_FLAG_STATIC;
+    physics->flags[body_base] |= PHYS_FLAG_STATIC;
 
     VoxelObject *top_obj = &obj_world->objects[obj_top];
-    float base_top_y = obj_world->objects[obj_base].position.y +
+    float base_top_y = voxel_object_position(obj_world, obj_base).y +
                        obj_world->objects[obj_base].shape_half_extents.y;
 
     for (int32_t tick = 0; tick < 300; tick++)
@@ -1329,10 +1328,10 @@ TEST(object_collision_stacking)
         physics_world_step(physics, 1.0f / 60.0f);
     }
 
-    float top_bottom_y = top_obj->position.y - top_obj->shape_half_extents.y;
+    float top_bottom_y = voxel_object_position(obj_world, obj_top).y - top_obj->shape_half_extents.y;
     float gap = top_bottom_y - base_top_y;
 
-    printf("(top_y=%.3f, base_top=%.3f, gap=%.3f) ", top_obj->position.y, base_top_y, gap);
+    printf("(top_y=%.3f, base_top=%.3f, gap=%.3f) ", voxel_object_position(obj_world, obj_top).y, base_top_y, gap);
 
     ASSERT(gap > -0.3f);
     ASSERT(gap < 0.5f);
@@ -1351,8 +1350,8 @@ static int32_t create_wall_object(VoxelObjectWorld *world, Vec3 position, uint8_
     VoxelObject *obj = &world->objects[slot];
     memset(obj, 0, sizeof(VoxelObject));
 
-    obj->position = position;
-    obj->orientation = quat_identity();
+    voxel_object_set_position(world, slot, position);
+    voxel_object_set_orientation(world, slot, quat_identity());
     obj->active = true;
     obj->voxel_size = world->voxel_size;
     obj->voxel_count = 0;
@@ -1372,7 +1371,7 @@ static int32_t create_wall_object(VoxelObjectWorld *world, Vec3 position, uint8_
     }
 
     obj->voxel_revision = 1;
-    voxel_object_recalc_shape(obj);
+    voxel_object_recalc_shape(world, slot);
     return slot;
 }
 
@@ -1386,7 +1385,7 @@ TEST(object_collision_wall_friction)
     ASSERT(wall_idx >= 0);
 
     VoxelObject *wall = &obj_world->objects[wall_idx];
-    float wall_right = wall->position.x + wall->shape_half_extents.x;
+    float wall_right = voxel_object_position(obj_world, wall_idx).x + wall->shape_half_extents.x;
 
     int32_t box_idx = voxel_object_world_add_box(obj_world,
                                                  vec3_create(wall_right + 1.0f, 10.0f, 0.0f),
@@ -1397,30 +1396,29 @@ TEST(object_collision_wall_friction)
     int32_t body_box = physics_world_add_body(physics, box_idx);
     ASSERT(body_wall >= 0 && body_box >= 0);
 
-    RigidBody *rb_wall = physics_world_get_body(physics, body_wall);
     RigidBody *rb_box = physics_world_get_body(physics, body_box);
-    rb_wall->flags |= PHYS_FLAG_STATIC;
+    physics->flags[body_wall] |= PHYS_FLAG_STATIC;
     rb_box->friction = 0.9f;
 
-    rb_box->velocity = vec3_create(-5.0f, 0.0f, 0.0f);
+    physics_body_store_velocity(physics, body_box, vec3_create(-5.0f, 0.0f, 0.0f));
 
-    float initial_y = obj_world->objects[box_idx].position.y;
-    float initial_x = obj_world->objects[box_idx].position.x;
+    float initial_y = voxel_object_position(obj_world, box_idx).y;
+    float initial_x = voxel_object_position(obj_world, box_idx).x;
     bool collision_detected = false;
 
     for (int32_t tick = 0; tick < 60; tick++)
     {
         physics_world_step(physics, 1.0f / 60.0f);
 
-        float current_x = obj_world->objects[box_idx].position.x;
+        float current_x = voxel_object_position(obj_world, box_idx).x;
         if (current_x < initial_x && current_x > wall_right - 0.5f)
             collision_detected = true;
     }
 
-    float final_y = obj_world->objects[box_idx].position.y;
-    float final_x = obj_world->objects[box_idx].position.x;
+    float final_y = voxel_object_position(obj_world, box_idx).y;
+    float final_x = voxel_object_position(obj_world, box_idx).x;
     float y_drop = initial_y - final_y;
-    float x_vel = rb_box->velocity.x;
+    float x_vel = physics->velocity.x[body_box];
 
     printf("(y_drop=%.2f, final_x=%.2f, x_vel=%.2f, collision=%d) ",
            y_drop, final_x, x_vel, collision_detected ? 1 : 0);
@@ -1449,12 +1447,10 @@ TEST(object_collision_no_interpenetration)
     int32_t body_b = physics_world_add_body(physics, obj_b);
     ASSERT(body_a >= 0 && body_b >= 0);
 
-    RigidBody *rb_a = physics_world_get_body(physics, body_a);
-    RigidBody *rb_b = physics_world_get_body(physics, body_b);
-    rb_a->flags |= PHYS_FLAG_STATIC;
-    rb_b->flags |= PHYS_FLAG_STATIC;
-    rb_a->flags &= ~PHYS_FLAG_STATIC;
-    rb_b->flags &= ~PHYS_FLAG_STATIC;
+    physics->flags[body_a] |= PHYS_FLAG_STATIC;
+    physics->flags[body_b] |= PHYS_FLAG_STATIC;
+    physics->flags[body_a] &= ~PHYS_FLAG_STATIC;
+    physics->flags[body_b] &= ~PHYS_FLAG_STATIC;
 
     int32_t max_interpenetration_ticks = 0;
     float max_interpenetration = 0.0f;
@@ -1465,7 +1461,7 @@ TEST(object_collision_no_interpenetration)
 
         VoxelObject *oa = &obj_world->objects[obj_a];
         VoxelObject *ob = &obj_world->objects[obj_b];
-        float dist = fabsf(ob->position.x - oa->position.x);
+        float dist = fabsf(voxel_object_position(obj_world, obj_b).x - voxel_object_position(obj_world, obj_a).x);
         float min_dist = oa->shape_half_extents.x + ob->shape_half_extents.x;
 
         if (dist < min_dist)
@@ -1499,9 +1495,8 @@ TEST(physics_no_sleep_midair)
     int32_t body_idx = physics_world_add_body(physics, obj_idx);
     ASSERT(body_idx >= 0);
 
-    RigidBody *body = physics_world_get_body(physics, body_idx);
-    body->velocity = vec3_zero();
-    body->angular_velocity = vec3_zero();
+    physics_body_store_velocity(physics, body_idx, vec3_zero());
+    physics_body_store_angular_velocity(physics, body_idx, vec3_zero());
 
     for (int32_t tick = 0; tick < 600; tick++)
     {
@@ -1509,10 +1504,10 @@ TEST(physics_no_sleep_midair)
     }
 
     printf("(sleeping=%d, y=%.2f) ",
-           (body->flags & PHYS_FLAG_SLEEPING) ? 1 : 0,
-           obj_world->objects[obj_idx].position.y);
+           (physics->flags[body_idx] & PHYS_FLAG_SLEEPING) ? 1 : 0,
+           voxel_object_position(obj_world, obj_idx).y);
 
-    ASSERT((body->flags & PHYS_FLAG_SLEEPING) == 0);
+    ASSERT((physics->flags[body_idx] & PHYS_FLAG_SLEEPING) == 0);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -1542,14 +1537,13 @@ TEST(physics_terrain_bounce)
     int32_t body_idx = physics_world_add_body(physics, obj_idx);
     ASSERT(body_idx >= 0);
 
-    RigidBody *body = physics_world_get_body(physics, body_idx);
     bool bounced = false;
 
     for (int32_t tick = 0; tick < 300; tick++)
     {
         physics_world_step(physics, 1.0f / 60.0f);
 
-        if ((body->flags & PHYS_FLAG_GROUNDED) && body->velocity.y > 0.1f)
+        if ((physics->flags[body_idx] & PHYS_FLAG_GROUNDED) && physics->velocity.y[body_idx] > 0.1f)
         {
             bounced = true;
             break;
@@ -1571,7 +1565,8 @@ TEST(physics_no_tunneling)
     float voxel_size = 0.1f;
 
     Vec3 origin = vec3_create(bounds.min_x, bounds.min_y, bounds.min_z);
-    VoxelVolume *terrain = volume_create_dims(4, 4, 4, origin, voxel_size);
+    int32_t chunks = 128 / CHUNK_SIZE;
+    VoxelVolume *terrain = volume_create_dims(chunks, chunks, chunks, origin, voxel_size);
 
     Vec3 wall_min = vec3_create(-0.5f, 0.0f, -5.0f);
     Vec3 wall_max = vec3_create(0.5f, 10.0f, 5.0f);
@@ -1594,10 +1589,9 @@ TEST(physics_no_tunneling)
         physics_world_step(physics, 1.0f / 60.0f);
     }
 
-    VoxelObject *obj = &obj_world->objects[obj_idx];
-    printf("(x=%.2f) ", obj->position.x);
+    printf("(x=%.2f) ", voxel_object_position(obj_world, obj_idx).x);
 
-    ASSERT(obj->position.x < 0.0f);
+    ASSERT(voxel_object_position(obj_world, obj_idx).x < 0.0f);
 
     physics_world_destroy(physics);
     voxel_object_world_destroy(obj_world);
@@ -1723,7 +1717,6 @@ TEST(terrain_contact_l_shape_stability)
     int32_t body_idx = physics_world_add_body(physics, obj_idx);
     ASSERT(body_idx >= 0);
 
-    RigidBody *body = physics_world_get_body(physics, body_idx);
     VoxelObject *obj = &obj_world->objects[obj_idx];
 
     int32_t settled_tick = -1;
@@ -1731,14 +1724,14 @@ TEST(terrain_contact_l_shape_stability)
     {
         physics_world_step(physics, 1.0f / 60.0f);
 
-        if (body->flags & PHYS_FLAG_SLEEPING)
+        if (physics->flags[body_idx] & PHYS_FLAG_SLEEPING)
         {
             settled_tick = tick;
             break;
         }
     }
 
-    float final_y = obj->position.y;
+    float final_y = voxel_object_position(obj_world, obj_idx).y;
     bool above_floor = final_y > floor_surface - 0.5f;
     bool below_start = final_y < floor_surface + 2.0f;
 
@@ -1754,88 +1747,3817 @@ TEST(terrain_contact_l_shape_stability)
     return 1;
 }
 
-int main(void)
+static VoxelVolume *create_island_floor(void)
 {
-    platform_time_init();
+    int32_t chunks = 128 / CHUNK_SIZE;
+    VoxelVolume *terrain = volume_create_dims(chunks, chunks, chunks, vec3_create(-6.4f, 0.0f, -6.4f), 0.1f);
+    if (!terrain)
+        return NULL;
+    volume_fill_box(terrain, vec3_create(-6.4f, 0.0f, -6.4f), vec3_create(6.4f, 0.5f, 6.4f), MAT_STONE);
+    volume_rebuild_all_occupancy(terrain);
+    return terrain;
+}
 
-    printf("=== Matrix Math Tests ===\n");
-    RUN_TEST(mat3_multiply_identity);
-    RUN_TEST(mat3_transpose_unit);
+/* Piles of slightly offset boxes dropped onto the floor, one pile per grid cell */
+static void add_island_piles(VoxelObjectWorld *obj_world, PhysicsWorld *physics,
+                             int32_t piles, int32_t per_pile)
+{
+    for (int32_t p = 0; p < piles; p++)
+    {
+        float x = (float)(p % 6) * 2.0f - 5.0f;
+        float z = (float)(p / 6) * 2.0f - 5.0f;
+        for (int32_t k = 0; k < per_pile; k++)
+        {
+            Vec3 pos = vec3_create(x + 0.05f * (float)k, 1.0f + 0.45f * (float)k, z - 0.03f * (float)k);
+            int32_t obj_idx = voxel_object_world_add_box(obj_world, pos, vec3_create(0.25f, 0.25f, 0.25f),
+                                                         MAT_STONE);
+            if (obj_idx >= 0)
+                physics_world_add_body(physics, obj_idx);
+        }
+    }
+}
 
-    printf("\n=== Quaternion/Vector Math Tests ===\n");
-    RUN_TEST(quat_from_axis_angle_identity);
-    RUN_TEST(quat_rotate_vec3_y_axis);
-    RUN_TEST(vec3_clamp_length_under_limit);
-    RUN_TEST(vec3_clamp_length_over_limit);
+TEST(island_partition)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.25f);
+    PhysicsWorld *physics = physics_world_create(obj_world, NULL);
+    ASSERT(physics != NULL);
 
-    printf("\n=== Voxel Object Shape Tests ===\n");
-    RUN_TEST(shape_half_extents_symmetric);
-    RUN_TEST(bounding_sphere_accuracy);
+    /* Two overlapping pairs and a loner */
+    Vec3 positions[5] = {
+        {0.0f, 5.0f, 0.0f}, {0.0f, 5.8f, 0.0f}, {8.0f, 5.0f, 0.0f}, {8.0f, 5.8f, 0.0f}, {-8.0f, 5.0f, 0.0f}};
+    int32_t bodies[5];
+    for (int32_t i = 0; i < 5; i++)
+    {
+        int32_t obj_idx = voxel_object_world_add_box(obj_world, positions[i], vec3_create(0.5f, 0.5f, 0.5f),
+                                                     MAT_STONE);
+        bodies[i] = physics_world_add_body(physics, obj_idx);
+        ASSERT(bodies[i] >= 0);
+    }
 
-    printf("\n=== Object Fragmentation Tests ===\n");
-    RUN_TEST(object_split_creates_fragments);
-    RUN_TEST(object_split_dumbbell);
+    physics_world_step(physics, 1.0f / 60.0f);
 
-    printf("\n=== Object Raycast Tests ===\n");
-    RUN_TEST(object_raycast_hit);
-    RUN_TEST(object_raycast_miss);
+    const PhysicsIslands *islands = physics->islands;
+    printf("(islands=%d, largest=%d) ", islands->count, islands->largest);
+    ASSERT_EQ(islands->count, 3);
+    ASSERT_EQ(islands->largest, 2);
+    ASSERT_EQ(islands->body_island[bodies[0]], islands->body_island[bodies[1]]);
+    ASSERT_EQ(islands->body_island[bodies[2]], islands->body_island[bodies[3]]);
+    ASSERT(islands->body_island[bodies[0]] != islands->body_island[bodies[2]]);
+    ASSERT(islands->body_island[bodies[4]] != islands->body_island[bodies[0]]);
+
+    /* Ids follow lowest body index, members ascend */
+    ASSERT_EQ(islands->body_island[bodies[0]], 0);
+    for (int32_t k = 0; k < islands->count; k++)
+    {
+        for (int32_t b = islands->body_start[k] + 1; b < islands->body_start[k + 1]; b++)
+            ASSERT(islands->bodies[b - 1] < islands->bodies[b]);
+    }
 
-    printf("\n=== Rigid Body Physics Tests ===\n");
-    RUN_TEST(physics_world_create_destroy);
-    RUN_TEST(physics_body_add_remove);
-    RUN_TEST(physics_body_inertia_symmetric);
-    RUN_TEST(physics_integration_gravity);
-    RUN_TEST(physics_sleep_from_rest);
-    RUN_TEST(physics_wake_on_impulse);
-    RUN_TEST(physics_velocity_clamping);
-    RUN_TEST(physics_energy_decreases);
-    RUN_TEST(physics_zero_mass_guard);
-    RUN_TEST(physics_terrain_contact);
-    RUN_TEST(physics_terrain_settling);
-    RUN_TEST(physics_no_jitter_after_sleep);
-    RUN_TEST(physics_performance_128_bodies);
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    return 1;
+}
 
-    printf("\n=== Character Controller Tests ===\n");
-    RUN_TEST(character_init_defaults);
-    RUN_TEST(character_gravity_fall);
+typedef struct
+{
+    RigidBody body;
+    Vec3 velocity;
+    Vec3 angular_velocity;
+    uint8_t flags;
+    VoxelObjectPose pose;
+} IslandBodyState;
+
+static void run_island_scene(int32_t workers, int32_t ticks, IslandBodyState *out, int32_t *out_count)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+    physics_world_set_worker_count(physics, workers);
 
-    printf("\n=== Projectile Tests ===\n");
-    RUN_TEST(projectile_system_create_destroy);
-    RUN_TEST(projectile_ballistic_fire);
-    RUN_TEST(projectile_ballistic_trajectory);
-    RUN_TEST(projectile_lifetime_expiry);
+    add_island_piles(obj_world, physics, 12, 4);
+    for (int32_t tick = 0; tick < ticks; tick++)
+        physics_world_step(physics, 1.0f / 60.0f);
 
-    printf("\n=== Physics Flags Tests ===\n");
-    RUN_TEST(physics_static_flag);
-    RUN_TEST(physics_kinematic_flag);
-    RUN_TEST(physics_add_body_with_mass);
+    *out_count = physics->max_body_index + 1;
+    for (int32_t i = 0; i < *out_count; i++)
+    {
+        out[i].body = physics->bodies[i];
+        out[i].velocity = physics_body_velocity(physics, i);
+        out[i].angular_velocity = physics_body_angular_velocity(physics, i);
+        out[i].flags = physics->flags[i];
+        out[i].pose = voxel_object_pose(obj_world, physics->bodies[i].vobj_index);
+    }
 
-    printf("\n=== Ragdoll Tests ===\n");
-    RUN_TEST(ragdoll_system_create_destroy);
-    RUN_TEST(ragdoll_spawn_despawn);
-    RUN_TEST(ragdoll_update_gravity);
-    RUN_TEST(ragdoll_apply_impulse);
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+}
 
-    printf("\n=== Object-Object Collision Tests ===\n");
-    RUN_TEST(object_collision_basic);
-    RUN_TEST(object_collision_dumbbell_gap);
-    RUN_TEST(object_collision_l_shape);
-    RUN_TEST(object_collision_contact_accuracy);
-    RUN_TEST(object_collision_moving_head_on);
-    RUN_TEST(object_collision_stacking);
-    RUN_TEST(object_collision_wall_friction);
-    RUN_TEST(object_collision_no_interpenetration);
+TEST(island_solve_deterministic)
+{
+    static IslandBodyState serial[PHYS_MAX_BODIES];
+    static IslandBodyState parallel[PHYS_MAX_BODIES];
+    int32_t count_serial = 0;
+    int32_t count_parallel = 0;
+
+    run_island_scene(0, 120, serial, &count_serial);
+    run_island_scene(4, 120, parallel, &count_parallel);
+    ASSERT_EQ(count_serial, 48);
+    ASSERT_EQ(count_parallel, count_serial);
+
+    /* Bit-identical, not just close */
+    int32_t mismatches = 0;
+    for (int32_t i = 0; i < count_serial; i++)
+    {
+        const IslandBodyState *a = &serial[i];
+        const IslandBodyState *b = &parallel[i];
+        if (memcmp(&a->velocity, &b->velocity, sizeof(Vec3)) != 0 ||
+            memcmp(&a->angular_velocity, &b->angular_velocity, sizeof(Vec3)) != 0 ||
+            a->flags != b->flags || a->body.sleep_frames != b->body.sleep_frames ||
+            memcmp(&a->pose.position, &b->pose.position, sizeof(Vec3)) != 0 ||
+            memcmp(&a->pose.orientation, &b->pose.orientation, sizeof(Quat)) != 0)
+            mismatches++;
+    }
+    printf("(mismatches=%d) ", mismatches);
+    ASSERT_EQ(mismatches, 0);
+    return 1;
+}
 
-    printf("\n=== Compound Collider Tests ===\n");
-    RUN_TEST(collider_box_count_basic);
-    RUN_TEST(collider_box_l_shape);
-    RUN_TEST(collider_box_dumbbell);
-    RUN_TEST(terrain_contact_l_shape_stability);
+/* The per-body integration step as integrate_body runs it for one plain tick */
+static void reference_body_step(Vec3 *velocity, Vec3 *angular_velocity, VoxelObjectPose *pose, Vec3 gravity,
+                                bool grounded, float dt)
+{
+    if (!grounded)
+        *velocity = vec3_add(*velocity, vec3_scale(gravity, dt));
+    *velocity = vec3_scale(*velocity, grounded ? PHYS_GROUND_LINEAR_DAMPING : PHYS_LINEAR_DAMPING);
+    *angular_velocity = vec3_scale(*angular_velocity, grounded ? PHYS_GROUND_ANGULAR_DAMPING : PHYS_ANGULAR_DAMPING);
+    *velocity = vec3_clamp_length(*velocity, PHYS_MAX_LINEAR_VELOCITY);
+    *angular_velocity = vec3_clamp_length(*angular_velocity, PHYS_MAX_ANGULAR_VELOCITY);
+    pose->position = vec3_add(pose->position, vec3_scale(*velocity, dt));
+    pose->orientation = quat_integrate(pose->orientation, *angular_velocity, dt);
+}
 
-    printf("\n=== Physics Sleep & Tunneling Tests ===\n");
-    RUN_TEST(physics_no_sleep_midair);
-    RUN_TEST(physics_terrain_bounce);
-    RUN_TEST(physics_no_tunneling);
+/* Small boxes on a 3m grid, well apart, tumbling below the substep speed */
+static int32_t add_flying_bodies(VoxelObjectWorld *obj_world, PhysicsWorld *physics, int32_t count, RngState *rng)
+{
+    int32_t added = 0;
+    for (int32_t i = 0; i < count; i++)
+    {
+        Vec3 position = vec3_create(-60.0f + 3.0f * (float)(i % 40), 30.0f, -60.0f + 3.0f * (float)(i / 40));
+        int32_t obj = voxel_object_world_add_box(obj_world, position, vec3_create(0.2f, 0.2f, 0.2f), MAT_STONE);
+        int32_t body = physics_world_add_body(physics, obj);
+        if (body < 0)
+            break;
+        physics_body_set_velocity(physics, body,
+                                  vec3_create(rng_signed_half(rng) * 6.0f, rng_signed_half(rng) * 6.0f,
+                                              rng_signed_half(rng) * 6.0f));
+        physics_body_set_angular_velocity(physics, body,
+                                          vec3_create(rng_signed_half(rng) * 50.0f, rng_signed_half(rng) * 50.0f,
+                                                      rng_signed_half(rng) * 50.0f));
+        added++;
+    }
+    return added;
+}
+
+static bool body_matches_reference(const PhysicsWorld *physics, int32_t body, Vec3 velocity, Vec3 angular_velocity,
+                                   VoxelObjectPose pose)
+{
+    Vec3 v = physics_body_velocity(physics, body);
+    Vec3 w = physics_body_angular_velocity(physics, body);
+    VoxelObjectPose p = voxel_object_pose(physics->objects, physics->bodies[body].vobj_index);
+    return memcmp(&v, &velocity, sizeof(Vec3)) == 0 && memcmp(&w, &angular_velocity, sizeof(Vec3)) == 0 &&
+           memcmp(&p.position, &pose.position, sizeof(Vec3)) == 0 &&
+           memcmp(&p.orientation, &pose.orientation, sizeof(Quat)) == 0;
+}
+
+TEST(body_batch_integration_matches_scalar_reference)
+{
+    Bounds3D bounds = {-64.0f, 64.0f, 0.0f, 64.0f, -64.0f, 64.0f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, NULL);
+    ASSERT(physics != NULL);
+
+    /* Off the lane width, grounded lanes mixed into each block, spins above the angular clamp */
+    enum { COUNT = 37 };
+    RngState rng;
+    rng_seed(&rng, 38);
+    ASSERT_EQ(add_flying_bodies(obj_world, physics, COUNT, &rng), COUNT);
+    physics->flags[7] |= PHYS_FLAG_STATIC;
+    Vec3 velocity[COUNT], angular_velocity[COUNT];
+    VoxelObjectPose pose[COUNT];
+    for (int32_t i = 0; i < COUNT; i++)
+    {
+        if (i % 3 == 1)
+            physics->flags[i] |= PHYS_FLAG_GROUNDED;
+        velocity[i] = physics_body_velocity(physics, i);
+        angular_velocity[i] = physics_body_angular_velocity(physics, i);
+        pose[i] = voxel_object_pose(obj_world, physics->bodies[i].vobj_index);
+    }
+
+    const float dt = 1.0f / 60.0f;
+    for (int32_t tick = 0; tick < 15; tick++)
+    {
+        physics_world_step(physics, dt);
+        for (int32_t i = 0; i < COUNT; i++)
+        {
+            ASSERT(!(physics->flags[i] & (PHYS_FLAG_FAST | PHYS_FLAG_SLEEPING)));
+            if (i != 7)
+                reference_body_step(&velocity[i], &angular_velocity[i], &pose[i], physics->gravity,
+                                    (physics->flags[i] & PHYS_FLAG_GROUNDED) != 0, dt);
+            ASSERT(body_matches_reference(physics, i, velocity[i], angular_velocity[i], pose[i]));
+        }
+    }
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    return 1;
+}
+
+TEST(body_batch_integration_benchmark)
+{
+    Bounds3D bounds = {-64.0f, 64.0f, 0.0f, 64.0f, -64.0f, 64.0f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, NULL);
+    ASSERT(physics != NULL);
+
+    RngState rng;
+    rng_seed(&rng, 380);
+    int32_t count = add_flying_bodies(obj_world, physics, PHYS_MAX_BODIES, &rng);
+    ASSERT_EQ(count, PHYS_MAX_BODIES);
+    static Vec3 velocity[PHYS_MAX_BODIES], angular_velocity[PHYS_MAX_BODIES];
+    static VoxelObjectPose pose[PHYS_MAX_BODIES];
+    for (int32_t i = 0; i < count; i++)
+    {
+        velocity[i] = physics_body_velocity(physics, i);
+        angular_velocity[i] = physics_body_angular_velocity(physics, i);
+        pose[i] = voxel_object_pose(obj_world, physics->bodies[i].vobj_index);
+    }
+
+    /* Best of five runs of two ticks; the scalar reference integration alone is printed for scale */
+    const int32_t runs = 5;
+    const int32_t rounds = 2;
+    const float dt = 1.0f / 60.0f;
+    float reference_ms = 1e30f, step_ms = 1e30f;
+    for (int32_t run = 0; run < runs; run++)
+    {
+        PlatformTime t0 = platform_time_now();
+        for (int32_t r = 0; r < rounds; r++)
+        {
+            for (int32_t i = 0; i < count; i++)
+                reference_body_step(&velocity[i], &angular_velocity[i], &pose[i], physics->gravity, false, dt);
+        }
+        reference_ms = fminf(reference_ms, platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f / (float)rounds);
+
+        PlatformTime t1 = platform_time_now();
+        for (int32_t r = 0; r < rounds; r++)
+            physics_world_step(physics, dt);
+        step_ms = fminf(step_ms, platform_time_delta_seconds(t1, platform_time_now()) * 1000.0f / (float)rounds);
+    }
+
+    printf("(%d bodies: reference integration %.3fms, step %.3fms) ", count, reference_ms, step_ms);
+    ASSERT(body_matches_reference(physics, 0, velocity[0], angular_velocity[0], pose[0]));
+    ASSERT(body_matches_reference(physics, count - 1, velocity[count - 1], angular_velocity[count - 1],
+                                  pose[count - 1]));
+#ifndef __SANITIZE_ADDRESS__ /* Instrumented loads and stores swamp the timing */
+    ASSERT(step_ms < 1.0f);
+#endif
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    return 1;
+}
+
+TEST(island_sleep_per_island)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+    ASSERT(physics != NULL);
+
+    int32_t obj_rest = voxel_object_world_add_box(obj_world, vec3_create(-3.0f, 0.85f, 0.0f),
+                                                  vec3_create(0.3f, 0.3f, 0.3f), MAT_STONE);
+    int32_t obj_pushed = voxel_object_world_add_box(obj_world, vec3_create(3.0f, 0.85f, -3.0f),
+                                                    vec3_create(0.3f, 0.3f, 0.3f), MAT_STONE);
+    int32_t body_rest = physics_world_add_body(physics, obj_rest);
+    int32_t body_pushed = physics_world_add_body(physics, obj_pushed);
+    ASSERT(body_rest >= 0 && body_pushed >= 0);
+
+    /* A world-wide rule would keep the resting box awake while the other moves */
+    int32_t rest_slept = -1;
+    for (int32_t tick = 0; tick < 240; tick++)
+    {
+        physics_body_set_velocity(physics, body_pushed, vec3_create(0.0f, 0.0f, 1.0f));
+        physics_world_step(physics, 1.0f / 60.0f);
+        ASSERT(!physics_body_is_sleeping(physics, body_pushed));
+        if (rest_slept < 0 && physics_body_is_sleeping(physics, body_rest))
+            rest_slept = tick;
+    }
+    printf("(rest slept at %d) ", rest_slept);
+    ASSERT(rest_slept >= 0);
+
+    /* Box dropped onto the sleeper joins its island: members share one sleep state */
+    int32_t obj_drop = voxel_object_world_add_box(obj_world, vec3_create(-3.0f, 2.5f, 0.0f),
+                                                  vec3_create(0.2f, 0.2f, 0.2f), MAT_STONE);
+    int32_t body_drop = physics_world_add_body(physics, obj_drop);
+    ASSERT(body_drop >= 0);
+
+    bool shared = false;
+    for (int32_t tick = 0; tick < 600; tick++)
+    {
+        physics_world_step(physics, 1.0f / 60.0f);
+        const PhysicsIslands *islands = physics->islands;
+        int32_t island_rest = islands->body_island[body_rest];
+        if (island_rest >= 0 && island_rest == islands->body_island[body_drop])
+        {
+            shared = true;
+            ASSERT_EQ(physics_body_is_sleeping(physics, body_rest), physics_body_is_sleeping(physics, body_drop));
+        }
+    }
+    printf("(shared=%d) ", shared ? 1 : 0);
+    ASSERT(shared);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(island_solve_benchmark)
+{
+    int32_t worker_counts[3] = {0, 2, 4};
+    for (int32_t w = 0; w < 3; w++)
+    {
+        VoxelVolume *terrain = create_island_floor();
+        Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+        VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+        PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+        ASSERT(physics_world_set_worker_count(physics, worker_counts[w]));
+
+        add_island_piles(obj_world, physics, 36, 6);
+
+        PlatformTime t0 = platform_time_now();
+        for (int32_t tick = 0; tick < 120; tick++)
+            physics_world_step(physics, 1.0f / 60.0f);
+        float elapsed_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+
+        printf("\n    workers=%d bodies=%d islands=%d largest=%d: 120 ticks in %.1fms",
+               physics_workers_count(physics->workers), physics_world_get_body_count(physics),
+               physics->islands->count, physics->islands->largest, elapsed_ms);
+
+        physics_world_destroy(physics);
+        voxel_object_world_destroy(obj_world);
+        volume_destroy(terrain);
+    }
+    printf("\n    ");
+    return 1;
+}
+
+/* Same grid as add_island_piles, but boxes start 5 cm apart so stacks settle instead of popping apart */
+static void add_resting_stacks(VoxelObjectWorld *obj_world, PhysicsWorld *physics,
+                               int32_t piles, int32_t per_pile)
+{
+    for (int32_t p = 0; p < piles; p++)
+    {
+        float x = (float)(p % 6) * 2.0f - 5.0f;
+        float z = (float)(p / 6) * 2.0f - 5.0f;
+        for (int32_t k = 0; k < per_pile; k++)
+        {
+            Vec3 pos = vec3_create(x + 0.03f * (float)k, 0.8f + 0.55f * (float)k, z - 0.02f * (float)k);
+            int32_t obj_idx = voxel_object_world_add_box(obj_world, pos, vec3_create(0.25f, 0.25f, 0.25f),
+                                                         MAT_STONE);
+            if (obj_idx >= 0)
+                physics_world_add_body(physics, obj_idx);
+        }
+    }
+}
+
+TEST(manifold_persists_and_warm_starts)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.25f);
+    PhysicsWorld *physics = physics_world_create(obj_world, NULL);
+
+    int32_t obj_base = voxel_object_world_add_box(obj_world, vec3_create(0.0f, 5.0f, 0.0f),
+                                                  vec3_create(1.0f, 0.5f, 1.0f), MAT_STONE);
+    int32_t obj_top = voxel_object_world_add_box(obj_world, vec3_create(0.1f, 6.2f, -0.1f),
+                                                 vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    int32_t body_base = physics_world_add_body(physics, obj_base);
+    int32_t body_top = physics_world_add_body(physics, obj_top);
+    ASSERT(body_base >= 0 && body_top >= 0);
+    physics->flags[body_base] |= PHYS_FLAG_STATIC;
+
+    int32_t max_points = 0;
+    int32_t warm_started = 0;
+    int32_t slept = -1;
+    float supported = 0.0f;
+    for (int32_t tick = 0; tick < 300 && slept < 0; tick++)
+    {
+        physics_world_step(physics, 1.0f / 60.0f);
+        ContactManifold *m = physics_manifolds_find(physics->manifolds, body_top, body_base);
+        if (!m)
+            continue;
+        ASSERT_EQ(m->body_a, body_base < body_top ? body_base : body_top);
+        if (m->point_count > max_points)
+            max_points = m->point_count;
+        warm_started += physics->manifolds->warm_started;
+
+        supported = 0.0f;
+        for (int32_t i = 0; i < m->point_count; i++)
+        {
+            ASSERT(m->points[i].normal_impulse >= 0.0f);
+            supported += m->points[i].normal_impulse;
+        }
+        if (physics_body_is_sleeping(physics, body_top))
+            slept = tick;
+    }
+
+    /* Before sleeping, the accumulated impulse carried the top box's weight */
+    RigidBody *top = physics_world_get_body(physics, body_top);
+    float weight_impulse = top->mass * -PHYS_GRAVITY_Y / 60.0f;
+    printf("(points=%d, warm=%d, slept=%d, impulse=%.1f/%.1f) ", max_points, warm_started, slept,
+           supported, weight_impulse);
+    ASSERT(max_points >= 2);
+    ASSERT(warm_started > 0);
+    ASSERT(slept >= 0);
+    ASSERT(supported > weight_impulse * 0.5f && supported < weight_impulse * 2.0f);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    return 1;
+}
+
+TEST(manifold_stacks_fall_asleep)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+
+    add_resting_stacks(obj_world, physics, 24, 3);
+    int32_t body_count = physics_world_get_body_count(physics);
+
+    int32_t asleep = 0;
+    for (int32_t tick = 0; tick < 600; tick++)
+        physics_world_step(physics, 1.0f / 60.0f);
+    for (int32_t i = 0; i <= physics->max_body_index; i++)
+    {
+        if (physics_body_is_sleeping(physics, i))
+            asleep++;
+    }
+
+    printf("(asleep=%d/%d, manifolds=%d) ", asleep, body_count, physics->manifolds->count);
+    ASSERT(physics->manifolds->count > 0);
+    ASSERT(asleep * 4 >= body_count * 3);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return 1;
+}
+
+static void random_sap_box(RngState *rng, float extent, Vec3 *out_min, Vec3 *out_max)
+{
+    Vec3 c = vec3_create(rng_range_f32(rng, -extent, extent), rng_range_f32(rng, -extent, extent),
+                         rng_range_f32(rng, -extent, extent));
+    Vec3 he = vec3_create(rng_range_f32(rng, 0.2f, 1.0f), rng_range_f32(rng, 0.2f, 1.0f),
+                          rng_range_f32(rng, 0.2f, 1.0f));
+    *out_min = vec3_sub(c, he);
+    *out_max = vec3_add(c, he);
+}
+
+static bool sap_boxes_overlap(const Vec3 *mins, const Vec3 *maxs, int32_t a, int32_t b)
+{
+    return mins[a].x <= maxs[b].x && mins[b].x <= maxs[a].x &&
+           mins[a].y <= maxs[b].y && mins[b].y <= maxs[a].y &&
+           mins[a].z <= maxs[b].z && mins[b].z <= maxs[a].z;
+}
+
+TEST(sap_matches_brute_force)
+{
+    enum { N = 600 };
+    SAPBroadphase *sap = sap_create(N);
+    ASSERT(sap != NULL);
+
+    static Vec3 mins[N], maxs[N];
+    static bool live[N];
+    static uint8_t before[N][N];
+    RngState rng;
+    rng_seed(&rng, 1234);
+
+    for (int32_t i = 0; i < N; i++)
+    {
+        random_sap_box(&rng, 12.0f, &mins[i], &maxs[i]);
+        live[i] = true;
+        sap_update_body(sap, i, mins[i], maxs[i], true);
+    }
+
+    for (int32_t a = 0; a < N; a++)
+    {
+        for (int32_t b = a + 1; b < N; b++)
+            before[a][b] = sap_boxes_overlap(mins, maxs, a, b) ? 1 : 0;
+    }
+
+    int32_t mismatches = 0;
+    int32_t max_pairs = 0;
+    for (int32_t frame = 0; frame < 40; frame++)
+    {
+        sap_clear_events(sap);
+        for (int32_t i = 0; i < N; i++)
+        {
+            uint32_t roll = rng_range_u32(&rng, 100);
+            if (roll < 2)
+            {
+                live[i] = !live[i];
+                if (live[i])
+                    random_sap_box(&rng, 12.0f, &mins[i], &maxs[i]);
+                sap_update_body(sap, i, mins[i], maxs[i], live[i]);
+            }
+            else if (roll < 30 && live[i])
+            {
+                Vec3 d = vec3_create(rng_signed_half(&rng), rng_signed_half(&rng), rng_signed_half(&rng));
+                mins[i] = vec3_add(mins[i], d);
+                maxs[i] = vec3_add(maxs[i], d);
+                sap_update_body(sap, i, mins[i], maxs[i], true);
+            }
+        }
+
+        int32_t brute = 0;
+        for (int32_t a = 0; a < N; a++)
+        {
+            for (int32_t b = a + 1; b < N; b++)
+            {
+                bool now = live[a] && live[b] && sap_boxes_overlap(mins, maxs, a, b);
+                brute += now ? 1 : 0;
+                if (now != sap_has_pair(sap, a, b))
+                    mismatches++;
+
+                /* Every change since the last frame shows up as an event */
+                bool found = (now == (before[a][b] != 0));
+                const SAPPair *events = NULL;
+                int32_t event_count = 0;
+                if (!found)
+                    events = now ? sap_get_began(sap, &event_count) : sap_get_ended(sap, &event_count);
+                for (int32_t e = 0; e < event_count && !found; e++)
+                    found = events[e].body_a == a && events[e].body_b == b;
+                if (!found)
+                    mismatches++;
+                before[a][b] = now ? 1 : 0;
+            }
+        }
+
+        int32_t pair_count = 0;
+        sap_get_pairs(sap, &pair_count);
+        if (pair_count != brute)
+            mismatches++;
+        if (pair_count > max_pairs)
+            max_pairs = pair_count;
+    }
+
+    printf("(pairs<=%d, mismatches=%d) ", max_pairs, mismatches);
+    ASSERT_EQ(mismatches, 0);
+
+    sap_destroy(sap);
+    return 1;
+}
+
+TEST(sap_no_pair_cap)
+{
+    SAPBroadphase *sap = sap_create(400);
+    ASSERT(sap != NULL);
+
+    for (int32_t i = 0; i < 400; i++)
+    {
+        float o = (float)i * 0.001f;
+        sap_update_body(sap, i, vec3_create(o, o, o), vec3_create(1.0f + o, 1.0f + o, 1.0f + o), true);
+    }
+
+    int32_t pair_count = 0;
+    const SAPPair *pairs = sap_get_pairs(sap, &pair_count);
+    printf("(pairs=%d) ", pair_count);
+    ASSERT_EQ(pair_count, 400 * 399 / 2);
+    for (int32_t p = 0; p < pair_count; p++)
+        ASSERT(pairs[p].body_a < pairs[p].body_b);
+
+    /* Removing every other body ends exactly its pairs */
+    sap_clear_events(sap);
+    for (int32_t i = 0; i < 400; i += 2)
+        sap_remove_body(sap, i);
+    int32_t ended = 0;
+    sap_get_ended(sap, &ended);
+    sap_get_pairs(sap, &pair_count);
+    ASSERT_EQ(pair_count, 200 * 199 / 2);
+    ASSERT_EQ(ended, 400 * 399 / 2 - 200 * 199 / 2);
+    ASSERT(!sap_has_pair(sap, 0, 1));
+    ASSERT(sap_has_pair(sap, 1, 3));
+
+    sap_destroy(sap);
+    return 1;
+}
+
+TEST(sap_benchmark)
+{
+    enum { N = 4096 };
+    SAPBroadphase *sap = sap_create(N);
+    ASSERT(sap != NULL);
+
+    static Vec3 mins[N], maxs[N];
+    RngState rng;
+    rng_seed(&rng, 99);
+    for (int32_t i = 0; i < N; i++)
+    {
+        random_sap_box(&rng, 40.0f, &mins[i], &maxs[i]);
+        sap_update_body(sap, i, mins[i], maxs[i], true);
+    }
+
+    /* A tenth of the bodies move a little each frame; the rest are asleep and never touched */
+    PlatformTime t0 = platform_time_now();
+    for (int32_t frame = 0; frame < 100; frame++)
+    {
+        sap_clear_events(sap);
+        for (int32_t i = frame % 10; i < N; i += 10)
+        {
+            Vec3 d = vec3_create(rng_signed_half(&rng) * 0.2f, rng_signed_half(&rng) * 0.2f,
+                                 rng_signed_half(&rng) * 0.2f);
+            mins[i] = vec3_add(mins[i], d);
+            maxs[i] = vec3_add(maxs[i], d);
+            sap_update_body(sap, i, mins[i], maxs[i], true);
+        }
+    }
+    float elapsed_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+
+    int32_t pair_count = 0;
+    sap_get_pairs(sap, &pair_count);
+    printf("(%d bodies, %d pairs: 100 frames in %.1fms) ", N, pair_count, elapsed_ms);
+
+    sap_destroy(sap);
+    return 1;
+}
+
+TEST(fast_body_speculative_contact)
+{
+    Bounds3D bounds = {-8.0f, 8.0f, 0.0f, 16.0f, -8.0f, 8.0f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, NULL);
+    physics->gravity = vec3_zero();
+
+    /* Thin plate: a 28 m/s box steps clean over it without speculative contacts */
+    int32_t obj_plate = voxel_object_world_add_box(obj_world, vec3_create(0.0f, 5.0f, 0.0f),
+                                                   vec3_create(0.05f, 1.0f, 1.0f), MAT_STONE);
+    int32_t obj_fast = voxel_object_world_add_box(obj_world, vec3_create(-3.2f, 5.0f, 0.0f),
+                                                  vec3_create(0.1f, 0.1f, 0.1f), MAT_STONE);
+    int32_t obj_idle = voxel_object_world_add_box(obj_world, vec3_create(3.0f, 5.0f, 3.0f),
+                                                  vec3_create(0.1f, 0.1f, 0.1f), MAT_STONE);
+    int32_t body_plate = physics_world_add_body(physics, obj_plate);
+    int32_t body_fast = physics_world_add_body(physics, obj_fast);
+    int32_t body_idle = physics_world_add_body(physics, obj_idle);
+    ASSERT(body_plate >= 0 && body_fast >= 0 && body_idle >= 0);
+    physics->flags[body_plate] |= PHYS_FLAG_STATIC;
+    physics_body_set_velocity(physics, body_fast, vec3_create(28.0f, 0.0f, 0.0f));
+
+    bool swept = false;
+    for (int32_t tick = 0; tick < 30; tick++)
+    {
+        physics_world_step(physics, 1.0f / 60.0f);
+        if (physics->flags[body_fast] & PHYS_FLAG_FAST)
+            swept = true;
+        ASSERT(!(physics->flags[body_idle] & PHYS_FLAG_FAST));
+    }
+
+    float x = voxel_object_position(obj_world, obj_fast).x;
+    printf("(x=%.2f) ", x);
+    ASSERT(swept);
+    ASSERT(x < 0.0f);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    return 1;
+}
+
+/* 500 boxes settled on the floor, then one projectile crossing above them */
+static int32_t add_resting_field(VoxelObjectWorld *obj_world, PhysicsWorld *physics)
+{
+    int32_t added = 0;
+    for (int32_t gz = 0; gz < 20 && added < 500; gz++)
+    {
+        for (int32_t gx = 0; gx < 25 && added < 500; gx++)
+        {
+            Vec3 pos = vec3_create(-6.0f + 0.48f * (float)gx, 0.62f, -5.0f + 0.5f * (float)gz);
+            int32_t obj = voxel_object_world_add_box(obj_world, pos, vec3_create(0.1f, 0.1f, 0.1f), MAT_STONE);
+            if (obj < 0 || physics_world_add_body(physics, obj) < 0)
+                return added;
+            added++;
+        }
+    }
+    return added;
+}
+
+TEST(fast_body_benchmark)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+
+    int32_t resting = add_resting_field(obj_world, physics);
+    ASSERT_EQ(resting, 500);
+    for (int32_t tick = 0; tick < 120; tick++)
+        physics_world_step(physics, 1.0f / 60.0f);
+
+    int32_t obj = voxel_object_world_add_box(obj_world, vec3_create(-5.0f, 3.0f, 0.0f),
+                                             vec3_create(0.1f, 0.1f, 0.1f), MAT_STONE);
+    int32_t fast = physics_world_add_body(physics, obj);
+    ASSERT(fast >= 0);
+
+    /* Kept at 25 m/s, bouncing between x = +-5, so it is fast every tick */
+    float dir = 1.0f;
+    PlatformTime t0 = platform_time_now();
+    for (int32_t tick = 0; tick < 120; tick++)
+    {
+        float x = voxel_object_position(obj_world, obj).x;
+        if (x > 5.0f)
+            dir = -1.0f;
+        else if (x < -5.0f)
+            dir = 1.0f;
+        physics_body_set_velocity(physics, fast, vec3_create(25.0f * dir, 0.0f, 0.0f));
+        physics_world_step(physics, 1.0f / 60.0f);
+    }
+    float elapsed_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+
+    int32_t asleep = 0;
+    for (int32_t i = 0; i <= physics->max_body_index; i++)
+    {
+        if (physics_body_is_sleeping(physics, i))
+            asleep++;
+    }
+    printf("(1 fast + %d resting, %d asleep: 120 ticks in %.1fms) ", resting, asleep, elapsed_ms);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(terrain_contacts_airborne_early_out)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    int32_t obj_idx = voxel_object_world_add_box(obj_world, vec3_create(0.05f, 3.0f, 0.05f),
+                                                 vec3_create(0.3f, 0.3f, 0.3f), MAT_STONE);
+    VoxelObject *obj = &obj_world->objects[obj_idx];
+
+    TerrainContactSet set;
+    int32_t count = physics_terrain_contacts(terrain, obj, voxel_object_pose(obj_world, obj_idx), &set);
+    printf("(count=%d, read=%d) ", count, set.samples_read);
+    ASSERT_EQ(count, 0);
+    ASSERT_EQ(set.samples_read, 0);
+
+    ASSERT(physics_terrain_box_empty(terrain, vec3_create(-1.0f, 2.0f, -1.0f), vec3_create(1.0f, 3.0f, 1.0f)));
+    ASSERT(!physics_terrain_box_empty(terrain, vec3_create(-1.0f, 0.45f, -1.0f), vec3_create(1.0f, 2.0f, 1.0f)));
+    ASSERT(physics_terrain_box_empty(terrain, vec3_create(20.0f, 0.0f, 20.0f), vec3_create(21.0f, 1.0f, 21.0f)));
+
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(terrain_contacts_face_normals)
+{
+    VoxelVolume *terrain = create_island_floor();
+    volume_fill_box(terrain, vec3_create(2.0f, 0.0f, -2.0f), vec3_create(3.0f, 4.0f, 2.0f), MAT_STONE);
+    volume_rebuild_all_occupancy(terrain);
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+
+    /* Sunk 0.03 into the floor */
+    int32_t floor_idx = voxel_object_world_add_box(obj_world, vec3_create(-2.05f, 0.77f, 0.05f),
+                                                   vec3_create(0.3f, 0.3f, 0.3f), MAT_STONE);
+    /* Pushed 0.03 into the wall's -x face, clear of the floor */
+    int32_t wall_idx = voxel_object_world_add_box(obj_world, vec3_create(1.73f, 2.05f, 0.05f),
+                                                  vec3_create(0.3f, 0.3f, 0.3f), MAT_STONE);
+
+    TerrainContactSet set;
+    int32_t count = physics_terrain_contacts(terrain, &obj_world->objects[floor_idx], voxel_object_pose(obj_world, floor_idx), &set);
+    printf("(floor: %d of %d, ground=%d", count, set.candidate_count, set.ground_count);
+    ASSERT(count >= 3 && count <= PHYS_TERRAIN_MAX_CONTACTS);
+    ASSERT(set.candidate_count > count);
+    ASSERT(set.ground_count > 0);
+    for (int32_t i = 0; i < count; i++)
+    {
+        ASSERT(fabsf(set.contacts[i].normal.y - 1.0f) < 1e-4f);
+        ASSERT(fabsf(set.contacts[i].penetration - 0.03f) < 0.005f);
+        ASSERT_EQ(set.contacts[i].material, MAT_STONE);
+    }
+    ASSERT(fabsf(set.support_centroid.x + 2.05f) < 0.05f);
+    ASSERT(fabsf(set.support_centroid.z - 0.05f) < 0.05f);
+
+    count = physics_terrain_contacts(terrain, &obj_world->objects[wall_idx], voxel_object_pose(obj_world, wall_idx), &set);
+    printf(", wall: %d of %d) ", count, set.candidate_count);
+    ASSERT(count >= 3);
+    ASSERT_EQ(set.ground_count, 0);
+    for (int32_t i = 0; i < count; i++)
+    {
+        ASSERT(fabsf(set.contacts[i].normal.x + 1.0f) < 1e-4f);
+        ASSERT(fabsf(set.contacts[i].penetration - 0.03f) < 0.005f);
+    }
+
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(terrain_contacts_benchmark)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+
+    int32_t grounded[64];
+    int32_t airborne[64];
+    for (int32_t i = 0; i < 64; i++)
+    {
+        float x = (float)(i % 8) * 1.4f - 5.0f;
+        float z = (float)(i / 8) * 1.4f - 5.0f;
+        grounded[i] = voxel_object_world_add_box(obj_world, vec3_create(x, 0.77f, z),
+                                                 vec3_create(0.3f, 0.3f, 0.3f), MAT_STONE);
+        airborne[i] = voxel_object_world_add_box(obj_world, vec3_create(x, 4.0f, z),
+                                                 vec3_create(0.3f, 0.3f, 0.3f), MAT_STONE);
+    }
+
+    TerrainContactSet set;
+    int32_t contacts = 0;
+    PlatformTime t0 = platform_time_now();
+    for (int32_t round = 0; round < 100; round++)
+        for (int32_t i = 0; i < 64; i++)
+            contacts += physics_terrain_contacts(terrain, &obj_world->objects[grounded[i]], voxel_object_pose(obj_world, grounded[i]), &set);
+    float grounded_us = platform_time_delta_seconds(t0, platform_time_now()) * 1e6f / 6400.0f;
+
+    int32_t read = 0;
+    t0 = platform_time_now();
+    for (int32_t round = 0; round < 100; round++)
+    {
+        for (int32_t i = 0; i < 64; i++)
+        {
+            physics_terrain_contacts(terrain, &obj_world->objects[airborne[i]], voxel_object_pose(obj_world, airborne[i]), &set);
+            read += set.samples_read;
+        }
+    }
+    float airborne_us = platform_time_delta_seconds(t0, platform_time_now()) * 1e6f / 6400.0f;
+
+    printf("(%d surface samples: grounded %.2fus, airborne %.3fus per body) ",
+           obj_world->objects[grounded[0]].surface_voxel_count, grounded_us, airborne_us);
+    ASSERT_EQ(contacts, 6400 * PHYS_TERRAIN_MAX_CONTACTS);
+    ASSERT_EQ(read, 0);
+
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(pair_cache_separating_axis_early_out)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, NULL);
+    physics->gravity = vec3_zero();
+
+    /* A diamond next to a box: the shape boxes overlap, the hulls do not */
+    int32_t obj_a = voxel_object_world_add_box(obj_world, vec3_create(0.0f, 5.0f, 0.0f),
+                                               vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    int32_t obj_b = voxel_object_world_add_box(obj_world, vec3_create(0.95f, 5.95f, 0.0f),
+                                               vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    voxel_object_set_orientation(obj_world, obj_a, quat_from_axis_angle(vec3_create(0.0f, 0.0f, 1.0f), K_PI * 0.25f));
+    ASSERT(physics_world_add_body(physics, obj_a) >= 0);
+    ASSERT(physics_world_add_body(physics, obj_b) >= 0);
+
+    PhysicsPairCache *cache = physics->pair_cache;
+    physics_world_step(physics, 1.0f / 60.0f);
+    int32_t first_runs = cache->gjk_runs;
+    ASSERT_EQ(cache->hull_tests, 1);
+    ASSERT_EQ(cache->epa_runs, 0);
+
+    int32_t rejects = 0;
+    int32_t runs = 0;
+    for (int32_t tick = 0; tick < 30; tick++)
+    {
+        physics_world_step(physics, 1.0f / 60.0f);
+        ASSERT_EQ(cache->hull_tests, 1);
+        rejects += cache->axis_rejects;
+        runs += cache->gjk_runs;
+    }
+
+    printf("(first=%d gjk, then %d rejects, %d gjk) ", first_runs, rejects, runs);
+    ASSERT_EQ(first_runs, 1);
+    ASSERT_EQ(rejects, 30);
+    ASSERT_EQ(runs, 0);
+    ASSERT_EQ(physics->manifolds->count, 0);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    return 1;
+}
+
+TEST(pair_cache_reuses_resting_contact)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.25f);
+    PhysicsWorld *physics = physics_world_create(obj_world, NULL);
+
+    int32_t obj_base = voxel_object_world_add_box(obj_world, vec3_create(0.0f, 5.0f, 0.0f),
+                                                  vec3_create(1.0f, 0.5f, 1.0f), MAT_STONE);
+    int32_t obj_top = voxel_object_world_add_box(obj_world, vec3_create(0.1f, 6.2f, -0.1f),
+                                                 vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    int32_t body_base = physics_world_add_body(physics, obj_base);
+    int32_t body_top = physics_world_add_body(physics, obj_top);
+    ASSERT(body_base >= 0 && body_top >= 0);
+    physics->flags[body_base] |= PHYS_FLAG_STATIC;
+
+    int32_t tests = 0;
+    int32_t reuses = 0;
+    int32_t epa_runs = 0;
+    for (int32_t tick = 0; tick < 300 && !physics_body_is_sleeping(physics, body_top); tick++)
+    {
+        physics_world_step(physics, 1.0f / 60.0f);
+        tests += physics->pair_cache->hull_tests;
+        reuses += physics->pair_cache->contact_reuses;
+        epa_runs += physics->pair_cache->epa_runs;
+    }
+
+    float top_y = voxel_object_position(obj_world, obj_top).y;
+    printf("(tests=%d, reused=%d, epa=%d, top_y=%.3f) ", tests, reuses, epa_runs, top_y);
+    ASSERT(physics_body_is_sleeping(physics, body_top));
+    ASSERT(reuses > 0);
+    ASSERT(epa_runs < tests);
+    ASSERT(fabsf(top_y - 6.0f) < 0.1f);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    return 1;
+}
+
+TEST(pair_cache_benchmark)
+{
+    for (int32_t cached = 0; cached < 2; cached++)
+    {
+        VoxelVolume *terrain = create_island_floor();
+        Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+        VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+        PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+
+        PhysicsPairCache *cache = physics->pair_cache;
+        if (!cached)
+            physics->pair_cache = NULL;
+
+        add_island_piles(obj_world, physics, 36, 6);
+
+        int32_t tests = 0, rejects = 0, reuses = 0, gjk_iterations = 0, epa_runs = 0;
+        PlatformTime t0 = platform_time_now();
+        for (int32_t tick = 0; tick < 120; tick++)
+        {
+            physics_world_step(physics, 1.0f / 60.0f);
+            if (cached)
+            {
+                tests += cache->hull_tests;
+                rejects += cache->axis_rejects;
+                reuses += cache->contact_reuses;
+                gjk_iterations += cache->gjk_iterations;
+                epa_runs += cache->epa_runs;
+            }
+        }
+        float elapsed_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+
+        if (cached)
+            printf("\n    cached: 120 ticks in %.1fms (%d hull tests: %d axis rejects, %d reused, "
+                   "%d EPA, %d GJK iterations)",
+                   elapsed_ms, tests, rejects, reuses, epa_runs, gjk_iterations);
+        else
+            printf("\n    uncached: 120 ticks in %.1fms", elapsed_ms);
+
+        /* Resting and touching pairs re-measure their cached contact; EPA is
+         * left to new and deepening contacts */
+        if (cached)
+            ASSERT(reuses >= epa_runs);
+
+        physics->pair_cache = cache;
+        physics_world_destroy(physics);
+        voxel_object_world_destroy(obj_world);
+        volume_destroy(terrain);
+    }
+    printf("\n    ");
+    return 1;
+}
+
+/* Largest distance any point lies outside the hull's face planes */
+static float hull_max_outside(const ConvexHull *hull, const Vec3 *points, int32_t count)
+{
+    float worst = -1e30f;
+    for (int32_t i = 0; i < count; i++)
+    {
+        for (int32_t f = 0; f < hull->face_count; f++)
+        {
+            float d = vec3_dot(hull->faces[f].normal, points[i]) - hull->faces[f].dist;
+            if (d > worst)
+                worst = d;
+        }
+    }
+    return worst;
+}
+
+/* Largest gap between the hull's support and the brute-force support over the points */
+static float hull_support_error(const ConvexHull *hull, const Vec3 *points, int32_t count, RngState *rng)
+{
+    float worst = 0.0f;
+    for (int32_t d = 0; d < 64; d++)
+    {
+        Vec3 dir = vec3_normalize(vec3_create(rng_range_f32(rng, -1.0f, 1.0f), rng_range_f32(rng, -1.0f, 1.0f),
+                                              rng_range_f32(rng, -1.0f, 1.0f)));
+        float brute = -1e30f;
+        for (int32_t i = 0; i < count; i++)
+            brute = maxf(brute, vec3_dot(points[i], dir));
+        int32_t idx = convex_hull_support(hull, dir, 0);
+        float err = fabsf(brute - vec3_dot(hull->vertices[idx], dir));
+        if (err > worst)
+            worst = err;
+    }
+    return worst;
+}
+
+static void remove_object_voxel(VoxelObjectWorld *world, int32_t obj_index, int32_t x, int32_t y, int32_t z)
+{
+    VoxelObject *obj = &world->objects[obj_index];
+    obj->voxels[vobj_index(x, y, z)].material = 0;
+    obj->voxel_count--;
+    obj->voxel_revision++;
+    voxel_object_recalc_shape(world, obj_index);
+}
+
+TEST(convex_hull_box_reduces_to_corners)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    VoxelObjectWorld *world = voxel_object_world_create(bounds, 0.1f);
+    int32_t idx = voxel_object_world_add_box(world, vec3_create(0.0f, 5.0f, 0.0f),
+                                             vec3_create(0.8f, 0.5f, 0.3f), MAT_STONE);
+    VoxelObject *obj = &world->objects[idx];
+
+    ConvexHull hull;
+    convex_hull_build(obj->surface_voxels, obj->surface_voxel_count, &hull);
+
+    printf("(%d points -> %d vertices, %d faces) ", obj->surface_voxel_count, hull.vertex_count, hull.face_count);
+    ASSERT_EQ(hull.vertex_count, 8);
+    ASSERT_EQ(hull.face_count, 12);
+    ASSERT(hull_max_outside(&hull, obj->surface_voxels, obj->surface_voxel_count) < 1e-4f);
+
+    voxel_object_world_destroy(world);
+    return 1;
+}
+
+TEST(convex_hull_matches_brute_force)
+{
+    RngState rng;
+    rng_seed(&rng, 37);
+
+    static Vec3 points[500];
+    for (int32_t trial = 0; trial < 8; trial++)
+    {
+        int32_t count = 20 + trial * 60;
+        for (int32_t i = 0; i < count; i++)
+        {
+            Vec3 p = vec3_create(rng_range_f32(&rng, -1.0f, 1.0f), rng_range_f32(&rng, -1.0f, 1.0f),
+                                 rng_range_f32(&rng, -1.0f, 1.0f));
+            points[i] = vec3_scale(vec3_normalize(p), rng_range_f32(&rng, 0.5f, 1.0f));
+        }
+
+        ConvexHull hull;
+        convex_hull_build(points, count, &hull);
+        ASSERT(hull.vertex_count >= 4 && hull.face_count >= 4);
+        ASSERT(hull_max_outside(&hull, points, count) < 1e-4f);
+        ASSERT(hull_support_error(&hull, points, count, &rng) < 1e-4f);
+    }
+
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    VoxelObjectWorld *world = voxel_object_world_create(bounds, 0.1f);
+    int32_t idx = create_dumbbell_object(world, vec3_create(0.0f, 5.0f, 0.0f), MAT_STONE);
+    VoxelObject *obj = &world->objects[idx];
+    ConvexHull hull;
+    convex_hull_build(obj->surface_voxels, obj->surface_voxel_count, &hull);
+    printf("(dumbbell: %d points -> %d vertices) ", obj->surface_voxel_count, hull.vertex_count);
+    ASSERT(hull_max_outside(&hull, obj->surface_voxels, obj->surface_voxel_count) < 1e-4f);
+    ASSERT(hull_support_error(&hull, obj->surface_voxels, obj->surface_voxel_count, &rng) < 1e-4f);
+
+    voxel_object_world_destroy(world);
+    return 1;
+}
+
+TEST(convex_hull_update_reuses_for_interior_damage)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    VoxelObjectWorld *world = voxel_object_world_create(bounds, 0.1f);
+    int32_t idx = voxel_object_world_add_box(world, vec3_create(0.0f, 5.0f, 0.0f),
+                                             vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    VoxelObject *obj = &world->objects[idx];
+
+    ConvexHull hull;
+    convex_hull_build(obj->surface_voxels, obj->surface_voxel_count, &hull);
+    hull.margin = 0.04f;
+
+    /* Find the box's voxel range in the grid */
+    int32_t lo = VOBJ_GRID_SIZE, hi = -1;
+    for (int32_t x = 0; x < VOBJ_GRID_SIZE; x++)
+    {
+        if (obj->voxels[vobj_index(x, VOBJ_GRID_SIZE / 2, VOBJ_GRID_SIZE / 2)].material != 0)
+        {
+            if (x < lo)
+                lo = x;
+            hi = x;
+        }
+    }
+    ASSERT(hi > lo + 2);
+    int32_t mid = (lo + hi) / 2;
+
+    /* A dent in the middle of the top face is inside the hull */
+    remove_object_voxel(world, idx, mid, hi, mid);
+    HullUpdate dent = convex_hull_update(&hull, obj->surface_voxels, obj->surface_voxel_count);
+    ASSERT_EQ(dent, HULL_UPDATE_REUSED);
+    ASSERT_EQ(hull.vertex_count, 8);
+
+    /* A corner takes hull vertices with it: rebuilt */
+    remove_object_voxel(world, idx, hi, hi, hi);
+    HullUpdate corner = convex_hull_update(&hull, obj->surface_voxels, obj->surface_voxel_count);
+    ConvexHull full;
+    convex_hull_build(obj->surface_voxels, obj->surface_voxel_count, &full);
+
+    RngState rng;
+    rng_seed(&rng, 11);
+    printf("(corner: %d -> %d vertices, full build %d) ", 8, hull.vertex_count, full.vertex_count);
+    ASSERT_EQ(corner, HULL_UPDATE_REBUILT);
+    ASSERT(hull.margin == 0.04f);
+    ASSERT_EQ(hull.vertex_count, full.vertex_count);
+    ASSERT(hull_max_outside(&hull, obj->surface_voxels, obj->surface_voxel_count) < 1e-4f);
+    ASSERT(hull_support_error(&hull, obj->surface_voxels, obj->surface_voxel_count, &rng) < 1e-4f);
+
+    voxel_object_world_destroy(world);
+    return 1;
+}
+
+/* Chips 200 surface voxels off a dumbbell, timing the incremental update against a full build per edit */
+static void hull_damage_run(int32_t counts[2], double update_s[2], double *build_s, float *worst_error)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    VoxelObjectWorld *world = voxel_object_world_create(bounds, 0.1f);
+    int32_t idx = create_dumbbell_object(world, vec3_create(0.0f, 5.0f, 0.0f), MAT_STONE);
+    VoxelObject *obj = &world->objects[idx];
+
+    ConvexHull incremental;
+    ConvexHull full;
+    convex_hull_build(obj->surface_voxels, obj->surface_voxel_count, &incremental);
+
+    RngState rng;
+    rng_seed(&rng, 5);
+
+    /* Chip surface voxels away one at a time, as sustained damage does */
+    for (int32_t hit = 0; hit < 200 && obj->surface_voxel_count > 8; hit++)
+    {
+        Vec3 target = obj->surface_voxels[rng_range_u32(&rng, (uint32_t)obj->surface_voxel_count)];
+        float half_grid = (float)VOBJ_GRID_SIZE * 0.5f;
+        int32_t vx = (int32_t)floorf(target.x / obj->voxel_size + half_grid - 0.01f);
+        int32_t vy = (int32_t)floorf(target.y / obj->voxel_size + half_grid - 0.01f);
+        int32_t vz = (int32_t)floorf(target.z / obj->voxel_size + half_grid - 0.01f);
+        int32_t found = -1;
+        for (int32_t d = 0; d < 8 && found < 0; d++)
+        {
+            int32_t x = vx + (d & 1), y = vy + ((d >> 1) & 1), z = vz + ((d >> 2) & 1);
+            if (x < VOBJ_GRID_SIZE && y < VOBJ_GRID_SIZE && z < VOBJ_GRID_SIZE &&
+                obj->voxels[vobj_index(x, y, z)].material != 0)
+                found = vobj_index(x, y, z);
+        }
+        if (found < 0)
+            continue;
+        int32_t fz = found / (VOBJ_GRID_SIZE * VOBJ_GRID_SIZE);
+        int32_t fy = (found / VOBJ_GRID_SIZE) % VOBJ_GRID_SIZE;
+        int32_t fx = found % VOBJ_GRID_SIZE;
+        remove_object_voxel(world, idx, fx, fy, fz);
+
+        /* Whichever runs first after the edit pays for the cold points: alternate */
+        HullUpdate update;
+        if (hit & 1)
+        {
+            PlatformTime t0 = platform_time_now();
+            convex_hull_build(obj->surface_voxels, obj->surface_voxel_count, &full);
+            PlatformTime t1 = platform_time_now();
+            update = convex_hull_update(&incremental, obj->surface_voxels, obj->surface_voxel_count);
+            PlatformTime t2 = platform_time_now();
+            *build_s += platform_time_delta_seconds(t0, t1);
+            update_s[update] += platform_time_delta_seconds(t1, t2);
+        }
+        else
+        {
+            PlatformTime t0 = platform_time_now();
+            update = convex_hull_update(&incremental, obj->surface_voxels, obj->surface_voxel_count);
+            PlatformTime t1 = platform_time_now();
+            convex_hull_build(obj->surface_voxels, obj->surface_voxel_count, &full);
+            PlatformTime t2 = platform_time_now();
+            update_s[update] += platform_time_delta_seconds(t0, t1);
+            *build_s += platform_time_delta_seconds(t1, t2);
+        }
+        counts[update]++;
+
+        *worst_error = maxf(*worst_error, hull_max_outside(&incremental, obj->surface_voxels,
+                                                           obj->surface_voxel_count));
+        *worst_error = maxf(*worst_error, hull_support_error(&incremental, obj->surface_voxels,
+                                                             obj->surface_voxel_count, &rng));
+    }
+
+    voxel_object_world_destroy(world);
+}
+
+TEST(convex_hull_damage_benchmark)
+{
+    /* The edits are deterministic: best of three runs per side */
+    int32_t counts[2] = {0, 0};
+    double update_s[2] = {0.0, 0.0};
+    double build_s = 0.0;
+    float worst_error = 0.0f;
+    for (int32_t run = 0; run < 3; run++)
+    {
+        int32_t run_counts[2] = {0, 0};
+        double run_update_s[2] = {0.0, 0.0};
+        double run_build_s = 0.0;
+        hull_damage_run(run_counts, run_update_s, &run_build_s, &worst_error);
+        if (run == 0 || run_update_s[0] + run_update_s[1] < update_s[0] + update_s[1])
+        {
+            update_s[0] = run_update_s[0];
+            update_s[1] = run_update_s[1];
+        }
+        if (run == 0 || run_build_s < build_s)
+            build_s = run_build_s;
+        counts[0] = run_counts[0];
+        counts[1] = run_counts[1];
+    }
+
+    int32_t edits = counts[0] + counts[1];
+    double per[2];
+    for (int32_t k = 0; k < 2; k++)
+        per[k] = update_s[k] * 1e6 / (counts[k] > 0 ? counts[k] : 1);
+    double update_total_s = update_s[0] + update_s[1];
+    printf("\n    %d edits: %d reused (%.1fus), %d rebuilt (%.1fus)"
+           "\n    update %.1fus, full build %.1fus per edit (error %.6f)\n    ",
+           edits, counts[HULL_UPDATE_REUSED], per[HULL_UPDATE_REUSED], counts[HULL_UPDATE_REBUILT],
+           per[HULL_UPDATE_REBUILT], update_total_s * 1e6 / (edits > 0 ? edits : 1),
+           build_s * 1e6 / (edits > 0 ? edits : 1), worst_error);
+    ASSERT(edits > 100);
+    ASSERT(counts[HULL_UPDATE_REUSED] > 0);
+    ASSERT(worst_error < 1e-4f);
+#ifndef __SANITIZE_ADDRESS__
+    ASSERT(update_total_s < build_s);
+#endif
+    return 1;
+}
+
+static bool step_until_all_sleep(PhysicsWorld *physics, const int32_t *bodies, int32_t count, int32_t max_ticks)
+{
+    for (int32_t tick = 0; tick < max_ticks; tick++)
+    {
+        physics_world_step(physics, 1.0f / 60.0f);
+        bool all = true;
+        for (int32_t i = 0; i < count; i++)
+            all = all && physics_body_is_sleeping(physics, bodies[i]);
+        if (all)
+            return true;
+    }
+    return false;
+}
+
+TEST(wake_propagates_to_supported_bodies_only)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+
+    /* A row of three boxes touching side by side, a fourth stacked on the middle one */
+    Vec3 positions[4] = {vec3_create(-0.5f, 0.75f, 0.0f), vec3_create(0.0f, 0.75f, 0.0f),
+                         vec3_create(0.5f, 0.75f, 0.0f), vec3_create(0.0f, 1.25f, 0.0f)};
+    int32_t bodies[4];
+    for (int32_t i = 0; i < 4; i++)
+    {
+        int32_t obj_idx = voxel_object_world_add_box(obj_world, positions[i], vec3_create(0.25f, 0.25f, 0.25f),
+                                                     MAT_STONE);
+        bodies[i] = physics_world_add_body(physics, obj_idx);
+        ASSERT(bodies[i] >= 0);
+    }
+    int32_t left = bodies[0], middle = bodies[1], right = bodies[2], top = bodies[3];
+    ASSERT(step_until_all_sleep(physics, bodies, 4, 600));
+
+    /* Waking the middle box wakes what rests on it, not its side neighbours */
+    physics_body_wake(physics, middle);
+    physics_world_step(physics, 1.0f / 60.0f);
+    ASSERT(!physics_body_is_sleeping(physics, top));
+    ASSERT(physics_body_is_sleeping(physics, left));
+    ASSERT(physics_body_is_sleeping(physics, right));
+    ASSERT(step_until_all_sleep(physics, bodies, 4, 600));
+
+    /* A light nudge into a sleeper stays below the wake threshold */
+    bool middle_woke = false;
+    for (int32_t tick = 0; tick < 20; tick++)
+    {
+        physics_body_set_velocity(physics, left, vec3_create(0.3f, 0.0f, 0.0f));
+        physics_world_step(physics, 1.0f / 60.0f);
+        middle_woke = middle_woke || !physics_body_is_sleeping(physics, middle);
+    }
+    ASSERT(!middle_woke);
+    ASSERT(physics_body_is_sleeping(physics, top));
+
+    /* A hard hit wakes it */
+    int32_t ball_obj = voxel_object_world_add_box(obj_world, vec3_create(2.0f, 0.75f, 0.0f),
+                                                  vec3_create(0.25f, 0.25f, 0.25f), MAT_STONE);
+    int32_t ball = physics_world_add_body(physics, ball_obj);
+    ASSERT(ball >= 0);
+    int32_t woke_at = -1;
+    for (int32_t tick = 0; tick < 60 && woke_at < 0; tick++)
+    {
+        if (tick == 0)
+            physics_body_set_velocity(physics, ball, vec3_create(-8.0f, 0.0f, 0.0f));
+        physics_world_step(physics, 1.0f / 60.0f);
+        if (!physics_body_is_sleeping(physics, right))
+            woke_at = tick;
+    }
+    printf("(hit woke the sleeper at tick %d) ", woke_at);
+    ASSERT(woke_at >= 0);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(supported_body_tracks_terrain_edits)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+
+    int32_t obj_idx = voxel_object_world_add_box(obj_world, vec3_create(1.0f, 0.8f, 1.0f),
+                                                 vec3_create(0.25f, 0.25f, 0.25f), MAT_STONE);
+    int32_t body_idx = physics_world_add_body(physics, obj_idx);
+    ASSERT(body_idx >= 0);
+    ASSERT(step_until_all_sleep(physics, &body_idx, 1, 600));
+    RigidBody *body = physics_world_get_body(physics, body_idx);
+    uint32_t support = body->support_version;
+    ASSERT(support != 0);
+
+    /* Awake and supported: terrain sampling is skipped */
+    physics_body_wake(physics, body_idx);
+    physics_world_step(physics, 1.0f / 60.0f);
+    ASSERT_EQ(body->support_version, support);
+
+    /* Edit in another chunk: nothing to re-check */
+    volume_fill_sphere(terrain, vec3_create(-5.0f, 0.4f, -5.0f), 0.3f, MATERIAL_EMPTY);
+    physics_world_step(physics, 1.0f / 60.0f);
+    ASSERT_EQ(body->support_version, support);
+
+    /* Edit in the same chunk but away from the body: re-sampled, still supported */
+    ASSERT(step_until_all_sleep(physics, &body_idx, 1, 600));
+    volume_fill_sphere(terrain, vec3_create(2.8f, 0.4f, 2.8f), 0.2f, MATERIAL_EMPTY);
+    physics_world_step(physics, 1.0f / 60.0f);
+    ASSERT(body->support_version != 0 && body->support_version != support);
+    ASSERT(physics_body_is_sleeping(physics, body_idx));
+
+    /* Support dug out from under the sleeper: it wakes and falls without a wake call */
+    float start_y = voxel_object_position(obj_world, obj_idx).y;
+    volume_fill_box(terrain, vec3_create(0.5f, 0.0f, 0.5f), vec3_create(1.5f, 0.5f, 1.5f), MATERIAL_EMPTY);
+    for (int32_t tick = 0; tick < 30; tick++)
+        physics_world_step(physics, 1.0f / 60.0f);
+    printf("(fell %.2f) ", start_y - voxel_object_position(obj_world, obj_idx).y);
+    ASSERT(!physics_body_is_sleeping(physics, body_idx));
+    ASSERT(voxel_object_position(obj_world, obj_idx).y < start_y - 0.2f);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(sim_lod_levels_and_stagger)
+{
+    PhysicsSimLod lod;
+    physics_lod_init(&lod);
+
+    /* No focus: everything at full rate */
+    ASSERT_EQ(physics_lod_level(&lod, vec3_create(1000.0f, 0.0f, 0.0f), 0.5f), 0);
+
+    Vec3 focus[2] = {vec3_zero(), vec3_create(0.0f, 0.0f, 200.0f)};
+    physics_lod_set_focus(&lod, focus, 2);
+    ASSERT_EQ(physics_lod_level(&lod, vec3_create(10.0f, 0.0f, 0.0f), 0.5f), 0);
+    ASSERT_EQ(physics_lod_level(&lod, vec3_create(24.3f, 0.0f, 0.0f), 0.5f), 0);
+    ASSERT_EQ(physics_lod_level(&lod, vec3_create(30.0f, 0.0f, 0.0f), 0.5f), 1);
+    ASSERT_EQ(physics_lod_level(&lod, vec3_create(100.0f, 0.0f, 0.0f), 0.5f), 2);
+    ASSERT_EQ(physics_lod_level(&lod, vec3_create(0.0f, 0.0f, 190.0f), 0.5f), 0); /* Nearest focus wins */
+
+    /* Level 2: every entry updates once per 4 ticks, a quarter of them on each tick */
+    uint8_t pending[8] = {0};
+    int32_t updates[8] = {0};
+    for (uint32_t tick = 1; tick <= 8; tick++)
+    {
+        int32_t due_count = 0;
+        for (int32_t i = 0; i < 8; i++)
+        {
+            if (physics_lod_due(tick, i, 2, pending[i]))
+            {
+                pending[i] = 0;
+                updates[i]++;
+                due_count++;
+            }
+            else
+            {
+                pending[i]++;
+            }
+        }
+        ASSERT_EQ(due_count, 2);
+    }
+    for (int32_t i = 0; i < 8; i++)
+        ASSERT_EQ(updates[i], 2);
+    return 1;
+}
+
+TEST(sim_lod_far_bodies_skip_ticks)
+{
+    Bounds3D bounds = {-128.0f, 128.0f, 0.0f, 64.0f, -128.0f, 128.0f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.25f);
+    PhysicsWorld *physics = physics_world_create(obj_world, NULL);
+    PhysicsSimLod lod;
+    physics_lod_init(&lod);
+    Vec3 focus = vec3_create(0.0f, 40.0f, 0.0f);
+    physics_lod_set_focus(&lod, &focus, 1);
+    physics_world_set_lod(physics, &lod);
+
+    int32_t near_obj = voxel_object_world_add_box(obj_world, vec3_create(2.0f, 40.0f, 0.0f),
+                                                  vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    int32_t far_obj = voxel_object_world_add_box(obj_world, vec3_create(100.0f, 40.0f, 0.0f),
+                                                 vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    int32_t near_body = physics_world_add_body(physics, near_obj);
+    int32_t far_body = physics_world_add_body(physics, far_obj);
+    ASSERT(near_body >= 0 && far_body >= 0);
+
+    int32_t near_moves = 0, far_moves = 0;
+    float near_falls[9] = {0.0f};
+    for (int32_t tick = 0; tick < 8; tick++)
+    {
+        float near_y = voxel_object_position(obj_world, near_obj).y;
+        float far_y = voxel_object_position(obj_world, far_obj).y;
+        physics_world_step(physics, 1.0f / 60.0f);
+        near_falls[tick + 1] = 40.0f - voxel_object_position(obj_world, near_obj).y;
+        near_moves += voxel_object_position(obj_world, near_obj).y != near_y;
+        far_moves += voxel_object_position(obj_world, far_obj).y != far_y;
+
+        ASSERT_EQ(lod.body_updates[0], 1);
+        ASSERT_EQ(lod.body_updates[2] + lod.body_deferred, 1);
+        ASSERT_EQ(profile_get_counter(PROFILE_COUNTER_LOD_BODY_DEFERRED), lod.body_deferred);
+        ASSERT(!physics_body_is_sleeping(physics, far_body));
+    }
+    ASSERT_EQ(near_moves, 8);
+    ASSERT_EQ(far_moves, 2);
+
+    /* Skipped ticks are carried, not dropped: the far body fell as far as the near one
+     * had by the last tick its updates covered */
+    int32_t covered = 8 - physics->bodies[far_body].lod_pending;
+    float far_fall = 40.0f - voxel_object_position(obj_world, far_obj).y;
+    printf("(fell %.3f near, %.3f far over %d ticks) ", near_falls[covered], far_fall, covered);
+    ASSERT_NEAR(far_fall, near_falls[covered], near_falls[covered] * 0.05f);
+    float far_vy = physics->velocity.y[far_body] +
+                   physics->gravity.y * (1.0f / 60.0f) * (float)physics->bodies[far_body].lod_pending;
+    ASSERT_NEAR(far_vy, physics->velocity.y[near_body], 0.15f);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    return 1;
+}
+
+/* Ticks until the body sleeps (or max_ticks), leaving its resting position in the object */
+static int32_t drop_box_until_sleep(bool far, float *out_rest_y)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+    PhysicsSimLod lod;
+    physics_lod_init(&lod);
+    Vec3 focus = vec3_create(far ? 200.0f : 0.0f, 0.0f, 0.0f);
+    physics_lod_set_focus(&lod, &focus, 1);
+    physics_world_set_lod(physics, &lod);
+
+    int32_t obj = voxel_object_world_add_box(obj_world, vec3_create(0.0f, 5.75f, 0.0f),
+                                             vec3_create(0.25f, 0.25f, 0.25f), MAT_STONE);
+    int32_t body = physics_world_add_body(physics, obj);
+
+    int32_t slept = -1;
+    for (int32_t tick = 0; tick < 600 && slept < 0; tick++)
+    {
+        physics_world_step(physics, 1.0f / 60.0f);
+        if (physics_body_is_sleeping(physics, body))
+            slept = tick;
+    }
+    *out_rest_y = voxel_object_position(obj_world, obj).y;
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return slept;
+}
+
+TEST(sim_lod_far_body_lands_on_terrain)
+{
+    float near_y = 0.0f, far_y = 0.0f;
+    int32_t near_slept = drop_box_until_sleep(false, &near_y);
+    int32_t far_slept = drop_box_until_sleep(true, &far_y);
+    printf("(rest y %.3f near, %.3f far; slept at %d, %d) ", near_y, far_y, near_slept, far_slept);
+
+    /* Floor top at 0.5, half extent rounds up to 3 voxels (0.3): a quarter-rate body
+     * must rest on the floor, not in it, and settle in about the same number of ticks */
+    ASSERT(near_slept >= 0 && far_slept >= 0);
+    ASSERT_NEAR(near_y, 0.8f, 0.05f);
+    ASSERT_NEAR(far_y, near_y, 0.03f);
+    ASSERT(far_slept <= near_slept + 20);
+    return 1;
+}
+
+/* Milliseconds to step a grid of boxes dropped onto the floor, near or far from the focus */
+static float step_dropped_grid_ms(bool far)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+    PhysicsSimLod lod;
+    physics_lod_init(&lod);
+    Vec3 focus = vec3_create(far ? 200.0f : 0.0f, 0.0f, 0.0f);
+    physics_lod_set_focus(&lod, &focus, 1);
+    physics_world_set_lod(physics, &lod);
+
+    for (int32_t i = 0; i < 64; i++)
+    {
+        Vec3 pos = vec3_create(-5.6f + (float)(i % 8) * 1.6f, 3.0f + (float)((i * 7) % 13) * 0.5f,
+                               -5.6f + (float)(i / 8) * 1.6f);
+        int32_t obj = voxel_object_world_add_box(obj_world, pos, vec3_create(0.25f, 0.25f, 0.25f), MAT_STONE);
+        physics_world_add_body(physics, obj);
+    }
+
+    PlatformTime t0 = platform_time_now();
+    for (int32_t tick = 0; tick < 180; tick++)
+        physics_world_step(physics, 1.0f / 60.0f);
+    float elapsed_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return elapsed_ms;
+}
+
+TEST(sim_lod_far_body_step_benchmark)
+{
+    float near_ms = 1e30f, far_ms = 1e30f;
+    for (int32_t run = 0; run < 3; run++)
+    {
+        near_ms = minf(near_ms, step_dropped_grid_ms(false));
+        far_ms = minf(far_ms, step_dropped_grid_ms(true));
+    }
+    printf("\n    64 boxes, 180 ticks: near %.2fms, far %.2fms\n    ", near_ms, far_ms);
+
+    /* Far bodies only sweep tick by tick while moving into terrain: they must cost less */
+#ifndef __SANITIZE_ADDRESS__
+    ASSERT(far_ms < near_ms * 0.75f);
+#endif
+    return 1;
+}
+
+TEST(sim_lod_contact_promotes_far_body)
+{
+    Bounds3D bounds = {-128.0f, 128.0f, 0.0f, 64.0f, -128.0f, 128.0f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.25f);
+    PhysicsWorld *physics = physics_world_create(obj_world, NULL);
+    physics->gravity = vec3_zero();
+    PhysicsSimLod lod;
+    physics_lod_init(&lod);
+    Vec3 focus = vec3_create(0.0f, 20.0f, 0.0f);
+    physics_lod_set_focus(&lod, &focus, 1);
+    physics_world_set_lod(physics, &lod);
+
+    int32_t mover_obj = voxel_object_world_add_box(obj_world, vec3_create(100.0f, 20.0f, 0.0f),
+                                                   vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    int32_t target_obj = voxel_object_world_add_box(obj_world, vec3_create(102.0f, 20.0f, 0.0f),
+                                                    vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    int32_t mover = physics_world_add_body(physics, mover_obj);
+    int32_t target = physics_world_add_body(physics, target_obj);
+    ASSERT(mover >= 0 && target >= 0);
+    physics_body_set_velocity(physics, mover, vec3_create(4.0f, 0.0f, 0.0f));
+
+    int32_t promoted_at = -1;
+    for (int32_t tick = 0; tick < 60; tick++)
+    {
+        physics_world_step(physics, 1.0f / 60.0f);
+        if (promoted_at < 0 && lod.body_promoted > 0)
+        {
+            promoted_at = tick;
+            ASSERT(physics->bodies[target].lod_hold > 0 || physics->bodies[mover].lod_hold > 0);
+        }
+    }
+    printf("(promoted at tick %d) ", promoted_at);
+    ASSERT(promoted_at >= 0);
+
+    /* The hit reached the far target */
+    ASSERT(physics->velocity.x[target] > 0.5f);
+    ASSERT(voxel_object_position(obj_world, target_obj).x > 102.0f);
+    ASSERT(voxel_object_position(obj_world, target_obj).x - voxel_object_position(obj_world, mover_obj).x > 0.9f);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    return 1;
+}
+
+TEST(sim_lod_far_particles_skip_ticks)
+{
+    Bounds3D bounds = {-128.0f, 128.0f, 0.0f, 64.0f, -128.0f, 128.0f};
+    ParticleSystem *sys = particle_system_create(bounds);
+    ASSERT(sys != NULL);
+    sys->enable_particle_collision = false;
+    PhysicsSimLod lod;
+    physics_lod_init(&lod);
+    Vec3 focus = vec3_create(0.0f, 30.0f, 0.0f);
+    physics_lod_set_focus(&lod, &focus, 1);
+    particle_system_set_lod(sys, &lod);
+
+    RngState rng;
+    rng_seed(&rng, 40);
+    int32_t near_p = particle_system_add(sys, &rng, vec3_create(1.0f, 30.0f, 0.0f), vec3_zero(),
+                                         vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+    int32_t half_p = particle_system_add(sys, &rng, vec3_create(30.0f, 30.0f, 0.0f), vec3_zero(),
+                                         vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+    int32_t far_p = particle_system_add(sys, &rng, vec3_create(100.0f, 30.0f, 0.0f), vec3_zero(),
+                                        vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+
+    int32_t moves[3] = {0, 0, 0};
+    int32_t indices[3] = {near_p, half_p, far_p};
+    for (int32_t tick = 0; tick < 8; tick++)
+    {
+        float before[3];
+        for (int32_t k = 0; k < 3; k++)
+            before[k] = sys->position.y[indices[k]];
+        particle_system_update(sys, 1.0f / 60.0f, NULL, NULL);
+        for (int32_t k = 0; k < 3; k++)
+            moves[k] += sys->position.y[indices[k]] != before[k];
+
+        ASSERT_EQ(lod.particle_updates[0], 1);
+        ASSERT_EQ(lod.particle_updates[1] + lod.particle_updates[2] + lod.particle_deferred, 2);
+    }
+    ASSERT_EQ(moves[0], 8);
+    ASSERT_EQ(moves[1], 4);
+    ASSERT_EQ(moves[2], 2);
+
+    float near_fall = 30.0f - sys->position.y[near_p];
+    float far_fall = 30.0f - sys->position.y[far_p];
+    ASSERT(far_fall > near_fall * 0.8f && far_fall < near_fall * 1.5f);
+
+    particle_system_destroy(sys);
+    return 1;
+}
+
+/* The pre-SoA per-particle step: integration only, terrain and collision off */
+static void reference_particle_step(Particle *p, Vec3 gravity, float damping, float friction, bool near_surface,
+                                    float dt, float max_velocity)
+{
+    p->prev_position = p->position;
+    p->velocity = vec3_add(p->velocity, vec3_scale(gravity, dt));
+
+    float speed_sq = vec3_length_sq(p->velocity);
+    if (speed_sq > max_velocity * max_velocity)
+    {
+        float speed = sqrtf(speed_sq);
+        p->velocity = vec3_scale(p->velocity, max_velocity / speed);
+    }
+
+    p->velocity = vec3_scale(p->velocity, damping);
+    if (near_surface)
+    {
+        p->velocity.x *= friction;
+        p->velocity.z *= friction;
+        p->angular_velocity = vec3_scale(p->angular_velocity, 0.9f);
+    }
+
+    p->position = vec3_add(p->position, vec3_scale(p->velocity, dt));
+    p->rotation = vec3_add(p->rotation, vec3_scale(p->angular_velocity, dt));
+    p->angular_velocity = vec3_scale(p->angular_velocity, 0.995f);
+}
+
+static bool vec3_bits_equal(Vec3 a, Vec3 b)
+{
+    return memcmp(&a, &b, sizeof(Vec3)) == 0;
+}
+
+static bool particle_bits_equal(const ParticleSystem *sys, int32_t i, const Particle *expected)
+{
+    Particle p = particle_system_get(sys, i);
+    return vec3_bits_equal(p.position, expected->position) &&
+           vec3_bits_equal(p.prev_position, expected->prev_position) &&
+           vec3_bits_equal(p.velocity, expected->velocity) &&
+           vec3_bits_equal(p.rotation, expected->rotation) &&
+           vec3_bits_equal(p.angular_velocity, expected->angular_velocity);
+}
+
+TEST(particle_soa_matches_scalar_reference)
+{
+    Bounds3D bounds = {-64.0f, 64.0f, 0.0f, 64.0f, -64.0f, 64.0f};
+    ParticleSystem *sys = particle_system_create(bounds);
+    ASSERT(sys != NULL);
+    sys->enable_particle_collision = false;
+
+    RngState rng;
+    rng_seed(&rng, 41);
+
+    /* Off the lane width, with fast particles that hit the speed clamp */
+    enum { COUNT = 37 };
+    Particle expected[COUNT];
+    for (int32_t i = 0; i < COUNT; i++)
+    {
+        Vec3 position = vec3_create(rng_signed_half(&rng) * 40.0f, 20.0f + rng_float(&rng) * 20.0f,
+                                    rng_signed_half(&rng) * 40.0f);
+        Vec3 velocity = vec3_create(rng_signed_half(&rng) * 30.0f, rng_signed_half(&rng) * 30.0f,
+                                    rng_signed_half(&rng) * 30.0f);
+        int32_t slot = particle_system_add(sys, &rng, position, velocity, vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+        ASSERT_EQ(slot, i);
+        expected[i] = particle_system_get(sys, i);
+    }
+
+    /* A picked-up particle keeps its state */
+    Vec3 picked_color;
+    ASSERT(particle_system_pickup_nearest(sys, expected[5].position, 0.01f, &picked_color));
+    ASSERT(!particle_system_is_active(sys, 5));
+
+    const float dt = 1.0f / 60.0f;
+    for (int32_t tick = 0; tick < 90; tick++)
+    {
+        particle_system_update(sys, dt, NULL, NULL);
+        for (int32_t i = 0; i < COUNT; i++)
+        {
+            if (i == 5)
+                continue;
+            reference_particle_step(&expected[i], sys->gravity, sys->damping, sys->floor_friction, false, dt, 10.0f);
+            ASSERT(particle_bits_equal(sys, i, &expected[i]));
+        }
+    }
+    ASSERT(vec3_bits_equal(particle_system_position(sys, 5), expected[5].position));
+    ASSERT(vec3_bits_equal(vec3_create(sys->velocity.x[5], sys->velocity.y[5], sys->velocity.z[5]),
+                           expected[5].velocity));
+
+    /* Render interpolation spans the last update */
+    Vec3 mid = particle_system_interpolated_position(sys, 0, 0.5f);
+    ASSERT(fabsf(mid.y - (expected[0].prev_position.y + expected[0].position.y) * 0.5f) < 1e-4f);
+
+    particle_system_destroy(sys);
+    return 1;
+}
+
+TEST(particle_soa_surface_friction_matches_reference)
+{
+    Bounds3D bounds = {-5.0f, 5.0f, 0.0f, 8.0f, -5.0f, 5.0f};
+    float voxel_size = 0.1f;
+    Vec3 origin = vec3_create(bounds.min_x, bounds.min_y, bounds.min_z);
+    VoxelVolume *terrain = volume_create_dims(4, 4, 4, origin, voxel_size);
+    volume_fill_box(terrain, origin, vec3_create(bounds.max_x, bounds.min_y + 0.5f, bounds.max_z), MAT_STONE);
+    volume_rebuild_all_occupancy(terrain);
+
+    ParticleSystem *sys = particle_system_create(bounds);
+    sys->enable_particle_collision = false;
+    RngState rng;
+    rng_seed(&rng, 410);
+
+    /* Sliding particles just above the floor mixed with airborne ones in each block */
+    enum { COUNT = 19 };
+    Particle expected[COUNT];
+    bool near[COUNT];
+    for (int32_t i = 0; i < COUNT; i++)
+    {
+        near[i] = (i % 3) != 0;
+        float radius = 0.05f;
+        float y = near[i] ? 0.5f + radius + 0.03f : 4.0f;
+        Vec3 velocity = vec3_create(2.0f + rng_float(&rng), 0.0f, -1.0f - rng_float(&rng));
+        particle_system_add(sys, &rng, vec3_create(-4.0f + 0.2f * (float)i, y, -4.0f), velocity,
+                            vec3_create(1.0f, 1.0f, 1.0f), radius);
+        expected[i] = particle_system_get(sys, i);
+    }
+
+    const float dt = 1.0f / 60.0f;
+    particle_system_update(sys, dt, terrain, NULL);
+    for (int32_t i = 0; i < COUNT; i++)
+    {
+        reference_particle_step(&expected[i], sys->gravity, sys->damping, sys->floor_friction, near[i], dt, 10.0f);
+        ASSERT(particle_bits_equal(sys, i, &expected[i]));
+        ASSERT(sys->state[i] != PARTICLE_SETTLED);
+    }
+    ASSERT(sys->velocity.x[1] < sys->velocity.x[0]);
+
+    particle_system_destroy(sys);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(particle_soa_update_benchmark)
+{
+    Bounds3D bounds = {-128.0f, 128.0f, 0.0f, 128.0f, -128.0f, 128.0f};
+    ParticleSystem *sys = particle_system_create(bounds);
+    ASSERT(sys != NULL);
+    sys->enable_particle_collision = false;
+
+    static Particle reference[PARTICLE_MAX_COUNT];
+    RngState rng;
+    rng_seed(&rng, 4100);
+    for (int32_t i = 0; i < PARTICLE_MAX_COUNT; i++)
+    {
+        Vec3 position = vec3_create(rng_signed_half(&rng) * 200.0f, 60.0f + rng_float(&rng) * 60.0f,
+                                    rng_signed_half(&rng) * 200.0f);
+        Vec3 velocity = vec3_create(rng_signed_half(&rng) * 8.0f, rng_float(&rng) * 8.0f,
+                                    rng_signed_half(&rng) * 8.0f);
+        particle_system_add(sys, &rng, position, velocity, vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+        reference[i] = particle_system_get(sys, i);
+    }
+
+    /* Young particles only, so every tick updates all of them; best of five runs of ten ticks each */
+    const int32_t runs = 5;
+    const int32_t rounds = 10;
+    const float dt = 1.0f / 60.0f;
+    float aos_ms = 1e30f, soa_ms = 1e30f;
+
+    for (int32_t run = 0; run < runs; run++)
+    {
+        PlatformTime t0 = platform_time_now();
+        for (int32_t r = 0; r < rounds; r++)
+        {
+            for (int32_t i = 0; i < PARTICLE_MAX_COUNT; i++)
+                reference_particle_step(&reference[i], sys->gravity, sys->damping, sys->floor_friction, false, dt,
+                                        10.0f);
+        }
+        aos_ms = fminf(aos_ms, platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f / (float)rounds);
+
+        PlatformTime t1 = platform_time_now();
+        for (int32_t r = 0; r < rounds; r++)
+            particle_system_update(sys, dt, NULL, NULL);
+        soa_ms = fminf(soa_ms, platform_time_delta_seconds(t1, platform_time_now()) * 1000.0f / (float)rounds);
+    }
+
+    printf("(%d particles: AoS %.3fms, SoA %.3fms per update) ", PARTICLE_MAX_COUNT, aos_ms, soa_ms);
+    ASSERT_EQ(sys->updated_count, PARTICLE_MAX_COUNT);
+    ASSERT(particle_bits_equal(sys, 0, &reference[0]));
+    ASSERT(particle_bits_equal(sys, PARTICLE_MAX_COUNT - 1, &reference[PARTICLE_MAX_COUNT - 1]));
+#ifndef __SANITIZE_ADDRESS__ /* Instrumented loads and stores swamp both timings */
+    /* The whole update, scheduling included, beats integrating the AoS reference alone */
+    ASSERT(soa_ms < aos_ms);
+    ASSERT(soa_ms < 1.0f);
+#endif
+
+    particle_system_destroy(sys);
+    return 1;
+}
+
+/* Every listed slot points back at its list position, and only listed slots are live */
+static bool particle_lists_consistent(const ParticleSystem *sys)
+{
+    int32_t listed = 0;
+    for (int32_t l = 0; l < PARTICLE_LIST_COUNT; l++)
+    {
+        const ParticleIndexList *list = &sys->lists[l];
+        for (int32_t k = 0; k < list->count; k++)
+        {
+            int32_t i = list->slots[k];
+            if (sys->state[i] != l || sys->list_index[i] != k)
+                return false;
+        }
+        listed += list->count;
+    }
+
+    int32_t live = 0;
+    for (int32_t i = 0; i < PARTICLE_MAX_COUNT; i++)
+        live += particle_system_is_active(sys, i);
+    return listed == live && live == sys->active_count;
+}
+
+TEST(particle_lists_follow_state_changes)
+{
+    Bounds3D bounds = {-5.0f, 5.0f, 0.0f, 8.0f, -5.0f, 5.0f};
+    float voxel_size = 0.1f;
+    Vec3 origin = vec3_create(bounds.min_x, bounds.min_y, bounds.min_z);
+    VoxelVolume *terrain = volume_create_dims(4, 4, 4, origin, voxel_size);
+    volume_fill_box(terrain, origin, vec3_create(bounds.max_x, bounds.min_y + 0.5f, bounds.max_z), MAT_STONE);
+    volume_rebuild_all_occupancy(terrain);
+
+    ParticleSystem *sys = particle_system_create(bounds);
+    sys->enable_particle_collision = false;
+    RngState rng;
+    rng_seed(&rng, 42);
+
+    /* Ten resting on the floor, five falling from high up */
+    for (int32_t i = 0; i < 10; i++)
+        particle_system_add(sys, &rng, vec3_create(-4.0f + 0.3f * (float)i, 0.56f, -4.0f), vec3_zero(),
+                            vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+    for (int32_t i = 0; i < 5; i++)
+        particle_system_add(sys, &rng, vec3_create(-4.0f + 0.3f * (float)i, 60.0f, -2.0f), vec3_zero(),
+                            vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+    ASSERT_EQ(sys->lists[PARTICLE_YOUNG].count, 15);
+    ASSERT(particle_lists_consistent(sys));
+
+    const float dt = 1.0f / 60.0f;
+    for (int32_t tick = 0; tick < 90; tick++)
+    {
+        particle_system_update(sys, dt, terrain, NULL);
+        ASSERT(particle_lists_consistent(sys));
+    }
+
+    /* Past the young age, the floor particles rest and the falling ones are awake */
+    ASSERT_EQ(sys->lists[PARTICLE_YOUNG].count, 0);
+    ASSERT_EQ(sys->lists[PARTICLE_SETTLED].count, 10);
+    ASSERT_EQ(sys->lists[PARTICLE_AWAKE].count, 5);
+    for (int32_t i = 0; i < 10; i++)
+        ASSERT_EQ(sys->state[i], PARTICLE_SETTLED);
+
+    /* Settled particles cost no integration */
+    particle_system_update(sys, dt, terrain, NULL);
+    ASSERT_EQ(sys->updated_count, 5);
+
+    Particle settled[16];
+    ASSERT_EQ(particle_system_get_settled(sys, settled, 16), 10);
+    ASSERT(settled[0].settled && settled[0].active && settled[0].lifetime > 1.0f);
+
+    /* Digging out the floor wakes them */
+    volume_fill_box(terrain, origin, vec3_create(bounds.max_x, bounds.min_y + 0.5f, bounds.max_z), MAT_AIR);
+    particle_system_update(sys, dt, terrain, NULL);
+    ASSERT_EQ(sys->lists[PARTICLE_SETTLED].count, 0);
+    ASSERT_EQ(sys->lists[PARTICLE_AWAKE].count, 15);
+    ASSERT(particle_lists_consistent(sys));
+
+    /* Pickup and clear unlist */
+    Vec3 color;
+    ASSERT(particle_system_pickup_nearest(sys, particle_system_position(sys, 3), 0.1f, &color));
+    ASSERT(!particle_system_is_active(sys, 3));
+    ASSERT_EQ(sys->active_count, 14);
+    ASSERT(particle_lists_consistent(sys));
+
+    particle_system_clear(sys);
+    ASSERT_EQ(sys->active_count, 0);
+    ASSERT(particle_lists_consistent(sys));
+
+    particle_system_destroy(sys);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(particle_lists_remove_settled_compacts)
+{
+    Bounds3D bounds = {-64.0f, 64.0f, 0.0f, 64.0f, -64.0f, 64.0f};
+    ParticleSystem *sys = particle_system_create(bounds);
+    RngState rng;
+    rng_seed(&rng, 420);
+    for (int32_t i = 0; i < 12; i++)
+        particle_system_add(sys, &rng, vec3_create((float)i, 10.0f, 0.0f), vec3_zero(),
+                            vec3_create((float)i, 0.0f, 0.0f), 0.05f);
+
+    /* Mark every third settled by hand; no terrain means the next update would wake them */
+    ParticleIndexList *young = &sys->lists[PARTICLE_YOUNG];
+    for (int32_t i = 0; i < 12; i += 3)
+    {
+        int32_t k = sys->list_index[i];
+        int32_t last = young->slots[--young->count];
+        young->slots[k] = last;
+        sys->list_index[last] = k;
+        ParticleIndexList *settled = &sys->lists[PARTICLE_SETTLED];
+        sys->list_index[i] = settled->count;
+        settled->slots[settled->count++] = i;
+        sys->state[i] = PARTICLE_SETTLED;
+    }
+    ASSERT(particle_lists_consistent(sys));
+
+    particle_system_remove_settled(sys);
+    ASSERT_EQ(sys->count, 8);
+    ASSERT_EQ(sys->lists[PARTICLE_YOUNG].count, 8);
+    ASSERT_EQ(sys->lists[PARTICLE_SETTLED].count, 0);
+    ASSERT(particle_lists_consistent(sys));
+    /* Survivors keep their slot order */
+    ASSERT(sys->color[0].x == 1.0f && sys->color[1].x == 2.0f && sys->color[2].x == 4.0f);
+
+    particle_system_destroy(sys);
+    return 1;
+}
+
+TEST(particle_lists_settled_benchmark)
+{
+    Bounds3D bounds = {-5.0f, 5.0f, 0.0f, 8.0f, -5.0f, 5.0f};
+    float voxel_size = 0.1f;
+    Vec3 origin = vec3_create(bounds.min_x, bounds.min_y, bounds.min_z);
+    VoxelVolume *terrain = volume_create_dims(4, 4, 4, origin, voxel_size);
+    volume_fill_box(terrain, origin, vec3_create(bounds.max_x, bounds.min_y + 0.5f, bounds.max_z), MAT_STONE);
+    volume_rebuild_all_occupancy(terrain);
+
+    ParticleSystem *sys = particle_system_create(bounds);
+    sys->enable_particle_collision = false;
+    RngState rng;
+    rng_seed(&rng, 4200);
+
+    /* A full buffer of debris lying on the floor, plus a few still falling */
+    const int32_t falling = 256;
+    for (int32_t i = 0; i < PARTICLE_MAX_COUNT - falling; i++)
+    {
+        Vec3 position = vec3_create(-4.5f + rng_float(&rng) * 5.5f, 0.56f, -4.5f + rng_float(&rng) * 5.5f);
+        particle_system_add(sys, &rng, position, vec3_zero(), vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+    }
+    const float dt = 1.0f / 60.0f;
+    for (int32_t tick = 0; tick < 90; tick++)
+        particle_system_update(sys, dt, terrain, NULL);
+    ASSERT_EQ(sys->lists[PARTICLE_SETTLED].count, PARTICLE_MAX_COUNT - falling);
+
+    for (int32_t i = 0; i < falling; i++)
+        particle_system_add(sys, &rng, vec3_create(-4.0f + rng_float(&rng), 200.0f, -4.0f), vec3_zero(),
+                            vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+
+    const int32_t rounds = 50;
+    PlatformTime t0 = platform_time_now();
+    for (int32_t r = 0; r < rounds; r++)
+        particle_system_update(sys, dt, terrain, NULL);
+    float elapsed_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+
+    printf("(%d settled + %d falling: %.3fms per update) ", sys->lists[PARTICLE_SETTLED].count, falling,
+           elapsed_ms / (float)rounds);
+    ASSERT_EQ(sys->updated_count, falling);
+    ASSERT_EQ(sys->lists[PARTICLE_SETTLED].count, PARTICLE_MAX_COUNT - falling);
+
+    particle_system_destroy(sys);
+    volume_destroy(terrain);
+    return 1;
+}
+
+/* Floor, a boulder and a wall, leaving the upper chunks empty */
+static VoxelVolume *particle_terrain_test_volume(void)
+{
+    float voxel_size = 0.1f;
+    float chunk_world = voxel_size * CHUNK_SIZE;
+    Vec3 origin = vec3_create(-2.0f * chunk_world, 0.0f, -2.0f * chunk_world);
+    VoxelVolume *terrain = volume_create_dims(4, 3, 4, origin, voxel_size);
+    volume_fill_box(terrain, origin, vec3_create(2.0f * chunk_world, 0.55f, 2.0f * chunk_world), MAT_STONE);
+    volume_fill_sphere(terrain, vec3_create(0.0f, 0.5f, 0.0f), 0.8f, MAT_STONE);
+    volume_fill_box(terrain, vec3_create(0.9f * chunk_world, 0.0f, -chunk_world),
+                    vec3_create(1.1f * chunk_world, 1.5f * chunk_world, chunk_world), MAT_STONE);
+    return terrain;
+}
+
+TEST(particle_terrain_matches_volume_queries)
+{
+    VoxelVolume *terrain = particle_terrain_test_volume();
+    float chunk_world = terrain->voxel_size * CHUNK_SIZE;
+    ParticleTerrain *pt = (ParticleTerrain *)malloc(sizeof(ParticleTerrain));
+    ASSERT(pt != NULL);
+    particle_terrain_init(pt);
+    RngState rng;
+    rng_seed(&rng, 4300);
+
+    /* Random points over the volume and a margin around it, then points on
+     * chunk and voxel boundaries where the float steps matter */
+    particle_terrain_begin(pt);
+    for (int32_t i = 0; i < 4000; i++)
+    {
+        particle_terrain_push(pt, terrain->bounds.min_x - 1.0f + rng_float(&rng) * (4.0f * chunk_world + 2.0f),
+                              terrain->bounds.min_y - 1.0f + rng_float(&rng) * (3.0f * chunk_world + 2.0f),
+                              terrain->bounds.min_z - 1.0f + rng_float(&rng) * (4.0f * chunk_world + 2.0f));
+    }
+    for (int32_t i = -2; i <= 6; i++)
+    {
+        for (int32_t j = -1; j <= 4; j++)
+        {
+            float edge = terrain->bounds.min_x + (float)i * chunk_world;
+            float y = (float)j * chunk_world * 0.25f;
+            particle_terrain_push(pt, edge, y, 0.05f);
+            particle_terrain_push(pt, nextafterf(edge, -1e9f), y, -0.05f);
+            particle_terrain_push(pt, 0.0f, nextafterf(y, -1e9f), edge);
+            particle_terrain_push(pt, (float)i * terrain->voxel_size, 0.5f, (float)j * terrain->voxel_size);
+        }
+    }
+    particle_terrain_solve(pt, terrain);
+
+    int32_t solid = 0;
+    for (int32_t q = 0; q < pt->count; q++)
+    {
+        Vec3 point = vec3_create(pt->x[q], pt->y[q], pt->z[q]);
+        bool expected = volume_is_solid_at(terrain, point);
+        ASSERT_EQ(pt->solid[q] != 0, expected);
+        ASSERT_EQ(particle_terrain_point_solid(pt, terrain, point, NULL), expected);
+        if (pt->chunk[q] >= 0)
+            ASSERT_EQ(particle_terrain_voxel_solid(pt, terrain, pt->gx[q], pt->gy[q], pt->gz[q]), expected);
+        solid += expected ? 1 : 0;
+    }
+    ASSERT(solid > 100);
+    ASSERT(solid < pt->count - 100);
+
+    /* No terrain answers empty */
+    particle_terrain_solve(pt, NULL);
+    for (int32_t q = 0; q < pt->count; q++)
+        ASSERT_EQ(pt->solid[q], 0);
+
+    free(pt);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(particle_terrain_masks_follow_edits)
+{
+    VoxelVolume *terrain = particle_terrain_test_volume();
+    float chunk_world = terrain->voxel_size * CHUNK_SIZE;
+    ParticleTerrain *pt = (ParticleTerrain *)malloc(sizeof(ParticleTerrain));
+    ASSERT(pt != NULL);
+    particle_terrain_init(pt);
+
+    /* Two floor points in different chunks, and one in an empty chunk */
+    Vec3 a = vec3_create(-1.5f * chunk_world, 0.25f, -1.5f * chunk_world);
+    Vec3 b = vec3_create(1.5f * chunk_world, 0.25f, 1.5f * chunk_world);
+    Vec3 sky = vec3_create(0.0f, 2.5f * chunk_world, 0.0f);
+
+    particle_terrain_begin(pt);
+    particle_terrain_push(pt, a.x, a.y, a.z);
+    particle_terrain_push(pt, b.x, b.y, b.z);
+    particle_terrain_push(pt, sky.x, sky.y, sky.z);
+    particle_terrain_solve(pt, terrain);
+    ASSERT_EQ(pt->solid[0], 1);
+    ASSERT_EQ(pt->solid[1], 1);
+    ASSERT_EQ(pt->solid[2], 0);
+    ASSERT_EQ(pt->chunk[2], -1);
+    ASSERT_EQ(pt->masks_built, 2);
+
+    /* Unchanged terrain reuses the masks */
+    particle_terrain_solve(pt, terrain);
+    ASSERT_EQ(pt->masks_built, 2);
+
+    /* Digging under a rebuilds that chunk only */
+    volume_fill_box(terrain, vec3_sub(a, vec3_create(0.2f, 0.2f, 0.2f)), vec3_add(a, vec3_create(0.2f, 0.2f, 0.2f)),
+                    MAT_AIR);
+    particle_terrain_solve(pt, terrain);
+    ASSERT_EQ(pt->solid[0], 0);
+    ASSERT_EQ(pt->solid[1], 1);
+    ASSERT_EQ(pt->masks_built, 3);
+
+    free(pt);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(particle_terrain_batch_benchmark)
+{
+    VoxelVolume *terrain = particle_terrain_test_volume();
+    float chunk_world = terrain->voxel_size * CHUNK_SIZE;
+    ParticleTerrain *pt = (ParticleTerrain *)malloc(sizeof(ParticleTerrain));
+    ASSERT(pt != NULL);
+    particle_terrain_init(pt);
+    RngState rng;
+    rng_seed(&rng, 4301);
+
+    /* Probes as debris makes them: near the floor, all over the volume */
+    const int32_t count = PARTICLE_TERRAIN_MAX_QUERIES;
+    Vec3 *points = (Vec3 *)malloc(sizeof(Vec3) * (size_t)count);
+    ASSERT(points != NULL);
+    for (int32_t i = 0; i < count; i++)
+    {
+        points[i] = vec3_create(terrain->bounds.min_x + rng_float(&rng) * 4.0f * chunk_world,
+                                0.3f + rng_float(&rng) * 0.6f,
+                                terrain->bounds.min_z + rng_float(&rng) * 4.0f * chunk_world);
+    }
+
+    const int32_t rounds = 20;
+    int32_t expected_solid = 0;
+    PlatformTime t0 = platform_time_now();
+    for (int32_t r = 0; r < rounds; r++)
+    {
+        expected_solid = 0;
+        for (int32_t i = 0; i < count; i++)
+            expected_solid += volume_is_solid_at(terrain, points[i]) ? 1 : 0;
+    }
+    float single_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f / (float)rounds;
+
+    int32_t batch_solid = 0;
+    t0 = platform_time_now();
+    for (int32_t r = 0; r < rounds; r++)
+    {
+        particle_terrain_begin(pt);
+        for (int32_t i = 0; i < count; i++)
+            particle_terrain_push(pt, points[i].x, points[i].y, points[i].z);
+        particle_terrain_solve(pt, terrain);
+    }
+    float batch_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f / (float)rounds;
+    for (int32_t i = 0; i < count; i++)
+        batch_solid += pt->solid[i];
+
+    printf("(%d probes: %.3fms single, %.3fms batched) ", count, single_ms, batch_ms);
+    ASSERT_EQ(batch_solid, expected_solid);
+
+    free(points);
+    free(pt);
+    volume_destroy(terrain);
+    return 1;
+}
+
+typedef struct
+{
+    int64_t *keys;
+    int32_t count;
+    int32_t capacity;
+} ParticlePairLog;
+
+static void log_particle_pair(int32_t a, int32_t b, void *user_data)
+{
+    ParticlePairLog *log = (ParticlePairLog *)user_data;
+    int32_t lo = a < b ? a : b;
+    int32_t hi = a < b ? b : a;
+    if (log->count < log->capacity)
+        log->keys[log->count] = (int64_t)lo * PARTICLE_CELLS_MAX + hi;
+    log->count++;
+}
+
+static void count_particle_pair(int32_t a, int32_t b, void *user_data)
+{
+    (void)a;
+    (void)b;
+    (*(int32_t *)user_data)++;
+}
+
+static int compare_pair_keys(const void *a, const void *b)
+{
+    int64_t ka = *(const int64_t *)a;
+    int64_t kb = *(const int64_t *)b;
+    return (ka > kb) - (ka < kb);
+}
+
+/* Random spheres in a cube; radius_max above half the minimum cell grows the cells */
+static void particle_cells_scatter(RngState *rng, int32_t count, float side, float radius_min, float radius_max,
+                                   float *x, float *y, float *z, float *r)
+{
+    for (int32_t i = 0; i < count; i++)
+    {
+        x[i] = rng_signed_half(rng) * side;
+        y[i] = rng_signed_half(rng) * side;
+        z[i] = rng_signed_half(rng) * side;
+        r[i] = radius_min + rng_float(rng) * (radius_max - radius_min);
+    }
+}
+
+TEST(particle_cells_pairs_match_brute_force)
+{
+    enum { SCATTERED = 6000 };
+    static float x[SCATTERED], y[SCATTERED], z[SCATTERED], r[SCATTERED];
+    static int32_t slots[SCATTERED];
+    static int64_t brute[SCATTERED * 16], swept[SCATTERED * 16];
+    RngState rng;
+    rng_seed(&rng, 4400);
+    particle_cells_scatter(&rng, SCATTERED, 3.0f, 0.02f, 0.2f, x, y, z, r);
+    /* One stray far away stretches the grid bounds past the cell budget */
+    x[SCATTERED - 1] = 400.0f;
+
+    /* Every other particle, so slots and sorted order differ */
+    int32_t count = 0;
+    for (int32_t i = 1; i < SCATTERED; i += 2)
+        slots[count++] = i;
+
+    int32_t brute_count = 0;
+    for (int32_t a = 0; a < count; a++)
+    {
+        for (int32_t b = a + 1; b < count; b++)
+        {
+            int32_t i = slots[a], j = slots[b];
+            float dx = x[j] - x[i], dy = y[j] - y[i], dz = z[j] - z[i];
+            float min_dist = r[i] + r[j];
+            if (dx * dx + dy * dy + dz * dz < min_dist * min_dist)
+                brute[brute_count++] = (int64_t)(i < j ? i : j) * PARTICLE_CELLS_MAX + (i < j ? j : i);
+        }
+    }
+
+    ParticleCellGrid *grid = (ParticleCellGrid *)malloc(sizeof(ParticleCellGrid));
+    ASSERT(grid != NULL);
+    particle_cells_init(grid, 0.25f);
+    particle_cells_build(grid, slots, count, x, y, z, r);
+    ASSERT_EQ(grid->count, count);
+    ASSERT(grid->cell_size > 0.4f);
+    ASSERT((int64_t)grid->dim_x * grid->dim_y * grid->dim_z <= PARTICLE_CELLS_TABLE_MAX);
+
+    /* Three uneven ranges together report each pair exactly once */
+    ParticlePairLog log = {swept, 0, SCATTERED * 16};
+    int32_t reported = particle_cells_sweep(grid, 0, 777, log_particle_pair, &log);
+    reported += particle_cells_sweep(grid, 777, 2000, log_particle_pair, &log);
+    reported += particle_cells_sweep(grid, 2000, count, log_particle_pair, &log);
+    ASSERT_EQ(reported, log.count);
+    ASSERT_EQ(log.count, brute_count);
+    ASSERT(brute_count > 1000);
+
+    qsort(brute, (size_t)brute_count, sizeof(int64_t), compare_pair_keys);
+    qsort(swept, (size_t)log.count, sizeof(int64_t), compare_pair_keys);
+    for (int32_t k = 0; k < brute_count; k++)
+        ASSERT_EQ(swept[k], brute[k]);
+
+    /* Colour order reports the same pairs */
+    log.count = 0;
+    reported = 0;
+    for (int32_t color = 0; color < PARTICLE_CELLS_COLORS; color++)
+        reported += particle_cells_sweep_cells(grid, grid->color_start[color], grid->color_start[color + 1],
+                                               log_particle_pair, &log);
+    ASSERT_EQ(reported, brute_count);
+    qsort(swept, (size_t)log.count, sizeof(int64_t), compare_pair_keys);
+    for (int32_t k = 0; k < brute_count; k++)
+        ASSERT_EQ(swept[k], brute[k]);
+    free(grid);
+    return 1;
+}
+
+TEST(particle_cells_colors_separate_cells)
+{
+    enum { SCATTERED = 4000 };
+    static float x[SCATTERED], y[SCATTERED], z[SCATTERED], r[SCATTERED];
+    static int32_t slots[SCATTERED];
+    RngState rng;
+    rng_seed(&rng, 4500);
+    particle_cells_scatter(&rng, SCATTERED, 2.0f, 0.04f, 0.06f, x, y, z, r);
+    for (int32_t i = 0; i < SCATTERED; i++)
+        slots[i] = i;
+
+    ParticleCellGrid *grid = (ParticleCellGrid *)malloc(sizeof(ParticleCellGrid));
+    ASSERT(grid != NULL);
+    particle_cells_init(grid, 0.1f);
+    particle_cells_build(grid, slots, SCATTERED, x, y, z, r);
+
+    /* Every occupied cell listed once; cells of one colour at least three apart on some axis */
+    int32_t occupied = 0;
+    for (int32_t p = 0; p < grid->count; p++)
+        occupied += p == 0 || grid->cell[p] != grid->cell[p - 1];
+    ASSERT_EQ(grid->color_start[PARTICLE_CELLS_COLORS], occupied);
+    ASSERT(occupied > 1000);
+
+    for (int32_t color = 0; color < PARTICLE_CELLS_COLORS; color++)
+    {
+        int32_t first = grid->color_start[color];
+        int32_t last = grid->color_start[color + 1];
+        for (int32_t a = first; a < last && a < first + 64; a++)
+        {
+            for (int32_t b = a + 1; b < last; b++)
+            {
+                int32_t ca = grid->color_cells[a], cb = grid->color_cells[b];
+                int32_t dx = abs(ca % grid->dim_x - cb % grid->dim_x);
+                int32_t dy = abs((ca / grid->dim_x) % grid->dim_y - (cb / grid->dim_x) % grid->dim_y);
+                int32_t dz = abs(ca / (grid->dim_x * grid->dim_y) - cb / (grid->dim_x * grid->dim_y));
+                ASSERT(dx >= 3 || dy >= 3 || dz >= 3);
+            }
+        }
+    }
+
+    free(grid);
+    return 1;
+}
+
+TEST(particle_collision_has_no_pair_cap)
+{
+    Bounds3D bounds = {-10.0f, 10.0f, 0.0f, 20.0f, -10.0f, 10.0f};
+    ParticleSystem *sys = particle_system_create(bounds);
+    ASSERT(sys != NULL);
+    sys->gravity = vec3_zero();
+    RngState rng;
+    rng_seed(&rng, 4401);
+
+    /* A dense cloud: far more touching pairs than the old 8192-pair budget */
+    for (int32_t i = 0; i < 20000; i++)
+    {
+        Vec3 position = vec3_create(rng_signed_half(&rng) * 2.4f, 5.0f + rng_signed_half(&rng) * 2.4f,
+                                    rng_signed_half(&rng) * 2.4f);
+        particle_system_add(sys, &rng, position, vec3_zero(), vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+    }
+    particle_system_update(sys, 1.0f / 60.0f, NULL, NULL);
+    printf("(%d pairs) ", sys->collision_pairs);
+    ASSERT(sys->collision_pairs > 8192);
+
+    /* Pushing the pairs apart leaves fewer overlaps for the next update */
+    int32_t first = sys->collision_pairs;
+    particle_system_update(sys, 1.0f / 60.0f, NULL, NULL);
+    ASSERT(sys->collision_pairs < first);
+
+    sys->enable_particle_collision = false;
+    particle_system_update(sys, 1.0f / 60.0f, NULL, NULL);
+    particle_system_destroy(sys);
+    return 1;
+}
+
+TEST(particle_cells_benchmark)
+{
+    static float x[PARTICLE_CELLS_MAX], y[PARTICLE_CELLS_MAX], z[PARTICLE_CELLS_MAX], r[PARTICLE_CELLS_MAX];
+    static int32_t slots[PARTICLE_CELLS_MAX];
+    ParticleCellGrid *grid = (ParticleCellGrid *)malloc(sizeof(ParticleCellGrid));
+    SpatialHashGrid *hash = (SpatialHashGrid *)malloc(sizeof(SpatialHashGrid));
+    ASSERT(grid != NULL && hash != NULL);
+    particle_cells_init(grid, 0.1f);
+    Bounds3D bounds = {-32.0f, 32.0f, -32.0f, 32.0f, -32.0f, 32.0f};
+    spatial_hash_init(hash, 0.25f, bounds);
+
+    const int32_t sizes[3] = {8192, 32768, 65536};
+    for (int32_t s = 0; s < 3; s++)
+    {
+        int32_t count = sizes[s];
+        RngState rng;
+        rng_seed(&rng, 4402);
+        /* Same density at every size: a few contacts per particle */
+        particle_cells_scatter(&rng, count, 0.13f * cbrtf((float)count), 0.04f, 0.06f, x, y, z, r);
+        for (int32_t i = 0; i < count; i++)
+            slots[i] = i;
+
+        const int32_t rounds = 10;
+        int32_t sorted_pairs = 0;
+        PlatformTime t0 = platform_time_now();
+        for (int32_t round = 0; round < rounds; round++)
+        {
+            sorted_pairs = 0;
+            particle_cells_build(grid, slots, count, x, y, z, r);
+            particle_cells_sweep(grid, 0, grid->count, count_particle_pair, &sorted_pairs);
+        }
+        float sorted_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f / (float)rounds;
+
+        /* The previous scheme: reinsert everything, then one hash query per particle (uncapped here) */
+        int32_t hashed_pairs = 0;
+        t0 = platform_time_now();
+        for (int32_t round = 0; round < rounds; round++)
+        {
+            hashed_pairs = 0;
+            spatial_hash_clear(hash);
+            for (int32_t i = 0; i < count; i++)
+                spatial_hash_insert(hash, i, vec3_create(x[i], y[i], z[i]), r[i]);
+            for (int32_t i = 0; i < count; i++)
+            {
+                int32_t nearby[SPATIAL_HASH_MAX_PER_CELL];
+                int32_t nearby_count = spatial_hash_query(hash, vec3_create(x[i], y[i], z[i]), r[i] * 2.0f, nearby,
+                                                          SPATIAL_HASH_MAX_PER_CELL);
+                for (int32_t n = 0; n < nearby_count; n++)
+                {
+                    int32_t j = nearby[n];
+                    if (j <= i)
+                        continue;
+                    float dx = x[j] - x[i], dy = y[j] - y[i], dz = z[j] - z[i];
+                    float min_dist = r[i] + r[j];
+                    if (dx * dx + dy * dy + dz * dz < min_dist * min_dist)
+                        hashed_pairs++;
+                }
+            }
+        }
+        float hashed_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f / (float)rounds;
+
+        printf("\n    %5d awake: %6d pairs, hash queries %.3fms, cell sort %.3fms", count, sorted_pairs, hashed_ms,
+               sorted_ms);
+        ASSERT(sorted_pairs >= hashed_pairs);
+        ASSERT(sorted_pairs > count / 2);
+    }
+    printf("\n  ");
+
+    free(hash);
+    free(grid);
+    return 1;
+}
+
+/* Young particles thrown onto the floor, boulder and wall of particle_terrain_test_volume */
+static ParticleSystem *particle_parallel_scene(VoxelVolume *terrain, PhysicsWorkers *workers)
+{
+    Bounds3D bounds = {-4.0f, 4.0f, 0.0f, 8.0f, -4.0f, 4.0f};
+    ParticleSystem *sys = particle_system_create(bounds);
+    if (!sys)
+        return NULL;
+    particle_system_set_workers(sys, workers);
+
+    RngState rng;
+    rng_seed(&rng, 4600);
+    particle_system_spawn_explosion(sys, &rng, vec3_create(0.0f, 2.0f, 0.0f), 0.9f, vec3_create(0.6f, 0.5f, 0.4f),
+                                    5000, 5.0f);
+    particle_system_spawn_explosion(sys, &rng, vec3_create(0.8f, 1.8f, -0.4f), 0.5f, vec3_create(0.3f, 0.3f, 0.3f),
+                                    2000, 3.0f);
+    for (int32_t tick = 0; tick < 60; tick++)
+        particle_system_update(sys, 1.0f / 60.0f, terrain, NULL);
+    return sys;
+}
+
+static bool particle_systems_identical(const ParticleSystem *a, const ParticleSystem *b)
+{
+    size_t n = sizeof(float) * (size_t)a->count;
+    return a->count == b->count && a->active_count == b->active_count &&
+           a->collision_pairs == b->collision_pairs &&
+           memcmp(a->position.x, b->position.x, n) == 0 && memcmp(a->position.y, b->position.y, n) == 0 &&
+           memcmp(a->position.z, b->position.z, n) == 0 && memcmp(a->velocity.x, b->velocity.x, n) == 0 &&
+           memcmp(a->velocity.y, b->velocity.y, n) == 0 && memcmp(a->velocity.z, b->velocity.z, n) == 0 &&
+           memcmp(a->rotation.x, b->rotation.x, n) == 0 && memcmp(a->state, b->state, (size_t)a->count) == 0 &&
+           memcmp(a->list_index, b->list_index, sizeof(int32_t) * (size_t)a->count) == 0;
+}
+
+TEST(particle_update_independent_of_worker_count)
+{
+    VoxelVolume *terrain = particle_terrain_test_volume();
+    volume_rebuild_all_occupancy(terrain);
+    PhysicsWorkers *one = physics_workers_create(1);
+    PhysicsWorkers *four = physics_workers_create(4);
+    ASSERT(one != NULL && four != NULL);
+
+    PlatformTime t0 = platform_time_now();
+    ParticleSystem *serial = particle_parallel_scene(terrain, NULL);
+    float serial_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+    t0 = platform_time_now();
+    ParticleSystem *threaded = particle_parallel_scene(terrain, four);
+    float threaded_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+    ParticleSystem *single = particle_parallel_scene(terrain, one);
+    ASSERT(serial != NULL && threaded != NULL && single != NULL);
+
+    printf("(%d pairs, %d settled; 60 updates: serial %.1fms, 4 workers %.1fms) ", serial->collision_pairs,
+           serial->lists[PARTICLE_SETTLED].count, serial_ms, threaded_ms);
+    ASSERT(serial->collision_pairs > 0);
+    ASSERT(serial->lists[PARTICLE_SETTLED].count > 0);
+    ASSERT(particle_systems_identical(serial, threaded));
+    ASSERT(particle_systems_identical(serial, single));
+
+    particle_system_destroy(single);
+    particle_system_destroy(threaded);
+    particle_system_destroy(serial);
+    physics_workers_destroy(four);
+    physics_workers_destroy(one);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(particle_spawn_buffers_merge_in_order)
+{
+    Bounds3D bounds = {-4.0f, 4.0f, 0.0f, 8.0f, -4.0f, 4.0f};
+    ParticleSystem *direct = particle_system_create(bounds);
+    ParticleSystem *merged = particle_system_create(bounds);
+    ParticleSpawnBuffer *buffers[2] = {(ParticleSpawnBuffer *)malloc(sizeof(ParticleSpawnBuffer)),
+                                       (ParticleSpawnBuffer *)malloc(sizeof(ParticleSpawnBuffer))};
+    ASSERT(direct != NULL && merged != NULL && buffers[0] != NULL && buffers[1] != NULL);
+    particle_spawn_buffer_clear(buffers[0]);
+    particle_spawn_buffer_clear(buffers[1]);
+
+    RngState first, second;
+    rng_seed(&first, 4700);
+    rng_seed(&second, 4701);
+    particle_system_spawn_explosion(direct, &first, vec3_create(0.0f, 2.0f, 0.0f), 1.0f,
+                                    vec3_create(1.0f, 0.5f, 0.2f), 300, 4.0f);
+    particle_system_spawn_explosion(direct, &second, vec3_create(1.0f, 3.0f, 0.0f), 0.5f,
+                                    vec3_create(0.2f, 0.5f, 1.0f), 200, 2.0f);
+
+    /* The second buffer fills first, as if its thread finished earlier */
+    rng_seed(&first, 4700);
+    rng_seed(&second, 4701);
+    ASSERT_EQ(particle_spawn_buffer_explosion(buffers[1], &second, vec3_create(1.0f, 3.0f, 0.0f), 0.5f,
+                                              vec3_create(0.2f, 0.5f, 1.0f), 200, 2.0f), 200);
+    ASSERT_EQ(particle_spawn_buffer_explosion(buffers[0], &first, vec3_create(0.0f, 2.0f, 0.0f), 1.0f,
+                                              vec3_create(1.0f, 0.5f, 0.2f), 300, 4.0f), 300);
+    ASSERT_EQ(particle_system_merge_spawns(merged, buffers, 2), 500);
+    ASSERT_EQ(buffers[0]->count, 0);
+    ASSERT_EQ(buffers[1]->count, 0);
+
+    ASSERT_EQ(merged->count, direct->count);
+    for (int32_t i = 0; i < direct->count; i++)
+    {
+        Particle expected = particle_system_get(direct, i);
+        ASSERT(particle_bits_equal(merged, i, &expected));
+        ASSERT(vec3_bits_equal(merged->color[i], direct->color[i]));
+        ASSERT(memcmp(&merged->radius[i], &direct->radius[i], sizeof(float)) == 0);
+    }
+    ASSERT(memcmp(merged->lists[PARTICLE_YOUNG].slots, direct->lists[PARTICLE_YOUNG].slots,
+                  sizeof(int32_t) * (size_t)direct->lists[PARTICLE_YOUNG].count) == 0);
+
+    /* A full buffer counts what it drops */
+    ASSERT_EQ(particle_spawn_buffer_explosion(buffers[0], &first, vec3_zero(), 1.0f, vec3_create(1.0f, 1.0f, 1.0f),
+                                              PARTICLE_SPAWN_BUFFER_MAX + 10, 1.0f),
+              PARTICLE_SPAWN_BUFFER_MAX);
+    ASSERT_EQ(buffers[0]->dropped, 10);
+
+    free(buffers[1]);
+    free(buffers[0]);
+    particle_system_destroy(merged);
+    particle_system_destroy(direct);
+    return 1;
+}
+
+/* A stone floor with its top at y = 0.5 */
+static VoxelVolume *particle_deposit_floor(Bounds3D bounds)
+{
+    Vec3 origin = vec3_create(bounds.min_x, bounds.min_y, bounds.min_z);
+    int32_t chunks = 128 / CHUNK_SIZE;
+    VoxelVolume *terrain = volume_create_dims(chunks, chunks, chunks, origin, 0.1f);
+    volume_fill_box(terrain, origin, vec3_create(bounds.max_x, bounds.min_y + 0.5f, bounds.max_z), MAT_STONE);
+    volume_rebuild_all_occupancy(terrain);
+    return terrain;
+}
+
+TEST(particle_deposit_fills_voxels_and_frees)
+{
+    Bounds3D bounds = {-5.0f, 5.0f, 0.0f, 8.0f, -5.0f, 5.0f};
+    VoxelVolume *terrain = particle_deposit_floor(bounds);
+    ParticleSystem *sys = particle_system_create(bounds);
+    ASSERT(terrain != NULL && sys != NULL);
+    sys->enable_particle_collision = false;
+    RngState rng;
+    rng_seed(&rng, 4800);
+
+    /* Twenty resting on the floor, every other one with a material of its own */
+    for (int32_t i = 0; i < 20; i++)
+    {
+        int32_t slot = particle_system_add(sys, &rng, vec3_create(-4.0f + 0.3f * (float)i, 0.56f, 1.0f),
+                                           vec3_zero(), vec3_create(1.0f, 1.0f, 1.0f), 0.05f);
+        if (i % 2)
+            sys->material[slot] = MAT_BRICK;
+    }
+
+    const float dt = 1.0f / 60.0f;
+    for (int32_t tick = 0; tick < 90; tick++)
+        particle_system_update(sys, dt, terrain, NULL);
+    ASSERT_EQ(sys->lists[PARTICLE_SETTLED].count, 20);
+
+    /* Not settled long enough, or no material to deposit: nothing changes */
+    uint32_t version = terrain->version_counter;
+    ASSERT_EQ(particle_system_deposit_settled(sys, terrain, 100000, MAT_DIRT), 0);
+    ASSERT_EQ(particle_system_deposit_settled(sys, terrain, 0, MAT_AIR), 10);
+    ASSERT_EQ(sys->lists[PARTICLE_SETTLED].count, 10);
+
+    for (int32_t tick = 0; tick < 30; tick++)
+        particle_system_update(sys, dt, terrain, NULL);
+    ASSERT(terrain->version_counter != version);
+    Vec3 positions[20];
+    for (int32_t i = 0; i < 20; i++)
+        positions[i] = particle_system_position(sys, i);
+    ASSERT_EQ(particle_system_deposit_settled(sys, terrain, 30, MAT_DIRT), 10);
+
+    ASSERT_EQ(sys->active_count, 0);
+    ASSERT(particle_lists_consistent(sys));
+    for (int32_t i = 0; i < 20; i++)
+        ASSERT_EQ(volume_get_at(terrain, positions[i]), i % 2 ? MAT_BRICK : MAT_DIRT);
+    ASSERT(volume_is_solid_at(terrain, vec3_create(-4.0f, 0.55f, 1.0f)));
+    ASSERT(!volume_is_solid_at(terrain, vec3_create(-3.85f, 0.55f, 1.0f)));
+
+    /* Deposits only add support: the next update skips the settled support check */
+    ASSERT(sys->support_terrain == terrain && sys->support_version == terrain->version_counter);
+
+    particle_system_destroy(sys);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(particle_deposit_keeps_settled_count_bounded)
+{
+    Bounds3D bounds = {-5.0f, 5.0f, 0.0f, 8.0f, -5.0f, 5.0f};
+    VoxelVolume *terrain = particle_deposit_floor(bounds);
+    ParticleSystem *kept = particle_system_create(bounds);
+    ParticleSystem *deposited = particle_system_create(bounds);
+    ASSERT(terrain != NULL && kept != NULL && deposited != NULL);
+    VoxelVolume *kept_terrain = particle_deposit_floor(bounds);
+    RngState rng_kept, rng_deposited;
+    rng_seed(&rng_kept, 4801);
+    rng_seed(&rng_deposited, 4801);
+
+    /* Repeated showers of debris: without deposition the settled list keeps growing */
+    const float dt = 1.0f / 60.0f;
+    int32_t solid_before = terrain->total_solid_voxels;
+    for (int32_t round = 0; round < 8; round++)
+    {
+        Vec3 center = vec3_create(-3.0f + 0.8f * (float)round, 2.0f, 0.0f);
+        particle_system_spawn_explosion(kept, &rng_kept, center, 0.8f, vec3_create(0.5f, 0.4f, 0.3f), 400, 3.0f);
+        particle_system_spawn_explosion(deposited, &rng_deposited, center, 0.8f, vec3_create(0.5f, 0.4f, 0.3f), 400,
+                                        3.0f);
+        for (int32_t tick = 0; tick < 120; tick++)
+        {
+            particle_system_update(kept, dt, kept_terrain, NULL);
+            particle_system_update(deposited, dt, terrain, NULL);
+            particle_system_deposit_settled(deposited, terrain, 30, MAT_DIRT);
+        }
+    }
+
+    printf("(settled kept %d, deposited %d; %d voxels added) ", kept->lists[PARTICLE_SETTLED].count,
+           deposited->lists[PARTICLE_SETTLED].count, terrain->total_solid_voxels - solid_before);
+    ASSERT(kept->lists[PARTICLE_SETTLED].count > 1000);
+    ASSERT(deposited->lists[PARTICLE_SETTLED].count < kept->lists[PARTICLE_SETTLED].count / 4);
+    ASSERT(terrain->total_solid_voxels > solid_before);
+    ASSERT(particle_lists_consistent(deposited));
+
+    particle_system_destroy(deposited);
+    particle_system_destroy(kept);
+    volume_destroy(kept_terrain);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(debris_lod_threshold_rises_with_body_count)
+{
+    ParticleSystem *sys = particle_system_create((Bounds3D){-5.0f, 5.0f, 0.0f, 8.0f, -5.0f, 5.0f});
+    ASSERT(sys != NULL);
+    RngState rng;
+    rng_seed(&rng, 4700);
+    DebrisLod lod;
+    debris_lod_init(&lod, sys, &rng);
+    lod.max_bodies = 100;
+
+    /* Base threshold up to half the limit, then rising to the pressure one */
+    ASSERT_EQ(debris_lod_voxel_threshold(&lod, 0), DEBRIS_LOD_MAX_VOXELS);
+    ASSERT_EQ(debris_lod_voxel_threshold(&lod, 50), DEBRIS_LOD_MAX_VOXELS);
+    ASSERT_EQ(debris_lod_voxel_threshold(&lod, 100), DEBRIS_LOD_PRESSURE_VOXELS);
+    ASSERT_EQ(debris_lod_voxel_threshold(&lod, 400), DEBRIS_LOD_PRESSURE_VOXELS);
+    int32_t previous = 0;
+    for (int32_t bodies = 0; bodies <= 100; bodies++)
+    {
+        int32_t threshold = debris_lod_voxel_threshold(&lod, bodies);
+        ASSERT(threshold >= previous);
+        previous = threshold;
+    }
+
+    ASSERT(debris_lod_should_demote(&lod, 8, 100.0f, 0));
+    ASSERT(!debris_lod_should_demote(&lod, 9, 1.0f, 0));
+    ASSERT(debris_lod_should_demote(&lod, 9, 1.0f, 90));
+    ASSERT(!debris_lod_should_demote(&lod, 0, 0.0f, 0));
+
+    /* A mass threshold demotes light fragments above the voxel threshold */
+    lod.max_mass = 12.0f;
+    ASSERT(debris_lod_should_demote(&lod, 10, 12.0f, 0));
+    ASSERT(!debris_lod_should_demote(&lod, 10, 12.5f, 0));
+    ASSERT(!debris_lod_should_demote(&lod, DEBRIS_LOD_MAX_FRAGMENT_VOXELS + 1, 0.0f, 100));
+
+    particle_system_destroy(sys);
+    return 1;
+}
+
+TEST(debris_lod_demotes_small_terrain_islands)
+{
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    int32_t chunks = 128 / CHUNK_SIZE;
+    VoxelVolume *vol = volume_create_dims(chunks, chunks, chunks, vec3_create(bounds.min_x, bounds.min_y, bounds.min_z), 0.1f);
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    ParticleSystem *sys = particle_system_create(bounds);
+    ASSERT(vol != NULL && obj_world != NULL && sys != NULL);
+    ConnectivityWorkBuffer work;
+    ASSERT(connectivity_work_init(&work, vol));
+
+    /* A floating 2x2 brick slab (4 voxels) and a floating half-metre stone block */
+    volume_edit_begin(vol);
+    for (int32_t i = 0; i < 4; i++)
+        volume_edit_set(vol, vec3_create(0.05f + 0.1f * (float)(i & 1), 5.05f, 0.05f + 0.1f * (float)(i >> 1)), MAT_BRICK);
+    volume_fill_box(vol, vec3_create(-3.0f, 3.0f, -3.0f), vec3_create(-2.5f, 3.5f, -2.5f), MAT_STONE);
+    volume_edit_end(vol);
+    ASSERT_EQ(volume_get_at(vol, vec3_create(0.05f, 5.05f, 0.05f)), MAT_BRICK);
+
+    RngState rng;
+    rng_seed(&rng, 4701);
+    DebrisLod lod;
+    debris_lod_init(&lod, sys, &rng);
+
+    DetachConfig cfg = detach_config_default();
+    cfg.debris_fn = debris_lod_take_island;
+    cfg.debris_user = &lod;
+    DetachResult result;
+    detach_terrain_process(vol, obj_world, &cfg, &work, &result);
+
+    /* The slab became four brick particles at its voxel centres, the block an object */
+    ASSERT_EQ(result.islands_demoted, 1);
+    ASSERT_EQ(result.bodies_spawned, 1);
+    ASSERT(obj_world->objects[result.spawned_indices[0]].voxel_count > DEBRIS_LOD_PRESSURE_VOXELS);
+    ASSERT_EQ(sys->active_count, 4);
+    ASSERT_EQ(lod.fragments_demoted, 1);
+    ASSERT_EQ(lod.voxels_demoted, 4);
+    ASSERT_EQ(lod.particles_spawned, 4);
+    ASSERT_EQ(volume_get_at(vol, vec3_create(0.05f, 5.05f, 0.05f)), MAT_AIR);
+    Vec3 brick = material_get_color(MAT_BRICK);
+    for (int32_t i = 0; i < sys->count; i++)
+    {
+        ASSERT(particle_system_is_active(sys, i));
+        ASSERT_EQ(sys->material[i], MAT_BRICK);
+        ASSERT_NEAR(sys->color[i].x, brick.x, 1e-6f);
+        Vec3 pos = particle_system_position(sys, i);
+        ASSERT(pos.x > 0.0f && pos.x < 0.2f && pos.z > 0.0f && pos.z < 0.2f);
+        ASSERT_NEAR(pos.y, 5.05f, 1e-3f);
+        ASSERT_NEAR(vec3_length(particle_system_get(sys, i).velocity), 0.0f, 1e-6f);
+    }
+
+    connectivity_work_destroy(&work);
+    particle_system_destroy(sys);
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(vol);
+    return 1;
+}
+
+TEST(debris_lod_demotes_small_split_fragments)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    const float vs = 0.25f;
+    VoxelObjectWorld *world = voxel_object_world_create(bounds, vs);
+    PhysicsWorld *physics = physics_world_create(world, NULL);
+    ParticleSystem *sys = particle_system_create(bounds);
+    ASSERT(world != NULL && physics != NULL && sys != NULL);
+
+    /* A 4x4x4 block with a two-voxel nub hanging off one bridge voxel */
+    uint8_t voxels[6 * 4 * 4];
+    memset(voxels, 0, sizeof(voxels));
+    for (int32_t z = 0; z < 4; z++)
+        for (int32_t y = 0; y < 4; y++)
+            for (int32_t x = 0; x < 4; x++)
+                voxels[x + y * 6 + z * 24] = MAT_STONE;
+    voxels[4] = MAT_STONE;
+    voxels[5] = MAT_BRICK;
+    voxels[5 + 6] = MAT_BRICK;
+    Vec3 origin = vec3_create(0.0f, 10.0f, 0.0f);
+    int32_t obj_idx = voxel_object_world_add_from_voxels(world, voxels, 6, 4, 4, origin, vs);
+    ASSERT(obj_idx >= 0);
+    ASSERT_EQ(world->objects[obj_idx].voxel_count, 67);
+
+    physics_world_sync_objects(physics);
+    int32_t body = physics_world_find_body_for_object(physics, obj_idx);
+    ASSERT(body >= 0);
+    Vec3 velocity = vec3_create(1.0f, 2.0f, -0.5f);
+    physics_body_set_velocity(physics, body, velocity);
+
+    RngState rng;
+    rng_seed(&rng, 4702);
+    DebrisLod lod;
+    debris_lod_init(&lod, sys, &rng);
+
+    /* Knock out the bridge: the nub splits off and becomes particles moving with the block */
+    Vec3 bridge = vec3_create(origin.x + 4.5f * vs, origin.y + 0.5f * vs, origin.z + 0.5f * vs);
+    Vec3 destroyed_pos[4];
+    ASSERT_EQ(detach_object_at_point(world, obj_idx, bridge, 0.5f * vs, destroyed_pos, NULL, 4), 1);
+    voxel_object_world_process_splits(world);
+    ASSERT_EQ(debris_lod_process_splits(&lod, world, physics), 1);
+    voxel_object_world_process_recalcs(world);
+
+    ASSERT_EQ(sys->active_count, 2);
+    for (int32_t i = 0; i < sys->count; i++)
+    {
+        ASSERT_EQ(sys->material[i], MAT_BRICK);
+        Vec3 v = particle_system_get(sys, i).velocity;
+        ASSERT_NEAR(v.x, velocity.x, 1e-5f);
+        ASSERT_NEAR(v.y, velocity.y, 1e-5f);
+        ASSERT_NEAR(v.z, velocity.z, 1e-5f);
+        ASSERT_NEAR(particle_system_position(sys, i).x, origin.x + 5.5f * vs, 1e-4f);
+    }
+
+    /* The block stays an object; nothing else is left */
+    int32_t active = 0;
+    for (int32_t i = 0; i < world->object_count; i++)
+    {
+        if (world->objects[i].active)
+        {
+            ASSERT_EQ(world->objects[i].voxel_count, 64);
+            active++;
+        }
+    }
+    ASSERT_EQ(active, 1);
+    ASSERT_EQ(lod.fragments_demoted, 1);
+    ASSERT_EQ(world->split_touched_count, 0);
+
+    /* A later split reuses the freed slot without trouble */
+    physics_world_sync_objects(physics);
+    ASSERT_EQ(physics->body_count, 1);
+    int32_t again = voxel_object_world_add_box(world, vec3_create(5.0f, 10.0f, 0.0f), vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    ASSERT(again >= 0 && again != obj_idx);
+    ASSERT(world->objects[again].active);
+
+    particle_system_destroy(sys);
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(world);
+    return 1;
+}
+
+/* Object voxels whose centre lands in solid terrain of their material, -1 at the first miss */
+static int32_t stamped_voxels_present(const VoxelVolume *terrain, const VoxelObjectWorld *world, int32_t obj_index,
+                                      bool check_material)
+{
+    const VoxelObject *obj = &world->objects[obj_index];
+    VoxelObjectPose pose = voxel_object_pose(world, obj_index);
+    float half_grid = (float)VOBJ_GRID_SIZE * obj->voxel_size * 0.5f;
+    float rot[9];
+    quat_to_mat3(pose.orientation, rot);
+    int32_t found = 0;
+    for (int32_t idx = 0; idx < VOBJ_TOTAL_VOXELS; idx++)
+    {
+        uint8_t mat = obj->voxels[idx].material;
+        if (mat == 0)
+            continue;
+        int32_t x, y, z;
+        vobj_coords(idx, &x, &y, &z);
+        Vec3 local = vec3_create(((float)x + 0.5f) * obj->voxel_size - half_grid,
+                                 ((float)y + 0.5f) * obj->voxel_size - half_grid,
+                                 ((float)z + 0.5f) * obj->voxel_size - half_grid);
+        uint8_t got = volume_get_at(terrain, vec3_add(pose.position, mat3_transform_vec3(rot, local)));
+        if (got == 0 || (check_material && got != mat))
+            return -1;
+        found++;
+    }
+    return found;
+}
+
+TEST(voxel_object_stamp_preserves_shape_and_materials)
+{
+    VoxelVolume *terrain = create_island_floor();
+    ASSERT(terrain != NULL);
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *world = voxel_object_world_create(bounds, 0.1f);
+    ASSERT(world != NULL);
+
+    /* Grid-aligned, two materials: the stamp is an exact copy */
+    uint8_t voxels[4 * 2 * 4];
+    for (int32_t i = 0; i < 4 * 2 * 4; i++)
+        voxels[i] = (i % 4) < 2 ? MAT_STONE : MAT_BRICK;
+    int32_t aligned = voxel_object_world_add_from_voxels(world, voxels, 4, 2, 4, vec3_create(1.0f, 1.0f, 1.0f), 0.1f);
+    ASSERT(aligned >= 0);
+    VoxelObject *obj = &world->objects[aligned];
+    ASSERT_EQ(obj->voxel_count, 32);
+
+    int32_t solid_before = terrain->total_solid_voxels;
+    int32_t chunks = 0;
+    ASSERT_EQ(voxel_object_stamp_volume(obj, voxel_object_pose(world, aligned), terrain, false, &chunks), 32);
+    ASSERT(chunks >= 1 && chunks <= 8);
+    ASSERT_EQ(terrain->total_solid_voxels, solid_before);
+
+    volume_edit_begin(terrain);
+    ASSERT_EQ(voxel_object_stamp_volume(obj, voxel_object_pose(world, aligned), terrain, true, NULL), 32);
+    volume_edit_end(terrain);
+    ASSERT_EQ(terrain->total_solid_voxels, solid_before + 32);
+    ASSERT_EQ(stamped_voxels_present(terrain, world, aligned, true), 32);
+
+    /* Already-solid voxels are left alone */
+    ASSERT_EQ(voxel_object_stamp_volume(obj, voxel_object_pose(world, aligned), terrain, false, NULL), 0);
+
+    /* Rotated 45 degrees about y: every voxel centre still lands in a solid voxel */
+    int32_t rotated = voxel_object_world_add_box(world, vec3_create(-3.0f, 2.0f, -3.0f),
+                                                 vec3_create(0.3f, 0.3f, 0.3f), MAT_WOOD);
+    ASSERT(rotated >= 0);
+    obj = &world->objects[rotated];
+    voxel_object_set_orientation(world, rotated, quat_from_axis_angle(vec3_create(0.0f, 1.0f, 0.0f), 0.25f * 3.14159265f));
+
+    solid_before = terrain->total_solid_voxels;
+    volume_edit_begin(terrain);
+    int32_t written = voxel_object_stamp_volume(obj, voxel_object_pose(world, rotated), terrain, true, NULL);
+    volume_edit_end(terrain);
+    printf("(rotated: %d voxels -> %d) ", obj->voxel_count, written);
+    ASSERT(written >= obj->voxel_count);
+    ASSERT_EQ(terrain->total_solid_voxels, solid_before + written);
+    ASSERT_EQ(stamped_voxels_present(terrain, world, rotated, true), obj->voxel_count);
+
+    voxel_object_world_destroy(world);
+    volume_destroy(terrain);
+    return 1;
+}
+
+/* Steps until every body has rested at least min_rest ticks, or max_ticks pass */
+static bool step_until_rested(PhysicsWorld *physics, int32_t min_rest, int32_t max_ticks)
+{
+    for (int32_t tick = 0; tick < max_ticks; tick++)
+    {
+        physics_world_step(physics, 1.0f / 60.0f);
+        bool all = true;
+        for (int32_t i = 0; i <= physics->max_body_index; i++)
+        {
+            if ((physics->flags[i] & PHYS_FLAG_ACTIVE) && physics->bodies[i].rest_ticks < min_rest)
+                all = false;
+        }
+        if (all)
+            return true;
+    }
+    return false;
+}
+
+TEST(sleeping_grounded_body_freezes_into_terrain)
+{
+    VoxelVolume *terrain = create_island_floor();
+    ASSERT(terrain != NULL);
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *obj_world = voxel_object_world_create(bounds, 0.1f);
+    PhysicsWorld *physics = physics_world_create(obj_world, terrain);
+    ASSERT(obj_world != NULL && physics != NULL);
+
+    int32_t first = voxel_object_world_add_box(obj_world, vec3_create(-2.0f, 1.0f, 0.0f),
+                                               vec3_create(0.2f, 0.2f, 0.2f), MAT_BRICK);
+    int32_t second = voxel_object_world_add_box(obj_world, vec3_create(2.0f, 1.0f, 0.0f),
+                                                vec3_create(0.2f, 0.2f, 0.2f), MAT_WOOD);
+    ASSERT(first >= 0 && second >= 0);
+    ASSERT(physics_world_add_body(physics, first) >= 0);
+    ASSERT(physics_world_add_body(physics, second) >= 0);
+    int32_t voxels = obj_world->objects[first].voxel_count + obj_world->objects[second].voxel_count;
+
+    PhysicsFreeze freeze;
+    physics_freeze_init(&freeze);
+    freeze.rest_ticks = 30;
+    freeze.max_per_tick = 1;
+
+    /* Falling and freshly asleep bodies stay bodies */
+    for (int32_t tick = 0; tick < 10; tick++)
+        physics_world_step(physics, 1.0f / 60.0f);
+    ASSERT_EQ(physics_freeze_resting(&freeze, physics), 0);
+    ASSERT_EQ(physics->body_count, 2);
+
+    ASSERT(step_until_rested(physics, 30, 1200));
+    Vec3 first_pos = voxel_object_position(obj_world, first);
+    Vec3 second_pos = voxel_object_position(obj_world, second);
+    int32_t solid_before = terrain->total_solid_voxels;
+
+    /* One per call: the other is deferred to the next */
+    ASSERT_EQ(physics_freeze_resting(&freeze, physics), 1);
+    ASSERT_EQ(freeze.deferred, 1);
+    ASSERT_EQ(physics->body_count, 1);
+    ASSERT_EQ(physics_freeze_resting(&freeze, physics), 1);
+    ASSERT_EQ(freeze.deferred, 0);
+    ASSERT_EQ(physics->body_count, 0);
+    ASSERT_EQ(freeze.bodies_frozen, 2);
+
+    ASSERT(!obj_world->objects[first].active);
+    ASSERT(!obj_world->objects[second].active);
+    int32_t added = terrain->total_solid_voxels - solid_before;
+    printf("(%d object voxels -> %d terrain voxels) ", voxels, added);
+    ASSERT_EQ(added, freeze.voxels_written);
+    ASSERT(added >= voxels);
+    ASSERT_EQ(volume_get_at(terrain, first_pos), MAT_BRICK);
+    ASSERT_EQ(volume_get_at(terrain, second_pos), MAT_WOOD);
+
+    /* Both slots are free again */
+    int32_t again = voxel_object_world_add_box(obj_world, vec3_create(0.0f, 2.0f, 0.0f),
+                                               vec3_create(0.2f, 0.2f, 0.2f), MAT_STONE);
+    ASSERT(again >= 0);
+    physics_world_sync_objects(physics);
+    ASSERT_EQ(physics->body_count, 1);
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(obj_world);
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(detach_object_at_point_matches_world_space_sphere)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    VoxelObjectWorld *world = voxel_object_world_create(bounds, 0.1f);
+    ASSERT(world != NULL);
+
+    int32_t obj_idx = voxel_object_world_add_box(world, vec3_create(1.0f, 10.0f, -2.0f),
+                                                 vec3_create(1.0f, 0.8f, 1.2f), MAT_STONE);
+    ASSERT(obj_idx >= 0);
+    VoxelObject *obj = &world->objects[obj_idx];
+    voxel_object_set_orientation(world, obj_idx, quat_normalize(quat_create(0.2f, 0.4f, -0.1f, 0.9f)));
+    voxel_object_world_process_recalcs(world);
+
+    /* Reference: every voxel centre in world space against the sphere */
+    Vec3 impact = vec3_add(voxel_object_position(world, obj_idx), vec3_create(0.37f, -0.21f, 0.44f));
+    float radius = 0.33f;
+    float half_size = obj->voxel_size * (float)VOBJ_GRID_SIZE * 0.5f;
+    float rot[9];
+    quat_to_mat3(voxel_object_orientation(world, obj_idx), rot);
+    static bool expected[VOBJ_TOTAL_VOXELS];
+    int32_t expected_count = 0;
+    for (int32_t idx = 0; idx < VOBJ_TOTAL_VOXELS; idx++)
+    {
+        expected[idx] = false;
+        if (obj->voxels[idx].material == 0)
+            continue;
+        int32_t x, y, z;
+        vobj_coords(idx, &x, &y, &z);
+        Vec3 local = vec3_create(((float)x + 0.5f) * obj->voxel_size - half_size,
+                                 ((float)y + 0.5f) * obj->voxel_size - half_size,
+                                 ((float)z + 0.5f) * obj->voxel_size - half_size);
+        Vec3 p = vec3_add(voxel_object_position(world, obj_idx), mat3_transform_vec3(rot, local));
+        if (vec3_length(vec3_sub(p, impact)) < radius)
+        {
+            expected[idx] = true;
+            expected_count++;
+        }
+    }
+    ASSERT(expected_count > 50);
+
+    int32_t before = obj->voxel_count;
+    uint32_t revision = obj->voxel_revision;
+    static Vec3 positions[512];
+    int32_t destroyed = detach_object_at_point(world, obj_idx, impact, radius, positions, NULL, 512);
+    ASSERT_EQ(destroyed, expected_count);
+    ASSERT_EQ(obj->voxel_count, before - expected_count);
+    ASSERT(obj->voxel_revision != revision);
+    for (int32_t idx = 0; idx < VOBJ_TOTAL_VOXELS; idx++)
+    {
+        if (expected[idx])
+            ASSERT_EQ(obj->voxels[idx].material, 0);
+    }
+    for (int32_t i = 0; i < destroyed; i++)
+        ASSERT(vec3_length(vec3_sub(positions[i], impact)) < radius + 1e-4f);
+
+    /* A miss touches nothing: no revision bump, no split queued */
+    voxel_object_world_process_splits(world);
+    voxel_object_world_process_recalcs(world);
+    revision = obj->voxel_revision;
+    int32_t tail = world->split_queue_tail;
+    Vec3 far_away = vec3_add(voxel_object_position(world, obj_idx), vec3_create(0.0f, 5.0f, 0.0f));
+    ASSERT_EQ(detach_object_at_point(world, obj_idx, far_away, 0.5f, positions, NULL, 512), 0);
+    ASSERT_EQ(obj->voxel_revision, revision);
+    ASSERT_EQ(world->split_queue_tail, tail);
+    ASSERT(!obj->shape_dirty);
+
+    voxel_object_world_destroy(world);
+    return 1;
+}
+
+TEST(detach_object_at_point_benchmark)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 64.0f, -16.0f, 16.0f};
+    VoxelObjectWorld *world = voxel_object_world_create(bounds, 0.1f);
+    ASSERT(world != NULL);
+
+    int32_t obj_idx = voxel_object_world_add_box(world, vec3_create(0.0f, 10.0f, 0.0f),
+                                                 vec3_create(1.5f, 1.5f, 1.5f), MAT_STONE);
+    ASSERT(obj_idx >= 0);
+    VoxelObject *obj = &world->objects[obj_idx];
+    voxel_object_set_orientation(world, obj_idx, quat_from_axis_angle(vec3_create(0.0f, 1.0f, 0.0f), 0.6f));
+
+    /* Small hits across the surface: cost should follow the few voxels each removes */
+    const int32_t hits = 2000;
+    int32_t total = 0;
+    Vec3 positions[64];
+    PlatformTime t0 = platform_time_now();
+    for (int32_t i = 0; i < hits && obj->active; i++)
+    {
+        float t = (float)i * 0.37f;
+        Vec3 impact = vec3_add(voxel_object_position(world, obj_idx), vec3_create(1.4f * cosf(t), 1.4f * sinf(t * 0.7f), 1.4f * sinf(t)));
+        total += detach_object_at_point(world, obj_idx, impact, 0.12f, positions, NULL, 64);
+    }
+    float secs = platform_time_delta_seconds(t0, platform_time_now());
+    printf("(%d hits, %d voxels, %.3f us/hit) ", hits, total, secs * 1e6f / (float)hits);
+    ASSERT(total > 0);
+
+    voxel_object_world_destroy(world);
+    return 1;
+}
+
+/* Solid voxels at every voxel centre inside [min, max] */
+static void character_fill(VoxelVolume *terrain, Vec3 min, Vec3 max)
+{
+    float vs = terrain->voxel_size;
+    for (float z = min.z + 0.5f * vs; z < max.z; z += vs)
+        for (float y = min.y + 0.5f * vs; y < max.y; y += vs)
+            for (float x = min.x + 0.5f * vs; x < max.x; x += vs)
+                volume_set_at(terrain, vec3_create(x, y, z), MAT_STONE);
+}
+
+static void character_run(Character *character, VoxelVolume *terrain, VoxelObjectWorld *objects,
+                          Vec3 input, int32_t ticks, float dt)
+{
+    for (int32_t tick = 0; tick < ticks; tick++)
+        character_move(character, terrain, objects, input, dt);
+}
+
+TEST(character_lands_on_terrain_floor)
+{
+    VoxelVolume *terrain = create_island_floor();
+    ASSERT(terrain != NULL);
+
+    Character character;
+    character_init(&character, vec3_create(0.3f, 2.0f, -0.2f));
+    character_run(&character, terrain, NULL, vec3_zero(), 90, 1.0f / 60.0f);
+
+    ASSERT(character.is_grounded);
+    ASSERT(character.position.y >= 0.5f);
+    ASSERT(character.position.y < 0.5f + 0.01f);
+    ASSERT(fabsf(character.velocity.y) < 1e-3f);
+    ASSERT(character.ground_normal.y > 0.99f);
+
+    /* Walking keeps it on the floor */
+    character_run(&character, terrain, NULL, vec3_create(2.0f, 0.0f, 1.0f), 60, 1.0f / 60.0f);
+    ASSERT(character.is_grounded);
+    ASSERT_NEAR(character.position.x, 2.3f, 0.05f);
+    ASSERT(character.position.y >= 0.5f && character.position.y < 0.51f);
+
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(character_fast_fall_stops_on_thin_floor)
+{
+    VoxelVolume *terrain = create_island_floor();
+    ASSERT(terrain != NULL);
+    character_fill(terrain, vec3_create(-1.0f, 3.0f, -1.0f), vec3_create(1.0f, 3.1f, 1.0f));
+    volume_rebuild_all_occupancy(terrain);
+
+    /* A metre per tick against a plate one voxel thick */
+    Character character;
+    character_init(&character, vec3_create(0.05f, 8.0f, 0.05f));
+    character.velocity.y = -PHYS_MAX_LINEAR_VELOCITY;
+    character_run(&character, terrain, NULL, vec3_zero(), 30, 1.0f / 30.0f);
+
+    ASSERT(character.is_grounded);
+    ASSERT(character.position.y >= 3.1f);
+    ASSERT(character.position.y < 3.1f + 0.01f);
+
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(character_lands_on_fine_rubble)
+{
+    VoxelVolume *terrain = create_island_floor();
+    ASSERT(terrain != NULL);
+    /* A 3D checkerboard up to y = 1.6: no two solid voxels share a run, so every voxel is its own box */
+    for (int32_t iz = -16; iz < 16; iz++)
+        for (int32_t iy = 5; iy < 16; iy++)
+            for (int32_t ix = -16; ix < 16; ix++)
+                if ((ix + iy + iz) & 1)
+                    volume_set_at(terrain, vec3_create(((float)ix + 0.5f) * 0.1f, ((float)iy + 0.5f) * 0.1f,
+                                                       ((float)iz + 0.5f) * 0.1f),
+                                  MAT_STONE);
+    volume_rebuild_all_occupancy(terrain);
+
+    /* Falling a metre per tick, the move reaches far more runs than CHAR_MAX_BOXES */
+    Character character;
+    character_init(&character, vec3_create(0.05f, 8.0f, 0.05f));
+    character.velocity.y = -PHYS_MAX_LINEAR_VELOCITY;
+    character_run(&character, terrain, NULL, vec3_zero(), 30, 1.0f / 30.0f);
+    ASSERT(character.is_grounded);
+    ASSERT(character.position.y >= 1.6f);
+    ASSERT(character.position.y < 1.6f + 0.01f);
+
+    /* Walking across it, standing moves alone reach several hundred runs */
+    character_run(&character, terrain, NULL, vec3_create(1.0f, 0.0f, 0.0f), 60, 1.0f / 60.0f);
+    printf("(y=%.3f x=%.3f) ", character.position.y, character.position.x);
+    ASSERT(character.position.y >= 1.6f - 0.01f);
+    ASSERT_NEAR(character.position.x, 1.05f, 0.05f);
+
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(character_blocked_by_wall_and_steps_up_ledge)
+{
+    VoxelVolume *terrain = create_island_floor();
+    ASSERT(terrain != NULL);
+    /* A wall across x = 1 */
+    character_fill(terrain, vec3_create(1.0f, 0.5f, -2.0f), vec3_create(1.2f, 3.0f, -1.0f));
+    /* A ledge under step height, then one above it */
+    character_fill(terrain, vec3_create(1.0f, 0.5f, 1.0f), vec3_create(3.0f, 0.7f, 2.0f));
+    character_fill(terrain, vec3_create(2.0f, 0.7f, 1.0f), vec3_create(3.0f, 1.2f, 2.0f));
+    volume_rebuild_all_occupancy(terrain);
+
+    Character blocked;
+    character_init(&blocked, vec3_create(0.0f, 0.51f, -1.5f));
+    character_run(&blocked, terrain, NULL, vec3_create(3.0f, 0.0f, 0.0f), 120, 1.0f / 60.0f);
+    ASSERT(blocked.is_grounded);
+    ASSERT(blocked.position.x <= 1.0f - CHAR_CAPSULE_RADIUS);
+    ASSERT(blocked.position.x > 1.0f - CHAR_CAPSULE_RADIUS - 0.01f);
+    ASSERT_NEAR(blocked.position.z, -1.5f, 1e-4f);
+
+    Character climber;
+    character_init(&climber, vec3_create(0.0f, 0.51f, 1.5f));
+    character_run(&climber, terrain, NULL, vec3_create(3.0f, 0.0f, 0.0f), 120, 1.0f / 60.0f);
+    printf("(wall x=%.3f, ledge x=%.3f y=%.3f) ", blocked.position.x, climber.position.x, climber.position.y);
+    ASSERT(climber.is_grounded);
+    ASSERT(climber.position.y >= 0.7f && climber.position.y < 0.71f);
+    ASSERT(climber.position.x <= 2.0f - CHAR_CAPSULE_RADIUS);
+    ASSERT(climber.position.x > 2.0f - CHAR_CAPSULE_RADIUS - 0.01f);
+
+    volume_destroy(terrain);
+    return 1;
+}
+
+TEST(character_stands_on_voxel_object)
+{
+    VoxelVolume *terrain = create_island_floor();
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *objects = voxel_object_world_create(bounds, 0.1f);
+    ASSERT(terrain != NULL && objects != NULL);
+
+    int32_t obj = voxel_object_world_add_box(objects, vec3_create(0.0f, 1.0f, 0.0f),
+                                             vec3_create(0.5f, 0.5f, 0.5f), MAT_WOOD);
+    ASSERT(obj >= 0);
+    voxel_object_world_process_recalcs(objects);
+    bvh_build(objects->bvh, objects);
+    float top = voxel_object_position(objects, obj).y + objects->objects[obj].shape_half_extents.y;
+
+    Character character;
+    character_init(&character, vec3_create(0.1f, 3.0f, 0.1f));
+    character_run(&character, terrain, objects, vec3_zero(), 90, 1.0f / 60.0f);
+    printf("(top=%.3f y=%.3f) ", top, character.position.y);
+    ASSERT(character.is_grounded);
+    ASSERT(character.position.y >= top - 0.01f);
+    ASSERT(character.position.y < top + 0.02f);
+
+    voxel_object_world_destroy(objects);
+    volume_destroy(terrain);
+    return 1;
+}
+
+/* Floor with a few ledges and boxes for the batch tests */
+static VoxelVolume *character_course(VoxelObjectWorld **out_objects)
+{
+    VoxelVolume *terrain = create_island_floor();
+    if (!terrain)
+        return NULL;
+    for (int32_t i = 0; i < 6; i++)
+    {
+        float x = -5.0f + 2.0f * (float)i;
+        character_fill(terrain, vec3_create(x, 0.5f, -4.0f), vec3_create(x + 0.6f, 0.5f + 0.1f * (float)(i + 1), 4.0f));
+    }
+    volume_rebuild_all_occupancy(terrain);
+
+    Bounds3D bounds = {-6.4f, 6.4f, 0.0f, 12.8f, -6.4f, 6.4f};
+    VoxelObjectWorld *objects = voxel_object_world_create(bounds, 0.1f);
+    for (int32_t i = 0; i < 24; i++)
+    {
+        Vec3 pos = vec3_create(-5.5f + 1.9f * (float)(i % 6), 0.8f, -4.5f + 2.5f * (float)(i / 6));
+        voxel_object_world_add_box(objects, pos, vec3_create(0.3f, 0.3f, 0.3f), MAT_WOOD);
+    }
+    voxel_object_world_process_recalcs(objects);
+    bvh_build(objects->bvh, objects);
+    *out_objects = objects;
+    return terrain;
+}
+
+/* Circles, turning back towards the middle near the edge of the floor */
+static Vec3 character_course_input(int32_t i, int32_t tick, float x, float z)
+{
+    if (fabsf(x) > 4.5f || fabsf(z) > 4.5f)
+        return vec3_create(x > 0.0f ? -3.0f : 3.0f, 0.0f, z > 0.0f ? -3.0f : 3.0f);
+    float a = 0.37f * (float)i + 0.02f * (float)tick;
+    return vec3_create(3.0f * cosf(a), 0.0f, 3.0f * sinf(a));
+}
+
+TEST(character_move_many_matches_character_move)
+{
+    VoxelObjectWorld *objects = NULL;
+    VoxelVolume *terrain = character_course(&objects);
+    ASSERT(terrain != NULL && objects != NULL);
+    PhysicsWorkers *workers = physics_workers_create(4);
+
+    enum { N = 100 };
+    static CharacterBatch batch;
+    static Character single[N];
+    character_batch_init(&batch);
+    for (int32_t i = 0; i < N; i++)
+    {
+        Vec3 start = vec3_create(-6.0f + 0.12f * (float)i, 1.5f + 0.01f * (float)(i % 7), -6.0f + 0.11f * (float)i);
+        ASSERT_EQ(character_batch_add(&batch, start), i);
+        character_init(&single[i], start);
+    }
+
+    for (int32_t tick = 0; tick < 120; tick++)
+    {
+        for (int32_t i = 0; i < N; i++)
+        {
+            Vec3 input = character_course_input(i, tick, batch.position.x[i], batch.position.z[i]);
+            batch.move_input.x[i] = input.x;
+            batch.move_input.z[i] = input.z;
+            character_move(&single[i], terrain, objects, input, 1.0f / 60.0f);
+            if (tick == 60 && single[i].is_grounded)
+                character_jump(&single[i], 6.0f);
+        }
+        character_move_many(&batch, terrain, objects, workers, 1.0f / 60.0f);
+        if (tick == 60)
+        {
+            for (int32_t i = 0; i < N; i++)
+            {
+                Character c;
+                character_batch_get(&batch, i, &c);
+                character_jump(&c, 6.0f);
+                character_batch_set(&batch, i, &c);
+            }
+        }
+    }
+
+    int32_t grounded = 0;
+    for (int32_t i = 0; i < N; i++)
+    {
+        Character c;
+        character_batch_get(&batch, i, &c);
+        ASSERT(memcmp(&c.position, &single[i].position, sizeof(Vec3)) == 0);
+        ASSERT(memcmp(&c.velocity, &single[i].velocity, sizeof(Vec3)) == 0);
+        ASSERT_EQ(c.is_grounded, single[i].is_grounded);
+        ASSERT(c.position.y >= 0.5f);
+        grounded += c.is_grounded ? 1 : 0;
+    }
+    printf("(%d/%d grounded) ", grounded, N);
+    ASSERT(grounded > N / 2);
+
+    physics_workers_destroy(workers);
+    voxel_object_world_destroy(objects);
+    volume_destroy(terrain);
+    return 1;
+}
+
+/*
+ * The controller character_move replaced, kept as the benchmark reference:
+ * twelve points on the capsule are sampled against terrain voxels and object
+ * boxes after each full move, which is undone and slid on contact.
+ */
+static bool sampled_terrain_hit(VoxelVolume *terrain, Vec3 p, Vec3 *out_normal)
+{
+    if (!terrain || volume_get_at(terrain, p) == 0)
+        return false;
+
+    float d = terrain->voxel_size * 0.5f;
+    float dx = (volume_get_at(terrain, vec3_create(p.x + d, p.y, p.z)) != 0 ? 1.0f : 0.0f) -
+               (volume_get_at(terrain, vec3_create(p.x - d, p.y, p.z)) != 0 ? 1.0f : 0.0f);
+    float dy = (volume_get_at(terrain, vec3_create(p.x, p.y + d, p.z)) != 0 ? 1.0f : 0.0f) -
+               (volume_get_at(terrain, vec3_create(p.x, p.y - d, p.z)) != 0 ? 1.0f : 0.0f);
+    float dz = (volume_get_at(terrain, vec3_create(p.x, p.y, p.z + d)) != 0 ? 1.0f : 0.0f) -
+               (volume_get_at(terrain, vec3_create(p.x, p.y, p.z - d)) != 0 ? 1.0f : 0.0f);
+    Vec3 gradient = vec3_create(-dx, -dy, -dz);
+    float len = vec3_length(gradient);
+    *out_normal = len > K_EPSILON ? vec3_scale(gradient, 1.0f / len) : vec3_create(0.0f, 1.0f, 0.0f);
+    return true;
+}
+
+static bool sampled_object_hit(VoxelObjectWorld *objects, Vec3 p, Vec3 *out_normal)
+{
+    if (!objects || !objects->bvh || objects->bvh->node_count <= 0)
+        return false;
+
+    BVHQueryResult candidates = bvh_query_sphere(objects->bvh, p, CHAR_CAPSULE_RADIUS);
+    for (int32_t c = 0; c < candidates.count; c++)
+    {
+        int32_t i = candidates.indices[c];
+        if (i < 0 || i >= objects->object_count || !objects->objects[i].active)
+            continue;
+        const VoxelObject *obj = &objects->objects[i];
+        Vec3 delta = vec3_sub(p, voxel_object_position(objects, i));
+        if (vec3_length(delta) > obj->radius)
+            continue;
+
+        Vec3 local = quat_rotate_vec3(quat_conjugate(voxel_object_orientation(objects, i)), delta);
+        Vec3 he = obj->shape_half_extents;
+        if (fabsf(local.x) > he.x || fabsf(local.y) > he.y || fabsf(local.z) > he.z)
+            continue;
+
+        float dx = he.x - fabsf(local.x), dy = he.y - fabsf(local.y), dz = he.z - fabsf(local.z);
+        float m[9];
+        quat_to_mat3(voxel_object_orientation(objects, i), m);
+        int32_t axis = (dx <= dy && dx <= dz) ? 0 : (dy <= dz ? 1 : 2);
+        float sign = (axis == 0 ? local.x : axis == 1 ? local.y : local.z) >= 0.0f ? 1.0f : -1.0f;
+        *out_normal = vec3_create(m[axis] * sign, m[3 + axis] * sign, m[6 + axis] * sign);
+        return true;
+    }
+    return false;
+}
+
+/* Opposing normals can cancel out; a sum that does not point anywhere stays as it is */
+static Vec3 sampled_normalize(Vec3 v)
+{
+    return vec3_length(v) > K_EPSILON ? vec3_normalize(v) : v;
+}
+
+static bool sampled_capsule_hit(const Character *character, VoxelVolume *terrain, VoxelObjectWorld *objects,
+                                Vec3 *out_normal)
+{
+    Vec3 total = vec3_zero();
+    int32_t hits = 0;
+    for (int32_t i = 0; i < 12; i++)
+    {
+        float a = (float)(i % 4) * K_PI * 0.5f;
+        float y = character->position.y + character->height * 0.5f * (float)(i / 4 == 0 ? 0 : i / 4 == 1 ? 2 : 1);
+        Vec3 p = vec3_create(character->position.x + cosf(a) * character->radius, y,
+                             character->position.z + sinf(a) * character->radius);
+        Vec3 tn = vec3_zero(), on = vec3_zero();
+        bool ht = sampled_terrain_hit(terrain, p, &tn);
+        bool ho = sampled_object_hit(objects, p, &on);
+        if (!ht && !ho)
+            continue;
+        total = vec3_add(total, ht && ho ? sampled_normalize(vec3_add(tn, on)) : (ht ? tn : on));
+        hits++;
+    }
+    if (hits > 0)
+        *out_normal = sampled_normalize(total);
+    return hits > 0;
+}
+
+static bool sampled_step_up(Character *character, VoxelVolume *terrain, VoxelObjectWorld *objects, Vec3 move_dir)
+{
+    Vec3 original = character->position;
+    Vec3 n;
+    character->position.y += character->step_height;
+    if (sampled_capsule_hit(character, terrain, objects, &n))
+    {
+        character->position = original;
+        return false;
+    }
+    character->position = vec3_add(character->position, move_dir);
+    if (sampled_capsule_hit(character, terrain, objects, &n))
+    {
+        character->position = original;
+        return false;
+    }
+    float step_down = character->step_height / 4.0f;
+    for (int32_t i = 0; i < 4; i++)
+    {
+        character->position.y -= step_down;
+        if (sampled_capsule_hit(character, terrain, objects, &n))
+        {
+            character->position.y += step_down;
+            return true;
+        }
+    }
+    character->position = original;
+    return false;
+}
+
+static void sampled_character_move(Character *character, VoxelVolume *terrain, VoxelObjectWorld *objects,
+                                   Vec3 move_input, float dt)
+{
+    character->velocity = vec3_add(character->velocity, vec3_create(0.0f, PHYS_GRAVITY_Y * dt, 0.0f));
+    character->velocity.x = move_input.x;
+    character->velocity.z = move_input.z;
+
+    Vec3 move_delta = vec3_scale(character->velocity, dt);
+    for (int32_t iter = 0; iter < CHAR_SLIDE_ITERATIONS; iter++)
+    {
+        if (vec3_length(move_delta) < K_EPSILON)
+            break;
+        character->position = vec3_add(character->position, move_delta);
+        Vec3 n;
+        if (!sampled_capsule_hit(character, terrain, objects, &n))
+            break;
+        character->position = vec3_sub(character->position, move_delta);
+
+        Vec3 horizontal = vec3_create(move_delta.x, 0.0f, move_delta.z);
+        if (n.y < CHAR_WALKABLE_NORMAL_Y && vec3_length_sq(horizontal) > K_EPSILON * K_EPSILON &&
+            sampled_step_up(character, terrain, objects, horizontal))
+        {
+            move_delta = vec3_zero();
+            continue;
+        }
+        move_delta = vec3_sub(move_delta, vec3_scale(n, vec3_dot(move_delta, n)));
+        character->velocity = vec3_sub(character->velocity, vec3_scale(n, vec3_dot(character->velocity, n)));
+        if (n.y > CHAR_WALKABLE_NORMAL_Y)
+        {
+            character->is_grounded = true;
+            character->ground_normal = n;
+        }
+    }
+
+    Character probe = *character;
+    probe.position.y -= CHAR_GROUND_CHECK_DIST;
+    Vec3 n;
+    if (sampled_capsule_hit(&probe, terrain, objects, &n))
+    {
+        if (n.y > CHAR_WALKABLE_NORMAL_Y)
+        {
+            character->is_grounded = true;
+            character->ground_normal = n;
+        }
+    }
+    else
+    {
+        character->is_grounded = false;
+    }
+    character->velocity = vec3_clamp_length(character->velocity, PHYS_MAX_LINEAR_VELOCITY);
+}
+
+TEST(character_move_many_benchmark)
+{
+    VoxelObjectWorld *objects = NULL;
+    VoxelVolume *terrain = character_course(&objects);
+    ASSERT(terrain != NULL && objects != NULL);
+    PhysicsWorkers *workers = physics_workers_create(4);
+
+    static CharacterBatch batch;
+    static Character single[CHAR_BATCH_MAX];
+    static Character sampled[CHAR_BATCH_MAX];
+    const int32_t counts[3] = {1, 64, 512};
+    const int32_t ticks = 60;
+    /* Spread over the floor, then packed as a crowd */
+    const float spacings[2] = {0.55f, 0.25f};
+    for (int32_t c = 0; c < 6; c++)
+    {
+        int32_t n = counts[c % 3];
+        float spacing = spacings[c / 3];
+        character_batch_init(&batch);
+        for (int32_t i = 0; i < n; i++)
+        {
+            Vec3 start = vec3_create(-6.0f + spacing * (float)(i % 22), 0.51f, -6.0f + spacing * (float)(i / 22));
+            character_batch_add(&batch, start);
+            character_init(&single[i], start);
+            character_init(&sampled[i], start);
+        }
+
+        PlatformTime t0 = platform_time_now();
+        for (int32_t tick = 0; tick < ticks; tick++)
+            for (int32_t i = 0; i < n; i++)
+                sampled_character_move(&sampled[i], terrain, objects,
+                                       character_course_input(i, tick, sampled[i].position.x, sampled[i].position.z),
+                                       1.0f / 60.0f);
+        float old_sampler = platform_time_delta_seconds(t0, platform_time_now());
+
+        t0 = platform_time_now();
+        for (int32_t tick = 0; tick < ticks; tick++)
+            for (int32_t i = 0; i < n; i++)
+                character_move(&single[i], terrain, objects,
+                               character_course_input(i, tick, single[i].position.x, single[i].position.z),
+                               1.0f / 60.0f);
+        float one_by_one = platform_time_delta_seconds(t0, platform_time_now());
+
+        t0 = platform_time_now();
+        for (int32_t tick = 0; tick < ticks; tick++)
+        {
+            for (int32_t i = 0; i < n; i++)
+            {
+                Vec3 input = character_course_input(i, tick, batch.position.x[i], batch.position.z[i]);
+                batch.move_input.x[i] = input.x;
+                batch.move_input.z[i] = input.z;
+            }
+            character_move_many(&batch, terrain, objects, workers, 1.0f / 60.0f);
+        }
+        float batched = platform_time_delta_seconds(t0, platform_time_now());
+
+        float per_tick = 1e6f / (float)ticks;
+        printf("\n    %3d characters %.2f m apart, us each per tick: old sampler %.2f, character_move %.2f, "
+               "move_many x4 %.2f",
+               n, spacing, old_sampler * per_tick / (float)n, one_by_one * per_tick / (float)n,
+               batched * per_tick / (float)n);
+        for (int32_t i = 0; i < n; i++)
+            ASSERT(batch.position.y[i] >= 0.5f);
+    }
+    printf("\n  ");
+
+    physics_workers_destroy(workers);
+    voxel_object_world_destroy(objects);
+    volume_destroy(terrain);
+    return 1;
+}
+
+int main(void)
+{
+    platform_time_init();
+
+    printf("=== Matrix Math Tests ===\n");
+    RUN_TEST(mat3_multiply_identity);
+    RUN_TEST(mat3_transpose_unit);
+
+    printf("\n=== Quaternion/Vector Math Tests ===\n");
+    RUN_TEST(quat_from_axis_angle_identity);
+    RUN_TEST(quat_rotate_vec3_y_axis);
+    RUN_TEST(vec3_clamp_length_under_limit);
+    RUN_TEST(vec3_clamp_length_over_limit);
+
+    printf("\n=== Voxel Object Shape Tests ===\n");
+    RUN_TEST(shape_half_extents_symmetric);
+    RUN_TEST(bounding_sphere_accuracy);
+
+    printf("\n=== Object Fragmentation Tests ===\n");
+    RUN_TEST(object_split_creates_fragments);
+    RUN_TEST(object_split_dumbbell);
+
+    printf("\n=== Object Raycast Tests ===\n");
+    RUN_TEST(object_raycast_hit);
+    RUN_TEST(object_raycast_miss);
+
+    printf("\n=== Rigid Body Physics Tests ===\n");
+    RUN_TEST(physics_world_create_destroy);
+    RUN_TEST(physics_body_add_remove);
+    RUN_TEST(physics_body_inertia_symmetric);
+    RUN_TEST(physics_integration_gravity);
+    RUN_TEST(physics_sleep_from_rest);
+    RUN_TEST(physics_wake_on_impulse);
+    RUN_TEST(physics_velocity_clamping);
+    RUN_TEST(physics_energy_decreases);
+    RUN_TEST(physics_zero_mass_guard);
+    RUN_TEST(physics_terrain_contact);
+    RUN_TEST(physics_terrain_settling);
+    RUN_TEST(physics_no_jitter_after_sleep);
+    RUN_TEST(physics_performance_128_bodies);
+
+    printf("\n=== Character Controller Tests ===\n");
+    RUN_TEST(character_init_defaults);
+    RUN_TEST(character_gravity_fall);
+
+    printf("\n=== Projectile Tests ===\n");
+    RUN_TEST(projectile_system_create_destroy);
+    RUN_TEST(projectile_ballistic_fire);
+    RUN_TEST(projectile_ballistic_trajectory);
+    RUN_TEST(projectile_lifetime_expiry);
+
+    printf("\n=== Physics Flags Tests ===\n");
+    RUN_TEST(physics_static_flag);
+    RUN_TEST(physics_kinematic_flag);
+    RUN_TEST(physics_add_body_with_mass);
+
+    printf("\n=== Ragdoll Tests ===\n");
+    RUN_TEST(ragdoll_system_create_destroy);
+    RUN_TEST(ragdoll_spawn_despawn);
+    RUN_TEST(ragdoll_update_gravity);
+    RUN_TEST(ragdoll_apply_impulse);
+
+    printf("\n=== Object-Object Collision Tests ===\n");
+    RUN_TEST(object_collision_basic);
+    RUN_TEST(object_collision_dumbbell_gap);
+    RUN_TEST(object_collision_l_shape);
+    RUN_TEST(object_collision_contact_accuracy);
+    RUN_TEST(object_collision_moving_head_on);
+    RUN_TEST(object_collision_stacking);
+    RUN_TEST(object_collision_wall_friction);
+    RUN_TEST(object_collision_no_interpenetration);
+
+    printf("\n=== Compound Collider Tests ===\n");
+    RUN_TEST(collider_box_count_basic);
+    RUN_TEST(collider_box_l_shape);
+    RUN_TEST(collider_box_dumbbell);
+    RUN_TEST(terrain_contact_l_shape_stability);
+
+    printf("\n=== Physics Sleep & Tunneling Tests ===\n");
+    RUN_TEST(physics_no_sleep_midair);
+    RUN_TEST(physics_terrain_bounce);
+    RUN_TEST(physics_no_tunneling);
+
+    printf("\n=== Contact Island Tests ===\n");
+    RUN_TEST(island_partition);
+    RUN_TEST(island_solve_deterministic);
+    RUN_TEST(body_batch_integration_matches_scalar_reference);
+    RUN_TEST(body_batch_integration_benchmark);
+    RUN_TEST(island_sleep_per_island);
+    RUN_TEST(island_solve_benchmark);
+    RUN_TEST(manifold_persists_and_warm_starts);
+    RUN_TEST(manifold_stacks_fall_asleep);
+
+    printf("\n=== Broadphase Tests ===\n");
+    RUN_TEST(sap_matches_brute_force);
+    RUN_TEST(sap_no_pair_cap);
+    RUN_TEST(sap_benchmark);
+
+    printf("\n=== Fast Body Tests ===\n");
+    RUN_TEST(fast_body_speculative_contact);
+    RUN_TEST(fast_body_benchmark);
+
+    printf("\n=== Terrain Contact Tests ===\n");
+    RUN_TEST(terrain_contacts_airborne_early_out);
+    RUN_TEST(terrain_contacts_face_normals);
+    RUN_TEST(terrain_contacts_benchmark);
+
+    printf("\n=== Narrowphase Cache Tests ===\n");
+    RUN_TEST(pair_cache_separating_axis_early_out);
+    RUN_TEST(pair_cache_reuses_resting_contact);
+    RUN_TEST(pair_cache_benchmark);
+
+    printf("\n=== Convex Hull Tests ===\n");
+    RUN_TEST(convex_hull_box_reduces_to_corners);
+    RUN_TEST(convex_hull_matches_brute_force);
+    RUN_TEST(convex_hull_update_reuses_for_interior_damage);
+    RUN_TEST(convex_hull_damage_benchmark);
+
+    printf("\n=== Wake Propagation Tests ===\n");
+    RUN_TEST(wake_propagates_to_supported_bodies_only);
+    RUN_TEST(supported_body_tracks_terrain_edits);
+
+    printf("\n=== Sim LOD Tests ===\n");
+    RUN_TEST(sim_lod_levels_and_stagger);
+    RUN_TEST(sim_lod_far_bodies_skip_ticks);
+    RUN_TEST(sim_lod_far_body_lands_on_terrain);
+    RUN_TEST(sim_lod_far_body_step_benchmark);
+    RUN_TEST(sim_lod_contact_promotes_far_body);
+    RUN_TEST(sim_lod_far_particles_skip_ticks);
+
+    printf("\n=== Particle SoA Tests ===\n");
+    RUN_TEST(particle_soa_matches_scalar_reference);
+    RUN_TEST(particle_soa_surface_friction_matches_reference);
+    RUN_TEST(particle_soa_update_benchmark);
+
+    printf("\n=== Particle List Tests ===\n");
+    RUN_TEST(particle_lists_follow_state_changes);
+    RUN_TEST(particle_lists_remove_settled_compacts);
+    RUN_TEST(particle_lists_settled_benchmark);
+
+    printf("\n=== Particle Terrain Tests ===\n");
+    RUN_TEST(particle_terrain_matches_volume_queries);
+    RUN_TEST(particle_terrain_masks_follow_edits);
+    RUN_TEST(particle_terrain_batch_benchmark);
+
+    printf("\n=== Particle Cell Tests ===\n");
+    RUN_TEST(particle_cells_pairs_match_brute_force);
+    RUN_TEST(particle_collision_has_no_pair_cap);
+    RUN_TEST(particle_cells_benchmark);
+
+    printf("\n=== Parallel Particle Tests ===\n");
+    RUN_TEST(particle_cells_colors_separate_cells);
+    RUN_TEST(particle_update_independent_of_worker_count);
+    RUN_TEST(particle_spawn_buffers_merge_in_order);
+
+    printf("\n=== Particle Deposit Tests ===\n");
+    RUN_TEST(particle_deposit_fills_voxels_and_frees);
+    RUN_TEST(particle_deposit_keeps_settled_count_bounded);
+
+    printf("\n=== Debris LOD Tests ===\n");
+    RUN_TEST(debris_lod_threshold_rises_with_body_count);
+    RUN_TEST(debris_lod_demotes_small_terrain_islands);
+    RUN_TEST(debris_lod_demotes_small_split_fragments);
+
+    printf("\n=== Body Freeze Tests ===\n");
+    RUN_TEST(voxel_object_stamp_preserves_shape_and_materials);
+    RUN_TEST(sleeping_grounded_body_freezes_into_terrain);
+
+    printf("\n=== Object Destroy Tests ===\n");
+    RUN_TEST(detach_object_at_point_matches_world_space_sphere);
+    RUN_TEST(detach_object_at_point_benchmark);
+
+    printf("\n=== Character Sweep Tests ===\n");
+    RUN_TEST(character_lands_on_terrain_floor);
+    RUN_TEST(character_fast_fall_stops_on_thin_floor);
+    RUN_TEST(character_lands_on_fine_rubble);
+    RUN_TEST(character_blocked_by_wall_and_steps_up_ledge);
+    RUN_TEST(character_stands_on_voxel_object);
+    RUN_TEST(character_move_many_matches_character_move);
+    RUN_TEST(character_move_many_benchmark);
 
     printf("\nResults: %d/%d passed\n", g_tests_passed, g_tests_run);
     return (g_tests_passed == g_tests_run) ? 0 : 1;
@@ -0,0 +1,315 @@
+#include "engine/core/types.h"
+#include "engine/core/math.h"
+#include "engine/voxel/volume.h"
+#include "engine/voxel/voxel_object.h"
+#include "engine/physics/rigidbody.h"
+#include "engine/sim/snapshot.h"
+#include "engine/platform/platform.h"
+#include "content/materials.h"
+#include "test_common.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define SNAPSHOT_TEST_PATH "test_snapshot.bin"
+
+static VoxelVolume *create_test_terrain(void)
+{
+    Bounds3D bounds = {-16.0f, 16.0f, 0.0f, 32.0f, -16.0f, 16.0f};
+    /* 64 voxels (0.5 units) per axis whatever the chunk size */
+    int32_t chunks = 64 / CHUNK_SIZE;
+    VoxelVolume *vol = volume_create(chunks, chunks, chunks, bounds);
+    if (!vol)
+        return NULL;
+
+    volume_fill_box(vol, vec3_create(-16.0f, 0.0f, -16.0f), vec3_create(16.0f, 2.0f, 16.0f), MAT_STONE);
+    volume_fill_sphere(vol, vec3_create(4.0f, 6.0f, 4.0f), 2.0f, MAT_BRICK);
+    volume_rebuild_all_occupancy(vol);
+    return vol;
+}
+
+static bool volumes_equal(const VoxelVolume *a, const VoxelVolume *b)
+{
+    if (a->total_chunks != b->total_chunks)
+        return false;
+    for (int32_t i = 0; i < a->total_chunks; i++)
+    {
+        if (memcmp(a->chunks[i].voxels, b->chunks[i].voxels, sizeof(a->chunks[i].voxels)) != 0)
+            return false;
+        if (a->chunks[i].occupancy.level0 != b->chunks[i].occupancy.level0 ||
+            a->chunks[i].occupancy.solid_count != b->chunks[i].occupancy.solid_count)
+            return false;
+    }
+    return true;
+}
+
+TEST(roundtrip_volume_zero_copy)
+{
+    VoxelVolume *vol = create_test_terrain();
+    ASSERT(vol != NULL);
+    ASSERT(snapshot_save(SNAPSHOT_TEST_PATH, vol, NULL, NULL));
+
+    SceneSnapshot *snap = snapshot_open(SNAPSHOT_TEST_PATH);
+    ASSERT(snap != NULL);
+    ASSERT(snap->header->chunk_offset % SNAPSHOT_ALIGNMENT == 0);
+
+    VoxelVolume *loaded = snapshot_load_volume(snap);
+    ASSERT(loaded != NULL);
+    ASSERT(loaded->chunks_borrowed);
+    ASSERT((const uint8_t *)loaded->chunks ==
+           (const uint8_t *)snap->map.data + snap->header->chunk_offset);
+    ASSERT(loaded->total_solid_voxels == vol->total_solid_voxels);
+    ASSERT(volumes_equal(vol, loaded));
+    ASSERT(volume_get_at(loaded, vec3_create(4.0f, 6.0f, 4.0f)) == MAT_BRICK);
+
+    /* Edits on adopted chunks stay private to the mapping */
+    volume_edit_begin(loaded);
+    volume_edit_set(loaded, vec3_create(4.0f, 6.0f, 4.0f), MAT_AIR);
+    volume_edit_end(loaded);
+    ASSERT(volume_get_at(loaded, vec3_create(4.0f, 6.0f, 4.0f)) == MAT_AIR);
+
+    volume_destroy(loaded);
+    snapshot_close(snap);
+    volume_destroy(vol);
+    remove(SNAPSHOT_TEST_PATH);
+    return 1;
+}
+
+TEST(incremental_save_writes_dirty_only)
+{
+    VoxelVolume *vol = create_test_terrain();
+    ASSERT(vol != NULL);
+    ASSERT(snapshot_save(SNAPSHOT_TEST_PATH, vol, NULL, NULL));
+
+    int32_t dirty[VOLUME_MAX_CHUNKS];
+    ASSERT(volume_get_snapshot_dirty_chunks(vol, dirty, VOLUME_MAX_CHUNKS) == 0);
+
+    /* Single voxel edit touches exactly one chunk */
+    volume_edit_begin(vol);
+    volume_edit_set(vol, vec3_create(-10.0f, 20.0f, -10.0f), MAT_WOOD);
+    volume_edit_end(vol);
+    ASSERT(volume_get_snapshot_dirty_chunks(vol, dirty, VOLUME_MAX_CHUNKS) == 1);
+
+    int32_t written = snapshot_save_dirty(SNAPSHOT_TEST_PATH, vol, NULL, NULL);
+    ASSERT_EQ(written, 1);
+    ASSERT(volume_get_snapshot_dirty_chunks(vol, dirty, VOLUME_MAX_CHUNKS) == 0);
+
+    SceneSnapshot *snap = snapshot_open(SNAPSHOT_TEST_PATH);
+    ASSERT(snap != NULL);
+    VoxelVolume *loaded = snapshot_load_volume(snap);
+    ASSERT(loaded != NULL);
+    ASSERT(volumes_equal(vol, loaded));
+    ASSERT(volume_get_at(loaded, vec3_create(-10.0f, 20.0f, -10.0f)) == MAT_WOOD);
+
+    volume_destroy(loaded);
+    snapshot_close(snap);
+    volume_destroy(vol);
+    remove(SNAPSHOT_TEST_PATH);
+    return 1;
+}
+
+TEST(roundtrip_objects_and_bodies)
+{
+    VoxelVolume *vol = create_test_terrain();
+    ASSERT(vol != NULL);
+
+    VoxelObjectWorld *objects = voxel_object_world_create(vol->bounds, vol->voxel_size);
+    ASSERT(objects != NULL);
+    int32_t a = voxel_object_world_add_box(objects, vec3_create(0.0f, 8.0f, 0.0f),
+                                           vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    int32_t b = voxel_object_world_add_sphere(objects, vec3_create(3.0f, 9.0f, 0.0f), 0.6f, MAT_WOOD);
+    int32_t c = voxel_object_world_add_box(objects, vec3_create(-3.0f, 9.0f, 0.0f),
+                                           vec3_create(0.4f, 0.4f, 0.4f), MAT_BRICK);
+    ASSERT(a >= 0 && b >= 0 && c >= 0);
+    voxel_object_world_free_slot(objects, b);
+    voxel_object_set_orientation(objects, c, quat_from_axis_angle(vec3_create(0.0f, 1.0f, 0.0f), 0.4f));
+
+    PhysicsWorld *physics = physics_world_create(objects, vol);
+    ASSERT(physics != NULL);
+    physics_world_sync_objects(physics);
+    int32_t body_a = physics_world_find_body_for_object(physics, a);
+    ASSERT(body_a >= 0);
+    physics_body_set_velocity(physics, body_a, vec3_create(1.0f, 2.0f, 3.0f));
+
+    ASSERT(snapshot_save(SNAPSHOT_TEST_PATH, vol, objects, physics));
+
+    SceneSnapshot *snap = snapshot_open(SNAPSHOT_TEST_PATH);
+    ASSERT(snap != NULL);
+    ASSERT(snap->header->object_count == 2);
+
+    VoxelVolume *loaded_vol = snapshot_load_volume(snap);
+    VoxelObjectWorld *loaded_objects = voxel_object_world_create(vol->bounds, vol->voxel_size);
+    ASSERT(loaded_vol != NULL && loaded_objects != NULL);
+    ASSERT_EQ(snapshot_load_objects(snap, loaded_objects), 2);
+    ASSERT(loaded_objects->objects[a].active);
+    ASSERT(!loaded_objects->objects[b].active);
+    ASSERT(loaded_objects->objects[c].active);
+    ASSERT_EQ(loaded_objects->objects[a].voxel_count, objects->objects[a].voxel_count);
+    ASSERT_NEAR(voxel_object_position(loaded_objects, c).x, voxel_object_position(objects, c).x, 1e-6f);
+    ASSERT_NEAR(voxel_object_orientation(loaded_objects, c).y, voxel_object_orientation(objects, c).y, 1e-6f);
+    ASSERT_NEAR(loaded_objects->objects[a].total_mass, objects->objects[a].total_mass, 1e-6f);
+
+    /* Freed slot is reused first */
+    ASSERT_EQ(voxel_object_world_alloc_slot(loaded_objects), b);
+
+    PhysicsWorld *loaded_physics = physics_world_create(loaded_objects, loaded_vol);
+    ASSERT(loaded_physics != NULL);
+    ASSERT_EQ(snapshot_load_physics(snap, loaded_physics), physics->body_count);
+    int32_t loaded_body_a = physics_world_find_body_for_object(loaded_physics, a);
+    ASSERT_EQ(loaded_body_a, body_a);
+    ASSERT(physics_world_get_body(loaded_physics, loaded_body_a) != NULL);
+    ASSERT_NEAR(physics_body_velocity(loaded_physics, loaded_body_a).y, 2.0f, 1e-6f);
+    ASSERT_NEAR(loaded_physics->inv_mass[loaded_body_a], physics->inv_mass[body_a], 1e-6f);
+    ASSERT_EQ(loaded_physics->body_count, physics->body_count);
+    ASSERT_EQ(loaded_physics->active_bodies[loaded_physics->active_index[loaded_body_a]], loaded_body_a);
+
+    physics_world_destroy(loaded_physics);
+    voxel_object_world_destroy(loaded_objects);
+    volume_destroy(loaded_vol);
+    snapshot_close(snap);
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(objects);
+    volume_destroy(vol);
+    remove(SNAPSHOT_TEST_PATH);
+    return 1;
+}
+
+TEST(rejects_invalid_file)
+{
+    FILE *f = fopen(SNAPSHOT_TEST_PATH, "wb");
+    ASSERT(f != NULL);
+    uint32_t garbage[64] = {0xDEADBEEFu};
+    fwrite(garbage, sizeof(garbage), 1, f);
+    fclose(f);
+
+    ASSERT(snapshot_open(SNAPSHOT_TEST_PATH) == NULL);
+    ASSERT(snapshot_open("does_not_exist.bin") == NULL);
+
+    remove(SNAPSHOT_TEST_PATH);
+    return 1;
+}
+
+TEST(restored_sleeper_collides_with_falling_body)
+{
+    VoxelVolume *vol = create_test_terrain();
+    ASSERT(vol != NULL);
+    VoxelObjectWorld *objects = voxel_object_world_create(vol->bounds, vol->voxel_size);
+    ASSERT(objects != NULL);
+    int32_t base = voxel_object_world_add_box(objects, vec3_create(0.0f, 3.5f, 0.0f),
+                                              vec3_create(1.0f, 1.0f, 1.0f), MAT_STONE);
+    ASSERT(base >= 0);
+    PhysicsWorld *physics = physics_world_create(objects, vol);
+    ASSERT(physics != NULL);
+    physics_world_sync_objects(physics);
+    int32_t base_body = physics_world_find_body_for_object(physics, base);
+    for (int32_t tick = 0; tick < 600 && !physics_body_is_sleeping(physics, base_body); tick++)
+        physics_world_step(physics, 1.0f / 60.0f);
+    ASSERT(physics_body_is_sleeping(physics, base_body));
+    float base_top = voxel_object_position(objects, base).y + objects->objects[base].shape_half_extents.y;
+    ASSERT(snapshot_save(SNAPSHOT_TEST_PATH, vol, objects, physics));
+
+    SceneSnapshot *snap = snapshot_open(SNAPSHOT_TEST_PATH);
+    ASSERT(snap != NULL);
+    VoxelVolume *loaded_vol = snapshot_load_volume(snap);
+    VoxelObjectWorld *loaded_objects = voxel_object_world_create(vol->bounds, vol->voxel_size);
+    ASSERT(loaded_vol != NULL && loaded_objects != NULL);
+    ASSERT_EQ(snapshot_load_objects(snap, loaded_objects), 1);
+    PhysicsWorld *loaded_physics = physics_world_create(loaded_objects, loaded_vol);
+    ASSERT(loaded_physics != NULL);
+    ASSERT_EQ(snapshot_load_physics(snap, loaded_physics), 1);
+    ASSERT(physics_body_is_sleeping(loaded_physics, base_body));
+
+    int32_t dropped = voxel_object_world_add_box(loaded_objects, vec3_create(0.0f, base_top + 2.0f, 0.0f),
+                                                 vec3_create(0.5f, 0.5f, 0.5f), MAT_STONE);
+    ASSERT(dropped >= 0);
+    ASSERT(physics_world_add_body(loaded_physics, dropped) >= 0);
+    for (int32_t tick = 0; tick < 180; tick++)
+        physics_world_step(loaded_physics, 1.0f / 60.0f);
+    /* It may land on top or slide off, but never end up inside */
+    Vec3 p = voxel_object_position(loaded_objects, dropped);
+    Vec3 c = voxel_object_position(loaded_objects, base);
+    printf("(top %.2f, dropped box at %.2f %.2f %.2f) ", base_top, p.x, p.y, p.z);
+    ASSERT(fabsf(p.x - c.x) > 1.4f || fabsf(p.y - c.y) > 1.4f || fabsf(p.z - c.z) > 1.4f);
+
+    physics_world_destroy(loaded_physics);
+    voxel_object_world_destroy(loaded_objects);
+    volume_destroy(loaded_vol);
+    snapshot_close(snap);
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(objects);
+    volume_destroy(vol);
+    remove(SNAPSHOT_TEST_PATH);
+    return 1;
+}
+
+/* Rewrites the saved header with one field changed; the file must then be refused */
+static bool snapshot_open_with_header(const SnapshotHeader *header)
+{
+    FILE *f = fopen(SNAPSHOT_TEST_PATH, "r+b");
+    if (!f)
+        return false;
+    fwrite(header, sizeof(*header), 1, f);
+    fclose(f);
+    SceneSnapshot *snap = snapshot_open(SNAPSHOT_TEST_PATH);
+    snapshot_close(snap);
+    return snap != NULL;
+}
+
+TEST(rejects_header_with_moved_sections)
+{
+    VoxelVolume *vol = create_test_terrain();
+    ASSERT(vol != NULL);
+    VoxelObjectWorld *objects = voxel_object_world_create(vol->bounds, vol->voxel_size);
+    ASSERT(objects != NULL);
+    ASSERT(voxel_object_world_add_box(objects, vec3_create(0.0f, 8.0f, 0.0f), vec3_create(0.5f, 0.5f, 0.5f),
+                                      MAT_STONE) >= 0);
+    PhysicsWorld *physics = physics_world_create(objects, vol);
+    ASSERT(physics != NULL);
+    physics_world_sync_objects(physics);
+    ASSERT(snapshot_save(SNAPSHOT_TEST_PATH, vol, objects, physics));
+
+    SceneSnapshot *snap = snapshot_open(SNAPSHOT_TEST_PATH);
+    ASSERT(snap != NULL);
+    SnapshotHeader good = *snap->header;
+    snapshot_close(snap);
+    ASSERT(snapshot_open_with_header(&good));
+
+    SnapshotHeader bad = good;
+    bad.chunk_offset += 8;
+    ASSERT(!snapshot_open_with_header(&bad));
+    bad = good;
+    bad.object_offset = good.file_size;
+    ASSERT(!snapshot_open_with_header(&bad));
+    bad = good;
+    bad.body_offset += 4;
+    ASSERT(!snapshot_open_with_header(&bad));
+    bad = good;
+    bad.file_size -= sizeof(RigidBody);
+    ASSERT(!snapshot_open_with_header(&bad));
+    /* Counts that would reach past the mapping move the sections too */
+    bad = good;
+    bad.body_slot_count = PHYS_MAX_BODIES;
+    ASSERT(!snapshot_open_with_header(&bad));
+    ASSERT(snapshot_open_with_header(&good));
+
+    physics_world_destroy(physics);
+    voxel_object_world_destroy(objects);
+    volume_destroy(vol);
+    remove(SNAPSHOT_TEST_PATH);
+    return 1;
+}
+
+int main(void)
+{
+    printf("=== Snapshot Tests ===\n");
+
+    RUN_TEST(roundtrip_volume_zero_copy);
+    RUN_TEST(incremental_save_writes_dirty_only);
+    RUN_TEST(roundtrip_objects_and_bodies);
+    RUN_TEST(restored_sleeper_collides_with_falling_body);
+    RUN_TEST(rejects_invalid_file);
+    RUN_TEST(rejects_header_with_moved_sections);
+
+    printf("\nResults: %d/%d passed\n", g_tests_passed, g_tests_run);
+    return (g_tests_passed == g_tests_run) ? 0 : 1;
+}
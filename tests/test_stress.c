@@ -164,7 +164,7 @@ TEST(destruction_burst)
                 {
                     hit.hit = true;
                     hit.object_index = i;
-                    hit.impact_point = world->objects[i].position;
+                    hit.impact_point = voxel_object_position(world, i);
                     hit.impact_normal = vec3_create(0, 1, 0);
                 }
             }
@@ -214,7 +214,7 @@ TEST(memory_footprint)
     size_t particle_sys_size = sizeof(ParticleSystem);
 
     size_t vobj_per_object = sizeof(VoxelObject);
-    size_t particle_per = sizeof(Particle);
+    size_t particle_per = particle_sys_size / PARTICLE_MAX_COUNT; /* SoA: every per-slot array */
 
     printf("\n");
     printf("    VoxelObjectWorld: %.2f MB (%d objects x %zu bytes)\n",
@@ -295,11 +295,12 @@ TEST(bulk_edit_deduplication)
 /* Worst-case test: dirty ring overflow recovery */
 TEST(dirty_ring_overflow_recovery)
 {
-    /* Create volume with more chunks than VOLUME_DIRTY_RING_SIZE (64) */
-    VoxelVolume *vol = volume_create_dims(8, 4, 8, vec3_zero(), 0.1f);
+    /* Create volume with more chunks than VOLUME_DIRTY_RING_SIZE (64 at 32^3) */
+    int32_t s = CHUNK_SIZE < 32 ? 32 / CHUNK_SIZE : 1;
+    VoxelVolume *vol = volume_create_dims(8 * s, 4 * s, 8 * s, vec3_zero(), 0.1f);
     ASSERT(vol != NULL);
 
-    /* Total chunks = 8 * 4 * 8 = 256, ring size = 64 */
+    /* Total chunks = 8 * 4 * 8 = 256 at 32^3, always 4x the ring size */
     printf("\n    Volume: %d chunks, dirty ring size: %d\n",
            vol->total_chunks, VOLUME_DIRTY_RING_SIZE);
 
@@ -0,0 +1,362 @@
+#include "engine/core/types.h"
+#include "engine/core/math.h"
+#include "engine/voxel/volume.h"
+#include "engine/voxel/volume_stream.h"
+#include "engine/voxel/connectivity.h"
+#include "content/materials.h"
+#include "test_common.h"
+#include <threads.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define STREAM_TEST_VOXEL_SIZE 0.5f
+#define STREAM_TEST_CHUNK_WORLD (STREAM_TEST_VOXEL_SIZE * CHUNK_SIZE)
+#define STREAM_TEST_MAX_UPDATES 1000
+
+/* Rolling ground: global voxel height 20..27, stone below, brick cap */
+static void generate_ground(void *user, int32_t gcx, int32_t gcy, int32_t gcz, VoxelCell *out_voxels)
+{
+    (void)user;
+    for (int32_t lz = 0; lz < CHUNK_SIZE; lz++)
+    {
+        for (int32_t lx = 0; lx < CHUNK_SIZE; lx++)
+        {
+            int32_t vx = gcx * CHUNK_SIZE + lx;
+            int32_t vz = gcz * CHUNK_SIZE + lz;
+            int32_t height = 20 + (((vx + vz) % 8) + 8) % 8;
+            for (int32_t ly = 0; ly < CHUNK_SIZE; ly++)
+            {
+                int32_t vy = gcy * CHUNK_SIZE + ly;
+                if (vy < height)
+                    out_voxels[chunk_voxel_index(lx, ly, lz)].material = (vy == height - 1) ? MAT_BRICK : MAT_STONE;
+            }
+        }
+    }
+}
+
+static void stream_test_desc(VolumeStreamDesc *desc, int32_t workers)
+{
+    volume_stream_desc_defaults(desc);
+    desc->chunks_x = 4;
+    desc->chunks_y = 2;
+    desc->chunks_z = 4;
+    desc->world_origin = vec3_zero();
+    desc->voxel_size = STREAM_TEST_VOXEL_SIZE;
+    desc->fixed_y = true;
+    desc->generate = generate_ground;
+    desc->worker_count = workers;
+}
+
+static bool stream_settle(VolumeStream *stream, Vec3 focus)
+{
+    for (int32_t i = 0; i < STREAM_TEST_MAX_UPDATES; i++)
+    {
+        volume_stream_update(stream, focus);
+        VolumeStreamStats stats = volume_stream_get_stats(stream);
+        const VoxelVolume *vol = volume_stream_volume(stream);
+        /* Same chunk-offset test as the stream's scroll planner */
+        int32_t dx = (int32_t)floorf((focus.x - vol->bounds.min_x) / STREAM_TEST_CHUNK_WORLD) - vol->chunks_x / 2;
+        int32_t dz = (int32_t)floorf((focus.z - vol->bounds.min_z) / STREAM_TEST_CHUNK_WORLD) - vol->chunks_z / 2;
+        bool centered = abs(dx) <= VOLUME_STREAM_HYSTERESIS && abs(dz) <= VOLUME_STREAM_HYSTERESIS;
+        if (stats.pending_loads == 0 && centered)
+            return true;
+
+        /* Give worker threads time to finish instead of spinning through the budget */
+        if (stats.pending_loads > 0)
+            thrd_sleep(&(struct timespec){.tv_nsec = 1000000}, NULL);
+    }
+    return false;
+}
+
+TEST(ring_slot_mapping_roundtrip)
+{
+    VoxelVolume *vol = volume_create_dims(4, 2, 3, vec3_zero(), 1.0f);
+    ASSERT(vol != NULL);
+    vol->ring_x = 3;
+    vol->ring_y = 1;
+    vol->ring_z = 2;
+
+    uint8_t seen[VOLUME_MAX_CHUNKS];
+    memset(seen, 0, sizeof(seen));
+    for (int32_t cz = 0; cz < vol->chunks_z; cz++)
+        for (int32_t cy = 0; cy < vol->chunks_y; cy++)
+            for (int32_t cx = 0; cx < vol->chunks_x; cx++)
+            {
+                int32_t slot = volume_chunk_index(vol, cx, cy, cz);
+                ASSERT(slot >= 0 && slot < vol->total_chunks);
+                ASSERT(!seen[slot]);
+                seen[slot] = 1;
+
+                int32_t rx, ry, rz;
+                volume_slot_to_chunk(vol, slot, &rx, &ry, &rz);
+                ASSERT(rx == cx && ry == cy && rz == cz);
+                ASSERT_EQ(volume_slot_to_logical(vol, slot), cx + cy * vol->chunks_x + cz * vol->chunks_x * vol->chunks_y);
+            }
+
+    volume_destroy(vol);
+    return 1;
+}
+
+TEST(scroll_keeps_world_positions)
+{
+    VoxelVolume *vol = volume_create_dims(4, 2, 4, vec3_zero(), 0.5f);
+    ASSERT(vol != NULL);
+    float cws = vol->voxel_size * CHUNK_SIZE;
+
+    Vec3 kept = vec3_create(2.5f * cws, 0.5f * cws, 1.5f * cws);
+    Vec3 lost = vec3_create(0.5f * cws, 0.5f * cws, 1.5f * cws);
+    volume_fill_sphere(vol, kept, 2.0f, MAT_STONE);
+    volume_fill_sphere(vol, lost, 2.0f, MAT_STONE);
+    int32_t solid_before = vol->total_solid_voxels;
+
+    int32_t recycled[VOLUME_MAX_CHUNKS];
+    int32_t count = volume_scroll(vol, 1, 0, 0, recycled, VOLUME_MAX_CHUNKS);
+    ASSERT_EQ(count, vol->chunks_y * vol->chunks_z);
+    ASSERT_NEAR(vol->bounds.min_x, cws, 1e-5f);
+    ASSERT(vol->ring_generation == 1);
+    ASSERT(vol->shadow_needs_full_rebuild);
+
+    /* Surviving content is untouched and still at the same world position */
+    ASSERT(volume_get_at(vol, kept) == MAT_STONE);
+    ASSERT(vol->total_solid_voxels < solid_before);
+    ASSERT(vol->total_solid_voxels > 0);
+
+    /* Recycled slots form the new +X face and are empty until loaded */
+    for (int32_t i = 0; i < count; i++)
+    {
+        int32_t cx, cy, cz;
+        volume_slot_to_chunk(vol, recycled[i], &cx, &cy, &cz);
+        ASSERT_EQ(cx, vol->chunks_x - 1);
+        ASSERT(vol->chunks[recycled[i]].state == CHUNK_STATE_LOADING);
+        ASSERT(!vol->chunks[recycled[i]].occupancy.has_any);
+        ASSERT_EQ(vol->chunks[recycled[i]].coord_x, cx);
+    }
+
+    /* Edits and raycasts address the rotated storage transparently */
+    Vec3 far_edge = vec3_create(vol->bounds.max_x - 1.0f, 0.5f * cws, 1.5f * cws);
+    volume_edit_begin(vol);
+    volume_edit_set(vol, far_edge, MAT_BRICK);
+    volume_edit_end(vol);
+    ASSERT(volume_get_at(vol, far_edge) == MAT_BRICK);
+
+    Vec3 hit_pos, hit_normal;
+    uint8_t hit_mat = 0;
+    Vec3 ray_origin = vec3_create(kept.x, vol->bounds.max_y - 0.1f, kept.z);
+    float dist = volume_raycast(vol, ray_origin, vec3_create(0.0f, -1.0f, 0.0f), 100.0f,
+                                &hit_pos, &hit_normal, &hit_mat);
+    ASSERT(dist >= 0.0f);
+    ASSERT(hit_mat == MAT_STONE);
+
+    volume_destroy(vol);
+    return 1;
+}
+
+TEST(connectivity_on_scrolled_window)
+{
+    VoxelVolume *vol = volume_create_dims(4, 2, 4, vec3_zero(), 0.5f);
+    ASSERT(vol != NULL);
+    volume_scroll(vol, 3, 0, 2, NULL, 0);
+    ASSERT(vol->ring_x == 3 && vol->ring_z == 2);
+
+    /* Floor anchored at bottom, floating block straddling wrapped slots */
+    Vec3 floor_min = vec3_create(vol->bounds.min_x, vol->bounds.min_y, vol->bounds.min_z);
+    Vec3 floor_max = vec3_create(vol->bounds.max_x, vol->bounds.min_y + 1.0f, vol->bounds.max_z);
+    volume_fill_box(vol, floor_min, floor_max, MAT_STONE);
+    float cws = vol->voxel_size * CHUNK_SIZE;
+    Vec3 block_min = vec3_create(vol->bounds.min_x + cws - 1.0f, 10.0f, vol->bounds.min_z + cws - 1.0f);
+    Vec3 block_max = vec3_create(block_min.x + 2.0f, 12.0f, block_min.z + 2.0f);
+    volume_fill_box(vol, block_min, block_max, MAT_BRICK);
+    volume_rebuild_all_occupancy(vol);
+
+    ConnectivityWorkBuffer work;
+    ASSERT(connectivity_work_init(&work, vol));
+    ConnectivityResult result;
+    connectivity_analyze_volume(vol, vol->bounds.min_y + 0.1f, 0, &work, &result);
+
+    ASSERT_EQ(result.island_count, 2);
+    ASSERT_EQ(result.floating_count, 1);
+    const IslandInfo *floating = result.islands[0].is_floating ? &result.islands[0] : &result.islands[1];
+    ASSERT_EQ(floating->voxel_count, 4 * 4 * 4);
+    ASSERT_NEAR(floating->min_corner.x, block_min.x + 0.5f * vol->voxel_size, 1e-4f); /* Voxel centers */
+
+    connectivity_work_destroy(&work);
+    volume_destroy(vol);
+    return 1;
+}
+
+TEST(window_follows_focus)
+{
+    VolumeStreamDesc desc;
+    stream_test_desc(&desc, 0);
+    Vec3 focus = vec3_create(8.0f, 5.0f, 8.0f);
+    VolumeStream *stream = volume_stream_create(&desc, focus);
+    ASSERT(stream != NULL);
+    VoxelVolume *vol = volume_stream_volume(stream);
+
+    /* Budget caps commits per update */
+    volume_stream_update(stream, focus);
+    VolumeStreamStats stats = volume_stream_get_stats(stream);
+    ASSERT_EQ(stats.loads_committed, desc.loads_per_frame);
+
+    ASSERT(stream_settle(stream, focus));
+    ASSERT(volume_get_at(vol, vec3_create(focus.x, 1.0f, focus.z)) == MAT_STONE);
+    ASSERT(volume_get_at(vol, vec3_create(focus.x, 15.0f, focus.z)) == MATERIAL_EMPTY);
+
+    /* Walk far beyond the original window */
+    Vec3 target = vec3_create(focus.x + 20.0f * STREAM_TEST_CHUNK_WORLD, focus.y, focus.z - 7.0f * STREAM_TEST_CHUNK_WORLD);
+    ASSERT(stream_settle(stream, target));
+    stats = volume_stream_get_stats(stream);
+    ASSERT(stats.scrolls >= 20);
+    ASSERT(stats.pending_loads == 0);
+    ASSERT(target.x >= vol->bounds.min_x && target.x < vol->bounds.max_x);
+    ASSERT(target.z >= vol->bounds.min_z && target.z < vol->bounds.max_z);
+
+    /* Generated terrain matches the generator at the new location */
+    int32_t vx = (int32_t)floorf(target.x / STREAM_TEST_VOXEL_SIZE);
+    int32_t vz = (int32_t)floorf(target.z / STREAM_TEST_VOXEL_SIZE);
+    int32_t height = 20 + (((vx + vz) % 8) + 8) % 8;
+    Vec3 top = vec3_create(target.x, (height - 0.5f) * STREAM_TEST_VOXEL_SIZE, target.z);
+    ASSERT(volume_get_at(vol, top) == MAT_BRICK);
+    ASSERT(volume_get_at(vol, vec3_create(top.x, top.y + STREAM_TEST_VOXEL_SIZE, top.z)) == MATERIAL_EMPTY);
+
+    int32_t expected_solid = 0;
+    for (int32_t i = 0; i < vol->total_chunks; i++)
+        expected_solid += vol->chunks[i].occupancy.solid_count;
+    ASSERT_EQ(vol->total_solid_voxels, expected_solid);
+
+    volume_stream_destroy(stream);
+    return 1;
+}
+
+TEST(edited_chunks_persist_across_eviction)
+{
+    VolumeStreamDesc desc;
+    stream_test_desc(&desc, 0);
+    desc.persist_dir = ".";
+    Vec3 focus = vec3_create(8.0f, 5.0f, 8.0f);
+    VolumeStream *stream = volume_stream_create(&desc, focus);
+    ASSERT(stream != NULL);
+    VoxelVolume *vol = volume_stream_volume(stream);
+    ASSERT(stream_settle(stream, focus));
+
+    Vec3 crater = vec3_create(focus.x, 9.0f, focus.z);
+    ASSERT(volume_get_at(vol, crater) == MAT_STONE);
+    volume_edit_begin(vol);
+    volume_edit_set(vol, crater, MATERIAL_EMPTY);
+    volume_edit_end(vol);
+
+    int32_t gcx = (int32_t)floorf(crater.x / STREAM_TEST_CHUNK_WORLD);
+    int32_t gcy = (int32_t)floorf(crater.y / STREAM_TEST_CHUNK_WORLD);
+    int32_t gcz = (int32_t)floorf(crater.z / STREAM_TEST_CHUNK_WORLD);
+
+    Vec3 away = vec3_create(focus.x + 12.0f * STREAM_TEST_CHUNK_WORLD, focus.y, focus.z);
+    ASSERT(stream_settle(stream, away));
+    ASSERT(volume_get_at(vol, crater) == MATERIAL_EMPTY); /* Outside window */
+    VolumeStreamStats stats = volume_stream_get_stats(stream);
+    ASSERT_EQ(stats.chunks_persisted, 1);
+
+    ASSERT(stream_settle(stream, focus));
+    ASSERT(volume_get_at(vol, crater) == MATERIAL_EMPTY);
+    ASSERT(volume_get_at(vol, vec3_create(crater.x, crater.y - STREAM_TEST_VOXEL_SIZE, crater.z)) == MAT_STONE);
+    stats = volume_stream_get_stats(stream);
+    ASSERT_EQ(stats.loads_from_disk, 1);
+
+    /* Untouched chunks are regenerated, never written */
+    ASSERT_EQ(stats.chunks_persisted, 1);
+
+    volume_stream_destroy(stream);
+
+    char path[128];
+    snprintf(path, sizeof(path), "./chunk_%d_%d_%d.bin", gcx, gcy, gcz);
+    ASSERT(remove(path) == 0);
+    return 1;
+}
+
+TEST(failed_saves_keep_edits)
+{
+    VolumeStreamDesc desc;
+    stream_test_desc(&desc, 0);
+    desc.persist_dir = "./missing_stream_dir"; /* Never created: every write fails */
+    Vec3 focus = vec3_create(8.0f, 5.0f, 8.0f);
+    VolumeStream *stream = volume_stream_create(&desc, focus);
+    ASSERT(stream != NULL);
+    VoxelVolume *vol = volume_stream_volume(stream);
+    ASSERT(stream_settle(stream, focus));
+
+    Vec3 crater = vec3_create(focus.x, 9.0f, focus.z);
+    volume_edit_begin(vol);
+    volume_edit_set(vol, crater, MATERIAL_EMPTY);
+    volume_edit_end(vol);
+
+    Vec3 away = vec3_create(focus.x + 12.0f * STREAM_TEST_CHUNK_WORLD, focus.y, focus.z);
+    ASSERT(stream_settle(stream, away));
+    VolumeStreamStats stats = volume_stream_get_stats(stream);
+    ASSERT_EQ(stats.chunks_persisted, 0);
+    ASSERT(stats.save_failures > 0);
+
+    /* The unwritten copy is served when the chunk comes back */
+    ASSERT(stream_settle(stream, focus));
+    ASSERT(volume_get_at(vol, crater) == MATERIAL_EMPTY);
+    ASSERT(volume_get_at(vol, vec3_create(crater.x, crater.y - STREAM_TEST_VOXEL_SIZE, crater.z)) == MAT_STONE);
+    stats = volume_stream_get_stats(stream);
+    ASSERT_EQ(stats.chunks_persisted, 0);
+
+    volume_stream_destroy(stream);
+    return 1;
+}
+
+TEST(threaded_matches_inline)
+{
+    VolumeStreamDesc desc;
+    stream_test_desc(&desc, 0);
+    Vec3 focus = vec3_create(-40.0f, 5.0f, 100.0f);
+    VolumeStream *inline_stream = volume_stream_create(&desc, focus);
+    desc.worker_count = 3;
+    VolumeStream *threaded_stream = volume_stream_create(&desc, focus);
+    ASSERT(inline_stream != NULL && threaded_stream != NULL);
+
+    Vec3 path[3] = {focus,
+                    vec3_create(focus.x + 6.0f * STREAM_TEST_CHUNK_WORLD, focus.y, focus.z),
+                    vec3_create(focus.x + 6.0f * STREAM_TEST_CHUNK_WORLD, focus.y, focus.z - 5.0f * STREAM_TEST_CHUNK_WORLD)};
+    for (int32_t p = 0; p < 3; p++)
+    {
+        ASSERT(stream_settle(inline_stream, path[p]));
+        ASSERT(stream_settle(threaded_stream, path[p]));
+    }
+
+    VoxelVolume *a = volume_stream_volume(inline_stream);
+    VoxelVolume *b = volume_stream_volume(threaded_stream);
+    ASSERT_NEAR(a->bounds.min_x, b->bounds.min_x, 1e-4f);
+    ASSERT_NEAR(a->bounds.min_z, b->bounds.min_z, 1e-4f);
+    ASSERT_EQ(a->total_solid_voxels, b->total_solid_voxels);
+    for (int32_t cz = 0; cz < a->chunks_z; cz++)
+        for (int32_t cy = 0; cy < a->chunks_y; cy++)
+            for (int32_t cx = 0; cx < a->chunks_x; cx++)
+            {
+                const Chunk *ca = volume_get_chunk(a, cx, cy, cz);
+                const Chunk *cb = volume_get_chunk(b, cx, cy, cz);
+                ASSERT(memcmp(ca->voxels, cb->voxels, sizeof(ca->voxels)) == 0);
+            }
+
+    volume_stream_destroy(threaded_stream);
+    volume_stream_destroy(inline_stream);
+    return 1;
+}
+
+int main(void)
+{
+    printf("=== Volume Stream Tests ===\n");
+
+    RUN_TEST(ring_slot_mapping_roundtrip);
+    RUN_TEST(scroll_keeps_world_positions);
+    RUN_TEST(connectivity_on_scrolled_window);
+    RUN_TEST(window_follows_focus);
+    RUN_TEST(edited_chunks_persist_across_eviction);
+    RUN_TEST(failed_saves_keep_edits);
+    RUN_TEST(threaded_matches_inline);
+
+    printf("\nResults: %d/%d passed\n", g_tests_passed, g_tests_run);
+    return (g_tests_passed == g_tests_run) ? 0 : 1;
+}
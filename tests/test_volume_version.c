@@ -0,0 +1,368 @@
+#include "engine/core/types.h"
+#include "engine/core/math.h"
+#include "engine/core/rng.h"
+#include "engine/voxel/volume.h"
+#include "engine/voxel/volume_version.h"
+#include "engine/render/gpu_volume.h"
+#include "engine/platform/platform.h"
+#include "content/materials.h"
+#include "test_common.h"
+#include <threads.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define VERSION_TEST_VOXEL_SIZE 0.1f
+#define VERSION_TEST_CHUNK_WORLD (VERSION_TEST_VOXEL_SIZE * CHUNK_SIZE)
+#define VERSION_TEST_FRAMES 300
+#define VERSION_TEST_READS 300
+
+static VoxelVolume *create_test_volume(void)
+{
+    VoxelVolume *vol = volume_create_dims(4, 2, 4, vec3_zero(), VERSION_TEST_VOXEL_SIZE);
+    if (!vol)
+        return NULL;
+    volume_fill_box(vol, vec3_zero(), vec3_create(4.0f * VERSION_TEST_CHUNK_WORLD, 0.5f, 4.0f * VERSION_TEST_CHUNK_WORLD),
+                    MAT_STONE);
+    volume_rebuild_all_occupancy(vol);
+    return vol;
+}
+
+/* Fills one whole chunk with a single material */
+static void fill_chunk(VoxelVolume *vol, int32_t cx, int32_t cy, int32_t cz, uint8_t material)
+{
+    float inset = VERSION_TEST_VOXEL_SIZE * 0.25f;
+    Vec3 lo = vec3_create(vol->bounds.min_x + cx * VERSION_TEST_CHUNK_WORLD + inset,
+                          vol->bounds.min_y + cy * VERSION_TEST_CHUNK_WORLD + inset,
+                          vol->bounds.min_z + cz * VERSION_TEST_CHUNK_WORLD + inset);
+    Vec3 hi = vec3_create(lo.x + VERSION_TEST_CHUNK_WORLD - 2.0f * inset,
+                          lo.y + VERSION_TEST_CHUNK_WORLD - 2.0f * inset,
+                          lo.z + VERSION_TEST_CHUNK_WORLD - 2.0f * inset);
+    volume_fill_box(vol, lo, hi, material);
+}
+
+static bool view_matches_volume(const VolumeView *view, VoxelVolume *vol)
+{
+    for (int32_t cz = 0; cz < vol->chunks_z; cz++)
+        for (int32_t cy = 0; cy < vol->chunks_y; cy++)
+            for (int32_t cx = 0; cx < vol->chunks_x; cx++)
+            {
+                const Chunk *a = volume_view_get_chunk(view, cx, cy, cz);
+                const Chunk *b = volume_get_chunk(vol, cx, cy, cz);
+                if (!a || memcmp(a->voxels, b->voxels, sizeof(a->voxels)) != 0 ||
+                    a->occupancy.level0 != b->occupancy.level0)
+                    return false;
+            }
+    return true;
+}
+
+TEST(publish_copies_only_changed_chunks)
+{
+    VoxelVolume *vol = create_test_volume();
+    ASSERT(vol != NULL);
+    VolumeVersionStore *store = volume_versions_create(vol);
+    ASSERT(store != NULL);
+
+    ASSERT(volume_versions_acquire(store, 0) == NULL);
+    ASSERT_EQ(volume_versions_publish(store, vol), 1u);
+    VolumeVersionStats stats = volume_versions_get_stats(store);
+    ASSERT_EQ(stats.pages_copied, vol->total_chunks);
+
+    /* No edits: new view shares every page */
+    ASSERT_EQ(volume_versions_publish(store, vol), 2u);
+    stats = volume_versions_get_stats(store);
+    ASSERT_EQ(stats.pages_copied, 0);
+
+    /* Single voxel edit copies one chunk */
+    volume_edit_begin(vol);
+    volume_edit_set(vol, vec3_create(0.55f, 0.25f, 0.55f), MATERIAL_EMPTY);
+    volume_edit_end(vol);
+    ASSERT_EQ(volume_versions_publish(store, vol), 3u);
+    stats = volume_versions_get_stats(store);
+    ASSERT_EQ(stats.pages_copied, 1);
+    ASSERT_EQ(stats.pages_allocated, vol->total_chunks + 1);
+
+    const VolumeView *view = volume_versions_acquire(store, 0);
+    ASSERT(view != NULL && view->epoch == 3);
+    ASSERT(view_matches_volume(view, vol));
+    volume_versions_release(store, 0);
+
+    volume_versions_destroy(store);
+    volume_destroy(vol);
+    return 1;
+}
+
+TEST(pinned_view_survives_edits)
+{
+    VoxelVolume *vol = create_test_volume();
+    ASSERT(vol != NULL);
+    VolumeVersionStore *store = volume_versions_create(vol);
+    ASSERT(store != NULL);
+    ASSERT(volume_versions_publish(store, vol) != 0);
+
+    const VolumeView *old_view = volume_versions_acquire(store, 0);
+    ASSERT(old_view != NULL);
+    const Chunk *old_chunk = volume_view_get_chunk(old_view, 0, 0, 0);
+    ASSERT(chunk_get(old_chunk, 1, 1, 1) == MAT_STONE);
+
+    /* Writer keeps editing and publishing while reader 0 holds epoch 1 */
+    for (int32_t i = 0; i < 5; i++)
+    {
+        fill_chunk(vol, 0, 0, 0, (uint8_t)(MAT_BRICK + (i & 1)));
+        ASSERT(volume_versions_publish(store, vol) != 0);
+    }
+    VolumeVersionStats stats = volume_versions_get_stats(store);
+    ASSERT_EQ(stats.pages_retired, 5);
+    ASSERT_EQ(stats.pages_reclaimed, 0);
+    ASSERT(chunk_get(old_chunk, 1, 1, 1) == MAT_STONE);
+    ASSERT(old_chunk->occupancy.solid_count != CHUNK_VOXEL_COUNT);
+
+    const VolumeView *new_view = volume_versions_acquire(store, 1);
+    ASSERT(new_view != NULL && new_view->epoch == 6);
+    ASSERT(chunk_get(volume_view_get_chunk(new_view, 0, 0, 0), 1, 1, 1) == MAT_BRICK);
+    ASSERT(volume_view_get_chunk(new_view, 1, 0, 0) == volume_view_get_chunk(old_view, 1, 0, 0));
+
+    /* Old pages return to the pool once both readers moved on */
+    volume_versions_release(store, 0);
+    volume_versions_release(store, 1);
+    ASSERT(volume_versions_publish(store, vol) != 0);
+    stats = volume_versions_get_stats(store);
+    ASSERT_EQ(stats.pages_retired, 0);
+    ASSERT_EQ(stats.pages_reclaimed, 5);
+    ASSERT_EQ(stats.pages_pooled, 5);
+
+    /* Steady state with no readers: pooled pages are reused, nothing new allocated */
+    int32_t allocated = stats.pages_allocated;
+    for (int32_t i = 0; i < 20; i++)
+    {
+        fill_chunk(vol, i & 3, 1, 2, (uint8_t)(MAT_STONE + (i & 1)));
+        ASSERT(volume_versions_publish(store, vol) != 0);
+    }
+    stats = volume_versions_get_stats(store);
+    ASSERT_EQ(stats.pages_allocated, allocated);
+
+    volume_versions_destroy(store);
+    volume_destroy(vol);
+    return 1;
+}
+
+TEST(reader_diff_reports_changed_chunks)
+{
+    VoxelVolume *vol = create_test_volume();
+    ASSERT(vol != NULL);
+    VolumeVersionStore *store = volume_versions_create(vol);
+    ASSERT(store != NULL);
+    ASSERT(volume_versions_publish(store, vol) != 0);
+
+    uint32_t *seen = (uint32_t *)calloc((size_t)vol->total_chunks, sizeof(uint32_t));
+    int32_t *changed = (int32_t *)malloc(sizeof(int32_t) * (size_t)vol->total_chunks);
+    ASSERT(seen != NULL && changed != NULL);
+
+    const VolumeView *view = volume_versions_acquire(store, 0);
+    ASSERT_EQ(volume_view_changed_chunks(view, seen, changed, vol->total_chunks), vol->total_chunks);
+    ASSERT_EQ(volume_view_changed_chunks(view, seen, changed, vol->total_chunks), 0);
+    volume_versions_release(store, 0);
+
+    fill_chunk(vol, 2, 1, 3, MAT_WOOD);
+    fill_chunk(vol, 0, 0, 1, MAT_WOOD);
+    ASSERT(volume_versions_publish(store, vol) != 0);
+    view = volume_versions_acquire(store, 0);
+    ASSERT_EQ(volume_view_changed_chunks(view, seen, changed, vol->total_chunks), 2);
+    ASSERT_EQ(changed[0], 0 + 0 * 4 + 1 * 8);
+    ASSERT_EQ(changed[1], 2 + 1 * 4 + 3 * 8);
+    volume_versions_release(store, 0);
+
+    free(changed);
+    free(seen);
+    volume_versions_destroy(store);
+    volume_destroy(vol);
+    return 1;
+}
+
+TEST(scrolled_volume_publishes_logical_order)
+{
+    VoxelVolume *vol = create_test_volume();
+    ASSERT(vol != NULL);
+    VolumeVersionStore *store = volume_versions_create(vol);
+    ASSERT(store != NULL);
+
+    fill_chunk(vol, 3, 1, 0, MAT_WOOD);
+    ASSERT(volume_versions_publish(store, vol) != 0);
+
+    int32_t slots[VOLUME_MAX_CHUNKS];
+    int32_t recycled = volume_scroll(vol, 1, 0, 0, slots, VOLUME_MAX_CHUNKS);
+    ASSERT_EQ(recycled, 8);
+    ASSERT(volume_versions_publish(store, vol) != 0);
+
+    const VolumeView *view = volume_versions_acquire(store, 0);
+    ASSERT(view_matches_volume(view, vol));
+    ASSERT_NEAR(view->bounds.min_x, VERSION_TEST_CHUNK_WORLD, 1e-5f);
+    const Chunk *moved = volume_view_get_chunk(view, 2, 1, 0);
+    ASSERT(chunk_get(moved, 0, 0, 0) == MAT_WOOD);
+    ASSERT_EQ(moved->coord_x, 2);
+    volume_versions_release(store, 0);
+
+    volume_versions_destroy(store);
+    volume_destroy(vol);
+    return 1;
+}
+
+typedef struct
+{
+    VolumeVersionStore *store;
+    int32_t reader;
+    int32_t views_checked;
+    int32_t torn_chunks;
+    int32_t chunks_packed;
+    uint8_t *staging;
+} VersionReaderCtx;
+
+/* Render-side stand-in: pack uploads for changed chunks, verify each is whole */
+static int version_reader_thread(void *arg)
+{
+    VersionReaderCtx *ctx = (VersionReaderCtx *)arg;
+    uint32_t seen[VOLUME_MAX_CHUNKS] = {0};
+    int32_t changed[VOLUME_MAX_CHUNKS];
+
+    for (int32_t i = 0; i < VERSION_TEST_READS; i++)
+    {
+        const VolumeView *view = volume_versions_acquire(ctx->store, ctx->reader);
+        if (!view)
+        {
+            thrd_yield();
+            continue;
+        }
+
+        int32_t count = volume_view_changed_chunks(view, seen, changed, VOLUME_MAX_CHUNKS);
+        for (int32_t c = 0; c < count; c++)
+        {
+            const Chunk *chunk = view->chunks[changed[c]];
+            gpu_chunk_copy_voxels(chunk, ctx->staging);
+            for (int32_t v = 1; v < CHUNK_VOXEL_COUNT; v++)
+            {
+                if (ctx->staging[v] != ctx->staging[0])
+                {
+                    ctx->torn_chunks++;
+                    break;
+                }
+            }
+            ctx->chunks_packed++;
+        }
+        ctx->views_checked++;
+        volume_versions_release(ctx->store, ctx->reader);
+        thrd_yield();
+    }
+    return 0;
+}
+
+TEST(concurrent_readers_see_whole_chunks)
+{
+    /* Every chunk is always uniformly filled; a torn read shows mixed materials */
+    VoxelVolume *vol = volume_create_dims(4, 2, 4, vec3_zero(), VERSION_TEST_VOXEL_SIZE);
+    ASSERT(vol != NULL);
+    VolumeVersionStore *store = volume_versions_create(vol);
+    ASSERT(store != NULL);
+    ASSERT(volume_versions_publish(store, vol) != 0);
+
+    VersionReaderCtx ctx[2];
+    thrd_t threads[2];
+    for (int32_t r = 0; r < 2; r++)
+    {
+        memset(&ctx[r], 0, sizeof(ctx[r]));
+        ctx[r].store = store;
+        ctx[r].reader = r;
+        ctx[r].staging = (uint8_t *)malloc(CHUNK_VOXEL_COUNT);
+        ASSERT(ctx[r].staging != NULL);
+        ASSERT(thrd_create(&threads[r], version_reader_thread, &ctx[r]) == thrd_success);
+    }
+
+    RngState rng;
+    rng_seed(&rng, 0x30u);
+    for (int32_t frame = 0; frame < VERSION_TEST_FRAMES; frame++)
+    {
+        int32_t edits = rng_range_i32(&rng, 1, 4);
+        for (int32_t e = 0; e < edits; e++)
+        {
+            fill_chunk(vol, rng_range_i32(&rng, 0, 3), rng_range_i32(&rng, 0, 1), rng_range_i32(&rng, 0, 3),
+                       (uint8_t)rng_range_i32(&rng, 0, 8));
+        }
+        volume_rebuild_dirty_occupancy(vol);
+        ASSERT(volume_versions_publish(store, vol) != 0);
+    }
+
+    for (int32_t r = 0; r < 2; r++)
+        thrd_join(threads[r], NULL);
+
+    for (int32_t r = 0; r < 2; r++)
+    {
+        ASSERT_EQ(ctx[r].views_checked, VERSION_TEST_READS);
+        ASSERT_EQ(ctx[r].torn_chunks, 0);
+        ASSERT(ctx[r].chunks_packed >= vol->total_chunks);
+        free(ctx[r].staging);
+    }
+
+    /* Readers gone: one more publish reclaims everything they held */
+    ASSERT(volume_versions_publish(store, vol) != 0);
+    VolumeVersionStats stats = volume_versions_get_stats(store);
+    ASSERT_EQ(stats.pages_retired, 0);
+    ASSERT_EQ(stats.pages_allocated, vol->total_chunks + stats.pages_pooled);
+
+    volume_versions_destroy(store);
+    volume_destroy(vol);
+    return 1;
+}
+
+TEST(publish_benchmark)
+{
+    VoxelVolume *vol = volume_create_dims(8, 4, 8, vec3_zero(), VERSION_TEST_VOXEL_SIZE);
+    ASSERT(vol != NULL);
+    VolumeVersionStore *store = volume_versions_create(vol);
+    ASSERT(store != NULL);
+
+    PlatformTime t0 = platform_time_now();
+    ASSERT(volume_versions_publish(store, vol) != 0);
+    float full_ms = platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+
+    /* Typical gameplay frame: a crater touching a handful of chunks */
+    const int32_t frames = 100;
+    int32_t copied = 0;
+    float publish_ms = 0.0f;
+    RngState rng;
+    rng_seed(&rng, 0x31u);
+    for (int32_t i = 0; i < frames; i++)
+    {
+        Vec3 c = vec3_create(rng_range_f32(&rng, 1.0f, 24.0f), rng_range_f32(&rng, 1.0f, 10.0f),
+                             rng_range_f32(&rng, 1.0f, 24.0f));
+        volume_fill_sphere(vol, c, 0.8f, MAT_STONE);
+        t0 = platform_time_now();
+        ASSERT(volume_versions_publish(store, vol) != 0);
+        publish_ms += platform_time_delta_seconds(t0, platform_time_now()) * 1000.0f;
+        copied += volume_versions_get_stats(store).pages_copied;
+    }
+
+    VolumeVersionStats stats = volume_versions_get_stats(store);
+    printf("\n    chunks=%d  full publish=%.2fms  edit publish=%.3fms avg (%.1f chunks copied)  pages=%d\n    ",
+           vol->total_chunks, full_ms, publish_ms / frames, (float)copied / frames, stats.pages_allocated);
+    ASSERT(stats.pages_allocated < vol->total_chunks * 2);
+
+    volume_versions_destroy(store);
+    volume_destroy(vol);
+    return 1;
+}
+
+int main(void)
+{
+    printf("=== Volume Version Tests ===\n");
+    platform_time_init();
+
+    RUN_TEST(publish_copies_only_changed_chunks);
+    RUN_TEST(pinned_view_survives_edits);
+    RUN_TEST(reader_diff_reports_changed_chunks);
+    RUN_TEST(scrolled_volume_publishes_logical_order);
+    RUN_TEST(concurrent_readers_see_whole_chunks);
+    RUN_TEST(publish_benchmark);
+
+    printf("\nResults: %d/%d passed\n", g_tests_passed, g_tests_run);
+    return (g_tests_passed == g_tests_run) ? 0 : 1;
+}